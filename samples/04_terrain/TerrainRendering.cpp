@@ -23,20 +23,20 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "App/AppBase.h"
 #include "App/CameraComponent.h"
 #include "App/Entity.h"
+#include "App/GeometryClipmap.h"
+#include "App/HeightField.h"
 #include "App/Scene.h"
 #include "App/ServiceProvider.h"
+#include "App/Terrain.h"
 #include "App/TransformController.h"
 #include "RenderBackend/RenderBackendService.h"
-#include "RenderBackend/MaterialBuilder.h"
-#include "RenderBackend/MeshBuilder.h"
-#include "RenderBackend/Mesh.h"
 #include "RenderBackend/TransformMatrixBlock.h"
 
 #define STB_IMAGE_IMPLEMENTATION 
 #include "stb_image.h"
 
+#include <cstdio>
 #include <vector>
-#include <iostream>
 
 using namespace ::OSRE;
 using namespace ::OSRE::RenderBackend;
@@ -45,10 +45,22 @@ using namespace ::OSRE::App;
 // To identify local log entries we will define this tag.
 static constexpr c8 Tag[] = "TerrainRenderingApp";
 
+// Switches to the geometry clipmap
+static constexpr c8 ClipmapArg[] = "clipmap";
+
+// The raw height field for the geometry clipmap, will be converted from the image
+static constexpr c8 RawHeightMap[] = "world_heightmap.r16";
+
+// The scale and the shift of the height data
+static constexpr f32 HeightScale = 128.0f / 256.0f;
+static constexpr f32 HeightShift = -16.0f;
+
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup    Samples
 ///
-/// @brief
+/// @brief  Renders a height map as a streamed terrain, the chunks will be selected by the distance
+///         to the camera. With --clipmap the height map will be rendered as a geometry clipmap,
+///         which reads the samples from a memory-mapped raw file.
 //-------------------------------------------------------------------------------------------------
 class TerrainRenderingApp : public App::AppBase {
     /// The transform block, contains the model-, view- and projection-matrix
@@ -57,16 +69,34 @@ class TerrainRenderingApp : public App::AppBase {
     Entity *mEntity;
     /// The keyboard controller instance.
     Animation::AnimationControllerBase *mKeyboardTransCtrl;
-    /// The number of pixels used for one sample.
-    ui32 mPixelPerSample;
+    /// The active camera.
+    CameraComponent *mCamera;
+    /// The height samples.
+    HeightField mHeightField;
+    /// The terrain.
+    Terrain mTerrain;
+    /// The memory-mapped height samples for the clipmap.
+    MappedHeightField mMappedField;
+    /// The clipmap.
+    GeometryClipmap mClipmap;
+    /// The model matrix of the clipmap, which centers it around the origin.
+    glm::mat4 mClipmapOffset;
+    /// true for using the clipmap.
+    bool mUseClipmap;
 
 public:
     TerrainRenderingApp(int argc, char *argv[]) :
-            AppBase(argc, (const char **)argv),
+            AppBase(argc, (const char **)argv, "api:clipmap", "The render API:Use the geometry clipmap"),
             mTransformMatrix(),
             mEntity(nullptr),
             mKeyboardTransCtrl(nullptr),
-            mPixelPerSample(1) {
+            mCamera(nullptr),
+            mHeightField(),
+            mTerrain(),
+            mMappedField(),
+            mClipmap(),
+            mClipmapOffset(1.0f),
+            mUseClipmap(false) {
         // empty
     }
 
@@ -74,74 +104,59 @@ public:
         delete mEntity;
     }
 
-    void setPixelPerSample(ui32 pixelPerSample) {
-        mPixelPerSample = pixelPerSample;
-    }
-
-    ui32 getPixelPerSample() const {
-        return mPixelPerSample;
-    }
-
 protected:
-    Mesh *loadHeightMap(const String &filename) {
+    bool loadHeightMap(const String &filename) {
         if (filename.empty()) {
-            return nullptr;
+            return false;
         }
 
         int width = 0, height = 0, nChannels = 0;
         unsigned char *data = stbi_load(filename.c_str(), &width, &height, &nChannels, 0);
         if (data == nullptr) {
-            return nullptr;
+            return false;
         }
 
-        // vertex generation
-        const int numVertices = width * height;
-        size_t index = 0;
-        RenderVert *v = new RenderVert[numVertices];
-        std::vector<float> vertices;
-        float yScale = 128.0f / 256.0f, yShift = 16.0f;  // apply a scale+shift to the height data
-        for (int i = 0; i<height; i=i+mPixelPerSample) {
-            for (int j = 0; j<width; j=j+mPixelPerSample) {
-                // retrieve texel for (i,j) tex coord
-                unsigned char *texel = data + (j + width * i) * nChannels;
-                // raw height at coordinate
-                unsigned char y = texel[0];
-
-                // vertex position
-                v[index].position.x = -height/2.0f + i;
-                v[index].position.y = (int) y * yScale - yShift;
-                v[index].position.z = -width/2.0f + j;
-                ++index;
-            }
+        // apply a scale+shift to the height data
+        bool ok = false;
+        if (mUseClipmap) {
+            ok = writeRawHeightMap(RawHeightMap, width, height, nChannels, data) &&
+                 mMappedField.open(RawHeightMap, width, height, HeightScale, HeightShift);
+        } else {
+            ok = mHeightField.createFromImage(width, height, nChannels, data, HeightScale, HeightShift);
         }
-        std::cout << "Number of vertices = " << numVertices << "\n";
         stbi_image_free(data);
+        osre_info(Tag, "Number of samples = " + std::to_string(width * height));
 
-        // Index generation
-        std::vector<unsigned int> indices;
-        for (ui32 i = 0; i < (height/mPixelPerSample)-1; i++) {      // for each row a.k.a. each strip
-            for (ui32 j = 0; j < (width/mPixelPerSample); j++) {     // for each column
-                for (ui32 k = 0; k < 2; k++)  {    // for each side of the strip
-                    indices.push_back(j + width * (i + k));
-                }
-            }
+        return ok;
+    }
+
+    static bool writeRawHeightMap(const String &filename, int width, int height, int nChannels, const unsigned char *data) {
+        std::vector<ui16> samples(static_cast<size_t>(width) * height);
+        for (size_t i = 0; i < samples.size(); ++i) {
+            samples[i] = data[i * nChannels];
         }
-        std::cout << "Number of indices = " << indices.size() << "\n";
 
-        MeshBuilder meshBuilder;
-        Mesh *mesh = meshBuilder.allocEmptyMesh("terrain", VertexType::RenderVertex).getMesh();
-        if (mesh == nullptr) {
-            return nullptr;
+        FILE *file = ::fopen(filename.c_str(), "wb");
+        if (file == nullptr) {
+            return false;
         }
+        const size_t written = ::fwrite(samples.data(), sizeof(ui16), samples.size(), file);
+        ::fclose(file);
+
+        return written == samples.size();
+    }
 
-        mesh->createVertexBuffer(v, (size_t) numVertices * sizeof(RenderVert), BufferAccessType::ReadWrite);
-        mesh->createIndexBuffer(&indices[0], indices.size(), IndexType::UnsignedInt, BufferAccessType::ReadWrite);
+    bool createTerrain(RenderBackendService *rbSrv) {
+        if (mUseClipmap) {
+            mClipmapOffset = glm::translate(glm::mat4(1.0f), glm::vec3(-(mMappedField.getWidth() / 2.0f), 0.0f, -(mMappedField.getHeight() / 2.0f)));
+            return mClipmap.init(rbSrv, &mMappedField, ClipmapDesc());
+        }
 
-        // setup primitives
-        mesh->addPrimitiveGroup(indices.size(), PrimitiveType::TriangelStrip, 0);
-        mesh->setMaterial(MaterialBuilder::createBuildinMaterial(VertexType::RenderVertex));
+        // The terrain is centered around the origin
+        TerrainDesc desc;
+        desc.Origin = glm::vec3(-(mHeightField.getWidth() / 2.0f), 0.0f, -(mHeightField.getHeight() / 2.0f));
 
-        return mesh;
+        return mTerrain.init(rbSrv, &mHeightField, desc);
     }
 
     CameraComponent *setupCamera(Scene *world) {
@@ -165,17 +180,24 @@ protected:
         Scene *world = new Scene("hello_world");
         addScene(world, true);
         mEntity = new Entity("entity", *AppBase::getIdContainer(), world);
-        CameraComponent *camera = setupCamera(world);
+        mCamera = setupCamera(world);
+        world->init();
 
+        mUseClipmap = getArgumentParser().hasArgument(ClipmapArg);
         String filename = "world_heightmap.png";
-        RenderBackend::Mesh *mesh = loadHeightMap(filename);
-        if (mesh != nullptr) {
-            RenderComponent *rc = (RenderComponent*) mEntity->getComponent(ComponentType::RenderComponentType);
-            rc->addStaticMesh(mesh);
-
-            // Initial update
-            world->init();
-            camera->observeBoundingBox(mEntity->getAABB());
+        if (loadHeightMap(filename)) {
+            RenderBackendService *rbSrv = ServiceProvider::getService<RenderBackendService>(ServiceType::RenderService);
+            rbSrv->beginPass(RenderPass::getPassNameById(RenderPassId));
+            rbSrv->beginRenderBatch("b1");
+            const bool ok = createTerrain(rbSrv);
+            rbSrv->endRenderBatch();
+            rbSrv->endPass();
+            if (!ok) {
+                osre_error(Tag, "Cannot create terrain.");
+                return false;
+            }
+
+            mCamera->setLookAt(glm::vec3(0.0f, 120.0f, -200.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
         }
         mKeyboardTransCtrl = AppBase::getTransformController(mTransformMatrix);
 
@@ -194,7 +216,15 @@ protected:
         rbSrv->beginPass(RenderPass::getPassNameById(RenderPassId));
         rbSrv->beginRenderBatch("b1");
 
-        rbSrv->setMatrix(MatrixType::Model, mTransformMatrix.mModel);
+        // The chunks and the clipmap levels are selected in terrain space
+        const glm::mat4 model = mUseClipmap ? mTransformMatrix.mModel * mClipmapOffset : mTransformMatrix.mModel;
+        rbSrv->setMatrix(MatrixType::Model, model);
+        const glm::vec3 eye = glm::vec3(glm::inverse(model) * glm::vec4(mCamera->getEye(), 1.0f));
+        if (mUseClipmap) {
+            mClipmap.update(rbSrv, eye);
+        } else {
+            mTerrain.update(rbSrv, eye);
+        }
 
         rbSrv->endRenderBatch();
         rbSrv->endPass();
@@ -205,7 +235,7 @@ protected:
 
 int main(int argc, char *argv[]) {
     TerrainRenderingApp myApp(argc, argv);
-    if (!myApp.initWindow(10, 10, 1024, 768, "Instancing-Sample", WindowMode::Windowed, WindowType::Root, RenderBackendType::OpenGLRenderBackend)) {
+    if (!myApp.initWindow(10, 10, 1024, 768, "Terrain-Sample", WindowMode::Windowed, WindowType::Root, RenderBackendType::OpenGLRenderBackend)) {
         return 1;
     }
 
@@ -22,7 +22,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "OsreEdApp.h"
 #include "Scripting/PythonInterface.h"
-#include "Actions/ImportAction.h"
 #include "App/ServiceProvider.h"
 #include "App/TransformController.h"
 #include "Common/Logger.h"
@@ -63,7 +62,10 @@ OsreEdApp::OsreEdApp(int argc, char *argv[]) :
         mGuiEntity(nullptr),
         mKeyboardTransCtrl(nullptr),
         mPythonInterface(nullptr),
-        mOrbitalMouseControl(nullptr) {
+        mOrbitalMouseControl(nullptr),
+        mImport(nullptr),
+        mProgressReporter(nullptr),
+        mImportLoc() {
     // empty
 }
 
@@ -95,15 +97,16 @@ void OsreEdApp::newProjectCmd(ui32, void *data) {
     AppBase::setWindowsTitle(title);
 }
 
-void OsreEdApp::loadAsset(const IO::Uri &modelLoc) {
+bool OsreEdApp::loadAsset(const IO::Uri &modelLoc) {
     Platform::AbstractWindow *rootWindow = getRootWindow();
     if (nullptr == rootWindow) {
-        return;
+        return false;
     }
 
-    ProgressReporter reporter(rootWindow);
-    reporter.start();
-    reporter.update(10);
+    if (nullptr != mImport) {
+        osre_warn(Tag, "Import of " + mImportLoc.getResource() + " is still running.");
+        return false;
+    }
 
     Scene *scene = getActiveScene();
     if (scene == nullptr) {
@@ -111,33 +114,88 @@ void OsreEdApp::loadAsset(const IO::Uri &modelLoc) {
         addScene(scene, true);
     }
 
-    ImportAction action(getIdContainer(), getActiveScene());
-    ArgumentList args;
-    args.add(cppcore::Variant::createFromString(modelLoc.getAbsPath()));
-    if (!action.run(args)) {
-        reporter.stop();
+    // The model gets parsed in the background, the editor keeps rendering meanwhile
+    mImport = new AsyncImport(*getIdContainer(), getActiveScene());
+    if (!mImport->start(modelLoc, 0)) {
+        delete mImport;
+        mImport = nullptr;
+        return false;
+    }
+
+    mImportLoc = modelLoc;
+    mProgressReporter = new ProgressReporter(rootWindow);
+    mProgressReporter->start();
+    mImport->setProgressCallback([this](ImportStage stage, f32 progress) {
+        osre_debug(Tag, String("Import stage ") + AsyncImport::getStageName(stage));
+        mProgressReporter->update(static_cast<i32>(progress * 100.0f));
+    });
+
+    return true;
+}
+
+void OsreEdApp::updateImport() {
+    if (nullptr == mImport) {
+        return;
+    }
+
+    if (AppBase::isKeyPressed(Platform::KEY_ESCAPE)) {
+        mImport->cancel();
+    }
+
+    if (!mImport->update()) {
         return;
     }
+
+    const AsyncImportState state = mImport->getState();
+    bool failed = false;
+    if (AsyncImportState::Finished == state) {
+        failed = !onAssetLoaded(mImport->getEntity(), mImportLoc);
+    } else if (AsyncImportState::Cancelled == state) {
+        osre_info(Tag, "Import of " + mImportLoc.getResource() + " was cancelled.");
+    } else {
+        failed = true;
+    }
+
+    mProgressReporter->stop();
+    delete mProgressReporter;
+    mProgressReporter = nullptr;
+    delete mImport;
+    mImport = nullptr;
+    if (failed) {
+        reportImportError(mImportLoc);
+    }
+}
+
+void OsreEdApp::reportImportError(const IO::Uri &modelLoc) {
+    osre_error(Tag, "Cannot import " + modelLoc.getAbsPath());
+
+    Platform::DlgResults result;
+    Platform::PlatformOperations::getDialog("Import failed", "Cannot import " + modelLoc.getResource() + ".",
+            Platform::PlatformOperations::DlgButton_ok, result);
+}
+
+bool OsreEdApp::onAssetLoaded(Entity *entity, const IO::Uri &modelLoc) {
+    Platform::AbstractWindow *rootWindow = getRootWindow();
+    if (nullptr == rootWindow || nullptr == entity) {
+        return false;
+    }
+
     if (mProject == nullptr) {
         newProjectCmd(1, cppcore::Variant::createFromString(modelLoc.getResource()));
     }
-    reporter.update(10);
     auto *rbSrv = ServiceProvider::getService<RenderBackendService>(ServiceType::RenderService);
     if (nullptr == rbSrv) {
-        reporter.stop();
-        return;
+        return false;
     }
 
     Rect2ui windowsRect;
     rootWindow->getWindowsRect(windowsRect);
-    scene = getActiveScene();
+    Scene *scene = getActiveScene();
     if (mProject == nullptr) {
         mProject = createProject(modelLoc.getAbsPath());
     }
-    Entity *entity = action.getEntity();
     mSceneData.mCamera = setupCamera(scene);
 
-    reporter.update(10);
     scene->addEntity(entity);
     mSceneData.mCamera->observeBoundingBox(entity->getAABB());
     mSceneData.m_modelNode = entity->getNode();
@@ -145,10 +203,11 @@ void OsreEdApp::loadAsset(const IO::Uri &modelLoc) {
     String title;
     createTitleString(mProject->getProjectName(), title);
     rootWindow->setWindowsTitle(title);
-    mOrbitalMouseControl = new OrbitalMouseControl(&mTransformMatrix);
+    if (mOrbitalMouseControl == nullptr) {
+        mOrbitalMouseControl = new OrbitalMouseControl(&mTransformMatrix);
+    }
 
-    reporter.update(70);
-    reporter.stop();
+    return true;
 }
 
 bool setupEditorGimmics(Entity *guiEntity) {
@@ -209,6 +268,10 @@ bool OsreEdApp::onCreate() {
 }
 
 bool OsreEdApp::onDestroy() {
+    delete mImport;
+    mImport = nullptr;
+    delete mProgressReporter;
+    mProgressReporter = nullptr;
     mPythonInterface->destroy();
     delete mPythonInterface;
     mPythonInterface = nullptr;
@@ -222,10 +285,11 @@ void OsreEdApp::onUpdate() {
     if (AppBase::isKeyPressed(Platform::KEY_O) || AppBase::isKeyPressed(Platform::KEY_o)) {
         IO::Uri modelLoc;
         Platform::PlatformOperations::getFileOpenDialog("Choose asset for import", "*", modelLoc);
-        if (modelLoc.isValid()) {
-            loadAsset(modelLoc);
+        if (modelLoc.isValid() && !loadAsset(modelLoc)) {
+            reportImportError(modelLoc);
         }
     }
+    updateImport();
 
     Platform::Key key = AppBase::getKeyboardEventListener()->getLastKey();
     if (key != Platform::KEY_UNKNOWN && mKeyboardTransCtrl != nullptr) {
@@ -24,6 +24,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "SceneData.h"
 #include "App/AppBase.h"
+#include "App/AsyncImport.h"
 #include "App/Project.h"
 #include "App/CameraComponent.h"
 #include "App/Entity.h"
@@ -34,6 +35,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace OSRE::Editor {
 
 class PythonInterface;
+class ProgressReporter;
 
 class OsreEdApp final : public App::AppBase {
 public:
@@ -44,7 +46,12 @@ public:
     bool onDestroy() override;
     void onUpdate() override;
     void newProjectCmd(ui32, void *data);
-    void loadAsset(const IO::Uri &modelLoc);
+    bool loadAsset(const IO::Uri &modelLoc);
+
+private:
+    void updateImport();
+    bool onAssetLoaded(App::Entity *entity, const IO::Uri &modelLoc);
+    void reportImportError(const IO::Uri &modelLoc);
 
 private:
     struct Config {
@@ -61,6 +68,9 @@ private:
     SceneData mSceneData;
     PythonInterface *mPythonInterface;
     App::OrbitalMouseControl *mOrbitalMouseControl;
+    App::AsyncImport *mImport;
+    ProgressReporter *mProgressReporter;
+    IO::Uri mImportLoc;
 };
 
 } // namespace OSRE::Editor
\ No newline at end of file
@@ -0,0 +1,317 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Animation/AnimationCompression.h"
+#include "Animation/AnimationSampler.h"
+#include "Animation/AnimatorComponent.h"
+#include "Common/Logger.h"
+
+#include <cmath>
+
+namespace OSRE::Animation {
+
+DECL_OSRE_LOG_MODULE(AnimationCompressor)
+
+namespace {
+
+    // The number of keys, which will be checked for one interpolated segment at most
+    constexpr size_t MaxReductionSpan = 1024;
+
+    constexpr ui32 MaxQuantizedTime = 65535;
+
+    constexpr f32 Sqrt2 = 1.41421356f;
+
+    f32 getRotationError(const glm::quat &a, const glm::quat &b) {
+        const f32 d = std::abs(glm::dot(a, b));
+        return d >= 1.0f ? 0.0f : 2.0f * std::acos(d);
+    }
+
+    f32 getVectorError(const glm::vec3 &a, const glm::vec3 &b) {
+        return glm::length(a - b);
+    }
+
+    // Will collect the keys, which cannot be restored by interpolating the kept neighbours
+    template <class TValue, class TLerp, class TError>
+    void reduceKeys(const std::vector<d32> &times, const std::vector<TValue> &values, f32 tolerance,
+            TLerp lerp, TError error, std::vector<size_t> &kept) {
+        kept.clear();
+        const size_t numKeys = times.size();
+        if (numKeys == 0) {
+            return;
+        }
+
+        kept.push_back(0);
+        if (numKeys == 1) {
+            return;
+        }
+
+        // Constant channels need one key only
+        bool isConstant = true;
+        for (size_t i = 1; i < numKeys && isConstant; ++i) {
+            isConstant = error(values[0], values[i]) <= tolerance;
+        }
+        if (isConstant) {
+            return;
+        }
+
+        size_t start = 0;
+        for (size_t end = 2; end < numKeys; ++end) {
+            bool canSkip = (end - start) <= MaxReductionSpan;
+            const d32 span = times[end] - times[start];
+            for (size_t k = start + 1; k < end && canSkip; ++k) {
+                const f32 t = span > 0.0 ? static_cast<f32>((times[k] - times[start]) / span) : 0.0f;
+                canSkip = error(lerp(values[start], values[end], t), values[k]) <= tolerance;
+            }
+
+            if (!canSkip) {
+                kept.push_back(end - 1);
+                start = end - 1;
+            }
+        }
+        kept.push_back(numKeys - 1);
+    }
+
+    ui16 quantize(f32 value, f32 min, f32 extent) {
+        if (extent <= 0.0f) {
+            return 0;
+        }
+
+        const f32 q = (value - min) / extent * 65535.0f + 0.5f;
+        return static_cast<ui16>(q <= 0.0f ? 0.0f : (q >= 65535.0f ? 65535.0f : q));
+    }
+
+    void computeRange(const std::vector<glm::vec3> &values, const std::vector<size_t> &kept, CompressedClip::Stream &stream) {
+        glm::vec3 minV(values[kept[0]]), maxV(values[kept[0]]);
+        for (size_t index : kept) {
+            minV = glm::min(minV, values[index]);
+            maxV = glm::max(maxV, values[index]);
+        }
+        stream.Min = minV;
+        stream.Extent = maxV - minV;
+    }
+
+} // namespace
+
+void CompressedClip::packRotation(const glm::quat &q, ui16 *words) {
+    const f32 comps[4] = { q.x, q.y, q.z, q.w };
+    ui32 largest = 0;
+    for (ui32 i = 1; i < 4; ++i) {
+        if (std::abs(comps[i]) > std::abs(comps[largest])) {
+            largest = i;
+        }
+    }
+
+    // q and -q are the same rotation, so the dropped component is always positive
+    const f32 sign = comps[largest] < 0.0f ? -1.0f : 1.0f;
+    ui64 bits = largest;
+    for (ui32 i = 0; i < 4; ++i) {
+        if (i == largest) {
+            continue;
+        }
+        // The smaller components are in the range of +-1/sqrt(2)
+        const f32 v = (comps[i] * sign * Sqrt2 + 1.0f) * 0.5f * 32767.0f + 0.5f;
+        const ui64 q15 = static_cast<ui64>(v <= 0.0f ? 0.0f : (v >= 32767.0f ? 32767.0f : v));
+        bits = (bits << 15) | q15;
+    }
+
+    words[0] = static_cast<ui16>((bits >> 32) & 0xffff);
+    words[1] = static_cast<ui16>((bits >> 16) & 0xffff);
+    words[2] = static_cast<ui16>(bits & 0xffff);
+}
+
+glm::quat CompressedClip::unpackRotation(const ui16 *words) {
+    ui64 bits = (static_cast<ui64>(words[0]) << 32) | (static_cast<ui64>(words[1]) << 16) | static_cast<ui64>(words[2]);
+    const ui32 largest = static_cast<ui32>((bits >> 45) & 0x3);
+
+    f32 comps[4] = {};
+    f32 sum = 0.0f;
+    for (i32 i = 3; i >= 0; --i) {
+        if (static_cast<ui32>(i) == largest) {
+            continue;
+        }
+        const f32 v = static_cast<f32>(bits & 0x7fff) / 32767.0f;
+        bits >>= 15;
+        comps[i] = (v * 2.0f - 1.0f) / Sqrt2;
+        sum += comps[i] * comps[i];
+    }
+    comps[largest] = std::sqrt(sum >= 1.0f ? 0.0f : 1.0f - sum);
+
+    return glm::normalize(glm::quat(comps[3], comps[0], comps[1], comps[2]));
+}
+
+size_t CompressedClip::getMemorySize() const {
+    size_t size = sizeof(CompressedClip) + mChannels.size() * sizeof(Channel);
+    size += (mTimes.size() + mPositions.size() + mRotations.size() + mScalings.size()) * sizeof(ui16);
+
+    return size;
+}
+
+CompressedClip *AnimationCompressor::compress(const AnimationTrack &track, const CompressionSettings &settings) {
+    if (track.animationChannels == nullptr || track.numVectorChannels == 0) {
+        osre_error(Tag, "Cannot compress empty track.");
+        return nullptr;
+    }
+
+    // Keys on whole ticks can be stored exactly, otherwise the duration will be split into 16 bit steps
+    d32 maxTime = track.duration > 0.0f ? static_cast<d32>(track.duration) : 0.0;
+    bool onWholeTicks = true;
+    for (size_t c = 0; c < track.numVectorChannels; ++c) {
+        const AnimationChannel &channel = track.animationChannels[c];
+        auto checkTime = [&](d32 time) {
+            maxTime = time > maxTime ? time : maxTime;
+            onWholeTicks = onWholeTicks && time >= 0.0 && time == std::floor(time);
+        };
+        for (size_t i = 0; i < channel.PositionKeys.size(); ++i) {
+            checkTime(channel.PositionKeys[i].Time);
+        }
+        for (size_t i = 0; i < channel.RotationKeys.size(); ++i) {
+            checkTime(channel.RotationKeys[i].Time);
+        }
+        for (size_t i = 0; i < channel.ScalingKeys.size(); ++i) {
+            checkTime(channel.ScalingKeys[i].Time);
+        }
+    }
+
+    CompressedClip *clip = new CompressedClip;
+    clip->mTimeStep = (onWholeTicks && maxTime <= MaxQuantizedTime) ? 1.0 : (maxTime > 0.0 ? maxTime / MaxQuantizedTime : 1.0);
+    const d32 invTimeStep = 1.0 / clip->mTimeStep;
+    auto addTime = [clip, invTimeStep](d32 time) {
+        const d32 q = std::floor(time * invTimeStep + 0.5);
+        clip->mTimes.push_back(static_cast<ui16>(q <= 0.0 ? 0.0 : (q >= MaxQuantizedTime ? MaxQuantizedTime : q)));
+    };
+
+    clip->mChannels.resize(track.numVectorChannels);
+    std::vector<d32> times;
+    std::vector<glm::vec3> vectors;
+    std::vector<glm::quat> rotations;
+    std::vector<size_t> kept;
+    auto lerpVector = [](const glm::vec3 &a, const glm::vec3 &b, f32 t) {
+        return a + (b - a) * t;
+    };
+    for (size_t c = 0; c < track.numVectorChannels; ++c) {
+        const AnimationChannel &channel = track.animationChannels[c];
+        CompressedClip::Channel &target = clip->mChannels[c];
+        target.NodeName = channel.NodeName;
+
+        // Positions
+        times.clear();
+        vectors.clear();
+        for (size_t i = 0; i < channel.PositionKeys.size(); ++i) {
+            times.push_back(channel.PositionKeys[i].Time);
+            vectors.push_back(channel.PositionKeys[i].Value);
+        }
+        reduceKeys(times, vectors, settings.PositionTolerance, lerpVector, getVectorError, kept);
+        if (!kept.empty()) {
+            CompressedClip::Stream &stream = target.Position;
+            stream.NumKeys = static_cast<ui32>(kept.size());
+            stream.TimeOffset = static_cast<ui32>(clip->mTimes.size());
+            stream.ValueOffset = static_cast<ui32>(clip->mPositions.size() / 3);
+            computeRange(vectors, kept, stream);
+            for (size_t index : kept) {
+                addTime(times[index]);
+                for (glm::length_t i = 0; i < 3; ++i) {
+                    clip->mPositions.push_back(quantize(vectors[index][i], stream.Min[i], stream.Extent[i]));
+                }
+            }
+        }
+
+        // Rotations
+        times.clear();
+        rotations.clear();
+        for (size_t i = 0; i < channel.RotationKeys.size(); ++i) {
+            times.push_back(channel.RotationKeys[i].Time);
+            rotations.push_back(channel.RotationKeys[i].Quad);
+        }
+        reduceKeys(times, rotations, settings.RotationTolerance, AnimationSampler::slerp, getRotationError, kept);
+        if (!kept.empty()) {
+            CompressedClip::Stream &stream = target.Rotation;
+            stream.NumKeys = static_cast<ui32>(kept.size());
+            stream.TimeOffset = static_cast<ui32>(clip->mTimes.size());
+            stream.ValueOffset = static_cast<ui32>(clip->mRotations.size() / 3);
+            for (size_t index : kept) {
+                addTime(times[index]);
+                ui16 words[3];
+                CompressedClip::packRotation(rotations[index], words);
+                clip->mRotations.insert(clip->mRotations.end(), words, words + 3);
+            }
+        }
+
+        // Scalings
+        times.clear();
+        vectors.clear();
+        for (size_t i = 0; i < channel.ScalingKeys.size(); ++i) {
+            times.push_back(channel.ScalingKeys[i].Time);
+            vectors.push_back(channel.ScalingKeys[i].Scale);
+        }
+        reduceKeys(times, vectors, settings.ScaleTolerance, lerpVector, getVectorError, kept);
+        if (!kept.empty()) {
+            CompressedClip::Stream &stream = target.Scaling;
+            stream.NumKeys = static_cast<ui32>(kept.size());
+            stream.TimeOffset = static_cast<ui32>(clip->mTimes.size());
+            stream.ValueOffset = static_cast<ui32>(clip->mScalings.size() / 3);
+            computeRange(vectors, kept, stream);
+            for (size_t index : kept) {
+                addTime(times[index]);
+                for (glm::length_t i = 0; i < 3; ++i) {
+                    clip->mScalings.push_back(quantize(vectors[index][i], stream.Min[i], stream.Extent[i]));
+                }
+            }
+        }
+    }
+
+    return clip;
+}
+
+bool AnimationCompressor::compressTrack(AnimationTrack &track, const CompressionSettings &settings, bool keepRawKeys) {
+    CompressedClip *clip = compress(track, settings);
+    if (clip == nullptr) {
+        return false;
+    }
+
+    delete track.compressedClip;
+    track.compressedClip = clip;
+    if (!keepRawKeys) {
+        delete[] track.animationChannels;
+        track.animationChannels = nullptr;
+    }
+
+    return true;
+}
+
+size_t AnimationCompressor::getMemorySize(const AnimationTrack &track) {
+    size_t size = sizeof(AnimationTrack);
+    if (track.animationChannels == nullptr) {
+        return size;
+    }
+
+    for (size_t c = 0; c < track.numVectorChannels; ++c) {
+        const AnimationChannel &channel = track.animationChannels[c];
+        size += sizeof(AnimationChannel);
+        size += channel.PositionKeys.size() * sizeof(VectorKey);
+        size += channel.RotationKeys.size() * sizeof(RotationKey);
+        size += channel.ScalingKeys.size() * sizeof(ScalingKey);
+    }
+
+    return size;
+}
+
+} // namespace OSRE::Animation
@@ -0,0 +1,197 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+#include "Animation/AnimatorBase.h"
+
+#include <vector>
+
+namespace OSRE {
+namespace Animation {
+
+struct AnimationTrack;
+
+/// @brief The error tolerances for the key reduction.
+struct CompressionSettings {
+    f32 PositionTolerance = 0.001f;     ///< The max. position error in units.
+    f32 RotationTolerance = 0.001f;     ///< The max. rotation error in radians.
+    f32 ScaleTolerance = 0.001f;        ///< The max. scaling error.
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief This class stores the quantized keys of an animation track.
+///
+/// All keys are stored in packed arrays, one for each key type:
+///  - Times are quantized to 16 bit steps of the clip time step.
+///  - Positions and scalings are quantized to 16 bit per component over the range of the channel.
+///  - Rotations are stored as the smallest three components with 15 bit each, the index of the
+///    dropped component takes the remaining 2 bit of the 48 bit word.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT CompressedClip {
+public:
+    /// @brief The keys of one type in one channel.
+    struct Stream {
+        ui32 NumKeys = 0;           ///< The number of keys.
+        ui32 TimeOffset = 0;        ///< The index of the first key time.
+        ui32 ValueOffset = 0;       ///< The index of the first value, 3 words per value.
+        glm::vec3 Min = glm::vec3(0.0f);    ///< The range start for vectors.
+        glm::vec3 Extent = glm::vec3(0.0f); ///< The range extent for vectors.
+    };
+
+    /// @brief The streams of one channel.
+    struct Channel {
+        String NodeName;
+        Stream Position;
+        Stream Rotation;
+        Stream Scaling;
+    };
+
+    /// @brief The default class constructor.
+    CompressedClip() = default;
+
+    /// @brief The class destructor, default implementation.
+    ~CompressedClip() = default;
+
+    /// @brief Will return the number of channels.
+    /// @return The number of channels.
+    size_t getNumChannels() const;
+
+    /// @brief Will return a channel.
+    /// @param[in] channel  The channel index.
+    /// @return The channel.
+    const Channel &getChannel(size_t channel) const;
+
+    /// @brief Will return the time of a key.
+    /// @param[in] stream   The key stream.
+    /// @param[in] key      The key index in the stream.
+    /// @return The time in ticks.
+    d32 getKeyTime(const Stream &stream, size_t key) const;
+
+    /// @brief Will decode a position key.
+    /// @param[in] stream   The position stream.
+    /// @param[in] key      The key index in the stream.
+    /// @return The position.
+    glm::vec3 getPosition(const Stream &stream, size_t key) const;
+
+    /// @brief Will decode a rotation key.
+    /// @param[in] stream   The rotation stream.
+    /// @param[in] key      The key index in the stream.
+    /// @return The rotation.
+    glm::quat getRotation(const Stream &stream, size_t key) const;
+
+    /// @brief Will decode a scaling key.
+    /// @param[in] stream   The scaling stream.
+    /// @param[in] key      The key index in the stream.
+    /// @return The scaling.
+    glm::vec3 getScaling(const Stream &stream, size_t key) const;
+
+    /// @brief Will return the used memory.
+    /// @return The size in bytes.
+    size_t getMemorySize() const;
+
+    /// @brief Will pack a rotation into three words, the smallest three components are stored.
+    /// @param[in]  q       The rotation.
+    /// @param[out] words   The packed rotation.
+    static void packRotation(const glm::quat &q, ui16 *words);
+
+    /// @brief Will unpack a rotation.
+    /// @param[in] words    The packed rotation.
+    /// @return The rotation.
+    static glm::quat unpackRotation(const ui16 *words);
+
+private:
+    friend class AnimationCompressor;
+
+    static glm::vec3 decodeVector(const Stream &stream, const ui16 *words);
+
+    d32 mTimeStep = 1.0;
+    std::vector<Channel> mChannels;
+    std::vector<ui16> mTimes;
+    std::vector<ui16> mPositions;
+    std::vector<ui16> mRotations;
+    std::vector<ui16> mScalings;
+};
+
+inline size_t CompressedClip::getNumChannels() const {
+    return mChannels.size();
+}
+
+inline const CompressedClip::Channel &CompressedClip::getChannel(size_t channel) const {
+    return mChannels[channel];
+}
+
+inline d32 CompressedClip::getKeyTime(const Stream &stream, size_t key) const {
+    return static_cast<d32>(mTimes[stream.TimeOffset + key]) * mTimeStep;
+}
+
+inline glm::vec3 CompressedClip::getPosition(const Stream &stream, size_t key) const {
+    return decodeVector(stream, &mPositions[(stream.ValueOffset + key) * 3]);
+}
+
+inline glm::quat CompressedClip::getRotation(const Stream &stream, size_t key) const {
+    return unpackRotation(&mRotations[(stream.ValueOffset + key) * 3]);
+}
+
+inline glm::vec3 CompressedClip::getScaling(const Stream &stream, size_t key) const {
+    return decodeVector(stream, &mScalings[(stream.ValueOffset + key) * 3]);
+}
+
+inline glm::vec3 CompressedClip::decodeVector(const Stream &stream, const ui16 *words) {
+    constexpr f32 Scale = 1.0f / 65535.0f;
+    return stream.Min + glm::vec3(words[0] * Scale, words[1] * Scale, words[2] * Scale) * stream.Extent;
+}
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief This class implements the compression of animation tracks.
+///
+/// Keys which can be restored by interpolating their neighbours within the tolerance will be
+/// removed, the remaining keys will be quantized into a CompressedClip.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT AnimationCompressor {
+public:
+    /// @brief Will compress an animation track.
+    /// @param[in] track        The track to compress.
+    /// @param[in] settings     The compression settings.
+    /// @return The compressed clip, nullptr in case of an error.
+    static CompressedClip *compress(const AnimationTrack &track, const CompressionSettings &settings);
+
+    /// @brief Will compress an animation track and attach the compressed clip to it.
+    /// @param[inout] track     The track to compress.
+    /// @param[in] settings     The compression settings.
+    /// @param[in] keepRawKeys  true to keep the uncompressed channels, false to release them.
+    /// @return true if successful, false in case of an error.
+    static bool compressTrack(AnimationTrack &track, const CompressionSettings &settings, bool keepRawKeys = false);
+
+    /// @brief Will return the memory used by the uncompressed keys of a track.
+    /// @param[in] track        The track.
+    /// @return The size in bytes.
+    static size_t getMemorySize(const AnimationTrack &track);
+};
+
+} // namespace Animation
+} // namespace OSRE
@@ -0,0 +1,228 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Animation/AnimationSampler.h"
+#include "Animation/AnimationCompression.h"
+#include "Animation/AnimatorComponent.h"
+
+#include <cmath>
+
+namespace OSRE::Animation {
+
+namespace {
+
+    f32 getFactor(d32 keyTime, d32 nextKeyTime, d32 time) {
+        const d32 diffTime = nextKeyTime - keyTime;
+        if (diffTime <= 0.0) {
+            return 0.0f;
+        }
+
+        const d32 factor = (time - keyTime) / diffTime;
+        if (factor <= 0.0) {
+            return 0.0f;
+        }
+
+        return factor >= 1.0 ? 1.0f : static_cast<f32>(factor);
+    }
+
+    glm::mat4 toTransform(const glm::vec3 &position, const glm::quat &rotation, const glm::vec3 &scaling) {
+        glm::mat4 transform = glm::translate(glm::mat4(1.0f), position);
+        transform *= glm::toMat4(rotation);
+        transform = glm::scale(transform, scaling);
+
+        return transform;
+    }
+
+    const String EmptyName;
+
+} // namespace
+
+glm::quat AnimationSampler::nlerp(const glm::quat &a, const glm::quat &b, f32 t) {
+    // Take the shortest path
+    const f32 sign = glm::dot(a, b) < 0.0f ? -1.0f : 1.0f;
+    const glm::quat q = a * (1.0f - t) + b * (sign * t);
+
+    return glm::normalize(q);
+}
+
+glm::quat AnimationSampler::slerp(const glm::quat &a, const glm::quat &b, f32 t) {
+    f32 cosTheta = glm::dot(a, b);
+    glm::quat end = b;
+    if (cosTheta < 0.0f) {
+        end = -b;
+        cosTheta = -cosTheta;
+    }
+
+    // Nearly parallel rotations are numerically unstable, the linear path is close enough there
+    if (cosTheta > 0.9995f) {
+        return nlerp(a, end, t);
+    }
+
+    const f32 theta = std::acos(cosTheta);
+    const f32 invSinTheta = 1.0f / std::sin(theta);
+    const f32 wa = std::sin((1.0f - t) * theta) * invSinTheta;
+    const f32 wb = std::sin(t * theta) * invSinTheta;
+
+    return a * wa + end * wb;
+}
+
+void AnimationSampler::sample(const AnimationChannel &channel, d32 time, KeyCursor &cursor, RotationBlendMode mode,
+        glm::vec3 &position, glm::quat &rotation, glm::vec3 &scale) {
+    const VectorKeyArray &posKeys = channel.PositionKeys;
+    if (!posKeys.isEmpty()) {
+        cursor.Position = findKey(posKeys, time, cursor.Position);
+        const VectorKey &key = posKeys[cursor.Position];
+        if (cursor.Position + 1 < posKeys.size()) {
+            const VectorKey &nextKey = posKeys[cursor.Position + 1];
+            position = key.Value + (nextKey.Value - key.Value) * getFactor(key.Time, nextKey.Time, time);
+        } else {
+            position = key.Value;
+        }
+    } else {
+        position = glm::vec3(0.0f);
+    }
+
+    const RotationKeyArray &rotKeys = channel.RotationKeys;
+    if (!rotKeys.isEmpty()) {
+        cursor.Rotation = findKey(rotKeys, time, cursor.Rotation);
+        const RotationKey &key = rotKeys[cursor.Rotation];
+        if (cursor.Rotation + 1 < rotKeys.size()) {
+            const RotationKey &nextKey = rotKeys[cursor.Rotation + 1];
+            const f32 factor = getFactor(key.Time, nextKey.Time, time);
+            rotation = (mode == RotationBlendMode::Slerp) ? slerp(key.Quad, nextKey.Quad, factor) : nlerp(key.Quad, nextKey.Quad, factor);
+        } else {
+            rotation = key.Quad;
+        }
+    } else {
+        rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    const ScalingKeyArray &scaleKeys = channel.ScalingKeys;
+    if (!scaleKeys.isEmpty()) {
+        cursor.Scaling = findKey(scaleKeys, time, cursor.Scaling);
+        const ScalingKey &key = scaleKeys[cursor.Scaling];
+        if (cursor.Scaling + 1 < scaleKeys.size()) {
+            const ScalingKey &nextKey = scaleKeys[cursor.Scaling + 1];
+            scale = key.Scale + (nextKey.Scale - key.Scale) * getFactor(key.Time, nextKey.Time, time);
+        } else {
+            scale = key.Scale;
+        }
+    } else {
+        scale = glm::vec3(1.0f);
+    }
+}
+
+glm::mat4 AnimationSampler::sample(const AnimationChannel &channel, d32 time, KeyCursor &cursor, RotationBlendMode mode) {
+    glm::vec3 position, scaling;
+    glm::quat rotation;
+    sample(channel, time, cursor, mode, position, rotation, scaling);
+
+    return toTransform(position, rotation, scaling);
+}
+
+void AnimationSampler::sample(const CompressedClip &clip, size_t channel, d32 time, KeyCursor &cursor, RotationBlendMode mode,
+        glm::vec3 &position, glm::quat &rotation, glm::vec3 &scale) {
+    const CompressedClip::Channel &source = clip.getChannel(channel);
+
+    const CompressedClip::Stream &posStream = source.Position;
+    if (posStream.NumKeys > 0) {
+        cursor.Position = findKey(posStream.NumKeys, time, cursor.Position, [&clip, &posStream](size_t index) {
+            return clip.getKeyTime(posStream, index);
+        });
+        position = clip.getPosition(posStream, cursor.Position);
+        if (cursor.Position + 1 < posStream.NumKeys) {
+            const f32 factor = getFactor(clip.getKeyTime(posStream, cursor.Position), clip.getKeyTime(posStream, cursor.Position + 1), time);
+            position += (clip.getPosition(posStream, cursor.Position + 1) - position) * factor;
+        }
+    } else {
+        position = glm::vec3(0.0f);
+    }
+
+    const CompressedClip::Stream &rotStream = source.Rotation;
+    if (rotStream.NumKeys > 0) {
+        cursor.Rotation = findKey(rotStream.NumKeys, time, cursor.Rotation, [&clip, &rotStream](size_t index) {
+            return clip.getKeyTime(rotStream, index);
+        });
+        rotation = clip.getRotation(rotStream, cursor.Rotation);
+        if (cursor.Rotation + 1 < rotStream.NumKeys) {
+            const f32 factor = getFactor(clip.getKeyTime(rotStream, cursor.Rotation), clip.getKeyTime(rotStream, cursor.Rotation + 1), time);
+            const glm::quat next = clip.getRotation(rotStream, cursor.Rotation + 1);
+            rotation = (mode == RotationBlendMode::Slerp) ? slerp(rotation, next, factor) : nlerp(rotation, next, factor);
+        }
+    } else {
+        rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    const CompressedClip::Stream &scaleStream = source.Scaling;
+    if (scaleStream.NumKeys > 0) {
+        cursor.Scaling = findKey(scaleStream.NumKeys, time, cursor.Scaling, [&clip, &scaleStream](size_t index) {
+            return clip.getKeyTime(scaleStream, index);
+        });
+        scale = clip.getScaling(scaleStream, cursor.Scaling);
+        if (cursor.Scaling + 1 < scaleStream.NumKeys) {
+            const f32 factor = getFactor(clip.getKeyTime(scaleStream, cursor.Scaling), clip.getKeyTime(scaleStream, cursor.Scaling + 1), time);
+            scale += (clip.getScaling(scaleStream, cursor.Scaling + 1) - scale) * factor;
+        }
+    } else {
+        scale = glm::vec3(1.0f);
+    }
+}
+
+glm::mat4 AnimationSampler::sample(const AnimationTrack &track, size_t channel, d32 time, KeyCursor &cursor, RotationBlendMode mode) {
+    glm::vec3 position, scaling;
+    glm::quat rotation;
+    if (!sample(track, channel, time, cursor, mode, position, rotation, scaling)) {
+        return glm::mat4(1.0f);
+    }
+
+    return toTransform(position, rotation, scaling);
+}
+
+bool AnimationSampler::sample(const AnimationTrack &track, size_t channel, d32 time, KeyCursor &cursor, RotationBlendMode mode,
+        glm::vec3 &position, glm::quat &rotation, glm::vec3 &scale) {
+    if (track.compressedClip != nullptr && channel < track.compressedClip->getNumChannels()) {
+        sample(*track.compressedClip, channel, time, cursor, mode, position, rotation, scale);
+        return true;
+    }
+
+    if (track.animationChannels == nullptr || channel >= track.numVectorChannels) {
+        return false;
+    }
+
+    sample(track.animationChannels[channel], time, cursor, mode, position, rotation, scale);
+
+    return true;
+}
+
+const String &AnimationSampler::getChannelName(const AnimationTrack &track, size_t channel) {
+    if (track.compressedClip != nullptr && channel < track.compressedClip->getNumChannels()) {
+        return track.compressedClip->getChannel(channel).NodeName;
+    }
+
+    if (track.animationChannels == nullptr || channel >= track.numVectorChannels) {
+        return EmptyName;
+    }
+
+    return track.animationChannels[channel].NodeName;
+}
+
+} // namespace OSRE::Animation
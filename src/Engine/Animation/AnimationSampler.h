@@ -0,0 +1,199 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+#include "Animation/AnimatorBase.h"
+
+namespace OSRE {
+namespace Animation {
+
+struct AnimationTrack;
+class CompressedClip;
+
+/// @brief Describes how rotation keys will be interpolated.
+enum class RotationBlendMode {
+    Slerp = 0,  ///< Spherical interpolation, constant angular velocity.
+    Nlerp       ///< Normalized linear interpolation, cheaper but not constant in speed.
+};
+
+/// @brief The cached key positions for one animation channel.
+struct KeyCursor {
+    size_t Position = 0;
+    size_t Rotation = 0;
+    size_t Scaling = 0;
+
+    /// @brief Will reset the cursor to the first keys.
+    void reset() {
+        Position = Rotation = Scaling = 0;
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief This class implements the keyframe sampling for animation channels.
+///
+/// Each channel keeps a cursor to the last used keys. During playback the time moves forward in
+/// small steps, so the next pair of keys is found in constant time by checking the cached key and
+/// its successor. Seeks, loops and larger jumps fall back to a binary search.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT AnimationSampler {
+public:
+    /// @brief Will find the key index, which starts the interval containing the given time.
+    /// @param[in] keys     The sorted key array.
+    /// @param[in] time     The time to look for.
+    /// @param[in] hint     The last used key index.
+    /// @return The key index, will be clamped to the first and the last key.
+    template <class TKey>
+    static size_t findKey(const cppcore::TArray<TKey> &keys, d32 time, size_t hint);
+
+    /// @brief Will find the key index, which starts the interval containing the given time.
+    /// @param[in] numKeys  The number of keys.
+    /// @param[in] time     The time to look for.
+    /// @param[in] hint     The last used key index.
+    /// @param[in] getTime  Will return the time of a key index, keys must be sorted by time.
+    /// @return The key index, will be clamped to the first and the last key.
+    template <class TGetTime>
+    static size_t findKey(size_t numKeys, d32 time, size_t hint, TGetTime getTime);
+
+    /// @brief Will interpolate two rotations by normalized linear interpolation along the shortest path.
+    /// @param[in] a    The start rotation.
+    /// @param[in] b    The end rotation.
+    /// @param[in] t    The interpolation factor, between 0 and 1.
+    /// @return The interpolated rotation.
+    static glm::quat nlerp(const glm::quat &a, const glm::quat &b, f32 t);
+
+    /// @brief Will interpolate two rotations spherically along the shortest path.
+    /// @param[in] a    The start rotation.
+    /// @param[in] b    The end rotation.
+    /// @param[in] t    The interpolation factor, between 0 and 1.
+    /// @return The interpolated rotation.
+    static glm::quat slerp(const glm::quat &a, const glm::quat &b, f32 t);
+
+    /// @brief Will sample the channel at the given time.
+    /// @param[in] channel      The animation channel.
+    /// @param[in] time         The time in ticks.
+    /// @param[inout] cursor    The cached cursor of the channel, will be updated.
+    /// @param[in] mode         The rotation interpolation mode.
+    /// @param[out] position    The sampled position.
+    /// @param[out] rotation    The sampled rotation.
+    /// @param[out] scale       The sampled scaling.
+    static void sample(const AnimationChannel &channel, d32 time, KeyCursor &cursor, RotationBlendMode mode,
+            glm::vec3 &position, glm::quat &rotation, glm::vec3 &scale);
+
+    /// @brief Will sample the channel at the given time and return the local transformation.
+    /// @param[in] channel      The animation channel.
+    /// @param[in] time         The time in ticks.
+    /// @param[inout] cursor    The cached cursor of the channel, will be updated.
+    /// @param[in] mode         The rotation interpolation mode.
+    /// @return The local transformation, translation * rotation * scaling.
+    static glm::mat4 sample(const AnimationChannel &channel, d32 time, KeyCursor &cursor, RotationBlendMode mode);
+
+    /// @brief Will sample a channel of a compressed clip at the given time.
+    /// @param[in] clip         The compressed clip.
+    /// @param[in] channel      The channel index.
+    /// @param[in] time         The time in ticks.
+    /// @param[inout] cursor    The cached cursor of the channel, will be updated.
+    /// @param[in] mode         The rotation interpolation mode.
+    /// @param[out] position    The sampled position.
+    /// @param[out] rotation    The sampled rotation.
+    /// @param[out] scale       The sampled scaling.
+    static void sample(const CompressedClip &clip, size_t channel, d32 time, KeyCursor &cursor, RotationBlendMode mode,
+            glm::vec3 &position, glm::quat &rotation, glm::vec3 &scale);
+
+    /// @brief Will sample a channel of a track, the compressed clip will be used when available.
+    /// @param[in] track        The animation track.
+    /// @param[in] channel      The channel index.
+    /// @param[in] time         The time in ticks.
+    /// @param[inout] cursor    The cached cursor of the channel, will be updated.
+    /// @param[in] mode         The rotation interpolation mode.
+    /// @return The local transformation, translation * rotation * scaling.
+    static glm::mat4 sample(const AnimationTrack &track, size_t channel, d32 time, KeyCursor &cursor, RotationBlendMode mode);
+
+    /// @brief Will sample a channel of a track, the compressed clip will be used when available.
+    /// @param[in] track        The animation track.
+    /// @param[in] channel      The channel index.
+    /// @param[in] time         The time in ticks.
+    /// @param[inout] cursor    The cached cursor of the channel, will be updated.
+    /// @param[in] mode         The rotation interpolation mode.
+    /// @param[out] position    The sampled position.
+    /// @param[out] rotation    The sampled rotation.
+    /// @param[out] scale       The sampled scaling.
+    /// @return true if the channel exists, false if not.
+    static bool sample(const AnimationTrack &track, size_t channel, d32 time, KeyCursor &cursor, RotationBlendMode mode,
+            glm::vec3 &position, glm::quat &rotation, glm::vec3 &scale);
+
+    /// @brief Will return the name of the node, which is animated by a channel.
+    /// @param[in] track        The animation track.
+    /// @param[in] channel      The channel index.
+    /// @return The node name.
+    static const String &getChannelName(const AnimationTrack &track, size_t channel);
+};
+
+template <class TKey>
+inline size_t AnimationSampler::findKey(const cppcore::TArray<TKey> &keys, d32 time, size_t hint) {
+    return findKey(keys.size(), time, hint, [&keys](size_t index) {
+        return static_cast<d32>(keys[index].Time);
+    });
+}
+
+template <class TGetTime>
+inline size_t AnimationSampler::findKey(size_t numKeys, d32 time, size_t hint, TGetTime getTime) {
+    if (numKeys < 2 || time <= getTime(0)) {
+        return 0;
+    }
+
+    const size_t lastKey = numKeys - 1;
+    if (time >= getTime(lastKey)) {
+        return lastKey;
+    }
+
+    // Playback will hit the cached key or its successor in nearly all frames
+    if (hint < lastKey && getTime(hint) <= time) {
+        if (time < getTime(hint + 1)) {
+            return hint;
+        }
+        if (hint + 1 < lastKey && time < getTime(hint + 2)) {
+            return hint + 1;
+        }
+    }
+
+    // Search for the first key behind the time, the interval starts one key before
+    size_t first = 1, count = lastKey;
+    while (count > 0) {
+        const size_t step = count / 2;
+        const size_t index = first + step;
+        if (getTime(index) <= time) {
+            first = index + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+
+    return first - 1;
+}
+
+} // namespace Animation
+} // namespace OSRE
@@ -0,0 +1,155 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Animation/AnimationSystem.h"
+#include "Animation/AnimatorComponent.h"
+#include "RenderBackend/RenderBackendService.h"
+#include "Threading/WorkerPool.h"
+
+#include <algorithm>
+
+namespace OSRE::Animation {
+
+using namespace ::OSRE::RenderBackend;
+using namespace ::OSRE::Threading;
+
+// A character takes a few microseconds, smaller jobs would be dominated by the scheduling
+static constexpr size_t DefaultGrainSize = 8;
+
+AnimationSystem::AnimationSystem() :
+        mAnimators(),
+        mInstances(),
+        mPoseBuffer(),
+        mGrainSize(DefaultGrainSize) {
+    // empty
+}
+
+AnimationSystem::~AnimationSystem() {
+    for (AnimatorComponent *animator : mAnimators) {
+        animator->mSystem = nullptr;
+    }
+}
+
+void AnimationSystem::addAnimator(AnimatorComponent *animator) {
+    if (animator == nullptr || animator->mSystem == this) {
+        return;
+    }
+
+    if (animator->mSystem != nullptr) {
+        animator->mSystem->removeAnimator(animator);
+    }
+    animator->mSystem = this;
+    mAnimators.push_back(animator);
+}
+
+void AnimationSystem::removeAnimator(AnimatorComponent *animator) {
+    if (animator == nullptr || animator->mSystem != this) {
+        return;
+    }
+
+    animator->mSystem = nullptr;
+    mAnimators.erase(std::remove(mAnimators.begin(), mAnimators.end(), animator), mAnimators.end());
+    mInstances.erase(std::remove_if(mInstances.begin(), mInstances.end(), [animator](const Instance &instance) {
+        return instance.Animator == animator;
+    }), mInstances.end());
+}
+
+void AnimationSystem::update(Time dt) {
+    // Collect the active animators, animators sharing a clip will be evaluated side by side
+    mInstances.resize(0);
+    for (AnimatorComponent *animator : mAnimators) {
+        const AnimationTrack *track = animator->getActiveClip();
+        if (track != nullptr) {
+            mInstances.push_back({ animator, track, 0, 0 });
+        }
+    }
+    std::stable_sort(mInstances.begin(), mInstances.end(), [](const Instance &lhs, const Instance &rhs) {
+        return lhs.Track < rhs.Track;
+    });
+
+    // Every animator only touches its own state, the tracks and rigs are shared read-only
+    const d32 seconds = static_cast<d32>(dt.asMicroSeconds()) / 1000000.0;
+    WorkerPool::getInstance().parallelFor(mInstances.size(), mGrainSize, [this, seconds](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            mInstances[i].Animator->evaluate(seconds);
+        }
+    });
+
+    // Pack the results into the pose buffer
+    size_t numMatrices = 0;
+    for (Instance &instance : mInstances) {
+        instance.Offset = numMatrices;
+        instance.Count = instance.Animator->getNumPoseMatrices();
+        numMatrices += instance.Count;
+    }
+    mPoseBuffer.resize(numMatrices);
+
+    WorkerPool::getInstance().parallelFor(mInstances.size(), mGrainSize, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Instance &instance = mInstances[i];
+            if (instance.Count != 0) {
+                const glm::mat4 *matrices = instance.Animator->getPoseMatrices();
+                std::copy(matrices, matrices + instance.Count, mPoseBuffer.begin() + instance.Offset);
+            }
+        }
+    });
+}
+
+void AnimationSystem::upload(RenderBackendService *rbSrv) {
+    if (rbSrv == nullptr) {
+        return;
+    }
+
+    // Every character draws its meshes from its own batch, so the palettes will not overwrite each other
+    for (const Instance &instance : mInstances) {
+        const c8 *batchName = instance.Animator->getRenderBatchName();
+        if (instance.Count == 0 || batchName == nullptr) {
+            continue;
+        }
+
+        if (rbSrv->beginRenderBatch(batchName) == nullptr) {
+            return;
+        }
+
+        const ui32 numMatrices = static_cast<ui32>(instance.Count > MaxSkinningJoints ? MaxSkinningJoints : instance.Count);
+        rbSrv->setMatrixArray(SkinPaletteName, numMatrices, &mPoseBuffer[instance.Offset]);
+        rbSrv->endRenderBatch();
+    }
+}
+
+bool AnimationSystem::getPoseRange(const AnimatorComponent *animator, size_t &offset, size_t &count) const {
+    for (const Instance &instance : mInstances) {
+        if (instance.Animator == animator) {
+            offset = instance.Offset;
+            count = instance.Count;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void AnimationSystem::setGrainSize(size_t grainSize) {
+    mGrainSize = grainSize > 0 ? grainSize : 1;
+}
+
+} // namespace OSRE::Animation
@@ -0,0 +1,118 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+#include "Common/glm_common.h"
+
+#include <vector>
+
+namespace OSRE {
+
+// Forward declarations ---------------------------------------------------------------------------
+namespace RenderBackend {
+    class RenderBackendService;
+}
+
+namespace Animation {
+
+class AnimatorComponent;
+struct AnimationTrack;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class updates all registered animators of a scene in one data-parallel step.
+///
+/// The active animators will be sorted by the track of their base layer, so animators sampling the
+/// same clip will be evaluated one after another by the same worker. Each animator gets a range in
+/// one contiguous pose buffer, which holds the skinning palette or the channel transformations.
+/// The palettes will be uploaded from this buffer in one step, each into the batch of its animator.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT AnimationSystem {
+public:
+    /// @brief  The default class constructor.
+    AnimationSystem();
+
+    /// @brief  The class destructor, will release all animators.
+    ~AnimationSystem();
+
+    /// @brief  Will add an animator, the animator will not update itself anymore.
+    /// @param[in] animator The animator to add.
+    void addAnimator(AnimatorComponent *animator);
+
+    /// @brief  Will remove an animator.
+    /// @param[in] animator The animator to remove.
+    void removeAnimator(AnimatorComponent *animator);
+
+    /// @brief  Will return the number of registered animators.
+    /// @return The number of animators.
+    size_t getNumAnimators() const;
+
+    /// @brief  Will evaluate all active animators.
+    /// @param[in] dt   The time diff.
+    void update(Time dt);
+
+    /// @brief  Will upload the skinning palettes of all evaluated animators into their render batches.
+    /// @param[in] rbSrv    The render backend service, a pass must be active and no batch open.
+    void upload(RenderBackend::RenderBackendService *rbSrv);
+
+    /// @brief  Will return the contiguous pose buffer of the last update.
+    /// @return The pose buffer.
+    const std::vector<glm::mat4> &getPoseBuffer() const;
+
+    /// @brief  Will return the range of an animator in the pose buffer.
+    /// @param[in]  animator    The animator.
+    /// @param[out] offset      The first matrix.
+    /// @param[out] count       The number of matrices.
+    /// @return true if the animator was evaluated in the last update.
+    bool getPoseRange(const AnimatorComponent *animator, size_t &offset, size_t &count) const;
+
+    /// @brief  Will set the number of animators per job.
+    /// @param[in] grainSize    The number of animators, at least 1.
+    void setGrainSize(size_t grainSize);
+
+private:
+    struct Instance {
+        AnimatorComponent *Animator;
+        const AnimationTrack *Track;
+        size_t Offset;
+        size_t Count;
+    };
+
+    std::vector<AnimatorComponent *> mAnimators;
+    std::vector<Instance> mInstances;
+    std::vector<glm::mat4> mPoseBuffer;
+    size_t mGrainSize;
+};
+
+inline size_t AnimationSystem::getNumAnimators() const {
+    return mAnimators.size();
+}
+
+inline const std::vector<glm::mat4> &AnimationSystem::getPoseBuffer() const {
+    return mPoseBuffer;
+}
+
+} // namespace Animation
+} // namespace OSRE
@@ -121,11 +121,12 @@ struct ScalingKey {
 using ScalingKeyArray = ::cppcore::TArray<ScalingKey>;
 
 struct AnimationChannel {
+    String NodeName;    ///< The name of the animated node or bone.
     VectorKeyArray PositionKeys;
     RotationKeyArray RotationKeys;
     ScalingKeyArray ScalingKeys;
     
-    AnimationChannel() : PositionKeys(), RotationKeys(), ScalingKeys() {
+    AnimationChannel() : NodeName(), PositionKeys(), RotationKeys(), ScalingKeys() {
         // empty
     }
 
@@ -21,7 +21,13 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "Animation/AnimatorComponent.h"
+#include "Animation/AnimationSystem.h"
 #include "Common/Logger.h"
+#include "RenderBackend/RenderBackendService.h"
+
+#include <algorithm>
+#include <deque>
+#include <mutex>
 
 
 namespace OSRE::Animation {
@@ -30,17 +36,44 @@ using namespace OSRE::App;
 
 static constexpr c8 Tag[] = "AnimatorComponent";
 
+// The render batches keep the pointer to their name, so the names will stay valid until the shutdown
+static const c8 *createRenderBatchName() {
+    static std::mutex nameMutex;
+    static std::deque<String> names;
+
+    std::lock_guard<std::mutex> lock(nameMutex);
+    names.push_back("skin." + std::to_string(names.size()));
+
+    return names.back().c_str();
+}
+
 AnimatorComponent::AnimatorComponent(Entity *owner) :
         Component(owner, ComponentType::AnimationComponentType),
-        mActiveTrack(),
+        mAnimationTrackArray(),
+        mOwnedTracks(),
+        mActiveTrack(0),
         mTransformArray(),
-        mLastPositions(),
-        mLastRotations(),
-        mLastScales(),
-        mLastTime(0.0) {
+        mLayers(1),
+        mNumSlots(0),
+        mPose(),
+        mLayerPose(),
+        mClipPose(),
+        mSkeletonPose(),
+        mRotationBlendMode(RotationBlendMode::Slerp),
+        mSystem(nullptr),
+        mRenderBatchName(nullptr) {
     // empty
 }
 
+AnimatorComponent::~AnimatorComponent() {
+    if (mSystem != nullptr) {
+        mSystem->removeAnimator(this);
+    }
+    for (size_t i = 0; i < mOwnedTracks.size(); ++i) {
+        delete mOwnedTracks[i];
+    }
+}
+
 void AnimatorComponent::addTrack(AnimationTrack *track) {
     if (track == nullptr) {
         osre_error(Tag, "Invalid animation track instance.");
@@ -49,12 +82,12 @@ void AnimatorComponent::addTrack(AnimationTrack *track) {
 
     const size_t lastTrack = mAnimationTrackArray.size();
     mAnimationTrackArray.add(track);
-    mTransformArray.add(glm::mat4(1.0f));
     selectTrack(lastTrack);
 }
 
 AnimationTrack *AnimatorComponent::createAnimation() {
     AnimationTrack *track = new AnimationTrack;
+    mOwnedTracks.add(track);
     addTrack(track);
 
     return track;    
@@ -70,154 +103,441 @@ AnimationTrack *AnimatorComponent::getTrackAt(size_t index) const {
 }
 
 bool AnimatorComponent::selectTrack(size_t index) {
+    return crossFade(index, 0.0f, 0);
+}
+
+size_t AnimatorComponent::getActiveTrack() const {
+    return mActiveTrack;
+}
+
+bool AnimatorComponent::crossFade(size_t index, f32 seconds, size_t layer) {
     if (index >= mAnimationTrackArray.size()) {
         osre_error(Tag, "Invalid animation track index.");
         return false;
     }
 
-    mActiveTrack = index;
+    if (layer >= mLayers.size()) {
+        osre_error(Tag, "Invalid animation layer index.");
+        return false;
+    }
+
+    // Fade all playing clips out, a fade time of zero will switch immediately
+    const f32 fadeRate = seconds > 0.0f ? 1.0f / seconds : 0.0f;
+    std::vector<ClipState> &clips = mLayers[layer].Clips;
+    for (ClipState &clip : clips) {
+        clip.TargetWeight = 0.0f;
+        clip.FadeRate = fadeRate;
+        if (fadeRate == 0.0f) {
+            clip.Weight = 0.0f;
+        }
+    }
+    clips.erase(std::remove_if(clips.begin(), clips.end(), [](const ClipState &clip) {
+        return clip.Weight <= 0.0f;
+    }), clips.end());
+
+    ClipState *clip = getClip(layer, index, true);
+    clip->TargetWeight = 1.0f;
+    clip->FadeRate = fadeRate;
+    if (fadeRate == 0.0f) {
+        clip->Weight = 1.0f;
+    }
+
+    if (layer == 0) {
+        mActiveTrack = index;
+    }
+    updateSlots();
 
     return true;
 }
 
-size_t AnimatorComponent::getActiveTrack() const {
-    return mActiveTrack;
-}
+bool AnimatorComponent::play(size_t index, f32 weight, size_t layer) {
+    if (index >= mAnimationTrackArray.size()) {
+        osre_error(Tag, "Invalid animation track index.");
+        return false;
+    }
 
-bool AnimatorComponent::onUpdate(Time dt) {
-    AnimationTrack *track = getTrackAt(mActiveTrack);
-    if (track == nullptr) {
+    if (layer >= mLayers.size()) {
+        osre_error(Tag, "Invalid animation layer index.");
+        return false;
+    }
+
+    if (weight <= 0.0f) {
+        std::vector<ClipState> &clips = mLayers[layer].Clips;
+        clips.erase(std::remove_if(clips.begin(), clips.end(), [index](const ClipState &clip) {
+            return clip.Track == index;
+        }), clips.end());
+        updateSlots();
         return true;
     }
 
-    // calculate the time
-    double time = static_cast<d32>(dt.asMilliSeconds()) / 1000.0f;
-    const double ticksPerSecond = track->ticksPerSecond != 0.0 ? track->ticksPerSecond : 25.0;
-    
-    // every following time calculation happens in ticks
-    time *= ticksPerSecond;
+    ClipState *clip = getClip(layer, index, true);
+    clip->Weight = weight;
+    clip->TargetWeight = weight;
+    clip->FadeRate = 0.0f;
+    if (layer == 0) {
+        mActiveTrack = index;
+    }
+    updateSlots();
+
+    return true;
+}
+
+size_t AnimatorComponent::addLayer(LayerBlendMode mode, f32 weight) {
+    mLayers.emplace_back();
+    mLayers.back().Mode = mode;
+    mLayers.back().Weight = weight;
+
+    return mLayers.size() - 1;
+}
 
-    // map into animation track duration
-    if (track->duration > 0.0) {
-        time = fmod(time, track->duration);
+void AnimatorComponent::setLayerWeight(size_t layer, f32 weight) {
+    if (layer >= mLayers.size()) {
+        osre_error(Tag, "Invalid animation layer index.");
+        return;
     }
 
-    const size_t currentAnimationTrack = getActiveTrack();
+    mLayers[layer].Weight = weight;
+}
 
-    AnimationChannel &animChannel = track->animationChannels[currentAnimationTrack];
-    glm::vec3 presentPosition(0, 0, 0);
-    glm::quat q(0, 0, 0, 1);
-    glm::vec3 presenceScale(1, 1, 1);
-    if (!animChannel.PositionKeys.isEmpty()) {
-        if (mLastPositions.empty()) {
-            mLastPositions.resize(animChannel.PositionKeys.size());
-        }
+void AnimatorComponent::setLayerMask(size_t layer, const std::vector<f32> &mask) {
+    if (layer >= mLayers.size()) {
+        osre_error(Tag, "Invalid animation layer index.");
+        return;
+    }
 
-        for (size_t keyIndex = 0; keyIndex < animChannel.PositionKeys.size(); ++keyIndex) {
-                
-            size_t animFrameIndex = (time > mLastTime) ? std::get<0>(mLastPositions[keyIndex]) : 0;
-            while (animFrameIndex < animChannel.PositionKeys.size() - 1) {
-                if (time < animChannel.PositionKeys[animFrameIndex + 1].Time) {
-                    break;
-                }
-                ++animFrameIndex;
-            }
-            size_t nextFrame = (animFrameIndex + 1) % animChannel.PositionKeys.size();
-            VectorKey &key = animChannel.PositionKeys[keyIndex];
-            VectorKey &nextKey = animChannel.PositionKeys[nextFrame];
-            double diffTime = nextKey.Time - key.Time;
-            if (diffTime < 0.0) {
-                diffTime += track->duration;
-            }
-            if (diffTime > 0) {
-                float factor = float((time - key.Time) / diffTime);
-                presentPosition = key.Value + (nextKey.Value - key.Value) * factor;
-            } else {
-                presentPosition = key.Value;
-            }
+    mLayers[layer].Mask = mask;
+}
 
-            std::get<0>(mLastPositions[keyIndex]) = animFrameIndex;
-        }   
+void AnimatorComponent::stopLayer(size_t layer) {
+    if (layer >= mLayers.size()) {
+        osre_error(Tag, "Invalid animation layer index.");
+        return;
     }
 
-    if (!animChannel.RotationKeys.isEmpty()) {
-        if (mLastRotations.empty()) {
-            mLastRotations.resize(animChannel.RotationKeys.size());
+    mLayers[layer].Clips.clear();
+    updateSlots();
+}
+
+void AnimatorComponent::seek(d32 ticks) {
+    // The cursors will be fixed up by a binary search during the next update
+    ClipState *clip = getClip(0, mActiveTrack, false);
+    if (clip != nullptr) {
+        clip->Time = ticks < 0.0 ? 0.0 : ticks;
+    }
+}
+
+d32 AnimatorComponent::getTrackTime() const {
+    for (const ClipState &clip : mLayers[0].Clips) {
+        if (clip.Track == mActiveTrack) {
+            return clip.Time;
         }
+    }
 
-        for (size_t keyIndex = 0; keyIndex < animChannel.RotationKeys.size(); ++keyIndex) {
-            size_t animFrameIndex = (time > mLastTime) ? std::get<0>(mLastRotations[keyIndex]) : 0;
-            while (animFrameIndex < animChannel.RotationKeys.size() - 1) {
-                if (time < animChannel.RotationKeys[animFrameIndex + 1].Time) {
-                    break;
-                }
-                ++animFrameIndex;
+    return 0.0;
+}
+
+void AnimatorComponent::setSkeletonRig(const SkeletonRig *rig) {
+    if (rig != nullptr && rig->getNumJoints() > RenderBackend::MaxSkinningJoints) {
+        osre_warn(Tag, "Too many joints for the skinning palette, skeleton will be clamped.");
+    }
+
+    if (rig != nullptr && mRenderBatchName == nullptr) {
+        mRenderBatchName = createRenderBatchName();
+    }
+
+    mSkeletonPose.setRig(rig);
+    initAnimations();
+}
+
+bool AnimatorComponent::onUpdate(Time dt) {
+    // The animation system will evaluate all animators of a scene at once
+    if (mSystem == nullptr) {
+        evaluate(static_cast<d32>(dt.asMicroSeconds()) / 1000000.0);
+    }
+
+    return true;
+}
+
+void AnimatorComponent::evaluate(d32 seconds) {
+    if (mAnimationTrackArray.isEmpty()) {
+        return;
+    }
+
+    // Advance the clips, every following time calculation happens in ticks
+    bool rebound = false;
+    for (Layer &layer : mLayers) {
+        for (ClipState &clip : layer.Clips) {
+            const AnimationTrack *track = mAnimationTrackArray[clip.Track];
+            if (track == nullptr) {
+                continue;
             }
-            size_t nextFrame = (animFrameIndex + 1) % animChannel.RotationKeys.size();
-            RotationKey &key = animChannel.RotationKeys[keyIndex];
-            RotationKey &nextKey = animChannel.RotationKeys[nextFrame];
-            double diffTime = nextKey.Time - key.Time;
-            if (diffTime < 0.0) {
-                diffTime += track->duration;
+
+            // channels can be added after the track was selected
+            if (clip.NumChannels != track->numVectorChannels) {
+                bindClip(clip);
+                rebound = true;
+            }
+
+            const d32 ticksPerSecond = track->ticksPerSecond != 0.0f ? track->ticksPerSecond : 25.0;
+            clip.Time += seconds * ticksPerSecond;
+            if (track->duration > 0.0f) {
+                clip.Time = fmod(clip.Time, static_cast<d32>(track->duration));
             }
-            if (diffTime > 0) {
-                f32 factor = f32((time - key.Time) / diffTime);
-                q = key.Quad + (nextKey.Quad - key.Quad) * factor;
-            } else {
-                q = key.Quad;
+
+            if (clip.FadeRate <= 0.0f) {
+                clip.Weight = clip.TargetWeight;
+            } else if (clip.Weight < clip.TargetWeight) {
+                clip.Weight = std::min(clip.TargetWeight, clip.Weight + clip.FadeRate * static_cast<f32>(seconds));
+            } else if (clip.Weight > clip.TargetWeight) {
+                clip.Weight = std::max(clip.TargetWeight, clip.Weight - clip.FadeRate * static_cast<f32>(seconds));
             }
-            std::get<0>(mLastRotations[keyIndex]) = animFrameIndex;
         }
+
+        // Faded out clips are done
+        layer.Clips.erase(std::remove_if(layer.Clips.begin(), layer.Clips.end(), [](const ClipState &clip) {
+            return clip.Weight <= 0.0f && clip.TargetWeight <= 0.0f;
+        }), layer.Clips.end());
+    }
+
+    if (rebound) {
+        updateSlots();
+    }
+
+    if (mNumSlots == 0) {
+        return;
+    }
+
+    // Start with the rest pose and apply all layers from the bottom to the top
+    const SkeletonRig *rig = mSkeletonPose.getRig();
+    if (rig != nullptr) {
+        mPose = rig->getBindLocalPose();
+    } else {
+        mPose.setIdentity();
     }
 
-    if (!animChannel.ScalingKeys.isEmpty()) {
-        if (mLastScales.empty()) {
-            mLastScales.resize(animChannel.ScalingKeys.size());
+    for (Layer &layer : mLayers) {
+        f32 totalWeight = 0.0f;
+        if (!evaluateLayer(layer, mLayerPose, totalWeight)) {
+            continue;
         }
 
-        for (size_t keyIndex = 0; keyIndex < animChannel.ScalingKeys.size(); ++keyIndex) {
-            size_t animFrameIndex = (time > mLastTime) ? std::get<0>(mLastScales[keyIndex]) : 0;
-            while (animFrameIndex < animChannel.ScalingKeys.size() - 1) {
-                if (time < animChannel.ScalingKeys[animFrameIndex + 1].Time) {
-                    break;
-                }
-                ++animFrameIndex;
-            }
-            size_t nextFrame = (animFrameIndex + 1) % animChannel.RotationKeys.size();
-            ScalingKey &key = animChannel.ScalingKeys[keyIndex];
-            ScalingKey &nextKey = animChannel.ScalingKeys[nextFrame];
-            double diffTime = nextKey.Time - key.Time;
-            if (diffTime < 0.0) {
-                diffTime += track->duration;
-            }
-            if (diffTime > 0) {
-                f32 factor = f32((time - key.Time) / diffTime);
-                presenceScale = key.Scale + (nextKey.Scale - key.Scale) * factor;
-            } else {
-                presenceScale = key.Scale;
-            }
-            std::get<0>(mLastScales[keyIndex]) = animFrameIndex;
+        const f32 weight = layer.Weight * (totalWeight < 1.0f ? totalWeight : 1.0f);
+        const f32 *mask = layer.Mask.size() >= mNumSlots ? layer.Mask.data() : nullptr;
+        if (layer.Mode == LayerBlendMode::Additive) {
+            PoseBlender::addAdditive(mPose, mLayerPose, weight, mask);
+        } else if (weight >= 1.0f && mask == nullptr) {
+            std::swap(mPose, mLayerPose);
+        } else {
+            PoseBlender::blend(mPose, mLayerPose, weight, mask);
         }
     }
 
-    glm::mat4 &transform = mTransformArray[currentAnimationTrack];
-    transform = toMat4(q);
-    transform = scale(transform, presenceScale);
-    transform = translate(transform, presentPosition);
-
-    return true;
+    if (rig != nullptr) {
+        mSkeletonPose.setLocalPose(mPose);
+        mSkeletonPose.buildPalette();
+    } else {
+        PoseBlender::toMatrices(mPose, &mTransformArray[0]);
+    }
 }
 
 bool AnimatorComponent::onRender(RenderBackend::RenderBackendService *renderBackendSrv) {
     osre_assert(renderBackendSrv != nullptr);
 
+    // The palette of an evaluated animator will be uploaded from the pose buffer of the animation system,
+    // the scene renders the entity into the batch of the animator
+    if (mSystem != nullptr && getActiveClip() != nullptr) {
+        return true;
+    }
+
+    const size_t numJoints = mSkeletonPose.getNumJoints();
+    if (numJoints == 0) {
+        return true;
+    }
+
+    const ui32 numMatrices = static_cast<ui32>(numJoints > RenderBackend::MaxSkinningJoints ? RenderBackend::MaxSkinningJoints : numJoints);
+    renderBackendSrv->setMatrixArray(RenderBackend::SkinPaletteName, numMatrices, mSkeletonPose.getPalette());
+
     return true;
 }
 
 void AnimatorComponent::initAnimations() {
-    for (size_t index = 0; index < mAnimationTrackArray.size(); ++index) {
-        mTransformArray[index] = glm::mat4(1.0f);
+    for (Layer &layer : mLayers) {
+        for (ClipState &clip : layer.Clips) {
+            clip.Time = 0.0;
+            bindClip(clip);
+        }
+    }
+    updateSlots();
+
+    if (mSkeletonPose.getRig() != nullptr) {
+        mSkeletonPose.buildPalette();
+    }
+}
+
+const AnimationTrack *AnimatorComponent::getActiveClip() const {
+    return mActiveTrack < mAnimationTrackArray.size() ? mAnimationTrackArray[mActiveTrack] : nullptr;
+}
+
+size_t AnimatorComponent::getNumPoseMatrices() const {
+    return mSkeletonPose.getRig() != nullptr ? mSkeletonPose.getNumJoints() : mTransformArray.size();
+}
+
+const glm::mat4 *AnimatorComponent::getPoseMatrices() const {
+    if (mSkeletonPose.getRig() != nullptr) {
+        return mSkeletonPose.getPalette();
+    }
+
+    return mTransformArray.isEmpty() ? nullptr : &mTransformArray[0];
+}
+
+AnimatorComponent::ClipState *AnimatorComponent::getClip(size_t layer, size_t index, bool create) {
+    if (layer >= mLayers.size()) {
+        return nullptr;
     }
+
+    std::vector<ClipState> &clips = mLayers[layer].Clips;
+    for (ClipState &clip : clips) {
+        if (clip.Track == index) {
+            return &clip;
+        }
+    }
+
+    if (!create) {
+        return nullptr;
+    }
+
+    clips.emplace_back();
+    ClipState &clip = clips.back();
+    clip.Track = index;
+    bindClip(clip);
+
+    return &clip;
+}
+
+void AnimatorComponent::bindClip(ClipState &clip) {
+    const AnimationTrack *track = mAnimationTrackArray[clip.Track];
+    clip.NumChannels = track != nullptr ? track->numVectorChannels : 0;
+    const SkeletonRig *rig = mSkeletonPose.getRig();
+    if (rig != nullptr && track != nullptr) {
+        rig->createChannelMap(*track, clip.SlotToChannel);
+    } else {
+        // Without a rig every channel drives its own slot
+        clip.SlotToChannel.resize(clip.NumChannels);
+        for (size_t i = 0; i < clip.NumChannels; ++i) {
+            clip.SlotToChannel[i] = static_cast<i32>(i);
+        }
+    }
+    clip.Cursors.assign(clip.SlotToChannel.size(), KeyCursor());
+
+    // The additive reference will be sampled again with the next evaluation
+    clip.Reference.resize(0);
+}
+
+void AnimatorComponent::updateSlots() {
+    const SkeletonRig *rig = mSkeletonPose.getRig();
+    size_t numSlots = 0;
+    if (rig != nullptr) {
+        numSlots = rig->getNumJoints();
+    } else {
+        for (const Layer &layer : mLayers) {
+            for (const ClipState &clip : layer.Clips) {
+                numSlots = std::max(numSlots, clip.SlotToChannel.size());
+            }
+        }
+    }
+
+    const size_t numTransforms = rig != nullptr ? 0 : numSlots;
+    if (numSlots == mNumSlots && mPose.size() == numSlots && mTransformArray.size() == numTransforms) {
+        return;
+    }
+
+    mNumSlots = numSlots;
+    mPose.resize(numSlots);
+    mLayerPose.resize(numSlots);
+    mClipPose.resize(numSlots);
+    mTransformArray.resize(numTransforms);
+    for (size_t i = 0; i < numTransforms; ++i) {
+        mTransformArray[i] = glm::mat4(1.0f);
+    }
+}
+
+void AnimatorComponent::sampleClip(ClipState &clip, d32 time, LocalPose &pose) {
+    const AnimationTrack *track = mAnimationTrackArray[clip.Track];
+    const SkeletonRig *rig = mSkeletonPose.getRig();
+    const LocalPose *bindPose = rig != nullptr ? &rig->getBindLocalPose() : nullptr;
+    const size_t numMapped = clip.SlotToChannel.size();
+    for (size_t slot = 0; slot < mNumSlots; ++slot) {
+        const i32 channel = slot < numMapped ? clip.SlotToChannel[slot] : -1;
+        if (track != nullptr && channel >= 0 &&
+                AnimationSampler::sample(*track, static_cast<size_t>(channel), time, clip.Cursors[slot], mRotationBlendMode,
+                        pose.Translations[slot], pose.Rotations[slot], pose.Scales[slot])) {
+            continue;
+        }
+
+        // Not animated, keep the rest pose
+        if (bindPose != nullptr && slot < bindPose->size()) {
+            pose.Translations[slot] = bindPose->Translations[slot];
+            pose.Rotations[slot] = bindPose->Rotations[slot];
+            pose.Scales[slot] = bindPose->Scales[slot];
+        } else {
+            pose.Translations[slot] = glm::vec3(0.0f);
+            pose.Rotations[slot] = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+            pose.Scales[slot] = glm::vec3(1.0f);
+        }
+    }
+}
+
+bool AnimatorComponent::evaluateLayer(Layer &layer, LocalPose &pose, f32 &totalWeight) {
+    totalWeight = 0.0f;
+    ClipState *single = nullptr;
+    size_t numActive = 0;
+    for (ClipState &clip : layer.Clips) {
+        if (clip.Weight > 0.0f) {
+            totalWeight += clip.Weight;
+            single = &clip;
+            ++numActive;
+        }
+    }
+
+    if (numActive == 0) {
+        return false;
+    }
+
+    const bool isAdditive = layer.Mode == LayerBlendMode::Additive;
+    if (isAdditive) {
+        // The first frame of an additive clip is the reference for its difference
+        for (ClipState &clip : layer.Clips) {
+            if (clip.Weight > 0.0f && clip.Reference.size() != mNumSlots) {
+                clip.Reference.resize(mNumSlots);
+                sampleClip(clip, 0.0, clip.Reference);
+            }
+        }
+    }
+
+    // A single clip needs no blending
+    if (numActive == 1) {
+        sampleClip(*single, single->Time, pose);
+        if (isAdditive) {
+            PoseBlender::makeAdditive(pose, single->Reference);
+        }
+        return true;
+    }
+
+    PoseBlender::clear(pose);
+    for (ClipState &clip : layer.Clips) {
+        if (clip.Weight <= 0.0f) {
+            continue;
+        }
+
+        sampleClip(clip, clip.Time, mClipPose);
+        if (isAdditive) {
+            PoseBlender::makeAdditive(mClipPose, clip.Reference);
+        }
+        PoseBlender::accumulate(pose, mClipPose, clip.Weight);
+    }
+    PoseBlender::normalize(pose, totalWeight);
+
+    return true;
 }
 
 } // namespace OSRE::Animation
@@ -24,64 +24,246 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "Common/osre_common.h"
 #include "Animation/AnimatorBase.h"
+#include "Animation/AnimationSampler.h"
+#include "Animation/AnimationCompression.h"
+#include "Animation/SkeletonRig.h"
+#include "Animation/PoseBlender.h"
 #include "App/Component.h"
 
 #include <vector>
-#include <tuple>
 
 namespace OSRE {
 namespace Animation {
 
+class AnimationSystem;
+
 /// @brief  This struct contains all the data for an animation track.
 struct AnimationTrack {
     f32 duration = 1.0f;
     f32 ticksPerSecond = 1.0f;
     size_t numVectorChannels = 0;
     AnimationChannel *animationChannels = nullptr;
+    CompressedClip *compressedClip = nullptr;   ///< Optional compressed keys, will be preferred for sampling.
 
     AnimationTrack() = default;
     ~AnimationTrack() {
         delete [] animationChannels;
+        delete compressedClip;
     }
 };
 
 /// The animation track array.
 using AnimationTrackArray = cppcore::TArray<AnimationTrack *>;
 
+/// @brief Describes how an animation layer is combined with the layers below.
+enum class LayerBlendMode {
+    Override = 0,   ///< The layer pose replaces the pose below by the layer weight.
+    Additive        ///< The difference of the layer pose to its first frame is added to the pose below.
+};
+
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
 ///	@brief This class implements the animation component. 
 /// 
-/// As a user you can add single animation tracks to the component. When applying an animation you
-/// first need to choose the track. This active animation track will be selected and updated.
+/// As a user you can add single animation tracks to the component. The tracks will be played in
+/// layers. Each layer holds a set of weighted clips, which will be blended into one local pose:
+///  - selectTrack will replace the clips of the base layer.
+///  - crossFade will fade the clips of a layer out while fading the new track in.
+///  - play will set the weight of a track directly, which is used to drive blend trees.
+/// Layers above the base layer will be applied by their weight and an optional joint mask, as
+/// override or additive layer. When a skeleton rig is assigned, the channels will drive the joints
+/// of the rig and the skinning palette will be uploaded for the skinning shader. Each rigged animator
+/// uses its own render batch, so every character keeps its palette. Without a rig every channel
+/// will be sampled into its own local transformation.
+/// Animators of entities in a scene will be evaluated by the AnimationSystem of the scene.
 //-------------------------------------------------------------------------------------------------
 class OSRE_EXPORT AnimatorComponent : public App::Component {
     using TransformArray = cppcore::TArray<glm::mat4>;
 
 public:
     AnimatorComponent(App::Entity *owner);
-    ~AnimatorComponent() override = default;
+    ~AnimatorComponent() override;
     void addTrack(AnimationTrack *track);
+
+    /// @brief Will create a new track, it is owned by the component.
+    /// @return The new track.
     AnimationTrack *createAnimation();
     AnimationTrack *getTrackAt(size_t index) const;
     bool selectTrack(size_t index);
     size_t getActiveTrack() const;
 
+    /// @brief Will fade from the clips of a layer to a new track.
+    /// @param[in] index    The track index.
+    /// @param[in] seconds  The fade time, 0 to switch immediately.
+    /// @param[in] layer    The layer index.
+    /// @return true if successful, false in case of an invalid index.
+    bool crossFade(size_t index, f32 seconds, size_t layer = 0);
+
+    /// @brief Will set the blend weight of a track in a layer, the track will be added if needed.
+    /// @param[in] index    The track index.
+    /// @param[in] weight   The blend weight, a weight of 0 will remove the track from the layer.
+    /// @param[in] layer    The layer index.
+    /// @return true if successful, false in case of an invalid index.
+    bool play(size_t index, f32 weight, size_t layer = 0);
+
+    /// @brief Will add a new layer on top of the existing layers.
+    /// @param[in] mode     The blend mode of the layer.
+    /// @param[in] weight   The layer weight.
+    /// @return The index of the new layer.
+    size_t addLayer(LayerBlendMode mode, f32 weight = 1.0f);
+
+    /// @brief Will return the number of layers, there is always a base layer.
+    /// @return The number of layers.
+    size_t getNumLayers() const;
+
+    /// @brief Will set the weight of a layer.
+    /// @param[in] layer    The layer index.
+    /// @param[in] weight   The new weight.
+    void setLayerWeight(size_t layer, f32 weight);
+
+    /// @brief Will set the joint mask of a layer.
+    /// @param[in] layer    The layer index.
+    /// @param[in] mask     The weight for each joint or channel, an empty mask will affect all.
+    void setLayerMask(size_t layer, const std::vector<f32> &mask);
+
+    /// @brief Will remove all clips from a layer.
+    /// @param[in] layer    The layer index.
+    void stopLayer(size_t layer);
+
+    /// @brief Will move the playback of the active track to the given time.
+    /// @param[in] ticks    The new time in ticks.
+    void seek(d32 ticks);
+
+    /// @brief Will return the current playback time of the active track.
+    /// @return The time in ticks.
+    d32 getTrackTime() const;
+
+    /// @brief Will set the interpolation mode for rotation keys.
+    /// @param[in] mode     The new mode.
+    void setRotationBlendMode(RotationBlendMode mode);
+
+    /// @brief Will return the interpolation mode for rotation keys.
+    /// @return The mode.
+    RotationBlendMode getRotationBlendMode() const;
+
+    /// @brief Will return the number of sampled channel transformations.
+    /// @return The number of animated channels.
+    size_t getNumChannelTransforms() const;
+
+    /// @brief Will return the sampled local transformation of a channel.
+    /// @param[in] channel  The channel index.
+    /// @return The local transformation.
+    const glm::mat4 &getChannelTransform(size_t channel) const;
+
+    /// @brief Will return the blended local pose.
+    /// @return The local pose.
+    const LocalPose &getLocalPose() const;
+
+    /// @brief Will assign the skeleton rig to animate.
+    /// @param[in] rig      The rig, must stay valid during the lifetime of the component.
+    void setSkeletonRig(const SkeletonRig *rig);
+
+    /// @brief Will return the evaluated skeleton pose.
+    /// @return The skeleton pose.
+    const SkeletonPose &getSkeletonPose() const;
+
+    /// @brief Will return true, when a skeleton rig is assigned.
+    /// @return true for a rig.
+    bool hasSkeletonRig() const;
+
+    /// @brief Will return the name of the render batch, which holds the meshes and the skinning palette.
+    /// @return The batch name, nullptr without a rig.
+    const c8 *getRenderBatchName() const;
+
 protected:
     bool onUpdate(Time dt) override;
     bool onRender(RenderBackend::RenderBackendService *renderBackendSrv) override;
     void initAnimations();
 
+private:
+    friend class AnimationSystem;
+
+    struct ClipState {
+        size_t Track = 0;
+        size_t NumChannels = 0;
+        d32 Time = 0.0;
+        f32 Weight = 0.0f;
+        f32 TargetWeight = 0.0f;
+        f32 FadeRate = 0.0f;
+        std::vector<KeyCursor> Cursors;
+        std::vector<i32> SlotToChannel;
+        LocalPose Reference;
+    };
+
+    struct Layer {
+        LayerBlendMode Mode = LayerBlendMode::Override;
+        f32 Weight = 1.0f;
+        std::vector<f32> Mask;
+        std::vector<ClipState> Clips;
+    };
+
+    ClipState *getClip(size_t layer, size_t index, bool create);
+    void bindClip(ClipState &clip);
+    void updateSlots();
+    void sampleClip(ClipState &clip, d32 time, LocalPose &pose);
+    bool evaluateLayer(Layer &layer, LocalPose &pose, f32 &totalWeight);
+    void evaluate(d32 seconds);
+    const AnimationTrack *getActiveClip() const;
+    size_t getNumPoseMatrices() const;
+    const glm::mat4 *getPoseMatrices() const;
+
 private:
     AnimationTrackArray mAnimationTrackArray;
+    AnimationTrackArray mOwnedTracks;
     size_t mActiveTrack;
     TransformArray mTransformArray;
-    std::vector<std::tuple<size_t, size_t, size_t>> mLastPositions;
-    std::vector<std::tuple<size_t, size_t, size_t>> mLastRotations;
-    std::vector<std::tuple<size_t, size_t, size_t>> mLastScales;
-    double mLastTime;
+    std::vector<Layer> mLayers;
+    size_t mNumSlots;
+    LocalPose mPose;
+    LocalPose mLayerPose;
+    LocalPose mClipPose;
+    SkeletonPose mSkeletonPose;
+    RotationBlendMode mRotationBlendMode;
+    AnimationSystem *mSystem;
+    const c8 *mRenderBatchName;
 };
 
+inline size_t AnimatorComponent::getNumLayers() const {
+    return mLayers.size();
+}
+
+inline void AnimatorComponent::setRotationBlendMode(RotationBlendMode mode) {
+    mRotationBlendMode = mode;
+}
+
+inline RotationBlendMode AnimatorComponent::getRotationBlendMode() const {
+    return mRotationBlendMode;
+}
+
+inline size_t AnimatorComponent::getNumChannelTransforms() const {
+    return mTransformArray.size();
+}
+
+inline const glm::mat4 &AnimatorComponent::getChannelTransform(size_t channel) const {
+    return mTransformArray[channel];
+}
+
+inline const LocalPose &AnimatorComponent::getLocalPose() const {
+    return mPose;
+}
+
+inline const SkeletonPose &AnimatorComponent::getSkeletonPose() const {
+    return mSkeletonPose;
+}
+
+inline bool AnimatorComponent::hasSkeletonRig() const {
+    return mSkeletonPose.getRig() != nullptr;
+}
+
+inline const c8 *AnimatorComponent::getRenderBatchName() const {
+    return hasSkeletonRig() ? mRenderBatchName : nullptr;
+}
+
 } // namespace Animation
 } // namespace OSRE
@@ -0,0 +1,141 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Animation/PoseBlender.h"
+#include "Common/BatchMath.h"
+
+#include <algorithm>
+
+namespace OSRE::Animation {
+
+using namespace ::OSRE::Common;
+
+namespace {
+
+    glm::quat nlerpShortest(const glm::quat &a, const glm::quat &b, f32 t) {
+        const f32 sign = glm::dot(a, b) < 0.0f ? -1.0f : 1.0f;
+        return glm::normalize(a * (1.0f - t) + b * (sign * t));
+    }
+
+} // namespace
+
+void LocalPose::resize(size_t numJoints) {
+    Translations.resize(numJoints, glm::vec3(0.0f));
+    Rotations.resize(numJoints, glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    Scales.resize(numJoints, glm::vec3(1.0f));
+}
+
+void LocalPose::setIdentity() {
+    std::fill(Translations.begin(), Translations.end(), glm::vec3(0.0f));
+    std::fill(Rotations.begin(), Rotations.end(), glm::quat(1.0f, 0.0f, 0.0f, 0.0f));
+    std::fill(Scales.begin(), Scales.end(), glm::vec3(1.0f));
+}
+
+void PoseBlender::clear(LocalPose &pose) {
+    std::fill(pose.Translations.begin(), pose.Translations.end(), glm::vec3(0.0f));
+    std::fill(pose.Rotations.begin(), pose.Rotations.end(), glm::quat(0.0f, 0.0f, 0.0f, 0.0f));
+    std::fill(pose.Scales.begin(), pose.Scales.end(), glm::vec3(0.0f));
+}
+
+void PoseBlender::accumulate(LocalPose &accum, const LocalPose &pose, f32 weight) {
+    const size_t numJoints = accum.size() < pose.size() ? accum.size() : pose.size();
+    for (size_t i = 0; i < numJoints; ++i) {
+        accum.Translations[i] += pose.Translations[i] * weight;
+    }
+
+    // Keep all rotations in the hemisphere of the sum, q and -q would cancel each other out
+    for (size_t i = 0; i < numJoints; ++i) {
+        const f32 sign = glm::dot(accum.Rotations[i], pose.Rotations[i]) < 0.0f ? -weight : weight;
+        accum.Rotations[i] = accum.Rotations[i] + pose.Rotations[i] * sign;
+    }
+
+    for (size_t i = 0; i < numJoints; ++i) {
+        accum.Scales[i] += pose.Scales[i] * weight;
+    }
+}
+
+void PoseBlender::normalize(LocalPose &accum, f32 totalWeight) {
+    if (totalWeight <= 0.0f) {
+        accum.setIdentity();
+        return;
+    }
+
+    const f32 invWeight = 1.0f / totalWeight;
+    for (size_t i = 0; i < accum.size(); ++i) {
+        accum.Translations[i] *= invWeight;
+    }
+
+    for (size_t i = 0; i < accum.size(); ++i) {
+        const f32 len = glm::length(accum.Rotations[i]);
+        accum.Rotations[i] = len > 0.0f ? accum.Rotations[i] * (1.0f / len) : glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+    }
+
+    for (size_t i = 0; i < accum.size(); ++i) {
+        accum.Scales[i] *= invWeight;
+    }
+}
+
+void PoseBlender::blend(LocalPose &target, const LocalPose &source, f32 weight, const f32 *mask) {
+    // Every array is blended in one vectorized pass
+    const size_t numJoints = target.size() < source.size() ? target.size() : source.size();
+    BatchMath::lerpVectors(target.Translations.data(), source.Translations.data(), weight, mask, numJoints);
+    BatchMath::nlerpRotations(target.Rotations.data(), source.Rotations.data(), weight, mask, numJoints);
+    BatchMath::lerpVectors(target.Scales.data(), source.Scales.data(), weight, mask, numJoints);
+}
+
+void PoseBlender::makeAdditive(LocalPose &pose, const LocalPose &reference) {
+    const size_t numJoints = pose.size() < reference.size() ? pose.size() : reference.size();
+    for (size_t i = 0; i < numJoints; ++i) {
+        pose.Translations[i] -= reference.Translations[i];
+        pose.Rotations[i] = glm::conjugate(reference.Rotations[i]) * pose.Rotations[i];
+        for (glm::length_t c = 0; c < 3; ++c) {
+            const f32 refScale = reference.Scales[i][c];
+            pose.Scales[i][c] = refScale != 0.0f ? pose.Scales[i][c] / refScale : 1.0f;
+        }
+    }
+}
+
+void PoseBlender::addAdditive(LocalPose &target, const LocalPose &additive, f32 weight, const f32 *mask) {
+    const glm::quat identity(1.0f, 0.0f, 0.0f, 0.0f);
+    const size_t numJoints = target.size() < additive.size() ? target.size() : additive.size();
+    for (size_t i = 0; i < numJoints; ++i) {
+        const f32 w = mask != nullptr ? weight * mask[i] : weight;
+        target.Translations[i] += additive.Translations[i] * w;
+        target.Rotations[i] = glm::normalize(target.Rotations[i] * nlerpShortest(identity, additive.Rotations[i], w));
+        target.Scales[i] = target.Scales[i] * (glm::vec3(1.0f) + (additive.Scales[i] - glm::vec3(1.0f)) * w);
+    }
+}
+
+void PoseBlender::toMatrices(const LocalPose &pose, glm::mat4 *transforms) {
+    if (transforms == nullptr) {
+        return;
+    }
+
+    for (size_t i = 0; i < pose.size(); ++i) {
+        glm::mat4 &transform = transforms[i];
+        transform = glm::translate(glm::mat4(1.0f), pose.Translations[i]);
+        transform *= glm::toMat4(pose.Rotations[i]);
+        transform = glm::scale(transform, pose.Scales[i]);
+    }
+}
+
+} // namespace OSRE::Animation
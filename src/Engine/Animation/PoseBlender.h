@@ -0,0 +1,113 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+
+#include <vector>
+
+namespace OSRE {
+namespace Animation {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief This struct stores the local transformations of a pose as separate arrays.
+///
+/// Translations, rotations and scalings are kept apart, so a blend touches each array in one
+/// linear pass.
+//-------------------------------------------------------------------------------------------------
+struct OSRE_EXPORT LocalPose {
+    std::vector<glm::vec3> Translations;
+    std::vector<glm::quat> Rotations;
+    std::vector<glm::vec3> Scales;
+
+    /// @brief Will resize the pose, new entries will be set to identity.
+    /// @param[in] numJoints    The number of joints.
+    void resize(size_t numJoints);
+
+    /// @brief Will return the number of joints.
+    /// @return The number of joints.
+    size_t size() const;
+
+    /// @brief Will set all joints to the identity transformation.
+    void setIdentity();
+};
+
+inline size_t LocalPose::size() const {
+    return Translations.size();
+}
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief This class implements the blend operations on local poses.
+///
+/// Rotations are blended by normalized linear interpolation. Weighted sums of any number of poses
+/// can be built by accumulating them and normalizing the result once, so the cost per pose stays
+/// the same for any number of blended clips.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT PoseBlender {
+public:
+    /// @brief Will clear an accumulation pose, all values will be set to zero.
+    /// @param[out] pose    The pose to clear.
+    static void clear(LocalPose &pose);
+
+    /// @brief Will add a weighted pose to an accumulation pose.
+    /// @param[inout] accum The accumulation pose.
+    /// @param[in] pose     The pose to add.
+    /// @param[in] weight   The weight of the pose.
+    static void accumulate(LocalPose &accum, const LocalPose &pose, f32 weight);
+
+    /// @brief Will turn the accumulated weighted sum into the blended pose.
+    /// @param[inout] accum     The accumulation pose.
+    /// @param[in] totalWeight  The sum of all accumulated weights.
+    static void normalize(LocalPose &accum, f32 totalWeight);
+
+    /// @brief Will blend a pose over the target pose.
+    /// @param[inout] target    The target pose.
+    /// @param[in] source       The pose to blend in.
+    /// @param[in] weight       The blend weight, 0 keeps the target, 1 takes the source.
+    /// @param[in] mask         Optional weights per joint, nullptr to blend all joints.
+    static void blend(LocalPose &target, const LocalPose &source, f32 weight, const f32 *mask = nullptr);
+
+    /// @brief Will convert a pose into the difference to a reference pose.
+    /// @param[inout] pose      The pose, will contain the difference.
+    /// @param[in] reference    The reference pose.
+    static void makeAdditive(LocalPose &pose, const LocalPose &reference);
+
+    /// @brief Will add a weighted difference pose to the target pose.
+    /// @param[inout] target    The target pose.
+    /// @param[in] additive     The difference pose, see makeAdditive.
+    /// @param[in] weight       The weight of the difference.
+    /// @param[in] mask         Optional weights per joint, nullptr to apply to all joints.
+    static void addAdditive(LocalPose &target, const LocalPose &additive, f32 weight, const f32 *mask = nullptr);
+
+    /// @brief Will convert a pose into local transformation matrices.
+    /// @param[in]  pose        The pose.
+    /// @param[out] transforms  The transformations, must have space for all joints of the pose.
+    static void toMatrices(const LocalPose &pose, glm::mat4 *transforms);
+};
+
+} // namespace Animation
+} // namespace OSRE
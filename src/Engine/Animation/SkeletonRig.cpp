@@ -0,0 +1,216 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Animation/SkeletonRig.h"
+#include "Animation/AnimatorComponent.h"
+#include "Common/Logger.h"
+
+namespace OSRE::Animation {
+
+DECL_OSRE_LOG_MODULE(SkeletonRig)
+
+bool SkeletonRig::create(const Skeleton &skeleton) {
+    clear();
+
+    const size_t numBones = skeleton.mBones.size();
+    if (numBones == 0) {
+        return true;
+    }
+
+    // Collect the children of every bone, invalid parents will be handled as roots
+    std::vector<std::vector<size_t>> children(numBones);
+    std::vector<size_t> order;
+    order.reserve(numBones);
+    for (size_t i = 0; i < numBones; ++i) {
+        const Bone *bone = skeleton.mBones[i];
+        if (bone == nullptr) {
+            osre_error(Tag, "Invalid bone in skeleton " + skeleton.mName);
+            return false;
+        }
+
+        const i32 parent = bone->mParent;
+        if (parent < 0 || static_cast<size_t>(parent) >= numBones || static_cast<size_t>(parent) == i) {
+            order.push_back(i);
+        } else {
+            children[parent].push_back(i);
+        }
+    }
+
+    // Breadth first, so every parent will be stored in front of its children
+    for (size_t i = 0; i < order.size(); ++i) {
+        for (size_t child : children[order[i]]) {
+            order.push_back(child);
+        }
+    }
+
+    if (order.size() != numBones) {
+        osre_error(Tag, "Cyclic bone hierarchy in skeleton " + skeleton.mName);
+        return false;
+    }
+
+    mBoneToJoint.assign(numBones, -1);
+    for (size_t joint = 0; joint < numBones; ++joint) {
+        mBoneToJoint[order[joint]] = static_cast<i32>(joint);
+    }
+
+    mParents.resize(numBones);
+    mNames.resize(numBones);
+    mBindPose.resize(numBones);
+    mInverseBind.resize(numBones);
+    cppcore::TArray<glm::mat4> bindModel;
+    bindModel.resize(numBones);
+    for (size_t joint = 0; joint < numBones; ++joint) {
+        const Bone *bone = skeleton.mBones[order[joint]];
+        const i32 parentBone = bone->mParent;
+        const bool isRoot = parentBone < 0 || static_cast<size_t>(parentBone) >= numBones || mBoneToJoint[parentBone] == static_cast<i32>(joint);
+        const i32 parent = isRoot ? -1 : mBoneToJoint[parentBone];
+        mParents[joint] = parent;
+        mNames[joint] = bone->mName;
+        mInverseBind[joint] = bone->m_offsetMatrix;
+        bindModel[joint] = glm::inverse(bone->m_offsetMatrix);
+        mBindPose[joint] = parent < 0 ? bindModel[joint] : glm::inverse(bindModel[parent]) * bindModel[joint];
+    }
+
+    // The blending works on separated components, so the bind pose will be decomposed once
+    mBindLocalPose.resize(numBones);
+    for (size_t joint = 0; joint < numBones; ++joint) {
+        const glm::mat4 &bind = mBindPose[joint];
+        glm::vec3 scale(glm::length(glm::vec3(bind[0])), glm::length(glm::vec3(bind[1])), glm::length(glm::vec3(bind[2])));
+        glm::mat3 rotation(1.0f);
+        for (glm::length_t c = 0; c < 3; ++c) {
+            if (scale[c] > 0.0f) {
+                rotation[c] = glm::vec3(bind[c]) / scale[c];
+            }
+        }
+        mBindLocalPose.Translations[joint] = glm::vec3(bind[3]);
+        mBindLocalPose.Rotations[joint] = glm::normalize(glm::quat_cast(rotation));
+        mBindLocalPose.Scales[joint] = scale;
+    }
+
+    return true;
+}
+
+void SkeletonRig::clear() {
+    mParents.clear();
+    mNames.clear();
+    mBoneToJoint.clear();
+    mBindPose.clear();
+    mInverseBind.clear();
+    mBindLocalPose.resize(0);
+}
+
+i32 SkeletonRig::findJoint(const String &name) const {
+    for (size_t i = 0; i < mNames.size(); ++i) {
+        if (mNames[i] == name) {
+            return static_cast<i32>(i);
+        }
+    }
+
+    return -1;
+}
+
+i32 SkeletonRig::getJointByBone(size_t bone) const {
+    if (bone >= mBoneToJoint.size()) {
+        return -1;
+    }
+
+    return mBoneToJoint[bone];
+}
+
+void SkeletonRig::createChannelMap(const AnimationTrack &track, std::vector<i32> &jointToChannel) const {
+    jointToChannel.assign(getNumJoints(), -1);
+    for (size_t channel = 0; channel < track.numVectorChannels; ++channel) {
+        const i32 joint = findJoint(AnimationSampler::getChannelName(track, channel));
+        if (joint != -1) {
+            jointToChannel[joint] = static_cast<i32>(channel);
+        }
+    }
+}
+
+SkeletonPose::SkeletonPose(const SkeletonRig *rig) :
+        mRig(nullptr),
+        mLocal(),
+        mModel(),
+        mPalette(),
+        mCursors() {
+    setRig(rig);
+}
+
+void SkeletonPose::setRig(const SkeletonRig *rig) {
+    mRig = rig;
+    const size_t numJoints = rig != nullptr ? rig->getNumJoints() : 0;
+    mLocal.resize(numJoints);
+    mModel.resize(numJoints);
+    mPalette.resize(numJoints);
+    mCursors.assign(numJoints, KeyCursor());
+    setBindPose();
+}
+
+void SkeletonPose::setBindPose() {
+    if (mRig == nullptr) {
+        return;
+    }
+
+    for (size_t joint = 0; joint < mLocal.size(); ++joint) {
+        mLocal[joint] = mRig->getBindPose(joint);
+    }
+}
+
+void SkeletonPose::sample(const AnimationTrack &track, const std::vector<i32> &jointToChannel, d32 time, RotationBlendMode mode) {
+    if (mRig == nullptr) {
+        return;
+    }
+
+    const size_t numJoints = jointToChannel.size() < mLocal.size() ? jointToChannel.size() : mLocal.size();
+    for (size_t joint = 0; joint < numJoints; ++joint) {
+        const i32 channel = jointToChannel[joint];
+        if (channel < 0 || static_cast<size_t>(channel) >= track.numVectorChannels) {
+            mLocal[joint] = mRig->getBindPose(joint);
+            continue;
+        }
+
+        mLocal[joint] = AnimationSampler::sample(track, static_cast<size_t>(channel), time, mCursors[joint], mode);
+    }
+}
+
+void SkeletonPose::setLocalPose(const LocalPose &pose) {
+    if (pose.size() != mLocal.size() || mLocal.isEmpty()) {
+        return;
+    }
+
+    PoseBlender::toMatrices(pose, &mLocal[0]);
+}
+
+void SkeletonPose::buildPalette() {
+    if (mRig == nullptr) {
+        return;
+    }
+
+    // Parents are stored in front of their children, so one pass will be enough
+    for (size_t joint = 0; joint < mLocal.size(); ++joint) {
+        const i32 parent = mRig->getParent(joint);
+        mModel[joint] = parent < 0 ? mLocal[joint] : mModel[parent] * mLocal[joint];
+        mPalette[joint] = mModel[joint] * mRig->getInverseBindMatrix(joint);
+    }
+}
+
+} // namespace OSRE::Animation
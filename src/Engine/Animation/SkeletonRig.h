@@ -0,0 +1,225 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+#include "Animation/AnimatorBase.h"
+#include "Animation/AnimationSampler.h"
+#include "Animation/PoseBlender.h"
+
+#include <vector>
+
+namespace OSRE {
+namespace Animation {
+
+struct AnimationTrack;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief This class stores the joint hierarchy of a skeleton in evaluation order.
+///
+/// The joints are sorted so that every parent is stored in front of its children. A pose can be
+/// evaluated in one flat pass over the joints this way. The rig will not be changed during
+/// playback and can be shared by all instances of a character.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT SkeletonRig {
+public:
+    /// @brief The default class constructor.
+    SkeletonRig() = default;
+
+    /// @brief The class destructor, default implementation.
+    ~SkeletonRig() = default;
+
+    /// @brief Will create the rig from a skeleton, the bind pose is taken from the bone offsets.
+    /// @param[in] skeleton     The skeleton.
+    /// @return true if successful, false in case of an invalid hierarchy.
+    bool create(const Skeleton &skeleton);
+
+    /// @brief Will remove all joints.
+    void clear();
+
+    /// @brief Will return the number of joints.
+    /// @return The number of joints.
+    size_t getNumJoints() const;
+
+    /// @brief Will return the parent joint.
+    /// @param[in] joint    The joint index.
+    /// @return The parent joint index or -1 for root joints.
+    i32 getParent(size_t joint) const;
+
+    /// @brief Will return the name of a joint.
+    /// @param[in] joint    The joint index.
+    /// @return The joint name.
+    const String &getName(size_t joint) const;
+
+    /// @brief Will look for a joint by its name.
+    /// @param[in] name     The joint name.
+    /// @return The joint index or -1 if there is no joint with this name.
+    i32 findJoint(const String &name) const;
+
+    /// @brief Will return the joint index for a bone index of the source skeleton.
+    /// @param[in] bone     The bone index.
+    /// @return The joint index or -1 if the bone index is invalid.
+    i32 getJointByBone(size_t bone) const;
+
+    /// @brief Will return the local bind transformation of a joint.
+    /// @param[in] joint    The joint index.
+    /// @return The local bind transformation.
+    const glm::mat4 &getBindPose(size_t joint) const;
+
+    /// @brief Will return the local bind pose of all joints, split into translation, rotation and scaling.
+    /// @return The local bind pose.
+    const LocalPose &getBindLocalPose() const;
+
+    /// @brief Will return the inverse bind matrix of a joint.
+    /// @param[in] joint    The joint index.
+    /// @return The inverse bind matrix, transforms from model space into joint space.
+    const glm::mat4 &getInverseBindMatrix(size_t joint) const;
+
+    /// @brief Will map the channels of a track to the joints by their names.
+    /// @param[in]  track           The animation track.
+    /// @param[out] jointToChannel  The channel for each joint, -1 for joints without a channel.
+    void createChannelMap(const AnimationTrack &track, std::vector<i32> &jointToChannel) const;
+
+private:
+    std::vector<i32> mParents;
+    std::vector<String> mNames;
+    std::vector<i32> mBoneToJoint;
+    cppcore::TArray<glm::mat4> mBindPose;
+    cppcore::TArray<glm::mat4> mInverseBind;
+    LocalPose mBindLocalPose;
+};
+
+inline size_t SkeletonRig::getNumJoints() const {
+    return mParents.size();
+}
+
+inline i32 SkeletonRig::getParent(size_t joint) const {
+    return mParents[joint];
+}
+
+inline const String &SkeletonRig::getName(size_t joint) const {
+    return mNames[joint];
+}
+
+inline const glm::mat4 &SkeletonRig::getBindPose(size_t joint) const {
+    return mBindPose[joint];
+}
+
+inline const LocalPose &SkeletonRig::getBindLocalPose() const {
+    return mBindLocalPose;
+}
+
+inline const glm::mat4 &SkeletonRig::getInverseBindMatrix(size_t joint) const {
+    return mInverseBind[joint];
+}
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief This class stores the pose of one skeleton instance.
+///
+/// The local joint transformations are sampled from a track, the model space transformations
+/// and the skinning palette are built in one pass over the parent ordered joints.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT SkeletonPose {
+public:
+    /// @brief The class constructor.
+    /// @param[in] rig      The rig, must stay valid during the lifetime of the pose.
+    explicit SkeletonPose(const SkeletonRig *rig = nullptr);
+
+    /// @brief The class destructor, default implementation.
+    ~SkeletonPose() = default;
+
+    /// @brief Will assign a new rig, the pose will be reset to the bind pose.
+    /// @param[in] rig      The new rig.
+    void setRig(const SkeletonRig *rig);
+
+    /// @brief Will return the assigned rig.
+    /// @return The rig, nullptr if none was assigned.
+    const SkeletonRig *getRig() const;
+
+    /// @brief Will reset the local transformations to the bind pose.
+    void setBindPose();
+
+    /// @brief Will sample the local transformations from a track.
+    /// @param[in] track            The animation track.
+    /// @param[in] jointToChannel   The channel map, see SkeletonRig::createChannelMap.
+    /// @param[in] time             The time in ticks.
+    /// @param[in] mode             The rotation interpolation mode.
+    void sample(const AnimationTrack &track, const std::vector<i32> &jointToChannel, d32 time, RotationBlendMode mode);
+
+    /// @brief Will build the model space transformations and the skinning palette.
+    void buildPalette();
+
+    /// @brief Will set the local transformations from a blended pose.
+    /// @param[in] pose     The local pose, must contain one entry per joint.
+    void setLocalPose(const LocalPose &pose);
+
+    /// @brief Will return the number of joints.
+    /// @return The number of joints.
+    size_t getNumJoints() const;
+
+    /// @brief Will return the local joint transformations.
+    /// @return The local transformations, can be changed before building the palette.
+    glm::mat4 *getLocalTransforms();
+
+    /// @brief Will return the model space joint transformations.
+    /// @return The model space transformations.
+    const glm::mat4 *getModelTransforms() const;
+
+    /// @brief Will return the skinning palette.
+    /// @return The skinning matrices, model transformation * inverse bind matrix.
+    const glm::mat4 *getPalette() const;
+
+private:
+    const SkeletonRig *mRig;
+    cppcore::TArray<glm::mat4> mLocal;
+    cppcore::TArray<glm::mat4> mModel;
+    cppcore::TArray<glm::mat4> mPalette;
+    std::vector<KeyCursor> mCursors;
+};
+
+inline const SkeletonRig *SkeletonPose::getRig() const {
+    return mRig;
+}
+
+inline size_t SkeletonPose::getNumJoints() const {
+    return mLocal.size();
+}
+
+inline glm::mat4 *SkeletonPose::getLocalTransforms() {
+    return mLocal.isEmpty() ? nullptr : &mLocal[0];
+}
+
+inline const glm::mat4 *SkeletonPose::getModelTransforms() const {
+    return mModel.isEmpty() ? nullptr : &mModel[0];
+}
+
+inline const glm::mat4 *SkeletonPose::getPalette() const {
+    return mPalette.isEmpty() ? nullptr : &mPalette[0];
+}
+
+} // namespace Animation
+} // namespace OSRE
@@ -280,6 +280,7 @@ bool AppBase::onCreate() {
     AbstractWindow *rootWindow = mPlatformInterface->getRootWindow();
     CreateRendererEventData *data = new CreateRendererEventData(rootWindow);
     data->RequestedPipeline = mRbService->createDefault3DPipeline(rootWindow->getId());
+    mRbService->setActivePipeline(data->RequestedPipeline);
     mRbService->sendEvent(&OnCreateRendererEvent, data);
 
     mTimer = PlatformInterface::getInstance()->getTimer();
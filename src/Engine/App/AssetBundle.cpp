@@ -0,0 +1,51 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "App/AssetBundle.h"
+#include "Common/Logger.h"
+#include "IO/AbstractFileSystem.h"
+
+namespace OSRE::App {
+
+DECL_OSRE_LOG_MODULE(AssetBundle)
+
+bool AssetBundle::pack(const String &root, const String &archive, IO::BundleCompression compression) const {
+    String folder = root;
+    IO::AbstractFileSystem::normalizeFilename(folder);
+    if (!folder.empty() && folder[folder.size() - 1] != '/') {
+        folder += '/';
+    }
+
+    IO::BundleArchiveWriter writer;
+    for (size_t i = 0; i < mAssetArray.size(); ++i) {
+        String name = mAssetArray[i];
+        IO::AbstractFileSystem::normalizeFilename(name);
+        if (!writer.addFile(name, folder + name, compression)) {
+            osre_error(Tag, "Cannot pack " + name + " into " + archive);
+            return false;
+        }
+    }
+
+    return writer.write(archive);
+}
+
+} // namespace OSRE::App
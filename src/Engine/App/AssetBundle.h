@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include "Common/osre_common.h"
+#include "IO/BundleArchive.h"
 
 #include <cppcore/Container/TArray.h>
 
@@ -33,8 +34,11 @@ namespace App {
 ///	@ingroup	Engine
 ///
 ///	@brief	This helper class can be used to bundle files.
+///
+/// The files can be packed into a bundle archive, which can be mounted into the bundle file system
+/// of the io-service afterwards.
 //-------------------------------------------------------------------------------------------------
-class AssetBundle {
+class OSRE_EXPORT AssetBundle {
 public:
     /// @param  The class construtor.
     /// @param[in] name     The bundle name.
@@ -68,6 +72,13 @@ public:
     /// @return The asset name.
     const String &getAssetAt(size_t index) const;
 
+    /// @brief Will pack all files of the bundle into an archive.
+    /// @param[in] root         The folder of the files, the files are named relative to it in the archive.
+    /// @param[in] archive      The archive file to write.
+    /// @param[in] compression  The compression of the entries.
+    /// @return true if successful, false if a file cannot be read or the archive cannot be written.
+    bool pack(const String &root, const String &archive, IO::BundleCompression compression) const;
+
 private:
     bool isSupported(const String &file) const;
 
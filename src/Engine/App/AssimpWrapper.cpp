@@ -20,31 +20,46 @@ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
 IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
+#include "Animation/AnimatorComponent.h"
+#include "Animation/SkeletonRig.h"
 #include "App/AssetRegistry.h"
 #include "App/AssimpWrapper.h"
 #include "App/Component.h"
 #include "App/Entity.h"
 #include "App/Scene.h"
+#include "App/SharedAssetCache.h"
+#include "Common/BatchMath.h"
 #include "Common/Ids.h"
 #include "Common/Logger.h"
 #include "Common/StringUtils.h"
 #include "Common/TAABB.h"
 #include "IO/AbstractFileSystem.h"
+#include "IO/BundleFileSystem.h"
 #include "IO/Directory.h"
 #include "IO/IOService.h"
 #include "IO/Uri.h"
 #include "RenderBackend/Mesh.h"
+#include "RenderBackend/Mesh/MeshSimplifier.h"
 #include "RenderBackend/RenderCommon.h"
 #include "RenderBackend/Material.h"
 #include "RenderBackend/MaterialBuilder.h"
+#include "Threading/WorkerPool.h"
 #include "App/TransformComponent.h"
 
+#include <assimp/DefaultIOSystem.h>
 #include <assimp/postprocess.h>
 #include <assimp/scene.h>
 #include <assimp/vector3.h>
+#include <assimp/IOStream.hpp>
 #include <assimp/Importer.hpp>
+#include <assimp/ProgressHandler.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 namespace OSRE::App {
 
@@ -67,16 +82,60 @@ static void setColor4(const aiColor4D &aiCol, Color4 &col) {
     col.m_a = aiCol.a;
 }
 
-static void setTexture(const String &resolvedPath, const aiString &texPath,
-        TextureResourceArray &texResArray, TextureStageType stage) {
-    // Check for an embedded texture
-    if (resolvedPath[0] == '*') {
-        // todo!
+static void setColor(const aiMaterial *material, const c8 *key, unsigned int type, unsigned int index,
+        MaterialColorType colorType, MaterialDesc &desc) {
+    aiColor4D color(1, 1, 1, 1);
+    if (AI_SUCCESS == aiGetMaterialColor(material, key, type, index, &color)) {
+        setColor4(color, desc.Colors[static_cast<size_t>(colorType)]);
+        desc.ColorMask |= 1u << static_cast<ui32>(colorType);
+    }
+}
+
+// Embedded textures are named after the model file and their index, like assimp references them by "*<index>"
+static String getEmbeddedTextureName(const String &modelFile, size_t index) {
+    return "file://" + modelFile + "*" + std::to_string(index);
+}
+
+// Returns the index of an embedded texture, formats like FBX are referencing them by their file name as well
+static i32 getEmbeddedTextureIndex(const aiScene *scene, const aiString &texPath) {
+    if (nullptr == scene || nullptr == scene->mTextures) {
+        return -1;
+    }
+
+    const aiTexture *texture = scene->GetEmbeddedTexture(texPath.C_Str());
+    if (nullptr == texture) {
+        return -1;
+    }
+    for (ui32 i = 0; i < scene->mNumTextures; ++i) {
+        if (texture == scene->mTextures[i]) {
+            return static_cast<i32>(i);
+        }
+    }
+
+    return -1;
+}
+
+static void setTexture(const aiScene *scene, const String &modelFile, const String &resolvedPath, const aiString &texPath,
+        MaterialDesc &desc, TextureStageType stage) {
+    // Check for an embedded texture, it is decoded from memory
+    const i32 embeddedIndex = getEmbeddedTextureIndex(scene, texPath);
+    if (embeddedIndex >= 0) {
+        MaterialTextureDesc texDesc;
+        texDesc.Name = getEmbeddedTextureName(modelFile, static_cast<size_t>(embeddedIndex));
+        texDesc.Stage = stage;
+        desc.Textures.add(texDesc);
+        return;
+    }
+    if ('*' == texPath.C_Str()[0]) {
+        osre_debug(Tag, "Cannot find the embedded texture " + String(texPath.C_Str()));
         return;
     }
 
+    // Models of a bundle are referencing the textures of the bundle
     String texname;
-    texname += "file://";
+    if (String::npos == resolvedPath.find("://")) {
+        texname += "file://";
+    }
     texname += resolvedPath;
     String temp = texPath.C_Str(), temp1;
     IO::Uri::normalizePath(temp, '\\', temp1);
@@ -86,9 +145,77 @@ static void setTexture(const String &resolvedPath, const aiString &texPath,
     }
     texname += temp1;
 
-    auto *texRes = new TextureResource(texname, Uri(texname));
-    texRes->setTextureStage(stage);
-    texResArray.add(texRes);
+    MaterialTextureDesc texDesc;
+    texDesc.Name = texname;
+    texDesc.Stage = stage;
+    desc.Textures.add(texDesc);
+}
+
+using ImportClock = std::chrono::steady_clock;
+
+static d32 getElapsedMs(const ImportClock::time_point &start) {
+    return std::chrono::duration<d32, std::milli>(ImportClock::now() - start).count();
+}
+
+// Returns the milliseconds since the start of the phase and starts the next one
+static d32 nextPhase(ImportClock::time_point &phaseStart) {
+    const d32 elapsed = getElapsedMs(phaseStart);
+    phaseStart = ImportClock::now();
+
+    return elapsed;
+}
+
+static String formatTimings(const AssimpWrapper::ImportTimings &timings) {
+    c8 buffer[512];
+    ::snprintf(buffer, sizeof(buffer),
+            "cache read %.2f ms, parse %.2f ms, materials %.2f ms, mesh prepare %.2f ms, mesh convert %.2f ms, "
+            "mesh lods %.2f ms, mesh merge %.2f ms, textures %.2f ms, nodes %.2f ms, animations %.2f ms, cache write %.2f ms, "
+            "total %.2f ms",
+            timings.CacheRead, timings.Parse, timings.Materials, timings.MeshPrepare, timings.MeshConvert,
+            timings.MeshLods, timings.MeshMerge, timings.Textures, timings.Nodes, timings.Animations, timings.CacheWrite,
+            timings.Total);
+
+    return String(buffer);
+}
+
+// A material is skinned, when one of its meshes is deformed by the imported skeleton
+static bool isSkinned(const aiScene *scene, ui32 materialIndex, const Skeleton &skeleton) {
+    if (skeleton.mBones.isEmpty()) {
+        return false;
+    }
+
+    for (ui32 i = 0; i < scene->mNumMeshes; ++i) {
+        const aiMesh *mesh = scene->mMeshes[i];
+        if (nullptr != mesh && mesh->mMaterialIndex == materialIndex && mesh->HasBones()) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+// A texture embedded in the model file, the data is owned by the scene or the mesh cache
+struct ImportedTexture {
+    String Name;
+    const uc8 *Data = nullptr;
+    size_t Size = 0;
+    ui32 Width = 0;                 // The width of uncompressed RGBA pixels, 0 for an encoded image
+    ui32 Height = 0;
+    const aiTexel *Texels = nullptr; // The uncompressed texels of the scene, stored as BGRA
+    std::vector<uc8> Pixels;        // The texels converted to RGBA
+    ui64 Key = 0;
+    TextureResource *Resource = nullptr;
+};
+
+static void releaseTextureResource(TextureResource *texRes) {
+    if (nullptr == texRes) {
+        return;
+    }
+
+    TextureLoader loader;
+    texRes->unload(loader);
+    delete texRes->getRes();
+    delete texRes;
 }
 
 AssimpWrapper::AssetContext::AssetContext(Ids &ids, Scene *world) :
@@ -97,13 +224,191 @@ AssimpWrapper::AssetContext::AssetContext(Ids &ids, Scene *world) :
         mWorld(world),
         mParentNode(nullptr),
         mIds(ids),
+        mCacheKey(0),
         mNumVertices(0),
-        mNumTriangles(0) {
+        mNumTriangles(0),
+        mFromCache(false) {
     // empty
 }
 
+// Forwards the parser progress, assimp will stop parsing when false is returned
+class ParseProgressHandler final : public Assimp::ProgressHandler {
+public:
+    ParseProgressHandler(ImportProgressHandler *handler, bool &cancelled) :
+            mHandler(handler), mCancelled(cancelled) {
+        // empty
+    }
+
+    ~ParseProgressHandler() override = default;
+
+    bool Update(float percentage) override {
+        if (nullptr != mHandler && !mHandler->onProgress(ImportStage::Parse, percentage < 0.0f ? 0.0f : percentage)) {
+            mCancelled = true;
+        }
+
+        return !mCancelled;
+    }
+
+private:
+    ImportProgressHandler *mHandler;
+    bool &mCancelled;
+};
+
+static bool isBundleUri(const String &file) {
+    return 0 == file.compare(0, 9, "bundle://");
+}
+
+// Returns the archive file of a bundle entry, empty if the bundle is not mounted
+static String getBundleArchiveFilename(const IO::Uri &file) {
+    BundleFileSystem *bundles = IOService::getInstance()->getBundleFileSystem();
+    String bundleName, entryName;
+    if (nullptr == bundles || !BundleFileSystem::splitUri(file, bundleName, entryName)) {
+        return String();
+    }
+    const BundleArchive *archive = bundles->getArchive(bundleName);
+
+    return nullptr != archive ? archive->getFilename() : String();
+}
+
+// Returns the mesh cache of a bundle entry, it is stored next to the archive as bundles are read-only
+static String getBundleCacheFilename(const IO::Uri &file) {
+    const String archiveFilename = getBundleArchiveFilename(file);
+    String bundleName, entryName;
+    if (archiveFilename.empty() || !BundleFileSystem::splitUri(file, bundleName, entryName)) {
+        return String();
+    }
+    for (c8 &c : entryName) {
+        if ('/' == c) {
+            c = '_';
+        }
+    }
+
+    return MeshCache::getCacheFilename(archiveFilename + "." + entryName);
+}
+
+// Hashes the content of a bundle entry, the opened stream holds it in memory already
+static ui64 computeBundleKey(const IO::Uri &file, ui32 flags) {
+    IOService *ioService = IOService::getInstance();
+    Stream *stream = ioService->openStream(file, Stream::AccessMode::ReadAccessBinary);
+    if (nullptr == stream) {
+        return 0;
+    }
+    const ui64 key = MeshCache::computeKey(static_cast<BundleStream *>(stream)->getData(), stream->getSize(), flags);
+    ioService->closeStream(&stream);
+
+    return key;
+}
+
+// Reads a stream of the io-service for the parser, like an entry of a mounted bundle
+class ServiceIOStream final : public Assimp::IOStream {
+public:
+    explicit ServiceIOStream(Stream *stream) :
+            mStream(stream) {
+        // empty
+    }
+
+    ~ServiceIOStream() override {
+        IOService::getInstance()->closeStream(&mStream);
+    }
+
+    size_t Read(void *buffer, size_t size, size_t count) override {
+        if (0 == size || 0 == count) {
+            return 0;
+        }
+
+        return mStream->read(buffer, size * count) / size;
+    }
+
+    size_t Write(const void *, size_t, size_t) override {
+        return 0;
+    }
+
+    aiReturn Seek(size_t offset, aiOrigin origin) override {
+        const size_t size = mStream->getSize();
+        size_t pos = offset;
+        if (aiOrigin_CUR == origin) {
+            pos = Tell() + offset;
+        } else if (aiOrigin_END == origin) {
+            pos = offset <= size ? size - offset : size + 1;
+        }
+        if (pos > size) {
+            return aiReturn_FAILURE;
+        }
+        mStream->seek(static_cast<Stream::Offset>(pos), Stream::Origin::Begin);
+
+        return aiReturn_SUCCESS;
+    }
+
+    size_t Tell() const override {
+        return mStream->tell();
+    }
+
+    size_t FileSize() const override {
+        return mStream->getSize();
+    }
+
+    void Flush() override {
+        // empty
+    }
+
+private:
+    Stream *mStream;
+};
+
+// Records all files the parser opens, material libraries and buffers are dependencies of the mesh cache.
+// Bundle uris are opened through the io-service, their archive is the dependency.
+class DependencyIOSystem final : public Assimp::DefaultIOSystem {
+public:
+    explicit DependencyIOSystem(cppcore::TArray<String> &files) :
+            mFiles(files) {
+        // empty
+    }
+
+    ~DependencyIOSystem() override = default;
+
+    bool Exists(const char *file) const override {
+        if (nullptr != file && isBundleUri(file)) {
+            return IOService::getInstance()->fileExists(IO::Uri(file));
+        }
+
+        return DefaultIOSystem::Exists(file);
+    }
+
+    Assimp::IOStream *Open(const char *file, const char *mode) override {
+        const bool read = nullptr != file && nullptr != mode && nullptr == ::strchr(mode, 'w');
+        if (read && isBundleUri(file)) {
+            const IO::Uri uri(file);
+            Stream *stream = IOService::getInstance()->openStream(uri, Stream::AccessMode::ReadAccessBinary);
+            if (nullptr == stream) {
+                return nullptr;
+            }
+            const String archiveFilename = getBundleArchiveFilename(uri);
+            if (!archiveFilename.empty()) {
+                mFiles.add(archiveFilename);
+            }
+
+            return new ServiceIOStream(stream);
+        }
+
+        if (read) {
+            mFiles.add(file);
+        }
+
+        return DefaultIOSystem::Open(file, mode);
+    }
+
+private:
+    cppcore::TArray<String> &mFiles;
+};
+
 AssimpWrapper::AssimpWrapper(Ids &ids, Scene *world) :
         mImporter(nullptr),
+        mProgressHandler(nullptr),
+        mWorkerPool(nullptr),
+        mSharedAssets(nullptr),
+        mCancelled(false),
+        mCompressAnimations(true),
+        mAnimCompression(),
         mAssetContext(ids, world) {
     // empty
 }
@@ -115,6 +420,19 @@ AssimpWrapper::~AssimpWrapper() {
 }
 
 bool AssimpWrapper::importAsset(const IO::Uri &file, ui32 flags) {
+    if (!loadAsset(file, flags)) {
+        return false;
+    }
+
+    if (nullptr == createEntity()) {
+        osre_error(Tag, "Cannot create the entity for " + file.getUri() + ".");
+        return false;
+    }
+
+    return true;
+}
+
+bool AssimpWrapper::loadAsset(const IO::Uri &file, ui32 flags) {
     if (!file.isValid()) {
         osre_error(Tag, "URI " + file.getUri() + " is invalid.");
         return false;
@@ -125,8 +443,17 @@ bool AssimpWrapper::importAsset(const IO::Uri &file, ui32 flags) {
         flags = DefaultImportFlags;
     }
 
+    // Entries of a bundle are parsed through the io-service, the uri is kept as the path
+    const bool fromBundle = isBundleUri(file.getUri());
+    if (fromBundle) {
+        IOService *ioService = IOService::getInstance();
+        if (nullptr == ioService || !ioService->fileExists(file)) {
+            osre_error(Tag, "Cannot find " + file.getUri() + " in the mounted bundles.");
+            return false;
+        }
+    }
     mAssetContext.mRoot = AssetRegistry::getPath("media");
-    mAssetContext.mAbsPathWithFile = AssetRegistry::resolvePathFromUri(file);
+    mAssetContext.mAbsPathWithFile = fromBundle ? file.getUri() : AssetRegistry::resolvePathFromUri(file);
 
     String filename;
     if (!Directory::getDirectoryAndFile(mAssetContext.mAbsPathWithFile, mAssetContext.mRoot, filename)) {
@@ -137,28 +464,155 @@ bool AssimpWrapper::importAsset(const IO::Uri &file, ui32 flags) {
     filename = mAssetContext.mRoot + filename;
     if (mImporter != nullptr) {
         delete mImporter;
+        mImporter = nullptr;
+    }
+
+    mCancelled = false;
+    mTimings = ImportTimings();
+    mAssetContext.mImportStart = ImportClock::now();
+    ImportClock::time_point phaseStart = mAssetContext.mImportStart;
+
+    // The cache is keyed by the content of the source and the import flags
+    if (fromBundle) {
+        mAssetContext.mCacheFile = getBundleCacheFilename(file);
+        mAssetContext.mCacheKey = mAssetContext.mCacheFile.empty() ? 0 : computeBundleKey(file, flags);
+    } else {
+        mAssetContext.mCacheKey = MeshCache::computeKey(filename, flags);
+        mAssetContext.mCacheFile = MeshCache::getCacheFilename(filename);
     }
+    mAssetContext.mScene = nullptr;
+    mAssetContext.mFromCache = false;
+    mAssetContext.mDependencies.resize(0);
+    if (0 != mAssetContext.mCacheKey && mAssetContext.mCacheReader.open(mAssetContext.mCacheFile, mAssetContext.mCacheKey)) {
+        osre_debug(Tag, "Loading " + filename + " from the mesh cache.");
+        mAssetContext.mFromCache = true;
+        mTimings.CacheRead = nextPhase(phaseStart);
+        if (!reportProgress(ImportStage::Meshes, 1.0f)) {
+            return false;
+        }
+        importEmbeddedTextures(mAssetContext.mCacheReader);
+        mTimings.Textures = nextPhase(phaseStart);
+
+        return reportProgress(ImportStage::Textures, 0.5f);
+    }
+    mTimings.CacheRead = nextPhase(phaseStart);
 
     mStream = aiGetPredefinedLogStream(aiDefaultLogStream_STDOUT, NULL);
     aiAttachLogStream(&mStream);
 
+    // The importer owns the progress handler and the io system
     mImporter = new Importer;
+    mImporter->SetProgressHandler(new ParseProgressHandler(mProgressHandler, mCancelled));
+    mImporter->SetIOHandler(new DependencyIOSystem(mAssetContext.mDependencies));
     osre_debug(Tag, "Start importing " + filename + ".");
     mAssetContext.mScene = mImporter->ReadFile(filename, flags);
+    mTimings.Parse = nextPhase(phaseStart);
+    if (mCancelled) {
+        osre_debug(Tag, "Importing " + filename + " was cancelled.");
+        return false;
+    }
+
     if (nullptr == mAssetContext.mScene) {
         osre_error(Tag, "Cannot start importing " + filename + ", scene is nullptr.");
         mAssetContext.mRoot = "";
         mAssetContext.mAbsPathWithFile = "";
         return false;
     }
-
     osre_debug(Tag, "Importing " + filename + " finished.");
-    convertScene();
-    osre_debug(Tag, "Converting " + filename + " finished.");
 
-    osre_debug(Tag, "Finish importing " + filename + ".");
+    // The skeleton is needed first, skinned materials use another shader
+    if (!reportProgress(ImportStage::Materials, 0.0f)) {
+        return false;
+    }
+    const aiScene *scene = mAssetContext.mScene;
+    importSkeleton(scene);
+    for (ui32 i = 0; i < scene->mNumMaterials; ++i) {
+        const bool skinned = isSkinned(scene, i, mAssetContext.mSkeleton);
+        importMaterial(scene->mMaterials[i], skinned ? VertexType::SkinnedVertex : VertexType::RenderVertex);
+    }
+    mTimings.Materials = nextPhase(phaseStart);
 
-    return true;
+    if (!reportProgress(ImportStage::Meshes, 0.0f)) {
+        return false;
+    }
+    if (scene->HasMeshes()) {
+        convertMeshes(scene->mMeshes, scene->mNumMeshes);
+    }
+    if (!reportProgress(ImportStage::Meshes, 1.0f)) {
+        return false;
+    }
+
+    // The embedded textures are decoded here as well, only the upload is left for the main thread
+    phaseStart = ImportClock::now();
+    importEmbeddedTextures(scene);
+    mTimings.Textures = nextPhase(phaseStart);
+
+    return reportProgress(ImportStage::Textures, 0.5f);
+}
+
+Entity *AssimpWrapper::createEntity() {
+    if (mCancelled) {
+        return nullptr;
+    }
+
+    if (mAssetContext.mFromCache) {
+        ImportClock::time_point phaseStart = ImportClock::now();
+        convertCache(mAssetContext.mCacheReader);
+        mAssetContext.mCacheReader.close();
+        mTimings.CacheRead += nextPhase(phaseStart);
+        mTimings.Total = getElapsedMs(mAssetContext.mImportStart);
+        reportProgress(ImportStage::Upload, 1.0f);
+        osre_debug(Tag, "Import timings: " + formatTimings(mTimings));
+
+        return mAssetContext.mEntity;
+    }
+
+    if (nullptr == convertScene()) {
+        return nullptr;
+    }
+    osre_debug(Tag, "Converting " + mAssetContext.mAbsPathWithFile + " finished.");
+
+    ImportClock::time_point phaseStart = ImportClock::now();
+    if (0 != mAssetContext.mCacheKey) {
+        writeCache(mAssetContext.mCacheFile, mAssetContext.mCacheKey);
+    }
+    mTimings.CacheWrite = nextPhase(phaseStart);
+    mTimings.Total = getElapsedMs(mAssetContext.mImportStart);
+    reportProgress(ImportStage::Upload, 1.0f);
+
+    osre_debug(Tag, "Finish importing " + mAssetContext.mAbsPathWithFile + ".");
+    osre_debug(Tag, "Import timings: " + formatTimings(mTimings));
+
+    return mAssetContext.mEntity;
+}
+
+void AssimpWrapper::setProgressHandler(ImportProgressHandler *handler) {
+    mProgressHandler = handler;
+}
+
+void AssimpWrapper::setWorkerPool(Threading::WorkerPool *pool) {
+    mWorkerPool = pool;
+}
+
+void AssimpWrapper::setSharedAssetCache(SharedAssetCache *cache) {
+    mSharedAssets = cache;
+}
+
+void AssimpWrapper::setAnimationCompression(bool enabled, const CompressionSettings &settings) {
+    mCompressAnimations = enabled;
+    mAnimCompression = settings;
+}
+
+SharedAssetCache &AssimpWrapper::getSharedAssets() const {
+    return nullptr != mSharedAssets ? *mSharedAssets : SharedAssetCache::getInstance();
+}
+
+bool AssimpWrapper::reportProgress(ImportStage stage, f32 progress) {
+    if (nullptr != mProgressHandler && !mProgressHandler->onProgress(stage, progress)) {
+        mCancelled = true;
+    }
+
+    return !mCancelled;
 }
 
 Entity *AssimpWrapper::getEntity() const {
@@ -174,6 +628,18 @@ const aiScene *AssimpWrapper::getScene() const {
     return mAssetContext.mScene;
 }
 
+bool AssimpWrapper::isLoadedFromCache() const {
+    return mAssetContext.mFromCache;
+}
+
+const Skeleton &AssimpWrapper::getSkeleton() const {
+    return mAssetContext.mSkeleton;
+}
+
+const AssimpWrapper::ImportTimings &AssimpWrapper::getImportTimings() const {
+    return mTimings;
+}
+
 Entity *AssimpWrapper::convertScene() {
     if (mAssetContext.mScene == nullptr) {
         return nullptr;
@@ -184,27 +650,98 @@ Entity *AssimpWrapper::convertScene() {
     }
 
     mAssetContext.mEntity = new Entity(mAssetContext.mAbsPathWithFile, mAssetContext.mIds, mAssetContext.mWorld);
-    if (mAssetContext.mScene->HasMaterials()) {
-        for (ui32 i = 0; i < mAssetContext.mScene->mNumMaterials; ++i) {
-            aiMaterial *currentMat = mAssetContext.mScene->mMaterials[i];
-            if (nullptr == currentMat) {
-                continue;
-            }
 
-            importMaterial(currentMat);
+    // Failed materials stay as nullptr, so the material indices of the meshes stay valid
+    ImportClock::time_point phaseStart = ImportClock::now();
+    SharedAssetCache &sharedAssets = getSharedAssets();
+    registerEmbeddedTextures();
+    const size_t numMaterials = mAssetContext.mMatDescArray.size();
+    for (size_t i = 0; i < numMaterials; ++i) {
+        reportProgress(ImportStage::Textures, 0.5f + 0.5f * static_cast<f32>(i) / static_cast<f32>(numMaterials));
+        Material *material = sharedAssets.getMaterial(mAssetContext.mMatDescArray[i]);
+        if (nullptr == material) {
+            osre_error(Tag, "Error while creating material for " + mAssetContext.mMatDescArray[i].Name);
         }
+        mAssetContext.mMatArray.add(material);
     }
+    mTimings.Materials += nextPhase(phaseStart);
 
-    if (mAssetContext.mScene->HasMeshes()) {
-        importMeshes(mAssetContext.mScene->mMeshes, mAssetContext.mScene->mNumMeshes);
-    }
+    reportProgress(ImportStage::Upload, 0.0f);
+    createMeshes();
 
+    phaseStart = ImportClock::now();
     if (nullptr != mAssetContext.mScene->mRootNode) {
         importNode(mAssetContext.mScene->mRootNode, nullptr);
     }
+    createMeshInstances();
+    mTimings.Nodes = nextPhase(phaseStart);
 
     importAnimations(mAssetContext.mScene);
+    mTimings.Animations = nextPhase(phaseStart);
+
+    if (!mAssetContext.mMeshArray.isEmpty()) {
+        RenderComponent *rc = (RenderComponent *)mAssetContext.mEntity->getComponent(ComponentType::RenderComponentType);
+        rc->addStaticMeshArray(mAssetContext.mMeshArray);
+    }
+
+    return mAssetContext.mEntity;
+}
+
+Entity *AssimpWrapper::convertCache(const MeshCacheReader &reader) {
+    if (mAssetContext.mWorld == nullptr) {
+        mAssetContext.mWorld = new Scene("scene");
+    }
+
+    mAssetContext.mEntity = new Entity(mAssetContext.mAbsPathWithFile, mAssetContext.mIds, mAssetContext.mWorld);
+
+    // Failed materials stay as nullptr, so the mesh indices stay valid
+    SharedAssetCache &sharedAssets = getSharedAssets();
+    registerEmbeddedTextures();
+    MaterialDesc desc;
+    for (size_t i = 0; i < reader.getNumMaterials(); ++i) {
+        reader.getMaterial(i, desc);
+        Material *material = sharedAssets.getMaterial(desc);
+        if (nullptr == material) {
+            osre_error(Tag, "Error while creating material for " + desc.Name);
+        }
+        mAssetContext.mMatArray.add(material);
+        mAssetContext.mMatDescArray.add(desc);
+    }
+
+    for (size_t i = 0; i < reader.getNumMeshes(); ++i) {
+        i32 materialIndex = -1;
+        Mesh *mesh = reader.createMesh(i, materialIndex);
+        if (nullptr != mesh && materialIndex >= 0) {
+            mesh->setMaterial(mAssetContext.mMatArray[materialIndex]);
+        }
+        if (nullptr != mesh) {
+            sharedAssets.shareMesh(mesh);
+        }
+        mAssetContext.mMeshArray.add(mesh);
+    }
+
+    cppcore::TArray<TransformComponent *> nodes;
+    for (size_t i = 0; i < reader.getNumNodes(); ++i) {
+        const CachedNode &cachedNode = reader.getNode(i);
+        TransformComponent *parent = cachedNode.Parent < 0 ? nullptr : nodes[cachedNode.Parent];
+        TransformComponent *node = new TransformComponent(reader.getString(cachedNode.Name), mAssetContext.mEntity, mAssetContext.mIds, parent);
+        glm::mat4 transform(1.0f);
+        ::memcpy(&transform[0][0], cachedNode.Transform, sizeof(cachedNode.Transform));
+        node->setTransformationMatrix(transform);
+        const ui32 *meshRefs = reader.getMeshRefs(cachedNode);
+        for (ui32 j = 0; j < cachedNode.NumMeshRefs; ++j) {
+            node->addMeshReference(meshRefs[j]);
+        }
+        if (nullptr == mAssetContext.mParentNode) {
+            mAssetContext.mParentNode = node;
+            mAssetContext.mEntity->setNode(node);
+        }
+        nodes.add(node);
+    }
 
+    mAssetContext.mEntity->setAABB(reader.getBounds());
+    mAssetContext.mNumVertices = reader.getHeader().NumVertices;
+    mAssetContext.mNumTriangles = reader.getHeader().NumTriangles;
     if (!mAssetContext.mMeshArray.isEmpty()) {
         RenderComponent *rc = (RenderComponent *)mAssetContext.mEntity->getComponent(ComponentType::RenderComponentType);
         rc->addStaticMeshArray(mAssetContext.mMeshArray);
@@ -213,200 +750,490 @@ Entity *AssimpWrapper::convertScene() {
     return mAssetContext.mEntity;
 }
 
+// Stores the nodes depth-first, so the parents are stored before their children
+static void addCacheNodes(MeshCacheWriter &writer, TransformComponent *node, i32 parent, i32 &numNodes) {
+    if (nullptr == node) {
+        return;
+    }
+
+    cppcore::TArray<ui32> meshRefs;
+    for (size_t i = 0; i < node->getNumMeshReferences(); ++i) {
+        meshRefs.add(static_cast<ui32>(node->getMeshReferenceAt(i)));
+    }
+    writer.addNode(node->getName(), parent, node->getTransformationMatrix(), meshRefs);
+
+    const i32 index = numNodes++;
+    for (size_t i = 0; i < node->getNumChildren(); ++i) {
+        addCacheNodes(writer, node->getChildAt(i), index, numNodes);
+    }
+}
+
+bool AssimpWrapper::writeCache(const String &filename, ui64 key) {
+    const aiScene *scene = mAssetContext.mScene;
+    if (nullptr == scene || nullptr == mAssetContext.mEntity) {
+        return false;
+    }
+
+    // Animations are not part of the cache yet
+    if (scene->HasAnimations()) {
+        return false;
+    }
+    for (ui32 i = 0; i < scene->mNumMeshes; ++i) {
+        if (scene->mMeshes[i]->HasBones()) {
+            return false;
+        }
+    }
+
+    // A changed companion file or texture will outdate the cache
+    MeshCacheWriter writer;
+    for (size_t i = 0; i < mAssetContext.mDependencies.size(); ++i) {
+        writer.addDependency(mAssetContext.mDependencies[i]);
+    }
+    const String embeddedPrefix = "file://" + mAssetContext.mAbsPathWithFile + "*";
+    for (size_t i = 0; i < mAssetContext.mMatDescArray.size(); ++i) {
+        const MaterialDesc &desc = mAssetContext.mMatDescArray[i];
+        for (size_t j = 0; j < desc.Textures.size(); ++j) {
+            const String &texName = desc.Textures[j].Name;
+            if (0 == texName.compare(0, 7, "file://") && 0 != texName.compare(0, embeddedPrefix.size(), embeddedPrefix)) {
+                writer.addDependency(texName.substr(7));
+            }
+        }
+        writer.addMaterial(desc);
+    }
+    for (size_t i = 0; i < mAssetContext.mTextures.size(); ++i) {
+        const ImportedTexture &tex = *mAssetContext.mTextures[i];
+        writer.addEmbeddedTexture(tex.Name, tex.Data, tex.Size, tex.Width, tex.Height);
+    }
+
+    for (size_t i = 0; i < mAssetContext.mMeshArray.size(); ++i) {
+        Mesh *mesh = mAssetContext.mMeshArray[i];
+        i32 materialIndex = -1;
+        for (size_t j = 0; j < mAssetContext.mMatArray.size(); ++j) {
+            if (mAssetContext.mMatArray[j] == mesh->getMaterial()) {
+                materialIndex = static_cast<i32>(j);
+                break;
+            }
+        }
+        if (!writer.addMesh(mesh, materialIndex)) {
+            return false;
+        }
+    }
+
+    i32 numNodes = 0;
+    addCacheNodes(writer, mAssetContext.mParentNode, -1, numNodes);
+    writer.setModelInfo(mAssetContext.mEntity->getAABB(), mAssetContext.mNumVertices, mAssetContext.mNumTriangles);
+
+    return writer.write(filename, key);
+}
+
+// Assimp stores the matrices row-major with the translation in the fourth column, glm is column-major
 static void copyAiMatrix4x4(const aiMatrix4x4 &aiMat, glm::mat4 &mat) {
     mat[0].x = aiMat.a1;
-    mat[0].y = aiMat.a2;
-    mat[0].z = aiMat.a3;
-    mat[0].w = aiMat.a4;
+    mat[0].y = aiMat.b1;
+    mat[0].z = aiMat.c1;
+    mat[0].w = aiMat.d1;
 
-    mat[1].x = aiMat.b1;
+    mat[1].x = aiMat.a2;
     mat[1].y = aiMat.b2;
-    mat[1].z = aiMat.b3;
-    mat[1].w = aiMat.b4;
+    mat[1].z = aiMat.c2;
+    mat[1].w = aiMat.d2;
 
-    mat[2].x = aiMat.c1;
-    mat[2].y = aiMat.c2;
+    mat[2].x = aiMat.a3;
+    mat[2].y = aiMat.b3;
     mat[2].z = aiMat.c3;
-    mat[2].w = aiMat.c4;
+    mat[2].w = aiMat.d3;
 
-    mat[3].x = aiMat.d1;
-    mat[3].y = aiMat.d2;
-    mat[3].z = aiMat.d3;
+    mat[3].x = aiMat.a4;
+    mat[3].y = aiMat.b4;
+    mat[3].z = aiMat.c4;
     mat[3].w = aiMat.d4;
 }
 
-using MeshIdxArray = ::cppcore::TArray<size_t>;
-using Mat2MeshMap = std::map<aiMaterial *, MeshIdxArray *>;
+// Both vertex types start with the 11 floats written by the interleave kernel
+template <class TVertex>
+static constexpr bool hasRenderVertexPrefix() {
+    return offsetof(TVertex, position) == 0 && offsetof(TVertex, normal) == 12 && offsetof(TVertex, color0) == 24 &&
+           offsetof(TVertex, tex0) == 36;
+}
+static_assert(hasRenderVertexPrefix<RenderVert>() && hasRenderVertexPrefix<SkinnedVert>(), "Unexpected vertex layout");
+
+// ai_real is single precision, so the attribute streams are read without a conversion
+static_assert(sizeof(aiVector3D) == 3 * sizeof(f32), "Attributes must be single precision");
+static_assert(sizeof(aiColor4D) == 4 * sizeof(f32), "Attributes must be single precision");
+
+// The strongest joints of a vertex
+struct JointWeights {
+    uc8 Joints[MaxJointsPerVertex];
+    f32 Weights[MaxJointsPerVertex];
+};
+
+static void addJointWeight(JointWeights &entry, uc8 joint, f32 weight) {
+    // Replace the weakest joint, if the new one is stronger
+    ui32 weakest = 0;
+    for (ui32 i = 1; i < MaxJointsPerVertex; ++i) {
+        if (entry.Weights[i] < entry.Weights[weakest]) {
+            weakest = i;
+        }
+    }
 
-static size_t countVertices(MeshIdxArray &miArray, const aiScene *scene) {
-    if (nullptr == scene) {
-        return 0;
+    if (weight > entry.Weights[weakest]) {
+        entry.Joints[weakest] = joint;
+        entry.Weights[weakest] = weight;
+    }
+}
+
+// The bones are visited once per job, the weights of its vertex range are scattered into a flat table with one entry per vertex
+static void buildWeightTable(const aiMesh *mesh, const std::map<String, i32> &bone2JointMap, size_t firstVertex, size_t numVertices,
+        std::vector<JointWeights> &table) {
+    table.assign(numVertices, JointWeights{});
+    for (ui32 i = 0; i < mesh->mNumBones; ++i) {
+        const aiBone *bone = mesh->mBones[i];
+        if (nullptr == bone) {
+            osre_debug(Tag, "Invalid bone instance found.");
+            continue;
+        }
+
+        const auto it = bone2JointMap.find(bone->mName.C_Str());
+        if (bone2JointMap.end() == it) {
+            continue;
+        }
+
+        const uc8 joint = static_cast<uc8>(it->second);
+        for (ui32 j = 0; j < bone->mNumWeights; ++j) {
+            const aiVertexWeight &vertexWeight = bone->mWeights[j];
+            const size_t vertex = static_cast<size_t>(vertexWeight.mVertexId) - firstVertex;
+            if (vertexWeight.mVertexId >= firstVertex && vertex < numVertices) {
+                addJointWeight(table[vertex], joint, vertexWeight.mWeight);
+            }
+        }
+    }
+
+    // The weights must sum up to one, vertices without weights follow the first joint
+    for (JointWeights &entry : table) {
+        f32 sum = 0.0f;
+        for (ui32 i = 0; i < MaxJointsPerVertex; ++i) {
+            sum += entry.Weights[i];
+        }
+
+        if (sum > 0.0f) {
+            for (ui32 i = 0; i < MaxJointsPerVertex; ++i) {
+                entry.Weights[i] /= sum;
+            }
+        } else {
+            entry.Weights[0] = 1.0f;
+        }
+    }
+}
+
+static void copyJointStream(const std::vector<JointWeights> &table, c8 *dst) {
+    for (const JointWeights &entry : table) {
+        SkinnedVert &vertex = *reinterpret_cast<SkinnedVert *>(dst);
+        ::memcpy(vertex.indices, entry.Joints, sizeof(entry.Joints));
+        vertex.weights = glm::vec4(entry.Weights[0], entry.Weights[1], entry.Weights[2], entry.Weights[3]);
+        dst += sizeof(SkinnedVert);
+    }
+}
+
+// A converted mesh of the scene, its buffers are shared by all nodes referencing it
+struct ImportedMesh {
+    ui32 MeshIndex = 0;
+    String Name;
+    ui32 MaterialIndex = 0;
+    bool Skinned = false;
+    size_t VertexStride = 0;
+    size_t NumVertices = 0;
+    size_t NumIndices = 0;
+    cppcore::TArray<c8> Vertices;
+    cppcore::TArray<ui32> Indices;
+    MeshLodArray Lods;
+    AABB Bounds;                    // The bounds in mesh-local space
+    Mesh *SceneMesh = nullptr;      // The mesh owning the buffers, drawn by the first referencing node
+    ui32 NumInstances = 0;
+};
+
+AssimpWrapper::AssetContext::~AssetContext() {
+    for (size_t i = 0; i < mSkeleton.mBones.size(); ++i) {
+        delete mSkeleton.mBones[i];
+    }
+    for (size_t i = 0; i < mImportedMeshes.size(); ++i) {
+        delete mImportedMeshes[i];
+    }
+    for (size_t i = 0; i < mTextures.size(); ++i) {
+        releaseTextureResource(mTextures[i]->Resource);
+        delete mTextures[i];
+    }
+}
+
+// A vertex and face range of a source mesh, it will be converted into the buffers of its imported mesh
+struct MeshJob {
+    static constexpr size_t InvalidMesh = ~static_cast<size_t>(0);
+
+    ui32 MeshIndex = 0;
+    size_t Target = InvalidMesh;
+    size_t FirstVertex = 0;
+    size_t NumVertices = 0;
+    size_t FirstFace = 0;
+    size_t NumFaces = 0;
+    size_t FirstIndex = 0;
+    size_t NumIndices = 0;
+    bool HasBounds = false;
+    glm::vec3 Min;
+    glm::vec3 Max;
+};
+
+// Large meshes are split, so a single big mesh is converted by all workers
+static constexpr size_t MaxVerticesPerJob = 64 * 1024;
+
+static void convertMesh(const aiMesh *mesh, const std::map<String, i32> &bone2JointMap, ImportedMesh &target, MeshJob &job,
+        std::vector<JointWeights> &weightTable) {
+    // The ranges are split independently, a mesh with much more faces than vertices has ranges without vertices
+    if (0 != job.NumIndices) {
+        ui32 *indices = &target.Indices[job.FirstIndex];
+        const size_t endFace = job.FirstFace + job.NumFaces;
+        for (size_t faceIdx = job.FirstFace; faceIdx < endFace; ++faceIdx) {
+            const aiFace &currentFace = mesh->mFaces[faceIdx];
+            for (ui32 idx = 0; idx < currentFace.mNumIndices; ++idx) {
+                *indices++ = currentFace.mIndices[idx];
+            }
+        }
     }
 
-    size_t numVertices = 0;
-    for (unsigned int i = 0; i < miArray.size(); ++i) {
-        numVertices += static_cast<size_t>(scene->mMeshes[miArray[i]]->mNumVertices);
+    const size_t first = job.FirstVertex;
+    if (0 == job.NumVertices) {
+        return;
     }
 
-    return numVertices;
+    // The bounds are reduced over the packed positions at once
+    if (mesh->HasPositions()) {
+        job.HasBounds = BatchMath::computeBounds(&mesh->mVertices[first].x, sizeof(aiVector3D), job.NumVertices, job.Min, job.Max);
+    }
+
+    // The attribute streams are shuffled into the interleaved vertices in one pass, every member of a
+    // render vertex is written, the joints of a skinned vertex follow below
+    c8 *dst = &target.Vertices[first * target.VertexStride];
+    const glm::vec3 defaultColor(0.5f, 0.5f, 0.5f);
+    VertexStreams streams;
+    streams.Positions = mesh->HasPositions() ? &mesh->mVertices[first].x : nullptr;
+    streams.PositionStride = sizeof(aiVector3D);
+    streams.Normals = mesh->HasNormals() ? &mesh->mNormals[first].x : nullptr;
+    streams.NormalStride = sizeof(aiVector3D);
+    streams.Colors = mesh->HasVertexColors(0) ? &mesh->mColors[0][first].r : &defaultColor.x;
+    streams.ColorStride = mesh->HasVertexColors(0) ? sizeof(aiColor4D) : 0;
+    streams.TexCoords = mesh->HasTextureCoords(0) ? &mesh->mTextureCoords[0][first].x : nullptr;
+    streams.TexCoordStride = sizeof(aiVector3D);
+    BatchMath::interleaveVertices(streams, reinterpret_cast<f32 *>(dst), target.VertexStride, job.NumVertices);
+
+    if (target.Skinned) {
+        buildWeightTable(mesh, bone2JointMap, first, job.NumVertices, weightTable);
+        copyJointStream(weightTable, dst);
+    }
 }
 
-void AssimpWrapper::importMeshes(aiMesh **meshes, ui32 numMeshes) {
+void AssimpWrapper::convertMeshes(aiMesh **meshes, ui32 numMeshes) {
     if (nullptr == meshes || 0 == numMeshes) {
         osre_debug(Tag, "No meshes, aborting.");
         return;
     }
 
-    AABB aabb = mAssetContext.mEntity->getAABB();
+    const aiScene *scene = mAssetContext.mScene;
+    Threading::WorkerPool &pool = nullptr != mWorkerPool ? *mWorkerPool : Threading::WorkerPool::getInstance();
+    ImportClock::time_point phaseStart = ImportClock::now();
 
-    Mat2MeshMap mat2MeshMap;
+    // Every mesh is split into ranges of at most MaxVerticesPerJob vertices and faces, the jobs of a mesh are adjacent
+    std::vector<MeshJob> jobs;
+    std::vector<size_t> firstJob(numMeshes + 1, 0);
     for (ui32 meshIndex = 0; meshIndex < numMeshes; ++meshIndex) {
-        aiMesh *currentMesh = meshes[meshIndex];
-        if (nullptr == currentMesh) {
-            osre_debug(Tag, "Invalid mesh instance found.");
+        firstJob[meshIndex] = jobs.size();
+        const aiMesh *mesh = meshes[meshIndex];
+        if (nullptr == mesh) {
             continue;
         }
 
-        aiMaterial *mat = mAssetContext.mScene->mMaterials[currentMesh->mMaterialIndex];
-        if (nullptr == mat) {
-            continue;
+        const size_t numVertices = mesh->mNumVertices;
+        const size_t numFaces = mesh->mNumFaces;
+        const size_t numJobs = std::max<size_t>((std::max(numVertices, numFaces) + MaxVerticesPerJob - 1) / MaxVerticesPerJob, 1);
+        for (size_t i = 0; i < numJobs; ++i) {
+            MeshJob job;
+            job.MeshIndex = meshIndex;
+            job.FirstVertex = numVertices * i / numJobs;
+            job.NumVertices = numVertices * (i + 1) / numJobs - job.FirstVertex;
+            job.FirstFace = numFaces * i / numJobs;
+            job.NumFaces = numFaces * (i + 1) / numJobs - job.FirstFace;
+            jobs.push_back(job);
+        }
+    }
+    firstJob[numMeshes] = jobs.size();
+
+    // The index count of a range is needed to find its place in the index buffer
+    pool.parallelFor(jobs.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            MeshJob &job = jobs[i];
+            const aiMesh *mesh = meshes[job.MeshIndex];
+            const size_t endFace = job.FirstFace + job.NumFaces;
+            for (size_t faceIdx = job.FirstFace; faceIdx < endFace; ++faceIdx) {
+                job.NumIndices += mesh->mFaces[faceIdx].mNumIndices;
+            }
         }
+    });
 
-        Mat2MeshMap::const_iterator it = mat2MeshMap.find(mat);
-        MeshIdxArray *miArray = nullptr;
-        if (mat2MeshMap.end() == it) {
-            miArray = new MeshIdxArray;
-            mat2MeshMap[mat] = miArray;
-        } else {
-            miArray = it->second;
+    std::vector<size_t> numIndices(numMeshes, 0);
+    for (ui32 meshIndex = 0; meshIndex < numMeshes; ++meshIndex) {
+        for (size_t i = firstJob[meshIndex]; i < firstJob[meshIndex + 1]; ++i) {
+            jobs[i].FirstIndex = numIndices[meshIndex];
+            numIndices[meshIndex] += jobs[i].NumIndices;
         }
-        miArray->add(static_cast<size_t>(meshIndex));
     }
 
-    for (size_t mat2MeshIdx = 0; mat2MeshIdx < mat2MeshMap.size(); ++mat2MeshIdx) {
-        mAssetContext.mMeshArray.add(new Mesh("m1", VertexType::RenderVertex, IndexType::UnsignedInt));
+    // Meshes without vertices or faces will not get a job
+    std::vector<bool> skipped(numMeshes, false);
+    for (ui32 meshIndex = 0; meshIndex < numMeshes; ++meshIndex) {
+        const aiMesh *currentMesh = meshes[meshIndex];
+        if (nullptr == currentMesh) {
+            osre_debug(Tag, "Invalid mesh instance found.");
+            skipped[meshIndex] = true;
+        } else if (0 == currentMesh->mNumVertices || 0 == numIndices[meshIndex]) {
+            osre_debug(Tag, "Skipping empty mesh " + String(currentMesh->mName.C_Str()) + ".");
+            skipped[meshIndex] = true;
+        }
     }
 
-    size_t i = 0;
-    aiMesh *currentMesh = nullptr;
-    ::cppcore::TArray<RenderVert> vertices;
-    for (auto &it : mat2MeshMap) {
-        cppcore::TArray<ui32> indexArray;
-        MeshIdxArray *miArray = it.second;
-        if (nullptr == miArray) {
+    // Every mesh keeps its own buffers, so it can be drawn by several nodes with their own transformation
+    cppcore::TArray<ImportedMesh *> &importedMeshes = mAssetContext.mImportedMeshes;
+    std::vector<size_t> targets(numMeshes, MeshJob::InvalidMesh);
+    for (ui32 meshIndex = 0; meshIndex < numMeshes; ++meshIndex) {
+        const aiMesh *currentMesh = meshes[meshIndex];
+        if (skipped[meshIndex]) {
             continue;
         }
 
-        const size_t numVerts = countVertices(*miArray, mAssetContext.mScene);
-        vertices.resize(numVerts);
-        Mesh &newMesh = *mAssetContext.mMeshArray[i];
-        size_t vertexOffset = 0, indexOffset = 0;
-        for (unsigned long long meshIndex : *miArray) {
-            currentMesh = mAssetContext.mScene->mMeshes[meshIndex];
-            if (nullptr == currentMesh) {
-                continue;
-            }
-
-            for (ui32 k = 0; k < currentMesh->mNumVertices; ++k) {
-                if (currentMesh->HasPositions()) {
-                    mAssetContext.mNumVertices++;
-                    const aiVector3D &vec3 = currentMesh->mVertices[k];
-                    vertices[vertexOffset].position.x = vec3.x;
-                    vertices[vertexOffset].position.y = vec3.y;
-                    vertices[vertexOffset].position.z = vec3.z;
-
-                    aabb.merge(vec3.x, vec3.y, vec3.z);
-                }
-
-                if (currentMesh->HasNormals()) {
-                    const aiVector3D &normal = currentMesh->mNormals[k];
-                    vertices[vertexOffset].normal.x = normal.x;
-                    vertices[vertexOffset].normal.y = normal.y;
-                    vertices[vertexOffset].normal.z = normal.z;
-                }
-
-                if (currentMesh->HasVertexColors(0)) {
-                    const aiColor4D &diffuse = currentMesh->mColors[0][k];
-                    vertices[vertexOffset].color0.r = diffuse.r;
-                    vertices[vertexOffset].color0.g = diffuse.g;
-                    vertices[vertexOffset].color0.b = diffuse.b;
-                } else {
-                    vertices[vertexOffset].color0.r = 0.5;
-                    vertices[vertexOffset].color0.g = 0.5;
-                    vertices[vertexOffset].color0.b = 0.5;
-                }
-
-                for (ui32 texIdx = 0; texIdx < AI_MAX_NUMBER_OF_TEXTURECOORDS; texIdx++) {
-                    if (currentMesh->HasTextureCoords(texIdx)) {
-                        if (0 == texIdx) {
-                            aiVector3D &tex0 = currentMesh->mTextureCoords[texIdx][k];
-                            vertices[vertexOffset].tex0.x = tex0.x;
-                            vertices[vertexOffset].tex0.y = tex0.y;
-                        }
-                    }
-                }
+        const ui32 materialIndex = currentMesh->mMaterialIndex;
+        if (materialIndex >= scene->mNumMaterials || nullptr == scene->mMaterials[materialIndex]) {
+            continue;
+        }
 
-                if (currentMesh->HasBones()) {
-                    Bone *bones = new Bone[currentMesh->mNumBones];
-                    for (ui32 l = 0; l < currentMesh->mNumBones; ++l) {
-                        aiBone *currentBone = currentMesh->mBones[l];
-                        if (nullptr == currentBone) {
-                            osre_debug(Tag, "Invalid bone instance found.");
-                            continue;
-                        }
-
-                        Bone &bone = bones[l];
-                        bone.mName = currentBone->mName.C_Str();
-                        copyAiMatrix4x4(currentBone->mOffsetMatrix, bone.m_offsetMatrix);
-                        VertexWeight *wArray = new VertexWeight[currentBone->mNumWeights];
-
-                        for (ui32 weightIdx = 0; weightIdx < currentBone->mNumWeights; ++weightIdx) {
-                            aiVertexWeight &aiVW = currentBone->mWeights[l];
-                            VertexWeight &w = wArray[weightIdx];
-                            w.VertexIndex = aiVW.mVertexId;
-                            w.Weight = aiVW.mWeight;
-                        }
-                        bone.m_vertexWeights.add(wArray, currentBone->mNumWeights);
-                        const aiNode *node = mAssetContext.mScene->mRootNode->FindNode(bone.mName.c_str());
-                        if (nullptr != node) {
-                            mAssetContext.mBone2NodeMap[bone.mName.c_str()] = node;
-                        }
-                    }
-                }
+        targets[meshIndex] = importedMeshes.size();
+        for (size_t i = firstJob[meshIndex]; i < firstJob[meshIndex + 1]; ++i) {
+            jobs[i].Target = targets[meshIndex];
+        }
+        ImportedMesh *importedMesh = new ImportedMesh;
+        importedMesh->MeshIndex = meshIndex;
+        importedMesh->Name = currentMesh->mName.C_Str();
+        importedMesh->MaterialIndex = materialIndex;
+        importedMesh->Skinned = isSkinned(scene, materialIndex, mAssetContext.mSkeleton);
+        importedMesh->VertexStride = importedMesh->Skinned ? sizeof(SkinnedVert) : sizeof(RenderVert);
+        importedMesh->NumVertices = currentMesh->mNumVertices;
+        importedMesh->NumIndices = numIndices[meshIndex];
+        importedMesh->Vertices.resize(importedMesh->NumVertices * importedMesh->VertexStride);
+        importedMesh->Indices.resize(importedMesh->NumIndices);
+        importedMeshes.add(importedMesh);
+    }
+    mTimings.MeshPrepare = nextPhase(phaseStart);
+    if (!reportProgress(ImportStage::Meshes, 0.1f)) {
+        return;
+    }
 
-                ++vertexOffset;
+    // Every job writes into its own range of the buffers
+    pool.parallelFor(jobs.size(), 1, [&](size_t begin, size_t end) {
+        std::vector<JointWeights> weightTable;
+        for (size_t i = begin; i < end; ++i) {
+            MeshJob &job = jobs[i];
+            if (MeshJob::InvalidMesh != job.Target) {
+                convertMesh(meshes[job.MeshIndex], mAssetContext.mBone2JointMap, *importedMeshes[job.Target], job, weightTable);
             }
+        }
+    });
+    mTimings.MeshConvert = nextPhase(phaseStart);
+    if (!reportProgress(ImportStage::Meshes, 0.5f)) {
+        return;
+    }
 
-            for (ui32 faceIdx = 0; faceIdx < currentMesh->mNumFaces; ++faceIdx) {
-                aiFace &currentFace = currentMesh->mFaces[faceIdx];
-                mAssetContext.mNumTriangles++;
-                for (ui32 idx = 0; idx < currentFace.mNumIndices; ++idx) {
-                    const ui32 currentIndex = currentFace.mIndices[idx];
-                    indexArray.add(static_cast<ui32>(currentIndex + indexOffset));
-                }
+    // The coarser levels of detail will be appended to the index buffer, all levels share the vertices
+    pool.parallelFor(importedMeshes.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            ImportedMesh &importedMesh = *importedMeshes[i];
+            if (!importedMesh.Indices.isEmpty()) {
+                MeshSimplifier::generateLodChain(&importedMesh.Vertices[0], importedMesh.NumVertices, importedMesh.VertexStride,
+                        importedMesh.Indices, importedMesh.Lods);
             }
+        }
+    });
+    mTimings.MeshLods = nextPhase(phaseStart);
 
-            indexOffset += currentMesh->mNumVertices;
+    // The statistics and the bounds of the ranges are merged in mesh order
+    for (ui32 meshIndex = 0; meshIndex < numMeshes; ++meshIndex) {
+        if (MeshJob::InvalidMesh == targets[meshIndex]) {
+            continue;
+        }
+
+        if (meshes[meshIndex]->HasPositions()) {
+            mAssetContext.mNumVertices += meshes[meshIndex]->mNumVertices;
+        }
+        mAssetContext.mNumTriangles += meshes[meshIndex]->mNumFaces;
 
-            const size_t vbSize = sizeof(RenderVert) * numVerts;
-            newMesh.createVertexBuffer(&vertices[0], vbSize, BufferAccessType::ReadOnly);
+        bool hasBounds = false;
+        glm::vec3 min, max;
+        for (size_t i = firstJob[meshIndex]; i < firstJob[meshIndex + 1]; ++i) {
+            const MeshJob &job = jobs[i];
+            if (!job.HasBounds) {
+                continue;
+            }
+            min = hasBounds ? glm::min(min, job.Min) : job.Min;
+            max = hasBounds ? glm::max(max, job.Max) : job.Max;
+            hasBounds = true;
+        }
+        if (hasBounds) {
+            importedMeshes[targets[meshIndex]]->Bounds.set(min, max);
+        }
+    }
+}
 
-            const size_t ibSize = sizeof(ui32) * indexArray.size();
-            newMesh.createIndexBuffer(&indexArray[0], ibSize, IndexType::UnsignedInt, BufferAccessType::ReadOnly);
+void AssimpWrapper::createMeshes() {
+    // The meshes are created in scene order on the main thread, so their ids are stable
+    ImportClock::time_point phaseStart = ImportClock::now();
+
+    // Geometry which was imported before will use the buffers of the first mesh
+    SharedAssetCache &sharedAssets = getSharedAssets();
+    const ui32 numSharedMeshes = sharedAssets.getStatistics().NumSharedMeshes;
+    cppcore::TArray<ImportedMesh *> &importedMeshes = mAssetContext.mImportedMeshes;
+    for (size_t i = 0; i < importedMeshes.size(); ++i) {
+        ImportedMesh &importedMesh = *importedMeshes[i];
+        reportProgress(ImportStage::Upload, static_cast<f32>(i) / static_cast<f32>(importedMeshes.size()));
+        const VertexType vertexType = importedMesh.Skinned ? VertexType::SkinnedVertex : VertexType::RenderVertex;
+        const String name = importedMesh.Name.empty() ? "m" + std::to_string(importedMesh.MeshIndex) : importedMesh.Name;
+        Mesh *newMesh = new Mesh(name, vertexType, IndexType::UnsignedInt);
+        importedMesh.SceneMesh = newMesh;
+        if (importedMesh.MaterialIndex < mAssetContext.mMatArray.size()) {
+            newMesh->setMaterial(mAssetContext.mMatArray[importedMesh.MaterialIndex]);
+        }
 
-            newMesh.addPrimitiveGroup(indexArray.size(), PrimitiveType::TriangleList, 0);
+        const size_t ibSize = sizeof(ui32) * importedMesh.Indices.size();
+        const ui64 key = SharedAssetCache::computeMeshKey(vertexType, IndexType::UnsignedInt, &importedMesh.Vertices[0],
+                importedMesh.Vertices.size(), &importedMesh.Indices[0], ibSize);
+        Mesh *sharedMesh = sharedAssets.findMesh(key, vertexType, IndexType::UnsignedInt, &importedMesh.Vertices[0],
+                importedMesh.Vertices.size(), &importedMesh.Indices[0], ibSize);
+        if (!sharedAssets.shareBuffers(newMesh, sharedMesh)) {
+            newMesh->createVertexBuffer(&importedMesh.Vertices[0], importedMesh.Vertices.size(), BufferAccessType::ReadOnly);
+            newMesh->createIndexBuffer(&importedMesh.Indices[0], ibSize, IndexType::UnsignedInt, BufferAccessType::ReadOnly);
+            sharedAssets.addMesh(key, newMesh);
+        }
 
-            newMesh.setMaterial(mAssetContext.mMatArray[currentMesh->mMaterialIndex]);
+        if (importedMesh.Lods.size() > 1) {
+            osre_debug(Tag, "Generated " + std::to_string(importedMesh.Lods.size()) + " levels of detail for " + name + ".");
+            newMesh->setLods(importedMesh.Lods);
         }
+        newMesh->addPrimitiveGroup(importedMesh.NumIndices, PrimitiveType::TriangleList, 0);
 
-        ++i;
+        // The buffers have been copied into the mesh
+        importedMesh.Vertices.clear();
+        importedMesh.Indices.clear();
+        importedMesh.Lods.clear();
     }
-    mAssetContext.mEntity->setAABB(aabb);
+    mTimings.MeshMerge = nextPhase(phaseStart);
 
-    for (auto &it : mat2MeshMap) {
-        delete it.second;
+    const ui32 numShared = sharedAssets.getStatistics().NumSharedMeshes - numSharedMeshes;
+    if (0 != numShared) {
+        osre_debug(Tag, std::to_string(numShared) + " meshes are using the buffers of identical meshes.");
     }
-    mat2MeshMap.clear();
 }
 
 void AssimpWrapper::importNode(const aiNode *node, TransformComponent *parent) {
@@ -415,6 +1242,7 @@ void AssimpWrapper::importNode(const aiNode *node, TransformComponent *parent) {
     }
 
     TransformComponent *newNode = new TransformComponent(node->mName.C_Str(), mAssetContext.mEntity, mAssetContext.mIds, parent);
+    mAssetContext.mNode2Component[node] = newNode;
 
     // If this is the root-node of the model, set it as the root for the model
     if (nullptr == mAssetContext.mParentNode) {
@@ -422,24 +1250,10 @@ void AssimpWrapper::importNode(const aiNode *node, TransformComponent *parent) {
         mAssetContext.mEntity->setNode(newNode);
     }
 
-    if (node->mNumMeshes > 0) {
-        glm::mat4 nodeMatrix;
-        copyAiMatrix4x4(node->mTransformation, nodeMatrix);
-        newNode->setTransformationMatrix(nodeMatrix);
-        for (ui32 meshIdx = 0; meshIdx < node->mNumMeshes; ++meshIdx) {
-            const size_t curMeshIdx = node->mMeshes[meshIdx];
-            if (curMeshIdx >= mAssetContext.mMeshArray.size()) {
-                continue;
-            }
-
-            Mesh *mesh = mAssetContext.mMeshArray[curMeshIdx];
-            if (nullptr != mesh) {
-                newNode->addMeshReference(curMeshIdx);
-                glm::mat4 model = newNode->getWorlTransformMatrix();
-                mesh->setModelMatrix(true, model);
-            }
-        }
-    }
+    // Nodes without meshes pass their transformation to their children as well
+    glm::mat4 nodeMatrix;
+    copyAiMatrix4x4(node->mTransformation, nodeMatrix);
+    newNode->setTransformationMatrix(nodeMatrix);
 
     for (ui32 i = 0; i < node->mNumChildren; ++i) {
         aiNode *currentNode = node->mChildren[i];
@@ -451,103 +1265,391 @@ void AssimpWrapper::importNode(const aiNode *node, TransformComponent *parent) {
     }
 }
 
-void AssimpWrapper::importMaterial(aiMaterial *material) {
-    if (nullptr == material) {
-        osre_trace(Tag, "Nullptr for material detected.");
+static void collectNodeMeshes(const aiNode *node, const glm::mat4 &parent, ui32 numMeshes, AssimpWrapper::MeshInstanceArray &instances) {
+    glm::mat4 nodeMatrix;
+    copyAiMatrix4x4(node->mTransformation, nodeMatrix);
+    const glm::mat4 world = parent * nodeMatrix;
+    for (ui32 i = 0; i < node->mNumMeshes; ++i) {
+        if (node->mMeshes[i] >= numMeshes) {
+            continue;
+        }
+
+        AssimpWrapper::MeshInstance instance;
+        instance.MeshIndex = node->mMeshes[i];
+        instance.Node = node;
+        instance.Transform = world;
+        instances.add(instance);
+    }
+
+    for (ui32 i = 0; i < node->mNumChildren; ++i) {
+        if (nullptr != node->mChildren[i]) {
+            collectNodeMeshes(node->mChildren[i], world, numMeshes, instances);
+        }
+    }
+}
+
+void AssimpWrapper::collectMeshInstances(const aiNode *root, ui32 numMeshes, MeshInstanceArray &instances) {
+    if (nullptr != root) {
+        collectNodeMeshes(root, glm::mat4(1.0f), numMeshes, instances);
+    }
+}
+
+Mesh *AssimpWrapper::createMeshInstance(Mesh *source, SharedAssetCache &cache) {
+    if (nullptr == source) {
+        return nullptr;
+    }
+
+    Mesh *mesh = new Mesh(source->getName(), source->getVertexType(), source->getIndexType());
+    if (!cache.shareBuffers(mesh, source)) {
+        delete mesh;
+        return nullptr;
+    }
+
+    mesh->setMaterial(source->getMaterial());
+    if (0 != source->getNumLods()) {
+        MeshLodArray lods;
+        for (size_t i = 0; i < source->getNumLods(); ++i) {
+            lods.add(source->getLodAt(i));
+        }
+        mesh->setLods(lods);
+    }
+    for (size_t i = 0; i < source->getNumberOfPrimitiveGroups(); ++i) {
+        const PrimitiveGroup *group = source->getPrimitiveGroupAt(i);
+        mesh->addPrimitiveGroup(group->m_numIndices, group->m_primitive, group->m_startIndex);
+    }
+
+    return mesh;
+}
+
+void AssimpWrapper::createMeshInstances() {
+    cppcore::TArray<ImportedMesh *> &importedMeshes = mAssetContext.mImportedMeshes;
+    const aiScene *scene = mAssetContext.mScene;
+    std::vector<ImportedMesh *> sceneMeshes(scene->mNumMeshes, nullptr);
+    for (size_t i = 0; i < importedMeshes.size(); ++i) {
+        sceneMeshes[importedMeshes[i]->MeshIndex] = importedMeshes[i];
+    }
+
+    // The first node referencing a mesh draws it, every further node gets an instance sharing its buffers
+    MeshInstanceArray instances;
+    collectMeshInstances(scene->mRootNode, scene->mNumMeshes, instances);
+    SharedAssetCache &sharedAssets = getSharedAssets();
+    AABB aabb = mAssetContext.mEntity->getAABB();
+    for (size_t i = 0; i < instances.size(); ++i) {
+        const MeshInstance &instance = instances[i];
+        ImportedMesh *importedMesh = sceneMeshes[instance.MeshIndex];
+        if (nullptr == importedMesh) {
+            continue;
+        }
+
+        Mesh *mesh = importedMesh->SceneMesh;
+        if (0 != importedMesh->NumInstances) {
+            mesh = createMeshInstance(importedMesh->SceneMesh, sharedAssets);
+            if (nullptr == mesh) {
+                continue;
+            }
+        }
+        ++importedMesh->NumInstances;
+        mesh->setModelMatrix(true, instance.Transform);
+        if (importedMesh->Bounds.isValid()) {
+            aabb.merge(importedMesh->Bounds.transform(instance.Transform));
+        }
+
+        auto it = mAssetContext.mNode2Component.find(instance.Node);
+        if (mAssetContext.mNode2Component.end() != it) {
+            it->second->addMeshReference(mAssetContext.mMeshArray.size());
+        }
+        mAssetContext.mMeshArray.add(mesh);
+    }
+
+    // Meshes without a referencing node are drawn untransformed
+    for (size_t i = 0; i < importedMeshes.size(); ++i) {
+        ImportedMesh *importedMesh = importedMeshes[i];
+        if (0 == importedMesh->NumInstances) {
+            if (importedMesh->Bounds.isValid()) {
+                aabb.merge(importedMesh->Bounds);
+            }
+            mAssetContext.mMeshArray.add(importedMesh->SceneMesh);
+        }
+        delete importedMesh;
+    }
+    importedMeshes.clear();
+    mAssetContext.mNode2Component.clear();
+    mAssetContext.mEntity->setAABB(aabb);
+}
+
+void AssimpWrapper::importEmbeddedTextures(const aiScene *scene) {
+    if (nullptr == scene || nullptr == scene->mTextures) {
         return;
     }
 
-    i32 texIndex = 0;
-    aiString texPath; // contains filename of texture
-    TextureResourceArray texResArray;
-    if (AI_SUCCESS == material->GetTexture(aiTextureType_DIFFUSE, texIndex, &texPath)) {
-        setTexture(mAssetContext.mRoot, texPath, texResArray, TextureStageType::TextureStage0);
+    for (ui32 i = 0; i < scene->mNumTextures; ++i) {
+        const aiTexture *texture = scene->mTextures[i];
+        if (nullptr == texture || nullptr == texture->pcData) {
+            continue;
+        }
+
+        // An encoded image has no height, its width is the size in bytes
+        auto *tex = new ImportedTexture;
+        tex->Name = getEmbeddedTextureName(mAssetContext.mAbsPathWithFile, i);
+        if (0 == texture->mHeight) {
+            tex->Data = reinterpret_cast<const uc8 *>(texture->pcData);
+            tex->Size = texture->mWidth;
+        } else {
+            tex->Texels = texture->pcData;
+            tex->Width = texture->mWidth;
+            tex->Height = texture->mHeight;
+        }
+        mAssetContext.mTextures.add(tex);
     }
 
-    String matName = texPath.C_Str();
-    if (matName.empty()) {
-        matName = "material1";
+    decodeEmbeddedTextures();
+}
+
+void AssimpWrapper::importEmbeddedTextures(const MeshCacheReader &reader) {
+    for (size_t i = 0; i < reader.getNumEmbeddedTextures(); ++i) {
+        const CachedEmbeddedTexture &cached = reader.getEmbeddedTexture(i);
+        auto *tex = new ImportedTexture;
+        tex->Name = reader.getString(cached.Name);
+        tex->Data = reader.getEmbeddedTextureData(cached);
+        tex->Size = static_cast<size_t>(cached.DataSize);
+        tex->Width = cached.Width;
+        tex->Height = cached.Height;
+        mAssetContext.mTextures.add(tex);
     }
 
-    Material *osreMat = MaterialBuilder::createTexturedMaterial(matName, texResArray, VertexType::RenderVertex);
-    if (nullptr == osreMat) {
-        osre_error(Tag, "Error while creating material for " + matName);
+    decodeEmbeddedTextures();
+}
+
+void AssimpWrapper::decodeEmbeddedTextures() {
+    cppcore::TArray<ImportedTexture *> &textures = mAssetContext.mTextures;
+    if (textures.isEmpty()) {
         return;
     }
 
-    mAssetContext.mMatArray.add(osreMat);
-    Color4 color;
-    const aiColor4D defaultColor(1, 1, 1, 1);
-    aiColor4D diffuse = defaultColor;
-    if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_DIFFUSE, &diffuse)) {
-        setColor4(diffuse, color);
-        osreMat->setColor(MaterialColorType::Mat_Diffuse, color);
+    Threading::WorkerPool &pool = nullptr != mWorkerPool ? *mWorkerPool : Threading::WorkerPool::getInstance();
+    pool.parallelFor(textures.size(), 1, [&](size_t begin, size_t end) {
+        TextureLoader loader;
+        for (size_t i = begin; i < end; ++i) {
+            ImportedTexture &tex = *textures[i];
+            if (nullptr != tex.Texels) {
+                const size_t numTexels = static_cast<size_t>(tex.Width) * tex.Height;
+                tex.Pixels.resize(numTexels * 4);
+                for (size_t j = 0; j < numTexels; ++j) {
+                    const aiTexel &texel = tex.Texels[j];
+                    tex.Pixels[j * 4] = texel.r;
+                    tex.Pixels[j * 4 + 1] = texel.g;
+                    tex.Pixels[j * 4 + 2] = texel.b;
+                    tex.Pixels[j * 4 + 3] = texel.a;
+                }
+                tex.Data = tex.Pixels.data();
+                tex.Size = tex.Pixels.size();
+            }
+
+            tex.Key = MeshCache::hashData(tex.Data, tex.Size);
+            tex.Resource = new TextureResource(tex.Name, IO::Uri(tex.Name));
+            const ResourceState state = 0 == tex.Width ? tex.Resource->loadFromMemory(tex.Data, tex.Size, loader) :
+                    tex.Resource->loadFromPixels(tex.Data, tex.Width, tex.Height, 4, loader);
+            if (ResourceState::Loaded != state) {
+                releaseTextureResource(tex.Resource);
+                tex.Resource = nullptr;
+            }
+        }
+    });
+}
+
+void AssimpWrapper::registerEmbeddedTextures() {
+    // Textures which are known already are released, the materials will use the registered ones
+    SharedAssetCache &sharedAssets = getSharedAssets();
+    for (size_t i = 0; i < mAssetContext.mTextures.size(); ++i) {
+        ImportedTexture &tex = *mAssetContext.mTextures[i];
+        if (nullptr == tex.Resource) {
+            osre_error(Tag, "Cannot decode the embedded texture " + tex.Name);
+            continue;
+        }
+        if (!sharedAssets.addTextureResource(tex.Name, tex.Key, tex.Resource)) {
+            releaseTextureResource(tex.Resource);
+        }
+        tex.Resource = nullptr;
     }
+}
 
-    aiColor4D specular = defaultColor;
-    if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_SPECULAR, &specular)) {
-        setColor4(specular, color);
-        osreMat->setColor(MaterialColorType::Mat_Specular, color);
+void AssimpWrapper::importMaterial(aiMaterial *material, VertexType type) {
+    // The description will be stored in the mesh cache as well, the material is created on the main thread
+    MaterialDesc desc;
+    desc.Type = type;
+    if (nullptr == material) {
+        osre_trace(Tag, "Nullptr for material detected.");
+        desc.Name = "material1";
+        mAssetContext.mMatDescArray.add(desc);
+        return;
     }
 
-    aiColor4D ambient = defaultColor;
-    if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_AMBIENT, &ambient)) {
-        setColor4(ambient, color);
-        osreMat->setColor(MaterialColorType::Mat_Ambient, color);
+    i32 texIndex = 0;
+    aiString texPath; // contains filename of texture
+    if (AI_SUCCESS == material->GetTexture(aiTextureType_DIFFUSE, texIndex, &texPath)) {
+        setTexture(mAssetContext.mScene, mAssetContext.mAbsPathWithFile, mAssetContext.mRoot, texPath, desc,
+                TextureStageType::TextureStage0);
     }
 
-    aiColor4D emission = defaultColor;
-    if (AI_SUCCESS == aiGetMaterialColor(material, AI_MATKEY_COLOR_EMISSIVE, &emission)) {
-        setColor4(emission, color);
-        osreMat->setColor(MaterialColorType::Mat_Emission, color);
+    desc.Name = texPath.C_Str();
+    if (desc.Name.empty()) {
+        desc.Name = "material1";
     }
 
+    setColor(material, AI_MATKEY_COLOR_DIFFUSE, MaterialColorType::Mat_Diffuse, desc);
+    setColor(material, AI_MATKEY_COLOR_SPECULAR, MaterialColorType::Mat_Specular, desc);
+    setColor(material, AI_MATKEY_COLOR_AMBIENT, MaterialColorType::Mat_Ambient, desc);
+    setColor(material, AI_MATKEY_COLOR_EMISSIVE, MaterialColorType::Mat_Emission, desc);
+
     ai_real shininess = 1.0, strength = 1.0;
     unsigned int max; // changed: to unsigned
     if (AI_SUCCESS == aiGetMaterialFloatArray(material, AI_MATKEY_SHININESS, &shininess, &max)) {
-        osreMat->setFloatParameter(MaterialParameterType::Shineness, shininess);
+        desc.Parameters[static_cast<size_t>(MaterialParameterType::Shineness)] = shininess;
+        desc.ParameterMask |= 1u << static_cast<ui32>(MaterialParameterType::Shineness);
     }
 
     if (AI_SUCCESS == aiGetMaterialFloatArray(material, AI_MATKEY_SHININESS_STRENGTH, &strength, &max)) {
-        osreMat->setFloatParameter(MaterialParameterType::ShinenessStrength, strength);
+        desc.Parameters[static_cast<size_t>(MaterialParameterType::ShinenessStrength)] = strength;
+        desc.ParameterMask |= 1u << static_cast<ui32>(MaterialParameterType::ShinenessStrength);
     }
-}
 
-using Bone2NodeMap = cppcore::THashMap<int, TransformComponent *>;
+    mAssetContext.mMatDescArray.add(desc);
+}
 
-void AssimpWrapper::importAnimations(const aiScene *scene) {
-    if (scene == nullptr) {
+void AssimpWrapper::importSkeleton(const aiScene *scene) {
+    if (nullptr == scene || nullptr == scene->mRootNode) {
         return;
     }
 
-    for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+    // Every bone is stored once, even if it deforms several meshes
+    Skeleton skeleton;
+    std::map<String, i32> bone2Index;
+    for (ui32 i = 0; i < scene->mNumMeshes; ++i) {
         const aiMesh *mesh = scene->mMeshes[i];
-        for (unsigned int n = 0; n < mesh->mNumBones; ++n) {
-            const aiBone *bone = mesh->mBones[n];
-            mAssetContext.mBone2NodeMap[bone->mName.data] = scene->mRootNode->FindNode(bone->mName);
+        if (nullptr == mesh) {
+            continue;
+        }
+
+        for (ui32 j = 0; j < mesh->mNumBones; ++j) {
+            const aiBone *bone = mesh->mBones[j];
+            if (nullptr == bone || bone2Index.find(bone->mName.C_Str()) != bone2Index.end()) {
+                continue;
+            }
+
+            Bone *newBone = new Bone;
+            newBone->mName = bone->mName.C_Str();
+            copyAiMatrix4x4(bone->mOffsetMatrix, newBone->m_offsetMatrix);
+            bone2Index[newBone->mName] = static_cast<i32>(skeleton.mBones.size());
+            skeleton.mBones.add(newBone);
+            mAssetContext.mBone2NodeMap[newBone->mName] = scene->mRootNode->FindNode(bone->mName);
         }
     }
 
-    for (ui32 animIndex = 0; animIndex < scene->mNumAnimations; ++animIndex) {
-        aiAnimation *currentAnim = scene->mAnimations[animIndex];
-        if (currentAnim == nullptr) {
+    const size_t numBones = skeleton.mBones.size();
+    if (0 == numBones) {
+        return;
+    }
+
+    // The parent of a bone is its next ancestor node, which is a bone as well
+    for (size_t i = 0; i < numBones; ++i) {
+        Bone *bone = skeleton.mBones[i];
+        const aiNode *node = mAssetContext.mBone2NodeMap[bone->mName];
+        for (const aiNode *parent = nullptr != node ? node->mParent : nullptr; nullptr != parent; parent = parent->mParent) {
+            const auto it = bone2Index.find(parent->mName.C_Str());
+            if (bone2Index.end() != it) {
+                bone->mParent = it->second;
+                break;
+            }
+        }
+    }
+
+    // The bones will be stored in joint order, so the vertices can address the skinning palette directly
+    SkeletonRig rig;
+    if (numBones > MaxSkinningJoints || !rig.create(skeleton)) {
+        osre_warn(Tag, "Cannot use the skeleton with " + std::to_string(numBones) + " bones for skinning.");
+        for (size_t i = 0; i < numBones; ++i) {
+            delete skeleton.mBones[i];
+        }
+        return;
+    }
+
+    Skeleton &target = mAssetContext.mSkeleton;
+    target.mName = scene->mRootNode->mName.C_Str();
+    target.mRootBone = 0;
+    target.mBones.resize(numBones);
+    for (size_t i = 0; i < numBones; ++i) {
+        const i32 joint = rig.getJointByBone(i);
+        Bone *bone = skeleton.mBones[i];
+        bone->mParent = rig.getParent(joint);
+        target.mBones[joint] = bone;
+        mAssetContext.mBone2JointMap[bone->mName] = joint;
+    }
+}
+
+bool AssimpWrapper::convertAnimation(const aiAnimation *animation, const CompressionSettings *settings, AnimationTrack &track) {
+    if (nullptr == animation || 0 == animation->mNumChannels) {
+        return false;
+    }
+
+    track.duration = static_cast<f32>(animation->mDuration);
+    track.ticksPerSecond = animation->mTicksPerSecond > 0.0 ? static_cast<f32>(animation->mTicksPerSecond) : 1.0f;
+    track.numVectorChannels = animation->mNumChannels;
+    delete[] track.animationChannels;
+    track.animationChannels = new AnimationChannel[animation->mNumChannels];
+    for (ui32 channelIndex = 0; channelIndex < animation->mNumChannels; ++channelIndex) {
+        const aiNodeAnim *nodeAnim = animation->mChannels[channelIndex];
+        if (nodeAnim == nullptr) {
             continue;
         }
 
-        if (currentAnim->mNumChannels > 0) {
-            AnimationChannel *channels = new AnimationChannel[currentAnim->mNumChannels];
-            for (ui32 channdelIndex = 0; channdelIndex < currentAnim->mNumChannels; ++channdelIndex) {
-                AnimationChannel &channel = channels[channdelIndex];
-                aiNodeAnim *nodeAnim = currentAnim->mChannels[channdelIndex];
-                if (nodeAnim == nullptr) {
-                    continue;
-                }
-                channel.PositionKeys.resize(nodeAnim->mNumPositionKeys);
+        AnimationChannel &channel = track.animationChannels[channelIndex];
+        channel.NodeName = nodeAnim->mNodeName.C_Str();
+        channel.PositionKeys.resize(nodeAnim->mNumPositionKeys);
+        for (ui32 i = 0; i < nodeAnim->mNumPositionKeys; ++i) {
+            const aiVectorKey &key = nodeAnim->mPositionKeys[i];
+            channel.PositionKeys[i].Time = static_cast<f32>(key.mTime);
+            channel.PositionKeys[i].Value = glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z);
+        }
 
-                channel.RotationKeys.resize(nodeAnim->mNumRotationKeys);
+        channel.RotationKeys.resize(nodeAnim->mNumRotationKeys);
+        for (ui32 i = 0; i < nodeAnim->mNumRotationKeys; ++i) {
+            const aiQuatKey &key = nodeAnim->mRotationKeys[i];
+            channel.RotationKeys[i].Time = key.mTime;
+            channel.RotationKeys[i].Quad = glm::quat(key.mValue.w, key.mValue.x, key.mValue.y, key.mValue.z);
+        }
 
-                channel.RotationKeys.resize(nodeAnim->mNumScalingKeys);
-            }
+        channel.ScalingKeys.resize(nodeAnim->mNumScalingKeys);
+        for (ui32 i = 0; i < nodeAnim->mNumScalingKeys; ++i) {
+            const aiVectorKey &key = nodeAnim->mScalingKeys[i];
+            channel.ScalingKeys[i].Time = key.mTime;
+            channel.ScalingKeys[i].Scale = glm::vec3(key.mValue.x, key.mValue.y, key.mValue.z);
+        }
+    }
+
+    // The raw keys are released, the sampler will use the compressed clip
+    if (nullptr != settings && !AnimationCompressor::compressTrack(track, *settings)) {
+        osre_warn(Tag, "Cannot compress the animation " + String(animation->mName.C_Str()) + ", the raw keys are used.");
+    }
+
+    return true;
+}
+
+void AssimpWrapper::importAnimations(const aiScene *scene) {
+    if (scene == nullptr || !scene->HasAnimations()) {
+        return;
+    }
+
+    AnimatorComponent *animator = (AnimatorComponent *)mAssetContext.mEntity->createComponent(ComponentType::AnimationComponentType);
+    if (animator == nullptr) {
+        osre_error(Tag, "Cannot create the animator component.");
+        return;
+    }
+
+    const CompressionSettings *settings = mCompressAnimations ? &mAnimCompression : nullptr;
+    for (ui32 animIndex = 0; animIndex < scene->mNumAnimations; ++animIndex) {
+        const aiAnimation *animation = scene->mAnimations[animIndex];
+        if (nullptr != animation && animation->mNumChannels > 0) {
+            convertAnimation(animation, settings, *animator->createAnimation());
         }
     }
 }
@@ -23,12 +23,15 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include "RenderBackend/RenderCommon.h"
+#include "Animation/AnimationCompression.h"
 #include "Animation/AnimatorBase.h"
+#include "App/MeshCache.h"
 #include "Common/Ids.h"
 #include "Common/TAABB.h"
 
 #include <assimp/cimport.h>
 #include <cppcore/Container/TArray.h>
+#include <chrono>
 #include <map>
 
 // Forward declarations ---------------------------------------------------------------------------
@@ -56,16 +59,55 @@ namespace RenderBackend {
     struct UniformVar;
 }
 
+namespace Animation {
+    struct AnimationTrack;
+}
+
 namespace IO {
     class Uri;
 }
+
+namespace Threading {
+    class WorkerPool;
+}
     
 namespace App {
 
 class Entity;
 class Scene;
+class SharedAssetCache;
 class TransformComponent;
 
+struct ImportedMesh;
+struct ImportedTexture;
+
+/// @brief The stages of a model import.
+enum class ImportStage : i32 {
+    Parse = 0,      ///< Parsing the file.
+    Materials,      ///< Collecting the skeleton and the material descriptions.
+    Meshes,         ///< Converting the meshes.
+    Textures,       ///< Creating the materials and their textures.
+    Upload,         ///< Creating the entity and attaching it to the scene.
+    Count           ///< Number of enums.
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup    Engine
+///
+///	@brief  This interface will receive the progress of an import.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT ImportProgressHandler {
+public:
+    /// @brief The class destructor, virtual.
+    virtual ~ImportProgressHandler() = default;
+
+    /// @brief Will be called when the import has made progress, it is called by the importing thread.
+    /// @param[in] stage        The current stage.
+    /// @param[in] progress     The progress of the stage, from 0 to 1.
+    /// @return false to cancel the import.
+    virtual bool onProgress(ImportStage stage, f32 progress) = 0;
+};
+
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup    Engine
 ///
@@ -77,7 +119,33 @@ public:
     using MaterialArray = cppcore::TArray<RenderBackend::Material *>;
 
     /// @brief Alias for bone to node relations.
-    using Bone2NodeMap = std::map<const char *, const aiNode *>;
+    using Bone2NodeMap = std::map<String, const aiNode *>;
+
+    /// @brief The wall time of the import phases in milliseconds.
+    struct ImportTimings {
+        d32 CacheRead = 0.0;        ///< Validating and converting the mesh cache.
+        d32 Parse = 0.0;            ///< Parsing the file with assimp.
+        d32 Materials = 0.0;        ///< Importing the skeleton and the materials.
+        d32 MeshPrepare = 0.0;      ///< Sizing the buffers of the meshes.
+        d32 MeshConvert = 0.0;      ///< Converting the vertex attributes and the indices.
+        d32 MeshLods = 0.0;         ///< Generating the levels of detail.
+        d32 MeshMerge = 0.0;        ///< Creating the meshes from the converted buffers.
+        d32 Textures = 0.0;         ///< Decoding the embedded textures.
+        d32 Nodes = 0.0;            ///< Importing the node hierarchy and instancing the meshes.
+        d32 Animations = 0.0;       ///< Importing the animations.
+        d32 CacheWrite = 0.0;       ///< Writing the mesh cache.
+        d32 Total = 0.0;            ///< The complete import.
+    };
+
+    /// @brief A mesh of the scene drawn by a node.
+    struct MeshInstance {
+        ui32 MeshIndex = 0;             ///< The index of the mesh in the scene.
+        const aiNode *Node = nullptr;   ///< The node referencing the mesh.
+        glm::mat4 Transform;            ///< The world transformation of the node.
+    };
+
+    /// @brief Alias for mesh instance arrays.
+    using MeshInstanceArray = cppcore::TArray<MeshInstance>;
 
     /// @brief The class constructor.
     /// @param ids      The id container.
@@ -87,12 +155,62 @@ public:
     ///	@brief  The default class destructor.
     ~AssimpWrapper();
 
-    /// @brief Will perform the import operation.
+    /// @brief Will perform the import operation. A valid mesh cache of the file will be used instead of
+    /// importing it, after an import the cache will be written.
     /// @param file     The file to load.
     /// @param flags    The flags for the import.
     /// @return true, if successful. false if not.
     bool importAsset( const IO::Uri &file, ui32 flags );
 
+    /// @brief Will load the file and convert the meshes, but will not create any engine objects.
+    /// This part of the import can run on a worker thread.
+    /// @param file     The file to load.
+    /// @param flags    The flags for the import.
+    /// @return true, if successful. false in case of an error or when the import was cancelled.
+    bool loadAsset(const IO::Uri &file, ui32 flags);
+
+    /// @brief Will create the entity from a loaded asset, must be called on the main thread.
+    /// @return The new entity, nullptr in case of an error or when the import was cancelled.
+    Entity *createEntity();
+
+    /// @brief Will set the handler for the import progress.
+    /// @param[in] handler      The handler, nullptr for none. Must stay valid during the import.
+    void setProgressHandler(ImportProgressHandler *handler);
+
+    /// @brief Will set the worker pool for the mesh conversion.
+    /// @param[in] pool         The pool, nullptr for the shared pool.
+    void setWorkerPool(Threading::WorkerPool *pool);
+
+    /// @brief Will set the cache for the deduplication of meshes, textures and materials.
+    /// @param[in] cache        The cache, nullptr for the cache shared by all imports.
+    void setSharedAssetCache(SharedAssetCache *cache);
+
+    /// @brief Will set the compression of the imported animation tracks, it is enabled by default.
+    /// @param[in] enabled      true to compress the tracks, false to keep the raw keys.
+    /// @param[in] settings     The error tolerances of the key reduction.
+    void setAnimationCompression(bool enabled, const Animation::CompressionSettings &settings = Animation::CompressionSettings());
+
+    /// @brief Will convert an animation into a track.
+    /// @param[in]  animation   The animation.
+    /// @param[in]  settings    The tolerances for the compression, nullptr to keep the raw keys.
+    /// @param[out] track       The track.
+    /// @return false if the animation has no channels.
+    static bool convertAnimation(const aiAnimation *animation, const Animation::CompressionSettings *settings,
+            Animation::AnimationTrack &track);
+
+    /// @brief Will collect the meshes drawn by the node hierarchy, a mesh referenced by several nodes
+    /// gets one instance per node.
+    /// @param[in]  root        The root node.
+    /// @param[in]  numMeshes   The number of meshes in the scene, invalid references will be ignored.
+    /// @param[out] instances   The instances in depth-first node order.
+    static void collectMeshInstances(const aiNode *root, ui32 numMeshes, MeshInstanceArray &instances);
+
+    /// @brief Will create a mesh, which draws the buffers of another mesh with its own transformation.
+    /// @param[in] source       The mesh owning the buffers.
+    /// @param[in] cache        The cache to share the buffers with.
+    /// @return The new mesh, nullptr if the source has no buffers to share.
+    static RenderBackend::Mesh *createMeshInstance(RenderBackend::Mesh *source, SharedAssetCache &cache);
+
     /// @brief  Will return the imported entity.
     /// @return The imported entity, nullptr if nothing was imported.
     Entity *getEntity() const;
@@ -103,36 +221,79 @@ public:
     void getStatistics(ui32 &numVertices, ui32 &numTriangles);
 
     /// @brief Will return the scene.
-    /// @return The scene.
+    /// @return The scene, nullptr if the model was loaded from the mesh cache.
     const aiScene *getScene() const;
 
+    /// @brief Will return true, if the last model was loaded from the mesh cache.
+    /// @return true if loaded from the cache.
+    bool isLoadedFromCache() const;
+
+    /// @brief Will return the timing breakdown of the last import.
+    /// @return The timings of the import phases.
+    const ImportTimings &getImportTimings() const;
+
+    /// @brief Will return the skeleton of the model, the bones are stored in joint order.
+    /// @return The skeleton, it has no bones for static models.
+    const Animation::Skeleton &getSkeleton() const;
+
 protected:
     Entity *convertScene();
-    void importMeshes( aiMesh **meshes, ui32 numMeshes );
+    bool reportProgress(ImportStage stage, f32 progress);
+    SharedAssetCache &getSharedAssets() const;
+    void convertMeshes(aiMesh **meshes, ui32 numMeshes);
+    void createMeshes();
     void importNode(const aiNode *node, TransformComponent *parent );
-    void importMaterial( aiMaterial *material );
+    void createMeshInstances();
+    void importMaterial( aiMaterial *material, RenderBackend::VertexType type );
+    void importSkeleton(const aiScene *scene);
     void importAnimations(const aiScene *scene);
     void optimizeVertexBuffer();
+    void importEmbeddedTextures(const aiScene *scene);
+    void importEmbeddedTextures(const MeshCacheReader &reader);
+    void decodeEmbeddedTextures();
+    void registerEmbeddedTextures();
+    Entity *convertCache(const MeshCacheReader &reader);
+    bool writeCache(const String &filename, ui64 key);
 
 private:
     aiLogStream mStream;
     Assimp::Importer *mImporter;
+    ImportTimings mTimings;
+    ImportProgressHandler *mProgressHandler;
+    Threading::WorkerPool *mWorkerPool;
+    SharedAssetCache *mSharedAssets;
+    bool mCancelled;
+    bool mCompressAnimations;
+    Animation::CompressionSettings mAnimCompression;
     struct AssetContext {
         const aiScene *mScene;
         RenderBackend::MeshArray mMeshArray;
         Entity *mEntity;
         Scene *mWorld;
         MaterialArray mMatArray;
+        cppcore::TArray<MaterialDesc> mMatDescArray;
         App::TransformComponent *mParentNode;
         Common::Ids &mIds;
         String mRoot;
         String mAbsPathWithFile;
         Bone2NodeMap mBone2NodeMap;
+        Animation::Skeleton mSkeleton;
+        std::map<String, i32> mBone2JointMap;
+        cppcore::TArray<ImportedMesh *> mImportedMeshes;
+        RenderBackend::MeshArray mSceneMeshes;
+        std::map<const aiNode *, TransformComponent *> mNode2Component;
+        cppcore::TArray<ImportedTexture *> mTextures;
+        MeshCacheReader mCacheReader;
+        String mCacheFile;
+        cppcore::TArray<String> mDependencies;
+        ui64 mCacheKey;
+        std::chrono::steady_clock::time_point mImportStart;
         ui32 mNumVertices;
         ui32 mNumTriangles;
-        
+        bool mFromCache;
+
         AssetContext(Common::Ids &ids, Scene *world);
-        ~AssetContext() = default;
+        ~AssetContext();
         AssetContext(const AssetContext &) = delete;
         AssetContext &operator=(const AssetContext&) = delete;
     } mAssetContext;
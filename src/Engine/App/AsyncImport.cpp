@@ -0,0 +1,166 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "App/AsyncImport.h"
+#include "Common/Logger.h"
+#include "IO/Uri.h"
+#include "Threading/WorkerPool.h"
+
+namespace OSRE::App {
+
+using namespace ::OSRE::Common;
+
+DECL_OSRE_LOG_MODULE(AsyncImport)
+
+// The share of every stage in the overall progress
+static constexpr f32 StageStart[static_cast<size_t>(ImportStage::Count) + 1] = { 0.0f, 0.4f, 0.45f, 0.8f, 0.9f, 1.0f };
+
+AsyncImport::AsyncImport(Ids &ids, Scene *world) :
+        mWrapper(ids, world),
+        mWorkerPool(),
+        mThread(),
+        mState(static_cast<i32>(AsyncImportState::Idle)),
+        mStage(static_cast<i32>(ImportStage::Parse)),
+        mProgress(0.0f),
+        mCancelRequested(false),
+        mReportedProgress(-1.0f),
+        mCallback(),
+        mEntity(nullptr) {
+    mWrapper.setProgressHandler(this);
+}
+
+AsyncImport::~AsyncImport() {
+    cancel();
+    join();
+}
+
+bool AsyncImport::start(const IO::Uri &file, ui32 flags) {
+    if (AsyncImportState::Idle != getState()) {
+        osre_error(Tag, "The import was already started.");
+        return false;
+    }
+
+    if (!file.isValid()) {
+        osre_error(Tag, "URI " + file.getUri() + " is invalid.");
+        return false;
+    }
+
+    // The import gets its own pool, so the jobs of the frames will not wait for it
+    const size_t numCores = std::thread::hardware_concurrency();
+    mWorkerPool.reset(new Threading::WorkerPool(numCores > 2 ? numCores / 2 : 1));
+    mWrapper.setWorkerPool(mWorkerPool.get());
+
+    mState = static_cast<i32>(AsyncImportState::Loading);
+    mThread = std::thread([this, file, flags]() {
+        const bool loaded = mWrapper.loadAsset(file, flags);
+        AsyncImportState state = loaded ? AsyncImportState::Loaded : AsyncImportState::Failed;
+        if (mCancelRequested) {
+            state = AsyncImportState::Cancelled;
+        }
+        mState = static_cast<i32>(state);
+    });
+
+    return true;
+}
+
+void AsyncImport::cancel() {
+    mCancelRequested = true;
+}
+
+bool AsyncImport::update() {
+    const AsyncImportState state = getState();
+    if (AsyncImportState::Idle == state) {
+        return false;
+    }
+
+    if (AsyncImportState::Loading == state) {
+        if (mCallback && mReportedProgress != getProgress()) {
+            mReportedProgress = getProgress();
+            mCallback(getStage(), mReportedProgress);
+        }
+        return false;
+    }
+
+    join();
+    if (AsyncImportState::Loaded == state) {
+        // The engine objects are created here, on the main thread
+        if (!mCancelRequested) {
+            mEntity = mWrapper.createEntity();
+        }
+
+        AsyncImportState result = nullptr != mEntity ? AsyncImportState::Finished : AsyncImportState::Failed;
+        if (mCancelRequested) {
+            result = AsyncImportState::Cancelled;
+        }
+        mState = static_cast<i32>(result);
+        mWorkerPool.reset();
+    }
+
+    if (mCallback && mReportedProgress != getProgress()) {
+        mReportedProgress = getProgress();
+        mCallback(getStage(), mReportedProgress);
+    }
+
+    return true;
+}
+
+void AsyncImport::setProgressCallback(const ProgressCallback &callback) {
+    mCallback = callback;
+}
+
+const c8 *AsyncImport::getStageName(ImportStage stage) {
+    switch (stage) {
+        case ImportStage::Parse:
+            return "Parse";
+        case ImportStage::Materials:
+            return "Materials";
+        case ImportStage::Meshes:
+            return "Meshes";
+        case ImportStage::Textures:
+            return "Textures";
+        case ImportStage::Upload:
+            return "Upload";
+        default:
+            break;
+    }
+
+    return "Invalid";
+}
+
+bool AsyncImport::onProgress(ImportStage stage, f32 progress) {
+    const size_t index = static_cast<size_t>(stage);
+    if (index < static_cast<size_t>(ImportStage::Count)) {
+        progress = progress < 0.0f ? 0.0f : (progress > 1.0f ? 1.0f : progress);
+        mStage = static_cast<i32>(stage);
+        mProgress = StageStart[index] + (StageStart[index + 1] - StageStart[index]) * progress;
+    }
+
+    return !mCancelRequested;
+}
+
+void AsyncImport::join() {
+    if (mThread.joinable()) {
+        mThread.join();
+    }
+}
+
+} // namespace OSRE::App
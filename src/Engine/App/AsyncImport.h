@@ -0,0 +1,167 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "App/AssimpWrapper.h"
+#include "Common/osre_common.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+
+namespace OSRE {
+
+namespace Common {
+    class Ids;
+}
+
+namespace Threading {
+    class WorkerPool;
+}
+
+namespace App {
+
+class Entity;
+class Scene;
+
+/// @brief The states of an asynchronous import.
+enum class AsyncImportState : i32 {
+    Idle = 0,       ///< Not started.
+    Loading,        ///< The file is loaded on the background thread.
+    Loaded,         ///< Loading is done, waiting for the main thread to create the entity.
+    Finished,       ///< The entity was created.
+    Failed,         ///< The import failed.
+    Cancelled,      ///< The import was cancelled.
+    Count           ///< Number of enums.
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class imports a model on a background thread, it is the handle of the import.
+///
+/// The file is parsed and the meshes are converted on a background thread, using an own worker
+/// pool so the frame jobs are not blocked. The entity, the materials and the meshes are created
+/// on the main thread, when update is called after the loading has been finished. The progress
+/// callback is called by update on the main thread as well.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT AsyncImport : public ImportProgressHandler {
+public:
+    /// @brief The progress callback, will get the stage and the overall progress from 0 to 1.
+    using ProgressCallback = std::function<void(ImportStage stage, f32 progress)>;
+
+    /// @brief The class constructor.
+    /// @param[in] ids      The id container.
+    /// @param[in] world    The world to put the imported entity in.
+    AsyncImport(Common::Ids &ids, Scene *world);
+
+    /// @brief The class destructor, a running import will be cancelled.
+    ~AsyncImport() override;
+
+    /// @brief Will start the import on a background thread.
+    /// @param[in] file     The file to import.
+    /// @param[in] flags    The import flags, 0 for the default flags.
+    /// @return true if started, false for an invalid uri or an import which was already started.
+    bool start(const IO::Uri &file, ui32 flags);
+
+    /// @brief Will request the cancellation, the import will stop at the next progress report.
+    void cancel();
+
+    /// @brief Will check the import, must be called by the main thread. When the loading is done,
+    /// the entity will be created.
+    /// @return true if the import is done, check the state for the result.
+    bool update();
+
+    /// @brief Will set the progress callback, it will be called by update.
+    /// @param[in] callback The callback.
+    void setProgressCallback(const ProgressCallback &callback);
+
+    /// @brief Will return the state.
+    /// @return The state.
+    AsyncImportState getState() const;
+
+    /// @brief Will return the current stage.
+    /// @return The stage.
+    ImportStage getStage() const;
+
+    /// @brief Will return the overall progress.
+    /// @return The progress from 0 to 1.
+    f32 getProgress() const;
+
+    /// @brief Will return the imported entity.
+    /// @return The entity, nullptr if the import is not finished.
+    Entity *getEntity() const;
+
+    /// @brief Will return the wrapper, use it for the statistics and timings after the import.
+    /// @return The wrapper.
+    const AssimpWrapper &getWrapper() const;
+
+    /// @brief Will return the name of a stage.
+    /// @param[in] stage    The stage.
+    /// @return The name.
+    static const c8 *getStageName(ImportStage stage);
+
+    /// @brief The progress handler, called by the importing thread.
+    bool onProgress(ImportStage stage, f32 progress) override;
+
+    OSRE_NON_COPYABLE(AsyncImport)
+
+private:
+    void join();
+
+private:
+    AssimpWrapper mWrapper;
+    std::unique_ptr<Threading::WorkerPool> mWorkerPool;
+    std::thread mThread;
+    std::atomic<i32> mState;
+    std::atomic<i32> mStage;
+    std::atomic<f32> mProgress;
+    std::atomic<bool> mCancelRequested;
+    f32 mReportedProgress;
+    ProgressCallback mCallback;
+    Entity *mEntity;
+};
+
+inline AsyncImportState AsyncImport::getState() const {
+    return static_cast<AsyncImportState>(mState.load());
+}
+
+inline ImportStage AsyncImport::getStage() const {
+    return static_cast<ImportStage>(mStage.load());
+}
+
+inline f32 AsyncImport::getProgress() const {
+    return mProgress.load();
+}
+
+inline Entity *AsyncImport::getEntity() const {
+    return mEntity;
+}
+
+inline const AssimpWrapper &AsyncImport::getWrapper() const {
+    return mWrapper;
+}
+
+} // Namespace App
+} // Namespace OSRE
@@ -25,6 +25,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "RenderBackend/RenderBackendService.h"
 #include "Common/glm_common.h"
 
+#include <cmath>
+#include <limits>
+
 namespace OSRE::App {
 
 using namespace ::OSRE::Common;
@@ -111,6 +114,20 @@ void CameraComponent::setLookAt(const glm::vec3 &eyePosition, const glm::vec3 &c
     mUp = up;
 }
 
+f32 CameraComponent::getScreenSize(f32 size, f32 distance) const {
+    // The orthogonal projection maps world units directly onto the viewport
+    if (mCameraModel != CameraModel::Perspective) {
+        return size;
+    }
+
+    const f32 projectedHeight = 2.0f * distance * std::tan(mFOV * 0.5f);
+    if (projectedHeight <= 0.0f) {
+        return std::numeric_limits<f32>::max();
+    }
+
+    return size * mResolution.height / projectedHeight;
+}
+
 void CameraComponent::setProjectionMode(f32 fov, f32 aspectRatio, f32 nearPlane, f32 farPlane) {
     mFOV = fov;
     mAspectRatio = aspectRatio;
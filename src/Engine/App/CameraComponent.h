@@ -150,6 +150,12 @@ public:
     /// @return the up-vector.
     const glm::vec3 &getUp() const;
 
+    /// @brief  Will return the projected size of an extent at the given distance in pixels.
+    /// @param[in] size      The extent in world units.
+    /// @param[in] distance  The distance to the eye.
+    /// @return The size on the screen in pixels.
+    f32 getScreenSize(f32 size, f32 distance) const;
+
 protected:
     bool onUpdate(Time dt) override;
     bool onRender(RenderBackend::RenderBackendService *renderBackendSrv) override;
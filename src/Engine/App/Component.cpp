@@ -45,7 +45,7 @@ void Component::render(RenderBackendService *renderBackendSrv) {
 }
 
 RenderComponent::RenderComponent(Entity *owner) :
-        Component(owner, ComponentType::RenderComponentType), m_newGeo() {
+        Component(owner, ComponentType::RenderComponentType), mMeshes(), m_newGeo() {
     // empty
 }
 
@@ -54,6 +54,7 @@ void RenderComponent::addStaticMesh(Mesh *geo) {
         return;
     }
 
+    mMeshes.add(geo);
     m_newGeo.add(geo);
 }
 
@@ -63,20 +64,25 @@ void RenderComponent::addStaticMeshArray(const RenderBackend::MeshArray &array)
     }
 
     for (size_t i = 0; i < array.size(); ++i) {
+        mMeshes.add(array[i]);
         m_newGeo.add(array[i]);
     }
 }
 
 size_t RenderComponent::getNumMeshes() const {
-    return m_newGeo.size();
+    return mMeshes.size();
 }
 
 Mesh *RenderComponent::getMeshAt(size_t idx) const {
-    return m_newGeo[idx];
+    if (idx >= mMeshes.size()) {
+        return nullptr;
+    }
+
+    return mMeshes[idx];
 }
 
 void RenderComponent::getMeshArray(MeshArray &meshArray) {
-    meshArray = m_newGeo;
+    meshArray = mMeshes;
 }
 
 bool RenderComponent::onUpdate(Time) {
@@ -157,6 +157,7 @@ protected:
     bool onRender(RenderBackend::RenderBackendService *rbSrv) override;
 
 private:
+    cppcore::TArray<RenderBackend::Mesh*> mMeshes;
     cppcore::TArray<RenderBackend::Mesh*> m_newGeo;
 };
 
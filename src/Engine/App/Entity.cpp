@@ -28,6 +28,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "RenderBackend/MeshProcessor.h"
 #include "Common/Logger.h"
 
+#include <algorithm>
+
 namespace OSRE::App {
 
 using namespace ::OSRE::Common;
@@ -56,13 +58,14 @@ Entity::Entity(const String &name, Common::Ids &ids, Scene *world) :
 }
 
 Entity::~Entity() {
+    // Leave the scene first, it will unregister the components from its systems
+    if (nullptr != mOwner) {
+        mOwner->removeEntity(this);
+    }
     for (auto & i : mComponentArray) {
         delete i;
     }
     mRenderComponent = nullptr;
-    if (nullptr != mOwner) {
-        mOwner->removeEntity(this);
-    }
 }
 
 void Entity::setNode(TransformComponent *node) {
@@ -109,9 +112,13 @@ Component *Entity::createComponent(ComponentType type) {
         case OSRE::App::ComponentType::CameraComponentType:
             component = new CameraComponent(this);
             break;
-        case OSRE::App::ComponentType::AnimationComponentType:
-            component = new AnimatorComponent(this);
-            break;
+        case OSRE::App::ComponentType::AnimationComponentType: {
+            AnimatorComponent *animator = new AnimatorComponent(this);
+            if (mOwner != nullptr) {
+                mOwner->getAnimationSystem().addAnimator(animator);
+            }
+            component = animator;
+        } break;
         case OSRE::App::ComponentType::Invalid:
         case OSRE::App::ComponentType::Count:
         default:
@@ -138,4 +145,56 @@ const AABB &Entity::getAABB() const {
     return mAabb;
 }
 
+glm::vec3 Entity::getWorldCenter() const {
+    glm::mat4 world(1.0f);
+    if (mTransformNode != nullptr) {
+        world = mTransformNode->getWorlTransformMatrix();
+    }
+
+    // Entities without geometry are located at the origin of their node
+    const glm::vec3 center = mAabb.isValid() ? mAabb.getCenter() : glm::vec3(0.0f);
+
+    return glm::vec3(world * glm::vec4(center, 1.0f));
+}
+
+AABB Entity::getWorldAABB() const {
+    if (!mAabb.isValid() || mTransformNode == nullptr) {
+        return mAabb;
+    }
+
+    return mAabb.transform(mTransformNode->getWorlTransformMatrix());
+}
+
+f32 Entity::getWorldScale() const {
+    if (mTransformNode == nullptr) {
+        return 1.0f;
+    }
+
+    // The length of the basis vectors, non-uniform scales use the largest one
+    const glm::mat4 world = mTransformNode->getWorlTransformMatrix();
+    const f32 scaleX = glm::length(glm::vec3(world[0]));
+    const f32 scaleY = glm::length(glm::vec3(world[1]));
+    const f32 scaleZ = glm::length(glm::vec3(world[2]));
+
+    return std::max(scaleX, std::max(scaleY, scaleZ));
+}
+
+void Entity::setName(const String &name) {
+    const String oldName = getName();
+    if (oldName == name) {
+        return;
+    }
+
+    Object::setName(name);
+    if (mOwner != nullptr) {
+        mOwner->onEntityRenamed(this, oldName);
+    }
+}
+
+void Entity::onTransformChanged() {
+    if (mOwner != nullptr) {
+        mOwner->onEntityMoved(this);
+    }
+}
+
 } // namespace OSRE::App
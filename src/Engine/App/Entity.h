@@ -58,6 +58,11 @@ public:
 
     Entity(const String &name, Common::Ids &ids, Scene *world);
     ~Entity() override;
+
+    /// @brief Will assign a new name, the name index of the scene will be updated.
+    /// @param[in] name     The new name.
+    void setName(const String &name);
+
     void setNode(TransformComponent *node);
     TransformComponent *getNode() const;
     bool update( Time dt );
@@ -67,6 +72,21 @@ public:
     void setAABB( const Common::AABB &aabb );
     const Common::AABB &getAABB() const;
 
+    /// @brief Will return the position used for spatial queries, the center of the bounds in world space.
+    /// @return The world position.
+    glm::vec3 getWorldCenter() const;
+
+    /// @brief Will return the bounds in world space, transformed by the world matrix of the node.
+    /// @return The world bounds, invalid if the entity has no geometry.
+    Common::AABB getWorldAABB() const;
+
+    /// @brief Will return the largest scale of the world transformation of the node.
+    /// @return The world scale, 1 for entities without a node.
+    f32 getWorldScale() const;
+
+    /// @brief Will be called by the transform components, when a transformation was changed.
+    void onTransformChanged();
+
 private:
     RenderComponent *mRenderComponent;
     ComponentArray mComponentArray;
@@ -0,0 +1,325 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "App/GeometryClipmap.h"
+#include "Common/Logger.h"
+#include "RenderBackend/MaterialBuilder.h"
+#include "RenderBackend/Mesh.h"
+#include "RenderBackend/RenderBackendService.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+namespace OSRE::App {
+
+using namespace ::OSRE::Common;
+using namespace ::OSRE::RenderBackend;
+
+DECL_OSRE_LOG_MODULE(GeometryClipmap)
+
+// The grid vertices are addressed by 16 bit indices
+static constexpr ui32 MaxGridSize = 252u;
+
+static ui32 wrap(i32 value, ui32 size) {
+    const i32 rest = value % static_cast<i32>(size);
+    return static_cast<ui32>(rest < 0 ? rest + static_cast<i32>(size) : rest);
+}
+
+ClipmapDesc::ClipmapDesc() :
+        GridSize(128u),
+        NumLevels(6u),
+        SampleSpacing(1.0f) {
+    // empty
+}
+
+ClipmapWindow::ClipmapWindow() :
+        mSize(0u),
+        mOriginX(0),
+        mOriginZ(0),
+        mValid(false) {
+    // empty
+}
+
+void ClipmapWindow::init(ui32 size) {
+    mSize = size;
+    mOriginX = mOriginZ = 0;
+    mValid = false;
+}
+
+void ClipmapWindow::moveTo(i32 originX, i32 originZ, ClipmapRegionArray &regions) {
+    if (mSize == 0u) {
+        return;
+    }
+
+    const i32 size = static_cast<i32>(mSize);
+    const i32 dx = originX - mOriginX;
+    const i32 dz = originZ - mOriginZ;
+    if (!mValid || std::abs(dx) >= size || std::abs(dz) >= size) {
+        addRegion(originX, originZ, mSize, mSize, regions);
+    } else {
+        // The entering columns cover all rows, the entering rows only the remaining columns
+        if (dx > 0) {
+            addRegion(mOriginX + size, originZ, dx, mSize, regions);
+        } else if (dx < 0) {
+            addRegion(originX, originZ, -dx, mSize, regions);
+        }
+
+        const i32 keepX = std::max(originX, mOriginX);
+        const ui32 keepWidth = mSize - std::abs(dx);
+        if (dz > 0) {
+            addRegion(keepX, mOriginZ + size, keepWidth, dz, regions);
+        } else if (dz < 0) {
+            addRegion(keepX, originZ, keepWidth, -dz, regions);
+        }
+    }
+
+    mOriginX = originX;
+    mOriginZ = originZ;
+    mValid = true;
+}
+
+void ClipmapWindow::invalidate() {
+    mValid = false;
+}
+
+void ClipmapWindow::addRegion(i32 sampleX, i32 sampleZ, ui32 width, ui32 height, ClipmapRegionArray &regions) const {
+    if (width == 0u || height == 0u) {
+        return;
+    }
+
+    // A region crossing the texture border will be split
+    const ui32 texelX = wrap(sampleX, mSize);
+    const ui32 texelZ = wrap(sampleZ, mSize);
+    const ui32 widths[2] = { std::min(width, mSize - texelX), width - std::min(width, mSize - texelX) };
+    const ui32 heights[2] = { std::min(height, mSize - texelZ), height - std::min(height, mSize - texelZ) };
+    for (ui32 j = 0; j < 2; ++j) {
+        for (ui32 i = 0; i < 2; ++i) {
+            if (widths[i] == 0u || heights[j] == 0u) {
+                continue;
+            }
+
+            ClipmapRegion region;
+            region.SampleX = sampleX + static_cast<i32>(i * widths[0]);
+            region.SampleZ = sampleZ + static_cast<i32>(j * heights[0]);
+            region.TexelX = i == 0 ? texelX : 0u;
+            region.TexelZ = j == 0 ? texelZ : 0u;
+            region.Width = widths[i];
+            region.Height = heights[j];
+            regions.add(region);
+        }
+    }
+}
+
+GeometryClipmap::GeometryClipmap() :
+        mField(nullptr),
+        mDesc(),
+        mHeightMapName(),
+        mWindows(),
+        mMeshes(),
+        mRegions(),
+        mStaging(),
+        mNumUploadedSamples(0u) {
+    // empty
+}
+
+bool GeometryClipmap::init(RenderBackendService *rbSrv, const MappedHeightField *field, const ClipmapDesc &desc) {
+    if (rbSrv == nullptr) {
+        osre_error(Tag, "Render backend service is nullptr.");
+        return false;
+    }
+
+    if (field == nullptr || !field->isOpen()) {
+        osre_error(Tag, "Height field is not open.");
+        return false;
+    }
+
+    if (desc.GridSize < 4u || desc.GridSize > MaxGridSize || (desc.GridSize % 4u) != 0u ||
+            desc.NumLevels == 0u || desc.NumLevels > MaxClipmapLevels) {
+        osre_error(Tag, "Invalid clipmap description.");
+        return false;
+    }
+
+    if (!mMeshes.isEmpty()) {
+        osre_error(Tag, "Clipmap was already initialized.");
+        return false;
+    }
+
+    // Each clipmap needs its own texture
+    static ui32 sNumClipmaps = 0u;
+    mHeightMapName = "clipmap_heights_" + std::to_string(sNumClipmaps++);
+    mField = field;
+    mDesc = desc;
+    for (ui32 level = 0; level < mDesc.NumLevels; ++level) {
+        mWindows[level].init(mDesc.GridSize + 1u);
+    }
+
+    const ui32 gridSize = mDesc.GridSize;
+    const ui32 numVertices = (gridSize + 1) * (gridSize + 1);
+    std::vector<ui16> fullIndices(getNumGridIndices(gridSize, false));
+    std::vector<ui16> ringIndices(getNumGridIndices(gridSize, true));
+    buildGridIndices(gridSize, false, fullIndices.data());
+    buildGridIndices(gridSize, true, ringIndices.data());
+
+    Material *mat = MaterialBuilder::createClipmapMaterial(mHeightMapName, gridSize);
+    for (ui32 level = 0; level < mDesc.NumLevels; ++level) {
+        Mesh *mesh = new Mesh("clipmap_level_" + std::to_string(level), VertexType::RenderVertex, IndexType::UnsignedShort);
+        RenderVert *vertices = static_cast<RenderVert *>(mesh->mapVertexBuffer(sizeof(RenderVert) * numVertices, BufferAccessType::ReadOnly));
+        for (ui32 z = 0; z <= gridSize; ++z) {
+            for (ui32 x = 0; x <= gridSize; ++x) {
+                RenderVert &v = vertices[z * (gridSize + 1) + x];
+                v.position = glm::vec3(static_cast<f32>(x), static_cast<f32>(level), static_cast<f32>(z));
+                v.normal = glm::vec3(0.0f, 1.0f, 0.0f);
+                v.color0 = glm::vec3(1.0f);
+                v.tex0 = glm::vec2(0.0f);
+            }
+        }
+
+        // Only the finest level is a full grid, the rings share their indices
+        if (level == 0u) {
+            mesh->createIndexBuffer(fullIndices.data(), sizeof(ui16) * fullIndices.size(), IndexType::UnsignedShort, BufferAccessType::ReadOnly);
+            mesh->addPrimitiveGroup(fullIndices.size(), PrimitiveType::TriangleList, 0);
+        } else {
+            if (level == 1u) {
+                mesh->createIndexBuffer(ringIndices.data(), sizeof(ui16) * ringIndices.size(), IndexType::UnsignedShort, BufferAccessType::ReadOnly);
+            } else {
+                mesh->shareIndexBuffer(mMeshes[1]);
+            }
+            mesh->addPrimitiveGroup(ringIndices.size(), PrimitiveType::TriangleList, 0);
+        }
+        mesh->setMaterial(mat);
+        mMeshes.add(mesh);
+    }
+    rbSrv->addMesh(mMeshes, 0);
+
+    // The texture must exist before the meshes are set up
+    const f32 centerX = static_cast<f32>(mField->getWidth()) * 0.5f * mDesc.SampleSpacing;
+    const f32 centerZ = static_cast<f32>(mField->getHeight()) * 0.5f * mDesc.SampleSpacing;
+    update(rbSrv, glm::vec3(centerX, 0.0f, centerZ));
+
+    return true;
+}
+
+void GeometryClipmap::getLevelOrigin(const glm::vec3 &eye, ui32 level, i32 &x, i32 &z) const {
+    x = z = 0;
+    if (level >= mDesc.NumLevels || mDesc.SampleSpacing <= 0.0f) {
+        return;
+    }
+
+    // The coarsest level follows the camera, the finer ones are centered in it
+    const ui32 coarsest = mDesc.NumLevels - 1u;
+    const f32 spacing = mDesc.SampleSpacing * static_cast<f32>(1u << coarsest);
+    const i32 halfSize = static_cast<i32>(mDesc.GridSize / 2u);
+    x = static_cast<i32>(std::floor(eye.x / spacing + 0.5f)) - halfSize;
+    z = static_cast<i32>(std::floor(eye.z / spacing + 0.5f)) - halfSize;
+    for (ui32 l = coarsest; l > level; --l) {
+        x = 2 * x + halfSize;
+        z = 2 * z + halfSize;
+    }
+}
+
+void GeometryClipmap::update(RenderBackendService *rbSrv, const glm::vec3 &eye) {
+    mNumUploadedSamples = 0u;
+    if (rbSrv == nullptr || mMeshes.isEmpty()) {
+        return;
+    }
+
+    glm::vec3 windows[MaxClipmapLevels];
+    for (ui32 level = 0; level < mDesc.NumLevels; ++level) {
+        i32 x = 0, z = 0;
+        getLevelOrigin(eye, level, x, z);
+        mRegions.resize(0);
+        mWindows[level].moveTo(x, z, mRegions);
+        uploadRegions(rbSrv, level);
+        windows[level] = glm::vec3(static_cast<f32>(x), static_cast<f32>(z), mDesc.SampleSpacing * static_cast<f32>(1u << level));
+    }
+
+    // The windows move together, so nothing changed without uploads
+    if (mNumUploadedSamples > 0u) {
+        rbSrv->setFloat3Array(ClipmapLevelsName, mDesc.NumLevels, windows);
+    }
+}
+
+void GeometryClipmap::uploadRegions(RenderBackendService *rbSrv, ui32 level) {
+    const ui32 size = mDesc.GridSize + 1u;
+    const i32 step = 1 << level;
+    for (ui32 i = 0; i < mRegions.size(); ++i) {
+        const ClipmapRegion &region = mRegions[i];
+        mStaging.resize(static_cast<size_t>(region.Width) * region.Height);
+        f32 *texel = mStaging.data();
+        for (ui32 z = 0; z < region.Height; ++z) {
+            const i32 sz = (region.SampleZ + static_cast<i32>(z)) * step;
+            for (ui32 x = 0; x < region.Width; ++x) {
+                *texel++ = mField->getSample((region.SampleX + static_cast<i32>(x)) * step, sz);
+            }
+        }
+
+        TextureLayerDesc desc;
+        desc.Width = size;
+        desc.Height = size;
+        desc.NumLayers = mDesc.NumLevels;
+        desc.Layer = level;
+        desc.X = region.TexelX;
+        desc.Y = region.TexelZ;
+        desc.RegionWidth = region.Width;
+        desc.RegionHeight = region.Height;
+        rbSrv->updateTextureLayer(mHeightMapName, desc, mStaging.data());
+        mNumUploadedSamples += region.Width * region.Height;
+    }
+}
+
+ui32 GeometryClipmap::getNumGridIndices(ui32 gridSize, bool ring) {
+    const ui32 hole = ring ? gridSize / 2u : 0u;
+    return 6u * (gridSize * gridSize - hole * hole);
+}
+
+void GeometryClipmap::buildGridIndices(ui32 gridSize, bool ring, ui16 *indices) {
+    if (indices == nullptr) {
+        return;
+    }
+
+    // The hole of a ring is covered by the next finer level
+    const ui32 holeStart = gridSize / 4u;
+    const ui32 holeEnd = holeStart + gridSize / 2u;
+    const ui32 rowSize = gridSize + 1u;
+    ui16 *index = indices;
+    for (ui32 z = 0; z < gridSize; ++z) {
+        for (ui32 x = 0; x < gridSize; ++x) {
+            if (ring && x >= holeStart && x < holeEnd && z >= holeStart && z < holeEnd) {
+                continue;
+            }
+
+            const ui16 i0 = static_cast<ui16>(z * rowSize + x);
+            const ui16 i1 = static_cast<ui16>(i0 + 1);
+            const ui16 i2 = static_cast<ui16>(i0 + rowSize);
+            const ui16 i3 = static_cast<ui16>(i2 + 1);
+            *index++ = i0;
+            *index++ = i2;
+            *index++ = i1;
+            *index++ = i1;
+            *index++ = i2;
+            *index++ = i3;
+        }
+    }
+}
+
+} // namespace OSRE::App
@@ -0,0 +1,206 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "App/MappedHeightField.h"
+#include "RenderBackend/RenderCommon.h"
+
+#include <vector>
+
+namespace OSRE {
+namespace RenderBackend {
+class RenderBackendService;
+} // namespace RenderBackend
+
+namespace App {
+
+/// @brief  Describes the layout of a geometry clipmap.
+struct ClipmapDesc {
+    ui32 GridSize;      ///< The number of quads per side of a level, a multiple of four up to 252.
+    ui32 NumLevels;     ///< The number of levels, each one doubles the sample spacing.
+    f32 SampleSpacing;  ///< The distance between two samples of the finest level.
+
+    /// @brief  The default class constructor.
+    ClipmapDesc();
+};
+
+/// @brief  A rectangle of samples entering a clipmap level, with its position in the toroidal texture.
+struct ClipmapRegion {
+    i32 SampleX;    ///< The first column, in samples of the level.
+    i32 SampleZ;    ///< The first row, in samples of the level.
+    ui32 TexelX;    ///< The first texel column.
+    ui32 TexelZ;    ///< The first texel row.
+    ui32 Width;     ///< The number of columns.
+    ui32 Height;    ///< The number of rows.
+};
+
+using ClipmapRegionArray = cppcore::TArray<ClipmapRegion>;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class tracks the samples of one clipmap level, which are resident in its texture.
+///
+/// The window is stored toroidally: sample s lives in texel s mod size. Moving the window will only
+/// report the samples which entered it, the other texels stay untouched.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT ClipmapWindow {
+public:
+    /// @brief  The default class constructor.
+    ClipmapWindow();
+
+    /// @brief  The class destructor.
+    ~ClipmapWindow() = default;
+
+    /// @brief  Will set the number of samples per side, the window will be invalid afterwards.
+    /// @param[in] size     The number of samples per side.
+    void init(ui32 size);
+
+    /// @brief  Will move the window, all of it will be reported for an invalid window.
+    /// @param[in]  originX     The new first column.
+    /// @param[in]  originZ     The new first row.
+    /// @param[out] regions     The new regions will be appended.
+    void moveTo(i32 originX, i32 originZ, ClipmapRegionArray &regions);
+
+    /// @brief  Will force a complete update with the next move.
+    void invalidate();
+
+    /// @brief  Will return true, if the texture contains the window.
+    /// @return true for valid.
+    bool isValid() const;
+
+    /// @brief  Will return the first column.
+    /// @return The first column.
+    i32 getOriginX() const;
+
+    /// @brief  Will return the first row.
+    /// @return The first row.
+    i32 getOriginZ() const;
+
+private:
+    void addRegion(i32 sampleX, i32 sampleZ, ui32 width, ui32 height, ClipmapRegionArray &regions) const;
+
+private:
+    ui32 mSize;
+    i32 mOriginX;
+    i32 mOriginZ;
+    bool mValid;
+};
+
+inline bool ClipmapWindow::isValid() const {
+    return mValid;
+}
+
+inline i32 ClipmapWindow::getOriginX() const {
+    return mOriginX;
+}
+
+inline i32 ClipmapWindow::getOriginZ() const {
+    return mOriginZ;
+}
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class renders a height field as a geometry clipmap.
+///
+/// Every level is a fixed grid around the camera, the vertex shader displaces it by a float texture
+/// array with one layer per level. Each level covers the ring around the next finer one, all rings
+/// share one index buffer. When the camera moves only the samples entering the windows will be read
+/// from the height field and uploaded, so the costs per frame do not depend on the size of the field.
+/// The levels are nested centered in each other, so they follow the camera in steps of the coarsest
+/// level.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT GeometryClipmap {
+public:
+    /// @brief  The default class constructor.
+    GeometryClipmap();
+
+    /// @brief  The class destructor.
+    ~GeometryClipmap() = default;
+
+    /// @brief  Will create the level meshes and upload the windows around the center of the field, must be
+    ///         called inside of a render batch.
+    /// @param[in] rbSrv    The render backend service.
+    /// @param[in] field    The height field, must stay open while the clipmap is used.
+    /// @param[in] desc     The clipmap description.
+    /// @return true, if successful, false for invalid arguments.
+    bool init(RenderBackend::RenderBackendService *rbSrv, const MappedHeightField *field, const ClipmapDesc &desc);
+
+    /// @brief  Will move the levels to the camera and upload the entering samples, must be called inside of the
+    ///         render batch used for init.
+    /// @param[in] rbSrv    The render backend service.
+    /// @param[in] eye      The camera position in terrain space.
+    void update(RenderBackend::RenderBackendService *rbSrv, const glm::vec3 &eye);
+
+    /// @brief  Will calculate the first sample of a level window for a camera position.
+    /// @param[in]  eye     The camera position in terrain space.
+    /// @param[in]  level   The level.
+    /// @param[out] x       The first column, in samples of the level.
+    /// @param[out] z       The first row, in samples of the level.
+    void getLevelOrigin(const glm::vec3 &eye, ui32 level, i32 &x, i32 &z) const;
+
+    /// @brief  Will return the number of samples uploaded by the last update.
+    /// @return The number of samples.
+    ui32 getNumUploadedSamples() const;
+
+    /// @brief  Will return the clipmap description.
+    /// @return The description.
+    const ClipmapDesc &getDesc() const;
+
+    /// @brief  Will return the number of indices of a level grid.
+    /// @param[in] gridSize     The number of quads per side.
+    /// @param[in] ring         true for a ring around the finer level, false for a full grid.
+    /// @return The number of indices.
+    static ui32 getNumGridIndices(ui32 gridSize, bool ring);
+
+    /// @brief  Will write the triangle list of a level grid.
+    /// @param[in]  gridSize    The number of quads per side.
+    /// @param[in]  ring        true for a ring around the finer level, false for a full grid.
+    /// @param[out] indices     The indices, see getNumGridIndices.
+    static void buildGridIndices(ui32 gridSize, bool ring, ui16 *indices);
+
+private:
+    void uploadRegions(RenderBackend::RenderBackendService *rbSrv, ui32 level);
+
+private:
+    const MappedHeightField *mField;
+    ClipmapDesc mDesc;
+    String mHeightMapName;
+    ClipmapWindow mWindows[RenderBackend::MaxClipmapLevels];
+    RenderBackend::MeshArray mMeshes;
+    ClipmapRegionArray mRegions;
+    std::vector<f32> mStaging;
+    ui32 mNumUploadedSamples;
+};
+
+inline ui32 GeometryClipmap::getNumUploadedSamples() const {
+    return mNumUploadedSamples;
+}
+
+inline const ClipmapDesc &GeometryClipmap::getDesc() const {
+    return mDesc;
+}
+
+} // Namespace App
+} // Namespace OSRE
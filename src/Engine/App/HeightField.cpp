@@ -0,0 +1,95 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "App/HeightField.h"
+
+#include <algorithm>
+
+namespace OSRE::App {
+
+HeightField::HeightField() :
+        mWidth(0u),
+        mHeight(0u),
+        mSamples() {
+    // empty
+}
+
+bool HeightField::create(ui32 width, ui32 height, const f32 *heights) {
+    if (width == 0u || height == 0u || heights == nullptr) {
+        return false;
+    }
+
+    mWidth = width;
+    mHeight = height;
+    mSamples.assign(heights, heights + static_cast<size_t>(width) * height);
+
+    return true;
+}
+
+bool HeightField::createFromImage(ui32 width, ui32 height, ui32 numChannels, const uc8 *pixels, f32 scale, f32 shift) {
+    if (width == 0u || height == 0u || numChannels == 0u || pixels == nullptr) {
+        return false;
+    }
+
+    mWidth = width;
+    mHeight = height;
+    const size_t numSamples = static_cast<size_t>(width) * height;
+    mSamples.resize(numSamples);
+    for (size_t i = 0; i < numSamples; ++i) {
+        mSamples[i] = static_cast<f32>(pixels[i * numChannels]) * scale + shift;
+    }
+
+    return true;
+}
+
+void HeightField::clear() {
+    mWidth = mHeight = 0u;
+    mSamples.clear();
+}
+
+void HeightField::getRange(i32 x0, i32 z0, i32 x1, i32 z1, f32 &minH, f32 &maxH) const {
+    minH = maxH = 0.0f;
+    if (isEmpty()) {
+        return;
+    }
+
+    // Only the part inside the field matters, the clamped samples repeat the border
+    x0 = std::max(x0, 0);
+    z0 = std::max(z0, 0);
+    x1 = std::min(x1, static_cast<i32>(mWidth) - 1);
+    z1 = std::min(z1, static_cast<i32>(mHeight) - 1);
+    if (x0 > x1 || z0 > z1) {
+        minH = maxH = getSample(x0, z0);
+        return;
+    }
+
+    minH = maxH = getSample(x0, z0);
+    for (i32 z = z0; z <= z1; ++z) {
+        const f32 *row = &mSamples[static_cast<size_t>(z) * mWidth];
+        for (i32 x = x0; x <= x1; ++x) {
+            minH = std::min(minH, row[x]);
+            maxH = std::max(maxH, row[x]);
+        }
+    }
+}
+
+} // namespace OSRE::App
@@ -0,0 +1,120 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+
+#include <vector>
+
+namespace OSRE {
+namespace App {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class stores the height samples of a terrain in row-major order.
+///
+/// The samples are addressed by their column x and their row z, lookups outside of the field will
+/// be clamped to the border.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT HeightField {
+public:
+    /// @brief  The default class constructor.
+    HeightField();
+
+    /// @brief  The class destructor.
+    ~HeightField() = default;
+
+    /// @brief  Will copy the heights.
+    /// @param[in] width    The number of columns.
+    /// @param[in] height   The number of rows.
+    /// @param[in] heights  The heights, width * height values.
+    /// @return true, if successful, false for invalid arguments.
+    bool create(ui32 width, ui32 height, const f32 *heights);
+
+    /// @brief  Will convert the first channel of an 8 bit image into heights.
+    /// @param[in] width        The image width.
+    /// @param[in] height       The image height.
+    /// @param[in] numChannels  The number of channels per pixel.
+    /// @param[in] pixels       The pixels.
+    /// @param[in] scale        The height per pixel value.
+    /// @param[in] shift        The height of the pixel value zero.
+    /// @return true, if successful, false for invalid arguments.
+    bool createFromImage(ui32 width, ui32 height, ui32 numChannels, const uc8 *pixels, f32 scale, f32 shift);
+
+    /// @brief  Will release all samples.
+    void clear();
+
+    /// @brief  Will return the number of columns.
+    /// @return The number of columns.
+    ui32 getWidth() const;
+
+    /// @brief  Will return the number of rows.
+    /// @return The number of rows.
+    ui32 getHeight() const;
+
+    /// @brief  Will return the height of a sample, the coordinates will be clamped.
+    /// @param[in] x    The column.
+    /// @param[in] z    The row.
+    /// @return The height.
+    f32 getSample(i32 x, i32 z) const;
+
+    /// @brief  Will calculate the height range of a rectangle of samples, the border is included.
+    /// @param[in]  x0      The first column.
+    /// @param[in]  z0      The first row.
+    /// @param[in]  x1      The last column.
+    /// @param[in]  z1      The last row.
+    /// @param[out] minH    The minimal height.
+    /// @param[out] maxH    The maximal height.
+    void getRange(i32 x0, i32 z0, i32 x1, i32 z1, f32 &minH, f32 &maxH) const;
+
+    /// @brief  Will return true, if there are no samples.
+    /// @return true for empty.
+    bool isEmpty() const;
+
+private:
+    ui32 mWidth;
+    ui32 mHeight;
+    std::vector<f32> mSamples;
+};
+
+inline ui32 HeightField::getWidth() const {
+    return mWidth;
+}
+
+inline ui32 HeightField::getHeight() const {
+    return mHeight;
+}
+
+inline bool HeightField::isEmpty() const {
+    return mSamples.empty();
+}
+
+inline f32 HeightField::getSample(i32 x, i32 z) const {
+    x = x < 0 ? 0 : (x >= static_cast<i32>(mWidth) ? static_cast<i32>(mWidth) - 1 : x);
+    z = z < 0 ? 0 : (z >= static_cast<i32>(mHeight) ? static_cast<i32>(mHeight) - 1 : z);
+    return mSamples[static_cast<size_t>(z) * mWidth + static_cast<size_t>(x)];
+}
+
+} // Namespace App
+} // Namespace OSRE
@@ -0,0 +1,69 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "App/MappedHeightField.h"
+#include "Common/Logger.h"
+
+namespace OSRE::App {
+
+DECL_OSRE_LOG_MODULE(MappedHeightField)
+
+MappedHeightField::MappedHeightField() :
+        mFile(),
+        mWidth(0u),
+        mHeight(0u),
+        mScale(1.0f),
+        mShift(0.0f) {
+    // empty
+}
+
+bool MappedHeightField::open(const String &filename, ui32 width, ui32 height, f32 scale, f32 shift) {
+    if (width == 0u || height == 0u) {
+        osre_error(Tag, "Invalid height field size.");
+        return false;
+    }
+
+    close();
+    if (!mFile.open(filename)) {
+        return false;
+    }
+
+    if (mFile.getSize() != static_cast<size_t>(width) * height * sizeof(ui16)) {
+        osre_error(Tag, "Size of " + filename + " does not match the height field size.");
+        mFile.close();
+        return false;
+    }
+
+    mWidth = width;
+    mHeight = height;
+    mScale = scale;
+    mShift = shift;
+
+    return true;
+}
+
+void MappedHeightField::close() {
+    mFile.close();
+    mWidth = mHeight = 0u;
+}
+
+} // namespace OSRE::App
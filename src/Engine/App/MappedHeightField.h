@@ -0,0 +1,112 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "IO/MemoryMappedFile.h"
+
+#include <cstring>
+
+namespace OSRE {
+namespace App {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class gives access to a large height field stored as a raw file of 16 bit samples.
+///
+/// The file is memory-mapped, only the pages which are really read will be loaded. The samples are
+/// stored little-endian in row-major order without any header, like most terrain tools export them.
+/// Lookups outside of the field will be clamped to the border, a closed field returns zero heights.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT MappedHeightField {
+public:
+    /// @brief  The default class constructor.
+    MappedHeightField();
+
+    /// @brief  The class destructor.
+    ~MappedHeightField() = default;
+
+    /// @brief  Will map the file.
+    /// @param[in] filename     The name of the raw file.
+    /// @param[in] width        The number of columns.
+    /// @param[in] height       The number of rows.
+    /// @param[in] scale        The height per sample value.
+    /// @param[in] shift        The height of the sample value zero.
+    /// @return true, if successful, false if the file cannot be mapped or does not match the size.
+    bool open(const String &filename, ui32 width, ui32 height, f32 scale, f32 shift);
+
+    /// @brief  Will release the mapping.
+    void close();
+
+    /// @brief  Will return true, if a file is mapped.
+    /// @return true for mapped.
+    bool isOpen() const;
+
+    /// @brief  Will return the number of columns.
+    /// @return The number of columns.
+    ui32 getWidth() const;
+
+    /// @brief  Will return the number of rows.
+    /// @return The number of rows.
+    ui32 getHeight() const;
+
+    /// @brief  Will return the height of a sample, the coordinates will be clamped.
+    /// @param[in] x    The column.
+    /// @param[in] z    The row.
+    /// @return The height, 0 if no file is mapped.
+    f32 getSample(i32 x, i32 z) const;
+
+private:
+    IO::MemoryMappedFile mFile;
+    ui32 mWidth;
+    ui32 mHeight;
+    f32 mScale;
+    f32 mShift;
+};
+
+inline bool MappedHeightField::isOpen() const {
+    return mFile.isOpen();
+}
+
+inline ui32 MappedHeightField::getWidth() const {
+    return mWidth;
+}
+
+inline ui32 MappedHeightField::getHeight() const {
+    return mHeight;
+}
+
+inline f32 MappedHeightField::getSample(i32 x, i32 z) const {
+    if (!isOpen()) {
+        return 0.0f;
+    }
+
+    x = x < 0 ? 0 : (x >= static_cast<i32>(mWidth) ? static_cast<i32>(mWidth) - 1 : x);
+    z = z < 0 ? 0 : (z >= static_cast<i32>(mHeight) ? static_cast<i32>(mHeight) - 1 : z);
+    ui16 value = 0;
+    ::memcpy(&value, mFile.getData() + (static_cast<size_t>(z) * mWidth + static_cast<size_t>(x)) * sizeof(ui16), sizeof(ui16));
+    return static_cast<f32>(value) * mScale + mShift;
+}
+
+} // Namespace App
+} // Namespace OSRE
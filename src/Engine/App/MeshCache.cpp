@@ -0,0 +1,615 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "App/MeshCache.h"
+#include "App/SharedAssetCache.h"
+#include "Common/Logger.h"
+#include "IO/File.h"
+#include "IO/Uri.h"
+#include "RenderBackend/MaterialBuilder.h"
+
+#include <cstdio>
+#include <type_traits>
+
+namespace OSRE::App {
+
+using namespace ::OSRE::Common;
+using namespace ::OSRE::RenderBackend;
+
+DECL_OSRE_LOG_MODULE(MeshCache)
+
+static constexpr c8 Magic[4] = { 'O', 'S', 'M', 'C' };
+
+// All sections and buffers start at this alignment
+static constexpr size_t SectionAlignment = 16;
+
+static_assert(std::is_trivially_copyable<MeshCacheHeader>::value, "The header must be a plain struct.");
+static_assert(std::is_trivially_copyable<CachedMesh>::value, "The records must be plain structs.");
+static_assert(std::is_trivially_copyable<MeshLod>::value, "The records must be plain structs.");
+
+static size_t align(size_t value) {
+    return (value + SectionAlignment - 1) & ~(SectionAlignment - 1);
+}
+
+static void copyMatrix(const glm::mat4 &m, f32 *dst) {
+    ::memcpy(dst, &m[0][0], sizeof(f32) * 16);
+}
+
+static glm::mat4 toMatrix(const f32 *src) {
+    glm::mat4 m(1.0f);
+    ::memcpy(&m[0][0], src, sizeof(f32) * 16);
+    return m;
+}
+
+// Checks the range without overflows
+static bool isRange(ui64 first, ui64 count, ui64 total) {
+    return first <= total && count <= total - first;
+}
+
+Material *MaterialDesc::create(SharedAssetCache *cache) const {
+    // Textures of the cache are loaded once, even when several materials are using them
+    TextureResourceArray texResArray;
+    for (size_t i = 0; i < Textures.size(); ++i) {
+        TextureResource *texRes = nullptr;
+        if (nullptr != cache) {
+            texRes = cache->getTextureResource(Textures[i].Name);
+        } else {
+            texRes = new TextureResource(Textures[i].Name, IO::Uri(Textures[i].Name));
+        }
+        texRes->setTextureStage(Textures[i].Stage);
+        texResArray.add(texRes);
+    }
+
+    Material *material = MaterialBuilder::createTexturedMaterial(Name, texResArray, Type);
+    if (nullptr == material) {
+        return nullptr;
+    }
+
+    for (ui32 i = 0; i < MaxMatColorType; ++i) {
+        if (0 != (ColorMask & (1u << i))) {
+            material->setColor(static_cast<MaterialColorType>(i), Colors[i]);
+        }
+    }
+    for (ui32 i = 0; i < static_cast<ui32>(MaterialParameterType::Count); ++i) {
+        if (0 != (ParameterMask & (1u << i))) {
+            material->setFloatParameter(static_cast<MaterialParameterType>(i), Parameters[i]);
+        }
+    }
+
+    return material;
+}
+
+ui64 MeshCache::computeKey(const String &sourceFile, ui32 importFlags) {
+    IO::MemoryMappedFile file;
+    if (!file.open(sourceFile)) {
+        return 0;
+    }
+
+    return computeKey(file.getData(), file.getSize(), importFlags);
+}
+
+ui64 MeshCache::computeKey(const void *data, size_t size, ui32 importFlags) {
+    constexpr ui64 Prime = 1099511628211ull;
+    ui64 hash = hashData(data, size);
+    hash = (hash ^ importFlags) * Prime;
+    hash = (hash ^ Version) * Prime;
+
+    return 0 == hash ? 1 : hash;
+}
+
+ui64 MeshCache::hashData(const void *data, size_t size, ui64 hash) {
+    // FNV-1a over 64-bit words, the tail will be hashed byte-wise
+    constexpr ui64 Prime = 1099511628211ull;
+    const uc8 *bytes = static_cast<const uc8 *>(data);
+    size_t i = 0;
+    for (; i + sizeof(ui64) <= size; i += sizeof(ui64)) {
+        ui64 word = 0;
+        ::memcpy(&word, bytes + i, sizeof(ui64));
+        hash = (hash ^ word) * Prime;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * Prime;
+    }
+
+    return (hash ^ static_cast<ui64>(size)) * Prime;
+}
+
+String MeshCache::getCacheFilename(const String &sourceFile) {
+    return sourceFile + ".osrecache";
+}
+
+MeshCacheWriter::MeshCacheWriter() :
+        mHeader() {
+    ::memset(&mHeader, 0, sizeof(MeshCacheHeader));
+}
+
+CachedString MeshCacheWriter::addString(const String &str) {
+    CachedString cs;
+    cs.Offset = static_cast<ui32>(mStrings.size());
+    cs.Length = static_cast<ui32>(str.size());
+    for (c8 c : str) {
+        mStrings.add(c);
+    }
+
+    return cs;
+}
+
+ui64 MeshCacheWriter::addData(const void *data, size_t size) {
+    const size_t offset = align(mData.size());
+    mData.resize(offset + size);
+    if (size > 0) {
+        ::memcpy(&mData[offset], data, size);
+    }
+
+    return offset;
+}
+
+ui64 MeshCacheWriter::addBuffer(BufferData *buffer) {
+    auto it = mBufferOffsets.find(buffer);
+    if (mBufferOffsets.end() != it) {
+        return it->second;
+    }
+
+    const ui64 offset = addData(buffer->getData(), buffer->getSize());
+    mBufferOffsets[buffer] = offset;
+
+    return offset;
+}
+
+void MeshCacheWriter::addMaterial(const MaterialDesc &desc) {
+    CachedMaterial mat;
+    ::memset(&mat, 0, sizeof(CachedMaterial));
+    mat.Name = addString(desc.Name);
+    mat.FirstTexture = static_cast<ui32>(mTextures.size());
+    mat.NumTextures = static_cast<ui32>(desc.Textures.size());
+    for (size_t i = 0; i < desc.Textures.size(); ++i) {
+        CachedTexture tex;
+        tex.Name = addString(desc.Textures[i].Name);
+        tex.Stage = static_cast<i32>(desc.Textures[i].Stage);
+        tex.Padding = 0;
+        mTextures.add(tex);
+    }
+
+    mat.ColorMask = desc.ColorMask;
+    for (ui32 i = 0; i < MaxMatColorType; ++i) {
+        const Color4 &col = desc.Colors[i];
+        mat.Colors[i][0] = col.m_r;
+        mat.Colors[i][1] = col.m_g;
+        mat.Colors[i][2] = col.m_b;
+        mat.Colors[i][3] = col.m_a;
+    }
+    mat.ParameterMask = desc.ParameterMask;
+    ::memcpy(mat.Parameters, desc.Parameters, sizeof(mat.Parameters));
+    mMaterials.add(mat);
+}
+
+void MeshCacheWriter::addEmbeddedTexture(const String &name, const uc8 *data, size_t size, ui32 width, ui32 height) {
+    CachedEmbeddedTexture tex;
+    ::memset(&tex, 0, sizeof(CachedEmbeddedTexture));
+    tex.Name = addString(name);
+    tex.Width = width;
+    tex.Height = height;
+    tex.DataOffset = addData(data, size);
+    tex.DataSize = size;
+    mEmbeddedTextures.add(tex);
+}
+
+void MeshCacheWriter::addDependency(const String &filename) {
+    for (size_t i = 0; i < mDependencies.size(); ++i) {
+        const CachedString &name = mDependencies[i].Name;
+        if (name.Length == filename.size() && 0 == ::memcmp(&mStrings[name.Offset], filename.c_str(), name.Length)) {
+            return;
+        }
+    }
+
+    CachedDependency dep;
+    ::memset(&dep, 0, sizeof(CachedDependency));
+    dep.Name = addString(filename);
+    IO::File::getStamp(filename, dep.Size, dep.Modified);
+    mDependencies.add(dep);
+}
+
+bool MeshCacheWriter::addMesh(Mesh *mesh, i32 materialIndex) {
+    if (nullptr == mesh || nullptr == mesh->getVertexBuffer() || nullptr == mesh->getIndexBuffer()) {
+        return false;
+    }
+
+    CachedMesh cm;
+    ::memset(&cm, 0, sizeof(CachedMesh));
+    cm.Name = addString(mesh->getName());
+    cm.VertexType = static_cast<ui32>(mesh->getVertexType());
+    cm.IndexType = static_cast<ui32>(mesh->getIndexType());
+    cm.MaterialIndex = materialIndex;
+    cm.IsLocal = mesh->isLocal() ? 1 : 0;
+    copyMatrix(mesh->getLocalMatrix(), cm.Model);
+
+    BufferData *vb = mesh->getVertexBuffer();
+    cm.VertexSize = vb->getSize();
+    cm.VertexOffset = addBuffer(vb);
+    BufferData *ib = mesh->getIndexBuffer();
+    cm.IndexSize = ib->getSize();
+    cm.IndexOffset = addBuffer(ib);
+
+    cm.FirstGroup = static_cast<ui32>(mPrimitiveGroups.size());
+    cm.NumGroups = static_cast<ui32>(mesh->getNumberOfPrimitiveGroups());
+    for (size_t i = 0; i < mesh->getNumberOfPrimitiveGroups(); ++i) {
+        const PrimitiveGroup *group = mesh->getPrimitiveGroupAt(i);
+        CachedPrimitiveGroup cg;
+        cg.Primitive = static_cast<ui32>(group->m_primitive);
+        cg.Padding = 0;
+        cg.StartIndex = group->m_startIndex;
+        cg.NumIndices = group->m_numIndices;
+        mPrimitiveGroups.add(cg);
+    }
+
+    cm.FirstLod = static_cast<ui32>(mLods.size());
+    cm.NumLods = static_cast<ui32>(mesh->getNumLods());
+    for (size_t i = 0; i < mesh->getNumLods(); ++i) {
+        mLods.add(mesh->getLodAt(i));
+    }
+    mMeshes.add(cm);
+
+    return true;
+}
+
+void MeshCacheWriter::addNode(const String &name, i32 parent, const glm::mat4 &transform, const cppcore::TArray<ui32> &meshRefs) {
+    CachedNode node;
+    ::memset(&node, 0, sizeof(CachedNode));
+    node.Name = addString(name);
+    node.Parent = parent;
+    node.FirstMeshRef = static_cast<ui32>(mMeshRefs.size());
+    node.NumMeshRefs = static_cast<ui32>(meshRefs.size());
+    for (size_t i = 0; i < meshRefs.size(); ++i) {
+        mMeshRefs.add(meshRefs[i]);
+    }
+    copyMatrix(transform, node.Transform);
+    mNodes.add(node);
+}
+
+void MeshCacheWriter::setModelInfo(const AABB &aabb, ui32 numVertices, ui32 numTriangles) {
+    for (glm::length_t i = 0; i < 3; ++i) {
+        mHeader.BoundsMin[i] = aabb.getMin()[i];
+        mHeader.BoundsMax[i] = aabb.getMax()[i];
+    }
+    mHeader.NumVertices = numVertices;
+    mHeader.NumTriangles = numTriangles;
+}
+
+template <class T>
+static void layoutSection(const cppcore::TArray<T> &records, MeshCacheSection &section, size_t &offset) {
+    section.Offset = offset;
+    section.Count = records.size();
+    offset = align(offset + records.size() * sizeof(T));
+}
+
+template <class T>
+static bool writeSection(FILE *file, const cppcore::TArray<T> &records, const MeshCacheSection &section) {
+    static const uc8 Zeros[SectionAlignment] = {};
+    const long pos = ::ftell(file);
+    if (pos < 0 || static_cast<ui64>(pos) > section.Offset) {
+        return false;
+    }
+    const size_t padding = static_cast<size_t>(section.Offset - static_cast<ui64>(pos));
+    if (padding > 0 && ::fwrite(Zeros, 1, padding, file) != padding) {
+        return false;
+    }
+    if (records.isEmpty()) {
+        return true;
+    }
+
+    return ::fwrite(&records[0], sizeof(T), records.size(), file) == records.size();
+}
+
+bool MeshCacheWriter::write(const String &filename, ui64 key) const {
+    MeshCacheHeader header = mHeader;
+    ::memcpy(header.Magic, Magic, sizeof(Magic));
+    header.Version = MeshCache::Version;
+    header.Key = key;
+
+    size_t offset = align(sizeof(MeshCacheHeader));
+    layoutSection(mMaterials, header.Materials, offset);
+    layoutSection(mTextures, header.Textures, offset);
+    layoutSection(mEmbeddedTextures, header.EmbeddedTextures, offset);
+    layoutSection(mDependencies, header.Dependencies, offset);
+    layoutSection(mMeshes, header.Meshes, offset);
+    layoutSection(mPrimitiveGroups, header.PrimitiveGroups, offset);
+    layoutSection(mLods, header.Lods, offset);
+    layoutSection(mNodes, header.Nodes, offset);
+    layoutSection(mMeshRefs, header.MeshRefs, offset);
+    layoutSection(mStrings, header.Strings, offset);
+    layoutSection(mData, header.Data, offset);
+
+    FILE *file = ::fopen(filename.c_str(), "wb");
+    if (nullptr == file) {
+        osre_warn(Tag, "Cannot write mesh cache " + filename);
+        return false;
+    }
+
+    bool ok = ::fwrite(&header, sizeof(MeshCacheHeader), 1, file) == 1;
+    ok = ok && writeSection(file, mMaterials, header.Materials);
+    ok = ok && writeSection(file, mTextures, header.Textures);
+    ok = ok && writeSection(file, mEmbeddedTextures, header.EmbeddedTextures);
+    ok = ok && writeSection(file, mDependencies, header.Dependencies);
+    ok = ok && writeSection(file, mMeshes, header.Meshes);
+    ok = ok && writeSection(file, mPrimitiveGroups, header.PrimitiveGroups);
+    ok = ok && writeSection(file, mLods, header.Lods);
+    ok = ok && writeSection(file, mNodes, header.Nodes);
+    ok = ok && writeSection(file, mMeshRefs, header.MeshRefs);
+    ok = ok && writeSection(file, mStrings, header.Strings);
+    ok = ok && writeSection(file, mData, header.Data);
+    ::fclose(file);
+
+    if (!ok) {
+        osre_warn(Tag, "Error while writing mesh cache " + filename);
+        ::remove(filename.c_str());
+    }
+
+    return ok;
+}
+
+MeshCacheReader::MeshCacheReader() :
+        mFile(),
+        mHeader(nullptr) {
+    // empty
+}
+
+bool MeshCacheReader::open(const String &filename, ui64 key) {
+    close();
+    if (!mFile.open(filename)) {
+        return false;
+    }
+
+    if (mFile.getSize() < sizeof(MeshCacheHeader)) {
+        mFile.close();
+        return false;
+    }
+
+    mHeader = reinterpret_cast<const MeshCacheHeader *>(mFile.getData());
+    if (0 != ::memcmp(mHeader->Magic, Magic, sizeof(Magic)) || MeshCache::Version != mHeader->Version || key != mHeader->Key) {
+        osre_debug(Tag, "Mesh cache " + filename + " is outdated.");
+        close();
+        return false;
+    }
+
+    if (!validate()) {
+        osre_warn(Tag, "Mesh cache " + filename + " is corrupt.");
+        close();
+        return false;
+    }
+
+    if (!isUpToDate()) {
+        osre_debug(Tag, "A dependency of mesh cache " + filename + " was changed.");
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void MeshCacheReader::close() {
+    mHeader = nullptr;
+    mFile.close();
+}
+
+template <class T>
+const T *MeshCacheReader::getSection(const MeshCacheSection &section) const {
+    return reinterpret_cast<const T *>(mFile.getData() + section.Offset);
+}
+
+bool MeshCacheReader::validate() const {
+    const ui64 fileSize = mFile.getSize();
+    const MeshCacheSection *sections[] = { &mHeader->Materials, &mHeader->Textures, &mHeader->EmbeddedTextures, &mHeader->Dependencies,
+        &mHeader->Meshes, &mHeader->PrimitiveGroups, &mHeader->Lods, &mHeader->Nodes, &mHeader->MeshRefs, &mHeader->Strings, &mHeader->Data };
+    const size_t recordSizes[] = { sizeof(CachedMaterial), sizeof(CachedTexture), sizeof(CachedEmbeddedTexture), sizeof(CachedDependency),
+        sizeof(CachedMesh), sizeof(CachedPrimitiveGroup), sizeof(MeshLod), sizeof(CachedNode), sizeof(ui32), sizeof(c8), sizeof(uc8) };
+    for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); ++i) {
+        const MeshCacheSection &section = *sections[i];
+        if (0 != section.Offset % SectionAlignment || section.Count > fileSize / recordSizes[i] ||
+                !isRange(section.Offset, section.Count * recordSizes[i], fileSize)) {
+            return false;
+        }
+    }
+
+    const ui64 numStrings = mHeader->Strings.Count;
+    auto isString = [numStrings](const CachedString &str) {
+        return isRange(str.Offset, str.Length, numStrings);
+    };
+
+    const CachedMaterial *materials = getSection<CachedMaterial>(mHeader->Materials);
+    for (ui64 i = 0; i < mHeader->Materials.Count; ++i) {
+        if (!isString(materials[i].Name) || !isRange(materials[i].FirstTexture, materials[i].NumTextures, mHeader->Textures.Count)) {
+            return false;
+        }
+    }
+
+    const CachedTexture *textures = getSection<CachedTexture>(mHeader->Textures);
+    for (ui64 i = 0; i < mHeader->Textures.Count; ++i) {
+        if (!isString(textures[i].Name)) {
+            return false;
+        }
+    }
+
+    // Uncompressed pixels are stored as RGBA
+    const CachedEmbeddedTexture *embedded = getSection<CachedEmbeddedTexture>(mHeader->EmbeddedTextures);
+    for (ui64 i = 0; i < mHeader->EmbeddedTextures.Count; ++i) {
+        const CachedEmbeddedTexture &tex = embedded[i];
+        if (!isString(tex.Name) || !isRange(tex.DataOffset, tex.DataSize, mHeader->Data.Count) ||
+                (0 != tex.Width && tex.DataSize != static_cast<ui64>(tex.Width) * tex.Height * 4)) {
+            return false;
+        }
+    }
+
+    const CachedDependency *dependencies = getSection<CachedDependency>(mHeader->Dependencies);
+    for (ui64 i = 0; i < mHeader->Dependencies.Count; ++i) {
+        if (!isString(dependencies[i].Name)) {
+            return false;
+        }
+    }
+
+    const CachedMesh *meshes = getSection<CachedMesh>(mHeader->Meshes);
+    for (ui64 i = 0; i < mHeader->Meshes.Count; ++i) {
+        const CachedMesh &mesh = meshes[i];
+        if (!isString(mesh.Name) || mesh.MaterialIndex < -1 || mesh.MaterialIndex >= static_cast<i64>(mHeader->Materials.Count) ||
+                !isRange(mesh.VertexOffset, mesh.VertexSize, mHeader->Data.Count) ||
+                !isRange(mesh.IndexOffset, mesh.IndexSize, mHeader->Data.Count) ||
+                !isRange(mesh.FirstGroup, mesh.NumGroups, mHeader->PrimitiveGroups.Count) ||
+                !isRange(mesh.FirstLod, mesh.NumLods, mHeader->Lods.Count)) {
+            return false;
+        }
+    }
+
+    // The parents are stored before their children
+    const CachedNode *nodes = getSection<CachedNode>(mHeader->Nodes);
+    const ui32 *meshRefs = getSection<ui32>(mHeader->MeshRefs);
+    for (ui64 i = 0; i < mHeader->Nodes.Count; ++i) {
+        const CachedNode &node = nodes[i];
+        if (!isString(node.Name) || node.Parent < -1 || node.Parent >= static_cast<i64>(i) ||
+                !isRange(node.FirstMeshRef, node.NumMeshRefs, mHeader->MeshRefs.Count)) {
+            return false;
+        }
+        for (ui32 j = 0; j < node.NumMeshRefs; ++j) {
+            if (meshRefs[node.FirstMeshRef + j] >= mHeader->Meshes.Count) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool MeshCacheReader::isUpToDate() const {
+    const CachedDependency *dependencies = getSection<CachedDependency>(mHeader->Dependencies);
+    for (ui64 i = 0; i < mHeader->Dependencies.Count; ++i) {
+        const CachedDependency &dep = dependencies[i];
+        ui64 size = 0;
+        i64 modified = 0;
+        IO::File::getStamp(getString(dep.Name), size, modified);
+        if (size != dep.Size || modified != dep.Modified) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+AABB MeshCacheReader::getBounds() const {
+    if (nullptr == mHeader) {
+        return AABB();
+    }
+
+    return AABB(glm::vec3(mHeader->BoundsMin[0], mHeader->BoundsMin[1], mHeader->BoundsMin[2]),
+            glm::vec3(mHeader->BoundsMax[0], mHeader->BoundsMax[1], mHeader->BoundsMax[2]));
+}
+
+void MeshCacheReader::getMaterial(size_t index, MaterialDesc &desc) const {
+    if (index >= getNumMaterials()) {
+        return;
+    }
+
+    const CachedMaterial &mat = getSection<CachedMaterial>(mHeader->Materials)[index];
+    desc.Name = getString(mat.Name);
+    desc.Textures.resize(0);
+    const CachedTexture *textures = getSection<CachedTexture>(mHeader->Textures);
+    for (ui32 i = 0; i < mat.NumTextures; ++i) {
+        const CachedTexture &tex = textures[mat.FirstTexture + i];
+        MaterialTextureDesc texDesc;
+        texDesc.Name = getString(tex.Name);
+        texDesc.Stage = static_cast<TextureStageType>(tex.Stage);
+        desc.Textures.add(texDesc);
+    }
+
+    desc.ColorMask = mat.ColorMask;
+    for (ui32 i = 0; i < MaxMatColorType; ++i) {
+        desc.Colors[i] = Color4(mat.Colors[i][0], mat.Colors[i][1], mat.Colors[i][2], mat.Colors[i][3]);
+    }
+    desc.ParameterMask = mat.ParameterMask;
+    ::memcpy(desc.Parameters, mat.Parameters, sizeof(desc.Parameters));
+}
+
+const CachedEmbeddedTexture &MeshCacheReader::getEmbeddedTexture(size_t index) const {
+    osre_assert(index < getNumEmbeddedTextures());
+
+    return getSection<CachedEmbeddedTexture>(mHeader->EmbeddedTextures)[index];
+}
+
+const uc8 *MeshCacheReader::getEmbeddedTextureData(const CachedEmbeddedTexture &tex) const {
+    return getSection<uc8>(mHeader->Data) + tex.DataOffset;
+}
+
+Mesh *MeshCacheReader::createMesh(size_t index, i32 &materialIndex) const {
+    materialIndex = -1;
+    if (index >= getNumMeshes()) {
+        return nullptr;
+    }
+
+    const CachedMesh &cm = getSection<CachedMesh>(mHeader->Meshes)[index];
+    const IndexType indexType = static_cast<IndexType>(cm.IndexType);
+    Mesh *mesh = new Mesh(getString(cm.Name), static_cast<VertexType>(cm.VertexType), indexType);
+
+    // The buffers are uploaded as they are, the memory is read from the mapping
+    uc8 *data = const_cast<uc8 *>(getSection<uc8>(mHeader->Data));
+    mesh->createVertexBuffer(data + cm.VertexOffset, static_cast<size_t>(cm.VertexSize), BufferAccessType::ReadOnly);
+    mesh->createIndexBuffer(data + cm.IndexOffset, static_cast<size_t>(cm.IndexSize), indexType, BufferAccessType::ReadOnly);
+
+    const CachedPrimitiveGroup *groups = getSection<CachedPrimitiveGroup>(mHeader->PrimitiveGroups);
+    for (ui32 i = 0; i < cm.NumGroups; ++i) {
+        const CachedPrimitiveGroup &group = groups[cm.FirstGroup + i];
+        mesh->addPrimitiveGroup(static_cast<size_t>(group.NumIndices), static_cast<PrimitiveType>(group.Primitive),
+                static_cast<ui32>(group.StartIndex));
+    }
+
+    if (cm.NumLods > 0) {
+        const MeshLod *lods = getSection<MeshLod>(mHeader->Lods);
+        MeshLodArray lodArray;
+        lodArray.add(lods + cm.FirstLod, cm.NumLods);
+        mesh->setLods(lodArray);
+    }
+
+    if (0 != cm.IsLocal) {
+        mesh->setModelMatrix(true, toMatrix(cm.Model));
+    }
+    materialIndex = cm.MaterialIndex;
+
+    return mesh;
+}
+
+const CachedNode &MeshCacheReader::getNode(size_t index) const {
+    osre_assert(index < getNumNodes());
+
+    return getSection<CachedNode>(mHeader->Nodes)[index];
+}
+
+const ui32 *MeshCacheReader::getMeshRefs(const CachedNode &node) const {
+    return getSection<ui32>(mHeader->MeshRefs) + node.FirstMeshRef;
+}
+
+String MeshCacheReader::getString(const CachedString &str) const {
+    if (nullptr == mHeader || 0 == str.Length) {
+        return String();
+    }
+
+    const c8 *strings = getSection<c8>(mHeader->Strings);
+
+    return String(strings + str.Offset, str.Length);
+}
+
+} // namespace OSRE::App
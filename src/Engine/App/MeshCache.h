@@ -0,0 +1,411 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+#include "Common/TAABB.h"
+#include "IO/MemoryMappedFile.h"
+#include "RenderBackend/Material.h"
+#include "RenderBackend/Mesh.h"
+#include "RenderBackend/RenderCommon.h"
+
+#include <cppcore/Container/TArray.h>
+#include <map>
+
+namespace OSRE {
+namespace App {
+
+class SharedAssetCache;
+
+/// @brief A texture reference of an imported material.
+struct MaterialTextureDesc {
+    String Name;                                ///< The texture name, used as the uri.
+    RenderBackend::TextureStageType Stage;      ///< The texture stage.
+};
+
+/// @brief Describes an imported material, the material can be created again from it.
+struct MaterialDesc {
+    String Name;                                                ///< The material name.
+    cppcore::TArray<MaterialTextureDesc> Textures;              ///< The textures.
+    ui32 ColorMask = 0;                                         ///< One bit per defined color.
+    Color4 Colors[RenderBackend::MaxMatColorType];              ///< The colors, see MaterialColorType.
+    ui32 ParameterMask = 0;                                     ///< One bit per defined parameter.
+    f32 Parameters[static_cast<size_t>(RenderBackend::MaterialParameterType::Count)] = {}; ///< The parameters.
+    RenderBackend::VertexType Type = RenderBackend::VertexType::RenderVertex; ///< The vertex type of the shader.
+
+    /// @brief Will create the material.
+    /// @param[in] cache    The cache for the texture resources, nullptr to create new ones.
+    /// @return The new material or nullptr in case of an error.
+    RenderBackend::Material *create(SharedAssetCache *cache = nullptr) const;
+};
+
+/// @brief A string in the string section of a mesh cache.
+struct CachedString {
+    ui32 Offset;
+    ui32 Length;
+};
+
+/// @brief A section of a mesh cache file.
+struct MeshCacheSection {
+    ui64 Offset;    ///< The offset from the file start in bytes.
+    ui64 Count;     ///< The number of records or bytes.
+};
+
+/// @brief The header of a mesh cache file, all sections are stored behind it.
+struct MeshCacheHeader {
+    c8 Magic[4];
+    ui32 Version;
+    ui64 Key;
+    MeshCacheSection Materials;
+    MeshCacheSection Textures;
+    MeshCacheSection EmbeddedTextures;
+    MeshCacheSection Dependencies;
+    MeshCacheSection Meshes;
+    MeshCacheSection PrimitiveGroups;
+    MeshCacheSection Lods;
+    MeshCacheSection Nodes;
+    MeshCacheSection MeshRefs;
+    MeshCacheSection Strings;
+    MeshCacheSection Data;
+    f32 BoundsMin[3];
+    f32 BoundsMax[3];
+    ui32 NumVertices;
+    ui32 NumTriangles;
+};
+
+/// @brief A cached material.
+struct CachedMaterial {
+    CachedString Name;
+    ui32 FirstTexture;
+    ui32 NumTextures;
+    ui32 ColorMask;
+    ui32 ParameterMask;
+    f32 Colors[RenderBackend::MaxMatColorType][4];
+    f32 Parameters[static_cast<size_t>(RenderBackend::MaterialParameterType::Count)];
+};
+
+/// @brief A cached texture reference.
+struct CachedTexture {
+    CachedString Name;
+    i32 Stage;
+    ui32 Padding;
+};
+
+/// @brief A cached texture embedded in the model file, the offset is relative to the data section.
+struct CachedEmbeddedTexture {
+    CachedString Name;
+    ui32 Width;         ///< The width of uncompressed RGBA pixels, 0 for an encoded image.
+    ui32 Height;        ///< The height of uncompressed RGBA pixels, 0 for an encoded image.
+    ui64 DataOffset;
+    ui64 DataSize;
+};
+
+/// @brief A file the import has read beside the source, like a material library or a texture.
+struct CachedDependency {
+    CachedString Name;
+    ui64 Size;          ///< The size in bytes, 0 if the file was missing.
+    i64 Modified;       ///< The time of the last modification, 0 if the file was missing.
+};
+
+/// @brief A cached mesh, the buffer offsets are relative to the data section.
+struct CachedMesh {
+    CachedString Name;
+    ui32 VertexType;
+    ui32 IndexType;
+    i32 MaterialIndex;
+    ui32 IsLocal;
+    ui64 VertexOffset;
+    ui64 VertexSize;
+    ui64 IndexOffset;
+    ui64 IndexSize;
+    ui32 FirstGroup;
+    ui32 NumGroups;
+    ui32 FirstLod;
+    ui32 NumLods;
+    f32 Model[16];
+};
+
+/// @brief A cached primitive group.
+struct CachedPrimitiveGroup {
+    ui32 Primitive;
+    ui32 Padding;
+    ui64 StartIndex;
+    ui64 NumIndices;
+};
+
+/// @brief A cached node of the hierarchy, the parent is stored before its children.
+struct CachedNode {
+    CachedString Name;
+    i32 Parent;
+    ui32 FirstMeshRef;
+    ui32 NumMeshRefs;
+    f32 Transform[16];
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class contains the common helpers for the engine-native mesh cache.
+///
+/// A cache file stores an imported model with ready-to-upload vertex- and index-buffers, the
+/// primitive groups, the materials and the node hierarchy. All records have a fixed layout, so the
+/// file can be used directly from a memory mapping.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT MeshCache {
+public:
+    /// The version of the file layout, older caches will be ignored.
+    static constexpr ui32 Version = 3;
+
+    /// @brief Will compute the key of a source file, the content and the import flags are hashed.
+    /// Companion files like material libraries and textures are stored as dependencies of the cache.
+    /// @param[in] sourceFile   The source file.
+    /// @param[in] importFlags  The import flags.
+    /// @return The key, 0 if the file cannot be read.
+    static ui64 computeKey(const String &sourceFile, ui32 importFlags);
+
+    /// @brief Will compute the key of a source, which was read into memory like an entry of a bundle.
+    /// @param[in] data         The content of the source.
+    /// @param[in] size         The size in bytes.
+    /// @param[in] importFlags  The import flags.
+    /// @return The key, it is the same as for a source file with this content.
+    static ui64 computeKey(const void *data, size_t size, ui32 importFlags);
+
+    /// The start value of a hash.
+    static constexpr ui64 HashSeed = 14695981039346656037ull;
+
+    /// @brief Will hash a memory block, the hash of the previous block can be passed to chain several blocks.
+    /// @param[in] data     The data.
+    /// @param[in] size     The size in bytes.
+    /// @param[in] hash     The hash to continue.
+    /// @return The hash.
+    static ui64 hashData(const void *data, size_t size, ui64 hash = HashSeed);
+
+    /// @brief Will return the name of the cache file for a source file.
+    /// @param[in] sourceFile   The source file.
+    /// @return The cache file name.
+    static String getCacheFilename(const String &sourceFile);
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class collects an imported model and writes it as a mesh cache.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT MeshCacheWriter {
+public:
+    /// @brief The default class constructor.
+    MeshCacheWriter();
+
+    /// @brief The class destructor.
+    ~MeshCacheWriter() = default;
+
+    /// @brief Will add a material.
+    /// @param[in] desc     The material description.
+    void addMaterial(const MaterialDesc &desc);
+
+    /// @brief Will add a texture embedded in the model file, the data will be copied.
+    /// @param[in] name     The texture name used by the materials.
+    /// @param[in] data     The encoded image or the uncompressed RGBA pixels.
+    /// @param[in] size     The size of the data in bytes.
+    /// @param[in] width    The width of uncompressed pixels, 0 for an encoded image.
+    /// @param[in] height   The height of uncompressed pixels, 0 for an encoded image.
+    void addEmbeddedTexture(const String &name, const uc8 *data, size_t size, ui32 width, ui32 height);
+
+    /// @brief Will add a file the import depends on, its size and its modification time are stored.
+    /// A missing file is stored as well, the cache gets outdated when it shows up.
+    /// @param[in] filename The file.
+    void addDependency(const String &filename);
+
+    /// @brief Will add a mesh, the buffers will be copied. Buffers shared by several meshes are stored once.
+    /// @param[in] mesh             The mesh.
+    /// @param[in] materialIndex    The index of its material, -1 for none.
+    /// @return false if the mesh has no buffers.
+    bool addMesh(RenderBackend::Mesh *mesh, i32 materialIndex);
+
+    /// @brief Will add a node, the parent must be added before.
+    /// @param[in] name         The node name.
+    /// @param[in] parent       The index of the parent, -1 for the root.
+    /// @param[in] transform    The local transformation.
+    /// @param[in] meshRefs     The indices of the referenced meshes.
+    void addNode(const String &name, i32 parent, const glm::mat4 &transform, const cppcore::TArray<ui32> &meshRefs);
+
+    /// @brief Will set the bounds and the statistics of the model.
+    /// @param[in] aabb         The bounds.
+    /// @param[in] numVertices  The number of vertices.
+    /// @param[in] numTriangles The number of triangles.
+    void setModelInfo(const Common::AABB &aabb, ui32 numVertices, ui32 numTriangles);
+
+    /// @brief Will write the cache.
+    /// @param[in] filename     The cache file.
+    /// @param[in] key          The key of the source.
+    /// @return true if successful.
+    bool write(const String &filename, ui64 key) const;
+
+    OSRE_NON_COPYABLE(MeshCacheWriter)
+
+private:
+    CachedString addString(const String &str);
+    ui64 addData(const void *data, size_t size);
+    ui64 addBuffer(RenderBackend::BufferData *buffer);
+
+private:
+    MeshCacheHeader mHeader;
+    cppcore::TArray<CachedMaterial> mMaterials;
+    cppcore::TArray<CachedTexture> mTextures;
+    cppcore::TArray<CachedEmbeddedTexture> mEmbeddedTextures;
+    cppcore::TArray<CachedDependency> mDependencies;
+    cppcore::TArray<CachedMesh> mMeshes;
+    cppcore::TArray<CachedPrimitiveGroup> mPrimitiveGroups;
+    cppcore::TArray<RenderBackend::MeshLod> mLods;
+    cppcore::TArray<CachedNode> mNodes;
+    cppcore::TArray<ui32> mMeshRefs;
+    cppcore::TArray<c8> mStrings;
+    cppcore::TArray<uc8> mData;
+    std::map<const RenderBackend::BufferData *, ui64> mBufferOffsets;
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class reads a mesh cache from a memory mapping, the records will not be parsed.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT MeshCacheReader {
+public:
+    /// @brief The default class constructor.
+    MeshCacheReader();
+
+    /// @brief The class destructor.
+    ~MeshCacheReader() = default;
+
+    /// @brief Will open a cache, it will be rejected if the layout or the key does not match or if a dependency was changed.
+    /// @param[in] filename     The cache file.
+    /// @param[in] key          The expected key of the source.
+    /// @return true if the cache is valid.
+    bool open(const String &filename, ui64 key);
+
+    /// @brief Will close the cache.
+    void close();
+
+    /// @brief Will return true, if a valid cache is open.
+    /// @return true if open.
+    bool isOpen() const;
+
+    /// @brief Will return the header.
+    /// @return The header.
+    const MeshCacheHeader &getHeader() const;
+
+    /// @brief Will return the bounds of the model.
+    /// @return The bounds.
+    Common::AABB getBounds() const;
+
+    /// @brief Will return the number of materials.
+    /// @return The number of materials.
+    size_t getNumMaterials() const;
+
+    /// @brief Will return a material description.
+    /// @param[in] index    The material index.
+    /// @param[out] desc    The description.
+    void getMaterial(size_t index, MaterialDesc &desc) const;
+
+    /// @brief Will return the number of embedded textures.
+    /// @return The number of embedded textures.
+    size_t getNumEmbeddedTextures() const;
+
+    /// @brief Will return an embedded texture.
+    /// @param[in] index    The texture index.
+    /// @return The texture record.
+    const CachedEmbeddedTexture &getEmbeddedTexture(size_t index) const;
+
+    /// @brief Will return the data of an embedded texture, it is read from the mapping.
+    /// @param[in] tex      The texture record.
+    /// @return The encoded image or the uncompressed pixels.
+    const uc8 *getEmbeddedTextureData(const CachedEmbeddedTexture &tex) const;
+
+    /// @brief Will return the number of meshes.
+    /// @return The number of meshes.
+    size_t getNumMeshes() const;
+
+    /// @brief Will create a mesh from the cache.
+    /// @param[in] index            The mesh index.
+    /// @param[out] materialIndex   The index of the material, -1 for none.
+    /// @return The new mesh.
+    RenderBackend::Mesh *createMesh(size_t index, i32 &materialIndex) const;
+
+    /// @brief Will return the number of nodes.
+    /// @return The number of nodes.
+    size_t getNumNodes() const;
+
+    /// @brief Will return a node.
+    /// @param[in] index    The node index.
+    /// @return The node.
+    const CachedNode &getNode(size_t index) const;
+
+    /// @brief Will return the mesh references of a node.
+    /// @param[in] node     The node.
+    /// @return The first mesh reference.
+    const ui32 *getMeshRefs(const CachedNode &node) const;
+
+    /// @brief Will return a string.
+    /// @param[in] str      The string record.
+    /// @return The string.
+    String getString(const CachedString &str) const;
+
+    OSRE_NON_COPYABLE(MeshCacheReader)
+
+private:
+    template <class T>
+    const T *getSection(const MeshCacheSection &section) const;
+    bool validate() const;
+    bool isUpToDate() const;
+
+private:
+    IO::MemoryMappedFile mFile;
+    const MeshCacheHeader *mHeader;
+};
+
+inline bool MeshCacheReader::isOpen() const {
+    return nullptr != mHeader;
+}
+
+inline const MeshCacheHeader &MeshCacheReader::getHeader() const {
+    return *mHeader;
+}
+
+inline size_t MeshCacheReader::getNumMaterials() const {
+    return nullptr != mHeader ? static_cast<size_t>(mHeader->Materials.Count) : 0;
+}
+
+inline size_t MeshCacheReader::getNumEmbeddedTextures() const {
+    return nullptr != mHeader ? static_cast<size_t>(mHeader->EmbeddedTextures.Count) : 0;
+}
+
+inline size_t MeshCacheReader::getNumMeshes() const {
+    return nullptr != mHeader ? static_cast<size_t>(mHeader->Meshes.Count) : 0;
+}
+
+inline size_t MeshCacheReader::getNumNodes() const {
+    return nullptr != mHeader ? static_cast<size_t>(mHeader->Nodes.Count) : 0;
+}
+
+} // Namespace App
+} // Namespace OSRE
@@ -26,95 +26,359 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "RenderBackend/Mesh.h"
 #include "RenderBackend/MeshBuilder.h"
 #include "RenderBackend/MaterialBuilder.h"
+#include "Threading/WorkerPool.h"
 
-#include <cppcore/Random/RandomGenerator.h>
+#include <algorithm>
+#include <atomic>
+#include <limits>
+
+#ifdef OSRE_SSE2
+#   include <emmintrin.h>
+#endif
 
 namespace OSRE::App {
 
+using namespace ::OSRE::Common;
 using namespace ::OSRE::RenderBackend;
+using namespace ::OSRE::Threading;
 
-ParticleEmitter::ParticleEmitter(RenderBackendService *rbSrv) :
-        m_rbSrv(rbSrv),
-        m_numPoints(0),
-        m_col(nullptr),
-        m_pos(nullptr),
-        m_pt_indices(nullptr),
-        m_ptGeo(nullptr),
-        mUseBounds(false),
-        mBounds() {
+// Large enough to hide the scheduling costs, small enough to balance the workers
+static constexpr size_t ParticleChunkSize = 16384;
+
+// Lifetime of particles, which will never expire
+static constexpr f32 InfiniteLifetime = std::numeric_limits<f32>::max();
+
+namespace {
+
+// A xorshift generator, each chunk derives its own state from the seed, so the result does not
+// depend on the thread scheduling.
+struct FastRandom {
+    ui32 State;
+
+    explicit FastRandom(ui32 seed) {
+        // Mix the seed, neighboring seeds shall not create correlated sequences
+        seed = (seed ^ 61u) ^ (seed >> 16);
+        seed *= 9u;
+        seed = seed ^ (seed >> 4);
+        seed *= 0x27d4eb2du;
+        seed = seed ^ (seed >> 15);
+        State = seed != 0 ? seed : 0x9e3779b9u;
+    }
+
+    ui32 next() {
+        State ^= State << 13;
+        State ^= State >> 17;
+        State ^= State << 5;
+        return State;
+    }
+
+    f32 get(f32 min, f32 max) {
+        const f32 t = static_cast<f32>(next() >> 8) * (1.0f / 16777216.0f);
+        return min + (max - min) * t;
+    }
+};
+
+inline void writeVec3(const ParticleVertexStream &stream, size_t index, size_t offset, f32 x, f32 y, f32 z) {
+    f32 *dst = reinterpret_cast<f32 *>(stream.Data + index * stream.Stride + offset);
+    dst[0] = x;
+    dst[1] = y;
+    dst[2] = z;
+}
+
+} // namespace
+
+ParticleEmitParams::ParticleEmitParams() :
+        SpawnBox(glm::vec3(-2.0f), glm::vec3(2.0f)),
+        VelocityMin(-0.5f),
+        VelocityMax(0.5f),
+        ColorMin(0.01f),
+        ColorMax(1.0f),
+        LifetimeMin(InfiniteLifetime),
+        LifetimeMax(InfiniteLifetime) {
     // empty
 }
 
-ParticleEmitter::~ParticleEmitter() {
-    delete[] m_col;
-    delete[] m_pos;
+ParticleBuffer::ParticleBuffer() :
+        mPosX(), mPosY(), mPosZ(),
+        mVelX(), mVelY(), mVelZ(),
+        mAge(),
+        mLifetime(),
+        mNumAlive(0) {
+    // empty
+}
+
+void ParticleBuffer::reserve(size_t capacity) {
+    mPosX.resize(capacity);
+    mPosY.resize(capacity);
+    mPosZ.resize(capacity);
+    mVelX.resize(capacity);
+    mVelY.resize(capacity);
+    mVelZ.resize(capacity);
+    mAge.resize(capacity);
+    mLifetime.resize(capacity);
+    mNumAlive = 0;
+}
+
+size_t ParticleBuffer::emit(size_t count, const ParticleEmitParams &params, ui32 seed, const ParticleVertexStream &stream) {
+    const size_t numFree = getCapacity() - mNumAlive;
+    if (count > numFree) {
+        count = numFree;
+    }
+
+    const size_t first = mNumAlive;
+    const glm::vec3 &boxMin = params.SpawnBox.getMin();
+    const glm::vec3 &boxMax = params.SpawnBox.getMax();
+    WorkerPool::getInstance().parallelFor(count, ParticleChunkSize, [&](size_t begin, size_t end) {
+        FastRandom rng(seed + static_cast<ui32>(begin / ParticleChunkSize) * 0x9e3779b9u);
+        for (size_t i = first + begin; i < first + end; ++i) {
+            mPosX[i] = rng.get(boxMin.x, boxMax.x);
+            mPosY[i] = rng.get(boxMin.y, boxMax.y);
+            mPosZ[i] = rng.get(boxMin.z, boxMax.z);
+            mVelX[i] = rng.get(params.VelocityMin.x, params.VelocityMax.x);
+            mVelY[i] = rng.get(params.VelocityMin.y, params.VelocityMax.y);
+            mVelZ[i] = rng.get(params.VelocityMin.z, params.VelocityMax.z);
+            mAge[i] = 0.0f;
+            mLifetime[i] = rng.get(params.LifetimeMin, params.LifetimeMax);
+            if (stream.Data == nullptr) {
+                continue;
+            }
+
+            writeVec3(stream, i, stream.PositionOffset, mPosX[i], mPosY[i], mPosZ[i]);
+            if (stream.ColorOffset >= 0) {
+                writeVec3(stream, i, static_cast<size_t>(stream.ColorOffset),
+                        rng.get(params.ColorMin.x, params.ColorMax.x),
+                        rng.get(params.ColorMin.y, params.ColorMax.y),
+                        rng.get(params.ColorMin.z, params.ColorMax.z));
+            }
+        }
+    });
+    mNumAlive += count;
+
+    return count;
+}
+
+void ParticleBuffer::simulate(f32 dt, const glm::vec3 &gravity, const AABB *bounds, const ParticleVertexStream &stream) {
+    std::atomic<size_t> numDead(0);
+    WorkerPool::getInstance().parallelFor(mNumAlive, ParticleChunkSize, [&](size_t begin, size_t end) {
+        const size_t dead = integrate(begin, end, dt, gravity, bounds, stream);
+        if (dead != 0) {
+            numDead.fetch_add(dead);
+        }
+    });
+
+    // Most frames will not kill anything, so the serial compaction is only done on demand
+    if (numDead.load() != 0) {
+        compact(stream);
+    }
+}
+
+void ParticleBuffer::clear() {
+    mNumAlive = 0;
 }
 
-void ParticleEmitter::init(ui32 numPoints) {
-    m_numPoints = numPoints;
-    m_col = new glm::vec3[numPoints];
-    m_pos = new glm::vec3[numPoints];
+size_t ParticleBuffer::integrate(size_t begin, size_t end, f32 dt, const glm::vec3 &gravity, const AABB *bounds,
+        const ParticleVertexStream &stream) {
+    // Killed particles get an infinite age, the compaction only needs to compare the age
+    constexpr f32 Killed = std::numeric_limits<f32>::infinity();
+    const glm::vec3 boundsMin = bounds != nullptr ? bounds->getMin() : glm::vec3(-Killed);
+    const glm::vec3 boundsMax = bounds != nullptr ? bounds->getMax() : glm::vec3(Killed);
+    const glm::vec3 dv = gravity * dt;
+    size_t numDead = 0;
+    size_t i = begin;
+
+#ifdef OSRE_SSE2
+    const __m128 vdt = _mm_set1_ps(dt);
+    const __m128 dvx = _mm_set1_ps(dv.x), dvy = _mm_set1_ps(dv.y), dvz = _mm_set1_ps(dv.z);
+    const __m128 minX = _mm_set1_ps(boundsMin.x), minY = _mm_set1_ps(boundsMin.y), minZ = _mm_set1_ps(boundsMin.z);
+    const __m128 maxX = _mm_set1_ps(boundsMax.x), maxY = _mm_set1_ps(boundsMax.y), maxZ = _mm_set1_ps(boundsMax.z);
+    const __m128 killed = _mm_set1_ps(Killed);
+    for (; i + 4 <= end; i += 4) {
+        // Semi-implicit euler, the new velocity moves the particle
+        const __m128 vx = _mm_add_ps(_mm_loadu_ps(&mVelX[i]), dvx);
+        const __m128 vy = _mm_add_ps(_mm_loadu_ps(&mVelY[i]), dvy);
+        const __m128 vz = _mm_add_ps(_mm_loadu_ps(&mVelZ[i]), dvz);
+        const __m128 px = _mm_add_ps(_mm_loadu_ps(&mPosX[i]), _mm_mul_ps(vx, vdt));
+        const __m128 py = _mm_add_ps(_mm_loadu_ps(&mPosY[i]), _mm_mul_ps(vy, vdt));
+        const __m128 pz = _mm_add_ps(_mm_loadu_ps(&mPosZ[i]), _mm_mul_ps(vz, vdt));
+        __m128 age = _mm_add_ps(_mm_loadu_ps(&mAge[i]), vdt);
+
+        __m128 dead = _mm_cmpge_ps(age, _mm_loadu_ps(&mLifetime[i]));
+        dead = _mm_or_ps(dead, _mm_or_ps(_mm_cmplt_ps(px, minX), _mm_cmpgt_ps(px, maxX)));
+        dead = _mm_or_ps(dead, _mm_or_ps(_mm_cmplt_ps(py, minY), _mm_cmpgt_ps(py, maxY)));
+        dead = _mm_or_ps(dead, _mm_or_ps(_mm_cmplt_ps(pz, minZ), _mm_cmpgt_ps(pz, maxZ)));
+        age = _mm_or_ps(_mm_andnot_ps(dead, age), _mm_and_ps(dead, killed));
+
+        _mm_storeu_ps(&mVelX[i], vx);
+        _mm_storeu_ps(&mVelY[i], vy);
+        _mm_storeu_ps(&mVelZ[i], vz);
+        _mm_storeu_ps(&mPosX[i], px);
+        _mm_storeu_ps(&mPosY[i], py);
+        _mm_storeu_ps(&mPosZ[i], pz);
+        _mm_storeu_ps(&mAge[i], age);
+
+        const i32 deadMask = _mm_movemask_ps(dead);
+        numDead += static_cast<size_t>((deadMask & 1) + ((deadMask >> 1) & 1) + ((deadMask >> 2) & 1) + ((deadMask >> 3) & 1));
+        if (stream.Data != nullptr) {
+            for (size_t j = i; j < i + 4; ++j) {
+                writeVec3(stream, j, stream.PositionOffset, mPosX[j], mPosY[j], mPosZ[j]);
+            }
+        }
+    }
+#endif
+
+    for (; i < end; ++i) {
+        mVelX[i] += dv.x;
+        mVelY[i] += dv.y;
+        mVelZ[i] += dv.z;
+        mPosX[i] += mVelX[i] * dt;
+        mPosY[i] += mVelY[i] * dt;
+        mPosZ[i] += mVelZ[i] * dt;
+        mAge[i] += dt;
 
-    cppcore::RandomGenerator generator;
-    for (ui32 i = 0; i < m_numPoints; i++) {
-        const f32 r = static_cast<f32>(generator.get(1, 100)) / 100.0f;
-        const f32 g = static_cast<f32>(generator.get(1, 100)) / 100.0f;
-        const f32 b = static_cast<f32>(generator.get(1, 100)) / 100.0f;
-        m_col[i] = glm::vec3(r, g, b);
+        const bool outside = mPosX[i] < boundsMin.x || mPosX[i] > boundsMax.x ||
+                mPosY[i] < boundsMin.y || mPosY[i] > boundsMax.y ||
+                mPosZ[i] < boundsMin.z || mPosZ[i] > boundsMax.z;
+        if (outside || mAge[i] >= mLifetime[i]) {
+            mAge[i] = Killed;
+            ++numDead;
+        }
 
-        const f32 x = static_cast<f32>(generator.get(0, 400) - 200) / 100.0f;
-        const f32 y = static_cast<f32>(generator.get(0, 400) - 200) / 100.0f;
-        const f32 z = static_cast<f32>(generator.get(0, 400) - 200) / 100.0f;
-        m_pos[i] = glm::vec3(x, y, z);
+        if (stream.Data != nullptr) {
+            writeVec3(stream, i, stream.PositionOffset, mPosX[i], mPosY[i], mPosZ[i]);
+        }
     }
 
-    m_pt_indices = new GLushort[m_numPoints];
-    for (ui32 i = 0; i < m_numPoints; i++) {
-        m_pt_indices[i] = static_cast<GLushort>(i);
+    return numDead;
+}
+
+void ParticleBuffer::compact(const ParticleVertexStream &stream) {
+    size_t i = 0;
+    while (i < mNumAlive) {
+        if (mAge[i] < mLifetime[i]) {
+            ++i;
+            continue;
+        }
+
+        // Move the last alive particle into the gap, it was already written this frame
+        const size_t last = --mNumAlive;
+        if (i == last) {
+            break;
+        }
+
+        mPosX[i] = mPosX[last];
+        mPosY[i] = mPosY[last];
+        mPosZ[i] = mPosZ[last];
+        mVelX[i] = mVelX[last];
+        mVelY[i] = mVelY[last];
+        mVelZ[i] = mVelZ[last];
+        mAge[i] = mAge[last];
+        mLifetime[i] = mLifetime[last];
+        if (stream.Data != nullptr) {
+            ::memcpy(stream.Data + i * stream.Stride, stream.Data + last * stream.Stride, stream.Stride);
+        }
     }
+}
+
+ParticleEmitter::ParticleEmitter(RenderBackendService *rbSrv) :
+        m_rbSrv(rbSrv),
+        mParticles(),
+        mEmitParams(),
+        mGravity(0.0f),
+        mEmissionRate(0.0f),
+        mEmissionAccum(0.0),
+        mSeed(1),
+        m_ptGeo(nullptr),
+        mUseBounds(false),
+        mBounds(),
+        mMode(ParticleSimulationMode::Cpu),
+        mCapacity(0u),
+        mEmitCursor(0u),
+        mPendingEmit(0u),
+        mNumSpawned(0u) {
+    // empty
+}
+
+void ParticleEmitter::init(ui32 numPoints, ParticleSimulationMode mode) {
+    mMode = mode;
+    mCapacity = numPoints;
+    const VertexType type = mMode == ParticleSimulationMode::Gpu ? VertexType::RenderVertex : VertexType::ColorVertex;
 
     MeshBuilder meshBuilder;
-    meshBuilder.allocEmptyMesh("", VertexType::ColorVertex);
+    meshBuilder.allocEmptyMesh("", type);
     m_ptGeo = meshBuilder.getMesh();
     m_rbSrv->addMesh(m_ptGeo, 0);
-    MeshBuilder::allocVertices(m_ptGeo, VertexType::ColorVertex, m_numPoints, m_pos, m_col, nullptr, BufferAccessType::ReadOnly);
-    ui32 pt_size = sizeof(GLushort) * m_numPoints;
-    m_ptGeo->createIndexBuffer(m_pt_indices, pt_size, IndexType::UnsignedShort, BufferAccessType::ReadOnly);
+
+    if (mMode == ParticleSimulationMode::Gpu) {
+        // The vertex buffer holds the particle state, all particles start dead
+        std::vector<RenderVert> vertices(numPoints);
+        m_ptGeo->createVertexBuffer(vertices.data(), sizeof(RenderVert) * numPoints, BufferAccessType::ReadWrite);
+    } else {
+        // The vertex buffer is streamed, the particles will be written into it directly
+        mParticles.reserve(numPoints);
+        MeshBuilder::allocVertices(m_ptGeo, type, numPoints, nullptr, nullptr, nullptr, BufferAccessType::ReadWrite);
+    }
+
+    // Alive particles are dense, so the indices never change
+    std::vector<ui32> indices(numPoints);
+    for (ui32 i = 0; i < numPoints; ++i) {
+        indices[i] = i;
+    }
+    m_ptGeo->createIndexBuffer(indices.data(), sizeof(ui32) * numPoints, IndexType::UnsignedInt, BufferAccessType::ReadOnly);
 
     // setup primitives
-    m_ptGeo->addPrimitiveGroup(m_numPoints, PrimitiveType::PointList, 0);
+    m_ptGeo->addPrimitiveGroup(numPoints, PrimitiveType::PointList, 0);
     m_ptGeo->setModelMatrix(true, glm::mat4(1.0f));
 
     // setup material
-    Material *mat = MaterialBuilder::createBuildinMaterial(VertexType::ColorVertex);
+    Material *mat = mMode == ParticleSimulationMode::Gpu ? MaterialBuilder::createParticleMaterial() :
+            MaterialBuilder::createBuildinMaterial(VertexType::ColorVertex);
     m_ptGeo->setMaterial(mat);
+
+    emit(numPoints);
 }
 
-void ParticleEmitter::update(d32 /*tick*/) {
-    cppcore::RandomGenerator generator;
-    for (ui32 i = 0; i < m_numPoints; i++) {
-        const f32 x = static_cast<f32>(generator.get(-10, 10)) / 100.0f;
-        const f32 y = static_cast<f32>(generator.get(-10, 10)) / 100.0f;
-        const f32 z = static_cast<f32>(generator.get(-10, 10)) / 100.0f;
-        m_pos[i] += glm::vec3(x, y, z);
-        if (mUseBounds) {
-            glm::vec3 pt(m_pos[i].x, m_pos[i].y, m_pos[i].z);
-            if (!mBounds.isIn(pt)) {
-                m_pos[i] -= m_pos[i];
-                m_pos[i] -= m_pos[i];
-            }
-        }
+void ParticleEmitter::update(d32 tick) {
+    const f32 dt = static_cast<f32>(tick);
+    mEmissionAccum += static_cast<d32>(mEmissionRate) * tick;
+    if (mEmissionAccum >= 1.0) {
+        const ui32 numNew = static_cast<ui32>(mEmissionAccum);
+        mEmissionAccum -= static_cast<d32>(numNew);
+        emit(numNew);
+    }
+
+    if (mMode == ParticleSimulationMode::Gpu) {
+        submitGpuStep(dt);
+        return;
     }
 
-    ui32 offset(0);
-    for (ui32 i = 0; i < m_numPoints; i++) {
-        uc8 *ptr = (uc8 *)m_ptGeo->getVertexBuffer()->getData();
-        ::memcpy(&ptr[offset], &m_pos[i], sizeof(glm::vec3));
-        offset += sizeof(ColorVert);
+    mParticles.simulate(dt, mGravity, mUseBounds ? &mBounds : nullptr, getVertexStream());
+    updatePrimitives();
+}
+
+ui32 ParticleEmitter::emit(ui32 numParticles) {
+    if (mMode == ParticleSimulationMode::Gpu) {
+        // The ring replaces the oldest particles, so one step can respawn each particle once
+        const ui32 numNew = std::min(numParticles, mCapacity - mPendingEmit);
+        mPendingEmit += numNew;
+        mNumSpawned = std::min(mCapacity, mNumSpawned + numNew);
+        return numNew;
     }
+
+    const size_t numNew = mParticles.emit(numParticles, mEmitParams, mSeed++, getVertexStream());
+    updatePrimitives();
+
+    return static_cast<ui32>(numNew);
+}
+
+void ParticleEmitter::setEmissionRate(f32 rate) {
+    mEmissionRate = rate > 0.0f ? rate : 0.0f;
 }
 
-void ParticleEmitter::setBounds(const Common::AABB &bounds) {
+void ParticleEmitter::setGravity(const glm::vec3 &gravity) {
+    mGravity = gravity;
+}
+
+void ParticleEmitter::setBounds(const AABB &bounds) {
     mUseBounds = true;
     mBounds = bounds;
 }
@@ -123,4 +387,59 @@ Mesh *ParticleEmitter::getMesh() const {
     return m_ptGeo;
 }
 
-} // namespace OSRE::App
\ No newline at end of file
+ParticleVertexStream ParticleEmitter::getVertexStream() const {
+    ParticleVertexStream stream;
+    if (m_ptGeo == nullptr || m_ptGeo->getVertexBuffer() == nullptr) {
+        return stream;
+    }
+
+    stream.Data = reinterpret_cast<uc8 *>(m_ptGeo->getVertexBuffer()->getData());
+    stream.Stride = sizeof(ColorVert);
+    stream.PositionOffset = offsetof(ColorVert, position);
+    stream.ColorOffset = static_cast<i32>(offsetof(ColorVert, color0));
+
+    return stream;
+}
+
+void ParticleEmitter::updatePrimitives() {
+    if (m_ptGeo == nullptr) {
+        return;
+    }
+
+    PrimitiveGroup *grp = m_ptGeo->getPrimitiveGroupAt(0);
+    if (grp != nullptr) {
+        grp->m_numIndices = mParticles.getNumAlive();
+    }
+}
+
+void ParticleEmitter::submitGpuStep(f32 dt) {
+    if (m_ptGeo == nullptr || mCapacity == 0u) {
+        return;
+    }
+
+    GpuParticleParams params;
+    params.Gravity = mGravity;
+    params.DeltaTime = dt;
+    params.SpawnMin = mEmitParams.SpawnBox.getMin();
+    params.SpawnMax = mEmitParams.SpawnBox.getMax();
+    params.VelocityMin = mEmitParams.VelocityMin;
+    params.VelocityMax = mEmitParams.VelocityMax;
+    params.ColorMin = mEmitParams.ColorMin;
+    params.ColorMax = mEmitParams.ColorMax;
+    params.LifetimeMin = std::min(mEmitParams.LifetimeMin, InfiniteLifetime);
+    params.LifetimeMax = std::min(mEmitParams.LifetimeMax, InfiniteLifetime);
+    params.UseBounds = mUseBounds ? 1u : 0u;
+    params.BoundsMin = mBounds.getMin();
+    params.BoundsMax = mBounds.getMax();
+    params.Capacity = mCapacity;
+    params.EmitStart = mEmitCursor;
+    params.EmitCount = mPendingEmit;
+    params.Seed = mSeed++;
+
+    mEmitCursor = (mEmitCursor + mPendingEmit) % mCapacity;
+    mPendingEmit = 0u;
+
+    m_rbSrv->simulateParticles(m_ptGeo, params);
+}
+
+} // namespace OSRE::App
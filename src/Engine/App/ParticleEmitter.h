@@ -26,8 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Common/TAABB.h"
 #include "Common/BaseMath.h"
 
-#include <GL/glew.h>
-#include <GL/gl.h>
+#include <vector>
 
 namespace OSRE {
 
@@ -38,30 +37,221 @@ namespace RenderBackend {
 
 namespace App {
 
+/// @brief  Describes how new particles will be spawned.
+struct ParticleEmitParams {
+    Common::AABB SpawnBox;          ///< New particles will be placed randomly in this box.
+    glm::vec3 VelocityMin;          ///< The minimal start velocity per axis.
+    glm::vec3 VelocityMax;          ///< The maximal start velocity per axis.
+    glm::vec3 ColorMin;             ///< The minimal color per channel.
+    glm::vec3 ColorMax;             ///< The maximal color per channel.
+    f32 LifetimeMin;                ///< The minimal lifetime in seconds.
+    f32 LifetimeMax;                ///< The maximal lifetime in seconds.
+
+    /// @brief  The default class constructor, particles will live forever.
+    ParticleEmitParams();
+};
+
+/// @brief  Describes where the particles will be simulated.
+enum class ParticleSimulationMode {
+    Cpu,    ///< Simulated on the worker pool, the vertex buffer will be uploaded each frame.
+    Gpu     ///< Simulated via transform feedback, the particles never leave the GPU.
+};
+
+/// @brief  Describes where particles will be written into a vertex buffer.
+struct ParticleVertexStream {
+    uc8 *Data = nullptr;            ///< The first vertex.
+    size_t Stride = 0;              ///< The vertex size in bytes.
+    size_t PositionOffset = 0;      ///< The offset of the position ( x|y|z ).
+    i32 ColorOffset = -1;           ///< The offset of the color ( r|g|b ), -1 for none.
+};
+
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
-///	@brief	This class offers some system-specific functions.
+///	@brief	This class stores the particles as a structure of arrays.
+///
+/// The alive particles are kept dense at the front of the arrays, dead particles will be replaced
+/// by the last alive one. The simulation runs in chunks on the worker pool and writes the positions
+/// directly into the vertex stream, so the vertex buffer can be uploaded without any conversion.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT ParticleBuffer {
+public:
+    /// @brief  The default class constructor.
+    ParticleBuffer();
+
+    /// @brief  The class destructor.
+    ~ParticleBuffer() = default;
+
+    /// @brief  Will set the maximal number of particles, all particles will be killed.
+    /// @param[in] capacity The number of particles.
+    void reserve(size_t capacity);
+
+    /// @brief  Will spawn new particles, the number is clamped to the free capacity.
+    /// @param[in] count    The number of new particles.
+    /// @param[in] params   The spawn parameters.
+    /// @param[in] seed     The random seed.
+    /// @param[in] stream   The vertex stream to write the new particles into.
+    /// @return The number of spawned particles.
+    size_t emit(size_t count, const ParticleEmitParams &params, ui32 seed, const ParticleVertexStream &stream);
+
+    /// @brief  Will integrate all alive particles and kill the expired ones.
+    /// @param[in] dt       The time step in seconds.
+    /// @param[in] gravity  The acceleration.
+    /// @param[in] bounds   Particles outside of these bounds will be killed, nullptr for none.
+    /// @param[in] stream   The vertex stream to write the positions into.
+    void simulate(f32 dt, const glm::vec3 &gravity, const Common::AABB *bounds, const ParticleVertexStream &stream);
+
+    /// @brief  Will kill all particles.
+    void clear();
+
+    /// @brief  Will return the number of alive particles.
+    /// @return The number of alive particles.
+    size_t getNumAlive() const;
+
+    /// @brief  Will return the maximal number of particles.
+    /// @return The capacity.
+    size_t getCapacity() const;
+
+    /// @brief  Will return the position of a particle.
+    /// @param[in] index    The particle index.
+    /// @return The position.
+    glm::vec3 getPosition(size_t index) const;
+
+    /// @brief  Will return the age of a particle.
+    /// @param[in] index    The particle index.
+    /// @return The age in seconds.
+    f32 getAge(size_t index) const;
+
+private:
+    size_t integrate(size_t begin, size_t end, f32 dt, const glm::vec3 &gravity, const Common::AABB *bounds,
+            const ParticleVertexStream &stream);
+    void compact(const ParticleVertexStream &stream);
+
+private:
+    std::vector<f32> mPosX, mPosY, mPosZ;
+    std::vector<f32> mVelX, mVelY, mVelZ;
+    std::vector<f32> mAge;
+    std::vector<f32> mLifetime;
+    size_t mNumAlive;
+};
+
+inline size_t ParticleBuffer::getNumAlive() const {
+    return mNumAlive;
+}
+
+inline size_t ParticleBuffer::getCapacity() const {
+    return mAge.size();
+}
+
+inline glm::vec3 ParticleBuffer::getPosition(size_t index) const {
+    return glm::vec3(mPosX[index], mPosY[index], mPosZ[index]);
+}
+
+inline f32 ParticleBuffer::getAge(size_t index) const {
+    return mAge[index];
+}
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief	This class implements a point particle emitter.
+///
+/// Particles will be spawned by the emission rate or by emit, age and will be killed at the end of
+/// their lifetime or when they leave the bounds. Only the alive particles will be drawn, use
+/// updateMesh and updateMeshPrimitives of the render backend after each update.
+///
+/// In the GPU mode the particles are stored in the vertex buffer and new particles replace the
+/// oldest ones in a ring. The update will queue the simulation step at the render backend, so it
+/// must be called inside a render batch, no buffer updates are needed.
 //-------------------------------------------------------------------------------------------------
 class OSRE_EXPORT ParticleEmitter {
 public:
-    ParticleEmitter( RenderBackend::RenderBackendService *rbSrv );
-    ~ParticleEmitter();
-    void init( ui32 numPoints );
-    void update( d32 tick );
+    /// @brief  The class constructor.
+    /// @param[in] rbSrv    The render backend service.
+    ParticleEmitter(RenderBackend::RenderBackendService *rbSrv);
+
+    /// @brief  The class destructor.
+    ~ParticleEmitter() = default;
+
+    /// @brief  Will create the point mesh and spawn the first particles.
+    /// @param[in] numPoints    The maximal number of particles, all of them will be spawned.
+    /// @param[in] mode         The simulation mode.
+    void init(ui32 numPoints, ParticleSimulationMode mode = ParticleSimulationMode::Cpu);
+
+    /// @brief  Will spawn and simulate the particles.
+    /// @param[in] tick     The time step in seconds.
+    void update(d32 tick);
+
+    /// @brief  Will spawn new particles.
+    /// @param[in] numParticles The number of particles.
+    /// @return The number of spawned particles.
+    ui32 emit(ui32 numParticles);
+
+    /// @brief  Will set the number of particles spawned per second.
+    /// @param[in] rate     The emission rate.
+    void setEmissionRate(f32 rate);
+
+    /// @brief  Will return the spawn parameters.
+    /// @return The spawn parameters, can be changed.
+    ParticleEmitParams &getEmitParams();
+
+    /// @brief  Will set the acceleration of all particles.
+    /// @param[in] gravity  The acceleration.
+    void setGravity(const glm::vec3 &gravity);
+
+    /// @brief  Will set the bounds, particles leaving the bounds will be killed.
+    /// @param[in] bounds   The bounds.
     void setBounds(const Common::AABB& bounds);
+
+    /// @brief  Will return the number of alive particles.
+    /// @return The number of particles, an upper bound in the GPU mode.
+    ui32 getNumAlive() const;
+
+    /// @brief  Will return the simulation mode.
+    /// @return The simulation mode.
+    ParticleSimulationMode getMode() const;
+
+    /// @brief  Will return the point mesh.
+    /// @return The mesh.
     RenderBackend::Mesh* getMesh() const;
 
+private:
+    ParticleVertexStream getVertexStream() const;
+    void updatePrimitives();
+    void submitGpuStep(f32 dt);
+
 private:
     RenderBackend::RenderBackendService *m_rbSrv;
-    ui32 m_numPoints;
-    glm::vec3 *m_col;
-    glm::vec3 *m_pos;
-    GLushort *m_pt_indices;
+    ParticleBuffer mParticles;
+    ParticleEmitParams mEmitParams;
+    glm::vec3 mGravity;
+    f32 mEmissionRate;
+    d32 mEmissionAccum;
+    ui32 mSeed;
     RenderBackend::Mesh *m_ptGeo;
     bool mUseBounds;
     Common::AABB mBounds;
+    ParticleSimulationMode mMode;
+    ui32 mCapacity;
+    ui32 mEmitCursor;
+    ui32 mPendingEmit;
+    ui32 mNumSpawned;
 };
 
+inline ParticleEmitParams &ParticleEmitter::getEmitParams() {
+    return mEmitParams;
+}
+
+inline ui32 ParticleEmitter::getNumAlive() const {
+    if (mMode == ParticleSimulationMode::Gpu) {
+        return mNumSpawned;
+    }
+    return static_cast<ui32>(mParticles.getNumAlive());
+}
+
+inline ParticleSimulationMode ParticleEmitter::getMode() const {
+    return mMode;
+}
+
 } // Namespace App
 } // Namespace OSRE
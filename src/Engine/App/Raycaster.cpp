@@ -0,0 +1,340 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "App/Raycaster.h"
+#include "App/Component.h"
+#include "App/Entity.h"
+#include "RenderBackend/Mesh.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef OSRE_SSE2
+#   include <emmintrin.h>
+#endif
+
+namespace OSRE::App {
+
+using namespace ::OSRE::Common;
+using namespace ::OSRE::RenderBackend;
+
+static Ray transformRay(const glm::mat4 &m, const Ray &ray) {
+    // The direction will not be normalized, so the ray parameters stay the same in both spaces
+    const glm::vec3 origin(m * glm::vec4(ray.getOrigin(), 1.0f));
+    const glm::vec3 direction(m * glm::vec4(ray.getDirection(), 0.0f));
+
+    return Ray(origin, direction);
+}
+
+static ui32 readIndex(const c8 *indices, IndexType type, size_t i) {
+    switch (type) {
+        case IndexType::UnsignedByte:
+            return reinterpret_cast<const uc8 *>(indices)[i];
+        case IndexType::UnsignedShort:
+            return reinterpret_cast<const ui16 *>(indices)[i];
+        case IndexType::UnsignedInt:
+            return reinterpret_cast<const ui32 *>(indices)[i];
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+bool Raycaster::intersect(const Ray &ray, const AABB &aabb, f32 maxDistance, f32 &distance) {
+    if (!aabb.isValid()) {
+        return false;
+    }
+
+    f32 tNear = 0.0f, tFar = maxDistance;
+    for (glm::length_t i = 0; i < 3; ++i) {
+        const f32 o = ray.getOrigin()[i];
+        const f32 d = ray.getDirection()[i];
+        const f32 min = aabb.getMin()[i];
+        const f32 max = aabb.getMax()[i];
+        if (d == 0.0f) {
+            if (o < min || o > max) {
+                return false;
+            }
+            continue;
+        }
+
+        const f32 inv = 1.0f / d;
+        f32 t1 = (min - o) * inv;
+        f32 t2 = (max - o) * inv;
+        if (t1 > t2) {
+            std::swap(t1, t2);
+        }
+        tNear = std::max(tNear, t1);
+        tFar = std::min(tFar, t2);
+        if (tNear > tFar) {
+            return false;
+        }
+    }
+    distance = tNear;
+
+    return true;
+}
+
+ui32 Raycaster::intersect(const Ray *rays, const AABB &aabb, const f32 *maxDistance, f32 *distance) {
+    if (rays == nullptr || !aabb.isValid()) {
+        return 0;
+    }
+
+#ifdef OSRE_SSE2
+    // The packet will be transposed into one register per component
+    alignas(16) f32 comp[6][PacketSize];
+    for (size_t i = 0; i < PacketSize; ++i) {
+        const glm::vec3 &o = rays[i].getOrigin();
+        const glm::vec3 &d = rays[i].getDirection();
+        comp[0][i] = o.x;
+        comp[1][i] = o.y;
+        comp[2][i] = o.z;
+        comp[3][i] = d.x;
+        comp[4][i] = d.y;
+        comp[5][i] = d.z;
+    }
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    __m128 tNear = _mm_setzero_ps();
+    __m128 tFar = _mm_loadu_ps(maxDistance);
+    for (glm::length_t i = 0; i < 3; ++i) {
+        const __m128 o = _mm_load_ps(comp[i]);
+        const __m128 inv = _mm_div_ps(one, _mm_load_ps(comp[3 + i]));
+        const __m128 t1 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(aabb.getMin()[i]), o), inv);
+        const __m128 t2 = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(aabb.getMax()[i]), o), inv);
+        tNear = _mm_max_ps(tNear, _mm_min_ps(t1, t2));
+        tFar = _mm_min_ps(tFar, _mm_max_ps(t1, t2));
+    }
+    _mm_storeu_ps(distance, tNear);
+
+    return static_cast<ui32>(_mm_movemask_ps(_mm_cmple_ps(tNear, tFar)));
+#else
+    ui32 mask = 0;
+    for (size_t i = 0; i < PacketSize; ++i) {
+        if (maxDistance[i] >= 0.0f && intersect(rays[i], aabb, maxDistance[i], distance[i])) {
+            mask |= 1u << i;
+        }
+    }
+
+    return mask;
+#endif
+}
+
+bool Raycaster::intersect(const Ray &ray, const glm::vec3 &v0, const glm::vec3 &v1, const glm::vec3 &v2, f32 &distance) {
+    constexpr f32 Epsilon = 1.0e-8f;
+
+    const glm::vec3 e1 = v1 - v0;
+    const glm::vec3 e2 = v2 - v0;
+    const glm::vec3 p = glm::cross(ray.getDirection(), e2);
+    const f32 det = glm::dot(e1, p);
+    if (det > -Epsilon && det < Epsilon) {
+        return false;
+    }
+
+    const f32 invDet = 1.0f / det;
+    const glm::vec3 s = ray.getOrigin() - v0;
+    const f32 u = glm::dot(s, p) * invDet;
+    if (u < 0.0f || u > 1.0f) {
+        return false;
+    }
+
+    const glm::vec3 q = glm::cross(s, e1);
+    const f32 v = glm::dot(ray.getDirection(), q) * invDet;
+    if (v < 0.0f || u + v > 1.0f) {
+        return false;
+    }
+
+    const f32 t = glm::dot(e2, q) * invDet;
+    if (t < 0.0f) {
+        return false;
+    }
+    distance = t;
+
+    return true;
+}
+
+bool Raycaster::intersect(const Ray &ray, const Mesh &mesh, RaycastMode mode, f32 &distance, ui32 &triangle) {
+    BufferData *vb = mesh.getVertexBuffer();
+    BufferData *ib = mesh.getIndexBuffer();
+    const size_t stride = Mesh::getVertexSize(mesh.getVertexType());
+    if (vb == nullptr || ib == nullptr || stride == 0) {
+        return false;
+    }
+
+    const c8 *vertices = vb->getData();
+    const c8 *indices = ib->getData();
+    const size_t numVertices = vb->getSize() / stride;
+    const IndexType indexType = mesh.getIndexType();
+
+    // Compact vertices need to be dequantized
+    const bool compact = mesh.getVertexType() == VertexType::CompactVertex;
+    auto getPosition = [&](ui32 index) {
+        if (compact) {
+            return mesh.getPosition(index);
+        }
+        const f32 *p = reinterpret_cast<const f32 *>(vertices + index * stride);
+        return glm::vec3(p[0], p[1], p[2]);
+    };
+
+    bool hit = false;
+    auto testRange = [&](size_t start, size_t numIndices) {
+        for (size_t i = start; i + 2 < start + numIndices; i += 3) {
+            const ui32 i0 = readIndex(indices, indexType, i);
+            const ui32 i1 = readIndex(indices, indexType, i + 1);
+            const ui32 i2 = readIndex(indices, indexType, i + 2);
+            if (i0 >= numVertices || i1 >= numVertices || i2 >= numVertices) {
+                continue;
+            }
+
+            f32 t = 0.0f;
+            if (intersect(ray, getPosition(i0), getPosition(i1), getPosition(i2), t) && t <= distance) {
+                distance = t;
+                triangle = static_cast<ui32>(i / 3);
+                hit = true;
+                if (mode == RaycastMode::AnyHit) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    };
+
+    // The first level contains the full detailed triangles
+    if (mesh.getNumLods() > 0) {
+        const MeshLod &lod = mesh.getLodAt(0);
+        testRange(lod.mStartIndex, lod.mNumIndices);
+        return hit;
+    }
+
+    for (size_t i = 0; i < mesh.getNumberOfPrimitiveGroups(); ++i) {
+        const PrimitiveGroup *grp = mesh.getPrimitiveGroupAt(i);
+        if (grp == nullptr || grp->m_primitive != PrimitiveType::TriangleList) {
+            continue;
+        }
+        if (testRange(grp->m_startIndex, grp->m_numIndices)) {
+            break;
+        }
+    }
+
+    return hit;
+}
+
+void Raycaster::cast(const cppcore::TArray<Entity *> &entities, const Ray *rays, size_t numRays,
+        RayHit *hits, RaycastMode mode, f32 maxDistance) {
+    if (rays == nullptr || hits == nullptr || numRays == 0) {
+        return;
+    }
+
+    // Collect the world bounds once for all packets
+    cppcore::TArray<Entity *> candidates;
+    cppcore::TArray<AABB> bounds;
+    cppcore::TArray<glm::mat4> toLocal;
+    for (size_t i = 0; i < entities.size(); ++i) {
+        Entity *entity = entities[i];
+        if (entity == nullptr || !entity->getAABB().isValid()) {
+            continue;
+        }
+
+        glm::mat4 world(1.0f);
+        if (entity->getNode() != nullptr) {
+            world = entity->getNode()->getWorlTransformMatrix();
+        }
+        candidates.add(entity);
+        bounds.add(entity->getAABB().transform(world));
+        toLocal.add(glm::inverse(world));
+    }
+
+    for (size_t first = 0; first < numRays; first += PacketSize) {
+        const size_t numLanes = std::min(PacketSize, numRays - first);
+        Ray packet[PacketSize];
+        f32 best[PacketSize], entry[PacketSize];
+        for (size_t lane = 0; lane < PacketSize; ++lane) {
+            // Unused lanes will be disabled by a negative distance
+            packet[lane] = lane < numLanes ? rays[first + lane] : rays[first];
+            best[lane] = lane < numLanes ? maxDistance : -1.0f;
+            if (lane < numLanes) {
+                hits[first + lane] = RayHit();
+            }
+        }
+
+        for (size_t e = 0; e < candidates.size(); ++e) {
+            if (mode == RaycastMode::AnyHit && std::max(std::max(best[0], best[1]), std::max(best[2], best[3])) < 0.0f) {
+                break;
+            }
+
+            const ui32 mask = intersect(packet, bounds[e], best, entry);
+            if (mask == 0) {
+                continue;
+            }
+
+            RenderComponent *rc = (RenderComponent *)candidates[e]->getComponent(ComponentType::RenderComponentType);
+            if (rc == nullptr) {
+                continue;
+            }
+
+            for (size_t lane = 0; lane < numLanes; ++lane) {
+                if ((mask & (1u << lane)) == 0) {
+                    continue;
+                }
+
+                const Ray entityRay = transformRay(toLocal[e], packet[lane]);
+                for (size_t m = 0; m < rc->getNumMeshes(); ++m) {
+                    Mesh *mesh = rc->getMeshAt(m);
+                    if (mesh == nullptr) {
+                        continue;
+                    }
+
+                    const Ray meshRay = mesh->isLocal() ? transformRay(glm::inverse(mesh->getLocalMatrix()), entityRay) : entityRay;
+                    f32 enter = 0.0f;
+                    if (!intersect(meshRay, mesh->getAABB(), best[lane], enter)) {
+                        continue;
+                    }
+
+                    f32 distance = best[lane];
+                    ui32 triangle = 0;
+                    if (intersect(meshRay, *mesh, mode, distance, triangle)) {
+                        RayHit &hit = hits[first + lane];
+                        hit.mEntity = candidates[e];
+                        hit.mMesh = mesh;
+                        hit.mTriangle = triangle;
+                        hit.mDistance = distance;
+                        best[lane] = distance;
+                        if (mode == RaycastMode::AnyHit) {
+                            best[lane] = -1.0f;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        for (size_t lane = 0; lane < numLanes; ++lane) {
+            RayHit &hit = hits[first + lane];
+            if (hit.hasHit()) {
+                hit.mPoint = packet[lane].getOrigin() + packet[lane].getDirection() * hit.mDistance;
+            }
+        }
+    }
+}
+
+} // namespace OSRE::App
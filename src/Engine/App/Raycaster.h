@@ -0,0 +1,124 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "App/AppCommon.h"
+#include "Common/glm_common.h"
+#include "Common/TAABB.h"
+#include "Common/TRay.h"
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+
+// Forward declarations ---------------------------------------------------------------------------
+namespace RenderBackend {
+    class Mesh;
+}
+
+namespace App {
+
+class Entity;
+
+/// @brief Describes how a ray cast will be resolved.
+enum class RaycastMode {
+    ClosestHit = 0,     ///< The nearest hit along the ray will be reported.
+    AnyHit              ///< The first found hit will be reported, use this for visibility tests.
+};
+
+/// @brief Describes the result of a ray cast.
+struct RayHit {
+    Entity *mEntity = nullptr;                  ///< The hit entity, nullptr if nothing was hit.
+    RenderBackend::Mesh *mMesh = nullptr;       ///< The hit mesh.
+    ui32 mTriangle = 0;                         ///< The index of the hit triangle in the mesh.
+    f32 mDistance = 0.0f;                       ///< The ray parameter of the hit, in units of the direction length.
+    glm::vec3 mPoint = glm::vec3(0.0f);         ///< The hit point in world space.
+
+    /// @brief Will return true, if something was hit.
+    bool hasHit() const {
+        return mEntity != nullptr;
+    }
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements ray casts against the triangles of entities.
+///
+/// Rays will be processed in packets of four. The packets are tested against the world bounds of
+/// the entities with a SIMD slab test first, only the triangles of the hit entities will be tested
+/// afterwards. Triangle list groups are supported, for meshes with a level of detail chain the
+/// full detailed level will be used.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT Raycaster {
+public:
+    /// @brief The number of rays in one packet.
+    static constexpr size_t PacketSize = 4;
+
+    /// @brief Will test a ray against a box.
+    /// @param[in]  ray         The ray.
+    /// @param[in]  aabb        The box.
+    /// @param[in]  maxDistance The maximal ray parameter.
+    /// @param[out] distance    The ray parameter where the ray enters the box, 0 if it starts inside.
+    /// @return true, if the ray hits the box.
+    static bool intersect(const Common::Ray &ray, const Common::AABB &aabb, f32 maxDistance, f32 &distance);
+
+    /// @brief Will test a packet of rays against a box.
+    /// @param[in]  rays        The rays, PacketSize entries.
+    /// @param[in]  aabb        The box.
+    /// @param[in]  maxDistance The maximal ray parameter per ray, negative values disable the ray.
+    /// @param[out] distance    The ray parameters where the rays enter the box.
+    /// @return A bit mask of the rays hitting the box.
+    static ui32 intersect(const Common::Ray *rays, const Common::AABB &aabb, const f32 *maxDistance, f32 *distance);
+
+    /// @brief Will test a ray against a triangle.
+    /// @param[in]  ray         The ray.
+    /// @param[in]  v0          The first vertex.
+    /// @param[in]  v1          The second vertex.
+    /// @param[in]  v2          The third vertex.
+    /// @param[out] distance    The ray parameter of the hit.
+    /// @return true, if the triangle was hit, both sides will be hit.
+    static bool intersect(const Common::Ray &ray, const glm::vec3 &v0, const glm::vec3 &v1, const glm::vec3 &v2, f32 &distance);
+
+    /// @brief Will test a ray against the triangles of a mesh.
+    /// @param[in]    ray       The ray in mesh space.
+    /// @param[in]    mesh      The mesh.
+    /// @param[in]    mode      The hit mode.
+    /// @param[inout] distance  The maximal ray parameter, will contain the parameter of the hit.
+    /// @param[out]   triangle  The index of the hit triangle.
+    /// @return true, if a triangle was hit.
+    static bool intersect(const Common::Ray &ray, const RenderBackend::Mesh &mesh, RaycastMode mode, f32 &distance, ui32 &triangle);
+
+    /// @brief Will cast rays against entities.
+    /// @param[in]  entities    The entities to test.
+    /// @param[in]  rays        The rays in world space.
+    /// @param[in]  numRays     The number of rays.
+    /// @param[out] hits        The hits, one per ray.
+    /// @param[in]  mode        The hit mode.
+    /// @param[in]  maxDistance The maximal ray parameter.
+    static void cast(const cppcore::TArray<Entity *> &entities, const Common::Ray *rays, size_t numRays,
+            RayHit *hits, RaycastMode mode, f32 maxDistance);
+};
+
+} // Namespace App
+} // Namespace OSRE
@@ -25,9 +25,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Common/Logger.h"
 #include "Common/StringUtils.h"
 #include "Debugging/osre_debugging.h"
-#include "RenderBackend/MeshProcessor.h"
+#include "RenderBackend/HiZBuffer.h"
+#include "RenderBackend/Mesh.h"
 #include "RenderBackend/RenderBackendService.h"
 #include "App/CameraComponent.h"
+#include "Animation/AnimatorComponent.h"
 
 namespace OSRE::App {
 
@@ -36,12 +38,20 @@ using namespace ::OSRE::RenderBackend;
 
 DECL_OSRE_LOG_MODULE(Scene)
 
+// Sub-pixel errors are not visible, the hysteresis keeps the levels stable at the thresholds
+static constexpr f32 DefaultLodMaxPixelError = 1.0f;
+static constexpr f32 DefaultLodHysteresis = 0.25f;
+
+static constexpr c8 SceneBatchName[] = "b1";
+
 Scene::Scene(const String &worldName) :
         Object(worldName),
         mActiveCamera(nullptr),
         mRoot(nullptr),
         mPipeline(nullptr),
-        mDirtry(false) {
+        mDirtry(false),
+        mLodMaxPixelError(DefaultLodMaxPixelError),
+        mLodHysteresis(DefaultLodHysteresis) {
     // empty
 }
 
@@ -52,24 +62,14 @@ void Scene::addEntity(Entity *entity) {
     }
     mDirtry = true;
     mEntities.add(entity);
+    mDirtyEntities.add(entity);
+
+    // The first entity wins for duplicated names, the others will be found by the linear fallback
+    addToNameIndex(entity);
 }
 
 Entity *Scene::findEntity(const String &name) {
-    if (name.empty()) {
-        return nullptr;
-    }
-
-    Entity *currentEntity{ nullptr };
-    for (size_t i = 0; i < mEntities.size(); ++i) {
-        currentEntity = mEntities[i];
-        if (currentEntity != nullptr) {
-            if (currentEntity->getName() == name) {
-                return currentEntity;
-            }
-        }
-    }
-
-    return nullptr;
+    return getEntityByName(name);
 }
 
 bool Scene::removeEntity(Entity *entity) {
@@ -85,6 +85,24 @@ bool Scene::removeEntity(Entity *entity) {
         mDirtry = true;
     }
 
+    it = mDirtyEntities.linearSearch(entity);
+    if (mDirtyEntities.end() != it) {
+        mDirtyEntities.remove(it);
+    }
+
+    for (it = mMovedEntities.linearSearch(entity); mMovedEntities.end() != it; it = mMovedEntities.linearSearch(entity)) {
+        mMovedEntities.remove(it);
+    }
+    mSpatialGrid.remove(entity);
+
+    // The animator must not be evaluated after the entity has left
+    Animation::AnimatorComponent *animator = (Animation::AnimatorComponent *)entity->getComponent(ComponentType::AnimationComponentType);
+    if (animator != nullptr) {
+        mAnimationSystem.removeAnimator(animator);
+    }
+
+    removeFromNameIndex(entity, entity->getName());
+
     return found;
 }
 
@@ -116,6 +134,16 @@ Entity *Scene::getEntityByName(const String &name) const {
     }
 
     Entity *entity = nullptr;
+    if (!mEntityNameMap.getValue(StringUtils::hashName(name), entity)) {
+        return nullptr;
+    }
+
+    if (entity != nullptr && entity->getName() == name) {
+        return entity;
+    }
+
+    // Hash collision, search for the name
+    entity = nullptr;
     for (size_t i = 0; i < mEntities.size(); ++i) {
         if (nullptr != mEntities[i]) {
             if (mEntities[i]->getName() == name) {
@@ -131,6 +159,7 @@ Entity *Scene::getEntityByName(const String &name) const {
 void Scene::setSceneRoot(TransformComponent *root) {
     mRoot = root;
     mDirtry = true;
+    mDirtyEntities = mEntities;
 }
 
 void Scene::init() {
@@ -147,18 +176,23 @@ void Scene::update(Time dt) {
         updateBoundingTrees();
     }
 
+    // All animators will be evaluated at once, the entity updates will skip them
+    mAnimationSystem.update(dt);
+
     for (Entity *entity : mEntities) {
         if (nullptr != entity) {
             entity->update(dt);
         }
     }
+
+    updateSpatialGrid();
 }
 
 void Scene::render(RenderBackendService *rbSrv) {
     osre_assert(nullptr != rbSrv);
 
     rbSrv->beginPass(RenderPass::getPassNameById(RenderPassId));
-    rbSrv->beginRenderBatch("b1");
+    rbSrv->beginRenderBatch(SceneBatchName);
 
     if (mActiveCamera != nullptr) {
         mActiveCamera->render(rbSrv);
@@ -166,30 +200,238 @@ void Scene::render(RenderBackendService *rbSrv) {
 
     for (Entity *entity : mEntities) {
         if (nullptr != entity) {
-            entity->render(rbSrv);
+            renderEntity(entity, rbSrv);
         }
     }
+    updateLods(rbSrv);
+    updateOcclusion(rbSrv);
+    updateMeshlets(rbSrv);
 
     rbSrv->endRenderBatch();
+    mAnimationSystem.upload(rbSrv);
     rbSrv->endPass();
 }
 
+void Scene::renderEntity(Entity *entity, RenderBackendService *rbSrv) {
+    Animation::AnimatorComponent *animator = (Animation::AnimatorComponent *)entity->getComponent(ComponentType::AnimationComponentType);
+    const c8 *batchName = animator != nullptr ? animator->getRenderBatchName() : nullptr;
+    if (batchName == nullptr) {
+        entity->render(rbSrv);
+        return;
+    }
+
+    // The skinning palette is a uniform of the batch, so every character needs its own batch
+    rbSrv->endRenderBatch();
+    rbSrv->beginRenderBatch(batchName);
+    if (mActiveCamera != nullptr) {
+        mActiveCamera->render(rbSrv);
+    }
+    entity->render(rbSrv);
+    rbSrv->endRenderBatch();
+    rbSrv->beginRenderBatch(SceneBatchName);
+}
+
 void Scene::updateBoundingTrees() {
-    for (ui32 i = 0; i < mEntities.size(); ++i) {
-        auto *entity = mEntities[i];
+    // Only new entities need an update, the mesh bounds are cached in the meshes itself
+    for (size_t i = 0; i < mDirtyEntities.size(); ++i) {
+        Entity *entity = mDirtyEntities[i];
         if (entity == nullptr) {
             continue;
         }
-        MeshProcessor processor;
+
+        // New entities will be sorted into the grid with their final bounds
+        onEntityMoved(entity);
+
         RenderComponent *rc = (RenderComponent *)entity->getComponent(ComponentType::RenderComponentType);
-        for (ui32 j = 0; j < rc->getNumMeshes(); ++j) {
-            processor.addMesh(rc->getMeshAt(j));
+        if (rc == nullptr || 0 == rc->getNumMeshes()) {
+            continue;
         }
-        if (processor.execute()) {
-            entity->setAABB(processor.getAABB());
+
+        AABB aabb;
+        for (size_t j = 0; j < rc->getNumMeshes(); ++j) {
+            const Mesh *mesh = rc->getMeshAt(j);
+            if (mesh == nullptr) {
+                continue;
+            }
+
+            if (mesh->isLocal()) {
+                aabb.merge(mesh->getAABB().transform(mesh->getLocalMatrix()));
+            } else {
+                aabb.merge(mesh->getAABB());
+            }
+        }
+
+        if (aabb.isValid()) {
+            entity->setAABB(aabb);
         }
     }
+    mDirtyEntities.clear();
     mDirtry = false;
 }
 
+void Scene::onEntityMoved(Entity *entity) {
+    if (entity == nullptr) {
+        return;
+    }
+
+    // Duplicates are cheap to resolve, the grid only moves entities which left their cell
+    mMovedEntities.add(entity);
+}
+
+void Scene::onEntityRenamed(Entity *entity, const String &oldName) {
+    if (entity == nullptr) {
+        return;
+    }
+
+    if (mEntities.end() == mEntities.linearSearch(entity)) {
+        return;
+    }
+
+    removeFromNameIndex(entity, oldName);
+    addToNameIndex(entity);
+}
+
+void Scene::addToNameIndex(Entity *entity) {
+    const HashId hash = StringUtils::hashName(entity->getName());
+    if (!mEntityNameMap.hasKey(hash)) {
+        mEntityNameMap.insert(hash, entity);
+    }
+}
+
+void Scene::removeFromNameIndex(Entity *entity, const String &name) {
+    // Hand the index slot over to the next entity with the same hash
+    const HashId hash = StringUtils::hashName(name);
+    Entity *indexed = nullptr;
+    if (mEntityNameMap.getValue(hash, indexed) && indexed == entity) {
+        mEntityNameMap.remove(hash);
+        for (size_t i = 0; i < mEntities.size(); ++i) {
+            if (mEntities[i] != nullptr && mEntities[i] != entity && StringUtils::hashName(mEntities[i]->getName()) == hash) {
+                mEntityNameMap.insert(hash, mEntities[i]);
+                break;
+            }
+        }
+    }
+}
+
+void Scene::updateSpatialGrid() {
+    for (size_t i = 0; i < mMovedEntities.size(); ++i) {
+        Entity *entity = mMovedEntities[i];
+        if (entity != nullptr) {
+            mSpatialGrid.update(entity, entity->getWorldCenter());
+        }
+    }
+    mMovedEntities.resize(0);
+}
+
+void Scene::updateLods(RenderBackendService *rbSrv) {
+    if (mActiveCamera == nullptr) {
+        return;
+    }
+
+    const glm::vec3 &eye = mActiveCamera->getEye();
+    for (Entity *entity : mEntities) {
+        if (entity == nullptr) {
+            continue;
+        }
+
+        RenderComponent *rc = (RenderComponent *)entity->getComponent(ComponentType::RenderComponentType);
+        if (rc == nullptr) {
+            continue;
+        }
+
+        // Use the distance to the closest point of the world bounds, the eye can be inside of large models
+        const AABB aabb = entity->getWorldAABB();
+        f32 distance = 0.0f;
+        if (aabb.isValid()) {
+            const glm::vec3 closest = glm::clamp(eye, aabb.getMin(), aabb.getMax());
+            distance = glm::length(eye - closest);
+        }
+
+        // The errors of the levels are stored in mesh units, so they grow with the world scale
+        const f32 pixelsPerUnit = mActiveCamera->getScreenSize(1.0f, distance) * entity->getWorldScale();
+
+        for (size_t i = 0; i < rc->getNumMeshes(); ++i) {
+            Mesh *mesh = rc->getMeshAt(i);
+            if (mesh == nullptr || mesh->getNumLods() < 2) {
+                continue;
+            }
+
+            const size_t lod = mesh->selectLod(pixelsPerUnit, mLodMaxPixelError, mLodHysteresis);
+            if (mesh->setActiveLod(lod)) {
+                rbSrv->updateMeshPrimitives(mesh);
+            }
+        }
+    }
+}
+
+void Scene::updateOcclusion(RenderBackendService *rbSrv) {
+    Pipeline *pipeline = rbSrv->getActivePipeline();
+    if (pipeline == nullptr) {
+        return;
+    }
+
+    const HiZBuffer *occlusionBuffer = pipeline->getOcclusionBuffer();
+    if (occlusionBuffer == nullptr) {
+        return;
+    }
+
+    // The buffer contains the depth of the last frame, without one all meshes must be drawn
+    const bool valid = occlusionBuffer->isValid();
+    for (Entity *entity : mEntities) {
+        if (entity == nullptr) {
+            continue;
+        }
+
+        RenderComponent *rc = (RenderComponent *)entity->getComponent(ComponentType::RenderComponentType);
+        if (rc == nullptr) {
+            continue;
+        }
+
+        const bool visible = !valid || occlusionBuffer->isVisible(entity->getWorldAABB());
+        for (size_t i = 0; i < rc->getNumMeshes(); ++i) {
+            Mesh *mesh = rc->getMeshAt(i);
+            if (mesh != nullptr && mesh->setVisible(visible)) {
+                rbSrv->updateMeshPrimitives(mesh);
+            }
+        }
+    }
+}
+
+void Scene::updateMeshlets(RenderBackendService *rbSrv) {
+    if (mActiveCamera == nullptr) {
+        return;
+    }
+
+    const glm::mat4 viewProjection = mActiveCamera->getProjection() * mActiveCamera->getView();
+    const glm::vec4 eye(mActiveCamera->getEye(), 1.0f);
+    for (Entity *entity : mEntities) {
+        if (entity == nullptr) {
+            continue;
+        }
+
+        RenderComponent *rc = (RenderComponent *)entity->getComponent(ComponentType::RenderComponentType);
+        if (rc == nullptr) {
+            continue;
+        }
+
+        const glm::mat4 world = entity->getNode() != nullptr ? entity->getNode()->getWorlTransformMatrix() : glm::mat4(1.0f);
+        for (size_t i = 0; i < rc->getNumMeshes(); ++i) {
+            Mesh *mesh = rc->getMeshAt(i);
+            if (mesh == nullptr || !mesh->isVisible() || mesh->getMeshlets().isEmpty()) {
+                continue;
+            }
+
+            // The meshlet bounds are stored in mesh-local space, so the view is moved into it
+            const glm::mat4 model = mesh->isLocal() ? world * mesh->getLocalMatrix() : world;
+            Frustum frustum;
+            frustum.extractFrom(viewProjection * model);
+            const glm::vec3 localEye = glm::vec3(glm::inverse(model) * eye);
+            if (mesh->cullMeshlets(frustum, localEye)) {
+                rbSrv->updateMeshIndices(mesh);
+                rbSrv->updateMeshPrimitives(mesh);
+            }
+        }
+    }
+}
+
 } // namespace OSRE::App
\ No newline at end of file
@@ -22,7 +22,10 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #pragma once
 
+#include "Animation/AnimationSystem.h"
 #include "App/AppCommon.h"
+#include "App/Raycaster.h"
+#include "App/SpatialGrid.h"
 
 #include "Common/Object.h"
 #include "Common/Ids.h"
@@ -30,6 +33,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <cppcore/Container/TArray.h>
 #include <cppcore/Container/THashMap.h>
 
+#include <limits>
+
 namespace OSRE {
 namespace App {
 
@@ -71,7 +76,7 @@ public:
     /// @return The entity instance or nullptr for invalid indices.
     Entity *getEntityAt(size_t index) const;
 
-    /// @brief Will search, if the entity is already part of the world instance.
+    /// @brief Will search, if the entity is already part of the world instance, the lookup uses a hash index.
     /// @param[in] name  The entity name to look for.
     /// @return A pointer showing ot the entity or nullptr, if nothing was found.
     Entity *findEntity(const String &name);
@@ -111,18 +116,102 @@ public:
     /// @brief  Will return the id container.
     /// @return The Id container.    
     Common::Ids &getIds();
-    
+
+    /// @brief  Will set the parameters for the level of detail selection.
+    /// @param[in] maxPixelError  The maximal accepted screen space error in pixels.
+    /// @param[in] hysteresis     The relative margin the error must fall below before switching to a coarser level.
+    void setLodParameters(f32 maxPixelError, f32 hysteresis);
+
+    /// @brief  Will collect all entities, which are located in the sphere.
+    /// @param[in]  center  The center of the sphere.
+    /// @param[in]  radius  The radius of the sphere.
+    /// @param[out] result  The found entities will be added.
+    void queryRadius(const glm::vec3 &center, f32 radius, cppcore::TArray<Entity *> &result) const;
+
+    /// @brief  Will collect all entities, which are located in the box.
+    /// @param[in]  box     The box in world space.
+    /// @param[out] result  The found entities will be added.
+    void queryBox(const Common::AABB &box, cppcore::TArray<Entity *> &result) const;
+
+    /// @brief  Will cast a ray against the triangles of all entities.
+    /// @param[in]  ray         The ray in world space.
+    /// @param[out] hit         The hit description.
+    /// @param[in]  mode        The hit mode, closest hit or any hit.
+    /// @param[in]  maxDistance The maximal ray parameter.
+    /// @return true, if something was hit.
+    bool raycast(const Common::Ray &ray, RayHit &hit, RaycastMode mode = RaycastMode::ClosestHit,
+            f32 maxDistance = std::numeric_limits<f32>::max()) const;
+
+    /// @brief  Will cast a batch of rays, the rays will be tested in packets against the entity bounds.
+    /// @param[in]  rays        The rays in world space.
+    /// @param[in]  numRays     The number of rays.
+    /// @param[out] hits        The hit descriptions, one per ray.
+    /// @param[in]  mode        The hit mode, closest hit or any hit.
+    /// @param[in]  maxDistance The maximal ray parameter.
+    void raycastBatch(const Common::Ray *rays, size_t numRays, RayHit *hits, RaycastMode mode = RaycastMode::ClosestHit,
+            f32 maxDistance = std::numeric_limits<f32>::max()) const;
+
+    /// @brief  Will set the cell size of the spatial grid used for the queries.
+    /// @param[in] cellSize The edge length of one cell.
+    void setSpatialCellSize(f32 cellSize);
+
+    /// @brief  Will return the animation system, which evaluates all animators of the scene.
+    /// @return The animation system.
+    Animation::AnimationSystem &getAnimationSystem();
+
+    /// @brief  Will be called by entities, when their transformation was changed.
+    /// @param[in] entity   The moved entity.
+    void onEntityMoved(Entity *entity);
+
+    /// @brief  Will be called by entities, when they were renamed.
+    /// @param[in] entity   The renamed entity.
+    /// @param[in] oldName  The name before the rename.
+    void onEntityRenamed(Entity *entity, const String &oldName);
+
 protected:
-    /// @brief Will update the whole bounding boxc hierarchy.
+    /// @brief Will render an entity, skinned entities will be rendered into the batch of their animator.
+    /// @param[in] entity     The entity to render.
+    /// @param[in] rbService  The renderbackend.
+    void renderEntity(Entity *entity, RenderBackend::RenderBackendService *rbService);
+
+    /// @brief Will update the bounding boxes of all entities, which were added or marked as dirty.
     void updateBoundingTrees();
 
+    /// @brief Will update the position of all moved entities in the spatial grid.
+    void updateSpatialGrid();
+
+    /// @brief Will select the level of detail of all meshes by their screen space error in the active camera.
+    /// @param[in] rbService  The renderbackend.
+    void updateLods(RenderBackend::RenderBackendService *rbService);
+
+    /// @brief Will hide all meshes, which were occluded in the depth of the last frame.
+    /// @param[in] rbService  The renderbackend.
+    void updateOcclusion(RenderBackend::RenderBackendService *rbService);
+
+    /// @brief Will cull the meshlets of all visible meshes against the view of the active camera.
+    /// @param[in] rbService  The renderbackend.
+    void updateMeshlets(RenderBackend::RenderBackendService *rbService);
+
 private:
+    void addToNameIndex(Entity *entity);
+    void removeFromNameIndex(Entity *entity, const String &name);
+
+private:
+    using EntityNameMap = cppcore::THashMap<HashId, Entity *>;
+
     cppcore::TArray<Entity*> mEntities;
+    cppcore::TArray<Entity*> mDirtyEntities;
+    cppcore::TArray<Entity*> mMovedEntities;
+    EntityNameMap mEntityNameMap;
+    SpatialGrid mSpatialGrid;
+    Animation::AnimationSystem mAnimationSystem;
     CameraComponent *mActiveCamera;
     TransformComponent *mRoot;
     Common::Ids mIds;
     RenderBackend::Pipeline *mPipeline;
     bool mDirtry;
+    f32 mLodMaxPixelError;
+    f32 mLodHysteresis;
 };
 
 inline TransformComponent *Scene::getRootNode() const {
@@ -133,10 +222,40 @@ inline const cppcore::TArray<Entity *> &Scene::getEntityArray() const {
     return mEntities;
 }
 
+inline Animation::AnimationSystem &Scene::getAnimationSystem() {
+    return mAnimationSystem;
+}
+
 inline Common::Ids &Scene::getIds() {
     return mIds;
 }
 
+inline void Scene::queryRadius(const glm::vec3 &center, f32 radius, cppcore::TArray<Entity *> &result) const {
+    mSpatialGrid.queryRadius(center, radius, result);
+}
+
+inline void Scene::queryBox(const Common::AABB &box, cppcore::TArray<Entity *> &result) const {
+    mSpatialGrid.queryBox(box, result);
+}
+
+inline bool Scene::raycast(const Common::Ray &ray, RayHit &hit, RaycastMode mode, f32 maxDistance) const {
+    Raycaster::cast(mEntities, &ray, 1, &hit, mode, maxDistance);
+    return hit.hasHit();
+}
+
+inline void Scene::raycastBatch(const Common::Ray *rays, size_t numRays, RayHit *hits, RaycastMode mode, f32 maxDistance) const {
+    Raycaster::cast(mEntities, rays, numRays, hits, mode, maxDistance);
+}
+
+inline void Scene::setSpatialCellSize(f32 cellSize) {
+    mSpatialGrid.setCellSize(cellSize);
+}
+
+inline void Scene::setLodParameters(f32 maxPixelError, f32 hysteresis) {
+    mLodMaxPixelError = maxPixelError;
+    mLodHysteresis = hysteresis;
+}
+
 } // Namespace App
 } // Namespace OSRE
 
@@ -0,0 +1,286 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "App/SharedAssetCache.h"
+#include "App/AssetRegistry.h"
+#include "Common/Logger.h"
+#include "IO/MemoryMappedFile.h"
+#include "IO/Uri.h"
+#include "RenderBackend/Material.h"
+#include "RenderBackend/Mesh.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace OSRE::App {
+
+using namespace ::OSRE::Common;
+using namespace ::OSRE::RenderBackend;
+
+DECL_OSRE_LOG_MODULE(SharedAssetCache)
+
+namespace {
+
+static bool isEqual(BufferData *buffer, const void *data, size_t size) {
+    if (nullptr == buffer || buffer->getSize() != size) {
+        return false;
+    }
+
+    return 0 == size || 0 == ::memcmp(buffer->getData(), data, size);
+}
+
+// Only the defined colors and parameters are compared, the name does not change the appearance
+static bool isEqual(const MaterialDesc &lhs, const MaterialDesc &rhs) {
+    if (lhs.Type != rhs.Type || lhs.ColorMask != rhs.ColorMask || lhs.ParameterMask != rhs.ParameterMask ||
+            lhs.Textures.size() != rhs.Textures.size()) {
+        return false;
+    }
+
+    for (size_t i = 0; i < lhs.Textures.size(); ++i) {
+        if (lhs.Textures[i].Name != rhs.Textures[i].Name || lhs.Textures[i].Stage != rhs.Textures[i].Stage) {
+            return false;
+        }
+    }
+    for (ui32 i = 0; i < MaxMatColorType; ++i) {
+        if (0 != (lhs.ColorMask & (1u << i)) && !(lhs.Colors[i] == rhs.Colors[i])) {
+            return false;
+        }
+    }
+    for (ui32 i = 0; i < static_cast<ui32>(MaterialParameterType::Count); ++i) {
+        if (0 != (lhs.ParameterMask & (1u << i)) && lhs.Parameters[i] != rhs.Parameters[i]) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static ui64 computeMaterialKey(const MaterialDesc &desc) {
+    const i32 type = static_cast<i32>(desc.Type);
+    ui64 key = MeshCache::hashData(&type, sizeof(type));
+    key = MeshCache::hashData(&desc.ColorMask, sizeof(desc.ColorMask), key);
+    key = MeshCache::hashData(&desc.ParameterMask, sizeof(desc.ParameterMask), key);
+    for (size_t i = 0; i < desc.Textures.size(); ++i) {
+        const MaterialTextureDesc &texture = desc.Textures[i];
+        const i32 stage = static_cast<i32>(texture.Stage);
+        key = MeshCache::hashData(texture.Name.c_str(), texture.Name.size(), key);
+        key = MeshCache::hashData(&stage, sizeof(stage), key);
+    }
+    for (ui32 i = 0; i < MaxMatColorType; ++i) {
+        if (0 != (desc.ColorMask & (1u << i))) {
+            const Color4 &color = desc.Colors[i];
+            const f32 rgba[4] = { color.m_r, color.m_g, color.m_b, color.m_a };
+            key = MeshCache::hashData(rgba, sizeof(rgba), key);
+        }
+    }
+    for (ui32 i = 0; i < static_cast<ui32>(MaterialParameterType::Count); ++i) {
+        if (0 != (desc.ParameterMask & (1u << i))) {
+            key = MeshCache::hashData(&desc.Parameters[i], sizeof(f32), key);
+        }
+    }
+
+    return key;
+}
+
+} // namespace
+
+SharedAssetCache &SharedAssetCache::getInstance() {
+    static SharedAssetCache cache;
+    return cache;
+}
+
+SharedAssetCache::~SharedAssetCache() {
+    for (size_t i = 0; i < mOwnedTextures.size(); ++i) {
+        delete mOwnedTextures[i];
+    }
+}
+
+ui64 SharedAssetCache::computeMeshKey(VertexType vertexType, IndexType indexType, const void *vertices, size_t vbSize,
+        const void *indices, size_t ibSize) {
+    const i32 types[2] = { static_cast<i32>(vertexType), static_cast<i32>(indexType) };
+    ui64 key = MeshCache::hashData(types, sizeof(types));
+    key = MeshCache::hashData(vertices, vbSize, key);
+
+    return MeshCache::hashData(indices, ibSize, key);
+}
+
+Mesh *SharedAssetCache::findMesh(ui64 key, VertexType vertexType, IndexType indexType, const void *vertices, size_t vbSize,
+        const void *indices, size_t ibSize) const {
+    // Different meshes can have the same key, so the buffers are compared
+    const auto range = mMeshes.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        Mesh *mesh = it->second;
+        if (mesh->getVertexType() == vertexType && mesh->getIndexType() == indexType &&
+                isEqual(mesh->getVertexBuffer(), vertices, vbSize) && isEqual(mesh->getIndexBuffer(), indices, ibSize)) {
+            return mesh;
+        }
+    }
+
+    return nullptr;
+}
+
+void SharedAssetCache::addMesh(ui64 key, Mesh *mesh) {
+    if (nullptr == mesh || nullptr == mesh->getVertexBuffer() || nullptr == mesh->getIndexBuffer()) {
+        return;
+    }
+
+    mMeshes.insert(std::make_pair(key, mesh));
+    ++mStatistics.NumMeshes;
+}
+
+bool SharedAssetCache::shareBuffers(Mesh *mesh, Mesh *source) {
+    if (nullptr == mesh || nullptr == source || !mesh->shareVertexBuffer(source) || !mesh->shareIndexBuffer(source)) {
+        return false;
+    }
+    ++mStatistics.NumSharedMeshes;
+
+    return true;
+}
+
+bool SharedAssetCache::shareMesh(Mesh *mesh) {
+    if (nullptr == mesh || nullptr == mesh->getVertexBuffer() || nullptr == mesh->getIndexBuffer()) {
+        return false;
+    }
+
+    BufferData *vb = mesh->getVertexBuffer();
+    BufferData *ib = mesh->getIndexBuffer();
+    const ui64 key = computeMeshKey(mesh->getVertexType(), mesh->getIndexType(), vb->getData(), vb->getSize(), ib->getData(), ib->getSize());
+    Mesh *source = findMesh(key, mesh->getVertexType(), mesh->getIndexType(), vb->getData(), vb->getSize(), ib->getData(), ib->getSize());
+    if (source == mesh) {
+        return false;
+    }
+
+    if (nullptr == source) {
+        addMesh(key, mesh);
+        return false;
+    }
+
+    return shareBuffers(mesh, source);
+}
+
+const String &SharedAssetCache::getTextureName(const String &name) {
+    auto it = mTextureNames.find(name);
+    if (mTextureNames.end() != it) {
+        return it->second;
+    }
+
+    // Textures which cannot be read are identified by their name
+    String sharedName = name;
+    IO::MemoryMappedFile file;
+    if (file.open(AssetRegistry::resolvePathFromUri(IO::Uri(name)))) {
+        const ui64 key = MeshCache::hashData(file.getData(), file.getSize());
+        auto content = mTextureContents.find(key);
+        if (mTextureContents.end() != content) {
+            sharedName = content->second;
+            ++mStatistics.NumSharedTextures;
+        } else {
+            mTextureContents[key] = name;
+            ++mStatistics.NumTextures;
+        }
+    } else {
+        ++mStatistics.NumTextures;
+    }
+
+    return mTextureNames[name] = sharedName;
+}
+
+TextureResource *SharedAssetCache::getTextureResource(const String &name) {
+    const String &sharedName = getTextureName(name);
+    auto it = mTextureResources.find(sharedName);
+    if (mTextureResources.end() != it) {
+        return it->second;
+    }
+
+    auto *texRes = new TextureResource(sharedName, IO::Uri(sharedName));
+    mTextureResources[sharedName] = texRes;
+    mOwnedTextures.add(texRes);
+
+    return texRes;
+}
+
+bool SharedAssetCache::addTextureResource(const String &name, ui64 key, TextureResource *texRes) {
+    if (nullptr == texRes || mTextureNames.end() != mTextureNames.find(name)) {
+        return false;
+    }
+
+    auto content = mTextureContents.find(key);
+    if (mTextureContents.end() != content) {
+        mTextureNames[name] = content->second;
+        ++mStatistics.NumSharedTextures;
+        return false;
+    }
+
+    mTextureContents[key] = name;
+    mTextureNames[name] = name;
+    mTextureResources[name] = texRes;
+    mOwnedTextures.add(texRes);
+    ++mStatistics.NumTextures;
+
+    return true;
+}
+
+Material *SharedAssetCache::getMaterial(const MaterialDesc &desc) {
+    MaterialDesc sharedDesc = desc;
+    for (size_t i = 0; i < sharedDesc.Textures.size(); ++i) {
+        sharedDesc.Textures[i].Name = getTextureName(sharedDesc.Textures[i].Name);
+    }
+
+    const ui64 key = computeMaterialKey(sharedDesc);
+    const auto range = mMaterials.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (isEqual(it->second.Desc, sharedDesc)) {
+            ++mStatistics.NumSharedMaterials;
+            return it->second.Instance;
+        }
+    }
+
+    // The material builder caches by name, so another content needs another name
+    if (mMaterialNames.end() != mMaterialNames.find(sharedDesc.Name)) {
+        c8 suffix[32];
+        ::snprintf(suffix, sizeof(suffix), "_%016llx", static_cast<unsigned long long>(key));
+        sharedDesc.Name += suffix;
+    }
+
+    Material *material = sharedDesc.create(this);
+    if (nullptr == material) {
+        osre_debug(Tag, "Cannot create the shared material " + sharedDesc.Name);
+        return nullptr;
+    }
+
+    mMaterialNames.insert(sharedDesc.Name);
+    mMaterials.insert(std::make_pair(key, MaterialEntry{ sharedDesc, material }));
+    ++mStatistics.NumMaterials;
+
+    return material;
+}
+
+void SharedAssetCache::clear() {
+    mMeshes.clear();
+    mTextureNames.clear();
+    mTextureContents.clear();
+    mTextureResources.clear();
+    mMaterials.clear();
+    mMaterialNames.clear();
+    mStatistics = Statistics();
+}
+
+} // namespace OSRE::App
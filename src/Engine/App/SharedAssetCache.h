@@ -0,0 +1,163 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "App/MeshCache.h"
+#include "RenderBackend/RenderCommon.h"
+
+#include <map>
+#include <set>
+
+namespace OSRE {
+
+namespace RenderBackend {
+    class Mesh;
+    class Material;
+}
+
+namespace App {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class deduplicates the geometry, the textures and the materials of imported models.
+///
+/// All assets are identified by a hash of their content. An imported mesh with the same buffers as
+/// a registered one will use its vertex- and index-buffers, so the backend uploads them only once.
+/// Texture references are resolved to the first file with the same content, and materials with the
+/// same description share one material instance. The cache is not thread-safe, use it on the main
+/// thread.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT SharedAssetCache {
+public:
+    /// @brief The number of unique assets and of the references resolved to them.
+    struct Statistics {
+        ui32 NumMeshes = 0;             ///< The registered meshes.
+        ui32 NumSharedMeshes = 0;       ///< The meshes which are using the buffers of a registered one.
+        ui32 NumTextures = 0;           ///< The unique textures.
+        ui32 NumSharedTextures = 0;     ///< The texture names resolved to a texture with the same content.
+        ui32 NumMaterials = 0;          ///< The unique materials.
+        ui32 NumSharedMaterials = 0;    ///< The material requests answered with an existing material.
+    };
+
+    /// @brief Will return the cache shared by all imports.
+    /// @return The shared cache.
+    static SharedAssetCache &getInstance();
+
+    /// @brief The default class constructor.
+    SharedAssetCache() = default;
+
+    /// @brief The class destructor, will release the texture resources.
+    ~SharedAssetCache();
+
+    /// @brief Will compute the content key of mesh buffers.
+    /// @param[in] vertexType   The vertex type.
+    /// @param[in] indexType    The index type.
+    /// @param[in] vertices     The vertex data.
+    /// @param[in] vbSize       The size of the vertex data in bytes.
+    /// @param[in] indices      The index data.
+    /// @param[in] ibSize       The size of the index data in bytes.
+    /// @return The key.
+    static ui64 computeMeshKey(RenderBackend::VertexType vertexType, RenderBackend::IndexType indexType,
+            const void *vertices, size_t vbSize, const void *indices, size_t ibSize);
+
+    /// @brief Will look up a registered mesh with the same buffers, the content is compared.
+    /// @param[in] key          The content key.
+    /// @param[in] vertexType   The vertex type.
+    /// @param[in] indexType    The index type.
+    /// @param[in] vertices     The vertex data.
+    /// @param[in] vbSize       The size of the vertex data in bytes.
+    /// @param[in] indices      The index data.
+    /// @param[in] ibSize       The size of the index data in bytes.
+    /// @return The registered mesh or nullptr.
+    RenderBackend::Mesh *findMesh(ui64 key, RenderBackend::VertexType vertexType, RenderBackend::IndexType indexType,
+            const void *vertices, size_t vbSize, const void *indices, size_t ibSize) const;
+
+    /// @brief Will register a mesh, later meshes with the same content can use its buffers.
+    /// @param[in] key      The content key.
+    /// @param[in] mesh     The mesh, must stay valid as long as it is registered.
+    void addMesh(ui64 key, RenderBackend::Mesh *mesh);
+
+    /// @brief Will let the mesh use the buffers of a registered mesh.
+    /// @param[in] mesh     The mesh.
+    /// @param[in] source   The registered mesh.
+    /// @return true, if successful.
+    bool shareBuffers(RenderBackend::Mesh *mesh, RenderBackend::Mesh *source);
+
+    /// @brief Will let the mesh use the buffers of an identical registered mesh, or register it.
+    /// @param[in] mesh     The mesh with its vertex- and index-buffer.
+    /// @return true, if the mesh is using the buffers of another mesh now.
+    bool shareMesh(RenderBackend::Mesh *mesh);
+
+    /// @brief Will return the name of the first texture with the same file content.
+    /// @param[in] name     The texture name, used as the uri.
+    /// @return The name of the shared texture, the name itself if the file cannot be read.
+    const String &getTextureName(const String &name);
+
+    /// @brief Will return the texture resource for a texture, it is created once per content.
+    /// @param[in] name     The texture name, used as the uri.
+    /// @return The texture resource, owned by the cache.
+    RenderBackend::TextureResource *getTextureResource(const String &name);
+
+    /// @brief Will register a texture which was loaded from memory, like an image embedded in a model.
+    /// @param[in] name     The texture name used by the materials.
+    /// @param[in] key      The content key, the hash of the encoded image or of the pixels.
+    /// @param[in] texRes   The loaded texture resource.
+    /// @return true, if the cache has taken the ownership of the resource. false, if the name is known
+    /// already or another texture has the same content, the name is resolved to it then.
+    bool addTextureResource(const String &name, ui64 key, RenderBackend::TextureResource *texRes);
+
+    /// @brief Will return the material for a description, it is created once per content.
+    /// @param[in] desc     The material description.
+    /// @return The material or nullptr in case of an error.
+    RenderBackend::Material *getMaterial(const MaterialDesc &desc);
+
+    /// @brief Will forget all registered assets, the created ones stay valid.
+    void clear();
+
+    /// @brief Will return the statistics.
+    /// @return The statistics.
+    const Statistics &getStatistics() const;
+
+private:
+    struct MaterialEntry {
+        MaterialDesc Desc;
+        RenderBackend::Material *Instance;
+    };
+
+    std::multimap<ui64, RenderBackend::Mesh *> mMeshes;
+    std::map<String, String> mTextureNames;
+    std::map<ui64, String> mTextureContents;
+    std::map<String, RenderBackend::TextureResource *> mTextureResources;
+    cppcore::TArray<RenderBackend::TextureResource *> mOwnedTextures;
+    std::multimap<ui64, MaterialEntry> mMaterials;
+    std::set<String> mMaterialNames;
+    Statistics mStatistics;
+};
+
+inline const SharedAssetCache::Statistics &SharedAssetCache::getStatistics() const {
+    return mStatistics;
+}
+
+} // Namespace App
+} // Namespace OSRE
@@ -0,0 +1,218 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "App/SpatialGrid.h"
+#include "Debugging/osre_debugging.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace OSRE::App {
+
+using namespace ::OSRE::Common;
+
+// 21 bits per axis, so the three cell coordinates can be packed into one key
+static constexpr i32 MaxCellCoord = (1 << 20) - 1;
+static constexpr i32 MinCellCoord = -(1 << 20);
+
+SpatialGrid::SpatialGrid(f32 cellSize) :
+        mCellSize(cellSize > 0.0f ? cellSize : DefaultCellSize),
+        mCells(),
+        mEntries() {
+    // empty
+}
+
+void SpatialGrid::setCellSize(f32 cellSize) {
+    if (cellSize <= 0.0f || cellSize == mCellSize) {
+        return;
+    }
+
+    cppcore::TArray<CellItem> items;
+    for (const auto &cell : mCells) {
+        for (size_t i = 0; i < cell.second.size(); ++i) {
+            items.add(cell.second[i]);
+        }
+    }
+
+    clear();
+    mCellSize = cellSize;
+    for (size_t i = 0; i < items.size(); ++i) {
+        update(items[i].mEntity, items[i].mPos);
+    }
+}
+
+void SpatialGrid::update(Entity *entity, const glm::vec3 &pos) {
+    if (entity == nullptr) {
+        return;
+    }
+
+    const CellKey key = getKey(pos);
+    auto it = mEntries.find(entity);
+    if (it != mEntries.end()) {
+        if (it->second == key) {
+            // Still in the same cell, only the position changes
+            Cell &cell = mCells[key];
+            for (size_t i = 0; i < cell.size(); ++i) {
+                if (cell[i].mEntity == entity) {
+                    cell[i].mPos = pos;
+                    return;
+                }
+            }
+            osre_assert(false);
+        }
+        removeFromCell(it->second, entity);
+        it->second = key;
+    } else {
+        mEntries[entity] = key;
+    }
+
+    mCells[key].add({ entity, pos });
+}
+
+bool SpatialGrid::remove(Entity *entity) {
+    auto it = mEntries.find(entity);
+    if (it == mEntries.end()) {
+        return false;
+    }
+
+    removeFromCell(it->second, entity);
+    mEntries.erase(it);
+
+    return true;
+}
+
+bool SpatialGrid::contains(Entity *entity) const {
+    return mEntries.find(entity) != mEntries.end();
+}
+
+void SpatialGrid::queryBox(const AABB &box, cppcore::TArray<Entity *> &result) const {
+    if (!box.isValid()) {
+        return;
+    }
+
+    const glm::vec3 &min = box.getMin();
+    const glm::vec3 &max = box.getMax();
+    query(min, max, [&min, &max](const glm::vec3 &pos) {
+        return pos.x >= min.x && pos.y >= min.y && pos.z >= min.z && pos.x <= max.x && pos.y <= max.y && pos.z <= max.z;
+    }, result);
+}
+
+void SpatialGrid::queryRadius(const glm::vec3 &center, f32 radius, cppcore::TArray<Entity *> &result) const {
+    if (radius < 0.0f) {
+        return;
+    }
+
+    const f32 radiusSq = radius * radius;
+    const glm::vec3 extent(radius);
+    query(center - extent, center + extent, [&center, radiusSq](const glm::vec3 &pos) {
+        const glm::vec3 d = pos - center;
+        return glm::dot(d, d) <= radiusSq;
+    }, result);
+}
+
+void SpatialGrid::clear() {
+    mCells.clear();
+    mEntries.clear();
+}
+
+i32 SpatialGrid::getCellCoord(f32 value) const {
+    const f32 coord = std::floor(value / mCellSize);
+    if (!(coord > static_cast<f32>(MinCellCoord))) {
+        return MinCellCoord;
+    }
+    if (coord > static_cast<f32>(MaxCellCoord)) {
+        return MaxCellCoord;
+    }
+
+    return static_cast<i32>(coord);
+}
+
+SpatialGrid::CellKey SpatialGrid::getKey(const glm::vec3 &pos) const {
+    return getKey(getCellCoord(pos.x), getCellCoord(pos.y), getCellCoord(pos.z));
+}
+
+SpatialGrid::CellKey SpatialGrid::getKey(i32 x, i32 y, i32 z) {
+    constexpr CellKey Mask = (1u << 21) - 1;
+    const CellKey kx = static_cast<CellKey>(x - MinCellCoord) & Mask;
+    const CellKey ky = static_cast<CellKey>(y - MinCellCoord) & Mask;
+    const CellKey kz = static_cast<CellKey>(z - MinCellCoord) & Mask;
+
+    return kx | (ky << 21) | (kz << 42);
+}
+
+void SpatialGrid::removeFromCell(CellKey key, Entity *entity) {
+    auto it = mCells.find(key);
+    if (it == mCells.end()) {
+        return;
+    }
+
+    Cell &cell = it->second;
+    for (size_t i = 0; i < cell.size(); ++i) {
+        if (cell[i].mEntity == entity) {
+            cell.remove(i);
+            break;
+        }
+    }
+
+    if (cell.isEmpty()) {
+        mCells.erase(it);
+    }
+}
+
+template<class TTest>
+void SpatialGrid::query(const glm::vec3 &min, const glm::vec3 &max, TTest test, cppcore::TArray<Entity *> &result) const {
+    const i32 x0 = getCellCoord(min.x), x1 = getCellCoord(max.x);
+    const i32 y0 = getCellCoord(min.y), y1 = getCellCoord(max.y);
+    const i32 z0 = getCellCoord(min.z), z1 = getCellCoord(max.z);
+    const d32 numCells = static_cast<d32>(x1 - x0 + 1) * static_cast<d32>(y1 - y0 + 1) * static_cast<d32>(z1 - z0 + 1);
+
+    // Large queries are cheaper by walking the occupied cells than by probing empty ones
+    if (numCells > static_cast<d32>(mCells.size())) {
+        for (const auto &cell : mCells) {
+            for (size_t i = 0; i < cell.second.size(); ++i) {
+                if (test(cell.second[i].mPos)) {
+                    result.add(cell.second[i].mEntity);
+                }
+            }
+        }
+        return;
+    }
+
+    for (i32 z = z0; z <= z1; ++z) {
+        for (i32 y = y0; y <= y1; ++y) {
+            for (i32 x = x0; x <= x1; ++x) {
+                auto it = mCells.find(getKey(x, y, z));
+                if (it == mCells.end()) {
+                    continue;
+                }
+                const Cell &cell = it->second;
+                for (size_t i = 0; i < cell.size(); ++i) {
+                    if (test(cell[i].mPos)) {
+                        result.add(cell[i].mEntity);
+                    }
+                }
+            }
+        }
+    }
+}
+
+} // namespace OSRE::App
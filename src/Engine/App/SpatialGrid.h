@@ -0,0 +1,134 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "App/AppCommon.h"
+#include "Common/glm_common.h"
+#include "Common/TAABB.h"
+
+#include <cppcore/Container/TArray.h>
+
+#include <unordered_map>
+
+namespace OSRE {
+namespace App {
+
+// Forward declarations ---------------------------------------------------------------------------
+class Entity;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a uniform grid to look up entities by their position.
+///
+/// Each entity is stored in the cell containing its position, only the occupied cells will be
+/// allocated. Moving an entity only touches the grid when it leaves its cell. Queries visit the
+/// overlapped cells and test the stored positions, so the cell size should be in the range of
+/// the typical query size.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT SpatialGrid {
+public:
+    /// @brief The default cell size.
+    static constexpr f32 DefaultCellSize = 10.0f;
+
+    /// @brief The class constructor.
+    /// @param[in] cellSize     The edge length of one cell.
+    explicit SpatialGrid(f32 cellSize = DefaultCellSize);
+
+    /// @brief The class destructor.
+    ~SpatialGrid() = default;
+
+    /// @brief Will change the cell size, all entities will be sorted in again.
+    /// @param[in] cellSize     The new edge length of one cell, must be greater than zero.
+    void setCellSize(f32 cellSize);
+
+    /// @brief Will return the cell size.
+    /// @return The edge length of one cell.
+    f32 getCellSize() const;
+
+    /// @brief Will add an entity or move it, when it is already part of the grid.
+    /// @param[in] entity       The entity.
+    /// @param[in] pos          The position of the entity.
+    void update(Entity *entity, const glm::vec3 &pos);
+
+    /// @brief Will remove an entity.
+    /// @param[in] entity       The entity to remove.
+    /// @return true, if the entity was found, false if not.
+    bool remove(Entity *entity);
+
+    /// @brief Will check if the entity is stored in the grid.
+    /// @param[in] entity       The entity to look for.
+    /// @return true, if stored.
+    bool contains(Entity *entity) const;
+
+    /// @brief Will collect all entities with a position in the box.
+    /// @param[in]  box         The box to look into.
+    /// @param[out] result      The found entities will be added.
+    void queryBox(const Common::AABB &box, cppcore::TArray<Entity *> &result) const;
+
+    /// @brief Will collect all entities with a position in the sphere.
+    /// @param[in]  center      The center of the sphere.
+    /// @param[in]  radius      The radius of the sphere.
+    /// @param[out] result      The found entities will be added.
+    void queryRadius(const glm::vec3 &center, f32 radius, cppcore::TArray<Entity *> &result) const;
+
+    /// @brief Will return the number of stored entities.
+    /// @return The number of entities.
+    size_t size() const;
+
+    /// @brief Will remove all entities.
+    void clear();
+
+private:
+    using CellKey = ui64;
+
+    struct CellItem {
+        Entity *mEntity;
+        glm::vec3 mPos;
+    };
+    using Cell = cppcore::TArray<CellItem>;
+
+    i32 getCellCoord(f32 value) const;
+    CellKey getKey(const glm::vec3 &pos) const;
+    static CellKey getKey(i32 x, i32 y, i32 z);
+    void removeFromCell(CellKey key, Entity *entity);
+
+    template<class TTest>
+    void query(const glm::vec3 &min, const glm::vec3 &max, TTest test, cppcore::TArray<Entity *> &result) const;
+
+private:
+    f32 mCellSize;
+    std::unordered_map<CellKey, Cell> mCells;
+    std::unordered_map<Entity *, CellKey> mEntries;
+};
+
+inline f32 SpatialGrid::getCellSize() const {
+    return mCellSize;
+}
+
+inline size_t SpatialGrid::size() const {
+    return mEntries.size();
+}
+
+} // Namespace App
+} // Namespace OSRE
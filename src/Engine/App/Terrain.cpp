@@ -0,0 +1,497 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "App/Terrain.h"
+#include "Common/Logger.h"
+#include "RenderBackend/MaterialBuilder.h"
+#include "RenderBackend/Mesh.h"
+#include "RenderBackend/RenderBackendService.h"
+#include "Threading/WorkerPool.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace OSRE::App {
+
+using namespace ::OSRE::Common;
+using namespace ::OSRE::RenderBackend;
+using namespace ::OSRE::Threading;
+
+DECL_OSRE_LOG_MODULE(Terrain)
+
+// The chunk vertices are addressed by 16 bit indices
+static constexpr ui32 MaxChunkSize = 250u;
+
+// The node coordinates are stored with 28 bits per axis in the key
+static constexpr ui32 MaxLods = 16u;
+
+TerrainDesc::TerrainDesc() :
+        ChunkSize(32u),
+        NumLods(5u),
+        SampleSpacing(1.0f),
+        Origin(0.0f),
+        LodRange(64.0f),
+        SkirtDepth(2.0f),
+        MaxResidentChunks(256u) {
+    // empty
+}
+
+// Returns the grid coordinate of a border vertex, the border is walked counter-clockwise seen from above
+static void getBorderVertex(ui32 chunkSize, ui32 i, ui32 &gx, ui32 &gz) {
+    const ui32 n = chunkSize;
+    if (i < n) {
+        gx = i;
+        gz = 0;
+    } else if (i < 2 * n) {
+        gx = n;
+        gz = i - n;
+    } else if (i < 3 * n) {
+        gx = n - (i - 2 * n);
+        gz = n;
+    } else {
+        gx = 0;
+        gz = n - (i - 3 * n);
+    }
+}
+
+static f32 getDistance(const AABB &box, const glm::vec3 &pos) {
+    const glm::vec3 closest = glm::clamp(pos, box.getMin(), box.getMax());
+    return glm::length(pos - closest);
+}
+
+TerrainLodTree::TerrainLodTree() :
+        mField(nullptr),
+        mDesc(),
+        mNumNodesX(),
+        mNumNodesZ(),
+        mRanges(),
+        mLodRanges() {
+    // empty
+}
+
+bool TerrainLodTree::init(const HeightField *field, const TerrainDesc &desc) {
+    if (field == nullptr || field->isEmpty()) {
+        osre_error(Tag, "Height field is empty.");
+        return false;
+    }
+
+    if (desc.ChunkSize == 0u || desc.ChunkSize > MaxChunkSize || desc.NumLods == 0u || desc.NumLods > MaxLods) {
+        osre_error(Tag, "Invalid terrain description.");
+        return false;
+    }
+
+    mField = field;
+    mDesc = desc;
+
+    const ui32 numQuadsX = std::max(field->getWidth() - 1u, 1u);
+    const ui32 numQuadsZ = std::max(field->getHeight() - 1u, 1u);
+    mNumNodesX.resize(desc.NumLods);
+    mNumNodesZ.resize(desc.NumLods);
+    mRanges.resize(desc.NumLods);
+    mLodRanges.resize(desc.NumLods);
+    mNumNodesX[0] = (numQuadsX + desc.ChunkSize - 1u) / desc.ChunkSize;
+    mNumNodesZ[0] = (numQuadsZ + desc.ChunkSize - 1u) / desc.ChunkSize;
+    mLodRanges[0] = desc.LodRange;
+    for (ui32 level = 1; level < desc.NumLods; ++level) {
+        mNumNodesX[level] = (mNumNodesX[level - 1] + 1u) / 2u;
+        mNumNodesZ[level] = (mNumNodesZ[level - 1] + 1u) / 2u;
+        mLodRanges[level] = mLodRanges[level - 1] * 2.0f;
+    }
+
+    // The finest level scans the samples, one row of nodes per task
+    const ui32 chunkSize = desc.ChunkSize;
+    const ui32 numX = mNumNodesX[0];
+    std::vector<glm::vec2> &leafs = mRanges[0];
+    leafs.resize(static_cast<size_t>(numX) * mNumNodesZ[0]);
+    WorkerPool::getInstance().parallelFor(mNumNodesZ[0], 1, [&](size_t begin, size_t end) {
+        for (size_t z = begin; z < end; ++z) {
+            for (ui32 x = 0; x < numX; ++x) {
+                glm::vec2 &range = leafs[z * numX + x];
+                const i32 x0 = static_cast<i32>(x * chunkSize);
+                const i32 z0 = static_cast<i32>(z * chunkSize);
+                field->getRange(x0, z0, x0 + static_cast<i32>(chunkSize), z0 + static_cast<i32>(chunkSize), range.x, range.y);
+            }
+        }
+    });
+
+    // The coarser levels merge their children
+    for (ui32 level = 1; level < desc.NumLods; ++level) {
+        std::vector<glm::vec2> &ranges = mRanges[level];
+        ranges.resize(static_cast<size_t>(mNumNodesX[level]) * mNumNodesZ[level]);
+        for (ui32 z = 0; z < mNumNodesZ[level]; ++z) {
+            for (ui32 x = 0; x < mNumNodesX[level]; ++x) {
+                glm::vec2 range(std::numeric_limits<f32>::max(), -std::numeric_limits<f32>::max());
+                for (ui32 j = 0; j < 2; ++j) {
+                    for (ui32 i = 0; i < 2; ++i) {
+                        const ui32 cx = x * 2 + i, cz = z * 2 + j;
+                        if (cx < mNumNodesX[level - 1] && cz < mNumNodesZ[level - 1]) {
+                            const glm::vec2 &child = getRange(level - 1, cx, cz);
+                            range.x = std::min(range.x, child.x);
+                            range.y = std::max(range.y, child.y);
+                        }
+                    }
+                }
+                ranges[static_cast<size_t>(z) * mNumNodesX[level] + x] = range;
+            }
+        }
+    }
+
+    return true;
+}
+
+const glm::vec2 &TerrainLodTree::getRange(ui32 level, ui32 x, ui32 z) const {
+    return mRanges[level][static_cast<size_t>(z) * mNumNodesX[level] + x];
+}
+
+void TerrainLodTree::getNumNodes(ui32 level, ui32 &numX, ui32 &numZ) const {
+    numX = numZ = 0u;
+    if (level < mNumNodesX.size()) {
+        numX = mNumNodesX[level];
+        numZ = mNumNodesZ[level];
+    }
+}
+
+void TerrainLodTree::select(const glm::vec3 &eye, TerrainNodeArray &nodes) const {
+    if (mField == nullptr) {
+        return;
+    }
+
+    const ui32 top = mDesc.NumLods - 1u;
+    for (ui32 z = 0; z < mNumNodesZ[top]; ++z) {
+        for (ui32 x = 0; x < mNumNodesX[top]; ++x) {
+            selectNode(top, x, z, eye, nodes);
+        }
+    }
+}
+
+void TerrainLodTree::selectNode(ui32 level, ui32 x, ui32 z, const glm::vec3 &eye, TerrainNodeArray &nodes) const {
+    const TerrainNode node = { level, x, z };
+    if (level > 0u && getDistance(getBounds(node), eye) <= mLodRanges[level - 1]) {
+        for (ui32 j = 0; j < 2; ++j) {
+            for (ui32 i = 0; i < 2; ++i) {
+                const ui32 cx = x * 2 + i, cz = z * 2 + j;
+                if (cx < mNumNodesX[level - 1] && cz < mNumNodesZ[level - 1]) {
+                    selectNode(level - 1, cx, cz, eye, nodes);
+                }
+            }
+        }
+        return;
+    }
+
+    nodes.add(node);
+}
+
+AABB TerrainLodTree::getBounds(const TerrainNode &node) const {
+    AABB box;
+    if (mField == nullptr || node.Level >= mDesc.NumLods) {
+        return box;
+    }
+
+    const ui32 span = mDesc.ChunkSize << node.Level;
+    const f32 x0 = static_cast<f32>(node.X * span);
+    const f32 z0 = static_cast<f32>(node.Z * span);
+    const f32 x1 = static_cast<f32>(std::min((node.X + 1) * span, mField->getWidth() - 1u));
+    const f32 z1 = static_cast<f32>(std::min((node.Z + 1) * span, mField->getHeight() - 1u));
+    const glm::vec2 &range = getRange(node.Level, node.X, node.Z);
+    const f32 spacing = mDesc.SampleSpacing;
+    box.set(mDesc.Origin + glm::vec3(x0 * spacing, range.x, z0 * spacing),
+            mDesc.Origin + glm::vec3(x1 * spacing, range.y, z1 * spacing));
+
+    return box;
+}
+
+ui32 TerrainLodTree::getNumChunkVertices() const {
+    const ui32 n = mDesc.ChunkSize;
+    return (n + 1) * (n + 1) + 4 * n;
+}
+
+ui32 TerrainLodTree::getNumChunkIndices() const {
+    const ui32 n = mDesc.ChunkSize;
+    return 6 * n * n + 6 * 4 * n;
+}
+
+void TerrainLodTree::buildChunkIndices(ui16 *indices) const {
+    if (indices == nullptr) {
+        return;
+    }
+
+    // The grid, two counter-clockwise triangles per quad seen from above
+    const ui32 n = mDesc.ChunkSize;
+    const ui32 rowSize = n + 1;
+    ui16 *index = indices;
+    for (ui32 z = 0; z < n; ++z) {
+        for (ui32 x = 0; x < n; ++x) {
+            const ui16 i0 = static_cast<ui16>(z * rowSize + x);
+            const ui16 i1 = static_cast<ui16>(i0 + 1);
+            const ui16 i2 = static_cast<ui16>(i0 + rowSize);
+            const ui16 i3 = static_cast<ui16>(i2 + 1);
+            *index++ = i0;
+            *index++ = i2;
+            *index++ = i1;
+            *index++ = i1;
+            *index++ = i2;
+            *index++ = i3;
+        }
+    }
+
+    // The skirts, facing outwards
+    const ui32 numBorder = 4 * n;
+    const ui32 firstSkirt = rowSize * rowSize;
+    for (ui32 i = 0; i < numBorder; ++i) {
+        const ui32 next = (i + 1) % numBorder;
+        ui32 ax, az, bx, bz;
+        getBorderVertex(n, i, ax, az);
+        getBorderVertex(n, next, bx, bz);
+        const ui16 a = static_cast<ui16>(az * rowSize + ax);
+        const ui16 b = static_cast<ui16>(bz * rowSize + bx);
+        const ui16 sa = static_cast<ui16>(firstSkirt + i);
+        const ui16 sb = static_cast<ui16>(firstSkirt + next);
+        *index++ = a;
+        *index++ = b;
+        *index++ = sa;
+        *index++ = b;
+        *index++ = sb;
+        *index++ = sa;
+    }
+}
+
+void TerrainLodTree::buildChunkVertices(const TerrainNode &node, RenderVert *vertices) const {
+    if (mField == nullptr || vertices == nullptr) {
+        return;
+    }
+
+    const ui32 n = mDesc.ChunkSize;
+    const i32 step = 1 << node.Level;
+    const i32 baseX = static_cast<i32>(node.X * (n << node.Level));
+    const i32 baseZ = static_cast<i32>(node.Z * (n << node.Level));
+    const i32 lastX = static_cast<i32>(mField->getWidth()) - 1;
+    const i32 lastZ = static_cast<i32>(mField->getHeight()) - 1;
+    const f32 spacing = mDesc.SampleSpacing;
+    const f32 invWidth = lastX > 0 ? 1.0f / static_cast<f32>(lastX) : 0.0f;
+    const f32 invHeight = lastZ > 0 ? 1.0f / static_cast<f32>(lastZ) : 0.0f;
+
+    // Vertices beyond the field will be clamped to its border
+    RenderVert *vertex = vertices;
+    for (ui32 gz = 0; gz <= n; ++gz) {
+        const i32 sz = std::min(baseZ + static_cast<i32>(gz) * step, lastZ);
+        for (ui32 gx = 0; gx <= n; ++gx) {
+            const i32 sx = std::min(baseX + static_cast<i32>(gx) * step, lastX);
+            const f32 h = mField->getSample(sx, sz);
+            const f32 dx = mField->getSample(sx - step, sz) - mField->getSample(sx + step, sz);
+            const f32 dz = mField->getSample(sx, sz - step) - mField->getSample(sx, sz + step);
+            vertex->position = mDesc.Origin + glm::vec3(static_cast<f32>(sx) * spacing, h, static_cast<f32>(sz) * spacing);
+            vertex->normal = glm::normalize(glm::vec3(dx, 2.0f * static_cast<f32>(step) * spacing, dz));
+            vertex->color0 = glm::vec3(1.0f);
+            vertex->tex0 = glm::vec2(static_cast<f32>(sx) * invWidth, static_cast<f32>(sz) * invHeight);
+            ++vertex;
+        }
+    }
+
+    // The skirts repeat the border vertices, deeper for coarser levels
+    const f32 depth = mDesc.SkirtDepth * static_cast<f32>(step);
+    for (ui32 i = 0; i < 4 * n; ++i) {
+        ui32 gx, gz;
+        getBorderVertex(n, i, gx, gz);
+        *vertex = vertices[gz * (n + 1) + gx];
+        vertex->position.y -= depth;
+        ++vertex;
+    }
+}
+
+TerrainChunkCache::TerrainChunkCache() :
+        mSlots(),
+        mLookup() {
+    // empty
+}
+
+void TerrainChunkCache::reserve(ui32 numSlots) {
+    clear();
+    mSlots.resize(numSlots);
+    for (Slot &slot : mSlots) {
+        slot.mKey = 0u;
+        slot.mLastUsed = 0u;
+        slot.mResident = false;
+    }
+}
+
+ui32 TerrainChunkCache::acquire(ui64 key, ui64 frame, bool &isNew) {
+    isNew = false;
+    auto it = mLookup.find(key);
+    if (it != mLookup.end()) {
+        mSlots[it->second].mLastUsed = frame;
+        return it->second;
+    }
+
+    // Take a free slot or replace the least recently used node, which is not part of this frame
+    ui32 victim = InvalidSlot;
+    ui64 oldest = std::numeric_limits<ui64>::max();
+    for (ui32 i = 0; i < mSlots.size(); ++i) {
+        const Slot &slot = mSlots[i];
+        if (!slot.mResident) {
+            victim = i;
+            break;
+        }
+        if (slot.mLastUsed < frame && slot.mLastUsed < oldest) {
+            oldest = slot.mLastUsed;
+            victim = i;
+        }
+    }
+
+    if (victim == InvalidSlot) {
+        return InvalidSlot;
+    }
+
+    Slot &slot = mSlots[victim];
+    if (slot.mResident) {
+        mLookup.erase(slot.mKey);
+    }
+    slot.mKey = key;
+    slot.mLastUsed = frame;
+    slot.mResident = true;
+    mLookup[key] = victim;
+    isNew = true;
+
+    return victim;
+}
+
+bool TerrainChunkCache::isUsed(ui32 slot, ui64 frame) const {
+    if (slot >= mSlots.size()) {
+        return false;
+    }
+
+    return mSlots[slot].mResident && mSlots[slot].mLastUsed == frame;
+}
+
+bool TerrainChunkCache::contains(ui64 key) const {
+    return mLookup.find(key) != mLookup.end();
+}
+
+void TerrainChunkCache::clear() {
+    for (Slot &slot : mSlots) {
+        slot.mResident = false;
+        slot.mLastUsed = 0u;
+    }
+    mLookup.clear();
+}
+
+Terrain::Terrain() :
+        mLodTree(),
+        mCache(),
+        mMeshes(),
+        mSelected(),
+        mStreamed(),
+        mFrame(0u) {
+    // empty
+}
+
+bool Terrain::init(RenderBackendService *rbSrv, const HeightField *field, const TerrainDesc &desc) {
+    if (rbSrv == nullptr) {
+        osre_error(Tag, "Render backend service is nullptr.");
+        return false;
+    }
+
+    if (!mMeshes.isEmpty()) {
+        osre_error(Tag, "Terrain was already initialized.");
+        return false;
+    }
+
+    if (desc.MaxResidentChunks == 0u || !mLodTree.init(field, desc)) {
+        return false;
+    }
+    mCache.reserve(desc.MaxResidentChunks);
+
+    const ui32 numVertices = mLodTree.getNumChunkVertices();
+    const ui32 numIndices = mLodTree.getNumChunkIndices();
+    std::vector<ui16> indices(numIndices);
+    mLodTree.buildChunkIndices(indices.data());
+
+    // The chunk meshes are a fixed pool, which is only hidden or refilled
+    Material *mat = MaterialBuilder::createBuildinMaterial(VertexType::RenderVertex);
+    mMeshes.reserve(desc.MaxResidentChunks);
+    for (ui32 i = 0; i < desc.MaxResidentChunks; ++i) {
+        Mesh *mesh = new Mesh("terrain_chunk_" + std::to_string(i), VertexType::RenderVertex, IndexType::UnsignedShort);
+        mesh->mapVertexBuffer(sizeof(RenderVert) * numVertices, BufferAccessType::ReadWrite);
+        if (mMeshes.isEmpty()) {
+            mesh->createIndexBuffer(indices.data(), sizeof(ui16) * numIndices, IndexType::UnsignedShort, BufferAccessType::ReadOnly);
+        } else {
+            mesh->shareIndexBuffer(mMeshes[0]);
+        }
+        mesh->addPrimitiveGroup(numIndices, PrimitiveType::TriangleList, 0);
+        mesh->setMaterial(mat);
+        mesh->setVisible(false);
+        mMeshes.add(mesh);
+    }
+
+    rbSrv->addMesh(mMeshes, 0);
+    for (ui32 i = 0; i < mMeshes.size(); ++i) {
+        rbSrv->updateMeshPrimitives(mMeshes[i]);
+    }
+
+    return true;
+}
+
+void Terrain::update(RenderBackendService *rbSrv, const glm::vec3 &eye) {
+    if (rbSrv == nullptr || mMeshes.isEmpty()) {
+        return;
+    }
+
+    ++mFrame;
+    mSelected.resize(0);
+    mStreamed.clear();
+    mLodTree.select(eye, mSelected);
+
+    for (ui32 i = 0; i < mSelected.size(); ++i) {
+        bool isNew = false;
+        const ui32 slot = mCache.acquire(mSelected[i].getKey(), mFrame, isNew);
+        if (slot == TerrainChunkCache::InvalidSlot) {
+            osre_debug(Tag, "Resident chunk budget exceeded, chunk skipped.");
+            continue;
+        }
+        if (isNew) {
+            mStreamed.emplace_back(slot, mSelected[i]);
+        }
+    }
+
+    // Each new chunk writes its own vertex buffer
+    WorkerPool::getInstance().parallelFor(mStreamed.size(), 1, [this](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            BufferData *vb = mMeshes[mStreamed[i].first]->getVertexBuffer();
+            mLodTree.buildChunkVertices(mStreamed[i].second, reinterpret_cast<RenderVert *>(vb->getData()));
+        }
+    });
+
+    for (const auto &streamed : mStreamed) {
+        Mesh *mesh = mMeshes[streamed.first];
+        mesh->invalidateAABB();
+        rbSrv->updateMesh(mesh);
+    }
+
+    // Only the chunks of this frame will be drawn, the others stay resident
+    for (ui32 i = 0; i < mMeshes.size(); ++i) {
+        Mesh *mesh = mMeshes[i];
+        if (mesh->setVisible(mCache.isUsed(i, mFrame))) {
+            rbSrv->updateMeshPrimitives(mesh);
+        }
+    }
+}
+
+} // namespace OSRE::App
@@ -0,0 +1,297 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "App/HeightField.h"
+#include "Common/glm_common.h"
+#include "Common/TAABB.h"
+#include "RenderBackend/RenderCommon.h"
+
+#include <cppcore/Container/TArray.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace OSRE {
+
+// Forward declarations ---------------------------------------------------------------------------
+namespace RenderBackend {
+    class RenderBackendService;
+    class Mesh;
+}
+
+namespace App {
+
+/// @brief  Describes the level of detail layout and the streaming budget of a terrain.
+struct TerrainDesc {
+    ui32 ChunkSize;             ///< The number of quads per chunk edge, all chunks share this grid.
+    ui32 NumLods;               ///< The number of levels, each level doubles the sample step.
+    f32 SampleSpacing;          ///< The distance between two samples in world units.
+    glm::vec3 Origin;           ///< The world position of the first sample.
+    f32 LodRange;               ///< The distance up to which the finest level is used, doubles per level.
+    f32 SkirtDepth;             ///< The skirt depth of the finest level, hides the cracks between levels.
+    ui32 MaxResidentChunks;     ///< The number of chunks kept in vertex buffers.
+
+    /// @brief  The default class constructor.
+    TerrainDesc();
+};
+
+/// @brief  Identifies a quadtree node, x and z are counted in nodes of its level.
+struct TerrainNode {
+    ui32 Level;     ///< The level, 0 is the finest one.
+    ui32 X;         ///< The column of the node.
+    ui32 Z;         ///< The row of the node.
+
+    /// @brief  Will return a unique key for the node.
+    /// @return The key.
+    ui64 getKey() const;
+};
+
+using TerrainNodeArray = cppcore::TArray<TerrainNode>;
+
+inline ui64 TerrainNode::getKey() const {
+    return (static_cast<ui64>(Level) << 56) | (static_cast<ui64>(X) << 28) | static_cast<ui64>(Z);
+}
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements the chunked level of detail quadtree of a terrain.
+///
+/// A node of level l covers ChunkSize << l samples and is drawn as a grid of ChunkSize quads,
+/// which samples the height field with a step of 1 << l. So all chunks share one index buffer.
+/// A node will be selected when it is farther away than the range of its children, otherwise it
+/// will be refined. Skirts along the chunk borders hide the cracks between neighbouring levels.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT TerrainLodTree {
+public:
+    /// @brief  The default class constructor.
+    TerrainLodTree();
+
+    /// @brief  The class destructor.
+    ~TerrainLodTree() = default;
+
+    /// @brief  Will build the height ranges of all nodes.
+    /// @param[in] field    The height field, must stay alive.
+    /// @param[in] desc     The terrain description.
+    /// @return true, if successful, false for an empty field or an invalid description.
+    bool init(const HeightField *field, const TerrainDesc &desc);
+
+    /// @brief  Will select the nodes to draw for a view position.
+    /// @param[in]  eye     The view position in world space.
+    /// @param[out] nodes   The selected nodes will be added, they cover the terrain without overlaps.
+    void select(const glm::vec3 &eye, TerrainNodeArray &nodes) const;
+
+    /// @brief  Will return the world space bounds of a node.
+    /// @param[in] node     The node.
+    /// @return The bounds.
+    Common::AABB getBounds(const TerrainNode &node) const;
+
+    /// @brief  Will return the number of vertices of one chunk including the skirts.
+    /// @return The number of vertices.
+    ui32 getNumChunkVertices() const;
+
+    /// @brief  Will return the number of triangle list indices of one chunk including the skirts.
+    /// @return The number of indices.
+    ui32 getNumChunkIndices() const;
+
+    /// @brief  Will write the indices shared by all chunks.
+    /// @param[out] indices     The indices, getNumChunkIndices values.
+    void buildChunkIndices(ui16 *indices) const;
+
+    /// @brief  Will write the vertices of a node.
+    /// @param[in]  node        The node.
+    /// @param[out] vertices    The vertices, getNumChunkVertices values.
+    void buildChunkVertices(const TerrainNode &node, RenderBackend::RenderVert *vertices) const;
+
+    /// @brief  Will return the number of nodes of a level per axis.
+    /// @param[in]  level   The level.
+    /// @param[out] numX    The number of columns.
+    /// @param[out] numZ    The number of rows.
+    void getNumNodes(ui32 level, ui32 &numX, ui32 &numZ) const;
+
+    /// @brief  Will return the terrain description.
+    /// @return The description.
+    const TerrainDesc &getDesc() const;
+
+private:
+    void selectNode(ui32 level, ui32 x, ui32 z, const glm::vec3 &eye, TerrainNodeArray &nodes) const;
+    const glm::vec2 &getRange(ui32 level, ui32 x, ui32 z) const;
+
+private:
+    const HeightField *mField;
+    TerrainDesc mDesc;
+    std::vector<ui32> mNumNodesX;
+    std::vector<ui32> mNumNodesZ;
+    std::vector<std::vector<glm::vec2>> mRanges;
+    std::vector<f32> mLodRanges;
+};
+
+inline const TerrainDesc &TerrainLodTree::getDesc() const {
+    return mDesc;
+}
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class assigns terrain nodes to a fixed number of chunk slots.
+///
+/// Nodes stay resident until their slot is needed for another node, the slot which was not used
+/// for the longest time will be replaced.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT TerrainChunkCache {
+public:
+    /// @brief  Marks an invalid slot.
+    static constexpr ui32 InvalidSlot = 0xffffffffu;
+
+    /// @brief  The default class constructor.
+    TerrainChunkCache();
+
+    /// @brief  The class destructor.
+    ~TerrainChunkCache() = default;
+
+    /// @brief  Will set the number of slots, all nodes will be released.
+    /// @param[in] numSlots     The number of slots.
+    void reserve(ui32 numSlots);
+
+    /// @brief  Will look up the slot of a node for a frame, a missing node will get a new slot.
+    /// @param[in]  key     The node key.
+    /// @param[in]  frame   The current frame.
+    /// @param[out] isNew   Will be true, if the slot must be filled with the node.
+    /// @return The slot or InvalidSlot, if all slots are used in this frame.
+    ui32 acquire(ui64 key, ui64 frame, bool &isNew);
+
+    /// @brief  Will return true, if a slot was used in a frame.
+    /// @param[in] slot     The slot.
+    /// @param[in] frame    The frame.
+    /// @return true, if used.
+    bool isUsed(ui32 slot, ui64 frame) const;
+
+    /// @brief  Will return true, if the node is resident.
+    /// @param[in] key      The node key.
+    /// @return true, if resident.
+    bool contains(ui64 key) const;
+
+    /// @brief  Will return the number of slots.
+    /// @return The number of slots.
+    ui32 getNumSlots() const;
+
+    /// @brief  Will return the number of resident nodes.
+    /// @return The number of resident nodes.
+    ui32 getNumResident() const;
+
+    /// @brief  Will release all nodes.
+    void clear();
+
+private:
+    struct Slot {
+        ui64 mKey;
+        ui64 mLastUsed;
+        bool mResident;
+    };
+
+    std::vector<Slot> mSlots;
+    std::unordered_map<ui64, ui32> mLookup;
+};
+
+inline ui32 TerrainChunkCache::getNumSlots() const {
+    return static_cast<ui32>(mSlots.size());
+}
+
+inline ui32 TerrainChunkCache::getNumResident() const {
+    return static_cast<ui32>(mLookup.size());
+}
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a streamed terrain with chunked level of detail.
+///
+/// The terrain owns a pool of chunk meshes, which share one index buffer. Each update selects the
+/// nodes for the view position, fills the vertex buffers of new nodes on the worker pool and
+/// uploads only these. Unused chunks will be hidden and stay resident until their mesh is needed
+/// for another node. Call init and update inside a render batch.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT Terrain {
+public:
+    /// @brief  The default class constructor.
+    Terrain();
+
+    /// @brief  The class destructor.
+    ~Terrain() = default;
+
+    /// @brief  Will create the chunk meshes and add them to the active render batch.
+    /// @param[in] rbSrv    The render backend service.
+    /// @param[in] field    The height field, must stay alive.
+    /// @param[in] desc     The terrain description.
+    /// @return true, if successful, false in case of an error.
+    bool init(RenderBackend::RenderBackendService *rbSrv, const HeightField *field, const TerrainDesc &desc);
+
+    /// @brief  Will select the chunks for the view position and stream in the missing ones.
+    /// @param[in] rbSrv    The render backend service.
+    /// @param[in] eye      The view position in world space.
+    void update(RenderBackend::RenderBackendService *rbSrv, const glm::vec3 &eye);
+
+    /// @brief  Will return the level of detail tree.
+    /// @return The tree.
+    const TerrainLodTree &getLodTree() const;
+
+    /// @brief  Will return the number of chunks drawn in the last update.
+    /// @return The number of chunks.
+    size_t getNumSelected() const;
+
+    /// @brief  Will return the number of chunks streamed in by the last update.
+    /// @return The number of chunks.
+    size_t getNumStreamed() const;
+
+    /// @brief  Will return the number of resident chunks.
+    /// @return The number of chunks.
+    ui32 getNumResident() const;
+
+private:
+    TerrainLodTree mLodTree;
+    TerrainChunkCache mCache;
+    RenderBackend::MeshArray mMeshes;
+    TerrainNodeArray mSelected;
+    std::vector<std::pair<ui32, TerrainNode>> mStreamed;
+    ui64 mFrame;
+};
+
+inline const TerrainLodTree &Terrain::getLodTree() const {
+    return mLodTree;
+}
+
+inline size_t Terrain::getNumSelected() const {
+    return mSelected.size();
+}
+
+inline size_t Terrain::getNumStreamed() const {
+    return mStreamed.size();
+}
+
+inline ui32 Terrain::getNumResident() const {
+    return mCache.getNumResident();
+}
+
+} // Namespace App
+} // Namespace OSRE
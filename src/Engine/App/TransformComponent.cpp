@@ -21,7 +21,9 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "App/Component.h"
+#include "App/Entity.h"
 #include "App/TransformComponent.h"
+#include "Common/BatchMath.h"
 #include "Common/StringUtils.h"
 #include "Common/glm_common.h"
 #include "Properties/Property.h"
@@ -75,9 +77,8 @@ TransformComponent *TransformComponent::getParent() const {
 }
 
 TransformComponent *TransformComponent::createChild(const String &name) {
+    // The child will register itself at its parent
     TransformComponent *child = new TransformComponent(name, getOwner(), *mIds, this);
-    mChildren.add(child);
-    child->get();
 
     return child;
 }
@@ -170,22 +171,35 @@ void TransformComponent::render(RenderBackendService *renderBackendSrv) {
 
 void TransformComponent::translate(const glm::vec3 &pos) {
     mLocalTransform = glm::translate(mLocalTransform, pos);
+    notifyOwner();
 }
 
 void TransformComponent::scale(const glm::vec3 &scale) {
     mLocalTransform = glm::scale(mLocalTransform, scale);
+    notifyOwner();
 }
 
 void TransformComponent::rotate(f32 angle, const glm::vec3 &axis) {
     mLocalTransform = glm::rotate(mLocalTransform, angle, axis);
+    notifyOwner();
 }
 
-void TransformComponent::setRotation(glm::quat &rotation) {
-    glm::toMat4(rotation);
+void TransformComponent::setRotation(const glm::quat &rotation) {
+    // Keep the translation and the scale of the local transformation
+    const glm::vec3 scale(glm::length(glm::vec3(mLocalTransform[0])), glm::length(glm::vec3(mLocalTransform[1])),
+            glm::length(glm::vec3(mLocalTransform[2])));
+    glm::mat4 m = glm::toMat4(rotation);
+    m[0] *= scale.x;
+    m[1] *= scale.y;
+    m[2] *= scale.z;
+    m[3] = mLocalTransform[3];
+    mLocalTransform = m;
+    notifyOwner();
 }
 
 void TransformComponent::setTransformationMatrix(const glm::mat4 &m) {
     mLocalTransform = m;
+    notifyOwner();
 }
 
 const glm::mat4 &TransformComponent::getTransformationMatrix() const {
@@ -195,14 +209,62 @@ const glm::mat4 &TransformComponent::getTransformationMatrix() const {
 glm::mat4 TransformComponent::getWorlTransformMatrix() {
     glm::mat4 wt(1.0);
     for (const TransformComponent *node = this; node != nullptr; node = node->getParent()) {
-        wt *= node->getTransformationMatrix();
+        wt = node->getTransformationMatrix() * wt;
     }
 
     return wt;
 }
 
+void TransformComponent::updateWorldTransforms(TransformComponent *root) {
+    if (nullptr == root) {
+        return;
+    }
+
+    root->mWorldTransform = root->getWorlTransformMatrix();
+
+    // Breadth-first, the nodes of one depth are stored behind each other
+    NodeArray nodes;
+    cppcore::TArray<glm::mat4> parents, locals, worlds;
+    nodes.add(root);
+    size_t levelStart = 0;
+    while (levelStart < nodes.size()) {
+        const size_t levelEnd = nodes.size();
+        parents.resize(0);
+        locals.resize(0);
+        for (size_t i = levelStart; i < levelEnd; ++i) {
+            TransformComponent *node = nodes[i];
+            for (size_t j = 0; j < node->mChildren.size(); ++j) {
+                TransformComponent *child = node->mChildren[j];
+                if (nullptr == child) {
+                    continue;
+                }
+                nodes.add(child);
+                parents.add(node->mWorldTransform);
+                locals.add(child->mLocalTransform);
+            }
+        }
+
+        const size_t numChildren = nodes.size() - levelEnd;
+        if (0 == numChildren) {
+            break;
+        }
+
+        worlds.resize(numChildren);
+        BatchMath::multiplyMatrices(&parents[0], &locals[0], &worlds[0], numChildren);
+        for (size_t i = 0; i < numChildren; ++i) {
+            nodes[levelEnd + i]->mWorldTransform = worlds[i];
+        }
+        levelStart = levelEnd;
+    }
+}
+
 bool TransformComponent::onUpdate(Time) {
-    mWorldTransform = getWorlTransformMatrix();
+    // A root updates its whole hierarchy in batches
+    if (nullptr == mParent) {
+        updateWorldTransforms(this);
+    } else {
+        mWorldTransform = getWorlTransformMatrix();
+    }
 
     return true;
 }
@@ -211,6 +273,24 @@ bool TransformComponent::onRender(RenderBackendService *) {
     return true;
 }
 
+void TransformComponent::notifyOwner() {
+    notifyHierarchy(nullptr);
+}
+
+void TransformComponent::notifyHierarchy(const Entity *notified) {
+    // The world transformation of all children follows the parent
+    Entity *owner = getOwner();
+    if (owner != nullptr && owner != notified) {
+        owner->onTransformChanged();
+    }
+
+    for (size_t i = 0; i < mChildren.size(); ++i) {
+        if (nullptr != mChildren[i]) {
+            mChildren[i]->notifyHierarchy(owner);
+        }
+    }
+}
+
 void TransformComponent::addMeshReference(size_t entityMeshIdx) {
     MeshReferenceArray::Iterator it = mMeshRefererenceArray.linearSearch(entityMeshIdx);
     if (mMeshRefererenceArray.end() == it) {
@@ -92,10 +92,16 @@ public:
     void translate(const glm::vec3 &pos);
     void scale(const glm::vec3 &pos);
     void rotate(f32 angle, const glm::vec3 &axis);
-    void setRotation(glm::quat &rotation);
+    void setRotation(const glm::quat &rotation);
     void setTransformationMatrix(const glm::mat4 &m);
     const glm::mat4 &getTransformationMatrix() const;
     glm::mat4 getWorlTransformMatrix();
+    const glm::mat4 &getWorldTransform() const;
+
+    /// @brief Will update the world transformations of a hierarchy. All nodes of one depth will be
+    /// multiplied with their parents in one batch.
+    /// @param[in] root     The root node of the hierarchy.
+    static void updateWorldTransforms(TransformComponent *root);
 
     void addMeshReference(size_t entityMeshIdx);
     size_t getNumMeshReferences() const;
@@ -105,6 +111,10 @@ protected:
     bool onUpdate(Time dt) override;
     bool onRender(RenderBackend::RenderBackendService *rbSrv) override;
 
+private:
+    void notifyOwner();
+    void notifyHierarchy(const Entity *notified);
+
 private:
     NodeArray mChildren;
     TransformComponent *mParent;
@@ -123,5 +133,9 @@ inline bool TransformComponent::isActive() const {
     return mIsActive;
 }
 
+inline const glm::mat4 &TransformComponent::getWorldTransform() const {
+    return mWorldTransform;
+}
+
 } // namespace App
 } // namespace OSRE
@@ -0,0 +1,784 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Common/BatchMath.h"
+
+#ifdef OSRE_SSE2
+#   include <immintrin.h>
+#   ifdef _MSC_VER
+#       include <intrin.h>
+#       define OSRE_TARGET_AVX2
+#   else
+#       define OSRE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#   endif
+#endif
+
+namespace OSRE::Common {
+
+namespace {
+
+inline const f32 *advance(const f32 *ptr, size_t stride) {
+    return reinterpret_cast<const f32 *>(reinterpret_cast<const c8 *>(ptr) + stride);
+}
+
+inline f32 *advance(f32 *ptr, size_t stride) {
+    return reinterpret_cast<f32 *>(reinterpret_cast<c8 *>(ptr) + stride);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Scalar kernels, the reference for all others
+//-------------------------------------------------------------------------------------------------
+void multiplyMatricesScalar(const glm::mat4 *lhs, const glm::mat4 *rhs, glm::mat4 *result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        result[i] = lhs[i] * rhs[i];
+    }
+}
+
+void transformPointsScalar(const glm::mat4 &m, const f32 *src, size_t srcStride, f32 *dst, size_t dstStride, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const glm::vec4 p = m * glm::vec4(src[0], src[1], src[2], 1.0f);
+        dst[0] = p.x;
+        dst[1] = p.y;
+        dst[2] = p.z;
+        src = advance(src, srcStride);
+        dst = advance(dst, dstStride);
+    }
+}
+
+void computeBoundsScalar(const f32 *positions, size_t stride, size_t count, glm::vec3 &min, glm::vec3 &max) {
+    min = max = glm::vec3(positions[0], positions[1], positions[2]);
+    for (size_t i = 1; i < count; ++i) {
+        positions = advance(positions, stride);
+        for (glm::length_t c = 0; c < 3; ++c) {
+            min[c] = positions[c] < min[c] ? positions[c] : min[c];
+            max[c] = positions[c] > max[c] ? positions[c] : max[c];
+        }
+    }
+}
+
+void mapToClipSpaceScalar(f32 *positions, size_t stride, size_t count, f32 scaleX, f32 scaleY) {
+    for (size_t i = 0; i < count; ++i) {
+        positions[0] = positions[0] * scaleX - 1.0f;
+        positions[1] = 1.0f - positions[1] * scaleY;
+        positions = advance(positions, stride);
+    }
+}
+
+void interleaveVerticesScalar(const VertexStreams &streams, f32 *dst, size_t dstStride, size_t count) {
+    const f32 *pos = streams.Positions, *normal = streams.Normals, *color = streams.Colors, *tex = streams.TexCoords;
+    for (size_t i = 0; i < count; ++i) {
+        dst[0] = pos[0];
+        dst[1] = pos[1];
+        dst[2] = pos[2];
+        dst[3] = normal[0];
+        dst[4] = normal[1];
+        dst[5] = normal[2];
+        dst[6] = color[0];
+        dst[7] = color[1];
+        dst[8] = color[2];
+        dst[9] = tex[0];
+        dst[10] = tex[1];
+        pos = advance(pos, streams.PositionStride);
+        normal = advance(normal, streams.NormalStride);
+        color = advance(color, streams.ColorStride);
+        tex = advance(tex, streams.TexCoordStride);
+        dst = advance(dst, dstStride);
+    }
+}
+
+void lerpVectorsScalar(glm::vec3 *target, const glm::vec3 *source, f32 weight, const f32 *weights, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const f32 w = weights != nullptr ? weight * weights[i] : weight;
+        target[i] += (source[i] - target[i]) * w;
+    }
+}
+
+void nlerpRotationsScalar(glm::quat *target, const glm::quat *source, f32 weight, const f32 *weights, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const f32 w = weights != nullptr ? weight * weights[i] : weight;
+        const f32 sign = glm::dot(target[i], source[i]) < 0.0f ? -1.0f : 1.0f;
+        target[i] = glm::normalize(target[i] * (1.0f - w) + source[i] * (sign * w));
+    }
+}
+
+#ifdef OSRE_SSE2
+
+// Loads x, y, z without touching the memory behind the position
+inline __m128 loadVec3(const f32 *p) {
+    const __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const d32 *>(p)));
+    return _mm_movelh_ps(xy, _mm_load_ss(p + 2));
+}
+
+inline void storeVec3(f32 *p, __m128 v) {
+    _mm_store_sd(reinterpret_cast<d32 *>(p), _mm_castps_pd(v));
+    _mm_store_ss(p + 2, _mm_movehl_ps(v, v));
+}
+
+//-------------------------------------------------------------------------------------------------
+// SSE2 kernels
+//-------------------------------------------------------------------------------------------------
+void multiplyMatricesSSE2(const glm::mat4 *lhs, const glm::mat4 *rhs, glm::mat4 *result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const f32 *a = &lhs[i][0][0];
+        const f32 *b = &rhs[i][0][0];
+        f32 *r = &result[i][0][0];
+        const __m128 a0 = _mm_loadu_ps(a);
+        const __m128 a1 = _mm_loadu_ps(a + 4);
+        const __m128 a2 = _mm_loadu_ps(a + 8);
+        const __m128 a3 = _mm_loadu_ps(a + 12);
+        for (size_t col = 0; col < 4; ++col) {
+            const __m128 bc = _mm_loadu_ps(b + col * 4);
+            __m128 res = _mm_mul_ps(a0, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(0, 0, 0, 0)));
+            res = _mm_add_ps(res, _mm_mul_ps(a1, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(1, 1, 1, 1))));
+            res = _mm_add_ps(res, _mm_mul_ps(a2, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(2, 2, 2, 2))));
+            res = _mm_add_ps(res, _mm_mul_ps(a3, _mm_shuffle_ps(bc, bc, _MM_SHUFFLE(3, 3, 3, 3))));
+            _mm_storeu_ps(r + col * 4, res);
+        }
+    }
+}
+
+void transformPointsSSE2(const glm::mat4 &m, const f32 *src, size_t srcStride, f32 *dst, size_t dstStride, size_t count) {
+    const __m128 c0 = _mm_loadu_ps(&m[0][0]);
+    const __m128 c1 = _mm_loadu_ps(&m[1][0]);
+    const __m128 c2 = _mm_loadu_ps(&m[2][0]);
+    const __m128 c3 = _mm_loadu_ps(&m[3][0]);
+    for (size_t i = 0; i < count; ++i) {
+        __m128 res = _mm_add_ps(c3, _mm_mul_ps(c0, _mm_set1_ps(src[0])));
+        res = _mm_add_ps(res, _mm_mul_ps(c1, _mm_set1_ps(src[1])));
+        res = _mm_add_ps(res, _mm_mul_ps(c2, _mm_set1_ps(src[2])));
+        storeVec3(dst, res);
+        src = advance(src, srcStride);
+        dst = advance(dst, dstStride);
+    }
+}
+
+void computeBoundsSSE2(const f32 *positions, size_t stride, size_t count, glm::vec3 &min, glm::vec3 &max) {
+    // All positions but the last one are followed by at least one float, the fourth lane
+    // will be ignored
+    __m128 minVec = loadVec3(positions);
+    __m128 maxVec = minVec;
+    const f32 *p = positions;
+    for (size_t i = 0; i + 1 < count; ++i) {
+        const __m128 pos = _mm_loadu_ps(p);
+        minVec = _mm_min_ps(minVec, pos);
+        maxVec = _mm_max_ps(maxVec, pos);
+        p = advance(p, stride);
+    }
+    const __m128 last = loadVec3(p);
+    minVec = _mm_min_ps(minVec, last);
+    maxVec = _mm_max_ps(maxVec, last);
+
+    f32 minArray[4] = {}, maxArray[4] = {};
+    _mm_storeu_ps(minArray, minVec);
+    _mm_storeu_ps(maxArray, maxVec);
+    min = glm::vec3(minArray[0], minArray[1], minArray[2]);
+    max = glm::vec3(maxArray[0], maxArray[1], maxArray[2]);
+}
+
+void mapToClipSpaceSSE2(f32 *positions, size_t stride, size_t count, f32 scaleX, f32 scaleY) {
+    // Two positions per step, x' = x * sx - 1, y' = y * -sy + 1
+    const __m128 scale = _mm_setr_ps(scaleX, -scaleY, scaleX, -scaleY);
+    const __m128 offset = _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+    size_t i = 0;
+    for (; i + 1 < count; i += 2) {
+        f32 *p1 = advance(positions, stride);
+        __m128 xy = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(positions));
+        xy = _mm_loadh_pi(xy, reinterpret_cast<const __m64 *>(p1));
+        xy = _mm_add_ps(_mm_mul_ps(xy, scale), offset);
+        _mm_storel_pi(reinterpret_cast<__m64 *>(positions), xy);
+        _mm_storeh_pi(reinterpret_cast<__m64 *>(p1), xy);
+        positions = advance(p1, stride);
+    }
+    if (i < count) {
+        mapToClipSpaceScalar(positions, stride, 1, scaleX, scaleY);
+    }
+}
+
+// Loads u, v into the lower half
+inline __m128 loadVec2(const f32 *p) {
+    return _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const d32 *>(p)));
+}
+
+void interleaveVerticesSSE2(const VertexStreams &streams, f32 *dst, size_t dstStride, size_t count) {
+    const f32 *pos = streams.Positions, *normal = streams.Normals, *color = streams.Colors, *tex = streams.TexCoords;
+    for (size_t i = 0; i < count; ++i) {
+        // ( px py pz nx | ny nz cr cg | cb u v - )
+        const __m128 p = loadVec3(pos), n = loadVec3(normal), c = loadVec3(color), t = loadVec2(tex);
+        const __m128 pn = _mm_shuffle_ps(p, n, _MM_SHUFFLE(0, 0, 2, 2));
+        const __m128 ct = _mm_shuffle_ps(c, t, _MM_SHUFFLE(1, 0, 2, 2));
+        const __m128 r0 = _mm_shuffle_ps(p, pn, _MM_SHUFFLE(2, 0, 1, 0));
+        const __m128 r1 = _mm_shuffle_ps(n, c, _MM_SHUFFLE(1, 0, 2, 1));
+        const __m128 r2 = _mm_shuffle_ps(ct, ct, _MM_SHUFFLE(3, 3, 2, 0));
+        _mm_storeu_ps(dst, r0);
+        _mm_storeu_ps(dst + 4, r1);
+        storeVec3(dst + 8, r2);
+        pos = advance(pos, streams.PositionStride);
+        normal = advance(normal, streams.NormalStride);
+        color = advance(color, streams.ColorStride);
+        tex = advance(tex, streams.TexCoordStride);
+        dst = advance(dst, dstStride);
+    }
+}
+
+void lerpVectorsSSE2(glm::vec3 *target, const glm::vec3 *source, f32 weight, const f32 *weights, size_t count) {
+    // Four vectors are three registers, the weights are spread over their components
+    f32 *t = reinterpret_cast<f32 *>(target);
+    const f32 *s = reinterpret_cast<const f32 *>(source);
+    __m128 w0 = _mm_set1_ps(weight), w1 = w0, w2 = w0;
+    size_t i = 0;
+    for (; i + 3 < count; i += 4) {
+        if (weights != nullptr) {
+            const __m128 w = _mm_mul_ps(_mm_loadu_ps(weights + i), _mm_set1_ps(weight));
+            w0 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(1, 0, 0, 0));
+            w1 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(2, 2, 1, 1));
+            w2 = _mm_shuffle_ps(w, w, _MM_SHUFFLE(3, 3, 3, 2));
+        }
+        const __m128 t0 = _mm_loadu_ps(t), t1 = _mm_loadu_ps(t + 4), t2 = _mm_loadu_ps(t + 8);
+        _mm_storeu_ps(t, _mm_add_ps(t0, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(s), t0), w0)));
+        _mm_storeu_ps(t + 4, _mm_add_ps(t1, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(s + 4), t1), w1)));
+        _mm_storeu_ps(t + 8, _mm_add_ps(t2, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(s + 8), t2), w2)));
+        t += 12;
+        s += 12;
+    }
+    lerpVectorsScalar(target + i, source + i, weight, weights != nullptr ? weights + i : nullptr, count - i);
+}
+
+// Four rotations are transposed into x, y, z and w registers
+inline void nlerpRotations4(__m128 &r0, __m128 &r1, __m128 &r2, __m128 &r3, __m128 s0, __m128 s1, __m128 s2, __m128 s3, __m128 w) {
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _MM_TRANSPOSE4_PS(s0, s1, s2, s3);
+    const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, s0), _mm_mul_ps(r1, s1)), _mm_add_ps(_mm_mul_ps(r2, s2), _mm_mul_ps(r3, s3)));
+    const __m128 sw = _mm_xor_ps(w, _mm_and_ps(_mm_cmplt_ps(dot, _mm_setzero_ps()), _mm_set1_ps(-0.0f)));
+    const __m128 tw = _mm_sub_ps(_mm_set1_ps(1.0f), w);
+    r0 = _mm_add_ps(_mm_mul_ps(r0, tw), _mm_mul_ps(s0, sw));
+    r1 = _mm_add_ps(_mm_mul_ps(r1, tw), _mm_mul_ps(s1, sw));
+    r2 = _mm_add_ps(_mm_mul_ps(r2, tw), _mm_mul_ps(s2, sw));
+    r3 = _mm_add_ps(_mm_mul_ps(r3, tw), _mm_mul_ps(s3, sw));
+    const __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(r0, r0), _mm_mul_ps(r1, r1)), _mm_add_ps(_mm_mul_ps(r2, r2), _mm_mul_ps(r3, r3))));
+    const __m128 invLen = _mm_div_ps(_mm_set1_ps(1.0f), len);
+    r0 = _mm_mul_ps(r0, invLen);
+    r1 = _mm_mul_ps(r1, invLen);
+    r2 = _mm_mul_ps(r2, invLen);
+    r3 = _mm_mul_ps(r3, invLen);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+}
+
+void nlerpRotationsSSE2(glm::quat *target, const glm::quat *source, f32 weight, const f32 *weights, size_t count) {
+    f32 *t = reinterpret_cast<f32 *>(target);
+    const f32 *s = reinterpret_cast<const f32 *>(source);
+    __m128 w = _mm_set1_ps(weight);
+    size_t i = 0;
+    for (; i + 3 < count; i += 4) {
+        if (weights != nullptr) {
+            w = _mm_mul_ps(_mm_loadu_ps(weights + i), _mm_set1_ps(weight));
+        }
+        __m128 r0 = _mm_loadu_ps(t), r1 = _mm_loadu_ps(t + 4), r2 = _mm_loadu_ps(t + 8), r3 = _mm_loadu_ps(t + 12);
+        nlerpRotations4(r0, r1, r2, r3, _mm_loadu_ps(s), _mm_loadu_ps(s + 4), _mm_loadu_ps(s + 8), _mm_loadu_ps(s + 12), w);
+        _mm_storeu_ps(t, r0);
+        _mm_storeu_ps(t + 4, r1);
+        _mm_storeu_ps(t + 8, r2);
+        _mm_storeu_ps(t + 12, r3);
+        t += 16;
+        s += 16;
+    }
+    nlerpRotationsScalar(target + i, source + i, weight, weights != nullptr ? weights + i : nullptr, count - i);
+}
+
+//-------------------------------------------------------------------------------------------------
+// AVX2 kernels, two 4-wide operations are done at once
+//-------------------------------------------------------------------------------------------------
+OSRE_TARGET_AVX2 inline __m256 combine(__m128 lo, __m128 hi) {
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+}
+
+OSRE_TARGET_AVX2 void multiplyMatricesAVX2(const glm::mat4 *lhs, const glm::mat4 *rhs, glm::mat4 *result, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const f32 *a = &lhs[i][0][0];
+        const f32 *b = &rhs[i][0][0];
+        f32 *r = &result[i][0][0];
+
+        // Each column of the left matrix is used for two result columns at once
+        const __m256 a0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a));
+        const __m256 a1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a + 4));
+        const __m256 a2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a + 8));
+        const __m256 a3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(a + 12));
+        for (size_t col = 0; col < 4; col += 2) {
+            const __m256 bc = _mm256_loadu_ps(b + col * 4);
+            __m256 res = _mm256_mul_ps(a0, _mm256_permute_ps(bc, _MM_SHUFFLE(0, 0, 0, 0)));
+            res = _mm256_fmadd_ps(a1, _mm256_permute_ps(bc, _MM_SHUFFLE(1, 1, 1, 1)), res);
+            res = _mm256_fmadd_ps(a2, _mm256_permute_ps(bc, _MM_SHUFFLE(2, 2, 2, 2)), res);
+            res = _mm256_fmadd_ps(a3, _mm256_permute_ps(bc, _MM_SHUFFLE(3, 3, 3, 3)), res);
+            _mm256_storeu_ps(r + col * 4, res);
+        }
+    }
+}
+
+OSRE_TARGET_AVX2 void transformPointsAVX2(const glm::mat4 &m, const f32 *src, size_t srcStride, f32 *dst, size_t dstStride, size_t count) {
+    const __m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&m[0][0]));
+    const __m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&m[1][0]));
+    const __m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&m[2][0]));
+    const __m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128 *>(&m[3][0]));
+    size_t i = 0;
+    for (; i + 1 < count; i += 2) {
+        const f32 *s1 = advance(src, srcStride);
+        f32 *d1 = advance(dst, dstStride);
+        __m256 res = _mm256_fmadd_ps(c0, combine(_mm_set1_ps(src[0]), _mm_set1_ps(s1[0])), c3);
+        res = _mm256_fmadd_ps(c1, combine(_mm_set1_ps(src[1]), _mm_set1_ps(s1[1])), res);
+        res = _mm256_fmadd_ps(c2, combine(_mm_set1_ps(src[2]), _mm_set1_ps(s1[2])), res);
+        storeVec3(dst, _mm256_castps256_ps128(res));
+        storeVec3(d1, _mm256_extractf128_ps(res, 1));
+        src = advance(s1, srcStride);
+        dst = advance(d1, dstStride);
+    }
+    if (i < count) {
+        transformPointsSSE2(m, src, srcStride, dst, dstStride, 1);
+    }
+}
+
+OSRE_TARGET_AVX2 void computeBoundsAVX2(const f32 *positions, size_t stride, size_t count, glm::vec3 &min, glm::vec3 &max) {
+    const __m128 first = loadVec3(positions);
+    __m256 minVec = combine(first, first);
+    __m256 maxVec = minVec;
+    const f32 *p = positions;
+    size_t i = 0;
+    for (; i + 2 < count; i += 2) {
+        const f32 *p1 = advance(p, stride);
+        const __m256 pos = combine(_mm_loadu_ps(p), _mm_loadu_ps(p1));
+        minVec = _mm256_min_ps(minVec, pos);
+        maxVec = _mm256_max_ps(maxVec, pos);
+        p = advance(p1, stride);
+    }
+
+    // One or two positions are left, the last one must not be read as four floats
+    __m128 minRes = _mm_min_ps(_mm256_castps256_ps128(minVec), _mm256_extractf128_ps(minVec, 1));
+    __m128 maxRes = _mm_max_ps(_mm256_castps256_ps128(maxVec), _mm256_extractf128_ps(maxVec, 1));
+    for (; i < count; ++i) {
+        const __m128 pos = (i + 1 < count) ? _mm_loadu_ps(p) : loadVec3(p);
+        minRes = _mm_min_ps(minRes, pos);
+        maxRes = _mm_max_ps(maxRes, pos);
+        p = advance(p, stride);
+    }
+
+    f32 minArray[4] = {}, maxArray[4] = {};
+    _mm_storeu_ps(minArray, minRes);
+    _mm_storeu_ps(maxArray, maxRes);
+    min = glm::vec3(minArray[0], minArray[1], minArray[2]);
+    max = glm::vec3(maxArray[0], maxArray[1], maxArray[2]);
+}
+
+OSRE_TARGET_AVX2 void mapToClipSpaceAVX2(f32 *positions, size_t stride, size_t count, f32 scaleX, f32 scaleY) {
+    // Four positions per step
+    const __m256 scale = _mm256_setr_ps(scaleX, -scaleY, scaleX, -scaleY, scaleX, -scaleY, scaleX, -scaleY);
+    const __m256 offset = _mm256_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
+    size_t i = 0;
+    for (; i + 3 < count; i += 4) {
+        f32 *p1 = advance(positions, stride);
+        f32 *p2 = advance(p1, stride);
+        f32 *p3 = advance(p2, stride);
+        __m128 lo = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(positions));
+        lo = _mm_loadh_pi(lo, reinterpret_cast<const __m64 *>(p1));
+        __m128 hi = _mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(p2));
+        hi = _mm_loadh_pi(hi, reinterpret_cast<const __m64 *>(p3));
+        const __m256 xy = _mm256_fmadd_ps(combine(lo, hi), scale, offset);
+        lo = _mm256_castps256_ps128(xy);
+        hi = _mm256_extractf128_ps(xy, 1);
+        _mm_storel_pi(reinterpret_cast<__m64 *>(positions), lo);
+        _mm_storeh_pi(reinterpret_cast<__m64 *>(p1), lo);
+        _mm_storel_pi(reinterpret_cast<__m64 *>(p2), hi);
+        _mm_storeh_pi(reinterpret_cast<__m64 *>(p3), hi);
+        positions = advance(p3, stride);
+    }
+    mapToClipSpaceSSE2(positions, stride, count - i, scaleX, scaleY);
+}
+
+OSRE_TARGET_AVX2 void interleaveVerticesAVX2(const VertexStreams &streams, f32 *dst, size_t dstStride, size_t count) {
+    // Two vertices per step, one in each lane
+    const f32 *pos = streams.Positions, *normal = streams.Normals, *color = streams.Colors, *tex = streams.TexCoords;
+    size_t i = 0;
+    for (; i + 1 < count; i += 2) {
+        const f32 *pos1 = advance(pos, streams.PositionStride);
+        const f32 *normal1 = advance(normal, streams.NormalStride);
+        const f32 *color1 = advance(color, streams.ColorStride);
+        const f32 *tex1 = advance(tex, streams.TexCoordStride);
+        f32 *dst1 = advance(dst, dstStride);
+        const __m256 p = combine(loadVec3(pos), loadVec3(pos1));
+        const __m256 n = combine(loadVec3(normal), loadVec3(normal1));
+        const __m256 c = combine(loadVec3(color), loadVec3(color1));
+        const __m256 t = combine(loadVec2(tex), loadVec2(tex1));
+        const __m256 pn = _mm256_shuffle_ps(p, n, _MM_SHUFFLE(0, 0, 2, 2));
+        const __m256 ct = _mm256_shuffle_ps(c, t, _MM_SHUFFLE(1, 0, 2, 2));
+        const __m256 r0 = _mm256_shuffle_ps(p, pn, _MM_SHUFFLE(2, 0, 1, 0));
+        const __m256 r1 = _mm256_shuffle_ps(n, c, _MM_SHUFFLE(1, 0, 2, 1));
+        const __m256 r2 = _mm256_shuffle_ps(ct, ct, _MM_SHUFFLE(3, 3, 2, 0));
+        _mm_storeu_ps(dst, _mm256_castps256_ps128(r0));
+        _mm_storeu_ps(dst + 4, _mm256_castps256_ps128(r1));
+        storeVec3(dst + 8, _mm256_castps256_ps128(r2));
+        _mm_storeu_ps(dst1, _mm256_extractf128_ps(r0, 1));
+        _mm_storeu_ps(dst1 + 4, _mm256_extractf128_ps(r1, 1));
+        storeVec3(dst1 + 8, _mm256_extractf128_ps(r2, 1));
+        pos = advance(pos1, streams.PositionStride);
+        normal = advance(normal1, streams.NormalStride);
+        color = advance(color1, streams.ColorStride);
+        tex = advance(tex1, streams.TexCoordStride);
+        dst = advance(dst1, dstStride);
+    }
+    if (i < count) {
+        VertexStreams tail = streams;
+        tail.Positions = pos;
+        tail.Normals = normal;
+        tail.Colors = color;
+        tail.TexCoords = tex;
+        interleaveVerticesSSE2(tail, dst, dstStride, 1);
+    }
+}
+
+OSRE_TARGET_AVX2 void lerpVectorsAVX2(glm::vec3 *target, const glm::vec3 *source, f32 weight, const f32 *weights, size_t count) {
+    // Eight vectors are three registers, the weights are spread over their components
+    f32 *t = reinterpret_cast<f32 *>(target);
+    const f32 *s = reinterpret_cast<const f32 *>(source);
+    const __m256i spread0 = _mm256_setr_epi32(0, 0, 0, 1, 1, 1, 2, 2);
+    const __m256i spread1 = _mm256_setr_epi32(2, 3, 3, 3, 4, 4, 4, 5);
+    const __m256i spread2 = _mm256_setr_epi32(5, 5, 6, 6, 6, 7, 7, 7);
+    __m256 w0 = _mm256_set1_ps(weight), w1 = w0, w2 = w0;
+    size_t i = 0;
+    for (; i + 7 < count; i += 8) {
+        if (weights != nullptr) {
+            const __m256 w = _mm256_mul_ps(_mm256_loadu_ps(weights + i), _mm256_set1_ps(weight));
+            w0 = _mm256_permutevar8x32_ps(w, spread0);
+            w1 = _mm256_permutevar8x32_ps(w, spread1);
+            w2 = _mm256_permutevar8x32_ps(w, spread2);
+        }
+        const __m256 t0 = _mm256_loadu_ps(t), t1 = _mm256_loadu_ps(t + 8), t2 = _mm256_loadu_ps(t + 16);
+        _mm256_storeu_ps(t, _mm256_fmadd_ps(_mm256_sub_ps(_mm256_loadu_ps(s), t0), w0, t0));
+        _mm256_storeu_ps(t + 8, _mm256_fmadd_ps(_mm256_sub_ps(_mm256_loadu_ps(s + 8), t1), w1, t1));
+        _mm256_storeu_ps(t + 16, _mm256_fmadd_ps(_mm256_sub_ps(_mm256_loadu_ps(s + 16), t2), w2, t2));
+        t += 24;
+        s += 24;
+    }
+    lerpVectorsSSE2(target + i, source + i, weight, weights != nullptr ? weights + i : nullptr, count - i);
+}
+
+// The 4x4 transpose of _MM_TRANSPOSE4_PS, done in both lanes
+OSRE_TARGET_AVX2 inline void transpose4(__m256 &r0, __m256 &r1, __m256 &r2, __m256 &r3) {
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+    r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+    r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+    r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+    r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3, 2, 3, 2));
+}
+
+OSRE_TARGET_AVX2 void nlerpRotationsAVX2(glm::quat *target, const glm::quat *source, f32 weight, const f32 *weights, size_t count) {
+    // The lower lanes hold the rotations i to i + 3, the upper ones i + 4 to i + 7
+    f32 *t = reinterpret_cast<f32 *>(target);
+    const f32 *s = reinterpret_cast<const f32 *>(source);
+    __m256 w = _mm256_set1_ps(weight);
+    size_t i = 0;
+    for (; i + 7 < count; i += 8) {
+        if (weights != nullptr) {
+            w = _mm256_mul_ps(_mm256_loadu_ps(weights + i), _mm256_set1_ps(weight));
+        }
+        __m256 r0 = combine(_mm_loadu_ps(t), _mm_loadu_ps(t + 16));
+        __m256 r1 = combine(_mm_loadu_ps(t + 4), _mm_loadu_ps(t + 20));
+        __m256 r2 = combine(_mm_loadu_ps(t + 8), _mm_loadu_ps(t + 24));
+        __m256 r3 = combine(_mm_loadu_ps(t + 12), _mm_loadu_ps(t + 28));
+        __m256 s0 = combine(_mm_loadu_ps(s), _mm_loadu_ps(s + 16));
+        __m256 s1 = combine(_mm_loadu_ps(s + 4), _mm_loadu_ps(s + 20));
+        __m256 s2 = combine(_mm_loadu_ps(s + 8), _mm_loadu_ps(s + 24));
+        __m256 s3 = combine(_mm_loadu_ps(s + 12), _mm_loadu_ps(s + 28));
+        transpose4(r0, r1, r2, r3);
+        transpose4(s0, s1, s2, s3);
+
+        __m256 dot = _mm256_mul_ps(r0, s0);
+        dot = _mm256_fmadd_ps(r1, s1, dot);
+        dot = _mm256_fmadd_ps(r2, s2, dot);
+        dot = _mm256_fmadd_ps(r3, s3, dot);
+        const __m256 sw = _mm256_xor_ps(w, _mm256_and_ps(_mm256_cmp_ps(dot, _mm256_setzero_ps(), _CMP_LT_OQ), _mm256_set1_ps(-0.0f)));
+        const __m256 tw = _mm256_sub_ps(_mm256_set1_ps(1.0f), w);
+        r0 = _mm256_fmadd_ps(s0, sw, _mm256_mul_ps(r0, tw));
+        r1 = _mm256_fmadd_ps(s1, sw, _mm256_mul_ps(r1, tw));
+        r2 = _mm256_fmadd_ps(s2, sw, _mm256_mul_ps(r2, tw));
+        r3 = _mm256_fmadd_ps(s3, sw, _mm256_mul_ps(r3, tw));
+        __m256 len = _mm256_mul_ps(r0, r0);
+        len = _mm256_fmadd_ps(r1, r1, len);
+        len = _mm256_fmadd_ps(r2, r2, len);
+        len = _mm256_fmadd_ps(r3, r3, len);
+        const __m256 invLen = _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(len));
+        r0 = _mm256_mul_ps(r0, invLen);
+        r1 = _mm256_mul_ps(r1, invLen);
+        r2 = _mm256_mul_ps(r2, invLen);
+        r3 = _mm256_mul_ps(r3, invLen);
+        transpose4(r0, r1, r2, r3);
+
+        _mm_storeu_ps(t, _mm256_castps256_ps128(r0));
+        _mm_storeu_ps(t + 4, _mm256_castps256_ps128(r1));
+        _mm_storeu_ps(t + 8, _mm256_castps256_ps128(r2));
+        _mm_storeu_ps(t + 12, _mm256_castps256_ps128(r3));
+        _mm_storeu_ps(t + 16, _mm256_extractf128_ps(r0, 1));
+        _mm_storeu_ps(t + 20, _mm256_extractf128_ps(r1, 1));
+        _mm_storeu_ps(t + 24, _mm256_extractf128_ps(r2, 1));
+        _mm_storeu_ps(t + 28, _mm256_extractf128_ps(r3, 1));
+        t += 32;
+        s += 32;
+    }
+    nlerpRotationsSSE2(target + i, source + i, weight, weights != nullptr ? weights + i : nullptr, count - i);
+}
+
+bool isAVX2Supported() {
+#ifdef _MSC_VER
+    i32 info[4] = {};
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+
+    // AVX, FMA and the OS support for the ymm-registers
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    const bool fma = (info[2] & (1 << 12)) != 0;
+    if (!osxsave || !avx || !fma || (_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+#endif // OSRE_SSE2
+
+SimdLevel detectLevel() {
+#ifdef OSRE_SSE2
+    return isAVX2Supported() ? SimdLevel::AVX2 : SimdLevel::SSE2;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel &activeLevel() {
+    static SimdLevel level = BatchMath::getSupportedLevel();
+    return level;
+}
+
+} // namespace
+
+SimdLevel BatchMath::getSupportedLevel() {
+    static const SimdLevel supported = detectLevel();
+    return supported;
+}
+
+SimdLevel BatchMath::getActiveLevel() {
+    return activeLevel();
+}
+
+void BatchMath::setActiveLevel(SimdLevel level) {
+    const SimdLevel supported = getSupportedLevel();
+    activeLevel() = static_cast<i32>(level) > static_cast<i32>(supported) ? supported : level;
+}
+
+const c8 *BatchMath::getLevelName(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::SSE2:
+            return "SSE2";
+        case SimdLevel::AVX2:
+            return "AVX2";
+        case SimdLevel::Scalar:
+        default:
+            break;
+    }
+
+    return "Scalar";
+}
+
+void BatchMath::multiplyMatrices(const glm::mat4 *lhs, const glm::mat4 *rhs, glm::mat4 *result, size_t count) {
+    if (nullptr == lhs || nullptr == rhs || nullptr == result) {
+        return;
+    }
+
+    switch (getActiveLevel()) {
+#ifdef OSRE_SSE2
+        case SimdLevel::AVX2:
+            multiplyMatricesAVX2(lhs, rhs, result, count);
+            break;
+        case SimdLevel::SSE2:
+            multiplyMatricesSSE2(lhs, rhs, result, count);
+            break;
+#endif
+        default:
+            multiplyMatricesScalar(lhs, rhs, result, count);
+            break;
+    }
+}
+
+void BatchMath::transformPoints(const glm::mat4 &m, const f32 *src, size_t srcStride, f32 *dst, size_t dstStride, size_t count) {
+    if (nullptr == src || nullptr == dst) {
+        return;
+    }
+
+    switch (getActiveLevel()) {
+#ifdef OSRE_SSE2
+        case SimdLevel::AVX2:
+            transformPointsAVX2(m, src, srcStride, dst, dstStride, count);
+            break;
+        case SimdLevel::SSE2:
+            transformPointsSSE2(m, src, srcStride, dst, dstStride, count);
+            break;
+#endif
+        default:
+            transformPointsScalar(m, src, srcStride, dst, dstStride, count);
+            break;
+    }
+}
+
+bool BatchMath::computeBounds(const f32 *positions, size_t stride, size_t count, glm::vec3 &min, glm::vec3 &max) {
+    if (nullptr == positions || 0 == count || stride < 3 * sizeof(f32)) {
+        return false;
+    }
+
+    switch (getActiveLevel()) {
+#ifdef OSRE_SSE2
+        case SimdLevel::AVX2:
+            computeBoundsAVX2(positions, stride, count, min, max);
+            break;
+        case SimdLevel::SSE2:
+            computeBoundsSSE2(positions, stride, count, min, max);
+            break;
+#endif
+        default:
+            computeBoundsScalar(positions, stride, count, min, max);
+            break;
+    }
+
+    return true;
+}
+
+void BatchMath::mapToClipSpace(f32 *positions, size_t stride, size_t count, f32 width, f32 height) {
+    if (nullptr == positions || stride < 2 * sizeof(f32) || width <= 0.0f || height <= 0.0f) {
+        return;
+    }
+
+    const f32 scaleX = 2.0f / width;
+    const f32 scaleY = 2.0f / height;
+    switch (getActiveLevel()) {
+#ifdef OSRE_SSE2
+        case SimdLevel::AVX2:
+            mapToClipSpaceAVX2(positions, stride, count, scaleX, scaleY);
+            break;
+        case SimdLevel::SSE2:
+            mapToClipSpaceSSE2(positions, stride, count, scaleX, scaleY);
+            break;
+#endif
+        default:
+            mapToClipSpaceScalar(positions, stride, count, scaleX, scaleY);
+            break;
+    }
+}
+
+void BatchMath::interleaveVertices(const VertexStreams &streams, f32 *dst, size_t dstStride, size_t count) {
+    if (nullptr == dst || dstStride < 11 * sizeof(f32)) {
+        return;
+    }
+
+    // Missing streams are read from zeros, so the kernels do not need to branch per vertex
+    static const f32 Zero[4] = {};
+    VertexStreams sources = streams;
+    if (nullptr == sources.Positions) {
+        sources.Positions = Zero;
+        sources.PositionStride = 0;
+    }
+    if (nullptr == sources.Normals) {
+        sources.Normals = Zero;
+        sources.NormalStride = 0;
+    }
+    if (nullptr == sources.Colors) {
+        sources.Colors = Zero;
+        sources.ColorStride = 0;
+    }
+    if (nullptr == sources.TexCoords) {
+        sources.TexCoords = Zero;
+        sources.TexCoordStride = 0;
+    }
+
+    switch (getActiveLevel()) {
+#ifdef OSRE_SSE2
+        case SimdLevel::AVX2:
+            interleaveVerticesAVX2(sources, dst, dstStride, count);
+            break;
+        case SimdLevel::SSE2:
+            interleaveVerticesSSE2(sources, dst, dstStride, count);
+            break;
+#endif
+        default:
+            interleaveVerticesScalar(sources, dst, dstStride, count);
+            break;
+    }
+}
+
+void BatchMath::lerpVectors(glm::vec3 *target, const glm::vec3 *source, f32 weight, const f32 *weights, size_t count) {
+    static_assert(sizeof(glm::vec3) == 3 * sizeof(f32), "Vectors must be packed");
+    if (nullptr == target || nullptr == source || 0 == count) {
+        return;
+    }
+
+    switch (getActiveLevel()) {
+#ifdef OSRE_SSE2
+        case SimdLevel::AVX2:
+            lerpVectorsAVX2(target, source, weight, weights, count);
+            break;
+        case SimdLevel::SSE2:
+            lerpVectorsSSE2(target, source, weight, weights, count);
+            break;
+#endif
+        default:
+            lerpVectorsScalar(target, source, weight, weights, count);
+            break;
+    }
+}
+
+void BatchMath::nlerpRotations(glm::quat *target, const glm::quat *source, f32 weight, const f32 *weights, size_t count) {
+    static_assert(sizeof(glm::quat) == 4 * sizeof(f32), "Rotations must be packed");
+    if (nullptr == target || nullptr == source || 0 == count) {
+        return;
+    }
+
+    switch (getActiveLevel()) {
+#ifdef OSRE_SSE2
+        case SimdLevel::AVX2:
+            nlerpRotationsAVX2(target, source, weight, weights, count);
+            break;
+        case SimdLevel::SSE2:
+            nlerpRotationsSSE2(target, source, weight, weights, count);
+            break;
+#endif
+        default:
+            nlerpRotationsScalar(target, source, weight, weights, count);
+            break;
+    }
+}
+
+} // namespace OSRE::Common
@@ -0,0 +1,138 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+#include "Common/glm_common.h"
+
+namespace OSRE::Common {
+
+///	@brief  Describes the instruction set used by the batch math kernels.
+enum class SimdLevel {
+    Scalar = 0, ///< Plain C++, available everywhere.
+    SSE2,       ///< 4-wide kernels, the baseline on x86-64.
+    AVX2        ///< 8-wide kernels with FMA, selected at runtime.
+};
+
+/// @brief  Describes the attribute streams of a mesh, which shall be interleaved into vertices.
+/// Streams which are nullptr will be written as zero.
+struct VertexStreams {
+    const f32 *Positions = nullptr;                 ///< The positions ( x|y|z ).
+    size_t PositionStride = 3 * sizeof(f32);        ///< The distance between two positions in bytes.
+    const f32 *Normals = nullptr;                   ///< The normals ( x|y|z ).
+    size_t NormalStride = 3 * sizeof(f32);          ///< The distance between two normals in bytes.
+    const f32 *Colors = nullptr;                    ///< The colors ( r|g|b ).
+    size_t ColorStride = 3 * sizeof(f32);           ///< The distance between two colors in bytes, 0 to repeat the first.
+    const f32 *TexCoords = nullptr;                 ///< The texture coordinates ( u|v ).
+    size_t TexCoordStride = 2 * sizeof(f32);        ///< The distance between two texture coordinates in bytes.
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class offers math kernels which work on arrays instead of single values. The
+/// best supported instruction set will be detected at runtime, all kernels produce the same
+/// results as the scalar versions except for rounding.
+///
+/// Positions are passed as float pointers with a stride in bytes, so they can be read directly
+/// from interleaved vertices.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT BatchMath {
+public:
+    /// @brief Will return the best instruction set supported by the CPU.
+    /// @return The supported level.
+    static SimdLevel getSupportedLevel();
+
+    /// @brief Will return the instruction set used by the kernels.
+    /// @return The active level.
+    static SimdLevel getActiveLevel();
+
+    /// @brief Will select the instruction set, levels which are not supported will be clamped.
+    /// @param[in] level    The requested level, meant for tests and benchmarks.
+    static void setActiveLevel(SimdLevel level);
+
+    /// @brief Will return the name of a level.
+    /// @param[in] level    The level.
+    /// @return The name.
+    static const c8 *getLevelName(SimdLevel level);
+
+    /// @brief Will multiply two arrays of matrices, result[i] = lhs[i] * rhs[i].
+    /// @param[in] lhs      The left matrices.
+    /// @param[in] rhs      The right matrices.
+    /// @param[out] result  The result, may be the same array as lhs or rhs.
+    /// @param[in] count    The number of matrices.
+    static void multiplyMatrices(const glm::mat4 *lhs, const glm::mat4 *rhs, glm::mat4 *result, size_t count);
+
+    /// @brief Will transform an array of points, the w-component will be assumed as 1.
+    /// @param[in] m            The transformation.
+    /// @param[in] src          The first position.
+    /// @param[in] srcStride    The distance between two positions in bytes.
+    /// @param[out] dst         The first transformed position, may be the same as src.
+    /// @param[in] dstStride    The distance between two transformed positions in bytes.
+    /// @param[in] count        The number of positions.
+    static void transformPoints(const glm::mat4 &m, const f32 *src, size_t srcStride, f32 *dst, size_t dstStride, size_t count);
+
+    /// @brief Will compute the bounds of an array of positions.
+    /// @param[in] positions    The first position.
+    /// @param[in] stride       The distance between two positions in bytes, at least 12.
+    /// @param[in] count        The number of positions.
+    /// @param[out] min         The minimum.
+    /// @param[out] max         The maximum.
+    /// @return false if the array is empty.
+    static bool computeBounds(const f32 *positions, size_t stride, size_t count, glm::vec3 &min, glm::vec3 &max);
+
+    /// @brief Will convert 2D positions from screen coordinates into clip space in place, the
+    /// y-axis will be flipped.
+    /// @param[in,out] positions    The first position.
+    /// @param[in] stride           The distance between two positions in bytes, at least 8.
+    /// @param[in] count            The number of positions.
+    /// @param[in] width            The width of the screen.
+    /// @param[in] height           The height of the screen.
+    static void mapToClipSpace(f32 *positions, size_t stride, size_t count, f32 width, f32 height);
+
+    /// @brief Will interleave attribute streams into vertices, which start with the position, the
+    /// normal, the color and the texture coordinate like the render vertex ( 11 floats ).
+    /// @param[in] streams      The attribute streams.
+    /// @param[out] dst         The first vertex.
+    /// @param[in] dstStride    The size of a vertex in bytes, at least 44.
+    /// @param[in] count        The number of vertices.
+    static void interleaveVertices(const VertexStreams &streams, f32 *dst, size_t dstStride, size_t count);
+
+    /// @brief Will interpolate two arrays of vectors, target[i] += (source[i] - target[i]) * weight * weights[i].
+    /// @param[inout] target    The vectors to interpolate, will contain the result.
+    /// @param[in] source       The vectors to interpolate to.
+    /// @param[in] weight       The interpolation factor.
+    /// @param[in] weights      Optional factors per vector, nullptr to use weight for all.
+    /// @param[in] count        The number of vectors.
+    static void lerpVectors(glm::vec3 *target, const glm::vec3 *source, f32 weight, const f32 *weights, size_t count);
+
+    /// @brief Will interpolate two arrays of rotations by normalized linear interpolation along the shortest path.
+    /// @param[inout] target    The rotations to interpolate, will contain the result.
+    /// @param[in] source       The rotations to interpolate to.
+    /// @param[in] weight       The interpolation factor.
+    /// @param[in] weights      Optional factors per rotation, nullptr to use weight for all.
+    /// @param[in] count        The number of rotations.
+    static void nlerpRotations(glm::quat *target, const glm::quat *source, f32 weight, const f32 *weights, size_t count);
+};
+
+} // namespace OSRE::Common
@@ -81,6 +81,12 @@ public:
     /// @return true if the point is in, false if not.
     bool isIn(const glm::vec3 &point);
 
+    /// @brief Will check if the sphere is at least partially in the frustum.
+    /// @param[in] center   The center of the sphere.
+    /// @param[in] radius   The radius of the sphere.
+    /// @return true if the sphere intersects the frustum, false if not.
+    bool isIn(const glm::vec3 &center, f32 radius) const;
+
     /// @brief Will generate the view frustum out of the view-projection matrix from the camera.
     /// @param[in] vp   The view-projection matrix from the camera model.
     void extractFrom(const glm::mat4 &vp);
@@ -110,18 +116,39 @@ inline bool Frustum::isIn(const glm::vec3 &point ) {
     return in;
 }
 
+inline bool Frustum::isIn(const glm::vec3 &center, f32 radius) const {
+    for (size_t i = 0; i < mPlanes.size(); ++i) {
+        const Plane &plane = mPlanes[i];
+        const f32 d = plane.param.x * center.x + plane.param.y * center.y + plane.param.z * center.z + plane.param.w;
+        if (d < -radius) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
 inline void Frustum::extractFrom(const glm::mat4 &vp) {
     glm::vec4 rowX = glm::row(vp, 0);
     glm::vec4 rowY = glm::row(vp, 1);
     glm::vec4 rowZ = glm::row(vp, 2);
     glm::vec4 rowW = glm::row(vp, 3);
 
-    mPlanes[0].param = glm::normalize(rowW + rowX);
-    mPlanes[1].param = glm::normalize(rowW - rowX);
-    mPlanes[2].param = glm::normalize(rowW + rowY);
-    mPlanes[3].param = glm::normalize(rowW - rowY);
-    mPlanes[4].param = glm::normalize(rowW + rowZ);
-    mPlanes[5].param = glm::normalize(rowW - rowZ);
+    mPlanes[0].param = rowW + rowX;
+    mPlanes[1].param = rowW - rowX;
+    mPlanes[2].param = rowW + rowY;
+    mPlanes[3].param = rowW - rowY;
+    mPlanes[4].param = rowW + rowZ;
+    mPlanes[5].param = rowW - rowZ;
+
+    // Normalize by the length of the normal, so d is the distance in world units
+    for (size_t i = 0; i < mPlanes.size(); ++i) {
+        glm::vec4 &param = mPlanes[i].param;
+        const f32 len = glm::length(glm::vec3(param));
+        if (len > 0.0f) {
+            param /= len;
+        }
+    }
 }
 
 inline void Frustum::clear() {
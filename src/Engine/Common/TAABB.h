@@ -80,6 +80,19 @@ public:
     /// @param[in] numVectors The number of positions.
     void updateFromVector3Array(glm::vec3 *vecArray, size_t numVectors);
 
+    /// @brief Will merge another bounding volume into this one.
+    /// @param[in] rhs   The bounding volume to merge.
+    void merge(const AABB &rhs);
+
+    /// @brief Will return the bounding volume of this box after applying the transformation.
+    /// @param[in] m     The transformation matrix.
+    /// @return The transformed bounding volume, axis-aligned again.
+    AABB transform(const glm::mat4 &m) const;
+
+    /// @brief Checks if the bounds were calculated.
+    /// @return true if valid, false if still in the reset state.
+    bool isValid() const;
+
     /// @brief Will return the diameter.
     /// @return The diameter.
     f32 getDiameter() const;
@@ -170,6 +183,37 @@ inline void AABB::updateFromVector3Array(glm::vec3 *vecArray, size_t numVectors)
     }
 }
 
+inline void AABB::merge(const AABB &rhs) {
+    if (!rhs.isValid()) {
+        return;
+    }
+
+    merge(rhs.mMin);
+    merge(rhs.mMax);
+}
+
+inline AABB AABB::transform(const glm::mat4 &m) const {
+    if (!isValid()) {
+        return *this;
+    }
+
+    // Arvo's method: the transformed extents are the sum of the min/max products per axis
+    glm::vec3 newMin(m[3]), newMax(m[3]);
+    for (glm::length_t col = 0; col < 3; ++col) {
+        const glm::vec3 axis(m[col]);
+        const glm::vec3 a = axis * mMin[col];
+        const glm::vec3 b = axis * mMax[col];
+        newMin += glm::min(a, b);
+        newMax += glm::max(a, b);
+    }
+
+    return AABB(newMin, newMax);
+}
+
+inline bool AABB::isValid() const {
+    return mMin.x <= mMax.x && mMin.y <= mMax.y && mMin.z <= mMax.z;
+}
+
 inline f32 AABB::getDiameter() const {
     if (0 != mDiameter) {
         return mDiameter;
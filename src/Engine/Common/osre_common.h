@@ -36,6 +36,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #    define OSRE_ANDROID
 #endif
 
+// SSE2 is the baseline for the vectorized code paths, all others will use the scalar fallback
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define OSRE_SSE2
+#endif
+
 #include "Common/glm_common.h"
 #include <cppcore/Container/TArray.h>
 
@@ -0,0 +1,364 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "IO/BundleArchive.h"
+#include "Common/Logger.h"
+#include "Debugging/osre_debugging.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace OSRE {
+namespace IO {
+
+DECL_OSRE_LOG_MODULE(BundleArchive)
+
+static constexpr c8 Magic[4] = { 'O', 'S', 'B', 'A' };
+
+static ui64 align(ui64 offset, ui32 alignment) {
+    return (offset + alignment - 1) & ~static_cast<ui64>(alignment - 1);
+}
+
+static bool isRange(ui64 first, ui64 count, ui64 total) {
+    return first <= total && count <= total - first;
+}
+
+// Compares a name of the table of contents with a string, like strcmp
+static i32 compareName(const c8 *name, ui32 length, const String &str) {
+    const size_t len = std::min(static_cast<size_t>(length), str.size());
+    const i32 result = 0 == len ? 0 : ::memcmp(name, str.c_str(), len);
+    if (0 != result) {
+        return result;
+    }
+    if (length == str.size()) {
+        return 0;
+    }
+
+    return length < str.size() ? -1 : 1;
+}
+
+static bool writePadding(FILE *file, ui64 offset) {
+    static const uc8 Zeros[256] = {};
+    const long pos = ::ftell(file);
+    if (pos < 0 || static_cast<ui64>(pos) > offset) {
+        return false;
+    }
+
+    ui64 padding = offset - static_cast<ui64>(pos);
+    while (padding > 0) {
+        const size_t chunk = static_cast<size_t>(std::min<ui64>(padding, sizeof(Zeros)));
+        if (::fwrite(Zeros, 1, chunk, file) != chunk) {
+            return false;
+        }
+        padding -= chunk;
+    }
+
+    return true;
+}
+
+BundleArchiveWriter::BundleArchiveWriter(ui32 alignment) :
+        mAlignment(alignment),
+        mEntries() {
+    if (0 == mAlignment || 0 != (mAlignment & (mAlignment - 1))) {
+        osre_warn(Tag, "Invalid alignment, using the default alignment.");
+        mAlignment = DefaultAlignment;
+    }
+}
+
+bool BundleArchiveWriter::add(const String &name, const void *data, size_t size, BundleCompression compression) {
+    if (name.empty() || (nullptr == data && 0 != size) || compression >= BundleCompression::Count) {
+        return false;
+    }
+    for (const PendingEntry &entry : mEntries) {
+        if (entry.Name == name) {
+            osre_debug(Tag, "Entry " + name + " is part of the bundle already.");
+            return false;
+        }
+    }
+
+    PendingEntry entry;
+    entry.Name = name;
+    entry.Compression = BundleCompression::None;
+    entry.UncompressedSize = size;
+    const uc8 *bytes = static_cast<const uc8 *>(data);
+    if (BundleCompression::Deflate == compression && size > 0) {
+        uLongf compressedSize = ::compressBound(static_cast<uLong>(size));
+        entry.Data.resize(compressedSize);
+        if (Z_OK != ::compress2(entry.Data.data(), &compressedSize, bytes, static_cast<uLong>(size), Z_BEST_COMPRESSION)) {
+            osre_error(Tag, "Cannot compress entry " + name);
+            return false;
+        }
+
+        // Entries which do not get smaller are stored
+        if (compressedSize < size) {
+            entry.Data.resize(compressedSize);
+            entry.Compression = BundleCompression::Deflate;
+        }
+    }
+    if (BundleCompression::None == entry.Compression) {
+        entry.Data.assign(bytes, bytes + size);
+    }
+    mEntries.push_back(std::move(entry));
+
+    return true;
+}
+
+bool BundleArchiveWriter::addFile(const String &name, const String &filename, BundleCompression compression) {
+    MemoryMappedFile file;
+    if (!file.open(filename)) {
+        // Empty files cannot be mapped
+        FILE *empty = ::fopen(filename.c_str(), "rb");
+        if (nullptr == empty) {
+            osre_error(Tag, "Cannot read " + filename);
+            return false;
+        }
+        ::fclose(empty);
+
+        return add(name, nullptr, 0, compression);
+    }
+
+    return add(name, file.getData(), file.getSize(), compression);
+}
+
+bool BundleArchiveWriter::write(const String &filename) const {
+    // The entries are sorted by their name, so they can be found by a binary search
+    std::vector<const PendingEntry *> sorted;
+    sorted.reserve(mEntries.size());
+    for (const PendingEntry &entry : mEntries) {
+        sorted.push_back(&entry);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const PendingEntry *lhs, const PendingEntry *rhs) {
+        return lhs->Name < rhs->Name;
+    });
+
+    BundleArchiveHeader header;
+    ::memset(&header, 0, sizeof(BundleArchiveHeader));
+    ::memcpy(header.Magic, Magic, sizeof(Magic));
+    header.Version = BundleArchive::Version;
+    header.NumEntries = static_cast<ui32>(sorted.size());
+    header.Alignment = mAlignment;
+    header.TocOffset = align(sizeof(BundleArchiveHeader), mAlignment);
+    header.NamesOffset = header.TocOffset + sorted.size() * sizeof(BundleEntry);
+
+    std::vector<BundleEntry> toc(sorted.size());
+    String names;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        toc[i].NameOffset = static_cast<ui32>(names.size());
+        toc[i].NameLength = static_cast<ui32>(sorted[i]->Name.size());
+        names += sorted[i]->Name;
+    }
+    header.NamesSize = names.size();
+
+    ui64 offset = header.NamesOffset + header.NamesSize;
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        offset = align(offset, mAlignment);
+        toc[i].Compression = static_cast<ui32>(sorted[i]->Compression);
+        toc[i].Padding = 0;
+        toc[i].Offset = offset;
+        toc[i].Size = sorted[i]->Data.size();
+        toc[i].UncompressedSize = sorted[i]->UncompressedSize;
+        offset += toc[i].Size;
+    }
+
+    FILE *file = ::fopen(filename.c_str(), "wb");
+    if (nullptr == file) {
+        osre_error(Tag, "Cannot write bundle " + filename);
+        return false;
+    }
+
+    bool ok = ::fwrite(&header, sizeof(BundleArchiveHeader), 1, file) == 1;
+    ok = ok && writePadding(file, header.TocOffset);
+    ok = ok && (toc.empty() || ::fwrite(toc.data(), sizeof(BundleEntry), toc.size(), file) == toc.size());
+    ok = ok && ::fwrite(names.c_str(), 1, names.size(), file) == names.size();
+    for (size_t i = 0; ok && i < sorted.size(); ++i) {
+        const std::vector<uc8> &data = sorted[i]->Data;
+        ok = writePadding(file, toc[i].Offset) && (data.empty() || ::fwrite(data.data(), 1, data.size(), file) == data.size());
+    }
+    ::fclose(file);
+
+    if (!ok) {
+        osre_error(Tag, "Error while writing bundle " + filename);
+        ::remove(filename.c_str());
+    }
+
+    return ok;
+}
+
+BundleArchive::BundleArchive() :
+        mFile(),
+        mFilename(),
+        mHeader(nullptr),
+        mEntries(nullptr) {
+    // empty
+}
+
+bool BundleArchive::open(const String &filename) {
+    close();
+    if (!mFile.open(filename)) {
+        osre_error(Tag, "Cannot open bundle " + filename);
+        return false;
+    }
+
+    if (mFile.getSize() < sizeof(BundleArchiveHeader)) {
+        mFile.close();
+        return false;
+    }
+
+    mHeader = reinterpret_cast<const BundleArchiveHeader *>(mFile.getData());
+    if (0 != ::memcmp(mHeader->Magic, Magic, sizeof(Magic)) || Version != mHeader->Version || !validate()) {
+        osre_error(Tag, "Bundle " + filename + " is invalid.");
+        close();
+        return false;
+    }
+    mEntries = reinterpret_cast<const BundleEntry *>(mFile.getData() + mHeader->TocOffset);
+    mFilename = filename;
+
+    return true;
+}
+
+void BundleArchive::close() {
+    mHeader = nullptr;
+    mEntries = nullptr;
+    mFilename.clear();
+    mFile.close();
+}
+
+bool BundleArchive::validate() const {
+    const ui64 fileSize = mFile.getSize();
+    const ui32 alignment = mHeader->Alignment;
+    if (0 == alignment || 0 != (alignment & (alignment - 1)) || 0 != mHeader->TocOffset % alignof(BundleEntry) ||
+            !isRange(mHeader->TocOffset, static_cast<ui64>(mHeader->NumEntries) * sizeof(BundleEntry), fileSize) ||
+            !isRange(mHeader->NamesOffset, mHeader->NamesSize, fileSize)) {
+        return false;
+    }
+
+    const BundleEntry *entries = reinterpret_cast<const BundleEntry *>(mFile.getData() + mHeader->TocOffset);
+    const c8 *names = reinterpret_cast<const c8 *>(mFile.getData() + mHeader->NamesOffset);
+    for (ui32 i = 0; i < mHeader->NumEntries; ++i) {
+        const BundleEntry &entry = entries[i];
+        if (0 == entry.NameLength || !isRange(entry.NameOffset, entry.NameLength, mHeader->NamesSize) ||
+                entry.Compression >= static_cast<ui32>(BundleCompression::Count) || 0 != entry.Offset % alignment ||
+                !isRange(entry.Offset, entry.Size, fileSize)) {
+            return false;
+        }
+        if (static_cast<ui32>(BundleCompression::None) == entry.Compression && entry.Size != entry.UncompressedSize) {
+            return false;
+        }
+
+        // The names must be sorted and unique
+        if (i > 0) {
+            const BundleEntry &prev = entries[i - 1];
+            const String prevName(names + prev.NameOffset, prev.NameLength);
+            if (compareName(names + entry.NameOffset, entry.NameLength, prevName) <= 0) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+const c8 *BundleArchive::getNames() const {
+    return reinterpret_cast<const c8 *>(mFile.getData() + mHeader->NamesOffset);
+}
+
+const BundleEntry &BundleArchive::getEntry(size_t index) const {
+    osre_assert(index < getNumEntries());
+
+    return mEntries[index];
+}
+
+String BundleArchive::getName(const BundleEntry &entry) const {
+    if (nullptr == mHeader) {
+        return String();
+    }
+
+    return String(getNames() + entry.NameOffset, entry.NameLength);
+}
+
+const BundleEntry *BundleArchive::find(const String &name) const {
+    if (nullptr == mHeader) {
+        return nullptr;
+    }
+
+    const c8 *names = getNames();
+    size_t first = 0, last = mHeader->NumEntries;
+    while (first < last) {
+        const size_t mid = first + (last - first) / 2;
+        const BundleEntry &entry = mEntries[mid];
+        const i32 result = compareName(names + entry.NameOffset, entry.NameLength, name);
+        if (0 == result) {
+            return &entry;
+        }
+        if (result < 0) {
+            first = mid + 1;
+        } else {
+            last = mid;
+        }
+    }
+
+    return nullptr;
+}
+
+const uc8 *BundleArchive::getData(const BundleEntry &entry) const {
+    if (nullptr == mHeader) {
+        return nullptr;
+    }
+
+    return mFile.getData() + entry.Offset;
+}
+
+bool BundleArchive::read(const BundleEntry &entry, uc8 *buffer, size_t size) const {
+    if (nullptr == mHeader || size < entry.UncompressedSize || (nullptr == buffer && 0 != entry.UncompressedSize)) {
+        return false;
+    }
+
+    const uc8 *data = getData(entry);
+    switch (static_cast<BundleCompression>(entry.Compression)) {
+        case BundleCompression::None:
+            if (0 != entry.Size) {
+                ::memcpy(buffer, data, static_cast<size_t>(entry.Size));
+            }
+            return true;
+
+        case BundleCompression::Deflate: {
+            uLongf uncompressedSize = static_cast<uLongf>(entry.UncompressedSize);
+            if (Z_OK != ::uncompress(buffer, &uncompressedSize, data, static_cast<uLong>(entry.Size)) ||
+                    uncompressedSize != entry.UncompressedSize) {
+                osre_error(Tag, "Cannot decompress entry " + getName(entry));
+                return false;
+            }
+            return true;
+        }
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+} // Namespace IO
+} // Namespace OSRE
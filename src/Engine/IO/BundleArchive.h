@@ -0,0 +1,216 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "IO/IOCommon.h"
+#include "IO/MemoryMappedFile.h"
+
+#include <vector>
+
+namespace OSRE {
+namespace IO {
+
+/// @brief The compression of a bundle entry.
+enum class BundleCompression : ui32 {
+    None = 0,       ///< The entry is stored, it can be used directly from the mapping.
+    Deflate,        ///< The entry is compressed with zlib.
+    Count           ///< Number of enums.
+};
+
+/// @brief The header of a bundle archive, the table of contents and the names are stored behind it.
+struct BundleArchiveHeader {
+    c8 Magic[4];
+    ui32 Version;
+    ui32 NumEntries;
+    ui32 Alignment;         ///< The alignment of the entry data in bytes.
+    ui64 TocOffset;         ///< The offset of the entries from the file start.
+    ui64 NamesOffset;       ///< The offset of the names from the file start.
+    ui64 NamesSize;         ///< The size of the names in bytes.
+};
+
+/// @brief An entry of the table of contents, the entries are sorted by their name.
+struct BundleEntry {
+    ui32 NameOffset;        ///< The offset of the name, relative to the names.
+    ui32 NameLength;        ///< The length of the name.
+    ui32 Compression;       ///< The compression, see BundleCompression.
+    ui32 Padding;
+    ui64 Offset;            ///< The offset of the data from the file start.
+    ui64 Size;              ///< The stored size in bytes.
+    ui64 UncompressedSize;  ///< The size after the decompression in bytes.
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class packs files into a bundle archive.
+///
+/// Every entry can be compressed on its own, entries which do not get smaller are stored. The data of
+/// all entries is aligned, so stored entries can be used directly from a memory mapping.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT BundleArchiveWriter {
+public:
+    /// The default alignment of the entry data.
+    static constexpr ui32 DefaultAlignment = 16;
+
+    /// @brief The class constructor.
+    /// @param[in] alignment    The alignment of the entry data, must be a power of two.
+    explicit BundleArchiveWriter(ui32 alignment = DefaultAlignment);
+
+    /// @brief The class destructor.
+    ~BundleArchiveWriter() = default;
+
+    /// @brief Will add an entry, the data will be copied.
+    /// @param[in] name         The entry name, like "models/house.obj".
+    /// @param[in] data         The data.
+    /// @param[in] size         The size in bytes.
+    /// @param[in] compression  The requested compression.
+    /// @return false if the name is empty or used already, or the compression failed.
+    bool add(const String &name, const void *data, size_t size, BundleCompression compression);
+
+    /// @brief Will add the content of a file.
+    /// @param[in] name         The entry name.
+    /// @param[in] filename     The file to read.
+    /// @param[in] compression  The requested compression.
+    /// @return false if the file cannot be read or the entry cannot be added.
+    bool addFile(const String &name, const String &filename, BundleCompression compression);
+
+    /// @brief Will return the number of entries.
+    /// @return The number of entries.
+    size_t getNumEntries() const;
+
+    /// @brief Will write the archive.
+    /// @param[in] filename     The archive file.
+    /// @return true if successful.
+    bool write(const String &filename) const;
+
+    OSRE_NON_COPYABLE(BundleArchiveWriter)
+
+private:
+    struct PendingEntry {
+        String Name;
+        BundleCompression Compression;
+        ui64 UncompressedSize;
+        std::vector<uc8> Data;
+    };
+
+    ui32 mAlignment;
+    std::vector<PendingEntry> mEntries;
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class reads a bundle archive from a memory mapping.
+///
+/// Opening an archive will only validate the table of contents, the entries are read on demand. An
+/// open archive is not modified anymore, so entries can be read from several threads.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT BundleArchive {
+public:
+    /// The version of the file layout.
+    static constexpr ui32 Version = 1;
+
+    /// @brief The default class constructor.
+    BundleArchive();
+
+    /// @brief The class destructor.
+    ~BundleArchive() = default;
+
+    /// @brief Will open an archive.
+    /// @param[in] filename     The archive file.
+    /// @return true if the archive is valid.
+    bool open(const String &filename);
+
+    /// @brief Will close the archive.
+    void close();
+
+    /// @brief Will return true, if a valid archive is open.
+    /// @return true if open.
+    bool isOpen() const;
+
+    /// @brief Will return the file of the archive.
+    /// @return The filename, empty if no archive is open.
+    const String &getFilename() const;
+
+    /// @brief Will return the number of entries.
+    /// @return The number of entries.
+    size_t getNumEntries() const;
+
+    /// @brief Will return an entry.
+    /// @param[in] index    The entry index.
+    /// @return The entry.
+    const BundleEntry &getEntry(size_t index) const;
+
+    /// @brief Will return the name of an entry.
+    /// @param[in] entry    The entry.
+    /// @return The name.
+    String getName(const BundleEntry &entry) const;
+
+    /// @brief Will look up an entry by its name.
+    /// @param[in] name     The entry name.
+    /// @return The entry or nullptr, if there is no such entry.
+    const BundleEntry *find(const String &name) const;
+
+    /// @brief Will return the stored data of an entry, it is read from the mapping.
+    /// @param[in] entry    The entry.
+    /// @return The stored data, still compressed for compressed entries.
+    const uc8 *getData(const BundleEntry &entry) const;
+
+    /// @brief Will read an entry, compressed entries will be decompressed.
+    /// @param[in] entry    The entry.
+    /// @param[out] buffer  The buffer, must hold the uncompressed size.
+    /// @param[in] size     The size of the buffer in bytes.
+    /// @return true if successful.
+    bool read(const BundleEntry &entry, uc8 *buffer, size_t size) const;
+
+    OSRE_NON_COPYABLE(BundleArchive)
+
+private:
+    bool validate() const;
+    const c8 *getNames() const;
+
+private:
+    MemoryMappedFile mFile;
+    String mFilename;
+    const BundleArchiveHeader *mHeader;
+    const BundleEntry *mEntries;
+};
+
+inline bool BundleArchive::isOpen() const {
+    return nullptr != mHeader;
+}
+
+inline const String &BundleArchive::getFilename() const {
+    return mFilename;
+}
+
+inline size_t BundleArchive::getNumEntries() const {
+    return nullptr != mHeader ? mHeader->NumEntries : 0;
+}
+
+inline size_t BundleArchiveWriter::getNumEntries() const {
+    return mEntries.size();
+}
+
+} // Namespace IO
+} // Namespace OSRE
@@ -0,0 +1,283 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "IO/BundleFileSystem.h"
+#include "Common/Logger.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace OSRE {
+namespace IO {
+
+DECL_OSRE_LOG_MODULE(BundleFileSystem)
+
+static constexpr c8 BundleSchema[] = "bundle";
+
+BundleStream::BundleStream(const Uri &uri, const BundleArchive &archive, const BundleEntry &entry) :
+        Stream(uri, AccessMode::ReadAccessBinary),
+        mArchive(archive),
+        mEntry(entry),
+        mBuffer(),
+        mData(nullptr),
+        mPos(0) {
+    // empty
+}
+
+bool BundleStream::canRead() const {
+    return true;
+}
+
+bool BundleStream::canSeek() const {
+    return true;
+}
+
+bool BundleStream::canBeMapped() const {
+    return static_cast<ui32>(BundleCompression::None) == mEntry.Compression;
+}
+
+bool BundleStream::open() {
+    if (isOpen()) {
+        return false;
+    }
+
+    // Stored entries are used from the mapping, the others are decompressed once
+    mPos = 0;
+    if (canBeMapped()) {
+        mData = mArchive.getData(mEntry);
+        return nullptr != mData;
+    }
+
+    mBuffer.resize(static_cast<size_t>(mEntry.UncompressedSize));
+    if (!mArchive.read(mEntry, mBuffer.data(), mBuffer.size())) {
+        mBuffer.clear();
+        return false;
+    }
+    mData = mBuffer.data();
+
+    return true;
+}
+
+bool BundleStream::close() {
+    if (!isOpen()) {
+        return false;
+    }
+
+    mData = nullptr;
+    mPos = 0;
+    std::vector<uc8>().swap(mBuffer);
+
+    return true;
+}
+
+size_t BundleStream::getSize() const {
+    return static_cast<size_t>(mEntry.UncompressedSize);
+}
+
+size_t BundleStream::read(void *buffer, size_t size) {
+    if (!isOpen() || nullptr == buffer) {
+        return 0;
+    }
+
+    const size_t numBytes = std::min(size, getSize() - mPos);
+    if (numBytes > 0) {
+        ::memcpy(buffer, mData + mPos, numBytes);
+        mPos += numBytes;
+    }
+
+    return numBytes;
+}
+
+size_t BundleStream::readI32(i32 &value) {
+    return read(&value, sizeof(i32));
+}
+
+size_t BundleStream::readUI32(ui32 &value) {
+    return read(&value, sizeof(ui32));
+}
+
+size_t BundleStream::readF32(f32 &value) {
+    return read(&value, sizeof(f32));
+}
+
+size_t BundleStream::readD32(d32 &value) {
+    return read(&value, sizeof(d32));
+}
+
+Stream::Position BundleStream::seek(Offset offset, Origin origin) {
+    // The offset is clamped to the entry
+    size_t pos = offset;
+    if (Origin::Current == origin) {
+        pos = mPos + offset;
+    } else if (Origin::End == origin) {
+        pos = getSize() - std::min(static_cast<size_t>(offset), getSize());
+    }
+    mPos = std::min(pos, getSize());
+
+    return static_cast<Position>(mPos);
+}
+
+Stream::Position BundleStream::tell() {
+    return static_cast<Position>(mPos);
+}
+
+bool BundleStream::isOpen() const {
+    return nullptr != mData;
+}
+
+const uc8 *BundleStream::getData() const {
+    return mData;
+}
+
+BundleFileSystem::~BundleFileSystem() {
+    for (ArchiveMap::iterator it = mArchives.begin(); it != mArchives.end(); ++it) {
+        delete it->second;
+    }
+    mArchives.clear();
+}
+
+bool BundleFileSystem::mount(const String &name, const String &filename) {
+    if (name.empty() || mArchives.end() != mArchives.find(name)) {
+        osre_error(Tag, "Cannot mount bundle " + filename + " as " + name);
+        return false;
+    }
+
+    auto *archive = new BundleArchive;
+    if (!archive->open(filename)) {
+        delete archive;
+        return false;
+    }
+    mArchives[name] = archive;
+    osre_debug(Tag, "Mounted bundle " + filename + " as " + name);
+
+    return true;
+}
+
+void BundleFileSystem::unmount(const String &name) {
+    ArchiveMap::iterator it = mArchives.find(name);
+    if (mArchives.end() == it) {
+        return;
+    }
+
+    delete it->second;
+    mArchives.erase(it);
+}
+
+const BundleArchive *BundleFileSystem::getArchive(const String &name) const {
+    ArchiveMap::const_iterator it = mArchives.find(name);
+
+    return mArchives.end() != it ? it->second : nullptr;
+}
+
+bool BundleFileSystem::splitUri(const Uri &file, String &bundle, String &entry) {
+    String path = file.getAbsPath();
+    normalizeFilename(path);
+    const String::size_type pos = path.find('/');
+    if (String::npos == pos || 0 == pos || pos + 1 == path.size()) {
+        return false;
+    }
+
+    bundle = path.substr(0, pos);
+    entry = path.substr(pos + 1);
+
+    return true;
+}
+
+const BundleEntry *BundleFileSystem::findEntry(const Uri &file, const BundleArchive **archive) const {
+    String bundleName, entryName;
+    if (!splitUri(file, bundleName, entryName)) {
+        return nullptr;
+    }
+
+    const BundleArchive *bundle = getArchive(bundleName);
+    if (nullptr == bundle) {
+        return nullptr;
+    }
+    if (nullptr != archive) {
+        *archive = bundle;
+    }
+
+    return bundle->find(entryName);
+}
+
+Stream *BundleFileSystem::open(const Uri &file, Stream::AccessMode mode) {
+    if (Stream::AccessMode::ReadAccess != mode && Stream::AccessMode::ReadAccessBinary != mode) {
+        osre_error(Tag, "Bundles are read-only, cannot open " + file.getUri());
+        return nullptr;
+    }
+
+    const BundleArchive *archive = nullptr;
+    const BundleEntry *entry = findEntry(file, &archive);
+    if (nullptr == entry) {
+        osre_debug(Tag, "Cannot find " + file.getUri());
+        return nullptr;
+    }
+
+    auto *stream = new BundleStream(file, *archive, *entry);
+    if (!stream->open()) {
+        delete stream;
+        return nullptr;
+    }
+
+    return stream;
+}
+
+void BundleFileSystem::close(Stream **stream) {
+    if (nullptr == stream || nullptr == *stream) {
+        return;
+    }
+
+    (*stream)->close();
+    delete *stream;
+    *stream = nullptr;
+}
+
+bool BundleFileSystem::fileExist(const Uri &file) {
+    return nullptr != findEntry(file, nullptr);
+}
+
+Stream *BundleFileSystem::find(const Uri &file, Stream::AccessMode mode, StringArray *searchPaths) {
+    if (nullptr == searchPaths) {
+        return nullptr;
+    }
+
+    for (const auto &path : *searchPaths) {
+        Uri currentFile(String(BundleSchema) + "://" + path + file.getResource());
+        Stream *stream = open(currentFile, mode);
+        if (nullptr != stream) {
+            return stream;
+        }
+    }
+
+    return nullptr;
+}
+
+const c8 *BundleFileSystem::getSchema() const {
+    return BundleSchema;
+}
+
+String BundleFileSystem::getWorkingDirectory() {
+    return String();
+}
+
+} // Namespace IO
+} // Namespace OSRE
@@ -0,0 +1,134 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "IO/AbstractFileSystem.h"
+#include "IO/BundleArchive.h"
+
+#include <map>
+#include <vector>
+
+namespace OSRE {
+namespace IO {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a read-only stream onto an entry of a bundle archive.
+///
+/// Stored entries are read directly from the memory mapping of the archive, compressed entries will
+/// be decompressed once when the stream is opened.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT BundleStream final : public Stream {
+public:
+    /// @brief The class constructor.
+    /// @param[in] uri      The uri of the entry.
+    /// @param[in] archive  The archive, must stay open while the stream is used.
+    /// @param[in] entry    The entry.
+    BundleStream(const Uri &uri, const BundleArchive &archive, const BundleEntry &entry);
+
+    /// @brief The class destructor.
+    ~BundleStream() override = default;
+
+    bool canRead() const override;
+    bool canSeek() const override;
+    bool canBeMapped() const override;
+    bool open() override;
+    bool close() override;
+    size_t getSize() const override;
+    size_t read(void *buffer, size_t size) override;
+    size_t readI32(i32 &value) override;
+    size_t readUI32(ui32 &value) override;
+    size_t readF32(f32 &value) override;
+    size_t readD32(d32 &value) override;
+    Position seek(Offset offset, Origin origin) override;
+    Position tell() override;
+    bool isOpen() const override;
+
+    /// @brief Will return the whole content of the entry.
+    /// @return The content, nullptr if the stream is not open.
+    const uc8 *getData() const;
+
+private:
+    const BundleArchive &mArchive;
+    const BundleEntry &mEntry;
+    std::vector<uc8> mBuffer;
+    const uc8 *mData;
+    size_t mPos;
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a read-only file system for bundle archives.
+///
+/// Every mounted archive gets a name, the uri bundle://pack/models/house.obj will open the entry
+/// models/house.obj of the archive mounted as pack.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT BundleFileSystem final : public AbstractFileSystem {
+public:
+    /// @brief The default class constructor.
+    BundleFileSystem() = default;
+
+    /// @brief The class destructor, all archives will be unmounted.
+    ~BundleFileSystem() override;
+
+    /// @brief Will open an archive and mount it.
+    /// @param[in] name         The bundle name, the first path component of the uris.
+    /// @param[in] filename     The archive file.
+    /// @return false if the name is used already or the archive is invalid.
+    bool mount(const String &name, const String &filename);
+
+    /// @brief Will unmount an archive, all of its streams must be closed.
+    /// @param[in] name         The bundle name.
+    void unmount(const String &name);
+
+    /// @brief Will return a mounted archive.
+    /// @param[in] name         The bundle name.
+    /// @return The archive or nullptr, if no archive is mounted with this name.
+    const BundleArchive *getArchive(const String &name) const;
+
+    Stream *open(const Uri &file, Stream::AccessMode mode) override;
+    void close(Stream **stream) override;
+    bool fileExist(const Uri &file) override;
+    Stream *find(const Uri &file, Stream::AccessMode mode, StringArray *searchPaths) override;
+    const c8 *getSchema() const override;
+    String getWorkingDirectory() override;
+
+    /// @brief Will split an uri into the bundle name and the entry name.
+    /// @param[in] file         The uri.
+    /// @param[out] bundle      The bundle name.
+    /// @param[out] entry       The entry name.
+    /// @return false if the uri does not name an entry.
+    static bool splitUri(const Uri &file, String &bundle, String &entry);
+
+private:
+    const BundleEntry *findEntry(const Uri &file, const BundleArchive **archive) const;
+
+private:
+    using ArchiveMap = std::map<String, BundleArchive *>;
+    ArchiveMap mArchives;
+};
+
+} // Namespace IO
+} // Namespace OSRE
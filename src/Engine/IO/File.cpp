@@ -22,6 +22,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "IO/File.h"
 #include <cstdio>
+#include <sys/stat.h>
+#include <sys/types.h>
 
 namespace OSRE {
 namespace IO {
@@ -45,5 +47,25 @@ bool File::exists(const String &filename) {
     return exists;
 }
 
+bool File::getStamp(const String &filename, ui64 &size, i64 &modified) {
+    size = 0;
+    modified = 0;
+#ifdef OSRE_WINDOWS
+    struct __stat64 fileStat;
+    if (0 != _stat64(filename.c_str(), &fileStat)) {
+        return false;
+    }
+#else
+    struct stat fileStat;
+    if (0 != ::stat(filename.c_str(), &fileStat)) {
+        return false;
+    }
+#endif
+    size = static_cast<ui64>(fileStat.st_size);
+    modified = static_cast<i64>(fileStat.st_mtime);
+
+    return true;
+}
+
 } // namespace IO
 } // namespace OSRE
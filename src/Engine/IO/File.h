@@ -44,6 +44,13 @@ public:
     /// @param[in] filename     The filename.
     /// @return true, ig the file exists.
     static bool exists(const String &filename);
+
+    /// @brief Will return the size and the time of the last modification of a file.
+    /// @param[in]  filename    The filename.
+    /// @param[out] size        The size in bytes.
+    /// @param[out] modified    The time of the last modification in seconds.
+    /// @return true, if the file exists.
+    static bool getStamp(const String &filename, ui64 &size, i64 &modified);
 };
 
 } // namespace IO
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "IO/IOService.h"
 #include "Common/Tokenizer.h"
 #include "Common/Logger.h"
+#include "IO/BundleFileSystem.h"
 #include "IO/LocaleFileSystem.h"
 
 IMPLEMENT_SINGLETON( ::OSRE::IO::IOService )
@@ -34,7 +35,7 @@ using namespace OSRE::Common;
 
 static constexpr c8 Tag[] = "IOService";
 
-IOService::IOService() : AbstractService("io/ioserver"), mMountedMap() {
+IOService::IOService() : AbstractService("io/ioserver"), mMountedMap(), mBundleFileSystem(nullptr) {
     CREATE_SINGLETON( IOService );
 
 //    mMountedMap["file"] = new LocaleFileSystem();
@@ -50,6 +51,10 @@ bool IOService::onOpen() {
     pFileSystem = new LocaleFileSystem;
     mountFileSystem( pFileSystem->getSchema(), pFileSystem );
 
+    // the archives will be mounted into the bundle file system later on
+    mBundleFileSystem = new BundleFileSystem;
+    mountFileSystem( mBundleFileSystem->getSchema(), mBundleFileSystem );
+
     return true;
 }
 
@@ -57,6 +62,9 @@ bool IOService::onClose() {
     for (MountedMap::iterator it = mMountedMap.begin(); it != mMountedMap.end(); ++it) {
         delete it->second;
     }
+    mMountedMap.clear();
+    mBundleFileSystem = nullptr;
+
     return true;
 }
 
@@ -76,6 +84,28 @@ void IOService::umountFileSystem( const String &schema, AbstractFileSystem *file
     if (it->second == fileSystem) {
         mMountedMap.erase(it);
     }
+    if (mBundleFileSystem == fileSystem) {
+        mBundleFileSystem = nullptr;
+    }
+}
+
+bool IOService::mountBundle( const String &name, const String &filename ) {
+    if (nullptr == mBundleFileSystem) {
+        osre_error(Tag, "Cannot mount bundle " + filename + ", the service is not open.");
+        return false;
+    }
+
+    return mBundleFileSystem->mount( name, filename );
+}
+
+void IOService::unmountBundle( const String &name ) {
+    if (nullptr != mBundleFileSystem) {
+        mBundleFileSystem->unmount( name );
+    }
+}
+
+BundleFileSystem *IOService::getBundleFileSystem() const {
+    return mBundleFileSystem;
 }
 
 Stream *IOService::openStream(const Uri &file, Stream::AccessMode mode) {
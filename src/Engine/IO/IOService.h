@@ -31,6 +31,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace OSRE {
 namespace IO {
 
+class BundleFileSystem;
+
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
@@ -78,6 +80,20 @@ public:
     /// @param  stream      [in] The pointer to the stream pointer, will be nullptr afterwards.
     void closeStream( Stream **stream );
 
+    /// @brief  Will mount a bundle archive into the bundle file system.
+    /// @param  name        [in] The bundle name, bundle://<name>/ will open the entries of the archive.
+    /// @param  filename    [in] The archive file.
+    /// @return false if the service is not open, the name is in use or the archive is invalid.
+    bool mountBundle( const String &name, const String &filename );
+
+    /// @brief  Will unmount a bundle archive, all of its streams must be closed.
+    /// @param  name        [in] The bundle name.
+    void unmountBundle( const String &name );
+
+    /// @brief  Will return the file system of the mounted bundle archives.
+    /// @return The bundle file system, nullptr if the service is not open.
+    BundleFileSystem *getBundleFileSystem() const;
+
     ///	@brief	Returns the assigned file system to a schema.
     ///	@param	schema		[in] The schema description of the mounted file system.
     ///	@return	A pointer showing to the file system or NULL, if no file system is mounted 
@@ -96,6 +112,7 @@ public:
 private:
     using MountedMap = std::map<String, AbstractFileSystem*> ;
     MountedMap mMountedMap;
+    BundleFileSystem *mBundleFileSystem;
 };
 
 } // Namespace IO
@@ -0,0 +1,144 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "IO/MemoryMappedFile.h"
+#include "Common/Logger.h"
+
+#ifdef OSRE_WINDOWS
+#    include "Platform/Windows/MinWindows.h"
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif // OSRE_WINDOWS
+
+namespace OSRE {
+namespace IO {
+
+DECL_OSRE_LOG_MODULE(MemoryMappedFile)
+
+MemoryMappedFile::MemoryMappedFile() :
+        mData(nullptr),
+        mSize(0)
+#ifdef OSRE_WINDOWS
+        ,
+        mFile(nullptr),
+        mMapping(nullptr)
+#endif // OSRE_WINDOWS
+{
+    // empty
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    close();
+}
+
+bool MemoryMappedFile::open(const String &filename) {
+    if (isOpen()) {
+        osre_debug(Tag, "File is already mapped.");
+        return false;
+    }
+
+    if (filename.empty()) {
+        osre_debug(Tag, "Filename is empty.");
+        return false;
+    }
+
+#ifdef OSRE_WINDOWS
+    HANDLE file = ::CreateFile(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+            FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == file) {
+        osre_error(Tag, "Cannot open " + filename);
+        return false;
+    }
+
+    LARGE_INTEGER size;
+    if (FALSE == ::GetFileSizeEx(file, &size) || 0 == size.QuadPart) {
+        ::CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = ::CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (nullptr == mapping) {
+        ::CloseHandle(file);
+        osre_error(Tag, "Cannot map " + filename);
+        return false;
+    }
+
+    void *data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (nullptr == data) {
+        ::CloseHandle(mapping);
+        ::CloseHandle(file);
+        osre_error(Tag, "Cannot map " + filename);
+        return false;
+    }
+    mFile = file;
+    mMapping = mapping;
+    mSize = static_cast<size_t>(size.QuadPart);
+#else
+    const int file = ::open(filename.c_str(), O_RDONLY);
+    if (-1 == file) {
+        osre_error(Tag, "Cannot open " + filename);
+        return false;
+    }
+
+    struct stat info;
+    if (-1 == ::fstat(file, &info) || 0 == info.st_size) {
+        ::close(file);
+        return false;
+    }
+
+    // The mapping stays valid after the descriptor was closed
+    void *data = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    ::close(file);
+    if (MAP_FAILED == data) {
+        osre_error(Tag, "Cannot map " + filename);
+        return false;
+    }
+    mSize = static_cast<size_t>(info.st_size);
+#endif // OSRE_WINDOWS
+    mData = static_cast<const uc8 *>(data);
+
+    return true;
+}
+
+void MemoryMappedFile::close() {
+    if (!isOpen()) {
+        return;
+    }
+
+#ifdef OSRE_WINDOWS
+    ::UnmapViewOfFile(mData);
+    ::CloseHandle(mMapping);
+    ::CloseHandle(mFile);
+    mMapping = nullptr;
+    mFile = nullptr;
+#else
+    ::munmap(const_cast<uc8 *>(mData), mSize);
+#endif // OSRE_WINDOWS
+    mData = nullptr;
+    mSize = 0;
+}
+
+} // Namespace IO
+} // Namespace OSRE
@@ -0,0 +1,90 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "IO/IOCommon.h"
+
+namespace OSRE {
+namespace IO {
+
+//--------------------------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief	This class maps a whole file read-only into the address space.
+///
+/// The pages will be loaded by the operating system on the first access, so even very large files can be
+/// opened without reading them.
+//--------------------------------------------------------------------------------------------------------------------
+class OSRE_EXPORT MemoryMappedFile {
+public:
+    /// @brief  The class constructor.
+    MemoryMappedFile();
+
+    /// @brief  The class destructor, an open mapping will be closed.
+    ~MemoryMappedFile();
+
+    /// @brief  Will map the file.
+    /// @param[in] filename     The name of the file.
+    /// @return true, if successful, false if the file cannot be mapped or is empty.
+    bool open(const String &filename);
+
+    /// @brief  Will release the mapping.
+    void close();
+
+    /// @brief  Will return true, if a file is mapped.
+    /// @return true for mapped.
+    bool isOpen() const;
+
+    /// @brief  Will return the mapped data.
+    /// @return The data or nullptr, if no file is mapped.
+    const uc8 *getData() const;
+
+    /// @brief  Will return the size of the mapped file.
+    /// @return The size in bytes.
+    size_t getSize() const;
+
+    OSRE_NON_COPYABLE(MemoryMappedFile)
+
+private:
+    const uc8 *mData;
+    size_t mSize;
+#ifdef OSRE_WINDOWS
+    void *mFile;
+    void *mMapping;
+#endif // OSRE_WINDOWS
+};
+
+inline bool MemoryMappedFile::isOpen() const {
+    return nullptr != mData;
+}
+
+inline const uc8 *MemoryMappedFile::getData() const {
+    return mData;
+}
+
+inline size_t MemoryMappedFile::getSize() const {
+    return mSize;
+}
+
+} // Namespace IO
+} // Namespace OSRE
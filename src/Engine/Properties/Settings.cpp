@@ -58,7 +58,8 @@ static const c8 *ConfigKeyStringTable[Settings::MaxKonfigKey] = {
     "PollingMode",
     "DefaultFont",
     "RenderMode",
-    "PluginDllName"
+    "PluginDllName",
+    "OcclusionCulling"
 };
 
 Settings::Settings() :
@@ -231,6 +232,9 @@ void Settings::initDefaults() {
 
     value.setInt( 1 );
     mPropertyMap->setProperty( RenderMode, ConfigKeyStringTable[ RenderMode], value );
+
+    value.setBool( false );
+    mPropertyMap->setProperty( OcclusionCulling, ConfigKeyStringTable[ OcclusionCulling ], value );
 }
 
 } // Namespace Properties
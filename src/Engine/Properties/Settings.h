@@ -70,6 +70,7 @@ public:
         DefaultFont,            ///< The default font for rendering.
         RenderMode,             ///< The requested render mode (2D or 3D, default 3D).
         PluginDllName,          ///< The name for the child application.
+        OcclusionCulling,       ///< The option for the hierarchical-z occlusion culling.
         MaxKonfigKey			///< The upper limit.
     };
 
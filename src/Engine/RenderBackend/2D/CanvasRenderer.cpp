@@ -26,6 +26,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "RenderBackend/MaterialBuilder.h"
 #include "RenderBackend/FontService.h"
 #include "RenderBackend/Mesh/MeshUtilities.h"
+#include "Common/BatchMath.h"
 #include "Common/Logger.h"
 #include "Debugging/MeshDiagnostic.h"
 
@@ -38,7 +39,8 @@ using namespace cppcore;
 
 static constexpr c8 Tag[] = "CanvasRenderer";
 
-// will rescale coordinates from absolute coordinates into model space coordinates
+// will rescale coordinates from absolute coordinates into model space coordinates, the vertices of
+// the draw commands will be rescaled in one batch when rendering
 inline void mapCoordinates(const Rect2i &resolution, i32 x, i32 y, f32 &xOut, f32 &yOut) {
     xOut = (2.0f * static_cast<f32>(x)  / static_cast<f32>(resolution.width)) - 1.0f;
     yOut = (2.0f * static_cast<f32>(y) / static_cast<f32>(resolution.height)) - 1.0f;
@@ -67,52 +69,45 @@ inline void clip(const Rect2i &resolution, i32 x, i32 y, i32 &x_out, i32 &y_out)
 
 static void createRectVertices(DrawCmd *drawCmd, const Color4 &penColor, const Rect2i &resolution, i32 x, i32 y, i32 w, i32 h, i32 layer) {
     i32 x_clipped{0}, y_clipped{0};
-    f32 x_model{0.f}, y_model{0.f};
 
     drawCmd->PrimType = PrimitiveType::TriangleList;
     drawCmd->NumVertices = 6;
     drawCmd->Vertices = new RenderVert[drawCmd->NumVertices];
 
     clip(resolution, x, y, x_clipped, y_clipped);
-    mapCoordinates(resolution, x_clipped, y_clipped, x_model, y_model);
     drawCmd->Vertices[0].color0 = penColor.toVec4();
-    drawCmd->Vertices[0].position.x = x_model;
-    drawCmd->Vertices[0].position.y = y_model;
+    drawCmd->Vertices[0].position.x = static_cast<f32>(x_clipped);
+    drawCmd->Vertices[0].position.y = static_cast<f32>(y_clipped);
     drawCmd->Vertices[0].position.z = static_cast<f32>(-layer);
 
     clip(resolution, x+w, y, x_clipped, y_clipped);
-    mapCoordinates(resolution, x_clipped, y_clipped, x_model, y_model);
     drawCmd->Vertices[1].color0 = penColor.toVec4();
-    drawCmd->Vertices[1].position.x = x_model;
-    drawCmd->Vertices[1].position.y = y_model;
+    drawCmd->Vertices[1].position.x = static_cast<f32>(x_clipped);
+    drawCmd->Vertices[1].position.y = static_cast<f32>(y_clipped);
     drawCmd->Vertices[1].position.z = static_cast<f32>(-layer);
 
     clip(resolution, x+w, y+h, x_clipped, y_clipped);
-    mapCoordinates(resolution, x_clipped, y_clipped, x_model, y_model);
     drawCmd->Vertices[2].color0 = penColor.toVec4();
-    drawCmd->Vertices[2].position.x = x_model;
-    drawCmd->Vertices[2].position.y = y_model;
+    drawCmd->Vertices[2].position.x = static_cast<f32>(x_clipped);
+    drawCmd->Vertices[2].position.y = static_cast<f32>(y_clipped);
     drawCmd->Vertices[2].position.z = static_cast<f32>(-layer);
 
     clip(resolution, x+w, y+h, x_clipped, y_clipped);
-    mapCoordinates(resolution, x_clipped, y_clipped, x_model, y_model);
     drawCmd->Vertices[3].color0 = penColor.toVec4();
-    drawCmd->Vertices[3].position.x = x_model;
-    drawCmd->Vertices[3].position.y = y_model;
+    drawCmd->Vertices[3].position.x = static_cast<f32>(x_clipped);
+    drawCmd->Vertices[3].position.y = static_cast<f32>(y_clipped);
     drawCmd->Vertices[3].position.z = static_cast<f32>(-layer);
 
     clip(resolution, x, y+h, x_clipped, y_clipped);
-    mapCoordinates(resolution, x_clipped, y_clipped, x_model, y_model);
     drawCmd->Vertices[4].color0 = penColor.toVec4();
-    drawCmd->Vertices[4].position.x = x_model;
-    drawCmd->Vertices[4].position.y = y_model;
+    drawCmd->Vertices[4].position.x = static_cast<f32>(x_clipped);
+    drawCmd->Vertices[4].position.y = static_cast<f32>(y_clipped);
     drawCmd->Vertices[4].position.z = static_cast<f32>(-layer);
 
     clip(resolution, x, y, x_clipped, y_clipped);
-    mapCoordinates(resolution, x_clipped, y_clipped, x_model, y_model);
     drawCmd->Vertices[5].color0 = penColor.toVec4();
-    drawCmd->Vertices[5].position.x = x_model;
-    drawCmd->Vertices[5].position.y = y_model;
+    drawCmd->Vertices[5].position.x = static_cast<f32>(x_clipped);
+    drawCmd->Vertices[5].position.y = static_cast<f32>(y_clipped);
     drawCmd->Vertices[5].position.z = static_cast<f32>(-layer);
 
     drawCmd->NumIndices = 6;
@@ -216,6 +211,8 @@ void CanvasRenderer::render(RenderBackendService *rbSrv) {
 
         const ui32 lastIndex = mMesh->getLastIndex();
         renumberIndices(dc, numVertices);
+        Common::BatchMath::mapToClipSpace(&dc.Vertices[0].position.x, sizeof(RenderVert), dc.NumVertices,
+                static_cast<f32>(mResolution.width), static_cast<f32>(mResolution.height));
 
         mMesh->attachVertices(dc.Vertices, dc.NumVertices * sizeof(RenderVert));
         mMesh->attachIndices(dc.Indices, dc.NumIndices * sizeof(ui16));
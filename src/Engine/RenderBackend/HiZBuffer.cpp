@@ -0,0 +1,168 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "RenderBackend/HiZBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace OSRE::RenderBackend {
+
+using namespace ::OSRE::Common;
+
+HiZBuffer::HiZBuffer() :
+        mLock(),
+        mDepth(),
+        mLevels(),
+        mViewProjection(1.0f) {
+    // empty
+}
+
+void HiZBuffer::build(const f32 *depth, ui32 width, ui32 height, const glm::mat4 &viewProjection) {
+    if (depth == nullptr || width == 0 || height == 0) {
+        return;
+    }
+
+    mLock.enter();
+    mViewProjection = viewProjection;
+    mLevels.resize(0);
+
+    // Reserve the whole chain up front, the levels are stored one after the other
+    size_t total = 0;
+    for (ui32 w = width, h = height;; w = std::max(1u, (w + 1) / 2), h = std::max(1u, (h + 1) / 2)) {
+        mLevels.add({ total, w, h });
+        total += static_cast<size_t>(w) * h;
+        if (w == 1 && h == 1) {
+            break;
+        }
+    }
+    mDepth.resize(total);
+    ::memcpy(&mDepth[0], depth, sizeof(f32) * width * height);
+
+    for (size_t l = 1; l < mLevels.size(); ++l) {
+        const Level &src = mLevels[l - 1];
+        const Level &dst = mLevels[l];
+        const f32 *in = &mDepth[src.mOffset];
+        f32 *out = &mDepth[dst.mOffset];
+        for (ui32 y = 0; y < dst.mHeight; ++y) {
+            const ui32 y0 = std::min(y * 2, src.mHeight - 1);
+            const ui32 y1 = std::min(y * 2 + 1, src.mHeight - 1);
+            for (ui32 x = 0; x < dst.mWidth; ++x) {
+                const ui32 x0 = std::min(x * 2, src.mWidth - 1);
+                const ui32 x1 = std::min(x * 2 + 1, src.mWidth - 1);
+                const f32 d0 = std::max(in[y0 * src.mWidth + x0], in[y0 * src.mWidth + x1]);
+                const f32 d1 = std::max(in[y1 * src.mWidth + x0], in[y1 * src.mWidth + x1]);
+                out[y * dst.mWidth + x] = std::max(d0, d1);
+            }
+        }
+    }
+    mLock.leave();
+}
+
+bool HiZBuffer::isVisible(const AABB &aabb) const {
+    if (!aabb.isValid()) {
+        return true;
+    }
+
+    mLock.enter();
+    if (mLevels.isEmpty()) {
+        mLock.leave();
+        return true;
+    }
+
+    const glm::vec3 &bbMin = aabb.getMin();
+    const glm::vec3 &bbMax = aabb.getMax();
+    glm::vec3 ndcMin(1.0f), ndcMax(-1.0f);
+    for (ui32 i = 0; i < 8; ++i) {
+        const glm::vec4 corner((i & 1) ? bbMax.x : bbMin.x, (i & 2) ? bbMax.y : bbMin.y, (i & 4) ? bbMax.z : bbMin.z, 1.0f);
+        const glm::vec4 clip = mViewProjection * corner;
+
+        // Boxes crossing the near plane cannot be projected, they are treated as visible
+        if (clip.w <= 1.0e-5f) {
+            mLock.leave();
+            return true;
+        }
+        const glm::vec3 ndc(clip.x / clip.w, clip.y / clip.w, clip.z / clip.w);
+        ndcMin = glm::min(ndcMin, ndc);
+        ndcMax = glm::max(ndcMax, ndc);
+    }
+
+    // Nothing is known about regions outside of the last frustum
+    if (ndcMax.x < -1.0f || ndcMin.x > 1.0f || ndcMax.y < -1.0f || ndcMin.y > 1.0f || ndcMin.z > 1.0f) {
+        mLock.leave();
+        return true;
+    }
+
+    const Level &base = mLevels[0];
+    const f32 x0 = (std::max(ndcMin.x, -1.0f) * 0.5f + 0.5f) * base.mWidth;
+    const f32 x1 = (std::min(ndcMax.x, 1.0f) * 0.5f + 0.5f) * base.mWidth;
+    const f32 y0 = (std::max(ndcMin.y, -1.0f) * 0.5f + 0.5f) * base.mHeight;
+    const f32 y1 = (std::min(ndcMax.y, 1.0f) * 0.5f + 0.5f) * base.mHeight;
+    const f32 minDepth = std::max(ndcMin.z, -1.0f) * 0.5f + 0.5f;
+
+    // Select the level, where the rectangle covers at most 2x2 texels
+    const f32 extent = std::max(std::max(x1 - x0, y1 - y0), 1.0f);
+    size_t level = static_cast<size_t>(std::ceil(std::log2(extent)));
+    level = std::min(level, mLevels.size() - 1);
+
+    const ui32 px0 = std::min(static_cast<ui32>(x0), base.mWidth - 1);
+    const ui32 px1 = std::min(static_cast<ui32>(x1), base.mWidth - 1);
+    const ui32 py0 = std::min(static_cast<ui32>(y0), base.mHeight - 1);
+    const ui32 py1 = std::min(static_cast<ui32>(y1), base.mHeight - 1);
+    const Level &lvl = mLevels[level];
+    const f32 *texels = &mDepth[lvl.mOffset];
+    f32 maxDepth = 0.0f;
+    for (ui32 y = py0 >> level; y <= (py1 >> level); ++y) {
+        for (ui32 x = px0 >> level; x <= (px1 >> level); ++x) {
+            maxDepth = std::max(maxDepth, texels[y * lvl.mWidth + x]);
+        }
+    }
+    mLock.leave();
+
+    return minDepth <= maxDepth;
+}
+
+bool HiZBuffer::isValid() const {
+    mLock.enter();
+    const bool valid = !mLevels.isEmpty();
+    mLock.leave();
+
+    return valid;
+}
+
+size_t HiZBuffer::getNumLevels() const {
+    mLock.enter();
+    const size_t numLevels = mLevels.size();
+    mLock.leave();
+
+    return numLevels;
+}
+
+void HiZBuffer::clear() {
+    mLock.enter();
+    mLevels.resize(0);
+    mDepth.resize(0);
+    mLock.leave();
+}
+
+} // namespace OSRE::RenderBackend
@@ -0,0 +1,93 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+#include "Common/glm_common.h"
+#include "Common/TAABB.h"
+#include "Platform/Threading.h"
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a hierarchical depth buffer for occlusion queries.
+///
+/// The pyramid will be built from a depth buffer readback, each level stores the farthest depth
+/// of the 2x2 texels of its predecessor. A bounding box is occluded when its nearest depth is
+/// behind the farthest depth of all texels it covers. The test uses the view-projection which
+/// was active when the depth was rendered, so results of the last frame can be used in the next
+/// one. The pyramid will be written by the render thread and tested by the application thread.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT HiZBuffer {
+public:
+    /// @brief The class constructor.
+    HiZBuffer();
+
+    /// @brief The class destructor.
+    ~HiZBuffer() = default;
+
+    /// @brief Will build the pyramid from a depth buffer.
+    /// @param[in] depth            The window depth values in [0, 1], rows starting at the bottom.
+    /// @param[in] width            The width of the depth buffer.
+    /// @param[in] height           The height of the depth buffer.
+    /// @param[in] viewProjection   The view-projection matrix used to render the depth.
+    void build(const f32 *depth, ui32 width, ui32 height, const glm::mat4 &viewProjection);
+
+    /// @brief Will test a bounding box against the pyramid.
+    /// @param[in] aabb     The bounding box in world space.
+    /// @return true, if the box may be visible, false if it is occluded for sure.
+    bool isVisible(const Common::AABB &aabb) const;
+
+    /// @brief Will return true, if a pyramid was built.
+    /// @return true, if valid.
+    bool isValid() const;
+
+    /// @brief Will return the number of levels in the pyramid.
+    /// @return The number of levels.
+    size_t getNumLevels() const;
+
+    /// @brief Will clear the pyramid, all boxes will be visible afterwards.
+    void clear();
+
+    OSRE_NON_COPYABLE(HiZBuffer)
+
+private:
+    struct Level {
+        size_t mOffset;
+        ui32 mWidth;
+        ui32 mHeight;
+    };
+
+    mutable Platform::CriticalSection mLock;
+    cppcore::TArray<f32> mDepth;
+    cppcore::TArray<Level> mLevels;
+    glm::mat4 mViewProjection;
+};
+
+} // Namespace RenderBackend
+} // Namespace OSRE
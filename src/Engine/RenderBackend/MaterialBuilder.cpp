@@ -104,6 +104,145 @@ Material *MaterialBuilder::create2DMaterial() {
     return mat;
 }
 
+static constexpr c8 ParticleMat[] = "particle_mat";
+
+Material *MaterialBuilder::createParticleMaterial() {
+    MaterialCache *materialCache = sData->mMaterialCache;
+    Material *mat = materialCache->find(ParticleMat);
+    if (nullptr != mat) {
+        return mat;
+    }
+
+    mat = materialCache->create(ParticleMat);
+    const String shaderName = "particle.sh";
+
+    // texcoord0 stores the age and the lifetime, dead particles will be moved behind the far plane
+    const String vertex_particle =
+            getDefaultGLSLVersion() +
+            getGLSLRenderVertexLayout() +
+            "out vec3 v_color0;\n"
+            "uniform mat4 Model;\n"
+            "uniform mat4 View;\n"
+            "uniform mat4 Projection;\n"
+            "void main() {\n"
+            "    v_color0 = color0;\n"
+            "    if (texcoord0.x >= texcoord0.y) {\n"
+            "        gl_Position = vec4(0.0, 0.0, 2.0, 1.0);\n"
+            "        return;\n"
+            "    }\n"
+            "    mat4 u_mvp = Projection * View * Model;\n"
+            "    gl_Position = u_mvp * vec4(position, 1.0);\n"
+            "}\n";
+
+    const String fragment_particle =
+            getDefaultGLSLVersion() +
+            "in vec3 v_color0;\n"
+            "out vec4 f_color;\n"
+            "void main() {\n"
+            "    f_color = vec4(v_color0, 1.0);\n"
+            "}\n";
+
+    ShaderSourceArray shArray;
+    shArray[static_cast<size_t>(ShaderType::SH_VertexShaderType)] = vertex_particle;
+    shArray[static_cast<size_t>(ShaderType::SH_FragmentShaderType)] = fragment_particle;
+    mat->createShader(shaderName, shArray);
+
+    // Setup shader attributes and variables
+    if (mat->hasShader()) {
+        Shader *shader = mat->getShader();
+        shader->addVertexAttributes(RenderVert::getAttributes(), RenderVert::getNumAttributes());
+        addMaterialParameter(mat);
+    }
+
+    return mat;
+}
+
+Material *MaterialBuilder::createClipmapMaterial(const String &heightMapName, ui32 gridSize) {
+    if (heightMapName.empty() || gridSize == 0) {
+        return nullptr;
+    }
+
+    const String matName = "clipmap_" + heightMapName + "_" + std::to_string(gridSize) + ".mat";
+    MaterialCache *materialCache = sData->mMaterialCache;
+    Material *mat = materialCache->find(matName);
+    if (nullptr != mat) {
+        return mat;
+    }
+
+    mat = materialCache->create(matName);
+    Texture *heightMap = new Texture(heightMapName);
+    heightMap->TargetType = TextureTargetType::Texture2DArray;
+    mat->createTextures(1);
+    mat->setTextureStage(0, heightMap);
+
+    // The position stores the grid coordinate in x and z and the level in y. The texture is
+    // addressed toroidally, so the windows can move without copying the resident samples.
+    const String vertex_clipmap =
+            getDefaultGLSLVersion() +
+            getGLSLRenderVertexLayout() +
+            "out vec3 v_normal;\n"
+            "uniform mat4 Model;\n"
+            "uniform mat4 View;\n"
+            "uniform mat4 Projection;\n"
+            "uniform vec3 " + String(ClipmapLevelsName) + "[" + std::to_string(MaxClipmapLevels) + "];\n"
+            "uniform sampler2DArray HeightMap;\n"
+            "const int GridSize = " + std::to_string(gridSize) + ";\n"
+            "const int ClipmapSize = GridSize + 1;\n"
+            "float getHeight(int level, ivec2 s) {\n"
+            "    ivec2 texel = s - ClipmapSize * ivec2(floor(vec2(s) / float(ClipmapSize)));\n"
+            "    return texelFetch(HeightMap, ivec3(texel, level), 0).r;\n"
+            "}\n"
+            "void main() {\n"
+            "    int level = int(position.y + 0.5);\n"
+            "    ivec2 grid = ivec2(position.xz + vec2(0.5));\n"
+            "    vec3 window = " + String(ClipmapLevelsName) + "[level];\n"
+            "    ivec2 s = ivec2(window.xy) + grid;\n"
+            "    float h = getHeight(level, s);\n"
+            "    // Odd border vertices lie on an edge of the coarser level, they are moved onto it\n"
+            "    if ((grid.x == 0 || grid.x == GridSize) && (grid.y & 1) == 1) {\n"
+            "        h = 0.5 * (getHeight(level, s - ivec2(0, 1)) + getHeight(level, s + ivec2(0, 1)));\n"
+            "    } else if ((grid.y == 0 || grid.y == GridSize) && (grid.x & 1) == 1) {\n"
+            "        h = 0.5 * (getHeight(level, s - ivec2(1, 0)) + getHeight(level, s + ivec2(1, 0)));\n"
+            "    }\n"
+            "    // The neighbours are clamped to the window, outside of it the texels belong to the other side\n"
+            "    ivec2 first = ivec2(window.xy);\n"
+            "    ivec2 last = first + ivec2(GridSize);\n"
+            "    ivec2 x0 = clamp(s - ivec2(1, 0), first, last);\n"
+            "    ivec2 x1 = clamp(s + ivec2(1, 0), first, last);\n"
+            "    ivec2 z0 = clamp(s - ivec2(0, 1), first, last);\n"
+            "    ivec2 z1 = clamp(s + ivec2(0, 1), first, last);\n"
+            "    float dx = (getHeight(level, x0) - getHeight(level, x1)) / float(x1.x - x0.x);\n"
+            "    float dz = (getHeight(level, z0) - getHeight(level, z1)) / float(z1.y - z0.y);\n"
+            "    v_normal = normalize(vec3(dx, window.z, dz));\n"
+            "    mat4 u_mvp = Projection * View * Model;\n"
+            "    gl_Position = u_mvp * vec4(float(s.x) * window.z, h, float(s.y) * window.z, 1.0);\n"
+            "}\n";
+
+    const String fragment_clipmap =
+            getDefaultGLSLVersion() +
+            "in vec3 v_normal;\n"
+            "out vec4 f_color;\n"
+            "void main() {\n"
+            "    float light = max(dot(normalize(v_normal), normalize(vec3(0.4, 1.0, 0.3))), 0.0);\n"
+            "    f_color = vec4(vec3(0.45, 0.55, 0.35) * (0.2 + 0.8 * light), 1.0);\n"
+            "}\n";
+
+    ShaderSourceArray shArray;
+    shArray[static_cast<size_t>(ShaderType::SH_VertexShaderType)] = vertex_clipmap;
+    shArray[static_cast<size_t>(ShaderType::SH_FragmentShaderType)] = fragment_clipmap;
+    mat->createShader("clipmap_" + std::to_string(gridSize) + ".sh", shArray);
+
+    // Setup shader attributes and variables
+    if (mat->hasShader()) {
+        Shader *shader = mat->getShader();
+        shader->addVertexAttributes(RenderVert::getAttributes(), RenderVert::getNumAttributes());
+        addMaterialParameter(mat);
+        shader->addUniformBuffer(ClipmapLevelsName);
+    }
+
+    return mat;
+}
+
 Material *MaterialBuilder::createTextMaterial(const String &fontName) {
     if (fontName.empty()) {
         return nullptr;
@@ -251,6 +390,65 @@ const String GLSLVertexShaderSrcRV =
         "    vUV = texcoord0;\n"
         "}\n";
 
+const String GLSLVertexShaderSrcSkinned =
+        getDefaultGLSLVersion() +
+        "\n" + getGLSLSkinnedVertexLayout() +
+        getNewLine() +
+        "out vec3 position_eye, normal_eye;\n"
+        "// output from the vertex shader\n"
+        "smooth out vec4 vSmoothColor;		//smooth colour to fragment shader\n"
+        "smooth out vec2 vUV;\n" +
+        getNewLine() +
+        "vec3 light_pos = vec3(0.0, 0.0, 2.0);\n"
+        "vec3 Ld        = vec3(0.7, 0.7, 0.7);\n"
+        "vec3 La        = vec3(0.7, 0.7, 0.7);\n" +
+        getNewLine() +
+        getGLSLCombinedMVPUniformSrc() +
+        getGLSLSkinningSrc() +
+        getNewLine() +
+        "void main()\n"
+        "{\n"
+        "    // move the vertex by its joints into the animated pose\n"
+        "    mat4 skin = getSkinMatrix();\n"
+        "    position_eye = vec3(View * Model * skin * vec4(position, 1.0));\n"
+        "    normal_eye = normalize(vec3(View * Model * skin * vec4(normal, 0.0)));\n"
+        "    vec3 light_position_eye = vec3(View * vec4(light_pos, 1.0));\n"
+        "    vec3 direction_to_light_eye = normalize(light_position_eye - position_eye);\n"
+        "    float dot_prod = max(dot(direction_to_light_eye, normal_eye), 0.0);\n" +
+        getNewLine() +
+        "    gl_Position = Projection * vec4(position_eye, 1.0);\n"
+        "    vSmoothColor = vec4(La * color0 + Ld * color0 * dot_prod, 1.0);\n"
+        "    vUV = texcoord0;\n"
+        "}\n";
+
+const String GLSLVertexShaderSrcCompact =
+        getDefaultGLSLVersion() +
+        "\n" + getGLSLCompactVertexLayout() +
+        getNewLine() +
+        "out vec3 position_eye, normal_eye;\n"
+        "// output from the vertex shader\n"
+        "smooth out vec4 vSmoothColor;		//smooth colour to fragment shader\n"
+        "smooth out vec2 vUV;\n" +
+        getNewLine() +
+        "vec3 light_pos = vec3(0.0, 0.0, 2.0);\n"
+        "vec3 Ld        = vec3(0.7, 0.7, 0.7);\n"
+        "vec3 La        = vec3(0.7, 0.7, 0.7);\n" +
+        getNewLine() +
+        getGLSLCombinedMVPUniformSrc() +
+        getNewLine() +
+        "void main()\n"
+        "{\n"
+        "    position_eye = vec3(View * Model * vec4(position.xyz, 1.0));\n"
+        "    normal_eye = normalize(vec3(View * Model * vec4(decodeNormal(normal), 0.0)));\n"
+        "    vec3 light_position_eye = vec3(View * vec4(light_pos, 1.0));\n"
+        "    vec3 direction_to_light_eye = normalize(light_position_eye - position_eye);\n"
+        "    float dot_prod = max(dot(direction_to_light_eye, normal_eye), 0.0);\n" +
+        getNewLine() +
+        "    gl_Position = Projection * vec4(position_eye, 1.0);\n"
+        "    vSmoothColor = vec4(La * color0.rgb + Ld * color0.rgb * dot_prod, color0.a);\n"
+        "    vUV = texcoord0;\n"
+        "}\n";
+
 const String GLSLFragmentShaderSrcRV =
         getDefaultGLSLVersion() +
         getNewLine() +
@@ -287,13 +485,20 @@ void MaterialBuilder::destroy() {
 }
 
 Material *MaterialBuilder::createBuildinMaterial(VertexType type) {
+    // Skinned and compact geometry need their own shaders, so they cannot share the material with the other types
+    const c8 *matName = "buildinShaderMaterial";
+    if (type == VertexType::SkinnedVertex) {
+        matName = "buildinSkinnedShaderMaterial";
+    } else if (type == VertexType::CompactVertex) {
+        matName = "buildinCompactShaderMaterial";
+    }
     MaterialCache *materialCache = sData->mMaterialCache;
-    Material *mat = materialCache->find("buildinShaderMaterial");
+    Material *mat = materialCache->find(matName);
     if (nullptr != mat) {
         return mat;
     }
 
-    mat = materialCache->create("buildinShaderMaterial", IO::Uri());
+    mat = materialCache->create(matName, IO::Uri());
     String vs, fs, shaderName;
     if (type == VertexType::ColorVertex) {
         vs = GLSLVsSrc;
@@ -303,6 +508,14 @@ Material *MaterialBuilder::createBuildinMaterial(VertexType type) {
         vs = GLSLVertexShaderSrcRV;
         fs = GLSLFragmentShaderSrcRV;
         shaderName = "buildinShaderRenderVert.sh";
+    } else if (type == VertexType::SkinnedVertex) {
+        vs = GLSLVertexShaderSrcSkinned;
+        fs = GLSLFragmentShaderSrcRV;
+        shaderName = "buildinShaderSkinnedVert.sh";
+    } else if (type == VertexType::CompactVertex) {
+        vs = GLSLVertexShaderSrcCompact;
+        fs = GLSLFragmentShaderSrcRV;
+        shaderName = "buildinShaderCompactVert.sh";
     }
     if (vs.empty() || fs.empty()) {
         delete mat;
@@ -321,6 +534,11 @@ Material *MaterialBuilder::createBuildinMaterial(VertexType type) {
             shader->addVertexAttributes(ColorVert::getAttributes(), ColorVert::getNumAttributes());
         } else if (type == VertexType::RenderVertex) {
             shader->addVertexAttributes(RenderVert::getAttributes(), RenderVert::getNumAttributes());
+        } else if (type == VertexType::SkinnedVertex) {
+            shader->addVertexAttributes(SkinnedVert::getAttributes(), SkinnedVert::getNumAttributes());
+            shader->addUniformBuffer(SkinPaletteName);
+        } else if (type == VertexType::CompactVertex) {
+            shader->addVertexAttributes(CompactVert::getAttributes(), CompactVert::getNumAttributes());
         }
 
         addMaterialParameter(mat);
@@ -370,6 +588,14 @@ Material *MaterialBuilder::createTexturedMaterial(const String &matName, const T
         vs = GLSLVertexShaderSrcRV;
         fs = GLSLFragmentShaderSrcRV;
         shaderName = "buildinShaderRenderVert.sh";
+    } else if (type == VertexType::SkinnedVertex) {
+        vs = GLSLVertexShaderSrcSkinned;
+        fs = GLSLFragmentShaderSrcRV;
+        shaderName = "buildinShaderSkinnedVert.sh";
+    } else if (type == VertexType::CompactVertex) {
+        vs = GLSLVertexShaderSrcCompact;
+        fs = GLSLFragmentShaderSrcRV;
+        shaderName = "buildinShaderCompactVert.sh";
     }
 
     if (vs.empty() || fs.empty()) {
@@ -400,6 +626,11 @@ Material *MaterialBuilder::createTexturedMaterial(const String &matName, const T
             shader->addVertexAttributes(ColorVert::getAttributes(), ColorVert::getNumAttributes());
         } else if (type == VertexType::RenderVertex) {
             shader->addVertexAttributes(RenderVert::getAttributes(), RenderVert::getNumAttributes());
+        } else if (type == VertexType::SkinnedVertex) {
+            shader->addVertexAttributes(SkinnedVert::getAttributes(), SkinnedVert::getNumAttributes());
+            shader->addUniformBuffer(SkinPaletteName);
+        } else if (type == VertexType::CompactVertex) {
+            shader->addVertexAttributes(CompactVert::getAttributes(), CompactVert::getNumAttributes());
         }
 
         addMaterialParameter(mat);
@@ -66,6 +66,16 @@ public:
     /// @brief Will return the default 2d material.
     /// @return The 2D material.
     static Material *create2DMaterial();
+
+    /// @brief Will return the material for particles simulated on the GPU, dead particles will be skipped.
+    /// @return The particle material.
+    static Material *createParticleMaterial();
+
+    /// @brief Will return the material for geometry clipmap levels, the vertices will be displaced by a height texture.
+    /// @param[in] heightMapName    The name of the float texture array, one layer per level.
+    /// @param[in] gridSize         The number of quads per side of a level.
+    /// @return The clipmap material.
+    static Material *createClipmapMaterial(const String &heightMapName, ui32 gridSize);
     static Material *createTextMaterial(const String &fontName);
 
 private:
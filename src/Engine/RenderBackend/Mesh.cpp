@@ -21,9 +21,14 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "RenderBackend/Mesh.h"
+#include "Common/BatchMath.h"
 #include "Common/Ids.h"
 #include "Common/Logger.h"
 #include "RenderBackend/Material.h"
+#include "RenderBackend/Mesh/VertexQuantizer.h"
+
+#include <algorithm>
+#include <cstring>
 
 namespace OSRE::RenderBackend {
 
@@ -35,6 +40,31 @@ static Ids s_Ids;
 // The log tag for messages
 DECL_OSRE_LOG_MODULE(Mesh)
 
+static size_t getIndexSize(IndexType indexType) {
+    switch (indexType) {
+        case IndexType::UnsignedByte:
+            return sizeof(uc8);
+        case IndexType::UnsignedShort:
+            return sizeof(ui16);
+        case IndexType::UnsignedInt:
+            return sizeof(ui32);
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+// Will calculate the bounds of the positions, each vertex starts with its position.
+static void computeBounds(const c8 *data, size_t numVertices, size_t stride, AABB &aabb) {
+    glm::vec3 min, max;
+    if (!BatchMath::computeBounds(reinterpret_cast<const f32 *>(data), stride, numVertices, min, max)) {
+        return;
+    }
+
+    aabb.set(min, max);
+}
+
 Mesh::Mesh(const String &name, VertexType vertexType, IndexType indextype) :
         mName(name),
         mLocalModelMatrix(false),
@@ -45,7 +75,20 @@ Mesh::Mesh(const String &name, VertexType vertexType, IndexType indextype) :
         mIndexType(indextype),
         mIndexBuffer(nullptr),
         mId(99999999),
-        mLastIndex(0) {
+        mLastIndex(0),
+        mDequantScale(1.0f),
+        mDequantOffset(0.0f),
+        mAabb(),
+        mAabbDirty(true),
+        mLods(),
+        mActiveLod(0),
+        mVisible(true),
+        mMeshlets(),
+        mCulledIndices(),
+        mMeshletDrawn(),
+        mMeshletRanges(),
+        mSharedIndexBuffer(false),
+        mSharedVertexBuffer(false) {
     mId = s_Ids.getUniqueId();
 }
 
@@ -55,6 +98,8 @@ Mesh::~Mesh() {
 
 void *Mesh::mapVertexBuffer(size_t vbSize, BufferAccessType accessType) {
     mVertexBuffer = BufferData::alloc(BufferType::VertexBuffer, vbSize, accessType);
+    mAabbDirty = true;
+
     return mVertexBuffer->getData();
 }
 
@@ -69,6 +114,7 @@ void Mesh::createVertexBuffer(void *vertices, size_t vbSize, BufferAccessType ac
 
     mVertexBuffer = BufferData::alloc(BufferType::VertexBuffer, vbSize, accessType);
     mVertexBuffer->copyFrom(vertices, vbSize);
+    mAabbDirty = true;
 }
 
 void Mesh::resizeVertexBuffer(size_t vbSize) {
@@ -83,6 +129,7 @@ void Mesh::resizeVertexBuffer(size_t vbSize) {
     }
 
     mVertexBuffer->m_buffer.resize(vbSize);
+    mAabbDirty = true;
 }
 
 BufferData *Mesh::getVertexBuffer() const {
@@ -103,6 +150,275 @@ BufferData *Mesh::getIndexBuffer() const {
     return mIndexBuffer;
 }
 
+bool Mesh::shareIndexBuffer(Mesh *source) {
+    if (source == nullptr || source->getIndexBuffer() == nullptr) {
+        osre_debug(Tag, "No index buffer to share.");
+        return false;
+    }
+
+    mIndexBuffer = source->getIndexBuffer();
+    mIndexType = source->getIndexType();
+    mSharedIndexBuffer = true;
+    source->mSharedIndexBuffer = true;
+
+    return true;
+}
+
+bool Mesh::shareVertexBuffer(Mesh *source) {
+    if (source == nullptr || source->getVertexBuffer() == nullptr) {
+        osre_debug(Tag, "No vertex buffer to share.");
+        return false;
+    }
+
+    if (source->getVertexType() != mVertexType) {
+        osre_debug(Tag, "Cannot share the vertex buffer of " + source->getName() + ", the vertex type differs.");
+        return false;
+    }
+
+    mVertexBuffer = source->getVertexBuffer();
+    mDequantScale = source->getDequantizationScale();
+    mDequantOffset = source->getDequantizationOffset();
+    mSharedVertexBuffer = true;
+    source->mSharedVertexBuffer = true;
+    invalidateAABB();
+
+    return true;
+}
+
+const AABB &Mesh::getAABB() const {
+    if (!mAabbDirty) {
+        return mAabb;
+    }
+
+    mAabb.reset();
+    mAabbDirty = false;
+    const size_t stride = getVertexSize(mVertexType);
+    if (nullptr == mVertexBuffer || 0 == stride || 0 == mVertexBuffer->getSize()) {
+        return mAabb;
+    }
+
+    const size_t numVertices = mVertexBuffer->getSize() / stride;
+    if (VertexType::CompactVertex == mVertexType) {
+        for (size_t i = 0; i < numVertices; ++i) {
+            mAabb.merge(getPosition(i));
+        }
+        return mAabb;
+    }
+    computeBounds(mVertexBuffer->getData(), numVertices, stride, mAabb);
+
+    return mAabb;
+}
+
+void Mesh::setDequantization(const glm::vec3 &scale, const glm::vec3 &offset) {
+    mDequantScale = scale;
+    mDequantOffset = offset;
+    invalidateAABB();
+}
+
+glm::mat4 Mesh::getDequantizationMatrix() const {
+    return glm::scale(glm::translate(glm::mat4(1.0f), mDequantOffset), mDequantScale);
+}
+
+glm::mat4 Mesh::getMeshMatrix() const {
+    const glm::mat4 model = mLocalModelMatrix ? mModel : glm::mat4(1.0f);
+    if (VertexType::CompactVertex == mVertexType) {
+        return model * getDequantizationMatrix();
+    }
+
+    return model;
+}
+
+bool Mesh::hasMeshMatrix() const {
+    return mLocalModelMatrix || VertexType::CompactVertex == mVertexType;
+}
+
+glm::vec3 Mesh::getPosition(size_t index) const {
+    const size_t stride = getVertexSize(mVertexType);
+    const c8 *vertex = mVertexBuffer->getData() + index * stride;
+    if (VertexType::CompactVertex == mVertexType) {
+        const CompactVert *compact = reinterpret_cast<const CompactVert *>(vertex);
+        const glm::vec3 pos(VertexQuantizer::fromSnorm16(compact->position[0]), VertexQuantizer::fromSnorm16(compact->position[1]),
+                VertexQuantizer::fromSnorm16(compact->position[2]));
+        return mDequantOffset + pos * mDequantScale;
+    }
+
+    glm::vec3 pos;
+    ::memcpy(&pos, vertex, sizeof(glm::vec3));
+
+    return pos;
+}
+
+void Mesh::setLods(const MeshLodArray &lods) {
+    mLods = lods;
+    mActiveLod = 0;
+}
+
+size_t Mesh::selectLod(f32 pixelsPerUnit, f32 maxPixelError, f32 hysteresis) const {
+    if (mLods.isEmpty()) {
+        return 0;
+    }
+
+    // Use the coarsest level which stays below the accepted error
+    size_t lod = 0;
+    for (size_t i = 1; i < mLods.size(); ++i) {
+        if (mLods[i].mError * pixelsPerUnit <= maxPixelError) {
+            lod = i;
+        }
+    }
+
+    // Getting coarser needs a clear margin, otherwise the level will flicker at the threshold
+    const f32 coarserError = maxPixelError * (1.0f - hysteresis);
+    while (lod > mActiveLod && mLods[lod].mError * pixelsPerUnit > coarserError) {
+        --lod;
+    }
+
+    return lod;
+}
+
+bool Mesh::setActiveLod(size_t index) {
+    if (index >= mLods.size() || index == mActiveLod || mPrimGroups.isEmpty()) {
+        return false;
+    }
+
+    PrimitiveGroup *grp = mPrimGroups[0];
+    grp->m_startIndex = mLods[index].mStartIndex;
+    grp->m_numIndices = mLods[index].mNumIndices;
+    mActiveLod = index;
+
+    return true;
+}
+
+bool Mesh::setMeshlets(const MeshletArray &meshlets) {
+    if (nullptr == mIndexBuffer || mSharedIndexBuffer) {
+        osre_debug(Tag, "Meshlets of " + mName + " cannot be culled, the index buffer is missing or shared.");
+        return false;
+    }
+
+    // The meshlets of a primitive group will be found by a binary search
+    mMeshlets = meshlets;
+    if (!mMeshlets.isEmpty()) {
+        std::sort(&mMeshlets[0], &mMeshlets[0] + mMeshlets.size(), [](const Meshlet &lhs, const Meshlet &rhs) {
+            return lhs.mStartIndex < rhs.mStartIndex;
+        });
+    }
+    mMeshletDrawn.resize(meshlets.size());
+    for (size_t i = 0; i < mMeshletDrawn.size(); ++i) {
+        mMeshletDrawn[i] = true;
+    }
+    mCulledIndices.resize(mIndexBuffer->getSize());
+    if (!mCulledIndices.isEmpty()) {
+        ::memcpy(&mCulledIndices[0], mIndexBuffer->getData(), mCulledIndices.size());
+    }
+    mMeshletRanges.clear();
+
+    return true;
+}
+
+void Mesh::updateMeshletRange(size_t index) {
+    const PrimitiveGroup *grp = mPrimGroups[index];
+    MeshletRange &range = mMeshletRanges[index];
+    if (range.mStartIndex == grp->m_startIndex && range.mNumIndices == grp->m_numIndices) {
+        return;
+    }
+
+    // A new level of detail draws other meshlets, the whole group must be uploaded again
+    const Meshlet *begin = &mMeshlets[0];
+    const Meshlet *end = begin + mMeshlets.size();
+    auto isBefore = [](const Meshlet &meshlet, size_t startIndex) {
+        return meshlet.mStartIndex < startIndex;
+    };
+    range.mStartIndex = grp->m_startIndex;
+    range.mNumIndices = grp->m_numIndices;
+    range.mFirstMeshlet = std::lower_bound(begin, end, range.mStartIndex, isBefore) - begin;
+    range.mEndMeshlet = std::lower_bound(begin + range.mFirstMeshlet, end, range.mStartIndex + range.mNumIndices, isBefore) - begin;
+    range.mNumDrawn = range.mNumIndices;
+    range.mDirty = true;
+}
+
+bool Mesh::cullMeshlets(const Frustum &frustum, const glm::vec3 &eye) {
+    if (mMeshlets.isEmpty() || nullptr == mIndexBuffer || mCulledIndices.size() != mIndexBuffer->getSize()) {
+        return false;
+    }
+
+    bool changed = false;
+    if (mMeshletRanges.size() != mPrimGroups.size()) {
+        mMeshletRanges.resize(mPrimGroups.size());
+        for (size_t i = 0; i < mMeshletRanges.size(); ++i) {
+            mMeshletRanges[i] = { ~static_cast<size_t>(0), 0, 0, 0, 0, false };
+        }
+        changed = true;
+    }
+
+    const size_t indexSize = getIndexSize(mIndexType);
+    const c8 *source = mIndexBuffer->getData();
+    for (size_t i = 0; i < mPrimGroups.size(); ++i) {
+        updateMeshletRange(i);
+        MeshletRange &range = mMeshletRanges[i];
+        const size_t end = range.mStartIndex + range.mNumIndices;
+        bool dirty = range.mDirty;
+        size_t next = range.mStartIndex;
+        for (size_t j = range.mFirstMeshlet; j < range.mEndMeshlet; ++j) {
+            const Meshlet &meshlet = mMeshlets[j];
+            const bool drawn = meshlet.mStartIndex + meshlet.mNumIndices <= end && MeshletCuller::isVisible(meshlet, frustum, eye);
+            if (drawn != mMeshletDrawn[j]) {
+                mMeshletDrawn[j] = drawn;
+                dirty = true;
+            }
+
+            // The visible meshlets are packed, so one draw of the group range covers all of them
+            if (drawn) {
+                ::memcpy(&mCulledIndices[next * indexSize], source + meshlet.mStartIndex * indexSize, meshlet.mNumIndices * indexSize);
+                next += meshlet.mNumIndices;
+            }
+        }
+        if (range.mNumDrawn != next - range.mStartIndex) {
+            range.mNumDrawn = next - range.mStartIndex;
+            dirty = true;
+        }
+        range.mDirty = dirty;
+        changed |= dirty;
+    }
+
+    return changed;
+}
+
+size_t Mesh::getNumDrawnIndices(size_t index) const {
+    if (index < mMeshletRanges.size()) {
+        return mMeshletRanges[index].mNumDrawn;
+    }
+    if (index < mPrimGroups.size()) {
+        return mPrimGroups[index]->m_numIndices;
+    }
+
+    return 0;
+}
+
+bool Mesh::getDirtyDrawnIndices(size_t index, size_t &offset, size_t &size) const {
+    if (index >= mMeshletRanges.size() || !mMeshletRanges[index].mDirty) {
+        return false;
+    }
+
+    const size_t indexSize = getIndexSize(mIndexType);
+    offset = mMeshletRanges[index].mStartIndex * indexSize;
+    size = mMeshletRanges[index].mNumDrawn * indexSize;
+
+    return true;
+}
+
+void Mesh::clearDirtyDrawnIndices() {
+    for (size_t i = 0; i < mMeshletRanges.size(); ++i) {
+        mMeshletRanges[i].mDirty = false;
+    }
+}
+
+const c8 *Mesh::getDrawnIndexData() const {
+    if (!mMeshlets.isEmpty() && !mCulledIndices.isEmpty()) {
+        return &mCulledIndices[0];
+    }
+
+    return nullptr != mIndexBuffer ? mIndexBuffer->getData() : nullptr;
+}
+
 size_t Mesh::getVertexSize(VertexType vertextype) {
     size_t vertexSize = 0;
     switch (vertextype) {
@@ -114,6 +430,14 @@ size_t Mesh::getVertexSize(VertexType vertextype) {
             vertexSize = sizeof(RenderVert);
             break;
 
+        case VertexType::SkinnedVertex:
+            vertexSize = sizeof(SkinnedVert);
+            break;
+
+        case VertexType::CompactVertex:
+            vertexSize = sizeof(CompactVert);
+            break;
+
         default:
             break;
     }
@@ -23,7 +23,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #pragma once
 
 #include "Common/glm_common.h"
+#include "Common/TAABB.h"
 #include "RenderBackend/RenderCommon.h"
+#include "RenderBackend/Mesh/MeshletBuilder.h"
 
 #include <cppcore/Container/TArray.h>
 
@@ -33,6 +35,15 @@ namespace RenderBackend {
 // Forward declarations ---------------------------------------------------------------------------
 class Material;
 
+/// @brief This struct describes one level of detail, which is stored as an index range in the index buffer of the mesh.
+struct MeshLod {
+    ui32 mStartIndex;   ///< The first index of the level.
+    ui32 mNumIndices;   ///< The number of indices of the level.
+    f32 mError;         ///< The geometric error against the full detailed mesh in mesh-local units.
+};
+
+using MeshLodArray = cppcore::TArray<MeshLod>;
+
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
@@ -53,8 +64,22 @@ public:
     void createVertexBuffer(void *vertices, size_t vbSize, BufferAccessType accessType);
     void resizeVertexBuffer(size_t vbSize);
     BufferData *getVertexBuffer() const;
+    /// @brief Will use the vertex buffer of another mesh, the backend will upload it only once.
+    /// @param[in] source   The mesh owning the vertex buffer, must have the same vertex type.
+    /// @return true, if successful, false if the source has no vertex buffer or another vertex type.
+    bool shareVertexBuffer(Mesh *source);
+    /// @brief Will return true, if the vertex buffer is used by several meshes.
+    /// @return true for a shared vertex buffer.
+    bool hasSharedVertexBuffer() const;
     void createIndexBuffer(void *indices, size_t ibSize, IndexType indexType, BufferAccessType accessType);
     BufferData *getIndexBuffer() const;
+    /// @brief Will use the index buffer of another mesh, the backend will upload it only once.
+    /// @param[in] source   The mesh owning the index buffer, must have the same index type.
+    /// @return true, if successful, false if the source has no index buffer.
+    bool shareIndexBuffer(Mesh *source);
+    /// @brief Will return true, if the index buffer is used by several meshes.
+    /// @return true for a shared index buffer.
+    bool hasSharedIndexBuffer() const;
     void setId(guid id);
     guid getId() const;
     size_t getNumberOfPrimitiveGroups() const;
@@ -63,6 +88,117 @@ public:
     bool isLocal() const;
     const glm::mat4 &getLocalMatrix() const;
 
+    /// @brief Will set the transformation from the quantized positions of compact vertices into mesh-local space.
+    /// @param[in] scale    The dequantization scale.
+    /// @param[in] offset   The dequantization offset.
+    void setDequantization(const glm::vec3 &scale, const glm::vec3 &offset);
+
+    /// @brief Will return the dequantization scale.
+    /// @return The scale, 1 for uncompressed vertices.
+    const glm::vec3 &getDequantizationScale() const;
+
+    /// @brief Will return the dequantization offset.
+    /// @return The offset, 0 for uncompressed vertices.
+    const glm::vec3 &getDequantizationOffset() const;
+
+    /// @brief Will return the dequantization as a matrix, which gets applied before the local matrix.
+    /// @return The dequantization matrix.
+    glm::mat4 getDequantizationMatrix() const;
+
+    /// @brief Will return the matrix from the vertex positions into the space of the owner, the model
+    ///        matrix of the owner gets multiplied from the left.
+    /// @return The local matrix followed by the dequantization.
+    glm::mat4 getMeshMatrix() const;
+
+    /// @brief Will return true, when the vertices need the mesh matrix to be drawn.
+    /// @return true for local matrices and compact vertices.
+    bool hasMeshMatrix() const;
+
+    /// @brief Will return the position of a vertex in mesh-local space, compact vertices will be dequantized.
+    /// @param[in] index    The vertex index, must be valid.
+    /// @return The position.
+    glm::vec3 getPosition(size_t index) const;
+
+    /// @brief Will return the bounding box of the vertices in mesh-local space.
+    /// @return The cached bounding box, will be recalculated when the vertices have changed.
+    const Common::AABB &getAABB() const;
+
+    /// @brief Marks the cached bounding box as outdated, use this after writing into the vertex buffer.
+    void invalidateAABB();
+
+    /// @brief Will set the level of detail chain, the first level is the full detailed one.
+    /// @param[in] lods     The index ranges of the levels, sorted from fine to coarse.
+    void setLods(const MeshLodArray &lods);
+
+    /// @brief Will return the number of levels of detail.
+    /// @return The number of levels, 0 if the mesh has no level of detail chain.
+    size_t getNumLods() const;
+
+    /// @brief Will return the level of detail at the given index.
+    /// @param[in] index    The level index.
+    /// @return The level description.
+    const MeshLod &getLodAt(size_t index) const;
+
+    /// @brief Will select the level of detail for the given projection scale.
+    /// @param[in] pixelsPerUnit   The number of pixels covered by one mesh-local unit.
+    /// @param[in] maxPixelError   The maximal accepted screen space error in pixels.
+    /// @param[in] hysteresis      The relative margin the error must fall below before switching to a coarser level.
+    /// @return The index of the selected level.
+    size_t selectLod(f32 pixelsPerUnit, f32 maxPixelError, f32 hysteresis) const;
+
+    /// @brief Will activate a level of detail, the first primitive group will draw its index range.
+    /// @param[in] index    The level index.
+    /// @return true, if the active level was changed, false if not.
+    bool setActiveLod(size_t index);
+
+    /// @brief Will return the active level of detail.
+    /// @return The active level index.
+    size_t getActiveLod() const;
+
+    /// @brief Will set the visibility, invisible meshes stay resident but will not be drawn.
+    /// @param[in] visible  true for visible, false for hidden.
+    /// @return true, if the visibility was changed, false if not.
+    bool setVisible(bool visible);
+
+    /// @brief Will return the visibility.
+    /// @return true, if the mesh will be drawn.
+    bool isVisible() const;
+
+    /// @brief Will set the meshlets for the cluster culling, the index buffer must be in meshlet order.
+    /// @param[in] meshlets     The meshlets, each one must lie in a level of detail or primitive group.
+    /// @return true, if successful, false for meshes without or with a shared index buffer.
+    bool setMeshlets(const MeshletArray &meshlets);
+
+    /// @brief Will return the meshlets.
+    /// @return The meshlets, empty if the mesh has none.
+    const MeshletArray &getMeshlets() const;
+
+    /// @brief Will copy the indices of the potentially visible meshlets to the start of each primitive group
+    ///        in the culled index data, only these indices will be drawn. The index buffer stays unchanged.
+    /// @param[in] frustum  The view frustum in mesh-local space.
+    /// @param[in] eye      The position of the viewer in mesh-local space.
+    /// @return true, if the drawn indices have changed and must be uploaded, false if not.
+    bool cullMeshlets(const Common::Frustum &frustum, const glm::vec3 &eye);
+
+    /// @brief Will return the number of indices, which are drawn by a primitive group.
+    /// @param[in] index    The index of the primitive group.
+    /// @return The number of indices left by the meshlet culling, 0 for an invalid index.
+    size_t getNumDrawnIndices(size_t index) const;
+
+    /// @brief Will return the drawn indices of a primitive group, which were changed by the meshlet culling.
+    /// @param[in]  index       The index of the primitive group.
+    /// @param[out] offset      The offset of the changed indices in the drawn index data in bytes.
+    /// @param[out] size        The size of the changed indices in bytes.
+    /// @return true, if the indices must be uploaded, false if not.
+    bool getDirtyDrawnIndices(size_t index, size_t &offset, size_t &size) const;
+
+    /// @brief Will mark the drawn indices of all primitive groups as uploaded.
+    void clearDirtyDrawnIndices();
+
+    /// @brief Will return the indices to upload for drawing.
+    /// @return The culled index data for meshes with meshlets, the index buffer data for all others.
+    const c8 *getDrawnIndexData() const;
+
     template <class T>
     void attachVertices(T *vertices, size_t size) {
         if (mVertexBuffer == nullptr) {
@@ -71,6 +207,7 @@ public:
         } else {
             mVertexBuffer->attach(vertices, size);
         }
+        invalidateAABB();
     }
 
     template <class T>
@@ -94,6 +231,18 @@ public:
 private:
     using PrimGroupArray = ::cppcore::TArray<PrimitiveGroup*>;
 
+    /// The meshlets of a primitive group, the range will be searched again when the group has changed.
+    struct MeshletRange {
+        size_t mStartIndex;     ///< The first index of the group.
+        size_t mNumIndices;     ///< The number of indices of the group.
+        size_t mFirstMeshlet;   ///< The first meshlet of the group.
+        size_t mEndMeshlet;     ///< One behind the last meshlet of the group.
+        size_t mNumDrawn;       ///< The number of drawn indices.
+        bool mDirty;            ///< true, if the drawn indices must be uploaded.
+    };
+
+    void updateMeshletRange(size_t index);
+
     String mName;
     bool mLocalModelMatrix;
     glm::mat4 mModel;
@@ -107,6 +256,19 @@ private:
     MemoryBuffer mVertexData;
     MemoryBuffer mIndexData;
     ui32 mLastIndex;
+    glm::vec3 mDequantScale;
+    glm::vec3 mDequantOffset;
+    mutable Common::AABB mAabb;
+    mutable bool mAabbDirty;
+    MeshLodArray mLods;
+    size_t mActiveLod;
+    bool mVisible;
+    MeshletArray mMeshlets;
+    cppcore::TArray<c8> mCulledIndices;
+    cppcore::TArray<bool> mMeshletDrawn;
+    cppcore::TArray<MeshletRange> mMeshletRanges;
+    bool mSharedIndexBuffer;
+    bool mSharedVertexBuffer;
 };
 
 inline void Mesh::setMaterial(Material *mat) {
@@ -138,6 +300,14 @@ inline void Mesh::setId(guid id) {
     mId = id;
 }
 
+inline bool Mesh::hasSharedIndexBuffer() const {
+    return mSharedIndexBuffer;
+}
+
+inline bool Mesh::hasSharedVertexBuffer() const {
+    return mSharedVertexBuffer;
+}
+
 inline guid Mesh::getId() const {
     return mId;
 }
@@ -167,6 +337,47 @@ inline bool Mesh::isLocal() const {
     return mLocalModelMatrix;
 }
 
+inline const glm::vec3 &Mesh::getDequantizationScale() const {
+    return mDequantScale;
+}
+
+inline const glm::vec3 &Mesh::getDequantizationOffset() const {
+    return mDequantOffset;
+}
+
+inline void Mesh::invalidateAABB() {
+    mAabbDirty = true;
+}
+
+inline size_t Mesh::getNumLods() const {
+    return mLods.size();
+}
+
+inline const MeshLod &Mesh::getLodAt(size_t index) const {
+    return mLods[index];
+}
+
+inline size_t Mesh::getActiveLod() const {
+    return mActiveLod;
+}
+
+inline bool Mesh::setVisible(bool visible) {
+    if (mVisible == visible) {
+        return false;
+    }
+    mVisible = visible;
+
+    return true;
+}
+
+inline bool Mesh::isVisible() const {
+    return mVisible;
+}
+
+inline const MeshletArray &Mesh::getMeshlets() const {
+    return mMeshlets;
+}
+
 inline void Mesh::setLastIndex(ui32 lastIndex) {
     mLastIndex = lastIndex;
 }
@@ -0,0 +1,456 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "RenderBackend/Mesh/MeshOptimizer.h"
+#include "Common/glm_common.h"
+
+#include <cppcore/Container/TArray.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace OSRE::RenderBackend {
+
+using namespace ::cppcore;
+
+namespace {
+
+// The parameters of the vertex score function, see "Linear-Speed Vertex Cache Optimisation" by Tom Forsyth
+static constexpr ui32 ScoreCacheSize = 32;
+static constexpr ui32 MaxScoreValence = 32;
+static constexpr f32 CacheDecayPower = 1.5f;
+static constexpr f32 LastTriangleScore = 0.75f;
+static constexpr f32 ValenceBoostScale = 2.0f;
+static constexpr f32 ValenceBoostPower = 0.5f;
+
+static constexpr ui32 InvalidIndex = std::numeric_limits<ui32>::max();
+
+// Precalculated vertex scores, indexed by the cache position + 1 and the number of remaining triangles
+struct VertexScoreTable {
+    f32 mScores[ScoreCacheSize + 1][MaxScoreValence + 1];
+
+    VertexScoreTable() {
+        for (ui32 pos = 0; pos <= ScoreCacheSize; ++pos) {
+            for (ui32 valence = 0; valence <= MaxScoreValence; ++valence) {
+                mScores[pos][valence] = calcScore(static_cast<i32>(pos) - 1, valence);
+            }
+        }
+    }
+
+    static f32 calcScore(i32 cachePos, ui32 numRemaining) {
+        if (0 == numRemaining) {
+            return -1.0f;
+        }
+
+        f32 score = 0.0f;
+        if (cachePos >= 0) {
+            if (cachePos < 3) {
+                // The vertices of the last triangle get a fixed score, so the order of its edges does not matter
+                score = LastTriangleScore;
+            } else {
+                const f32 scaler = 1.0f / static_cast<f32>(ScoreCacheSize - 3);
+                score = std::pow(1.0f - static_cast<f32>(cachePos - 3) * scaler, CacheDecayPower);
+            }
+        }
+
+        // Vertices with only a few remaining triangles get a boost, so they will not be left over as single triangles
+        score += ValenceBoostScale * std::pow(static_cast<f32>(numRemaining), -ValenceBoostPower);
+
+        return score;
+    }
+
+    f32 get(i32 cachePos, ui32 numRemaining) const {
+        return mScores[cachePos + 1][std::min(numRemaining, MaxScoreValence)];
+    }
+};
+
+// FIFO cache simulation, a vertex is in the cache when it was inserted within the last cacheSize misses
+struct FifoCache {
+    TArray<ui32> mTimestamps;
+    ui32 mCacheSize;
+    ui32 mTime;
+
+    FifoCache(size_t numVertices, ui32 cacheSize) :
+            mTimestamps(), mCacheSize(cacheSize), mTime(cacheSize + 1) {
+        mTimestamps.resize(numVertices);
+        for (size_t i = 0; i < numVertices; ++i) {
+            mTimestamps[i] = 0;
+        }
+    }
+
+    void flush() {
+        mTime += mCacheSize + 1;
+    }
+
+    ui32 access(ui32 vertex) {
+        if (mTime - mTimestamps[vertex] > mCacheSize) {
+            mTimestamps[vertex] = mTime++;
+            return 1;
+        }
+
+        return 0;
+    }
+
+    ui32 accessTriangle(const ui32 *triangle) {
+        return access(triangle[0]) + access(triangle[1]) + access(triangle[2]);
+    }
+};
+
+static glm::vec3 getPosition(const c8 *vertexData, size_t stride, ui32 vertex) {
+    glm::vec3 pos;
+    ::memcpy(&pos, vertexData + vertex * stride, sizeof(glm::vec3));
+
+    return pos;
+}
+
+static bool hasValidIndices(const ui32 *indices, size_t numIndices, size_t numVertices) {
+    if (nullptr == indices || numIndices < 3 || 0 == numVertices) {
+        return false;
+    }
+
+    for (size_t i = 0; i < numIndices; ++i) {
+        if (indices[i] >= numVertices) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Will split the triangles into clusters, which can be reordered without losing too much cache efficiency
+static void generateClusters(const ui32 *indices, size_t numTriangles, size_t numVertices, f32 threshold,
+        TArray<size_t> &clusters) {
+    FifoCache cache(numVertices, MeshOptimizer::DefaultCacheSize);
+
+    // A triangle without any cache hit starts a new hard cluster
+    TArray<size_t> hardClusters;
+    for (size_t i = 0; i < numTriangles; ++i) {
+        if (3 == cache.accessTriangle(&indices[i * 3])) {
+            hardClusters.add(i);
+        }
+    }
+    hardClusters.add(numTriangles);
+
+    // Split the hard clusters, as long as the parts are as efficient as the whole cluster
+    for (size_t c = 0; c + 1 < hardClusters.size(); ++c) {
+        const size_t start = hardClusters[c], end = hardClusters[c + 1];
+        cache.flush();
+        size_t clusterMisses = 0;
+        for (size_t i = start; i < end; ++i) {
+            clusterMisses += cache.accessTriangle(&indices[i * 3]);
+        }
+        const f32 clusterThreshold = threshold * static_cast<f32>(clusterMisses) / static_cast<f32>(end - start);
+
+        clusters.add(start);
+        cache.flush();
+        size_t misses = 0, triangles = 0;
+        for (size_t i = start; i < end; ++i) {
+            misses += cache.accessTriangle(&indices[i * 3]);
+            ++triangles;
+            if (static_cast<f32>(misses) <= clusterThreshold * static_cast<f32>(triangles) && i + 1 < end) {
+                clusters.add(i + 1);
+                cache.flush();
+                misses = 0;
+                triangles = 0;
+            }
+        }
+    }
+    clusters.add(numTriangles);
+}
+
+} // namespace
+
+VertexCacheStatistics MeshOptimizer::analyzeVertexCache(const ui32 *indices, size_t numIndices, size_t numVertices,
+        ui32 cacheSize) {
+    VertexCacheStatistics stats = { 0, 0, 0, 0.0f, 0.0f };
+    if (!hasValidIndices(indices, numIndices, numVertices) || 0 == cacheSize) {
+        return stats;
+    }
+
+    FifoCache cache(numVertices, cacheSize);
+    TArray<uc8> used;
+    used.resize(numVertices);
+    ::memset(&used[0], 0, numVertices);
+    const size_t numTriangles = numIndices / 3;
+    for (size_t i = 0; i < numTriangles * 3; ++i) {
+        const ui32 vertex = indices[i];
+        stats.mNumTransforms += cache.access(vertex);
+        if (0 == used[vertex]) {
+            used[vertex] = 1;
+            ++stats.mNumVertices;
+        }
+    }
+    stats.mNumTriangles = numTriangles;
+    stats.mAcmr = static_cast<f32>(stats.mNumTransforms) / static_cast<f32>(stats.mNumTriangles);
+    stats.mAtvr = static_cast<f32>(stats.mNumTransforms) / static_cast<f32>(stats.mNumVertices);
+
+    return stats;
+}
+
+void MeshOptimizer::optimizeVertexCache(ui32 *indices, size_t numIndices, size_t numVertices) {
+    if (!hasValidIndices(indices, numIndices, numVertices)) {
+        return;
+    }
+
+    static const VertexScoreTable scoreTable;
+    const size_t numTriangles = numIndices / 3;
+
+    // The triangles of every vertex, the not yet emitted ones are at the front of each list
+    TArray<ui32> numRemaining, adjacencyOffsets, adjacency;
+    numRemaining.resize(numVertices);
+    adjacencyOffsets.resize(numVertices + 1);
+    for (size_t i = 0; i < numVertices; ++i) {
+        numRemaining[i] = 0;
+    }
+    for (size_t i = 0; i < numTriangles * 3; ++i) {
+        ++numRemaining[indices[i]];
+    }
+    adjacencyOffsets[0] = 0;
+    for (size_t i = 0; i < numVertices; ++i) {
+        adjacencyOffsets[i + 1] = adjacencyOffsets[i] + numRemaining[i];
+        numRemaining[i] = 0;
+    }
+    adjacency.resize(numTriangles * 3);
+    for (size_t i = 0; i < numTriangles * 3; ++i) {
+        const ui32 vertex = indices[i];
+        adjacency[adjacencyOffsets[vertex] + numRemaining[vertex]++] = static_cast<ui32>(i / 3);
+    }
+
+    TArray<i32> cachePositions;
+    TArray<f32> vertexScores, triangleScores;
+    TArray<uc8> emitted;
+    cachePositions.resize(numVertices);
+    vertexScores.resize(numVertices);
+    for (size_t i = 0; i < numVertices; ++i) {
+        cachePositions[i] = -1;
+        vertexScores[i] = scoreTable.get(-1, numRemaining[i]);
+    }
+    triangleScores.resize(numTriangles);
+    emitted.resize(numTriangles);
+    for (size_t i = 0; i < numTriangles; ++i) {
+        triangleScores[i] = vertexScores[indices[i * 3]] + vertexScores[indices[i * 3 + 1]] + vertexScores[indices[i * 3 + 2]];
+        emitted[i] = 0;
+    }
+
+    TArray<ui32> result;
+    result.resize(numTriangles * 3);
+    ui32 cache[ScoreCacheSize + 3], newCache[ScoreCacheSize + 3];
+    size_t cacheCount = 0;
+    size_t deadEndCursor = 0;
+    ui32 best = 0;
+    for (size_t i = 1; i < numTriangles; ++i) {
+        if (triangleScores[i] > triangleScores[best]) {
+            best = static_cast<ui32>(i);
+        }
+    }
+
+    for (size_t out = 0; out < numTriangles; ++out) {
+        if (InvalidIndex == best) {
+            // Dead end, continue with the next triangle in the input order
+            while (0 != emitted[deadEndCursor]) {
+                ++deadEndCursor;
+            }
+            best = static_cast<ui32>(deadEndCursor);
+        }
+
+        const ui32 *triangle = &indices[best * 3];
+        result[out * 3] = triangle[0];
+        result[out * 3 + 1] = triangle[1];
+        result[out * 3 + 2] = triangle[2];
+        emitted[best] = 1;
+
+        // Remove the triangle from the lists of its vertices
+        for (ui32 k = 0; k < 3; ++k) {
+            const ui32 vertex = triangle[k];
+            ui32 *list = &adjacency[adjacencyOffsets[vertex]];
+            const ui32 count = numRemaining[vertex];
+            for (ui32 j = 0; j < count; ++j) {
+                if (list[j] == best) {
+                    list[j] = list[count - 1];
+                    break;
+                }
+            }
+            --numRemaining[vertex];
+        }
+
+        // The vertices of the emitted triangle move to the front of the LRU cache
+        size_t newCount = 0;
+        for (ui32 k = 0; k < 3; ++k) {
+            const ui32 vertex = triangle[k];
+            if (std::find(newCache, newCache + newCount, vertex) == newCache + newCount) {
+                newCache[newCount++] = vertex;
+            }
+        }
+        for (size_t k = 0; k < cacheCount; ++k) {
+            const ui32 vertex = cache[k];
+            if (std::find(newCache, newCache + newCount, vertex) != newCache + newCount) {
+                continue;
+            }
+            if (newCount < ScoreCacheSize + 3) {
+                newCache[newCount++] = vertex;
+            }
+        }
+        for (size_t k = 0; k < cacheCount; ++k) {
+            cachePositions[cache[k]] = -1;
+        }
+        for (size_t k = 0; k < newCount; ++k) {
+            cache[k] = newCache[k];
+            cachePositions[cache[k]] = k < ScoreCacheSize ? static_cast<i32>(k) : -1;
+        }
+        cacheCount = std::min(newCount, static_cast<size_t>(ScoreCacheSize));
+
+        // Rescore the cached vertices and their triangles, the best one will be emitted next
+        for (size_t k = 0; k < newCount; ++k) {
+            const ui32 vertex = newCache[k];
+            vertexScores[vertex] = scoreTable.get(cachePositions[vertex], numRemaining[vertex]);
+        }
+        best = InvalidIndex;
+        f32 bestScore = -1.0f;
+        for (size_t k = 0; k < newCount; ++k) {
+            const ui32 vertex = newCache[k];
+            const ui32 *list = &adjacency[adjacencyOffsets[vertex]];
+            for (ui32 j = 0; j < numRemaining[vertex]; ++j) {
+                const ui32 tri = list[j];
+                const f32 score = vertexScores[indices[tri * 3]] + vertexScores[indices[tri * 3 + 1]] + vertexScores[indices[tri * 3 + 2]];
+                triangleScores[tri] = score;
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = tri;
+                }
+            }
+        }
+    }
+
+    ::memcpy(indices, &result[0], numTriangles * 3 * sizeof(ui32));
+}
+
+void MeshOptimizer::optimizeOverdraw(ui32 *indices, size_t numIndices, const c8 *vertexData, size_t numVertices,
+        size_t stride, f32 threshold) {
+    if (!hasValidIndices(indices, numIndices, numVertices) || nullptr == vertexData || stride < sizeof(glm::vec3)) {
+        return;
+    }
+
+    const size_t numTriangles = numIndices / 3;
+    TArray<size_t> clusters;
+    generateClusters(indices, numTriangles, numVertices, threshold, clusters);
+    const size_t numClusters = clusters.size() - 1;
+    if (numClusters < 2) {
+        return;
+    }
+
+    // The area weighted centroid and normal of each cluster and of the whole mesh
+    TArray<glm::vec3> centroids, normals;
+    centroids.resize(numClusters);
+    normals.resize(numClusters);
+    glm::vec3 meshCentroid(0.0f);
+    f32 meshArea = 0.0f;
+    for (size_t c = 0; c < numClusters; ++c) {
+        glm::vec3 centroid(0.0f), normal(0.0f);
+        f32 area = 0.0f;
+        for (size_t i = clusters[c]; i < clusters[c + 1]; ++i) {
+            const glm::vec3 p0 = getPosition(vertexData, stride, indices[i * 3]);
+            const glm::vec3 p1 = getPosition(vertexData, stride, indices[i * 3 + 1]);
+            const glm::vec3 p2 = getPosition(vertexData, stride, indices[i * 3 + 2]);
+            const glm::vec3 n = glm::cross(p1 - p0, p2 - p0);
+            const f32 triArea = glm::length(n);
+            centroid += (p0 + p1 + p2) * (triArea / 3.0f);
+            normal += n;
+            area += triArea;
+        }
+        meshCentroid += centroid;
+        meshArea += area;
+        centroids[c] = area > 0.0f ? centroid / area : centroid;
+        normals[c] = normal;
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+
+    // Clusters, which are far away from the center and face outwards, will occlude the others
+    TArray<f32> keys;
+    TArray<size_t> order;
+    keys.resize(numClusters);
+    order.resize(numClusters);
+    for (size_t c = 0; c < numClusters; ++c) {
+        const f32 length = glm::length(normals[c]);
+        keys[c] = length > 0.0f ? glm::dot(centroids[c] - meshCentroid, normals[c] / length) : 0.0f;
+        order[c] = c;
+    }
+    std::stable_sort(&order[0], &order[0] + numClusters, [&keys](size_t lhs, size_t rhs) {
+        return keys[lhs] > keys[rhs];
+    });
+
+    TArray<ui32> result;
+    result.resize(numTriangles * 3);
+    size_t out = 0;
+    for (size_t c = 0; c < numClusters; ++c) {
+        const size_t cluster = order[c];
+        const size_t count = (clusters[cluster + 1] - clusters[cluster]) * 3;
+        ::memcpy(&result[out], &indices[clusters[cluster] * 3], count * sizeof(ui32));
+        out += count;
+    }
+
+    ::memcpy(indices, &result[0], numTriangles * 3 * sizeof(ui32));
+}
+
+size_t MeshOptimizer::optimizeVertexFetch(c8 *vertexData, size_t numVertices, size_t stride, ui32 *indices,
+        size_t numIndices) {
+    if (nullptr == vertexData || 0 == stride || !hasValidIndices(indices, numIndices, numVertices)) {
+        return 0;
+    }
+
+    TArray<ui32> remap;
+    remap.resize(numVertices);
+    for (size_t i = 0; i < numVertices; ++i) {
+        remap[i] = InvalidIndex;
+    }
+
+    ui32 next = 0;
+    for (size_t i = 0; i < numIndices; ++i) {
+        ui32 &target = remap[indices[i]];
+        if (InvalidIndex == target) {
+            target = next++;
+        }
+        indices[i] = target;
+    }
+    const size_t numUsed = next;
+
+    // Unreferenced vertices are kept behind the referenced ones, so the vertex count will not change
+    for (size_t i = 0; i < numVertices; ++i) {
+        if (InvalidIndex == remap[i]) {
+            remap[i] = next++;
+        }
+    }
+
+    TArray<c8> source;
+    source.resize(numVertices * stride);
+    ::memcpy(&source[0], vertexData, numVertices * stride);
+    for (size_t i = 0; i < numVertices; ++i) {
+        ::memcpy(vertexData + remap[i] * stride, &source[i * stride], stride);
+    }
+
+    return numUsed;
+}
+
+} // namespace OSRE::RenderBackend
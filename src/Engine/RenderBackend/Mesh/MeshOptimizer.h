@@ -0,0 +1,95 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+
+namespace OSRE {
+namespace RenderBackend {
+
+/// @brief The post transform vertex cache efficiency of an indexed triangle list.
+struct VertexCacheStatistics {
+    size_t mNumTransforms;  ///< The number of vertex shader invocations, one per cache miss.
+    size_t mNumTriangles;   ///< The number of triangles.
+    size_t mNumVertices;    ///< The number of referenced vertices.
+    f32 mAcmr;              ///< The average cache miss ratio, transformed vertices per triangle.
+    f32 mAtvr;              ///< The average transform to vertex ratio, 1 is optimal.
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements index and vertex reordering for indexed triangle lists.
+///
+/// The vertex cache optimization uses the linear-speed algorithm by Tom Forsyth. The overdraw
+/// optimization splits the cache optimized triangles into clusters, which keep the cache
+/// efficiency within a threshold, and draws the outward-facing clusters first. The vertex
+/// fetch optimization stores the vertices in the order of their first use. Overdraw
+/// optimization requires the position as three floats at the start of each vertex.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT MeshOptimizer {
+public:
+    /// @brief The FIFO cache size used for the statistics.
+    static constexpr ui32 DefaultCacheSize = 16;
+
+    /// @brief The accepted cache miss ratio of a cluster relative to the source, used for overdraw.
+    static constexpr f32 DefaultOverdrawThreshold = 1.05f;
+
+    /// @brief Will simulate a FIFO vertex cache.
+    /// @param[in] indices      The triangle indices.
+    /// @param[in] numIndices   The number of indices.
+    /// @param[in] numVertices  The number of vertices.
+    /// @param[in] cacheSize    The number of cache entries.
+    /// @return The cache statistics.
+    static VertexCacheStatistics analyzeVertexCache(const ui32 *indices, size_t numIndices, size_t numVertices,
+            ui32 cacheSize = DefaultCacheSize);
+
+    /// @brief Will reorder the triangles to reduce the number of vertex cache misses.
+    /// @param[inout] indices       The triangle indices.
+    /// @param[in]    numIndices    The number of indices.
+    /// @param[in]    numVertices   The number of vertices.
+    static void optimizeVertexCache(ui32 *indices, size_t numIndices, size_t numVertices);
+
+    /// @brief Will reorder the clusters of cache optimized triangles to reduce overdraw.
+    /// @param[inout] indices       The cache optimized triangle indices.
+    /// @param[in]    numIndices    The number of indices.
+    /// @param[in]    vertexData    The vertex data.
+    /// @param[in]    numVertices   The number of vertices.
+    /// @param[in]    stride        The vertex stride in bytes.
+    /// @param[in]    threshold     The accepted cache miss ratio relative to the input.
+    static void optimizeOverdraw(ui32 *indices, size_t numIndices, const c8 *vertexData, size_t numVertices,
+            size_t stride, f32 threshold = DefaultOverdrawThreshold);
+
+    /// @brief Will reorder the vertices in the order of their first use and remap the indices.
+    /// @param[inout] vertexData    The vertex data.
+    /// @param[in]    numVertices   The number of vertices.
+    /// @param[in]    stride        The vertex stride in bytes.
+    /// @param[inout] indices       The indices.
+    /// @param[in]    numIndices    The number of indices.
+    /// @return The number of referenced vertices, unreferenced ones are moved behind them.
+    static size_t optimizeVertexFetch(c8 *vertexData, size_t numVertices, size_t stride, ui32 *indices,
+            size_t numIndices);
+};
+
+} // Namespace RenderBackend
+} // Namespace OSRE
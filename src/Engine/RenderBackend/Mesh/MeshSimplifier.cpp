@@ -0,0 +1,380 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "RenderBackend/Mesh/MeshSimplifier.h"
+#include "Common/glm_common.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace OSRE::RenderBackend {
+
+using namespace ::cppcore;
+
+namespace {
+
+// The symmetric 4x4 error matrix, which stores the sum of the squared distances to a set of planes
+struct Quadric {
+    d32 a2, ab, ac, ad, b2, bc, bd, c2, cd, d2;
+
+    Quadric() :
+            a2(0), ab(0), ac(0), ad(0), b2(0), bc(0), bd(0), c2(0), cd(0), d2(0) {
+        // empty
+    }
+
+    void addPlane(d32 a, d32 b, d32 c, d32 d) {
+        a2 += a * a; ab += a * b; ac += a * c; ad += a * d;
+        b2 += b * b; bc += b * c; bd += b * d;
+        c2 += c * c; cd += c * d;
+        d2 += d * d;
+    }
+
+    void add(const Quadric &rhs) {
+        a2 += rhs.a2; ab += rhs.ab; ac += rhs.ac; ad += rhs.ad;
+        b2 += rhs.b2; bc += rhs.bc; bd += rhs.bd;
+        c2 += rhs.c2; cd += rhs.cd;
+        d2 += rhs.d2;
+    }
+
+    d32 eval(const glm::vec3 &p) const {
+        const d32 x = p.x, y = p.y, z = p.z;
+        const d32 err = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+                + b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+                + c2 * z * z + 2.0 * cd * z + d2;
+
+        return err > 0.0 ? err : 0.0;
+    }
+};
+
+// Describes the collapse of the source vertex onto the target vertex
+struct Collapse {
+    ui32 mSource;
+    ui32 mTarget;
+    d32 mCost;
+};
+
+static constexpr ui32 InvalidVertex = std::numeric_limits<ui32>::max();
+
+static bool lessPosition(const glm::vec3 &lhs, const glm::vec3 &rhs) {
+    if (lhs.x != rhs.x) {
+        return lhs.x < rhs.x;
+    }
+    if (lhs.y != rhs.y) {
+        return lhs.y < rhs.y;
+    }
+    return lhs.z < rhs.z;
+}
+
+static ui64 edgeKey(ui32 a, ui32 b) {
+    return a < b ? (static_cast<ui64>(a) << 32) | b : (static_cast<ui64>(b) << 32) | a;
+}
+
+// Will lock all vertices, which share their position with other vertices or are part of an open border.
+static void lockSeamsAndBorders(const TArray<glm::vec3> &positions, const TArray<ui32> &indices, TArray<uc8> &locked) {
+    const size_t numVertices = positions.size();
+    TArray<ui32> order;
+    order.resize(numVertices);
+    for (size_t i = 0; i < numVertices; ++i) {
+        order[i] = static_cast<ui32>(i);
+    }
+    std::sort(&order[0], &order[0] + numVertices, [&positions](ui32 lhs, ui32 rhs) {
+        return lessPosition(positions[lhs], positions[rhs]);
+    });
+
+    // Weld vertices with the same position, the first one of a group is the representative
+    TArray<ui32> weld;
+    weld.resize(numVertices);
+    size_t groupStart = 0;
+    for (size_t i = 0; i <= numVertices; ++i) {
+        if (i < numVertices && positions[order[i]] == positions[order[groupStart]]) {
+            continue;
+        }
+
+        for (size_t j = groupStart; j < i; ++j) {
+            weld[order[j]] = order[groupStart];
+            locked[order[j]] = (i - groupStart) > 1 ? 1 : 0;
+        }
+        groupStart = i;
+    }
+
+    // Edges of the welded topology, which are used by one triangle only, are part of a border
+    TArray<ui64> edges;
+    edges.reserve(indices.size());
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        for (size_t e = 0; e < 3; ++e) {
+            const ui32 a = weld[indices[i + e]], b = weld[indices[i + (e + 1) % 3]];
+            if (a != b) {
+                edges.add(edgeKey(a, b));
+            }
+        }
+    }
+    if (edges.isEmpty()) {
+        return;
+    }
+    std::sort(&edges[0], &edges[0] + edges.size());
+
+    TArray<uc8> borderWeld;
+    borderWeld.resize(numVertices);
+    ::memset(&borderWeld[0], 0, numVertices);
+    for (size_t i = 0; i < edges.size();) {
+        size_t j = i + 1;
+        while (j < edges.size() && edges[j] == edges[i]) {
+            ++j;
+        }
+        if (j - i == 1) {
+            borderWeld[static_cast<ui32>(edges[i] >> 32)] = 1;
+            borderWeld[static_cast<ui32>(edges[i] & 0xffffffff)] = 1;
+        }
+        i = j;
+    }
+
+    for (size_t i = 0; i < numVertices; ++i) {
+        if (borderWeld[weld[i]] != 0) {
+            locked[i] = 1;
+        }
+    }
+}
+
+// Will check, if moving the source vertex onto the target flips one of the remaining triangles.
+static bool flipsTriangle(ui32 source, ui32 target, const TArray<glm::vec3> &positions, const TArray<ui32> &indices,
+        const TArray<ui32> &adjOffsets, const TArray<ui32> &adjTris) {
+    for (ui32 k = adjOffsets[source]; k < adjOffsets[source + 1]; ++k) {
+        const size_t tri = adjTris[k] * 3;
+        const ui32 i0 = indices[tri], i1 = indices[tri + 1], i2 = indices[tri + 2];
+        if (i0 == target || i1 == target || i2 == target) {
+            continue;
+        }
+
+        const glm::vec3 &p0 = positions[i0], &p1 = positions[i1], &p2 = positions[i2];
+        const glm::vec3 q0 = i0 == source ? positions[target] : p0;
+        const glm::vec3 q1 = i1 == source ? positions[target] : p1;
+        const glm::vec3 q2 = i2 == source ? positions[target] : p2;
+        const glm::vec3 oldNormal = glm::cross(p1 - p0, p2 - p0);
+        const glm::vec3 newNormal = glm::cross(q1 - q0, q2 - q0);
+        if (glm::dot(oldNormal, newNormal) <= 0.0f) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace
+
+f32 MeshSimplifier::simplify(const c8 *vertexData, size_t numVertices, size_t stride, const ui32 *indices,
+        size_t numIndices, size_t targetIndexCount, TArray<ui32> &result) {
+    result.resize(0);
+    if (nullptr == vertexData || nullptr == indices || 0 == numVertices || stride < sizeof(f32) * 3) {
+        return 0.0f;
+    }
+
+    numIndices -= numIndices % 3;
+    if (0 == numIndices) {
+        return 0.0f;
+    }
+    result.add(indices, numIndices);
+    if (targetIndexCount >= numIndices) {
+        return 0.0f;
+    }
+
+    TArray<glm::vec3> positions;
+    positions.resize(numVertices);
+    for (size_t i = 0; i < numVertices; ++i) {
+        const f32 *pos = reinterpret_cast<const f32 *>(vertexData + i * stride);
+        positions[i] = glm::vec3(pos[0], pos[1], pos[2]);
+    }
+
+    TArray<uc8> locked;
+    locked.resize(numVertices);
+    ::memset(&locked[0], 0, numVertices);
+    lockSeamsAndBorders(positions, result, locked);
+
+    TArray<Quadric> quadrics;
+    quadrics.resize(numVertices);
+    for (size_t i = 0; i < numVertices; ++i) {
+        quadrics[i] = Quadric();
+    }
+    for (size_t i = 0; i < numIndices; i += 3) {
+        const glm::vec3 &p0 = positions[result[i]];
+        glm::vec3 normal = glm::cross(positions[result[i + 1]] - p0, positions[result[i + 2]] - p0);
+        const f32 len = glm::length(normal);
+        if (len <= 0.0f) {
+            continue;
+        }
+        normal /= len;
+        const f32 d = -glm::dot(normal, p0);
+        for (size_t j = 0; j < 3; ++j) {
+            quadrics[result[i + j]].addPlane(normal.x, normal.y, normal.z, d);
+        }
+    }
+
+    TArray<ui32> adjOffsets, adjTris, bestTarget, remap;
+    TArray<d32> bestCost;
+    TArray<uc8> touched;
+    TArray<Collapse> collapses;
+    adjOffsets.resize(numVertices + 1);
+    bestTarget.resize(numVertices);
+    bestCost.resize(numVertices);
+    touched.resize(numVertices);
+    remap.resize(numVertices);
+    for (size_t i = 0; i < numVertices; ++i) {
+        remap[i] = static_cast<ui32>(i);
+    }
+
+    d32 maxCost = 0.0;
+    size_t count = numIndices;
+    while (count > targetIndexCount) {
+        const size_t numTris = count / 3;
+
+        // Triangles per vertex
+        ::memset(&adjOffsets[0], 0, sizeof(ui32) * adjOffsets.size());
+        for (size_t i = 0; i < count; ++i) {
+            ++adjOffsets[result[i] + 1];
+        }
+        for (size_t i = 0; i < numVertices; ++i) {
+            adjOffsets[i + 1] += adjOffsets[i];
+        }
+        adjTris.resize(count);
+        for (size_t i = 0; i < count; ++i) {
+            adjTris[adjOffsets[result[i]]++] = static_cast<ui32>(i / 3);
+        }
+        for (size_t i = numVertices; i > 0; --i) {
+            adjOffsets[i] = adjOffsets[i - 1];
+        }
+        adjOffsets[0] = 0;
+
+        // The cheapest collapse for each vertex
+        for (size_t i = 0; i < numVertices; ++i) {
+            bestTarget[i] = InvalidVertex;
+            bestCost[i] = std::numeric_limits<d32>::max();
+            touched[i] = 0;
+        }
+        for (size_t tri = 0; tri < numTris; ++tri) {
+            for (size_t e = 0; e < 3; ++e) {
+                const ui32 source = result[tri * 3 + e];
+                if (locked[source] != 0) {
+                    continue;
+                }
+                for (size_t o = 1; o < 3; ++o) {
+                    const ui32 target = result[tri * 3 + (e + o) % 3];
+                    Quadric q = quadrics[source];
+                    q.add(quadrics[target]);
+                    const d32 cost = q.eval(positions[target]);
+                    if (cost < bestCost[source]) {
+                        bestCost[source] = cost;
+                        bestTarget[source] = target;
+                    }
+                }
+            }
+        }
+
+        collapses.resize(0);
+        for (size_t i = 0; i < numVertices; ++i) {
+            if (bestTarget[i] != InvalidVertex) {
+                collapses.add({ static_cast<ui32>(i), bestTarget[i], bestCost[i] });
+            }
+        }
+        if (collapses.isEmpty()) {
+            break;
+        }
+        std::sort(&collapses[0], &collapses[0] + collapses.size(), [](const Collapse &lhs, const Collapse &rhs) {
+            return lhs.mCost < rhs.mCost;
+        });
+
+        // Each collapse removes about two triangles, the collapses of one pass must not share any triangle
+        const size_t trianglesToRemove = (count - targetIndexCount) / 3;
+        size_t removed = 0;
+        for (size_t i = 0; i < collapses.size() && removed < trianglesToRemove; ++i) {
+            const Collapse &c = collapses[i];
+            if (touched[c.mSource] != 0 || touched[c.mTarget] != 0) {
+                continue;
+            }
+            if (flipsTriangle(c.mSource, c.mTarget, positions, result, adjOffsets, adjTris)) {
+                continue;
+            }
+
+            remap[c.mSource] = c.mTarget;
+            quadrics[c.mTarget].add(quadrics[c.mSource]);
+            maxCost = std::max(maxCost, c.mCost);
+            for (ui32 k = adjOffsets[c.mSource]; k < adjOffsets[c.mSource + 1]; ++k) {
+                const size_t tri = adjTris[k] * 3;
+                touched[result[tri]] = touched[result[tri + 1]] = touched[result[tri + 2]] = 1;
+                if (result[tri] == c.mTarget || result[tri + 1] == c.mTarget || result[tri + 2] == c.mTarget) {
+                    ++removed;
+                }
+            }
+        }
+        if (0 == removed) {
+            break;
+        }
+
+        // Rebuild the triangle list without the degenerated triangles
+        size_t newCount = 0;
+        for (size_t i = 0; i < count; i += 3) {
+            const ui32 a = remap[result[i]], b = remap[result[i + 1]], c = remap[result[i + 2]];
+            if (a == b || b == c || a == c) {
+                continue;
+            }
+            result[newCount++] = a;
+            result[newCount++] = b;
+            result[newCount++] = c;
+        }
+        count = newCount;
+    }
+    result.resize(count);
+
+    return static_cast<f32>(std::sqrt(maxCost));
+}
+
+size_t MeshSimplifier::generateLodChain(const c8 *vertexData, size_t numVertices, size_t stride,
+        TArray<ui32> &indices, MeshLodArray &lods, size_t maxLods) {
+    lods.clear();
+    if (indices.isEmpty()) {
+        return 0;
+    }
+
+    lods.add({ 0u, static_cast<ui32>(indices.size()), 0.0f });
+
+    TArray<ui32> current, simplified;
+    current = indices;
+    f32 error = 0.0f;
+    while (lods.size() < maxLods && current.size() / 3 >= MinLodTriangles * 2) {
+        const size_t target = (current.size() / 6) * 3;
+        const f32 levelError = simplify(vertexData, numVertices, stride, &current[0], current.size(), target, simplified);
+
+        // Stop when the mesh cannot be reduced noticeably any more
+        if (simplified.isEmpty() || simplified.size() * 4 > current.size() * 3) {
+            break;
+        }
+
+        // The errors of the levels are measured against their predecessor, so sum them up as an upper bound
+        error += levelError;
+        lods.add({ static_cast<ui32>(indices.size()), static_cast<ui32>(simplified.size()), error });
+        indices.add(&simplified[0], simplified.size());
+        current = simplified;
+    }
+
+    return lods.size();
+}
+
+} // namespace OSRE::RenderBackend
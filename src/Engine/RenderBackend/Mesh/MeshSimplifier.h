@@ -0,0 +1,76 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+#include "RenderBackend/Mesh.h"
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements a quadric error mesh simplification for indexed triangle lists.
+///
+/// The simplification collapses vertices onto their neighbours, so no new vertices will be
+/// created and all levels can share the vertex buffer of the source mesh. Each vertex must
+/// start with its position as three floats. Vertices on open borders and on attribute seams
+/// will be kept to preserve the silhouette and the texture mapping.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT MeshSimplifier {
+public:
+    /// @brief The default number of levels in a level of detail chain.
+    static constexpr size_t DefaultMaxLods = 4;
+
+    /// @brief Triangle count below which no further level will be generated.
+    static constexpr size_t MinLodTriangles = 64;
+
+    /// @brief Will simplify a triangle list.
+    /// @param[in]  vertexData        The vertex data.
+    /// @param[in]  numVertices       The number of vertices.
+    /// @param[in]  stride            The vertex stride in bytes.
+    /// @param[in]  indices           The triangle indices.
+    /// @param[in]  numIndices        The number of indices.
+    /// @param[in]  targetIndexCount  The number of indices to reach.
+    /// @param[out] result            The simplified triangle indices.
+    /// @return The geometric error of the simplified mesh in mesh-local units.
+    static f32 simplify(const c8 *vertexData, size_t numVertices, size_t stride, const ui32 *indices,
+            size_t numIndices, size_t targetIndexCount, cppcore::TArray<ui32> &result);
+
+    /// @brief Will generate a level of detail chain, each level will have half of the triangles of its predecessor.
+    /// @param[in]    vertexData    The vertex data.
+    /// @param[in]    numVertices   The number of vertices.
+    /// @param[in]    stride        The vertex stride in bytes.
+    /// @param[inout] indices       The triangle indices, the coarser levels will be appended.
+    /// @param[out]   lods          The index ranges of all levels, the first one is the source mesh.
+    /// @param[in]    maxLods       The maximal number of levels.
+    /// @return The number of generated levels.
+    static size_t generateLodChain(const c8 *vertexData, size_t numVertices, size_t stride,
+            cppcore::TArray<ui32> &indices, MeshLodArray &lods, size_t maxLods = DefaultMaxLods);
+};
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,306 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "RenderBackend/Mesh/MeshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace OSRE::RenderBackend {
+
+using namespace ::OSRE::Common;
+using namespace ::cppcore;
+
+namespace {
+
+static constexpr ui32 InvalidIndex = std::numeric_limits<ui32>::max();
+
+// The triangles using a vertex, stored as one list with an offset per vertex
+struct TriangleAdjacency {
+    TArray<ui32> mOffsets;
+    TArray<ui32> mTriangles;
+
+    void build(const ui32 *indices, size_t numTriangles, size_t numVertices) {
+        mOffsets.resize(numVertices + 1);
+        for (size_t i = 0; i <= numVertices; ++i) {
+            mOffsets[i] = 0;
+        }
+        for (size_t i = 0; i < numTriangles * 3; ++i) {
+            ++mOffsets[indices[i] + 1];
+        }
+        for (size_t i = 0; i < numVertices; ++i) {
+            mOffsets[i + 1] += mOffsets[i];
+        }
+
+        TArray<ui32> cursor;
+        cursor.resize(numVertices);
+        for (size_t i = 0; i < numVertices; ++i) {
+            cursor[i] = mOffsets[i];
+        }
+        mTriangles.resize(numTriangles * 3);
+        for (size_t i = 0; i < numTriangles * 3; ++i) {
+            mTriangles[cursor[indices[i]]++] = static_cast<ui32>(i / 3);
+        }
+    }
+};
+
+static void calcBounds(Meshlet &meshlet, const ui32 *indices, const glm::vec3 *positions) {
+    glm::vec3 minPos = positions[indices[0]];
+    glm::vec3 maxPos = minPos;
+    for (ui32 i = 1; i < meshlet.mNumIndices; ++i) {
+        minPos = glm::min(minPos, positions[indices[i]]);
+        maxPos = glm::max(maxPos, positions[indices[i]]);
+    }
+
+    meshlet.mCenter = (minPos + maxPos) * 0.5f;
+    meshlet.mRadius = 0.0f;
+    for (ui32 i = 0; i < meshlet.mNumIndices; ++i) {
+        meshlet.mRadius = std::max(meshlet.mRadius, glm::length(positions[indices[i]] - meshlet.mCenter));
+    }
+
+    // The cone axis is the average normal, degenerated triangles have no direction
+    glm::vec3 axis(0.0f, 0.0f, 0.0f);
+    for (ui32 i = 0; i + 2 < meshlet.mNumIndices; i += 3) {
+        const glm::vec3 &p0 = positions[indices[i]];
+        const glm::vec3 normal = glm::cross(positions[indices[i + 1]] - p0, positions[indices[i + 2]] - p0);
+        const f32 len = glm::length(normal);
+        if (len > 0.0f) {
+            axis += normal / len;
+        }
+    }
+
+    meshlet.mConeAxis = glm::vec3(0.0f, 0.0f, 0.0f);
+    meshlet.mConeCutoff = 1.0f;
+    const f32 axisLen = glm::length(axis);
+    if (axisLen < 1e-6f) {
+        return;
+    }
+    axis /= axisLen;
+
+    f32 minDot = 1.0f;
+    for (ui32 i = 0; i + 2 < meshlet.mNumIndices; i += 3) {
+        const glm::vec3 &p0 = positions[indices[i]];
+        const glm::vec3 normal = glm::cross(positions[indices[i + 1]] - p0, positions[indices[i + 2]] - p0);
+        const f32 len = glm::length(normal);
+        if (len > 0.0f) {
+            minDot = std::min(minDot, glm::dot(normal / len, axis));
+        }
+    }
+
+    // A spread of 90 degrees or more contains normals facing every direction
+    meshlet.mConeAxis = axis;
+    if (minDot > 0.0f) {
+        meshlet.mConeCutoff = std::sqrt(1.0f - minDot * minDot);
+    }
+}
+
+} // namespace
+
+size_t MeshletBuilder::build(ui32 *indices, size_t numIndices, const glm::vec3 *positions, size_t numVertices,
+        ui32 startIndex, MeshletArray &meshlets, ui32 maxVertices, ui32 maxTriangles) {
+    if (nullptr == indices || nullptr == positions || numIndices < 3 || 0 == numVertices || maxVertices < 3 || 0 == maxTriangles) {
+        return 0;
+    }
+
+    const size_t numTriangles = numIndices / 3;
+    for (size_t i = 0; i < numTriangles * 3; ++i) {
+        if (indices[i] >= numVertices) {
+            return 0;
+        }
+    }
+
+    TriangleAdjacency adjacency;
+    adjacency.build(indices, numTriangles, numVertices);
+
+    TArray<uc8> emitted;
+    emitted.resize(numTriangles);
+    for (size_t i = 0; i < numTriangles; ++i) {
+        emitted[i] = 0;
+    }
+
+    // The number of the last meshlet using the vertex, so new vertices can be counted without a search
+    TArray<ui32> vertexMeshlet;
+    vertexMeshlet.resize(numVertices);
+    for (size_t i = 0; i < numVertices; ++i) {
+        vertexMeshlet[i] = InvalidIndex;
+    }
+
+    TArray<ui32> result;
+    result.resize(numTriangles * 3);
+    TArray<ui32> meshletVertices;
+    ui32 meshletId = 0;
+    size_t meshletStart = 0, numMeshletTriangles = 0, numWritten = 0, cursor = 0, numMeshlets = 0;
+
+    auto countNewVertices = [&](size_t triangle) {
+        ui32 count = 0;
+        for (size_t k = 0; k < 3; ++k) {
+            if (vertexMeshlet[indices[triangle * 3 + k]] != meshletId) {
+                ++count;
+            }
+        }
+        return count;
+    };
+
+    auto finishMeshlet = [&]() {
+        Meshlet meshlet;
+        meshlet.mStartIndex = startIndex + static_cast<ui32>(meshletStart * 3);
+        meshlet.mNumIndices = static_cast<ui32>(numMeshletTriangles * 3);
+        meshlet.mNumVertices = static_cast<ui32>(meshletVertices.size());
+        calcBounds(meshlet, &result[meshletStart * 3], positions);
+        meshlets.add(meshlet);
+        ++numMeshlets;
+
+        ++meshletId;
+        meshletStart = numWritten;
+        numMeshletTriangles = 0;
+        meshletVertices.resize(0);
+    };
+
+    while (numWritten < numTriangles) {
+        // Prefer the connected triangle which adds the fewest vertices
+        size_t best = InvalidIndex;
+        ui32 bestNew = 4;
+        for (size_t i = 0; i < meshletVertices.size() && bestNew > 0; ++i) {
+            const ui32 vertex = meshletVertices[i];
+            for (ui32 j = adjacency.mOffsets[vertex]; j < adjacency.mOffsets[vertex + 1]; ++j) {
+                const ui32 triangle = adjacency.mTriangles[j];
+                if (0 != emitted[triangle]) {
+                    continue;
+                }
+                const ui32 numNew = countNewVertices(triangle);
+                if (numNew < bestNew || (numNew == bestNew && triangle < best)) {
+                    best = triangle;
+                    bestNew = numNew;
+                }
+            }
+        }
+
+        // Nothing connected is left, continue with the input order
+        if (InvalidIndex == best) {
+            while (0 != emitted[cursor]) {
+                ++cursor;
+            }
+            best = cursor;
+            bestNew = countNewVertices(best);
+        }
+
+        if (numMeshletTriangles == maxTriangles || meshletVertices.size() + bestNew > maxVertices) {
+            finishMeshlet();
+            continue;
+        }
+
+        for (size_t k = 0; k < 3; ++k) {
+            const ui32 vertex = indices[best * 3 + k];
+            if (vertexMeshlet[vertex] != meshletId) {
+                vertexMeshlet[vertex] = meshletId;
+                meshletVertices.add(vertex);
+            }
+            result[numWritten * 3 + k] = vertex;
+        }
+        emitted[best] = 1;
+        ++numWritten;
+        ++numMeshletTriangles;
+    }
+    finishMeshlet();
+
+    for (size_t i = 0; i < result.size(); ++i) {
+        indices[i] = result[i];
+    }
+
+    return numMeshlets;
+}
+
+void MeshletBuilder::computeBounds(Meshlet &meshlet, const ui32 *indices, const glm::vec3 *positions) {
+    if (nullptr == indices || nullptr == positions || meshlet.mNumIndices < 3) {
+        return;
+    }
+
+    calcBounds(meshlet, &indices[meshlet.mStartIndex], positions);
+}
+
+bool MeshletCuller::isVisible(const Meshlet &meshlet, const Frustum &frustum, const glm::vec3 &eye) {
+    if (!frustum.isIn(meshlet.mCenter, meshlet.mRadius)) {
+        return false;
+    }
+
+    // Back-facing if the view direction is inside the cone, the sphere keeps the test conservative
+    if (meshlet.mConeCutoff < 1.0f) {
+        const glm::vec3 toCenter = meshlet.mCenter - eye;
+        if (glm::dot(toCenter, meshlet.mConeAxis) >= meshlet.mConeCutoff * glm::length(toCenter) + meshlet.mRadius) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+size_t MeshletCuller::cull(const MeshletArray &meshlets, const Frustum &frustum, const glm::vec3 &eye,
+        const ui32 *indices, TArray<ui32> &visibleIndices) {
+    visibleIndices.resize(0);
+    if (nullptr == indices) {
+        return 0;
+    }
+
+    size_t numVisible = 0;
+    for (size_t i = 0; i < meshlets.size(); ++i) {
+        const Meshlet &meshlet = meshlets[i];
+        if (!isVisible(meshlet, frustum, eye)) {
+            continue;
+        }
+
+        for (ui32 j = 0; j < meshlet.mNumIndices; ++j) {
+            visibleIndices.add(indices[meshlet.mStartIndex + j]);
+        }
+        ++numVisible;
+    }
+
+    return numVisible;
+}
+
+size_t MeshletCuller::cull(const MeshletArray &meshlets, const Frustum &frustum, const glm::vec3 &eye,
+        DrawIndirectCommandArray &commands) {
+    commands.resize(0);
+
+    size_t numVisible = 0;
+    for (size_t i = 0; i < meshlets.size(); ++i) {
+        const Meshlet &meshlet = meshlets[i];
+        if (!isVisible(meshlet, frustum, eye)) {
+            continue;
+        }
+        ++numVisible;
+
+        // Visible neighbours in the index buffer can be drawn with one command
+        if (!commands.isEmpty()) {
+            DrawIndirectCommand &last = commands[commands.size() - 1];
+            if (last.mFirstIndex + last.mCount == meshlet.mStartIndex) {
+                last.mCount += meshlet.mNumIndices;
+                continue;
+            }
+        }
+        commands.add({ meshlet.mNumIndices, 1, meshlet.mStartIndex, 0, 0 });
+    }
+
+    return numVisible;
+}
+
+} // namespace OSRE::RenderBackend
@@ -0,0 +1,136 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+#include "Common/glm_common.h"
+#include "Common/Frustum.h"
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace RenderBackend {
+
+/// @brief A cluster of triangles, stored as a contiguous range in the index buffer.
+///
+/// The bounds are in mesh-local units. A cluster is back-facing for every viewer in the cone
+/// along its axis, a cutoff of 1 means the cone cannot be used for culling.
+struct Meshlet {
+    ui32 mStartIndex;       ///< The first index of the cluster.
+    ui32 mNumIndices;       ///< The number of indices of the cluster.
+    ui32 mNumVertices;      ///< The number of unique vertices of the cluster.
+    glm::vec3 mCenter;      ///< The center of the bounding sphere.
+    f32 mRadius;            ///< The radius of the bounding sphere.
+    glm::vec3 mConeAxis;    ///< The average direction of the triangle normals.
+    f32 mConeCutoff;        ///< The sine of the normal cone spread angle.
+};
+
+using MeshletArray = cppcore::TArray<Meshlet>;
+
+/// @brief An indexed indirect draw, the layout matches the GL DrawElementsIndirectCommand.
+struct DrawIndirectCommand {
+    ui32 mCount;            ///< The number of indices.
+    ui32 mInstanceCount;    ///< The number of instances.
+    ui32 mFirstIndex;       ///< The first index.
+    i32 mBaseVertex;        ///< The offset added to each index.
+    ui32 mBaseInstance;     ///< The first instance.
+};
+
+using DrawIndirectCommandArray = cppcore::TArray<DrawIndirectCommand>;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class splits an indexed triangle list into meshlets.
+///
+/// The triangles are collected greedily, the next triangle of a meshlet is the connected one
+/// which adds the fewest new vertices. Run it on cache optimized indices, the input order is
+/// used to start a new meshlet.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT MeshletBuilder {
+public:
+    /// @brief The default maximum number of vertices of a meshlet.
+    static constexpr ui32 MaxVertices = 64;
+
+    /// @brief The default maximum number of triangles of a meshlet.
+    static constexpr ui32 MaxTriangles = 124;
+
+    /// @brief Will reorder the triangles into meshlets.
+    /// @param[inout] indices       The triangle indices, will be stored in meshlet order.
+    /// @param[in]    numIndices    The number of indices.
+    /// @param[in]    positions     The vertex positions.
+    /// @param[in]    numVertices   The number of vertices.
+    /// @param[in]    startIndex    The offset of the indices in the index buffer, added to the meshlet start.
+    /// @param[out]   meshlets      The new meshlets will be added.
+    /// @param[in]    maxVertices   The maximum number of vertices per meshlet.
+    /// @param[in]    maxTriangles  The maximum number of triangles per meshlet.
+    /// @return The number of added meshlets.
+    static size_t build(ui32 *indices, size_t numIndices, const glm::vec3 *positions, size_t numVertices,
+            ui32 startIndex, MeshletArray &meshlets, ui32 maxVertices = MaxVertices, ui32 maxTriangles = MaxTriangles);
+
+    /// @brief Will calculate the bounding sphere and the normal cone of a meshlet.
+    /// @param[inout] meshlet   The meshlet, the index range must be set.
+    /// @param[in]    indices   The indices of the whole index buffer.
+    /// @param[in]    positions The vertex positions.
+    static void computeBounds(Meshlet &meshlet, const ui32 *indices, const glm::vec3 *positions);
+};
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements the per meshlet frustum and back-face cone culling on the CPU.
+///
+/// Frustum and eye must be given in the mesh-local space, extract the frustum from the
+/// view-projection matrix multiplied with the model matrix.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT MeshletCuller {
+public:
+    /// @brief Will check if a meshlet is potentially visible.
+    /// @param[in] meshlet  The meshlet to check.
+    /// @param[in] frustum  The view frustum.
+    /// @param[in] eye      The position of the viewer.
+    /// @return true if the meshlet intersects the frustum and has a front-facing triangle.
+    static bool isVisible(const Meshlet &meshlet, const Common::Frustum &frustum, const glm::vec3 &eye);
+
+    /// @brief Will copy the indices of the visible meshlets into a compacted index list.
+    /// @param[in]  meshlets        The meshlets.
+    /// @param[in]  frustum         The view frustum.
+    /// @param[in]  eye             The position of the viewer.
+    /// @param[in]  indices         The indices of the whole index buffer.
+    /// @param[out] visibleIndices  The indices of the visible meshlets, will be replaced.
+    /// @return The number of visible meshlets.
+    static size_t cull(const MeshletArray &meshlets, const Common::Frustum &frustum, const glm::vec3 &eye,
+            const ui32 *indices, cppcore::TArray<ui32> &visibleIndices);
+
+    /// @brief Will create the indirect draws for the visible meshlets, neighbours are merged.
+    /// @param[in]  meshlets    The meshlets.
+    /// @param[in]  frustum     The view frustum.
+    /// @param[in]  eye         The position of the viewer.
+    /// @param[out] commands    The draw commands, will be replaced.
+    /// @return The number of visible meshlets.
+    static size_t cull(const MeshletArray &meshlets, const Common::Frustum &frustum, const glm::vec3 &eye,
+            DrawIndirectCommandArray &commands);
+};
+
+} // Namespace RenderBackend
+} // Namespace OSRE
@@ -0,0 +1,213 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "RenderBackend/Mesh/VertexQuantizer.h"
+#include "RenderBackend/Mesh.h"
+
+#include <cppcore/Container/TArray.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace OSRE::RenderBackend {
+
+static constexpr f32 Snorm16Max = 32767.0f;
+
+ui16 VertexQuantizer::toHalf(f32 value) {
+    ui32 bits = 0;
+    ::memcpy(&bits, &value, sizeof(bits));
+    const ui32 sign = (bits >> 16) & 0x8000u;
+    const ui32 floatExponent = (bits >> 23) & 0xffu;
+    ui32 mantissa = bits & 0x7fffffu;
+
+    // Infinity and NaN
+    if (0xffu == floatExponent) {
+        return static_cast<ui16>(sign | 0x7c00u | (0 != mantissa ? 0x200u : 0u));
+    }
+
+    const i32 exponent = static_cast<i32>(floatExponent) - 127 + 15;
+    if (exponent >= 31) {
+        return static_cast<ui16>(sign | 0x7c00u);
+    }
+
+    // Denormalized half floats, too small values become zero
+    if (exponent <= 0) {
+        if (exponent < -10) {
+            return static_cast<ui16>(sign);
+        }
+        mantissa |= 0x800000u;
+        const ui32 shift = static_cast<ui32>(14 - exponent);
+        ui32 half = mantissa >> shift;
+        if (0 != ((mantissa >> (shift - 1)) & 1u)) {
+            ++half;
+        }
+        return static_cast<ui16>(sign | half);
+    }
+
+    // A carry of the rounding will move into the exponent, which is the correct result
+    ui32 half = sign | (static_cast<ui32>(exponent) << 10) | (mantissa >> 13);
+    if (0 != (mantissa & 0x1000u)) {
+        ++half;
+    }
+
+    return static_cast<ui16>(half);
+}
+
+f32 VertexQuantizer::fromHalf(ui16 value) {
+    const ui32 sign = (static_cast<ui32>(value) & 0x8000u) << 16;
+    const ui32 exponent = (value >> 10) & 0x1fu;
+    const ui32 mantissa = value & 0x3ffu;
+
+    if (0 == exponent) {
+        const f32 result = std::ldexp(static_cast<f32>(mantissa), -24);
+        return 0 != sign ? -result : result;
+    }
+
+    ui32 bits = 0;
+    if (31 == exponent) {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+    f32 result = 0.0f;
+    ::memcpy(&result, &bits, sizeof(result));
+
+    return result;
+}
+
+i16 VertexQuantizer::toSnorm16(f32 value) {
+    value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+
+    return static_cast<i16>(std::lround(value * Snorm16Max));
+}
+
+f32 VertexQuantizer::fromSnorm16(i16 value) {
+    const f32 result = static_cast<f32>(value) / Snorm16Max;
+
+    return result < -1.0f ? -1.0f : result;
+}
+
+uc8 VertexQuantizer::toUnorm8(f32 value) {
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+
+    return static_cast<uc8>(std::lround(value * 255.0f));
+}
+
+void VertexQuantizer::encodeNormal(const glm::vec3 &normal, i16 encoded[2]) {
+    // Project onto the octahedron, the lower half gets folded over the diagonals
+    const f32 sum = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    if (sum <= 0.0f) {
+        encoded[0] = encoded[1] = 0;
+        return;
+    }
+
+    f32 x = normal.x / sum, y = normal.y / sum;
+    if (normal.z < 0.0f) {
+        const f32 foldedX = (1.0f - std::fabs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        const f32 foldedY = (1.0f - std::fabs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = foldedX;
+        y = foldedY;
+    }
+    encoded[0] = toSnorm16(x);
+    encoded[1] = toSnorm16(y);
+}
+
+glm::vec3 VertexQuantizer::decodeNormal(const i16 encoded[2]) {
+    glm::vec3 normal(fromSnorm16(encoded[0]), fromSnorm16(encoded[1]), 0.0f);
+    normal.z = 1.0f - std::fabs(normal.x) - std::fabs(normal.y);
+    const f32 t = normal.z < 0.0f ? -normal.z : 0.0f;
+    normal.x += normal.x >= 0.0f ? -t : t;
+    normal.y += normal.y >= 0.0f ? -t : t;
+
+    return glm::normalize(normal);
+}
+
+void VertexQuantizer::getDequantization(const glm::vec3 &min, const glm::vec3 &max, glm::vec3 &scale, glm::vec3 &offset) {
+    offset = (min + max) * 0.5f;
+    const glm::vec3 halfExtent = (max - min) * 0.5f;
+    f32 extent = std::max(halfExtent.x, std::max(halfExtent.y, halfExtent.z));
+    if (extent <= 0.0f) {
+        extent = 1.0f;
+    }
+    scale = glm::vec3(extent);
+}
+
+void VertexQuantizer::encode(const RenderVert *vertices, size_t numVertices, const glm::vec3 &scale, const glm::vec3 &offset,
+        CompactVert *compact) {
+    if (nullptr == vertices || nullptr == compact) {
+        return;
+    }
+
+    const glm::vec3 invScale(1.0f / scale.x, 1.0f / scale.y, 1.0f / scale.z);
+    for (size_t i = 0; i < numVertices; ++i) {
+        const RenderVert &src = vertices[i];
+        CompactVert &dst = compact[i];
+        const glm::vec3 pos = (src.position - offset) * invScale;
+        dst.position[0] = toSnorm16(pos.x);
+        dst.position[1] = toSnorm16(pos.y);
+        dst.position[2] = toSnorm16(pos.z);
+        dst.position[3] = static_cast<i16>(Snorm16Max);
+        encodeNormal(src.normal, dst.normal);
+        dst.color0[0] = toUnorm8(src.color0.r);
+        dst.color0[1] = toUnorm8(src.color0.g);
+        dst.color0[2] = toUnorm8(src.color0.b);
+        dst.color0[3] = 255;
+        dst.tex0[0] = toHalf(src.tex0.x);
+        dst.tex0[1] = toHalf(src.tex0.y);
+    }
+}
+
+RenderVert VertexQuantizer::decode(const CompactVert &compact, const glm::vec3 &scale, const glm::vec3 &offset) {
+    RenderVert vertex;
+    const glm::vec3 pos(fromSnorm16(compact.position[0]), fromSnorm16(compact.position[1]), fromSnorm16(compact.position[2]));
+    vertex.position = offset + pos * scale;
+    vertex.normal = decodeNormal(compact.normal);
+    vertex.color0 = glm::vec3(compact.color0[0], compact.color0[1], compact.color0[2]) / 255.0f;
+    vertex.tex0 = glm::vec2(fromHalf(compact.tex0[0]), fromHalf(compact.tex0[1]));
+
+    return vertex;
+}
+
+bool VertexQuantizer::createVertexBuffer(Mesh *mesh, const RenderVert *vertices, size_t numVertices, BufferAccessType access) {
+    if (nullptr == mesh || nullptr == vertices || 0 == numVertices || VertexType::CompactVertex != mesh->getVertexType()) {
+        return false;
+    }
+
+    glm::vec3 min = vertices[0].position, max = vertices[0].position;
+    for (size_t i = 1; i < numVertices; ++i) {
+        min = glm::min(min, vertices[i].position);
+        max = glm::max(max, vertices[i].position);
+    }
+
+    glm::vec3 scale, offset;
+    getDequantization(min, max, scale, offset);
+    cppcore::TArray<CompactVert> compact;
+    compact.resize(numVertices);
+    encode(vertices, numVertices, scale, offset, &compact[0]);
+    mesh->setDequantization(scale, offset);
+    mesh->createVertexBuffer(&compact[0], sizeof(CompactVert) * numVertices, access);
+
+    return true;
+}
+
+} // namespace OSRE::RenderBackend
@@ -0,0 +1,114 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+#include "Common/glm_common.h"
+#include "RenderBackend/RenderCommon.h"
+
+namespace OSRE {
+namespace RenderBackend {
+
+// Forward declarations ---------------------------------------------------------------------------
+class Mesh;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Engine
+///
+///	@brief  This class implements the encoding of the compact vertex format.
+///
+/// Positions are quantized to snorm16 relative to the bounds of the mesh. The scale is the same
+/// for all axes, so the dequantization can be part of the model matrix without distorting the
+/// normals. Normals use the octahedral encoding, colors unorm8 and texture coordinates half floats.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT VertexQuantizer {
+public:
+    /// @brief Will convert a float into a half float, the value will be rounded to the nearest.
+    /// @param[in] value    The float value.
+    /// @return The half float bits.
+    static ui16 toHalf(f32 value);
+
+    /// @brief Will convert a half float into a float.
+    /// @param[in] value    The half float bits.
+    /// @return The float value.
+    static f32 fromHalf(ui16 value);
+
+    /// @brief Will convert a value in the range -1..1 into a snorm16.
+    /// @param[in] value    The value, will be clamped.
+    /// @return The snorm16 value.
+    static i16 toSnorm16(f32 value);
+
+    /// @brief Will convert a snorm16 into a float like the GPU does.
+    /// @param[in] value    The snorm16 value.
+    /// @return The value in the range -1..1.
+    static f32 fromSnorm16(i16 value);
+
+    /// @brief Will convert a value in the range 0..1 into an unorm8.
+    /// @param[in] value    The value, will be clamped.
+    /// @return The unorm8 value.
+    static uc8 toUnorm8(f32 value);
+
+    /// @brief Will encode a normal with the octahedral mapping.
+    /// @param[in]  normal  The normal, does not need to be normalized.
+    /// @param[out] encoded The encoded normal.
+    static void encodeNormal(const glm::vec3 &normal, i16 encoded[2]);
+
+    /// @brief Will decode an octahedral encoded normal.
+    /// @param[in] encoded  The encoded normal.
+    /// @return The normalized normal.
+    static glm::vec3 decodeNormal(const i16 encoded[2]);
+
+    /// @brief Will calculate the dequantization for the given bounds.
+    /// @param[in]  min     The minimum of the positions.
+    /// @param[in]  max     The maximum of the positions.
+    /// @param[out] scale   The dequantization scale, the same for all axes.
+    /// @param[out] offset  The dequantization offset.
+    static void getDequantization(const glm::vec3 &min, const glm::vec3 &max, glm::vec3 &scale, glm::vec3 &offset);
+
+    /// @brief Will encode render vertices into compact vertices.
+    /// @param[in]  vertices    The render vertices.
+    /// @param[in]  numVertices The number of vertices.
+    /// @param[in]  scale       The dequantization scale.
+    /// @param[in]  offset      The dequantization offset.
+    /// @param[out] compact     The compact vertices, must have space for numVertices.
+    static void encode(const RenderVert *vertices, size_t numVertices, const glm::vec3 &scale, const glm::vec3 &offset,
+            CompactVert *compact);
+
+    /// @brief Will decode a compact vertex.
+    /// @param[in] compact  The compact vertex.
+    /// @param[in] scale    The dequantization scale.
+    /// @param[in] offset   The dequantization offset.
+    /// @return The decoded render vertex.
+    static RenderVert decode(const CompactVert &compact, const glm::vec3 &scale, const glm::vec3 &offset);
+
+    /// @brief Will create the vertex buffer of a compact mesh from render vertices and set its dequantization.
+    /// @param[in] mesh         The mesh, must use the compact vertex type.
+    /// @param[in] vertices     The render vertices.
+    /// @param[in] numVertices  The number of vertices.
+    /// @param[in] access       The buffer access type.
+    /// @return true, if successful, false if the mesh does not use compact vertices.
+    static bool createVertexBuffer(Mesh *mesh, const RenderVert *vertices, size_t numVertices, BufferAccessType access);
+};
+
+} // Namespace RenderBackend
+} // Namespace OSRE
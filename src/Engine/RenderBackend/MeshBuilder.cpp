@@ -25,6 +25,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "RenderBackend/MaterialBuilder.h"
 #include "RenderBackend/FontService.h"
 #include "RenderBackend/Mesh.h"
+#include "RenderBackend/Mesh/VertexQuantizer.h"
 #include "Common/Logger.h"
 #include "Common/Tokenizer.h"
 #include "Debugging/osre_debugging.h"
@@ -425,6 +426,24 @@ void MeshBuilder::allocVertices(Mesh *mesh, VertexType type, size_t numVerts, gl
             delete[] renderVerts;
         } break;
 
+        case VertexType::CompactVertex: {
+            // The vertices are built as render vertices first and get quantized into the bounds of the mesh
+            cppcore::TArray<RenderVert> renderVerts;
+            renderVerts.resize(numVerts);
+            for (ui32 i = 0; i < numVerts; i++) {
+                if (nullptr != pos) {
+                    renderVerts[i].position = pos[i];
+                }
+                if (nullptr != col1) {
+                    renderVerts[i].color0 = col1[i];
+                }
+                if (nullptr != tex0) {
+                    renderVerts[i].tex0 = tex0[i];
+                }
+            }
+            VertexQuantizer::createVertexBuffer(mesh, &renderVerts[0], numVerts, access);
+        } break;
+
         default:
             break;
     }
@@ -20,18 +20,152 @@ COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
 IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
+#include "Common/Logger.h"
 #include "Debugging/osre_debugging.h"
 #include "RenderBackend/Mesh.h"
 #include "RenderBackend/RenderCommon.h"
 #include "RenderBackend/MeshProcessor.h"
 
+#include <algorithm>
+#include <cstdio>
+
 namespace OSRE {
 namespace RenderBackend {
 
 using namespace ::OSRE::Common;
+using namespace ::cppcore;
+
+DECL_OSRE_LOG_MODULE(MeshProcessor)
 
 static const i32 NeedsUpdate = 1;
 
+// A range of triangles in the index buffer
+struct TriangleRange {
+    size_t mStartIndex;
+    size_t mNumIndices;
+};
+
+static size_t getIndexSize(IndexType indexType) {
+    switch (indexType) {
+        case IndexType::UnsignedByte:
+            return sizeof(uc8);
+        case IndexType::UnsignedShort:
+            return sizeof(ui16);
+        case IndexType::UnsignedInt:
+            return sizeof(ui32);
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+static bool readIndices(Mesh *mesh, TArray<ui32> &indices) {
+    BufferData *indexBuffer = mesh->getIndexBuffer();
+    const size_t indexSize = getIndexSize(mesh->getIndexType());
+    if (nullptr == indexBuffer || 0 == indexSize || indexBuffer->getSize() < indexSize) {
+        return false;
+    }
+
+    const size_t numIndices = indexBuffer->getSize() / indexSize;
+    const c8 *data = indexBuffer->getData();
+    indices.resize(numIndices);
+    for (size_t i = 0; i < numIndices; ++i) {
+        if (sizeof(uc8) == indexSize) {
+            indices[i] = reinterpret_cast<const uc8 *>(data)[i];
+        } else if (sizeof(ui16) == indexSize) {
+            indices[i] = reinterpret_cast<const ui16 *>(data)[i];
+        } else {
+            indices[i] = reinterpret_cast<const ui32 *>(data)[i];
+        }
+    }
+
+    return true;
+}
+
+static void writeIndices(Mesh *mesh, const TArray<ui32> &indices) {
+    c8 *data = mesh->getIndexBuffer()->getData();
+    const size_t indexSize = getIndexSize(mesh->getIndexType());
+    for (size_t i = 0; i < indices.size(); ++i) {
+        if (sizeof(uc8) == indexSize) {
+            reinterpret_cast<uc8 *>(data)[i] = static_cast<uc8>(indices[i]);
+        } else if (sizeof(ui16) == indexSize) {
+            reinterpret_cast<ui16 *>(data)[i] = static_cast<ui16>(indices[i]);
+        } else {
+            reinterpret_cast<ui32 *>(data)[i] = indices[i];
+        }
+    }
+}
+
+// The levels of detail or the triangle list groups, each one will be optimized on its own
+static void getTriangleRanges(const Mesh *mesh, size_t numIndices, TArray<TriangleRange> &ranges) {
+    if (mesh->getNumLods() > 0) {
+        for (size_t i = 0; i < mesh->getNumLods(); ++i) {
+            const MeshLod &lod = mesh->getLodAt(i);
+            ranges.add({ lod.mStartIndex, lod.mNumIndices });
+        }
+    } else {
+        for (size_t i = 0; i < mesh->getNumberOfPrimitiveGroups(); ++i) {
+            const PrimitiveGroup *group = mesh->getPrimitiveGroupAt(i);
+            if (nullptr != group && PrimitiveType::TriangleList == group->m_primitive) {
+                ranges.add({ group->m_startIndex, group->m_numIndices });
+            }
+        }
+    }
+
+    // Drop invalid ranges and ranges used by several groups
+    for (size_t i = ranges.size(); i > 0; --i) {
+        const TriangleRange &range = ranges[i - 1];
+        bool valid = range.mNumIndices >= 3 && range.mStartIndex + range.mNumIndices <= numIndices;
+        for (size_t j = 0; j + 1 < i && valid; ++j) {
+            valid = ranges[j].mStartIndex != range.mStartIndex || ranges[j].mNumIndices != range.mNumIndices;
+        }
+        if (!valid) {
+            ranges.remove(i - 1);
+        }
+    }
+}
+
+static size_t getNumVertices(const Mesh *mesh, const TArray<ui32> &indices) {
+    const size_t stride = Mesh::getVertexSize(mesh->getVertexType());
+    BufferData *vertexBuffer = mesh->getVertexBuffer();
+    if (0 != stride && nullptr != vertexBuffer) {
+        return vertexBuffer->getSize() / stride;
+    }
+
+    // Unknown vertex layout, the indices tell the minimal vertex count
+    size_t numVertices = 0;
+    for (size_t i = 0; i < indices.size(); ++i) {
+        numVertices = std::max(numVertices, static_cast<size_t>(indices[i]) + 1);
+    }
+
+    return numVertices;
+}
+
+static VertexCacheStatistics analyzeRanges(const TArray<ui32> &indices, const TArray<TriangleRange> &ranges, size_t numVertices) {
+    VertexCacheStatistics stats = { 0, 0, 0, 0.0f, 0.0f };
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        const VertexCacheStatistics rangeStats = MeshOptimizer::analyzeVertexCache(&indices[ranges[i].mStartIndex],
+                ranges[i].mNumIndices, numVertices);
+        stats.mNumTransforms += rangeStats.mNumTransforms;
+        stats.mNumTriangles += rangeStats.mNumTriangles;
+        stats.mNumVertices += rangeStats.mNumVertices;
+    }
+    if (0 != stats.mNumTriangles) {
+        stats.mAcmr = static_cast<f32>(stats.mNumTransforms) / static_cast<f32>(stats.mNumTriangles);
+        stats.mAtvr = static_cast<f32>(stats.mNumTransforms) / static_cast<f32>(stats.mNumVertices);
+    }
+
+    return stats;
+}
+
+static void logReport(const c8 *operation, const Mesh *mesh, const MeshOptimizationReport &report) {
+    c8 buffer[256];
+    ::snprintf(buffer, sizeof(buffer), "%s of %s: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f", operation, mesh->getName().c_str(),
+            report.mBefore.mAcmr, report.mAfter.mAcmr, report.mBefore.mAtvr, report.mAfter.mAtvr);
+    osre_debug(Tag, buffer);
+}
+
 MeshProcessor::MeshProcessor() :
         AbstractProcessor(),
         mDirty(0) {
@@ -73,34 +207,160 @@ void MeshProcessor::handleMesh(Mesh *mesh) {
         return;
     }
 
-    ui32 stride(0);
-    switch (mesh->getVertexType()) {
-        case VertexType::RenderVertex:
-            stride = sizeof(RenderVert);
-            break;
+    // The mesh caches its local bounds, so only the transformation needs to get applied
+    const AABB &localAabb = mesh->getAABB();
+    if (mesh->isLocal()) {
+        mAabb.merge(localAabb.transform(mesh->getLocalMatrix()));
+    } else {
+        mAabb.merge(localAabb);
+    }
+}
 
-        case VertexType::ColorVertex:
-            stride = sizeof(ColorVert);
-            break;
+bool MeshProcessor::optimizeVertexCache(Mesh *mesh, MeshOptimizationReport *report) {
+    TArray<ui32> indices;
+    if (nullptr == mesh || !readIndices(mesh, indices)) {
+        return false;
+    }
 
-        default:
-            break;
+    TArray<TriangleRange> ranges;
+    getTriangleRanges(mesh, indices.size(), ranges);
+    const size_t numVertices = getNumVertices(mesh, indices);
+    if (ranges.isEmpty() || 0 == numVertices) {
+        return false;
     }
 
-    BufferData *data = mesh->getVertexBuffer();
-    if (nullptr == data || 0L == data->getSize()) {
-        return;
+    MeshOptimizationReport result;
+    result.mBefore = analyzeRanges(indices, ranges, numVertices);
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        MeshOptimizer::optimizeVertexCache(&indices[ranges[i].mStartIndex], ranges[i].mNumIndices, numVertices);
+    }
+    result.mAfter = analyzeRanges(indices, ranges, numVertices);
+    writeIndices(mesh, indices);
+
+    logReport("Vertex cache optimization", mesh, result);
+    if (nullptr != report) {
+        *report = result;
+    }
+
+    return true;
+}
+
+bool MeshProcessor::optimizeOverdraw(Mesh *mesh, f32 threshold, MeshOptimizationReport *report) {
+    TArray<ui32> indices;
+    if (nullptr == mesh || nullptr == mesh->getVertexBuffer() || !readIndices(mesh, indices)) {
+        return false;
+    }
+
+    // The cluster sorting reads float positions
+    const size_t stride = Mesh::getVertexSize(mesh->getVertexType());
+    if (0 == stride || VertexType::CompactVertex == mesh->getVertexType()) {
+        osre_debug(Tag, "Overdraw optimization requires uncompressed vertices.");
+        return false;
     }
 
-    ui32 offset = 0;
-    const ui32 numVertices = (ui32)data->getSize() / stride;
-    for (ui32 i = 0; i < numVertices; i++) {
-        glm::vec3 pos = {};
-        uc8 *ptr = (uc8*) data->getData();
-        ::memcpy(&pos.x, &ptr[offset], sizeof(glm::vec3));
-        offset += stride;
-        mAabb.merge(pos.x, pos.y, pos.z);
+    TArray<TriangleRange> ranges;
+    getTriangleRanges(mesh, indices.size(), ranges);
+    const size_t numVertices = getNumVertices(mesh, indices);
+    if (ranges.isEmpty() || 0 == numVertices) {
+        return false;
     }
+
+    MeshOptimizationReport result;
+    result.mBefore = analyzeRanges(indices, ranges, numVertices);
+    const c8 *vertexData = mesh->getVertexBuffer()->getData();
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        MeshOptimizer::optimizeOverdraw(&indices[ranges[i].mStartIndex], ranges[i].mNumIndices, vertexData,
+                numVertices, stride, threshold);
+    }
+    result.mAfter = analyzeRanges(indices, ranges, numVertices);
+    writeIndices(mesh, indices);
+
+    logReport("Overdraw optimization", mesh, result);
+    if (nullptr != report) {
+        *report = result;
+    }
+
+    return true;
+}
+
+bool MeshProcessor::optimizeVertexFetch(Mesh *mesh, MeshOptimizationReport *report) {
+    TArray<ui32> indices;
+    if (nullptr == mesh || nullptr == mesh->getVertexBuffer() || !readIndices(mesh, indices)) {
+        return false;
+    }
+
+    // Other meshes would still use the old vertex order
+    if (mesh->hasSharedIndexBuffer() || mesh->hasSharedVertexBuffer()) {
+        osre_debug(Tag, "Cannot reorder the vertices of " + mesh->getName() + ", the buffers are shared.");
+        return false;
+    }
+
+    const size_t stride = Mesh::getVertexSize(mesh->getVertexType());
+    const size_t numVertices = getNumVertices(mesh, indices);
+    if (0 == stride || 0 == numVertices) {
+        return false;
+    }
+
+    TArray<TriangleRange> ranges;
+    getTriangleRanges(mesh, indices.size(), ranges);
+
+    MeshOptimizationReport result;
+    result.mBefore = analyzeRanges(indices, ranges, numVertices);
+    if (0 == MeshOptimizer::optimizeVertexFetch(mesh->getVertexBuffer()->getData(), numVertices, stride, &indices[0], indices.size())) {
+        return false;
+    }
+    result.mAfter = analyzeRanges(indices, ranges, numVertices);
+    writeIndices(mesh, indices);
+
+    logReport("Vertex fetch optimization", mesh, result);
+    if (nullptr != report) {
+        *report = result;
+    }
+
+    return true;
+}
+
+bool MeshProcessor::buildMeshlets(Mesh *mesh, MeshletArray &meshlets, ui32 maxVertices, ui32 maxTriangles) {
+    meshlets.resize(0);
+    TArray<ui32> indices;
+    if (nullptr == mesh || nullptr == mesh->getVertexBuffer() || !readIndices(mesh, indices)) {
+        return false;
+    }
+
+    // The bounds need the positions
+    if (0 == Mesh::getVertexSize(mesh->getVertexType())) {
+        osre_debug(Tag, "Cannot build meshlets for " + mesh->getName() + ", unknown vertex type.");
+        return false;
+    }
+
+    TArray<TriangleRange> ranges;
+    getTriangleRanges(mesh, indices.size(), ranges);
+    const size_t numVertices = getNumVertices(mesh, indices);
+    if (ranges.isEmpty() || 0 == numVertices) {
+        return false;
+    }
+
+    TArray<glm::vec3> positions;
+    positions.resize(numVertices);
+    for (size_t i = 0; i < numVertices; ++i) {
+        positions[i] = mesh->getPosition(i);
+    }
+
+    for (size_t i = 0; i < ranges.size(); ++i) {
+        MeshletBuilder::build(&indices[ranges[i].mStartIndex], ranges[i].mNumIndices, &positions[0], numVertices,
+                static_cast<ui32>(ranges[i].mStartIndex), meshlets, maxVertices, maxTriangles);
+    }
+    if (meshlets.isEmpty()) {
+        return false;
+    }
+    writeIndices(mesh, indices);
+    mesh->setMeshlets(meshlets);
+
+    c8 buffer[256];
+    ::snprintf(buffer, sizeof(buffer), "Built %u meshlets for %s.", static_cast<ui32>(meshlets.size()), mesh->getName().c_str());
+    osre_debug(Tag, buffer);
+
+    return true;
 }
 
 } // namespace RenderBackend
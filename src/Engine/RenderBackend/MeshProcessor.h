@@ -24,6 +24,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "Common/AbstractProcessor.h"
 #include "RenderBackend/RenderCommon.h"
+#include "RenderBackend/Mesh/MeshOptimizer.h"
+#include "RenderBackend/Mesh/MeshletBuilder.h"
 #include "Common/TAABB.h"
 #include "App/TransformComponent.h"
 
@@ -32,10 +34,20 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 namespace OSRE {
 namespace RenderBackend {
         
+/// @brief The vertex cache efficiency of a mesh before and after an optimization.
+struct MeshOptimizationReport {
+    VertexCacheStatistics mBefore;  ///< The statistics of the source mesh.
+    VertexCacheStatistics mAfter;   ///< The statistics of the optimized mesh.
+};
+
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
 ///
-///	@brief
+///	@brief  This class calculates the bounds of meshes and provides the mesh optimizations.
+///
+/// The optimizations work on the triangle list groups or, if the mesh has one, on each level
+/// of detail. Run them before the mesh gets rendered for the first time, the buffers will not
+/// be uploaded again.
 //-------------------------------------------------------------------------------------------------
 class OSRE_EXPORT MeshProcessor : public Common::AbstractProcessor {
 public:
@@ -45,6 +57,38 @@ public:
     void addMesh( RenderBackend::Mesh *geo );
     const Common::AABB &getAABB() const;
 
+    /// @brief Will reorder the triangles of the mesh for the post transform vertex cache.
+    /// @param[in]  mesh    The mesh to optimize.
+    /// @param[out] report  The cache statistics before and after, may be nullptr.
+    /// @return true, if successful, false if the mesh has no triangles.
+    static bool optimizeVertexCache(Mesh *mesh, MeshOptimizationReport *report = nullptr);
+
+    /// @brief Will reorder the triangle clusters of the mesh to reduce overdraw, run it after the cache optimization.
+    /// @param[in]  mesh        The mesh to optimize.
+    /// @param[in]  threshold   The accepted cache miss ratio relative to the source.
+    /// @param[out] report      The cache statistics before and after, may be nullptr.
+    /// @return true, if successful, false if the mesh has no triangles or an unknown vertex type.
+    static bool optimizeOverdraw(Mesh *mesh, f32 threshold = MeshOptimizer::DefaultOverdrawThreshold,
+            MeshOptimizationReport *report = nullptr);
+
+    /// @brief Will reorder the vertices of the mesh in the order of their first use, run it as the last step.
+    /// @param[in]  mesh    The mesh to optimize.
+    /// @param[out] report  The cache statistics before and after, may be nullptr.
+    /// @return true, if successful, false for meshes with shared buffers or an unknown vertex type.
+    static bool optimizeVertexFetch(Mesh *mesh, MeshOptimizationReport *report = nullptr);
+
+    /// @brief Will split the triangles of the mesh into meshlets for the cluster culling.
+    /// Each meshlet lies in one level of detail or triangle list group. Run it after the
+    /// vertex cache optimization. The meshlets will be stored in the mesh, the scene culls them
+    /// before each frame.
+    /// @param[in]  mesh            The mesh to split.
+    /// @param[out] meshlets        The meshlets, will be replaced.
+    /// @param[in]  maxVertices     The maximum number of vertices per meshlet.
+    /// @param[in]  maxTriangles    The maximum number of triangles per meshlet.
+    /// @return true, if successful, false if the mesh has no triangles or an unknown vertex type.
+    static bool buildMeshlets(Mesh *mesh, MeshletArray &meshlets, ui32 maxVertices = MeshletBuilder::MaxVertices,
+            ui32 maxTriangles = MeshletBuilder::MaxTriangles);
+
 private:
     void handleMesh( RenderBackend::Mesh *mesh );
 
@@ -78,9 +78,12 @@ struct OGLVertexAttribute {
     size_t m_size;              ///< The size for one attribute.
     GLenum m_type;              ///< The attribute type.
     const GLvoid *m_ptr;        ///< The data pointer for the attribute.
+    bool m_normalized;          ///< true, if integer data will be mapped to 0..1 or -1..1.
+    bool m_integer;             ///< true, if the shader will get the data as integers.
 
     /// @brief The default class constructor.
-    OGLVertexAttribute() : m_index(999999), m_pAttributeName(nullptr), m_size(0U), m_type(), m_ptr(nullptr) {}
+    OGLVertexAttribute() :
+            m_index(999999), m_pAttributeName(nullptr), m_size(0U), m_type(), m_ptr(nullptr), m_normalized(false), m_integer(false) {}
 
     /// @brief  The class destructor, default implementation.
     ~OGLVertexAttribute() = default;
@@ -200,13 +203,16 @@ struct SetRenderTargetCmdData {
 
 ///	@brief This struct declares the data for a render call with instanced render data.
 struct DrawInstancePrimitivesCmdData {
+    bool m_localMatrix;                     ///< true for a mesh matrix.
+    glm::mat4 m_model;                      ///< The mesh matrix, applied before the model matrix.
     OGLVertexArray *m_vertexArray;          ///< The vertex array to use.
     size_t m_numInstances;                  ///< The number of instances to render.
     cppcore::TArray<size_t> m_primitives;   ///< The primitives to render.
     const char *m_id;                       ///< The call id.
 
     /// @brief The default class constructor.
-    DrawInstancePrimitivesCmdData() : m_vertexArray(nullptr), m_numInstances(0), m_primitives(), m_id(nullptr) {}
+    DrawInstancePrimitivesCmdData() :
+            m_localMatrix(false), m_model(1.0f), m_vertexArray(nullptr), m_numInstances(0), m_primitives(), m_id(nullptr) {}
 
     /// @brief  The class destructor, default implementation.
     ~DrawInstancePrimitivesCmdData() = default;
@@ -105,6 +105,8 @@ GLenum OGLEnum::getGLTextureTarget( TextureTargetType type ) {
             return GL_TEXTURE_2D;
         case TextureTargetType::Texture3D:
             return GL_TEXTURE_3D;
+        case TextureTargetType::Texture2DArray:
+            return GL_TEXTURE_2D_ARRAY;
         default:
             osre_assert2( false, "Unknown enum for TextureTargetType." );
             break;
@@ -177,7 +179,17 @@ GLenum OGLEnum::getOGLTypeForFormat( VertexFormat format ) {
             return GL_UNSIGNED_BYTE;
         case VertexFormat::Short2:
         case VertexFormat::Short4:
+        case VertexFormat::Short2Norm:
+        case VertexFormat::Short4Norm:
             return GL_SHORT;
+        case VertexFormat::Half2:
+        case VertexFormat::Half4:
+            return GL_HALF_FLOAT;
+        case VertexFormat::UByte4Norm:
+        case VertexFormat::UByte4Int:
+            return GL_UNSIGNED_BYTE;
+        case VertexFormat::Int:
+            return GL_INT;
         case VertexFormat::Count:
         case VertexFormat::Invalid:
         default:
@@ -191,9 +203,12 @@ GLenum OGLEnum::getOGLTypeForFormat( VertexFormat format ) {
 ui32 OGLEnum::getOGLSizeForFormat( VertexFormat format ) {
     switch ( format ) {
         case VertexFormat::Float:
+        case VertexFormat::Int:
             return 1;
         case VertexFormat::Float2:
         case VertexFormat::Short2:
+        case VertexFormat::Half2:
+        case VertexFormat::Short2Norm:
             return 2;
         case VertexFormat::Float3:
             return 3;
@@ -201,6 +216,10 @@ ui32 OGLEnum::getOGLSizeForFormat( VertexFormat format ) {
         case VertexFormat::UByte4:
         case VertexFormat::Float4:
         case VertexFormat::Short4:
+        case VertexFormat::Half4:
+        case VertexFormat::UByte4Norm:
+        case VertexFormat::Short4Norm:
+        case VertexFormat::UByte4Int:
             return 4;
         case VertexFormat::Count:
         case VertexFormat::Invalid:
@@ -213,6 +232,14 @@ ui32 OGLEnum::getOGLSizeForFormat( VertexFormat format ) {
     return 0;
 }
 
+bool OGLEnum::isNormalizedFormat( VertexFormat format ) {
+    return format == VertexFormat::UByte4Norm || format == VertexFormat::Short2Norm || format == VertexFormat::Short4Norm;
+}
+
+bool OGLEnum::isIntegerFormat( VertexFormat format ) {
+    return format == VertexFormat::UByte4Int || format == VertexFormat::Int;
+}
+
 GLenum OGLEnum::getOGLCullState( CullState::CullMode cullMode ) {
     switch ( cullMode ) {
         case CullState::CullMode::CW:
@@ -55,6 +55,10 @@ public:
     static GLenum getOGLTypeForFormat( VertexFormat format );
     /// @brief  Translates the vertex format type to the corresponding size.
     static ui32 getOGLSizeForFormat( VertexFormat format );
+    /// @brief  Will return true, if the vertex format will be normalized by the GPU.
+    static bool isNormalizedFormat( VertexFormat format );
+    /// @brief  Will return true, if the vertex format will be passed as integers to the shader.
+    static bool isIntegerFormat( VertexFormat format );
     /// @brief  Translates the cull state to the corresponding GLenum type.
     static GLenum getOGLCullState( CullState::CullMode cullMode );
     /// @brief  Translates the cull-face mode to the corresponding GLenum value.
@@ -32,12 +32,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Profiling/PerformanceCounterRegistry.h"
 #include "RenderBackend/RenderStates.h"
 #include "RenderBackend/Shader.h"
+#include "RenderBackend/Shader/DefaultShader.h"
 
 #include <cppcore/CPPCoreCommon.h>
 #include <cppcore/Memory/MemUtils.h>
 
 #include "stb_image.h"
 
+#include <algorithm>
 #include <iostream>
 
 namespace OSRE::RenderBackend {
@@ -56,6 +58,7 @@ OGLRenderBackend::OGLRenderBackend() :
         mActiveIB(NotInitedHandle),
         mActiveVertexArray(OGLNotSetId),
         mShaderInUse(nullptr),
+        mDepthReadback(),
         mFpState(nullptr),
         mFpsCounter(nullptr) {
     mBindedTextures.resize(static_cast<size_t>(TextureStageType::Count));
@@ -206,6 +209,8 @@ bool OGLRenderBackend::destroy() {
 
     releaseAllShaders();
     releaseAllTextures();
+    releaseAllParticleStates();
+    releaseDepthReadback();
     releaseAllVertexArrays();
     releaseAllBuffers();
     releaseAllParameters();
@@ -255,6 +260,190 @@ void OGLRenderBackend::setViewport(i32 x, i32 y, i32 w, i32 h) {
     glViewport(x, y, w, h);
 }
 
+// The occlusion test only needs a coarse depth, a full resolution read back would cost more than it saves
+static constexpr ui32 MaxDepthReadbackWidth = 256;
+
+bool OGLRenderBackend::beginDepthReadback(i32 x, i32 y, i32 w, i32 h, const glm::mat4 &viewProjection) {
+    if (w <= 0 || h <= 0) {
+        return false;
+    }
+
+    OGLShader *shader = getDepthReduceShader();
+    if (nullptr == shader) {
+        return false;
+    }
+
+    unmapDepthReadback();
+
+    const ui32 srcWidth = static_cast<ui32>(w), srcHeight = static_cast<ui32>(h);
+    const ui32 width = std::min(srcWidth, MaxDepthReadbackWidth);
+    const ui32 height = std::max(1u, srcHeight * width / srcWidth);
+    OGLDepthReadback &rb = mDepthReadback;
+    if (0 == rb.mFrameBuffer) {
+        glGenFramebuffers(1, &rb.mFrameBuffer);
+        glGenTextures(1, &rb.mDepthTexture);
+        glGenTextures(1, &rb.mTarget);
+        glGenVertexArrays(1, &rb.mVertexArray);
+        glGenBuffers(2, rb.mPixelBuffers);
+    }
+
+    GLint prevFrameBuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &prevFrameBuffer);
+    GLint prevViewport[4] = {};
+    glGetIntegerv(GL_VIEWPORT, prevViewport);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, rb.mDepthTexture);
+    if (rb.mSourceWidth != srcWidth || rb.mSourceHeight != srcHeight) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, w, h, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+        glBindTexture(GL_TEXTURE_2D, rb.mTarget);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R32F, width, height, 0, GL_RED, GL_FLOAT, nullptr);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glBindFramebuffer(GL_FRAMEBUFFER, rb.mFrameBuffer);
+        glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, rb.mTarget, 0);
+        const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+        glBindFramebuffer(GL_FRAMEBUFFER, prevFrameBuffer);
+        if (status != GL_FRAMEBUFFER_COMPLETE) {
+            osre_error(Tag, "Depth read back target is incomplete.");
+            glBindTexture(GL_TEXTURE_2D, 0);
+            releaseDepthReadback();
+            return false;
+        }
+
+        for (GLuint pixelBuffer : rb.mPixelBuffers) {
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, pixelBuffer);
+            glBufferData(GL_PIXEL_PACK_BUFFER, width * height * sizeof(f32), nullptr, GL_STREAM_READ);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        for (GLsync &fence : rb.mFences) {
+            if (nullptr != fence) {
+                glDeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+        rb.mSourceWidth = srcWidth;
+        rb.mSourceHeight = srcHeight;
+        glBindTexture(GL_TEXTURE_2D, rb.mDepthTexture);
+    }
+
+    // Copy the depth of the active frame buffer, it can not be sampled while it is attached
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, x, y, w, h);
+
+    // Reduce it to the read back size, every texel keeps the farthest depth of its source texels
+    const GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+    const GLboolean blend = glIsEnabled(GL_BLEND);
+    const GLboolean cullFace = glIsEnabled(GL_CULL_FACE);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+    glDisable(GL_CULL_FACE);
+    glBindFramebuffer(GL_FRAMEBUFFER, rb.mFrameBuffer);
+    glViewport(0, 0, width, height);
+    useShader(shader);
+    glUniform1i(shader->getUniformLocation("DepthMap"), 0);
+    glUniform2i(shader->getUniformLocation("SourceSize"), w, h);
+    glUniform2i(shader->getUniformLocation("TargetSize"), width, height);
+    glBindVertexArray(rb.mVertexArray);
+    glDrawArrays(GL_TRIANGLES, 0, 3);
+    unbindVertexArray();
+
+    // Start the copy into the pixel buffer of this frame, the fence tells when it has arrived
+    const ui32 slot = rb.mFrame % 2;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, rb.mPixelBuffers[slot]);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RED, GL_FLOAT, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (nullptr != rb.mFences[slot]) {
+        glDeleteSync(rb.mFences[slot]);
+    }
+    rb.mFences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    rb.mWidth[slot] = width;
+    rb.mHeight[slot] = height;
+    rb.mViewProjection[slot] = viewProjection;
+    ++rb.mFrame;
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    mBindedTextures[0] = nullptr;
+    glBindFramebuffer(GL_FRAMEBUFFER, prevFrameBuffer);
+    glViewport(prevViewport[0], prevViewport[1], prevViewport[2], prevViewport[3]);
+    if (depthTest) {
+        glEnable(GL_DEPTH_TEST);
+    }
+    if (blend) {
+        glEnable(GL_BLEND);
+    }
+    if (cullFace) {
+        glEnable(GL_CULL_FACE);
+    }
+    CHECKOGLERRORSTATE();
+
+    return true;
+}
+
+const f32 *OGLRenderBackend::mapDepthReadback(ui32 &width, ui32 &height, glm::mat4 &viewProjection) {
+    OGLDepthReadback &rb = mDepthReadback;
+    const ui32 slot = (rb.mFrame + 1) % 2;
+    if (0 != rb.mMapped || nullptr == rb.mFences[slot]) {
+        return nullptr;
+    }
+
+    // Never stall, when the copy has not arrived yet the last result stays in use
+    const GLenum state = glClientWaitSync(rb.mFences[slot], 0, 0);
+    if (state != GL_ALREADY_SIGNALED && state != GL_CONDITION_SATISFIED) {
+        return nullptr;
+    }
+    glDeleteSync(rb.mFences[slot]);
+    rb.mFences[slot] = nullptr;
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, rb.mPixelBuffers[slot]);
+    const void *data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, rb.mWidth[slot] * rb.mHeight[slot] * sizeof(f32), GL_MAP_READ_BIT);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    if (nullptr == data) {
+        return nullptr;
+    }
+
+    rb.mMapped = rb.mPixelBuffers[slot];
+    width = rb.mWidth[slot];
+    height = rb.mHeight[slot];
+    viewProjection = rb.mViewProjection[slot];
+
+    return static_cast<const f32 *>(data);
+}
+
+void OGLRenderBackend::unmapDepthReadback() {
+    if (0 == mDepthReadback.mMapped) {
+        return;
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, mDepthReadback.mMapped);
+    glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    mDepthReadback.mMapped = 0;
+}
+
+void OGLRenderBackend::releaseDepthReadback() {
+    OGLDepthReadback &rb = mDepthReadback;
+    if (0 == rb.mFrameBuffer) {
+        return;
+    }
+
+    unmapDepthReadback();
+    for (GLsync fence : rb.mFences) {
+        if (nullptr != fence) {
+            glDeleteSync(fence);
+        }
+    }
+    glDeleteBuffers(2, rb.mPixelBuffers);
+    glDeleteVertexArrays(1, &rb.mVertexArray);
+    glDeleteTextures(1, &rb.mTarget);
+    glDeleteTextures(1, &rb.mDepthTexture);
+    glDeleteFramebuffers(1, &rb.mFrameBuffer);
+    rb = OGLDepthReadback();
+}
+
 OGLBuffer *OGLRenderBackend::createBuffer(BufferType type) {
     size_t handle(OGLNotSetId);
     GLuint bufferId(OGLNotSetId);
@@ -288,6 +477,16 @@ OGLBuffer *OGLRenderBackend::getBufferById(guid geoId) {
     return buffer;
 }
 
+OGLBuffer *OGLRenderBackend::getBufferById(guid geoId, BufferType type) {
+    for (ui32 i = 0; i < mBuffers.size(); i++) {
+        if (mBuffers[i]->m_geoId == geoId && mBuffers[i]->m_type == type) {
+            return mBuffers[i];
+        }
+    }
+
+    return nullptr;
+}
+
 void OGLRenderBackend::bindBuffer(OGLBuffer *buffer) {
     if (nullptr == buffer) {
         osre_debug(Tag, "Pointer to buffer is nullptr");
@@ -332,6 +531,17 @@ void OGLRenderBackend::copyDataToBuffer(OGLBuffer *buffer, void *data, size_t si
     CHECKOGLERRORSTATE();
 }
 
+void OGLRenderBackend::copyDataToBufferRange(OGLBuffer *buffer, size_t offset, const void *data, size_t size) {
+    if (nullptr == buffer) {
+        osre_debug(Tag, "Pointer to buffer is nullptr");
+        return;
+    }
+    const GLenum target = OGLEnum::getGLBufferType(buffer->m_type);
+    glBufferSubData(target, offset, size, data);
+
+    CHECKOGLERRORSTATE();
+}
+
 void OGLRenderBackend::releaseBuffer(OGLBuffer *buffer) {
     if (nullptr == buffer) {
         osre_debug(Tag, "Pointer to buffer instance is nullptr, skipped.");
@@ -362,6 +572,24 @@ void OGLRenderBackend::releaseAllBuffers() {
     }
     mBuffers.clear();
     mFreeBufferSlots.clear();
+    mSharedBuffers.clear();
+}
+
+OGLBuffer *OGLRenderBackend::getSharedBuffer(const BufferData *data) const {
+    auto it = mSharedBuffers.find(data);
+    if (it == mSharedBuffers.end()) {
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+void OGLRenderBackend::addSharedBuffer(const BufferData *data, OGLBuffer *buffer) {
+    if (nullptr == data || nullptr == buffer) {
+        return;
+    }
+
+    mSharedBuffers[data] = buffer;
 }
 
 bool OGLRenderBackend::createVertexCompArray(const VertexLayout *layout, OGLShader *shader, VertAttribArray &attributes) {
@@ -375,7 +603,6 @@ bool OGLRenderBackend::createVertexCompArray(const VertexLayout *layout, OGLShad
         return false;
     }
 
-    size_t index(0);
     OGLVertexAttribute *attribute(nullptr);
     for (ui32 i = 0; i < layout->numComponents(); i++) {
         VertComponent &comp(layout->getAt(i));
@@ -384,9 +611,10 @@ bool OGLRenderBackend::createVertexCompArray(const VertexLayout *layout, OGLShad
         attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
         attribute->m_size = OGLEnum::getOGLSizeForFormat(comp.m_format);
         attribute->m_type = OGLEnum::getOGLTypeForFormat(comp.m_format);
-        attribute->m_ptr = (GLvoid *)index;
+        attribute->m_normalized = OGLEnum::isNormalizedFormat(comp.m_format);
+        attribute->m_integer = OGLEnum::isIntegerFormat(comp.m_format);
+        attribute->m_ptr = (GLvoid *)layout->m_offsets[i];
         attributes.add(attribute);
-        index += attribute->m_size;
     }
 
     return true;
@@ -460,6 +688,95 @@ bool OGLRenderBackend::createVertexCompArray(VertexType type, OGLShader *shader,
             attributes.add(attribute);
             break;
 
+        case VertexType::SkinnedVertex:
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::Position).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 3;
+            attribute->m_type = GL_FLOAT;
+            attribute->m_ptr = 0;
+            attributes.add(attribute);
+
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::Normal).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 3;
+            attribute->m_type = GL_FLOAT;
+            attribute->m_ptr = (const GLvoid *)offsetof(SkinnedVert, normal);
+            attributes.add(attribute);
+
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::Color0).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 3;
+            attribute->m_type = GL_FLOAT;
+            attribute->m_ptr = (const GLvoid *)offsetof(SkinnedVert, color0);
+            attributes.add(attribute);
+
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::TexCoord0).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 2;
+            attribute->m_type = GL_FLOAT;
+            attribute->m_ptr = (const GLvoid *)offsetof(SkinnedVert, tex0);
+            attributes.add(attribute);
+
+            // The joint indices are passed as unnormalized bytes, the shader will see them as float values
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::Indices).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 4;
+            attribute->m_type = GL_UNSIGNED_BYTE;
+            attribute->m_ptr = (const GLvoid *)offsetof(SkinnedVert, indices);
+            attributes.add(attribute);
+
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::Weights).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 4;
+            attribute->m_type = GL_FLOAT;
+            attribute->m_ptr = (const GLvoid *)offsetof(SkinnedVert, weights);
+            attributes.add(attribute);
+            break;
+
+        case VertexType::CompactVertex:
+            // The quantized position and the octahedral normal are normalized by the GPU, the shader decodes the normal
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::Position).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 4;
+            attribute->m_type = GL_SHORT;
+            attribute->m_normalized = true;
+            attribute->m_ptr = (const GLvoid *)offsetof(CompactVert, position);
+            attributes.add(attribute);
+
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::Normal).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 2;
+            attribute->m_type = GL_SHORT;
+            attribute->m_normalized = true;
+            attribute->m_ptr = (const GLvoid *)offsetof(CompactVert, normal);
+            attributes.add(attribute);
+
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::Color0).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 4;
+            attribute->m_type = GL_UNSIGNED_BYTE;
+            attribute->m_normalized = true;
+            attribute->m_ptr = (const GLvoid *)offsetof(CompactVert, color0);
+            attributes.add(attribute);
+
+            attribute = new OGLVertexAttribute;
+            attribute->m_pAttributeName = getVertCompName(VertexAttribute::TexCoord0).c_str();
+            attribute->m_index = shader->getAttributeLocation(attribute->m_pAttributeName);
+            attribute->m_size = 2;
+            attribute->m_type = GL_HALF_FLOAT;
+            attribute->m_ptr = (const GLvoid *)offsetof(CompactVert, tex0);
+            attributes.add(attribute);
+            break;
+
         default:
             break;
     }
@@ -488,6 +805,20 @@ OGLVertexArray *OGLRenderBackend::createVertexArray() {
     return vertexArray;
 }
 
+// Integer attributes need their own entry point, otherwise the shader would get them as floats
+static void setVertexAttribPointer(GLint loc, size_t stride, const OGLVertexAttribute *attrib) {
+    if (attrib->m_integer) {
+        glVertexAttribIPointer(loc, (GLint)attrib->m_size, attrib->m_type, (GLsizei)stride, attrib->m_ptr);
+        return;
+    }
+
+    glVertexAttribPointer(loc, (GLint)attrib->m_size,
+            attrib->m_type,
+            attrib->m_normalized ? GL_TRUE : GL_FALSE,
+            (GLsizei)stride,
+            attrib->m_ptr);
+}
+
 bool OGLRenderBackend::bindVertexLayout(OGLVertexArray *va, OGLShader *shader, size_t stride, GLint loc,
         OGLVertexAttribute *attrib) {
     if (nullptr == va || nullptr == shader || nullptr == attrib) {
@@ -495,11 +826,7 @@ bool OGLRenderBackend::bindVertexLayout(OGLVertexArray *va, OGLShader *shader, s
     }
 
     glEnableVertexAttribArray(loc);
-    glVertexAttribPointer(loc, (GLint)attrib->m_size,
-            attrib->m_type,
-            GL_FALSE,
-            (GLsizei)stride,
-            attrib->m_ptr);
+    setVertexAttribPointer(loc, stride, attrib);
 
     return true;
 }
@@ -519,11 +846,7 @@ bool OGLRenderBackend::bindVertexLayout(OGLVertexArray *va, OGLShader *shader, s
         const GLint loc = shader->getAttributeLocation(attribName);
         if (-1 != loc) {
             glEnableVertexAttribArray(loc);
-            glVertexAttribPointer(loc, (GLint)attributes[i]->m_size,
-                    attributes[i]->m_type,
-                    GL_FALSE,
-                    (GLsizei)stride,
-                    attributes[i]->m_ptr);
+            setVertexAttribPointer(loc, stride, attributes[i]);
         }
     }
 
@@ -778,6 +1101,35 @@ void OGLRenderBackend::updateTexture(OGLTexture *oglTextue, ui32 offsetX, ui32 o
             oglTextue->m_height, oglTextue->m_format, GL_UNSIGNED_BYTE, data);
 }
 
+void OGLRenderBackend::updateTextureLayer(const String &name, const TextureLayerDesc &desc, const void *data) {
+    if (nullptr == data) {
+        osre_error(Tag, "Pointer to texture data is a nullptr.");
+        return;
+    }
+
+    OGLTexture *tex = findTexture(name);
+    if (nullptr == tex) {
+        tex = createEmptyTexture(name, TextureTargetType::Texture2DArray, PixelFormatType::R8G8B8, desc.Width, desc.Height, 1);
+        tex->m_format = GL_RED;
+
+        // The texels are fetched directly, so there is nothing to filter
+        glTexParameteri(tex->m_target, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(tex->m_target, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(tex->m_target, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(tex->m_target, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexImage3D(tex->m_target, 0, GL_R32F, desc.Width, desc.Height, desc.NumLayers, 0, GL_RED, GL_FLOAT, nullptr);
+    } else if (tex->m_target != GL_TEXTURE_2D_ARRAY || tex->m_width != desc.Width || tex->m_height != desc.Height) {
+        osre_error(Tag, "Texture " + name + " does not match the layer update.");
+        return;
+    } else {
+        glBindTexture(tex->m_target, tex->m_textureId);
+    }
+
+    glTexSubImage3D(tex->m_target, 0, desc.X, desc.Y, desc.Layer, desc.RegionWidth, desc.RegionHeight, 1, GL_RED, GL_FLOAT, data);
+    glBindTexture(tex->m_target, 0);
+    CHECKOGLERRORSTATE();
+}
+
 OGLTexture *OGLRenderBackend::createTexture(const String &name, Texture *tex) {
     if (nullptr == tex) {
         return nullptr;
@@ -1029,8 +1381,44 @@ void OGLRenderBackend::setParameter(OGLParameter *param) {
     CHECKOGLERRORSTATE();
 }
 
+OGLParameter *OGLRenderBackend::createBatchParameter(const c8 *batchId, const String &name, ParameterType type, size_t numItems) {
+    if (batchId == nullptr || name.empty()) {
+        return nullptr;
+    }
+
+    cppcore::TArray<OGLParameter *> &params = mBatchParameters[batchId];
+    for (ui32 i = 0; i < params.size(); ++i) {
+        if (params[i]->m_name == name) {
+            return params[i];
+        }
+    }
+
+    OGLParameter *param = new OGLParameter;
+    param->m_name = name;
+    param->m_type = type;
+    param->m_loc = NoneLocation;
+    param->m_numItems = numItems;
+    param->m_data = UniformDataBlob::create(type, numItems);
+    params.add(param);
+
+    return param;
+}
+
+const cppcore::TArray<OGLParameter *> *OGLRenderBackend::getBatchParameters(const c8 *batchId) const {
+    auto it = mBatchParameters.find(batchId);
+    if (it == mBatchParameters.end() || it->second.isEmpty()) {
+        return nullptr;
+    }
+
+    return &it->second;
+}
+
 void OGLRenderBackend::releaseAllParameters() {
     ContainerClear(mParameters);
+    for (auto &it : mBatchParameters) {
+        ContainerClear(it.second);
+    }
+    mBatchParameters.clear();
 }
 
 void OGLRenderBackend::setParameter(OGLParameter **param, size_t numParam) {
@@ -1066,6 +1454,303 @@ size_t OGLRenderBackend::addPrimitiveGroup(PrimitiveGroup *grp) {
 
 void OGLRenderBackend::releaseAllPrimitiveGroups() {
     ContainerClear(mPrimitives);
+    mMeshPrimitives.clear();
+}
+
+void OGLRenderBackend::registerMeshPrimitives(guid meshId, size_t firstPrimIdx, size_t numPrims) {
+    if (0 == numPrims) {
+        return;
+    }
+
+    mMeshPrimitives[meshId] = std::make_pair(firstPrimIdx, numPrims);
+}
+
+bool OGLRenderBackend::updatePrimitiveRanges(guid meshId, const ui32 *ranges, size_t numRanges) {
+    if (nullptr == ranges) {
+        return false;
+    }
+
+    auto it = mMeshPrimitives.find(meshId);
+    if (it == mMeshPrimitives.end()) {
+        osre_debug(Tag, "Primitive groups of mesh not found.");
+        return false;
+    }
+
+    const size_t numPrims = std::min(numRanges, it->second.second);
+    for (size_t i = 0; i < numPrims; ++i) {
+        OGLPrimGroup *grp = mPrimitives[it->second.first + i];
+        if (nullptr != grp) {
+            grp->m_startIndex = ranges[i * 2];
+            grp->m_numIndices = ranges[i * 2 + 1];
+        }
+    }
+
+    return true;
+}
+
+static constexpr c8 ParticleSimShaderName[] = "particle_sim.sh";
+
+// The particle state is stored as a render vertex: normal = velocity, texcoord0 = ( age | lifetime )
+static const String ParticleSimVsSrc =
+        getDefaultGLSLVersion() +
+        getGLSLRenderVertexLayout() +
+        "out vec3 tf_position;\n"
+        "out vec3 tf_velocity;\n"
+        "out vec3 tf_color0;\n"
+        "out vec2 tf_life;\n"
+        "uniform float DeltaTime;\n"
+        "uniform vec3 Gravity;\n"
+        "uniform int Capacity;\n"
+        "uniform int EmitStart;\n"
+        "uniform int EmitCount;\n"
+        "uniform uint Seed;\n"
+        "uniform vec3 SpawnMin;\n"
+        "uniform vec3 SpawnMax;\n"
+        "uniform vec3 VelocityMin;\n"
+        "uniform vec3 VelocityMax;\n"
+        "uniform vec3 ColorMin;\n"
+        "uniform vec3 ColorMax;\n"
+        "uniform vec2 Lifetime;\n"
+        "uniform int UseBounds;\n"
+        "uniform vec3 BoundsMin;\n"
+        "uniform vec3 BoundsMax;\n"
+        "uint hash(uint x) {\n"
+        "    x ^= x >> 16u;\n"
+        "    x *= 0x7feb352du;\n"
+        "    x ^= x >> 15u;\n"
+        "    x *= 0x846ca68bu;\n"
+        "    x ^= x >> 16u;\n"
+        "    return x;\n"
+        "}\n"
+        "float random(inout uint state) {\n"
+        "    state = hash(state);\n"
+        "    return float(state >> 8u) * (1.0 / 16777216.0);\n"
+        "}\n"
+        "vec3 randomRange(inout uint state, vec3 lo, vec3 hi) {\n"
+        "    float x = random(state);\n"
+        "    float y = random(state);\n"
+        "    float z = random(state);\n"
+        "    return mix(lo, hi, vec3(x, y, z));\n"
+        "}\n"
+        "void main() {\n"
+        "    vec3 pos = position;\n"
+        "    vec3 vel = normal;\n"
+        "    vec3 col = color0;\n"
+        "    vec2 life = texcoord0;\n"
+        "    int slot = (gl_VertexID - EmitStart + Capacity) % Capacity;\n"
+        "    if (slot < EmitCount) {\n"
+        "        uint state = hash(uint(gl_VertexID) ^ Seed);\n"
+        "        pos = randomRange(state, SpawnMin, SpawnMax);\n"
+        "        vel = randomRange(state, VelocityMin, VelocityMax);\n"
+        "        col = randomRange(state, ColorMin, ColorMax);\n"
+        "        life = vec2(0.0, mix(Lifetime.x, Lifetime.y, random(state)));\n"
+        "    } else if (life.x < life.y) {\n"
+        "        vel += Gravity * DeltaTime;\n"
+        "        pos += vel * DeltaTime;\n"
+        "        life.x += DeltaTime;\n"
+        "        if (UseBounds != 0 && (any(lessThan(pos, BoundsMin)) || any(greaterThan(pos, BoundsMax)))) {\n"
+        "            life.x = life.y;\n"
+        "        }\n"
+        "    }\n"
+        "    tf_position = pos;\n"
+        "    tf_velocity = vel;\n"
+        "    tf_color0 = col;\n"
+        "    tf_life = life;\n"
+        "}\n";
+
+OGLShader *OGLRenderBackend::getParticleSimShader() {
+    OGLShader *shader = getShader(ParticleSimShaderName);
+    if (nullptr != shader) {
+        return shader->isCompiled() ? shader : nullptr;
+    }
+
+    shader = new OGLShader(ParticleSimShaderName);
+    mShaders.add(shader);
+    if (!shader->loadFromSource(ShaderType::SH_VertexShaderType, ParticleSimVsSrc)) {
+        osre_error(Tag, "Error while compiling the particle simulation shader.");
+        return nullptr;
+    }
+
+    // The outputs are interleaved in the order of the render vertex members
+    StringArray varyings;
+    varyings.add("tf_position");
+    varyings.add("tf_velocity");
+    varyings.add("tf_color0");
+    varyings.add("tf_life");
+    shader->setFeedbackVaryings(varyings);
+    if (!shader->createAndLink()) {
+        osre_error(Tag, "Error while linking the particle simulation shader.");
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < RenderVert::getNumAttributes(); ++i) {
+        shader->addAttribute(RenderVert::getAttributes()[i]);
+    }
+    static const c8 *Uniforms[] = {
+        "DeltaTime", "Gravity", "Capacity", "EmitStart", "EmitCount", "Seed", "SpawnMin", "SpawnMax",
+        "VelocityMin", "VelocityMax", "ColorMin", "ColorMax", "Lifetime", "UseBounds", "BoundsMin", "BoundsMax"
+    };
+    for (const c8 *uniform : Uniforms) {
+        shader->addUniform(uniform);
+    }
+
+    return shader;
+}
+
+static constexpr c8 DepthReduceShaderName[] = "depth_reduce.sh";
+
+// A full screen triangle, every target texel keeps the maximum of the source texels it covers
+static const String DepthReduceVsSrc =
+        getDefaultGLSLVersion() +
+        "void main() {\n"
+        "    vec2 pos = vec2(float((gl_VertexID << 1) & 2), float(gl_VertexID & 2));\n"
+        "    gl_Position = vec4(pos * 2.0 - 1.0, 0.0, 1.0);\n"
+        "}\n";
+
+static const String DepthReduceFsSrc =
+        getDefaultGLSLVersion() +
+        "uniform sampler2D DepthMap;\n"
+        "uniform ivec2 SourceSize;\n"
+        "uniform ivec2 TargetSize;\n"
+        "out float f_depth;\n"
+        "void main() {\n"
+        "    ivec2 texel = ivec2(gl_FragCoord.xy);\n"
+        "    ivec2 lo = (texel * SourceSize) / TargetSize;\n"
+        "    ivec2 hi = min(((texel + 1) * SourceSize + TargetSize - 1) / TargetSize, SourceSize);\n"
+        "    float depth = 0.0;\n"
+        "    for (int y = lo.y; y < hi.y; ++y) {\n"
+        "        for (int x = lo.x; x < hi.x; ++x) {\n"
+        "            depth = max(depth, texelFetch(DepthMap, ivec2(x, y), 0).r);\n"
+        "        }\n"
+        "    }\n"
+        "    f_depth = depth;\n"
+        "}\n";
+
+OGLShader *OGLRenderBackend::getDepthReduceShader() {
+    OGLShader *shader = getShader(DepthReduceShaderName);
+    if (nullptr != shader) {
+        return shader->isCompiled() ? shader : nullptr;
+    }
+
+    shader = new OGLShader(DepthReduceShaderName);
+    mShaders.add(shader);
+    if (!shader->loadFromSource(ShaderType::SH_VertexShaderType, DepthReduceVsSrc) ||
+            !shader->loadFromSource(ShaderType::SH_FragmentShaderType, DepthReduceFsSrc)) {
+        osre_error(Tag, "Error while compiling the depth reduction shader.");
+        return nullptr;
+    }
+    if (!shader->createAndLink()) {
+        osre_error(Tag, "Error while linking the depth reduction shader.");
+        return nullptr;
+    }
+
+    shader->addUniform("DepthMap");
+    shader->addUniform("SourceSize");
+    shader->addUniform("TargetSize");
+
+    return shader;
+}
+
+bool OGLRenderBackend::simulateParticles(guid meshId, const GpuParticleParams &params) {
+    static_assert(sizeof(RenderVert) == 11 * sizeof(f32), "Feedback layout does not match the render vertex.");
+
+    if (0 == params.Capacity) {
+        return false;
+    }
+
+    OGLBuffer *vb = getBufferById(meshId);
+    if (nullptr == vb || BufferType::VertexBuffer != vb->m_type) {
+        osre_debug(Tag, "Vertex buffer of particle mesh not found.");
+        return false;
+    }
+
+    OGLShader *shader = getParticleSimShader();
+    if (nullptr == shader) {
+        return false;
+    }
+
+    const size_t size = sizeof(RenderVert) * params.Capacity;
+    auto it = mParticleStates.find(meshId);
+    if (it == mParticleStates.end()) {
+        GLint vbSize = 0;
+        bindBuffer(vb);
+        glGetBufferParameteriv(GL_ARRAY_BUFFER, GL_BUFFER_SIZE, &vbSize);
+        if (static_cast<size_t>(vbSize) < size) {
+            osre_error(Tag, "Particle capacity exceeds the vertex buffer.");
+            return false;
+        }
+
+        OGLParticleState state;
+        state.mSize = size;
+        glGenBuffers(1, &state.mFeedbackBuffer);
+        glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, state.mFeedbackBuffer);
+        glBufferData(GL_TRANSFORM_FEEDBACK_BUFFER, size, nullptr, GL_DYNAMIC_COPY);
+        glBindBuffer(GL_TRANSFORM_FEEDBACK_BUFFER, 0);
+
+        // The simulation reads the vertex buffer of the mesh with its own input layout
+        state.mVertexArray = createVertexArray();
+        bindVertexArray(state.mVertexArray);
+        bindBuffer(vb);
+        VertAttribArray attributes;
+        createVertexCompArray(VertexType::RenderVertex, shader, attributes);
+        bindVertexLayout(state.mVertexArray, shader, sizeof(RenderVert), attributes);
+        releaseVertexCompArray(attributes);
+        unbindVertexArray();
+        it = mParticleStates.insert(std::make_pair(meshId, state)).first;
+    }
+
+    OGLParticleState &state = it->second;
+    if (size > state.mSize) {
+        osre_error(Tag, "Particle capacity changed after the first simulation step.");
+        return false;
+    }
+
+    useShader(shader);
+    glUniform1f(shader->getUniformLocation("DeltaTime"), params.DeltaTime);
+    glUniform3fv(shader->getUniformLocation("Gravity"), 1, glm::value_ptr(params.Gravity));
+    glUniform1i(shader->getUniformLocation("Capacity"), static_cast<GLint>(params.Capacity));
+    glUniform1i(shader->getUniformLocation("EmitStart"), static_cast<GLint>(params.EmitStart % params.Capacity));
+    glUniform1i(shader->getUniformLocation("EmitCount"), static_cast<GLint>(std::min(params.EmitCount, params.Capacity)));
+    glUniform1ui(shader->getUniformLocation("Seed"), params.Seed);
+    glUniform3fv(shader->getUniformLocation("SpawnMin"), 1, glm::value_ptr(params.SpawnMin));
+    glUniform3fv(shader->getUniformLocation("SpawnMax"), 1, glm::value_ptr(params.SpawnMax));
+    glUniform3fv(shader->getUniformLocation("VelocityMin"), 1, glm::value_ptr(params.VelocityMin));
+    glUniform3fv(shader->getUniformLocation("VelocityMax"), 1, glm::value_ptr(params.VelocityMax));
+    glUniform3fv(shader->getUniformLocation("ColorMin"), 1, glm::value_ptr(params.ColorMin));
+    glUniform3fv(shader->getUniformLocation("ColorMax"), 1, glm::value_ptr(params.ColorMax));
+    glUniform2f(shader->getUniformLocation("Lifetime"), params.LifetimeMin, params.LifetimeMax);
+    glUniform1i(shader->getUniformLocation("UseBounds"), params.UseBounds != 0u ? 1 : 0);
+    glUniform3fv(shader->getUniformLocation("BoundsMin"), 1, glm::value_ptr(params.BoundsMin));
+    glUniform3fv(shader->getUniformLocation("BoundsMax"), 1, glm::value_ptr(params.BoundsMax));
+
+    // Capture the new state, nothing will be rasterized
+    bindVertexArray(state.mVertexArray);
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, state.mFeedbackBuffer);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(params.Capacity));
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glDisable(GL_RASTERIZER_DISCARD);
+    unbindVertexArray();
+
+    // Copy the state back into the vertex buffer on the GPU, so the mesh is drawn as usual
+    glBindBuffer(GL_COPY_READ_BUFFER, state.mFeedbackBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, vb->m_oglId);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(size));
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    CHECKOGLERRORSTATE();
+
+    return true;
+}
+
+void OGLRenderBackend::releaseAllParticleStates() {
+    for (auto &it : mParticleStates) {
+        glDeleteBuffers(1, &it.second.mFeedbackBuffer);
+    }
+    mParticleStates.clear();
 }
 
 OGLFrameBuffer *OGLRenderBackend::createFrameBuffer(const String &name, ui32 width, ui32 height,
@@ -1155,13 +1840,14 @@ void OGLRenderBackend::releaseFrameBuffer(OGLFrameBuffer *oglFB) {
 
 void OGLRenderBackend::render(size_t primpGrpIdx) {
     OGLPrimGroup *grp = mPrimitives[primpGrpIdx];
-    if (grp != nullptr) {
-        glDrawRangeElements(grp->m_primitive,
-                grp->m_startIndex,
-                (GLuint)(grp->m_startIndex + grp->m_numIndices),
+    if (grp != nullptr && grp->m_numIndices > 0) {
+        // The start index is an offset into the bound index buffer
+        const size_t indexSize = grp->m_indexType == GL_UNSIGNED_INT ? sizeof(GLuint) :
+                (grp->m_indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLubyte));
+        glDrawElements(grp->m_primitive,
                 (GLsizei)grp->m_numIndices,
                 grp->m_indexType,
-                nullptr);
+                reinterpret_cast<const void *>(grp->m_startIndex * indexSize));
     }
 }
 
@@ -106,14 +106,44 @@ public:
 	void setRenderContext(Platform::AbstractOGLRenderContext *renderCtx);
 	void clearRenderTarget(const ClearState &clearState);
 	void setViewport(i32 x, i32 y, i32 w, i32 h);
+	/// @brief Will start the asynchronous read back of the depth values of the active frame buffer.
+	/// The depth will be reduced to at most 256 texels per row keeping the farthest depth per texel and
+	/// copied into one of two pixel buffers, so it can be mapped in the next frame without a stall.
+	/// @param[in] viewProjection The view-projection matrix the depth was rendered with.
+	/// @return true, if the read back was started, false for invalid arguments.
+	bool beginDepthReadback(i32 x, i32 y, i32 w, i32 h, const glm::mat4 &viewProjection);
+	/// @brief Will map the depth read back of the previous frame, rows start at the bottom.
+	/// @param[out] width          The width of the reduced depth.
+	/// @param[out] height         The height of the reduced depth.
+	/// @param[out] viewProjection The view-projection matrix the depth was rendered with.
+	/// @return The depth values or nullptr, if no read back has finished yet.
+	const f32 *mapDepthReadback(ui32 &width, ui32 &height, glm::mat4 &viewProjection);
+	/// @brief Will unmap the depth read back mapped by mapDepthReadback.
+	void unmapDepthReadback();
+	void releaseDepthReadback();
 	OGLBuffer *createBuffer(BufferType type);
     OGLBuffer *getBufferById(guid bufferId);
+
+    /// @brief Will look for a buffer of a mesh by its type.
+    /// @param[in] bufferId The id of the mesh.
+    /// @param[in] type     The buffer type.
+    /// @return The buffer or nullptr if not found.
+    OGLBuffer *getBufferById(guid bufferId, BufferType type);
 	void bindBuffer(ui32 handle);
 	void bindBuffer(OGLBuffer *pBuffer);
 	void unbindBuffer(OGLBuffer *pBuffer);
 	void copyDataToBuffer(OGLBuffer *pBuffer, void *pData, size_t size, BufferAccessType usage);
+	void copyDataToBufferRange(OGLBuffer *buffer, size_t offset, const void *data, size_t size);
 	void releaseBuffer(OGLBuffer *pBuffer);
 	void releaseAllBuffers();
+	/// @brief Will look up the buffer of a vertex- or index buffer, which is shared by several meshes.
+	/// @param[in] data     The shared buffer data.
+	/// @return The buffer or nullptr, if the data was not uploaded before.
+	OGLBuffer *getSharedBuffer(const BufferData *data) const;
+	/// @brief Will register the buffer of a shared vertex- or index buffer.
+	/// @param[in] data     The shared buffer data.
+	/// @param[in] buffer   The uploaded buffer.
+	void addSharedBuffer(const BufferData *data, OGLBuffer *buffer);
 	bool createVertexCompArray(const VertexLayout *layout, OGLShader *pShader, VertAttribArray &attributes);
 	bool createVertexCompArray(VertexType type, OGLShader *pShader, VertAttribArray &attributes);
 	void releaseVertexCompArray(cppcore::TArray<OGLVertexAttribute *> &attributes);
@@ -136,6 +166,11 @@ public:
 	OGLTexture *createEmptyTexture(const String &name, TextureTargetType target, PixelFormatType pixelFormat, ui32 width, ui32 height, ui32 channels);
     OGLTexture *createDefaultTexture(TextureTargetType target, PixelFormatType pixelFormat, ui32 width, ui32 height);
 	void updateTexture(OGLTexture *pOGLTextue, ui32 offsetX, ui32 offsetY, c8 *data, size_t size);
+	/// @brief Will update a rectangle of a float texture array, the texture will be created by the first update.
+	/// @param[in] name     The texture name.
+	/// @param[in] desc     The texture size and the rectangle.
+	/// @param[in] data     The texels of the rectangle, row by row.
+	void updateTextureLayer(const String &name, const TextureLayerDesc &desc, const void *data);
 	OGLTexture *createTexture(const String &name, Texture *tex);
 	OGLTexture *createTextureFromFile(const String &name, const IO::Uri &fileloc);
 	OGLTexture *findTexture(const String &name) const;
@@ -147,9 +182,39 @@ public:
 	OGLParameter *getParameter(const String &name) const;
 	void setParameter(OGLParameter *param);
 	void setParameter(OGLParameter **param, size_t numParam);
+	/// @brief Will return the parameter of a render batch, it will be created by the first call.
+	/// @param[in] batchId   The batch id.
+	/// @param[in] name      The parameter name in the shader.
+	/// @param[in] type      The parameter type.
+	/// @param[in] numItems  The number of items.
+	/// @return The parameter, it will only be used by the draw calls of the batch.
+	OGLParameter *createBatchParameter(const c8 *batchId, const String &name, ParameterType type, size_t numItems);
+	/// @brief Will return all parameters of a render batch.
+	/// @param[in] batchId   The batch id.
+	/// @return The parameters or nullptr, if the batch has none.
+	const cppcore::TArray<OGLParameter *> *getBatchParameters(const c8 *batchId) const;
 	void releaseAllParameters();
 	size_t addPrimitiveGroup(PrimitiveGroup *grp);
 	void releaseAllPrimitiveGroups();
+
+	/// @brief Will store the primitive groups of a mesh, the groups of one mesh are added en bloc.
+	/// @param[in] meshId        The mesh id.
+	/// @param[in] firstPrimIdx  The index of the first primitive group.
+	/// @param[in] numPrims      The number of primitive groups.
+	void registerMeshPrimitives(guid meshId, size_t firstPrimIdx, size_t numPrims);
+
+	/// @brief Will update the index ranges of the primitive groups of a mesh.
+	/// @param[in] meshId     The mesh id.
+	/// @param[in] ranges     The start-index / number-of-indices pairs.
+	/// @param[in] numRanges  The number of pairs.
+	/// @return true, if the ranges were updated, false if the mesh is unknown.
+	bool updatePrimitiveRanges(guid meshId, const ui32 *ranges, size_t numRanges);
+	/// @brief Will run one particle simulation step via transform feedback, the particles stay on the GPU.
+	/// @param[in] meshId     The id of the particle mesh.
+	/// @param[in] params     The simulation step.
+	/// @return true, if the step was executed, false in case of an error.
+	bool simulateParticles(guid meshId, const GpuParticleParams &params);
+	void releaseAllParticleStates();
     OGLFrameBuffer *createFrameBuffer(const String &name, ui32 width, ui32 height, PixelFormatType pixelFormat, bool depthBuffer);
 	void bindFrameBuffer(OGLFrameBuffer *oglFB);
 	OGLFrameBuffer *getFrameBufferByName(const String &name) const;
@@ -162,6 +227,32 @@ public:
     const String &getExtensions() const;
     
 private:
+	OGLShader *getParticleSimShader();
+	OGLShader *getDepthReduceShader();
+
+private:
+	/// @brief The transform feedback target and the input layout of a particle mesh.
+	struct OGLParticleState {
+		GLuint mFeedbackBuffer;
+		OGLVertexArray *mVertexArray;
+		size_t mSize;
+	};
+
+	/// @brief The reduction target and the double buffered pixel buffers of the depth read back.
+	struct OGLDepthReadback {
+		GLuint mDepthTexture;
+		GLuint mFrameBuffer;
+		GLuint mTarget;
+		GLuint mVertexArray;
+		GLuint mPixelBuffers[2];
+		GLsync mFences[2];
+		ui32 mSourceWidth, mSourceHeight;
+		ui32 mWidth[2], mHeight[2];
+		glm::mat4 mViewProjection[2];
+		ui32 mFrame;
+		GLuint mMapped;
+	};
+
     Color4 mClearColor;
     TransformMatrixBlock mMatrixBlock;
     Platform::AbstractOGLRenderContext *mRenderCtx;
@@ -176,9 +267,14 @@ private:
 	cppcore::TArray<size_t> mFreeTexSlots;
 	std::map<String, size_t> m_texLookupMap;
 	cppcore::TArray<OGLParameter *> mParameters;
+	std::map<const c8 *, cppcore::TArray<OGLParameter *>> mBatchParameters;
 	OGLShader *mShaderInUse;
 	cppcore::TArray<size_t> mFreeBufferSlots;
 	cppcore::TArray<OGLPrimGroup*> mPrimitives;
+	std::map<guid, std::pair<size_t, size_t>> mMeshPrimitives;
+	std::map<guid, OGLParticleState> mParticleStates;
+	OGLDepthReadback mDepthReadback;
+	std::map<const BufferData *, OGLBuffer *> mSharedBuffers;
 	RenderStates *mFpState;
 	Profiling::FPSCounter *mFpsCounter;
 	OGLCapabilities mOglCapabilities;
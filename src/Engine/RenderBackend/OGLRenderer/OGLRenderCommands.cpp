@@ -173,11 +173,19 @@ OGLVertexArray *setupBuffers(Mesh *mesh, OGLRenderBackend *rb, OGLShader *oglSha
         return nullptr;
     }
 
-    // create vertex buffer and  and pass triangle vertex to buffer object
-    OGLBuffer *vb = rb->createBuffer(vertices->m_type);
-    vb->m_geoId = mesh->getId();
-    rb->bindBuffer(vb);
-    rb->copyDataToBuffer(vb, vertices->getData(), vertices->getSize(), vertices->m_access);
+    // create vertex buffer and pass triangle vertex to buffer object, shared ones are uploaded once
+    OGLBuffer *vb = mesh->hasSharedVertexBuffer() ? rb->getSharedBuffer(vertices) : nullptr;
+    if (vb != nullptr) {
+        rb->bindBuffer(vb);
+    } else {
+        vb = rb->createBuffer(vertices->m_type);
+        vb->m_geoId = mesh->getId();
+        rb->bindBuffer(vb);
+        rb->copyDataToBuffer(vb, vertices->getData(), vertices->getSize(), vertices->m_access);
+        if (mesh->hasSharedVertexBuffer()) {
+            rb->addSharedBuffer(vertices, vb);
+        }
+    }
 
     // enable vertex attribute arrays
     TArray<OGLVertexAttribute *> attributes;
@@ -186,11 +194,19 @@ OGLVertexArray *setupBuffers(Mesh *mesh, OGLRenderBackend *rb, OGLShader *oglSha
     rb->bindVertexLayout(vertexArray, oglShader, stride, attributes);
     rb->releaseVertexCompArray(attributes);
 
-    // create index buffer and pass indices to element array buffer
-    OGLBuffer *ib = rb->createBuffer(indices->m_type);
-    ib->m_geoId = mesh->getId();
-    rb->bindBuffer(ib);
-    rb->copyDataToBuffer(ib, indices->getData(), indices->getSize(), indices->m_access);
+    // create index buffer and pass indices to element array buffer, shared ones are uploaded once
+    OGLBuffer *ib = mesh->hasSharedIndexBuffer() ? rb->getSharedBuffer(indices) : nullptr;
+    if (ib != nullptr) {
+        rb->bindBuffer(ib);
+    } else {
+        ib = rb->createBuffer(indices->m_type);
+        ib->m_geoId = mesh->getId();
+        rb->bindBuffer(ib);
+        rb->copyDataToBuffer(ib, indices->getData(), indices->getSize(), indices->m_access);
+        if (mesh->hasSharedIndexBuffer()) {
+            rb->addSharedBuffer(indices, ib);
+        }
+    }
 
     rb->unbindVertexArray();
 
@@ -226,7 +242,7 @@ void setupPrimDrawCmd(const char *id, bool useLocalMatrix, const glm::mat4 &mode
     eh->enqueueRenderCmd(renderCmd);
 }
 
-void setupInstancedDrawCmd(const char *id, const TArray<size_t> &ids, OGLRenderBackend *rb,
+void setupInstancedDrawCmd(const char *id, bool useLocalMatrix, const glm::mat4 &model, const TArray<size_t> &ids, OGLRenderBackend *rb,
         OGLRenderEventHandler *eh, OGLVertexArray *va, size_t numInstances) {
     osre_assert(nullptr != rb);
     osre_assert(nullptr != eh);
@@ -239,6 +255,10 @@ void setupInstancedDrawCmd(const char *id, const TArray<size_t> &ids, OGLRenderB
 
     DrawInstancePrimitivesCmdData *data = new DrawInstancePrimitivesCmdData;
     data->m_id = id;
+    if (useLocalMatrix) {
+        data->m_model = model;
+        data->m_localMatrix = useLocalMatrix;
+    }
     data->m_vertexArray = va;
     data->m_numInstances = numInstances;
     data->m_primitives.reserve(ids.size());
@@ -75,7 +75,8 @@ void setupPrimDrawCmd(const char* id, bool useLocalMatrix, const glm::mat4& mode
     OGLRenderEventHandler* eh, OGLVertexArray* va);
 
 /// @brief Setup for instanced render calls.
-void setupInstancedDrawCmd(const char* id, const cppcore::TArray<size_t>& ids, OGLRenderBackend* rb,
+void setupInstancedDrawCmd(const char* id, bool useLocalMatrix, const glm::mat4& model,
+    const cppcore::TArray<size_t>& ids, OGLRenderBackend* rb,
     OGLRenderEventHandler* eh, OGLVertexArray* va, size_t numInstances);
 
 } // Namespace RenderBackend
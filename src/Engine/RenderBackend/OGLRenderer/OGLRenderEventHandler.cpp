@@ -39,6 +39,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "RenderBackend/RenderCommon.h"
 
 #include <cppcore/Container/TArray.h>
+#include <algorithm>
 
 namespace OSRE::RenderBackend {
 
@@ -272,6 +273,9 @@ bool OGLRenderEventHandler::addMeshes(const c8 *id, cppcore::TArray<size_t> &pri
             const size_t primIdx(m_oglBackend->addPrimitiveGroup(currentMesh->getPrimitiveGroupAt(i)));
             primGroups.add(primIdx);
         }
+        if (!primGroups.isEmpty()) {
+            m_oglBackend->registerMeshPrimitives(currentMesh->getId(), primGroups[0], primGroups.size());
+        }
 
         // create the default material
         SetMaterialStageCmdData *data = setupMaterial(currentMesh->getMaterial(), m_oglBackend, this);
@@ -286,11 +290,11 @@ bool OGLRenderEventHandler::addMeshes(const c8 *id, cppcore::TArray<size_t> &pri
 
         // setup the render calls
         if (0 == currentMeshEntry->numInstances) {
-            setupPrimDrawCmd(id, currentMesh->isLocal(), currentMesh->getLocalMatrix(),
-                    primGroups, m_oglBackend, this, m_vertexArray);
+            setupPrimDrawCmd(id, currentMesh->hasMeshMatrix(), currentMesh->getMeshMatrix(), primGroups, m_oglBackend, this,
+                    m_vertexArray);
         } else {
-            setupInstancedDrawCmd(id, primGroups, m_oglBackend, this, m_vertexArray,
-                    currentMeshEntry->numInstances);
+            setupInstancedDrawCmd(id, currentMesh->hasMeshMatrix(), currentMesh->getMeshMatrix(), primGroups, m_oglBackend,
+                    this, m_vertexArray, currentMeshEntry->numInstances);
         }
 
         primGroups.resize(0);
@@ -358,6 +362,9 @@ bool OGLRenderEventHandler::onInitRenderPasses(const Common::EventData *eventDat
                         const size_t primIdx(m_oglBackend->addPrimitiveGroup(currentMesh->getPrimitiveGroupAt(i)));
                         primGroups.add(primIdx);
                     }
+                    if (!primGroups.isEmpty()) {
+                        m_oglBackend->registerMeshPrimitives(currentMesh->getId(), primGroups[0], primGroups.size());
+                    }
 
                     // create the default material
                     SetMaterialStageCmdData *data = setupMaterial(currentMesh->getMaterial(), m_oglBackend, this);
@@ -372,11 +379,11 @@ bool OGLRenderEventHandler::onInitRenderPasses(const Common::EventData *eventDat
 
                     // setup the render calls
                     if (0 == currentMeshEntry->numInstances) {
-                        setupPrimDrawCmd(currentBatchData->m_id, currentMesh->isLocal(), currentMesh->getLocalMatrix(),
+                        setupPrimDrawCmd(currentBatchData->m_id, currentMesh->hasMeshMatrix(), currentMesh->getMeshMatrix(),
                                 primGroups, m_oglBackend, this, m_vertexArray);
                     } else {
-                        setupInstancedDrawCmd(currentBatchData->m_id, primGroups, m_oglBackend, this, m_vertexArray,
-                                currentMeshEntry->numInstances);
+                        setupInstancedDrawCmd(currentBatchData->m_id, currentMesh->hasMeshMatrix(), currentMesh->getMeshMatrix(),
+                                primGroups, m_oglBackend, this, m_vertexArray, currentMeshEntry->numInstances);
                     }
 
                     primGroups.resize(0);
@@ -413,15 +420,56 @@ void OGLRenderEventHandler::onHandleCommit(FrameSubmitCmd *cmd) {
     } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateUniforms) {
         c8 name[BufferSize];
         setName(name, BufferSize, cmd);
-        const ui32 offset = cmd->m_data[0] + 1;
+        ui32 desc[2] = {};
+        const size_t descOffset = static_cast<uc8>(cmd->m_data[0]) + 1;
+        ::memcpy(desc, &cmd->m_data[descOffset], sizeof(desc));
+        const size_t offset = descOffset + sizeof(desc);
         const size_t size = cmd->m_size - offset;
         OGLParameter *oglParam = m_oglBackend->getParameter(name);
-        ::memcpy(oglParam->m_data->getData(), &cmd->m_data[offset], size);
+        if (oglParam != nullptr) {
+            // New uniforms will be created with their batch
+            ::memcpy(oglParam->m_data->getData(), &cmd->m_data[offset], std::min(size, oglParam->m_data->m_size));
+        }
+
+        // Batches sharing a uniform name keep their own values, their draw calls will use them
+        OGLParameter *batchParam = m_oglBackend->createBatchParameter(cmd->m_batchId, name, static_cast<ParameterType>(desc[0]), desc[1]);
+        if (batchParam != nullptr) {
+            ::memcpy(batchParam->m_data->getData(), &cmd->m_data[offset], std::min(size, batchParam->m_data->m_size));
+        }
     } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateBuffer) {
         OGLBuffer *buffer = m_oglBackend->getBufferById(cmd->m_meshId);
         m_oglBackend->bindBuffer(buffer);
         m_oglBackend->copyDataToBuffer(buffer, cmd->m_data, cmd->m_size, BufferAccessType::ReadWrite);
         m_oglBackend->unbindBuffer(buffer);
+    } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateIndexBuffer) {
+        // The element buffer binding is part of the vertex array state, it must not change another array
+        OGLBuffer *buffer = m_oglBackend->getBufferById(cmd->m_meshId, BufferType::IndexBuffer);
+        if (buffer != nullptr) {
+            m_oglBackend->unbindVertexArray();
+            m_oglBackend->bindBuffer(buffer);
+            for (size_t offset = 0; offset + 2 * sizeof(ui32) <= cmd->m_size;) {
+                ui32 range[2];
+                ::memcpy(range, &cmd->m_data[offset], sizeof(range));
+                offset += sizeof(range);
+                m_oglBackend->copyDataToBufferRange(buffer, range[0], &cmd->m_data[offset], range[1]);
+                offset += range[1];
+            }
+            m_oglBackend->unbindBuffer(buffer);
+        }
+    } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdatePrimitives) {
+        const ui32 *ranges = reinterpret_cast<const ui32 *>(cmd->m_data);
+        m_oglBackend->updatePrimitiveRanges(cmd->m_meshId, ranges, cmd->m_size / (2 * sizeof(ui32)));
+    } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::SimulateParticles) {
+        GpuParticleParams params;
+        ::memcpy(&params, cmd->m_data, sizeof(GpuParticleParams));
+        m_oglBackend->simulateParticles(cmd->m_meshId, params);
+    } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::UpdateTexture) {
+        c8 name[BufferSize];
+        setName(name, BufferSize, cmd);
+        const size_t offset = static_cast<uc8>(cmd->m_data[0]) + 1;
+        TextureLayerDesc desc;
+        ::memcpy(&desc, &cmd->m_data[offset], sizeof(TextureLayerDesc));
+        m_oglBackend->updateTextureLayer(name, desc, &cmd->m_data[offset + sizeof(TextureLayerDesc)]);
     } else if (cmd->m_updateFlags & (ui32)FrameSubmitCmd::AddRenderData) {
         for (ui32 i = 0; i < cmd->m_updatedPasses.size(); ++i) {
             PassData *pd = cmd->m_updatedPasses[i];
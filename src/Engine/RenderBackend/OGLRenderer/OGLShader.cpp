@@ -103,6 +103,18 @@ bool OGLShader::loadFromStream(ShaderType type, IO::Stream &stream) {
     return retCode;
 }
 
+void OGLShader::setFeedbackVaryings(const StringArray &varyings) {
+    if (isCompiled()) {
+        osre_warn(Tag, "Feedback varyings must be set before linking.");
+        return;
+    }
+
+    mFeedbackVaryings.clear();
+    for (ui32 i = 0; i < varyings.size(); ++i) {
+        mFeedbackVaryings.add(varyings[i]);
+    }
+}
+
 bool OGLShader::createAndLink() {
     if (isCompiled()) {
         osre_warn(Tag, "Trying to compile shader program, which was compiled before.");
@@ -124,6 +136,14 @@ bool OGLShader::createAndLink() {
         glAttachShader(mShaderprog, mShaders[static_cast<i32>(ShaderType::SH_GeometryShaderType)]);
     }
 
+    if (!mFeedbackVaryings.isEmpty()) {
+        cppcore::TArray<const GLchar *> names;
+        for (ui32 i = 0; i < mFeedbackVaryings.size(); ++i) {
+            names.add(mFeedbackVaryings[i].c_str());
+        }
+        glTransformFeedbackVaryings(mShaderprog, static_cast<GLsizei>(names.size()), &names[0], GL_INTERLEAVED_ATTRIBS);
+    }
+
     GLint status(0);
     glLinkProgram(mShaderprog);
     glGetProgramiv(mShaderprog, GL_LINK_STATUS, &status);
@@ -86,6 +86,11 @@ public:
     /// @return true, if compile was successful, false in case of an error.
     bool loadFromStream( ShaderType type, IO::Stream &stream );
 
+    /// @brief  Will set the outputs, which will be captured by transform feedback.
+    /// @param  varyings    [in] The output names, the values are interleaved in this order.
+    /// @remark Must be called before createAndLink.
+    void setFeedbackVaryings( const StringArray &varyings );
+
     /// @brief  Will create and link a shader program.
     /// @return true, if create & link was successful, false in case of an error.
     bool createAndLink();
@@ -146,6 +151,7 @@ private:
     ui32 mShaders[static_cast<size_t>(ShaderType::Count)];
     std::map<String, GLint> mAttributeMap;
     std::map<String, GLint> mUniformLocationMap;
+    StringArray mFeedbackVaryings;
     bool mIsCompiledAndLinked;
 	bool mIsInUse;
 };
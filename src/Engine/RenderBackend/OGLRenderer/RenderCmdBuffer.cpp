@@ -23,6 +23,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "RenderBackend/OGLRenderer/RenderCmdBuffer.h"
 #include "RenderBackend/OGLRenderer/OGLCommon.h"
 #include "RenderBackend/OGLRenderer/OGLRenderBackend.h"
+#include "RenderBackend/HiZBuffer.h"
+#include "RenderBackend/Pipeline.h"
 #include "Debugging/osre_debugging.h"
 #include "Platform/AbstractOGLRenderContext.h"
 
@@ -107,6 +109,13 @@ void RenderCmdBuffer::onRenderFrame() {
             continue;
         }
 
+        // The occlusion pass does not draw, it builds the depth pyramid for the next frame
+        if (pass->getId() == OcclusionPassId) {
+            onOcclusionPass(pass);
+            mPipeline->endPass(passId);
+            continue;
+        }
+
         RenderStates states;
         states.m_polygonState = pass->getPolygonState();
         states.m_cullState = pass->getCullState();
@@ -143,6 +152,28 @@ void RenderCmdBuffer::onRenderFrame() {
     mRBService->renderFrame();
 }
 
+void RenderCmdBuffer::onOcclusionPass(RenderPass *pass) {
+    HiZBuffer *occlusionBuffer = mPipeline->getOcclusionBuffer();
+    if (occlusionBuffer == nullptr) {
+        return;
+    }
+
+    const Viewport &v = pass->getViewport();
+    if (v.m_w <= 0 || v.m_h <= 0) {
+        return;
+    }
+
+    // The read back of the last frame has arrived by now, so the occlusion test runs one frame behind
+    ui32 width = 0, height = 0;
+    glm::mat4 viewProjection(1.0f);
+    const f32 *depth = mRBService->mapDepthReadback(width, height, viewProjection);
+    if (depth != nullptr) {
+        occlusionBuffer->build(depth, width, height, viewProjection);
+        mRBService->unmapDepthReadback();
+    }
+    mRBService->beginDepthReadback(v.m_x, v.m_y, v.m_w, v.m_h, mProj * mView);
+}
+
 void RenderCmdBuffer::onPostRenderFrame() {
 
     // unbind the active shader
@@ -201,6 +232,18 @@ void RenderCmdBuffer::commitParameters() {
     }
 }
 
+void RenderCmdBuffer::commitBatchParameters(const c8 *id) {
+    // The values of the batch win over the shared ones, for instance the skinning palette of a character
+    const ::cppcore::TArray<OGLParameter *> *params = mRBService->getBatchParameters(id);
+    if (params == nullptr) {
+        return;
+    }
+
+    for (ui32 i = 0; i < params->size(); ++i) {
+        mRBService->setParameter((*params)[i]);
+    }
+}
+
 void RenderCmdBuffer::setMatrixes(const glm::mat4 &model, const glm::mat4 &view, const glm::mat4 &proj) {
     mModel = model;
     mView = view;
@@ -227,11 +270,13 @@ bool RenderCmdBuffer::onDrawPrimitivesCmd(DrawPrimitivesCmdData *data) {
         const MatrixBuffer *buffer = it->second;
         setMatrixes(buffer->model, buffer->view, buffer->proj);
     }
+    commitBatchParameters(data->id);
 
     mRBService->bindVertexArray(data->vertexArray);
+    const glm::mat4 model = mRBService->getMatrix(MatrixType::Model);
     if (data->localMatrix) {
-        glm::mat4 model = mRBService->getMatrix(MatrixType::Model);
-        mRBService->setMatrix(MatrixType::Model, data->model * model);
+        // The mesh matrix works on the vertices, so it gets applied before the model matrix
+        mRBService->setMatrix(MatrixType::Model, model * data->model);
         mRBService->applyMatrix();
     }
 
@@ -239,6 +284,11 @@ bool RenderCmdBuffer::onDrawPrimitivesCmd(DrawPrimitivesCmdData *data) {
         mRBService->render(data->primitives[i]);
     }
 
+    if (data->localMatrix) {
+        mRBService->setMatrix(MatrixType::Model, model);
+        mRBService->applyMatrix();
+    }
+
     return true;
 }
 
@@ -247,11 +297,30 @@ bool RenderCmdBuffer::onDrawPrimitivesInstancesCmd(DrawInstancePrimitivesCmdData
         return false;
     }
 
+    if (data->m_id != nullptr) {
+        if (auto it = mMatrixBuffer.find(data->m_id); it != mMatrixBuffer.end()) {
+            const MatrixBuffer *buffer = it->second;
+            setMatrixes(buffer->model, buffer->view, buffer->proj);
+        }
+        commitBatchParameters(data->m_id);
+    }
+
     mRBService->bindVertexArray(data->m_vertexArray);
+    const glm::mat4 model = mRBService->getMatrix(MatrixType::Model);
+    if (data->m_localMatrix) {
+        mRBService->setMatrix(MatrixType::Model, model * data->m_model);
+        mRBService->applyMatrix();
+    }
+
     for (size_t i = 0; i < data->m_primitives.size(); i++) {
         mRBService->render(data->m_primitives[i], data->m_numInstances);
     }
 
+    if (data->m_localMatrix) {
+        mRBService->setMatrix(MatrixType::Model, model);
+        mRBService->applyMatrix();
+    }
+
     return true;
 }
 
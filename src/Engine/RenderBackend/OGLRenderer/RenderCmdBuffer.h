@@ -46,6 +46,7 @@ namespace RenderBackend {
 class OGLRenderBackend;
 class OGLShader;
 class Pipeline;
+class RenderPass;
 class Material;
 
 struct OGLVertexArray;
@@ -115,6 +116,10 @@ public:
     /// @brief Commits all assigned parameters to the active shader.
     void commitParameters();
 
+    /// @brief Commits the parameters of one render batch to the active shader.
+    /// @param id       The batch id.
+    void commitBatchParameters(const c8 *id);
+
     /// @brief  Will assign the default matrices.
     /// @param model    The model matrix.
     /// @param view     The view matrix
@@ -135,6 +140,8 @@ protected:
     virtual bool onSetRenderTargetCmd(SetRenderTargetCmdData *data);
     /// The set material callback.
     virtual bool onSetMaterialStageCmd(SetMaterialStageCmdData *data);
+    /// The occlusion pass callback, builds the occlusion buffer from the depth of the last frame.
+    void onOcclusionPass(RenderPass *pass);
 
 private:
     OGLRenderBackend *mRBService;
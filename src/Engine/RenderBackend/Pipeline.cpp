@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "Common/osre_common.h"
 #include "RenderBackend/Pipeline.h"
 #include "RenderBackend/RenderBackendService.h"
+#include "RenderBackend/HiZBuffer.h"
 
 namespace OSRE {
 namespace RenderBackend {
@@ -45,12 +46,14 @@ Pipeline::Pipeline(const String &pipelineName) :
         Object(pipelineName),
         mRbService(),
         mCurrentPassId(InvalidPassIdx),
-        mInFrame(false) {
+        mInFrame(false),
+        mOcclusionBuffer(nullptr) {
     // empty
 }
 
 Pipeline::~Pipeline() {
     clear();
+    delete mOcclusionBuffer;
 }
 
 void Pipeline::addPass(RenderPass *pass) {
@@ -59,6 +62,9 @@ void Pipeline::addPass(RenderPass *pass) {
     }
 
     mPasses.add(pass);
+    if (pass->getId() == OcclusionPassId && mOcclusionBuffer == nullptr) {
+        mOcclusionBuffer = new HiZBuffer;
+    }
 }
 
 RenderPass *Pipeline::getPassById(guid passId) const {
@@ -121,6 +127,9 @@ void Pipeline::clear() {
     mCurrentPassId = InvalidPassIdx;
     mInFrame = false;
     mPasses.resize(0);
+    if (mOcclusionBuffer != nullptr) {
+        mOcclusionBuffer->clear();
+    }
 }
 
 void Pipeline::resizeRenderTargets(guid id, ui32 x, ui32 y, ui32 w, ui32 h) {
@@ -136,5 +145,9 @@ void Pipeline::resizeRenderTargets(guid id, ui32 x, ui32 y, ui32 w, ui32 h) {
     }
 }
 
+HiZBuffer *Pipeline::getOcclusionBuffer() const {
+    return mOcclusionBuffer;
+}
+
 } // Namespace RenderBackend
 } // Namespace OSRE
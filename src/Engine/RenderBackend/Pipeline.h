@@ -34,6 +34,7 @@ namespace RenderBackend {
 // Forward declarations ---------------------------------------------------------------------------
 class Shader;
 class RenderBackendService;
+class HiZBuffer;
 
 using cppcore::TArray;
 
@@ -100,12 +101,17 @@ public:
 
     void resizeRenderTargets(guid id, ui32 x, ui32 y, ui32 w, ui32 h);
 
+    /// @brief  Will return the occlusion buffer, which is written by the occlusion pass.
+    /// @return The occlusion buffer or nullptr, if the pipeline contains no occlusion pass.
+    HiZBuffer *getOcclusionBuffer() const;
+
 private:
     using PipelinePassArray = TArray<RenderPass*>;
     PipelinePassArray mPasses;
     RenderBackend::RenderBackendService *mRbService;
     guid mCurrentPassId;
     bool mInFrame;
+    HiZBuffer *mOcclusionBuffer;
 };
 
 } // Namespace RenderBackend
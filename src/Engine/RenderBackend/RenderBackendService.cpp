@@ -64,8 +64,9 @@ static i32 hasBatch(const c8 *id, const TArray<RenderBatchData *> &batchDataArra
         return IdxNotFound;
     }
 
+    // The batch names of skinned entities only differ in their suffix
     for (ui32 i = 0; i < batchDataArray.size(); ++i) {
-        if (0 == strncmp(batchDataArray[i]->m_id, id, strlen(id))) {
+        if (0 == strcmp(batchDataArray[i]->m_id, id)) {
             return i;
         }
     }
@@ -73,6 +74,42 @@ static i32 hasBatch(const c8 *id, const TArray<RenderBatchData *> &batchDataArra
     return IdxNotFound;
 }
 
+// The index update is stored as a sequence of byte-offset / byte-size / indices ranges
+static void fillIndexRanges(Mesh *mesh, FrameSubmitCmd *cmd) {
+    const size_t headerSize = 2 * sizeof(ui32);
+    const c8 *indices = mesh->getDrawnIndexData();
+    if (mesh->getMeshlets().isEmpty()) {
+        const ui32 header[2] = { 0u, static_cast<ui32>(mesh->getIndexBuffer()->getSize()) };
+        cmd->m_size = headerSize + header[1];
+        cmd->m_data = new c8[cmd->m_size];
+        ::memcpy(cmd->m_data, header, headerSize);
+        ::memcpy(&cmd->m_data[headerSize], indices, header[1]);
+        return;
+    }
+
+    // Only the changed groups will be uploaded, the indices behind the drawn ones are never used
+    size_t offset = 0, size = 0;
+    cmd->m_size = 0;
+    for (size_t i = 0; i < mesh->getNumberOfPrimitiveGroups(); ++i) {
+        if (mesh->getDirtyDrawnIndices(i, offset, size) && size != 0) {
+            cmd->m_size += headerSize + size;
+        }
+    }
+    cmd->m_data = cmd->m_size != 0 ? new c8[cmd->m_size] : nullptr;
+    size_t next = 0;
+    for (size_t i = 0; i < mesh->getNumberOfPrimitiveGroups(); ++i) {
+        if (!mesh->getDirtyDrawnIndices(i, offset, size) || size == 0) {
+            continue;
+        }
+        const ui32 header[2] = { static_cast<ui32>(offset), static_cast<ui32>(size) };
+        ::memcpy(&cmd->m_data[next], header, headerSize);
+        next += headerSize;
+        ::memcpy(&cmd->m_data[next], indices + offset, size);
+        next += size;
+    }
+    mesh->clearDirtyDrawnIndices();
+}
+
 RenderBackendService::RenderBackendService() :
         AbstractService("renderbackend/renderbackendserver"),
         mSettings(nullptr),
@@ -249,13 +286,17 @@ void RenderBackendService::commitNextFrame() {
                     uniformBuffer.writeVar(var);
 
                     // todo: replace by uniform buffer.
-                    cmd->m_size = var->getSize();
+                    // len of name | name | type | number of items | buffer, the batch creates its own copy
+                    const ui32 desc[2] = { static_cast<ui32>(var->m_type), static_cast<ui32>(var->m_numItems) };
+                    cmd->m_size = var->getSize() + sizeof(desc);
                     cmd->m_data = new c8[cmd->m_size];
                     size_t offset = 0;
                     cmd->m_data[offset] = var->m_name.size() > 255 ? 255 : static_cast<c8>(var->m_name.size());
                     ++offset;
                     memcpy(&cmd->m_data[offset], var->m_name.c_str(), var->m_name.size());
                     offset += var->m_name.size();
+                    memcpy(&cmd->m_data[offset], desc, sizeof(desc));
+                    offset += sizeof(desc);
                     memcpy(&cmd->m_data[offset], var->m_data.getData(), var->m_data.m_size);
                 }
             }
@@ -270,6 +311,32 @@ void RenderBackendService::commitNextFrame() {
                     cmd->m_data = new c8[cmd->m_size];
                     ::memcpy(cmd->m_data, currentMesh->getVertexBuffer()->getData(), cmd->m_size);
                 }
+                currentBatch->m_updateMeshArray.resize(0);
+            }
+
+            // Must be handled before new meshes were added, their materials look up the textures by name
+            if (currentBatch->m_dirtyFlag & RenderBatchData::TextureUpdateDirty) {
+                for (ui32 k = 0; k < currentBatch->m_textureUpdates.size(); ++k) {
+                    TextureLayerUpdate *update = currentBatch->m_textureUpdates[k];
+                    FrameSubmitCmd *cmd = mSubmitFrame->enqueue(currentPass->m_id, currentBatch->m_id);
+                    cmd->m_updateFlags |= (ui32)FrameSubmitCmd::UpdateTexture;
+
+                    // len of name | name | desc | texels
+                    const size_t nameLen = update->Name.size() > 255 ? 255 : update->Name.size();
+                    const size_t dataSize = update->Data.size() * sizeof(f32);
+                    cmd->m_size = 1 + nameLen + sizeof(TextureLayerDesc) + dataSize;
+                    cmd->m_data = new c8[cmd->m_size];
+                    size_t offset = 0;
+                    cmd->m_data[offset] = static_cast<c8>(nameLen);
+                    ++offset;
+                    ::memcpy(&cmd->m_data[offset], update->Name.c_str(), nameLen);
+                    offset += nameLen;
+                    ::memcpy(&cmd->m_data[offset], &update->Desc, sizeof(TextureLayerDesc));
+                    offset += sizeof(TextureLayerDesc);
+                    ::memcpy(&cmd->m_data[offset], &update->Data[0], dataSize);
+                    delete update;
+                }
+                currentBatch->m_textureUpdates.resize(0);
             }
 
             if (currentBatch->m_dirtyFlag & RenderBatchData::MeshDirty) {
@@ -280,6 +347,54 @@ void RenderBackendService::commitNextFrame() {
                 cmd->m_updateFlags |= (ui32)FrameSubmitCmd::AddRenderData;
             }
 
+            // Must be handled after new meshes were added, they create the index buffers
+            if (currentBatch->m_dirtyFlag & RenderBatchData::IndexUpdateDirty) {
+                for (ui32 k = 0; k < currentBatch->m_indexUpdateMeshArray.size(); ++k) {
+                    Mesh *currentMesh = currentBatch->m_indexUpdateMeshArray[k];
+                    FrameSubmitCmd *cmd = mSubmitFrame->enqueue(currentPass->m_id, currentBatch->m_id);
+                    cmd->m_updateFlags |= (ui32)FrameSubmitCmd::UpdateIndexBuffer;
+                    cmd->m_meshId = currentMesh->getId();
+                    fillIndexRanges(currentMesh, cmd);
+                }
+                currentBatch->m_indexUpdateMeshArray.resize(0);
+            }
+
+            // Must be handled after new meshes were added, the ranges are stored as start-index / number-of-indices pairs
+            if (currentBatch->m_dirtyFlag & RenderBatchData::MeshRangeDirty) {
+                for (ui32 k = 0; k < currentBatch->m_rangeUpdateMeshArray.size(); ++k) {
+                    Mesh *currentMesh = currentBatch->m_rangeUpdateMeshArray[k];
+                    FrameSubmitCmd *cmd = mSubmitFrame->enqueue(currentPass->m_id, currentBatch->m_id);
+                    cmd->m_updateFlags |= (ui32)FrameSubmitCmd::UpdatePrimitives;
+                    cmd->m_meshId = currentMesh->getId();
+                    const size_t numGroups = currentMesh->getNumberOfPrimitiveGroups();
+                    cmd->m_size = numGroups * 2 * sizeof(ui32);
+                    cmd->m_data = new c8[cmd->m_size];
+                    ui32 *ranges = reinterpret_cast<ui32 *>(cmd->m_data);
+                    const bool visible = currentMesh->isVisible();
+                    for (size_t l = 0; l < numGroups; ++l) {
+                        const PrimitiveGroup *grp = currentMesh->getPrimitiveGroupAt(l);
+                        ranges[l * 2] = static_cast<ui32>(grp->m_startIndex);
+                        ranges[l * 2 + 1] = visible ? static_cast<ui32>(currentMesh->getNumDrawnIndices(l)) : 0u;
+                    }
+                }
+                currentBatch->m_rangeUpdateMeshArray.resize(0);
+            }
+
+            // The simulation steps run before the frame is rendered, the result will not be read back
+            if (currentBatch->m_dirtyFlag & RenderBatchData::ParticleSimDirty) {
+                for (ui32 k = 0; k < currentBatch->m_particleMeshArray.size(); ++k) {
+                    Mesh *currentMesh = currentBatch->m_particleMeshArray[k];
+                    FrameSubmitCmd *cmd = mSubmitFrame->enqueue(currentPass->m_id, currentBatch->m_id);
+                    cmd->m_updateFlags |= (ui32)FrameSubmitCmd::SimulateParticles;
+                    cmd->m_meshId = currentMesh->getId();
+                    cmd->m_size = sizeof(GpuParticleParams);
+                    cmd->m_data = new c8[cmd->m_size];
+                    ::memcpy(cmd->m_data, &currentBatch->m_particleParams[k], cmd->m_size);
+                }
+                currentBatch->m_particleMeshArray.resize(0);
+                currentBatch->m_particleParams.resize(0);
+            }
+
             currentBatch->m_dirtyFlag = 0;
         }
     }
@@ -307,6 +422,11 @@ Pipeline *RenderBackendService::createDefault3DPipeline(guid framebufferId) {
     renderPass->setCullState(cullState);
     pipeline->addPass(renderPass);
 
+    // The occlusion pass reads back the depth of the scene, so it must follow the scene pass
+    if (mSettings != nullptr && mSettings->getBool(Settings::OcclusionCulling)) {
+        pipeline->addPass(RenderPassFactory::create(OcclusionPassId, framebufferId));
+    }
+
     return pipeline;
 }
 
@@ -325,6 +445,10 @@ void RenderBackendService::setActivePipeline(Pipeline *pipeline) {
     mPipeline = pipeline;
 }
 
+Pipeline *RenderBackendService::getActivePipeline() const {
+    return mPipeline;
+}
+
 PassData *RenderBackendService::getPassById(const c8 *id) const {
     if (nullptr == id) {
         return nullptr;
@@ -452,16 +576,48 @@ void RenderBackendService::setMatrixArray(const String &name, ui32 numMat, const
         return;
     }
 
+    if (0 == numMat || nullptr == matrixArray) {
+        osre_error(Tag, "Invalid matrix array.");
+        return;
+    }
+
     UniformVar *var = mCurrentBatch->getVarByName(name.c_str());
     if (nullptr == var) {
         var = UniformVar::create(name, ParameterType::PT_Mat4Array, numMat);
         mCurrentBatch->m_uniforms.add(var);
+    } else if (numMat > var->m_numItems) {
+        osre_error(Tag, "Matrix array " + name + " is too small.");
+        return;
     }
 
     ::memcpy(var->m_data.m_data, glm::value_ptr(matrixArray[0]), sizeof(glm::mat4) * numMat);
     mCurrentBatch->m_dirtyFlag |= RenderBatchData::UniformBufferDirty;
 }
 
+void RenderBackendService::setFloat3Array(const String &name, ui32 numValues, const glm::vec3 *values) {
+    if (nullptr == mCurrentBatch) {
+        osre_error(Tag, "No active batch.");
+        return;
+    }
+
+    if (0 == numValues || nullptr == values) {
+        osre_error(Tag, "Invalid value array.");
+        return;
+    }
+
+    UniformVar *var = mCurrentBatch->getVarByName(name.c_str());
+    if (nullptr == var) {
+        var = UniformVar::create(name, ParameterType::PT_Float3Array, numValues);
+        mCurrentBatch->m_uniforms.add(var);
+    } else if (numValues > var->m_numItems) {
+        osre_error(Tag, "Value array " + name + " is too small.");
+        return;
+    }
+
+    ::memcpy(var->m_data.m_data, glm::value_ptr(values[0]), sizeof(glm::vec3) * numValues);
+    mCurrentBatch->m_dirtyFlag |= RenderBatchData::UniformBufferDirty;
+}
+
 void RenderBackendService::addMesh(Mesh *mesh, ui32 numInstances) {
     if (mesh == nullptr) {
         osre_error(Tag, "Pointer to geometry is nullptr.");
@@ -513,6 +669,84 @@ void RenderBackendService::updateMesh(Mesh *mesh) {
     mCurrentBatch->m_dirtyFlag |= RenderBatchData::MeshUpdateDirty;
 }
 
+void RenderBackendService::updateMeshPrimitives(Mesh *mesh) {
+    if (nullptr == mCurrentBatch) {
+        osre_error(Tag, "No active batch.");
+        return;
+    }
+
+    if (mesh == nullptr) {
+        osre_error(Tag, "Mesh is nullptr.");
+        return;
+    }
+
+    // The ranges are read at commit time, so one update per mesh and frame is enough
+    if (mCurrentBatch->m_rangeUpdateMeshArray.linearSearch(mesh) == mCurrentBatch->m_rangeUpdateMeshArray.end()) {
+        mCurrentBatch->m_rangeUpdateMeshArray.add(mesh);
+    }
+    mCurrentBatch->m_dirtyFlag |= RenderBatchData::MeshRangeDirty;
+}
+
+void RenderBackendService::updateMeshIndices(Mesh *mesh) {
+    if (nullptr == mCurrentBatch) {
+        osre_error(Tag, "No active batch.");
+        return;
+    }
+
+    if (mesh == nullptr || mesh->getIndexBuffer() == nullptr) {
+        osre_error(Tag, "Mesh is nullptr or has no indices.");
+        return;
+    }
+
+    // The indices are copied at commit time, so one update per mesh and frame is enough
+    if (mCurrentBatch->m_indexUpdateMeshArray.linearSearch(mesh) == mCurrentBatch->m_indexUpdateMeshArray.end()) {
+        mCurrentBatch->m_indexUpdateMeshArray.add(mesh);
+    }
+    mCurrentBatch->m_dirtyFlag |= RenderBatchData::IndexUpdateDirty;
+}
+
+void RenderBackendService::simulateParticles(Mesh *mesh, const GpuParticleParams &params) {
+    if (nullptr == mCurrentBatch) {
+        osre_error(Tag, "No active batch.");
+        return;
+    }
+
+    if (mesh == nullptr) {
+        osre_error(Tag, "Mesh is nullptr.");
+        return;
+    }
+
+    mCurrentBatch->m_particleMeshArray.add(mesh);
+    mCurrentBatch->m_particleParams.add(params);
+    mCurrentBatch->m_dirtyFlag |= RenderBatchData::ParticleSimDirty;
+}
+
+void RenderBackendService::updateTextureLayer(const String &name, const TextureLayerDesc &desc, const f32 *data) {
+    if (nullptr == mCurrentBatch) {
+        osre_error(Tag, "No active batch.");
+        return;
+    }
+
+    if (name.empty() || nullptr == data || desc.Layer >= desc.NumLayers ||
+            desc.X + desc.RegionWidth > desc.Width || desc.Y + desc.RegionHeight > desc.Height) {
+        osre_error(Tag, "Invalid texture layer update.");
+        return;
+    }
+
+    const size_t numTexels = static_cast<size_t>(desc.RegionWidth) * desc.RegionHeight;
+    if (0 == numTexels) {
+        return;
+    }
+
+    TextureLayerUpdate *update = new TextureLayerUpdate;
+    update->Name = name;
+    update->Desc = desc;
+    update->Data.resize(numTexels);
+    ::memcpy(&update->Data[0], data, sizeof(f32) * numTexels);
+    mCurrentBatch->m_textureUpdates.add(update);
+    mCurrentBatch->m_dirtyFlag |= RenderBatchData::TextureUpdateDirty;
+}
+
 bool RenderBackendService::endRenderBatch() {
     if (nullptr == mCurrentBatch) {
         return false;
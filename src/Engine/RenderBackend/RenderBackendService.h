@@ -205,6 +205,10 @@ public:
     /// @param
     void setActivePipeline(Pipeline *pipeline);
 
+    /// @brief  Will return the active pipeline.
+    /// @return The active pipeline or nullptr, if none was set.
+    Pipeline *getActivePipeline() const;
+
     ///	@brief
     /// @param
     ///	@return
@@ -240,12 +244,37 @@ public:
 
     void setMatrixArray(const String &name, ui32 numMat, const glm::mat4 *matrixArray);
 
+    /// @brief Will set an array of vec3 uniforms of the current batch.
+    /// @param[in] name         The uniform name.
+    /// @param[in] numValues    The number of values, must not grow after the first call.
+    /// @param[in] values       The values.
+    void setFloat3Array(const String &name, ui32 numValues, const glm::vec3 *values);
+
     void addMesh(Mesh *geo, ui32 numInstances);
 
     void addMesh(const MeshArray &meshArray, ui32 numInstances);
 
     void updateMesh(Mesh *mesh);
 
+    /// @brief Will update the drawn index ranges of the primitive groups, for instance after switching the level of detail.
+    /// @param[in] mesh     The already added mesh.
+    void updateMeshPrimitives(Mesh *mesh);
+
+    /// @brief Will upload the index buffer of a mesh, for instance after culling its meshlets.
+    /// @param[in] mesh     The already added mesh.
+    void updateMeshIndices(Mesh *mesh);
+
+    /// @brief Will run one simulation step of a particle mesh on the GPU, the vertex buffer keeps the particle state.
+    /// @param[in] mesh     The already added particle mesh, the vertices are render vertices.
+    /// @param[in] params   The simulation step.
+    void simulateParticles(Mesh *mesh, const GpuParticleParams &params);
+
+    /// @brief Will update a rectangle of a float texture array, the texture will be created by the first update.
+    /// @param[in] name     The texture name, materials refer to it by their texture stages.
+    /// @param[in] desc     The texture size and the rectangle.
+    /// @param[in] data     The texels of the rectangle, row by row.
+    void updateTextureLayer(const String &name, const TextureLayerDesc &desc, const f32 *data);
+
     bool endRenderBatch();
 
     bool endPass();
@@ -23,6 +23,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "RenderBackend/RenderCommon.h"
 #include "App/AssetRegistry.h"
 #include "Common/Logger.h"
+#include "IO/IOService.h"
 #include "IO/Uri.h"
 #include "RenderBackend/Mesh.h"
 #include "RenderBackend/Shader.h"
@@ -31,6 +32,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
 namespace OSRE::RenderBackend {
 
 using namespace ::cppcore;
@@ -119,6 +125,62 @@ const String *RenderVert::getAttributes() {
     return RenderVertAttributes;
 }
 
+// List of attributes for compact vertices
+static constexpr ui32 NumCompactVertAttributes = 4;
+
+static const String CompactVertAttributes[NumCompactVertAttributes] = {
+    "position",
+    "normal",
+    "color0",
+    "texcoord0"
+};
+
+CompactVert::CompactVert() :
+        position{ 0, 0, 0, 32767 },
+        normal{ 0, 0 },
+        color0{ 255, 255, 255, 255 },
+        tex0{ 0, 0 } {
+    // empty
+}
+
+size_t CompactVert::getNumAttributes() {
+    return NumCompactVertAttributes;
+}
+
+const String *CompactVert::getAttributes() {
+    return CompactVertAttributes;
+}
+
+// List of attributes for skinned vertices
+static constexpr ui32 NumSkinnedVertAttributes = 6;
+
+static const String SkinnedVertAttributes[NumSkinnedVertAttributes] = {
+    "position",
+    "normal",
+    "color0",
+    "texcoord0",
+    "indices",
+    "weights"
+};
+
+SkinnedVert::SkinnedVert() :
+        position(),
+        normal(),
+        color0(1, 1, 1),
+        tex0(),
+        indices{ 0, 0, 0, 0 },
+        weights(1, 0, 0, 0) {
+    // empty
+}
+
+size_t SkinnedVert::getNumAttributes() {
+    return NumSkinnedVertAttributes;
+}
+
+const String *SkinnedVert::getAttributes() {
+    return SkinnedVertAttributes;
+}
+
 const String &getVertCompName(VertexAttribute attrib) {
     if (attrib > VertexAttribute::Instance3 || attrib == VertexAttribute::Invalid) {
         return ErrorCmpName;
@@ -316,6 +378,21 @@ void Texture::clear() {
     Data = nullptr;
 }
 
+// The images are stored from the top to the bottom, OpenGL expects the bottom row first
+static void flipRows(uc8 *data, i32 width, i32 height, i32 channels) {
+    for (i32 j = 0; j * 2 < height; ++j) {
+        i32 index1 = j * width * channels;
+        i32 index2 = (height - 1 - j) * width * channels;
+        for (i32 i = width * channels; i > 0; --i) {
+            uc8 temp = data[index1];
+            data[index1] = data[index2];
+            data[index2] = temp;
+            ++index1;
+            ++index2;
+        }
+    }
+}
+
 size_t TextureLoader::load(const IO::Uri &uri, Texture *tex) {
     if (nullptr == tex) {
         return 0l;
@@ -326,6 +403,11 @@ size_t TextureLoader::load(const IO::Uri &uri, Texture *tex) {
         tex = TextureLoader::getDefaultTexture();
     }
 
+    // Textures of bundles are read through the io-service and decoded from memory
+    if (uri.getScheme() == "bundle") {
+        return loadFromStream(uri, tex);
+    }
+
     String root = App::AssetRegistry::getPath("media");
     String path = App::AssetRegistry::resolvePathFromUri(uri);
 
@@ -340,24 +422,71 @@ size_t TextureLoader::load(const IO::Uri &uri, Texture *tex) {
     tex->Height = height;
     tex->Channels = channels;
 
-    // swap the texture data
-    for (i32 j = 0; j * 2 < height; ++j) {
-        i32 index1 = j * width * channels;
-        i32 index2 = (height - 1 - j) * width * channels;
-        for (i32 i = width * channels; i > 0; --i) {
-            uc8 temp = tex->Data[index1];
-            tex->Data[index1] = tex->Data[index2];
-            tex->Data[index2] = temp;
-            ++index1;
-            ++index2;
-        }
-    }
+    flipRows(tex->Data, width, height, channels);
 
     const size_t size = width * height * channels;
 
     return size;
 }
 
+size_t TextureLoader::loadFromStream(const IO::Uri &uri, Texture *tex) {
+    IO::IOService *ioService = IO::IOService::getInstance();
+    IO::Stream *stream = nullptr != ioService ? ioService->openStream(uri, IO::Stream::AccessMode::ReadAccessBinary) : nullptr;
+    if (nullptr == stream) {
+        osre_debug(Tag, "Cannot open texture " + uri.getUri());
+        return 0;
+    }
+
+    std::vector<uc8> data(stream->getSize());
+    const size_t numBytes = stream->read(data.data(), data.size());
+    ioService->closeStream(&stream);
+    if (numBytes != data.size()) {
+        osre_debug(Tag, "Cannot read texture " + uri.getUri());
+        return 0;
+    }
+
+    return loadFromMemory(data.data(), data.size(), tex);
+}
+
+size_t TextureLoader::loadFromMemory(const uc8 *data, size_t size, Texture *tex) {
+    if (nullptr == data || 0 == size || nullptr == tex || size > static_cast<size_t>(INT_MAX)) {
+        return 0;
+    }
+
+    i32 width = 0, height = 0, channels = 0;
+    tex->Data = stbi_load_from_memory(data, static_cast<i32>(size), &width, &height, &channels, 0);
+    if (nullptr == tex->Data) {
+        osre_debug(Tag, "Cannot decode texture " + tex->TextureName);
+        return 0;
+    }
+    tex->Width = width;
+    tex->Height = height;
+    tex->Channels = channels;
+    flipRows(tex->Data, width, height, channels);
+
+    return static_cast<size_t>(width) * height * channels;
+}
+
+size_t TextureLoader::loadFromPixels(const uc8 *pixels, ui32 width, ui32 height, ui32 channels, Texture *tex) {
+    if (nullptr == pixels || nullptr == tex || 0 == width || 0 == height || 0 == channels || channels > 4) {
+        return 0;
+    }
+
+    // Allocated like the images of stb_image, so unload can release both
+    const size_t size = static_cast<size_t>(width) * height * channels;
+    tex->Data = static_cast<uc8 *>(::malloc(size));
+    if (nullptr == tex->Data) {
+        return 0;
+    }
+    ::memcpy(tex->Data, pixels, size);
+    tex->Width = width;
+    tex->Height = height;
+    tex->Channels = channels;
+    flipRows(tex->Data, static_cast<i32>(width), static_cast<i32>(height), static_cast<i32>(channels));
+
+    return size;
+}
+
 static Texture *DefaultTexture = nullptr;
 
 Texture *TextureLoader::getDefaultTexture() {
@@ -457,6 +586,47 @@ ResourceState TextureResource::onLoad(const IO::Uri &uri, TextureLoader &loader)
     return getState();
 }
 
+ResourceState TextureResource::loadFromMemory(const uc8 *data, size_t size, TextureLoader &loader) {
+    if (getState() == ResourceState::Loaded) {
+        return getState();
+    }
+
+    Texture *tex = create(getName());
+    if (nullptr == tex) {
+        return ResourceState::Error;
+    }
+
+    return finishLoad(tex, loader.loadFromMemory(data, size, tex), "memory");
+}
+
+ResourceState TextureResource::loadFromPixels(const uc8 *pixels, ui32 width, ui32 height, ui32 channels, TextureLoader &loader) {
+    if (getState() == ResourceState::Loaded) {
+        return getState();
+    }
+
+    Texture *tex = create(getName());
+    if (nullptr == tex) {
+        return ResourceState::Error;
+    }
+
+    return finishLoad(tex, loader.loadFromPixels(pixels, width, height, channels, tex), "pixels");
+}
+
+ResourceState TextureResource::finishLoad(Texture *tex, size_t size, const String &source) {
+    tex->TextureName = getName();
+    tex->TargetType = m_targetType;
+    getStats().m_memory = size;
+    if (0 == size) {
+        setState(ResourceState::Error);
+        osre_debug(Tag, "Cannot load texture " + getName() + " from " + source);
+        return getState();
+    }
+
+    setState(ResourceState::Loaded);
+
+    return getState();
+}
+
 ResourceState TextureResource::onUnload(TextureLoader &loader) {
     if (getState() == ResourceState::Unloaded) {
         return getState();
@@ -578,7 +748,7 @@ RenderBatchData *PassData::getBatchById(const c8 *id) const {
     }
 
     for (ui32 i = 0; i < mMeshBatches.size(); ++i) {
-        if (0 == strncmp(mMeshBatches[i]->m_id, id, strlen(id))) {
+        if (0 == strcmp(mMeshBatches[i]->m_id, id)) {
             return mMeshBatches[i];
         }
     }
@@ -662,6 +832,18 @@ UniformDataBlob *UniformDataBlob::create(ParameterType type, size_t arraySize) {
         case ParameterType::PT_Mat4:
             blob->m_size = sizeof(f32) * 16;
             break;
+        case ParameterType::PT_IntArray:
+            blob->m_size = sizeof(i32) * arraySize;
+            break;
+        case ParameterType::PT_FloatArray:
+            blob->m_size = sizeof(f32) * arraySize;
+            break;
+        case ParameterType::PT_Float2Array:
+            blob->m_size = sizeof(f32) * 2 * arraySize;
+            break;
+        case ParameterType::PT_Float3Array:
+            blob->m_size = sizeof(f32) * 3 * arraySize;
+            break;
         case ParameterType::PT_Mat4Array:
             blob->m_size = sizeof(f32) * 16 * arraySize;
             break;
@@ -701,6 +883,18 @@ ui32 UniformVar::getParamDataSize(ParameterType type, ui32 arraySize) {
         case ParameterType::PT_Mat4:
             size = sizeof(f32) * 16;
             break;
+        case ParameterType::PT_IntArray:
+            size = sizeof(i32) * arraySize;
+            break;
+        case ParameterType::PT_FloatArray:
+            size = sizeof(f32) * arraySize;
+            break;
+        case ParameterType::PT_Float2Array:
+            size = sizeof(f32) * 2 * arraySize;
+            break;
+        case ParameterType::PT_Float3Array:
+            size = sizeof(f32) * 3 * arraySize;
+            break;
         case ParameterType::PT_Mat4Array:
             size = sizeof(f32) * 16 * arraySize;
             break;
@@ -55,6 +55,21 @@ static constexpr i32 UnsetHandle = -1;
 /// @brief Upper limits for names.
 static constexpr ui32 MaxEntNameLen = 256;
 
+/// The max. number of joints in a skinning palette.
+static constexpr ui32 MaxSkinningJoints = 64;
+
+/// The uniform name of the skinning palette.
+static constexpr c8 SkinPaletteName[] = "SkinPalette";
+
+/// The max. number of levels of a geometry clipmap.
+static constexpr ui32 MaxClipmapLevels = 8;
+
+/// The uniform name of the clipmap level windows.
+static constexpr c8 ClipmapLevelsName[] = "ClipmapLevels";
+
+/// The max. number of joints, which can influence one vertex.
+static constexpr ui32 MaxJointsPerVertex = 4;
+
 ///	@brief  This enum describes the usage of a GPU-buffer-object.
 ///
 /// Buffer objects are used to store vertex-, index- or image data on the GPU-memory
@@ -90,6 +105,8 @@ enum class VertexType {
     Invalid = -1,       ///< Marker for an invalid data type.
     ColorVertex = 0,    ///< A simple vertex consisting of position and color.
     RenderVertex,       ///< A render vertex with position, color, normals and texture coordinates.
+    SkinnedVertex,      ///< A render vertex with additional joint indices and weights for skinning.
+    CompactVertex,      ///< A quantized render vertex, the positions will be dequantized by the mesh.
     Count               ///< Number of enums.
 };
 
@@ -99,6 +116,7 @@ enum class TextureTargetType {
     Texture1D = 0,  ///< 1D-textures, used for simple arrays in shaders.
     Texture2D,      ///< 2D-textures, used for images and render targets.
     Texture3D,      ///< 3D-textures, used for volume rendering.
+    Texture2DArray, ///< Arrays of 2D-textures, addressed by layer in shaders.
     Count           ///< Number of enums.
 };
 
@@ -217,6 +235,13 @@ enum class VertexFormat : int {
     UByte4,         ///< 4-component float (0.0f..255.0f) mapped to byte (0..255)
     Short2,         ///< 2-component float (-32768.0f..+32767.0f) mapped to short (-32768..+32768)
     Short4,         ///< 4-component float (-32768.0f..+32767.0f) mapped to short (-32768..+32768)
+    Half2,          ///< 2-component half float
+    Half4,          ///< 4-component half float
+    UByte4Norm,     ///< 4-component normalized unsigned byte (0..255), expanded to (0.0f..1.0f)
+    Short2Norm,     ///< 2-component normalized short (-32767..+32767), expanded to (-1.0f..+1.0f)
+    Short4Norm,     ///< 4-component normalized short (-32767..+32767), expanded to (-1.0f..+1.0f)
+    UByte4Int,      ///< 4-component unsigned byte, passed as integers to the shader
+    Int,            ///< single component int, passed as integer to the shader
     Count           ///< Number of enums.
 };
 
@@ -263,6 +288,45 @@ struct OSRE_EXPORT RenderVert {
     static const String *getAttributes();
 };
 
+/// @brief  This struct declares a compact render vertex, which needs 20 bytes instead of 44.
+///
+/// The position is quantized into the bounds of the mesh, which will be restored by the
+/// dequantization of the mesh. The normal is stored in octahedral encoding.
+struct OSRE_EXPORT CompactVert {
+    i16 position[4];    ///< The quantized position ( x|y|z|1 ) as snorm16
+    i16 normal[2];      ///< The octahedral encoded normal as snorm16
+    uc8 color0[4];      ///< The diffuse color ( r|g|b|a ) as unorm8
+    ui16 tex0[2];       ///< The texture coordinate ( u|v ) as half float
+
+    /// @brief The class constructor
+    CompactVert();
+
+    /// @brief  Returns the number of attributes.
+    static size_t getNumAttributes();
+
+    /// @brief  Returns the attribute array.
+    static const String *getAttributes();
+};
+
+/// @brief  This struct declares a render vertex for skinned geometry.
+struct OSRE_EXPORT SkinnedVert {
+    glm::vec3 position;                 ///< The position ( x|y|z )
+    glm::vec3 normal;                   ///< The normal vector ( x|y|z )
+    glm::vec3 color0;                   ///< The diffuse color ( r|g|b )
+    glm::vec2 tex0;                     ///< The texture coordinate ( u|v )
+    uc8 indices[MaxJointsPerVertex];    ///< The joint indices into the skinning palette
+    glm::vec4 weights;                  ///< The joint weights, sum up to one
+
+    /// @brief The class constructor
+    SkinnedVert();
+
+    /// @brief  Returns the number of attributes.
+    static size_t getNumAttributes();
+
+    /// @brief  Returns the attribute array.
+    static const String *getAttributes();
+};
+
 OSRE_EXPORT const String &getVertCompName(VertexAttribute attrib);
 
 struct OSRE_EXPORT UIVert {
@@ -307,6 +371,25 @@ inline size_t getVertexFormatSize(VertexFormat format) {
         case VertexFormat::Short4:
             size = sizeof(ui16) * 4;
             break;
+        case VertexFormat::Half2:
+            size = sizeof(ui16) * 2;
+            break;
+        case VertexFormat::Half4:
+            size = sizeof(ui16) * 4;
+            break;
+        case VertexFormat::UByte4Norm:
+        case VertexFormat::UByte4Int:
+            size = sizeof(uc8) * 4;
+            break;
+        case VertexFormat::Short2Norm:
+            size = sizeof(i16) * 2;
+            break;
+        case VertexFormat::Short4Norm:
+            size = sizeof(i16) * 4;
+            break;
+        case VertexFormat::Int:
+            size = sizeof(i32);
+            break;
         case VertexFormat::Count:
         case VertexFormat::Invalid:
             break;
@@ -440,6 +523,28 @@ public:
     TextureLoader() = default;
     ~TextureLoader() = default;
     size_t load(const IO::Uri &uri, Texture *tex);
+
+    /// @brief Will read an encoded image through the io-service and decode it, used for bundles.
+    /// @param[in] uri      The uri of the image.
+    /// @param[out] tex     The texture to fill.
+    /// @return The size of the decoded pixels in bytes, 0 in case of an error.
+    size_t loadFromStream(const IO::Uri &uri, Texture *tex);
+
+    /// @brief Will decode a compressed image from memory, like an image embedded in a model file.
+    /// @param[in] data     The encoded image, all formats of stb_image are supported.
+    /// @param[in] size     The size of the encoded image in bytes.
+    /// @param[out] tex     The texture to fill.
+    /// @return The size of the decoded pixels in bytes, 0 in case of an error.
+    size_t loadFromMemory(const uc8 *data, size_t size, Texture *tex);
+
+    /// @brief Will copy uncompressed pixels, the rows are stored from the top to the bottom.
+    /// @param[in] pixels   The pixels.
+    /// @param[in] width    The width in pixels.
+    /// @param[in] height   The height in pixels.
+    /// @param[in] channels The number of channels per pixel.
+    /// @param[out] tex     The texture to fill.
+    /// @return The size of the pixels in bytes, 0 in case of an error.
+    size_t loadFromPixels(const uc8 *pixels, ui32 width, ui32 height, ui32 channels, Texture *tex);
     bool unload(Texture *tex);
     static Texture *getDefaultTexture();
     static void releaseDefaultTexture();
@@ -455,10 +560,29 @@ public:
     void setTextureStage(TextureStageType stage);
     TextureStageType setTextureStage() const;
 
+    /// @brief Will load the texture from an encoded image in memory instead of its uri.
+    /// @param[in] data     The encoded image.
+    /// @param[in] size     The size of the encoded image in bytes.
+    /// @param[in] loader   The texture loader.
+    /// @return The new state.
+    Common::ResourceState loadFromMemory(const uc8 *data, size_t size, TextureLoader &loader);
+
+    /// @brief Will load the texture from uncompressed pixels instead of its uri.
+    /// @param[in] pixels   The pixels, the rows are stored from the top to the bottom.
+    /// @param[in] width    The width in pixels.
+    /// @param[in] height   The height in pixels.
+    /// @param[in] channels The number of channels per pixel.
+    /// @param[in] loader   The texture loader.
+    /// @return The new state.
+    Common::ResourceState loadFromPixels(const uc8 *pixels, ui32 width, ui32 height, ui32 channels, TextureLoader &loader);
+
 protected:
     Common::ResourceState onLoad(const IO::Uri &uri, TextureLoader &loader) override;
     Common::ResourceState onUnload(TextureLoader &loader) override;
 
+private:
+    Common::ResourceState finishLoad(Texture *tex, size_t size, const String &source);
+
 private:
     TextureTargetType m_targetType;
     TextureStageType m_stage;
@@ -674,6 +798,67 @@ struct MatrixBuffer {
     ~MatrixBuffer() = default;
 };
 
+/// @brief  Describes one simulation step of a particle system, which lives on the GPU.
+///
+/// The particles are stored as render vertices: the normal holds the velocity and the texture
+/// coordinate holds the age and the lifetime, a particle is dead when its age reached the lifetime.
+/// The particles in the ring window [EmitStart, EmitStart + EmitCount) will be respawned.
+struct GpuParticleParams {
+    glm::vec3 Gravity;      ///< The acceleration.
+    f32 DeltaTime;          ///< The time step in seconds.
+    glm::vec3 SpawnMin;     ///< The minimum of the spawn box.
+    glm::vec3 SpawnMax;     ///< The maximum of the spawn box.
+    glm::vec3 VelocityMin;  ///< The minimal start velocity per axis.
+    glm::vec3 VelocityMax;  ///< The maximal start velocity per axis.
+    glm::vec3 ColorMin;     ///< The minimal color per channel.
+    glm::vec3 ColorMax;     ///< The maximal color per channel.
+    f32 LifetimeMin;        ///< The minimal lifetime in seconds.
+    f32 LifetimeMax;        ///< The maximal lifetime in seconds.
+    glm::vec3 BoundsMin;    ///< The minimum of the bounds.
+    glm::vec3 BoundsMax;    ///< The maximum of the bounds.
+    ui32 UseBounds;         ///< Particles leaving the bounds will be killed when not zero.
+    ui32 Capacity;          ///< The number of particles in the vertex buffer.
+    ui32 EmitStart;         ///< The first particle to respawn.
+    ui32 EmitCount;         ///< The number of particles to respawn.
+    ui32 Seed;              ///< The random seed for this step.
+
+    /// @brief The class constructor.
+    GpuParticleParams() :
+            Gravity(0.0f), DeltaTime(0.0f), SpawnMin(0.0f), SpawnMax(0.0f), VelocityMin(0.0f), VelocityMax(0.0f),
+            ColorMin(1.0f), ColorMax(1.0f), LifetimeMin(0.0f), LifetimeMax(0.0f), BoundsMin(0.0f), BoundsMax(0.0f),
+            UseBounds(0u), Capacity(0u), EmitStart(0u), EmitCount(0u), Seed(0u) {
+        // empty
+    }
+};
+
+/// @brief  Describes the update of a rectangle in one layer of a float texture array.
+///
+/// The texture stores one float per texel and will be created by the first update, so all
+/// updates of a texture must use the same size.
+struct TextureLayerDesc {
+    ui32 Width;         ///< The width of the texture.
+    ui32 Height;        ///< The height of the texture.
+    ui32 NumLayers;     ///< The number of layers of the texture.
+    ui32 Layer;         ///< The layer to update.
+    ui32 X;             ///< The first column of the rectangle.
+    ui32 Y;             ///< The first row of the rectangle.
+    ui32 RegionWidth;   ///< The width of the rectangle.
+    ui32 RegionHeight;  ///< The height of the rectangle.
+
+    /// @brief The class constructor.
+    TextureLayerDesc() :
+            Width(0u), Height(0u), NumLayers(0u), Layer(0u), X(0u), Y(0u), RegionWidth(0u), RegionHeight(0u) {
+        // empty
+    }
+};
+
+/// @brief  A pending texture layer update, the texels are stored row by row.
+struct TextureLayerUpdate {
+    String Name;
+    TextureLayerDesc Desc;
+    cppcore::TArray<f32> Data;
+};
+
 /// @brief 
 struct MeshEntry {
     ui32 numInstances;
@@ -691,7 +876,11 @@ struct RenderBatchData {
         MatrixBufferDirty = 1,  ///< The matrix buffer is dirty.
         UniformBufferDirty = 2, ///< The uniform buffer is dirty.
         MeshDirty = 4,          ///< The mesh is dirty.
-        MeshUpdateDirty = 8     ///< The mesh is updated.
+        MeshUpdateDirty = 8,    ///< The mesh is updated.
+        MeshRangeDirty = 16,    ///< The index ranges of the primitive groups have changed.
+        ParticleSimDirty = 32,  ///< A particle simulation step was requested.
+        TextureUpdateDirty = 64,///< Texture data was updated.
+        IndexUpdateDirty = 128  ///< The indices of a mesh are updated.
     };
 
     const c8 *m_id;
@@ -699,6 +888,11 @@ struct RenderBatchData {
     cppcore::TArray<UniformVar *> m_uniforms;
     cppcore::TArray<MeshEntry *> m_meshArray;
     MeshArray m_updateMeshArray;
+    MeshArray m_rangeUpdateMeshArray;
+    MeshArray m_indexUpdateMeshArray;
+    MeshArray m_particleMeshArray;
+    cppcore::TArray<GpuParticleParams> m_particleParams;
+    cppcore::TArray<TextureLayerUpdate *> m_textureUpdates;
     ui32 m_dirtyFlag;
 
     /// @brief  The class constructor
@@ -709,6 +903,11 @@ struct RenderBatchData {
             m_uniforms(),
             m_meshArray(),
             m_updateMeshArray(),
+            m_rangeUpdateMeshArray(),
+            m_indexUpdateMeshArray(),
+            m_particleMeshArray(),
+            m_particleParams(),
+            m_textureUpdates(),
             m_dirtyFlag(0) {
         osre_assert(id != nullptr);
     }
@@ -792,7 +991,11 @@ struct FrameSubmitCmd {
         UpdateBuffer = 2,
         UpdateMatrixes = 4,
         UpdateUniforms = 8,
-        AddRenderData = 16
+        AddRenderData = 16,
+        UpdatePrimitives = 32,
+        SimulateParticles = 64,
+        UpdateTexture = 128,
+        UpdateIndexBuffer = 256
     };
 
     guid m_meshId;
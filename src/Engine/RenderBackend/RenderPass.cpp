@@ -27,13 +27,15 @@ namespace Details {
 static const c8 *RenderPassNames[] = {
     "RenderPass",
     "2D",
-    "DbgPass"
+    "DbgPass",
+    "OcclusionPass"
 };
 
 static void initRenderPasses(guid framebufferId) {
     RenderPassFactory::registerPass(RenderPassId, new RenderPass(RenderPassId, framebufferId, nullptr));
     RenderPassFactory::registerPass(UiPassId, RenderPass2D::build(UiPassId, framebufferId));
     RenderPassFactory::registerPass(DbgPassId, new RenderPass(DbgPassId, framebufferId, nullptr));
+    RenderPassFactory::registerPass(OcclusionPassId, new RenderPass(OcclusionPassId, framebufferId, nullptr));
 }
 
 } // Namespace Details
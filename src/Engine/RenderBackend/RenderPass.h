@@ -50,7 +50,8 @@ private:
 static constexpr ui32 RenderPassId = 0;
 static constexpr ui32 UiPassId = 1;
 static constexpr ui32 DbgPassId = 2;
-static constexpr ui32 MaxDbgPasses = 3;
+static constexpr ui32 OcclusionPassId = 3;
+static constexpr ui32 MaxDbgPasses = 4;
 
 //-------------------------------------------------------------------------------------------------
 ///	@ingroup	Engine
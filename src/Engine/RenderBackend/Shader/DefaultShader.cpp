@@ -21,6 +21,7 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "RenderBackend/Shader/DefaultShader.h"
+#include "RenderBackend/RenderCommon.h"
 
 namespace OSRE::RenderBackend {
 
@@ -66,6 +67,51 @@ String getGLSLColorVertexLayout() {
     return GLSLColorVertexLayout;
 }
 
+String getGLSLSkinnedVertexLayout() {
+    static const String GLSLSkinnedVertexLayout =
+            "// SkinnedVertex layout\n"
+            "layout(location = 0) in vec3 position;	  // object space vertex position\n"
+            "layout(location = 1) in vec3 normal;	  // object space vertex normal\n"
+            "layout(location = 2) in vec3 color0;     // per-vertex diffuse colour\n"
+            "layout(location = 3) in vec2 texcoord0;  // per-vertex tex coord, stage 0\n"
+            "layout(location = 4) in vec4 indices;    // joint indices into the skinning palette\n"
+            "layout(location = 5) in vec4 weights;    // joint weights\n" +
+            getNewLine();
+    return GLSLSkinnedVertexLayout;
+}
+
+String getGLSLCompactVertexLayout() {
+    static const String GLSLCompactVertexLayout =
+            "// CompactVertex layout\n"
+            "layout(location = 0) in vec4 position;   // quantized position, dequantized by the model matrix\n"
+            "layout(location = 1) in vec2 normal;     // octahedral encoded normal\n"
+            "layout(location = 2) in vec4 color0;     // per-vertex diffuse colour\n"
+            "layout(location = 3) in vec2 texcoord0;  // per-vertex tex coord, stage 0\n" +
+            getNewLine() +
+            "vec3 decodeNormal(vec2 e) {\n"
+            "    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));\n"
+            "    float t = max(-n.z, 0.0);\n"
+            "    n.x += n.x >= 0.0 ? -t : t;\n"
+            "    n.y += n.y >= 0.0 ? -t : t;\n"
+            "    return normalize(n);\n"
+            "}\n" +
+            getNewLine();
+    return GLSLCompactVertexLayout;
+}
+
+String getGLSLSkinningSrc() {
+    static const String GLSLSkinningSrc =
+            "// skinning\n"
+            "uniform mat4 " + String(SkinPaletteName) + "[" + std::to_string(MaxSkinningJoints) + "];\n"
+            "mat4 getSkinMatrix() {\n"
+            "    return " + String(SkinPaletteName) + "[int(indices.x)] * weights.x +\n"
+            "           " + String(SkinPaletteName) + "[int(indices.y)] * weights.y +\n"
+            "           " + String(SkinPaletteName) + "[int(indices.z)] * weights.z +\n"
+            "           " + String(SkinPaletteName) + "[int(indices.w)] * weights.w;\n"
+            "}\n";
+    return GLSLSkinningSrc;
+}
+
 String getGLSLCombinedMVPUniformSrc() {
     static const String GLSLCombinedMVPUniformSrc =
             "// uniforms\n"
@@ -34,6 +34,9 @@ String getGLSLVersionString_400();
 String getNewLine();
 String getGLSLRenderVertexLayout();
 String getGLSLColorVertexLayout();
+String getGLSLSkinnedVertexLayout();
+String getGLSLCompactVertexLayout();
+String getGLSLSkinningSrc();
 String getGLSLCombinedMVPUniformSrc();
 
 struct DefaultShader {
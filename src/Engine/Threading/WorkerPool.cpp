@@ -0,0 +1,136 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Threading/WorkerPool.h"
+
+namespace OSRE {
+namespace Threading {
+
+WorkerPool::WorkerPool(size_t numWorkers) :
+        mThreads(),
+        mMutex(),
+        mWakeup(),
+        mDone(),
+        mFunc(nullptr),
+        mCount(0),
+        mGrainSize(1),
+        mNextChunk(0),
+        mNumPending(0),
+        mGeneration(0),
+        mShutdown(false) {
+    if (numWorkers == 0) {
+        const size_t numCores = std::thread::hardware_concurrency();
+        numWorkers = numCores > 1 ? numCores - 1 : 0;
+    }
+
+    mThreads.reserve(numWorkers);
+    for (size_t i = 0; i < numWorkers; ++i) {
+        mThreads.emplace_back(&WorkerPool::run, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mShutdown = true;
+    }
+    mWakeup.notify_all();
+    for (std::thread &thread : mThreads) {
+        thread.join();
+    }
+}
+
+void WorkerPool::parallelFor(size_t count, size_t grainSize, const RangeFunc &func) {
+    if (count == 0) {
+        return;
+    }
+
+    if (grainSize == 0) {
+        grainSize = 1;
+    }
+
+    // Small loops are not worth waking up anybody
+    if (mThreads.empty() || count <= grainSize) {
+        func(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mFunc = &func;
+        mCount = count;
+        mGrainSize = grainSize;
+        mNextChunk.store(0);
+        mNumPending = mThreads.size();
+        ++mGeneration;
+    }
+    mWakeup.notify_all();
+
+    processChunks();
+
+    // Every worker must have left the job before the function goes out of scope
+    std::unique_lock<std::mutex> lock(mMutex);
+    mDone.wait(lock, [this]() {
+        return mNumPending == 0;
+    });
+    mFunc = nullptr;
+}
+
+WorkerPool &WorkerPool::getInstance() {
+    static WorkerPool pool;
+    return pool;
+}
+
+void WorkerPool::run() {
+    ui64 generation = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeup.wait(lock, [this, generation]() {
+                return mShutdown || mGeneration != generation;
+            });
+            if (mShutdown) {
+                return;
+            }
+            generation = mGeneration;
+        }
+
+        processChunks();
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (--mNumPending == 0) {
+            mDone.notify_one();
+        }
+    }
+}
+
+void WorkerPool::processChunks() {
+    const size_t numChunks = (mCount + mGrainSize - 1) / mGrainSize;
+    for (size_t chunk = mNextChunk.fetch_add(1); chunk < numChunks; chunk = mNextChunk.fetch_add(1)) {
+        const size_t begin = chunk * mGrainSize;
+        const size_t end = begin + mGrainSize < mCount ? begin + mGrainSize : mCount;
+        (*mFunc)(begin, end);
+    }
+}
+
+} // Namespace Threading
+} // Namespace OSRE
@@ -0,0 +1,100 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OSRE {
+namespace Threading {
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	Infrastructure
+///
+///	@brief	This class implements a pool of worker threads for data-parallel loops.
+///
+/// The workers will be started once and sleep between the jobs. A loop will be split into chunks,
+/// the calling thread works on the chunks as well and returns when all of them are done. So the
+/// function must be safe to call for disjoint ranges at the same time. Only one loop can run at a
+/// time, loops must not be nested.
+//-------------------------------------------------------------------------------------------------
+class OSRE_EXPORT WorkerPool {
+public:
+    /// @brief The range callback, will get the first and the last + 1 index of the chunk.
+    using RangeFunc = std::function<void(size_t begin, size_t end)>;
+
+    /// @brief  The class constructor.
+    /// @param[in] numWorkers   The number of worker threads, 0 for one per core minus the caller.
+    explicit WorkerPool(size_t numWorkers = 0);
+
+    /// @brief  The class destructor, will stop all workers.
+    ~WorkerPool();
+
+    /// @brief  Will return the number of worker threads.
+    /// @return The number of workers, the calling thread is not included.
+    size_t getNumWorkers() const;
+
+    /// @brief  Will run the function for all indices in [0, count).
+    /// @param[in] count        The number of items.
+    /// @param[in] grainSize    The minimal number of items per chunk.
+    /// @param[in] func         The function to call for each chunk.
+    void parallelFor(size_t count, size_t grainSize, const RangeFunc &func);
+
+    /// @brief  Will return the shared pool instance.
+    /// @return The shared pool.
+    static WorkerPool &getInstance();
+
+    // No copying
+    WorkerPool(const WorkerPool &) = delete;
+    WorkerPool &operator = (const WorkerPool &) = delete;
+
+private:
+    void run();
+    void processChunks();
+
+private:
+    std::vector<std::thread> mThreads;
+    std::mutex mMutex;
+    std::condition_variable mWakeup;
+    std::condition_variable mDone;
+    const RangeFunc *mFunc;
+    size_t mCount;
+    size_t mGrainSize;
+    std::atomic<size_t> mNextChunk;
+    size_t mNumPending;
+    ui64 mGeneration;
+    bool mShutdown;
+};
+
+inline size_t WorkerPool::getNumWorkers() const {
+    return mThreads.size();
+}
+
+} // Namespace Threading
+} // Namespace OSRE
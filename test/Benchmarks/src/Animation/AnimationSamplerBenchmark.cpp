@@ -0,0 +1,112 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmarks.h"
+#include "Animation/AnimationSampler.h"
+#include "Common/Logger.h"
+
+#include <vector>
+
+using namespace ::OSRE;
+using namespace ::OSRE::Animation;
+using namespace ::OSRE::Benchmark;
+
+DECL_OSRE_LOG_MODULE(AnimationSamplerBenchmark)
+
+namespace {
+
+// A long recorded track, one key per tick
+constexpr size_t NumKeys = 50000;
+constexpr d32 FrameStep = 0.25;
+constexpr size_t NumSeeks = 200000;
+constexpr size_t NumRuns = 5;
+
+void createChannel(AnimationChannel &channel) {
+    channel.PositionKeys.resize(NumKeys);
+    channel.RotationKeys.resize(NumKeys);
+    channel.ScalingKeys.resize(NumKeys);
+    for (size_t i = 0; i < NumKeys; ++i) {
+        const f32 time = static_cast<f32>(i);
+        channel.PositionKeys[i].Time = time;
+        channel.PositionKeys[i].Value = glm::vec3(time, 0.0f, 0.0f);
+        channel.RotationKeys[i].Time = time;
+        channel.RotationKeys[i].Quad = glm::angleAxis(time * 0.01f, glm::vec3(0.0f, 1.0f, 0.0f));
+        channel.ScalingKeys[i].Time = time;
+        channel.ScalingKeys[i].Scale = glm::vec3(1.0f + time * 0.001f);
+    }
+}
+
+} // namespace
+
+namespace OSRE::Benchmark {
+
+f32 runAnimationSamplerBenchmark() {
+    AnimationChannel channel;
+    createChannel(channel);
+    const d32 duration = static_cast<d32>(NumKeys - 1);
+    const size_t numFrames = static_cast<size_t>(duration / FrameStep);
+
+    // Random jumps, every one misses the cached keys
+    std::vector<d32> seekTimes(NumSeeks);
+    for (size_t i = 0; i < NumSeeks; ++i) {
+        seekTimes[i] = static_cast<d32>((i * 7919) % NumKeys) + 0.5;
+    }
+
+    glm::vec3 position, scale;
+    glm::quat rotation;
+    f32 checksum = 0.0f;
+
+    // Playback with the cursor kept from the last frame
+    const long long cachedTime = measure(NumRuns, [&]() {
+        KeyCursor cursor;
+        for (size_t frame = 0; frame < numFrames; ++frame) {
+            AnimationSampler::sample(channel, static_cast<d32>(frame) * FrameStep, cursor, RotationBlendMode::Nlerp, position, rotation, scale);
+        }
+        checksum += position.x;
+    });
+
+    // The same playback, every frame has to search its keys
+    const long long searchTime = measure(NumRuns, [&]() {
+        KeyCursor cursor;
+        for (size_t frame = 0; frame < numFrames; ++frame) {
+            cursor.reset();
+            AnimationSampler::sample(channel, static_cast<d32>(frame) * FrameStep, cursor, RotationBlendMode::Nlerp, position, rotation, scale);
+        }
+        checksum += position.x;
+    });
+
+    const long long seekTime = measure(NumRuns, [&]() {
+        KeyCursor cursor;
+        for (d32 time : seekTimes) {
+            AnimationSampler::sample(channel, time, cursor, RotationBlendMode::Nlerp, position, rotation, scale);
+        }
+        checksum += position.x;
+    });
+
+    osre_info(Tag, std::to_string(NumKeys) + " keys: play " + std::to_string(numFrames) + " frames cached " +
+            std::to_string(cachedTime) + " us, binary search " + std::to_string(searchTime) + " us, " +
+            std::to_string(NumSeeks) + " seeks " + std::to_string(seekTime) + " us (" + std::to_string(NumRuns) + " runs)");
+
+    return checksum;
+}
+
+} // namespace OSRE::Benchmark
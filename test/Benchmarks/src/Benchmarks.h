@@ -0,0 +1,54 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+
+#include <chrono>
+
+namespace OSRE {
+namespace Benchmark {
+
+/// @brief Will run a function several times and measure the time.
+/// @param[in] numRuns  The number of runs.
+/// @param[in] func     The function to measure.
+/// @return The time of all runs in microseconds.
+template <class TFunc>
+long long measure(size_t numRuns, TFunc func) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (size_t run = 0; run < numRuns; ++run) {
+        func();
+    }
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+/// @brief Will run the batch math kernels at all supported instruction set levels.
+/// @return A checksum of the results, keeps them alive.
+f32 runBatchMathBenchmark();
+
+/// @brief Will play and seek a long animation track with and without the cached key cursor.
+/// @return A checksum of the results, keeps them alive.
+f32 runAnimationSamplerBenchmark();
+
+} // namespace Benchmark
+} // namespace OSRE
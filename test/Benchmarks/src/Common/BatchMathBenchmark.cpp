@@ -0,0 +1,145 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "Benchmarks.h"
+#include "Common/BatchMath.h"
+#include "Common/Logger.h"
+
+#include <vector>
+
+using namespace ::OSRE;
+using namespace ::OSRE::Common;
+using namespace ::OSRE::Benchmark;
+
+DECL_OSRE_LOG_MODULE(BatchMathBenchmark)
+
+namespace {
+
+constexpr size_t NumMatrices = 20000;
+constexpr size_t NumVertices = 200000;
+constexpr size_t NumRuns = 20;
+
+// Interleaved like a vertex, the position is followed by two other floats
+struct Vertex {
+    f32 Pos[3];
+    f32 Pad[2];
+};
+
+// The attribute streams of an imported mesh
+struct MeshStreams {
+    std::vector<f32> Positions;
+    std::vector<f32> Normals;
+    std::vector<f32> TexCoords;
+};
+
+MeshStreams createStreams(size_t count) {
+    MeshStreams streams;
+    streams.Positions.resize(count * 3);
+    streams.Normals.resize(count * 3);
+    streams.TexCoords.resize(count * 3);
+    for (size_t i = 0; i < count * 3; ++i) {
+        const f32 t = static_cast<f32>(i);
+        streams.Positions[i] = t * 0.01f;
+        streams.Normals[i] = 1.0f - t * 0.001f;
+        streams.TexCoords[i] = t * 0.002f;
+    }
+    return streams;
+}
+
+glm::mat4 createMatrix(f32 seed) {
+    glm::mat4 m(1.0f);
+    for (glm::length_t col = 0; col < 4; ++col) {
+        for (glm::length_t row = 0; row < 4; ++row) {
+            m[col][row] = seed + static_cast<f32>(col * 4 + row) * 0.25f - 2.0f;
+        }
+    }
+    return m;
+}
+
+std::vector<Vertex> createVertices(size_t count) {
+    std::vector<Vertex> vertices(count);
+    for (size_t i = 0; i < count; ++i) {
+        const f32 t = static_cast<f32>(i);
+        vertices[i].Pos[0] = (static_cast<f32>((i * 7919) % 1000) - 500.0f) * 0.1f;
+        vertices[i].Pos[1] = t * 0.5f - 3.0f;
+        vertices[i].Pos[2] = -t;
+        vertices[i].Pad[0] = vertices[i].Pad[1] = 12345.0f;
+    }
+    return vertices;
+}
+
+} // namespace
+
+namespace OSRE::Benchmark {
+
+f32 runBatchMathBenchmark() {
+    std::vector<glm::mat4> lhs(NumMatrices, createMatrix(0.5f)), rhs(NumMatrices, createMatrix(-1.0f)), result(NumMatrices);
+    std::vector<Vertex> vertices = createVertices(NumVertices), transformed(NumVertices);
+    const glm::mat4 m = createMatrix(0.1f);
+
+    // Interleaved into render vertices ( 11 floats ), the texture coordinates have three components
+    const MeshStreams meshStreams = createStreams(NumVertices);
+    const f32 defaultColor[3] = { 0.5f, 0.5f, 0.5f };
+    VertexStreams streams;
+    streams.Positions = meshStreams.Positions.data();
+    streams.Normals = meshStreams.Normals.data();
+    streams.Colors = defaultColor;
+    streams.ColorStride = 0;
+    streams.TexCoords = meshStreams.TexCoords.data();
+    streams.TexCoordStride = 3 * sizeof(f32);
+    std::vector<f32> renderVertices(NumVertices * 11);
+
+    // Every kernel runs at all supported instruction set levels
+    f32 checksum = 0.0f;
+    for (i32 i = 0; i <= static_cast<i32>(BatchMath::getSupportedLevel()); ++i) {
+        const SimdLevel level = static_cast<SimdLevel>(i);
+        BatchMath::setActiveLevel(level);
+        const long long matTime = measure(NumRuns, [&]() {
+            BatchMath::multiplyMatrices(lhs.data(), rhs.data(), result.data(), NumMatrices);
+        });
+        const long long transformTime = measure(NumRuns, [&]() {
+            BatchMath::transformPoints(m, vertices[0].Pos, sizeof(Vertex), transformed[0].Pos, sizeof(Vertex), NumVertices);
+        });
+        glm::vec3 min, max;
+        const long long boundsTime = measure(NumRuns, [&]() {
+            BatchMath::computeBounds(vertices[0].Pos, sizeof(Vertex), NumVertices, min, max);
+        });
+        const long long mapTime = measure(NumRuns, [&]() {
+            BatchMath::mapToClipSpace(transformed[0].Pos, sizeof(Vertex), NumVertices, 1024.0f, 768.0f);
+        });
+        const long long interleaveTime = measure(NumRuns, [&]() {
+            BatchMath::interleaveVertices(streams, renderVertices.data(), 11 * sizeof(f32), NumVertices);
+        });
+        checksum += result[NumMatrices - 1][3][3] + min.x + max.y + renderVertices.back();
+
+        osre_info(Tag, String(BatchMath::getLevelName(level)) + ": " + std::to_string(NumMatrices) + " mat4 products " +
+                std::to_string(matTime) + " us, " + std::to_string(NumVertices) + " points: transform " +
+                std::to_string(transformTime) + " us, bounds " + std::to_string(boundsTime) + " us, clip space " +
+                std::to_string(mapTime) + " us, interleave " + std::to_string(interleaveTime) + " us (" +
+                std::to_string(NumRuns) + " runs)");
+    }
+    BatchMath::setActiveLevel(BatchMath::getSupportedLevel());
+
+    return checksum;
+}
+
+} // namespace OSRE::Benchmark
@@ -0,0 +1,104 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "AbstractRenderTest.h"
+#include "RenderTestUtils.h"
+
+#include "App/ParticleEmitter.h"
+#include "RenderBackend/RenderBackendService.h"
+#include "RenderBackend/RenderCommon.h"
+#include "RenderBackend/TransformMatrixBlock.h"
+
+namespace OSRE {
+namespace RenderTest {
+
+using namespace ::OSRE::RenderBackend;
+using namespace ::OSRE::App;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	RenderTest
+///
+///	@brief  A particle emitter simulated on the GPU - rendering test
+//-------------------------------------------------------------------------------------------------
+class GpuParticleRenderTest : public AbstractRenderTest {
+    static const ui32 NumPoints = 100000;
+
+    TransformMatrixBlock mTransformMatrix;
+    ParticleEmitter *mEmitter;
+
+public:
+    GpuParticleRenderTest() :
+            AbstractRenderTest("rendertest/GpuParticleRenderTest"),
+            mEmitter(nullptr) {
+        // empty
+    }
+
+    ~GpuParticleRenderTest() override {
+        delete mEmitter;
+        mEmitter = nullptr;
+    }
+
+    bool onCreate(RenderBackendService *rbSrv) override {
+        rbSrv->sendEvent(&OnAttachViewEvent, nullptr);
+
+        rbSrv->beginPass(RenderPass::getPassNameById(RenderPassId));
+        rbSrv->beginRenderBatch("b1");
+
+        mEmitter = new ParticleEmitter(rbSrv);
+        ParticleEmitParams &params = mEmitter->getEmitParams();
+        params.SpawnBox = Common::AABB(glm::vec3(-0.1f), glm::vec3(0.1f));
+        params.VelocityMin = glm::vec3(-0.5f, 0.5f, -0.5f);
+        params.VelocityMax = glm::vec3(0.5f, 1.5f, 0.5f);
+        params.LifetimeMin = 1.0f;
+        params.LifetimeMax = 2.0f;
+        mEmitter->setGravity(glm::vec3(0.0f, -1.0f, 0.0f));
+        mEmitter->setEmissionRate(NumPoints / 2.0f);
+        mEmitter->init(NumPoints, ParticleSimulationMode::Gpu);
+
+        rbSrv->setMatrix(MatrixType::Model, mTransformMatrix.getModel());
+        rbSrv->setMatrix(MatrixType::View, mTransformMatrix.getView());
+        rbSrv->setMatrix(MatrixType::Projection, mTransformMatrix.getProjection());
+
+        rbSrv->endRenderBatch();
+        rbSrv->endPass();
+
+        return true;
+    }
+
+    bool onRender(RenderBackendService *rbSrv) override {
+        rbSrv->beginPass(RenderPass::getPassNameById(RenderPassId));
+        rbSrv->beginRenderBatch("b1");
+
+        // Queues the simulation step, the particles stay in the vertex buffer
+        mEmitter->update(1.0 / 60.0);
+
+        rbSrv->endRenderBatch();
+        rbSrv->endPass();
+
+        return true;
+    }
+};
+
+ATTACH_RENDERTEST(GpuParticleRenderTest)
+
+} // Namespace RenderTest
+} // Namespace OSRE
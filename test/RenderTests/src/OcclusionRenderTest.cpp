@@ -0,0 +1,123 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "AbstractRenderTest.h"
+#include "RenderTestUtils.h"
+
+#include "Common/Logger.h"
+#include "RenderBackend/HiZBuffer.h"
+#include "RenderBackend/Mesh.h"
+#include "RenderBackend/MeshBuilder.h"
+#include "RenderBackend/Pipeline.h"
+#include "RenderBackend/RenderBackendService.h"
+#include "RenderBackend/RenderCommon.h"
+
+namespace OSRE {
+namespace RenderTest {
+
+using namespace ::OSRE::RenderBackend;
+
+//-------------------------------------------------------------------------------------------------
+///	@ingroup	RenderTest
+///
+///	@brief  A wall in front of the camera, the occlusion pass shall hide the boxes behind it - rendering test
+//-------------------------------------------------------------------------------------------------
+class OcclusionRenderTest : public AbstractRenderTest {
+    // The read back arrives one frame late, give the driver some frames more
+    static constexpr ui32 CheckFrame = 10;
+
+    glm::mat4 mView;
+    glm::mat4 mProjection;
+    ui32 mFrame;
+
+public:
+    OcclusionRenderTest() :
+            AbstractRenderTest("rendertest/OcclusionRenderTest"),
+            mView(glm::lookAt(glm::vec3(0, 0, 5), glm::vec3(0, 0, 0), glm::vec3(0, 1, 0))),
+            mProjection(glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f)),
+            mFrame(0) {
+        // empty
+    }
+
+    ~OcclusionRenderTest() override = default;
+
+    bool onCreate(RenderBackendService *rbSrv) override {
+        rbSrv->sendEvent(&OnAttachViewEvent, nullptr);
+
+        rbSrv->beginPass(RenderPass::getPassNameById(RenderPassId));
+        rbSrv->beginRenderBatch("b1");
+        {
+            // A 3 x 3 wall around the origin, facing the camera
+            MeshBuilder meshBuilder;
+            meshBuilder.createCube(VertexType::ColorVertex, 3.0f, 0.1f, 3.0f, BufferAccessType::ReadOnly);
+            glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(-1.5f, -1.5f, -0.05f));
+            rbSrv->setMatrix(MatrixType::Model, model);
+            rbSrv->setMatrix(MatrixType::View, mView);
+            rbSrv->setMatrix(MatrixType::Projection, mProjection);
+            rbSrv->addMesh(meshBuilder.getMesh(), 0);
+        }
+        rbSrv->endRenderBatch();
+        rbSrv->endPass();
+
+        return true;
+    }
+
+    bool onRender(RenderBackendService *rbSrv) override {
+        rbSrv->beginPass(RenderPass::getPassNameById(RenderPassId));
+        rbSrv->beginRenderBatch("b1");
+        rbSrv->setMatrix(MatrixType::View, mView);
+        rbSrv->setMatrix(MatrixType::Projection, mProjection);
+        rbSrv->endRenderBatch();
+        rbSrv->endPass();
+
+        ++mFrame;
+        if (mFrame != CheckFrame) {
+            return true;
+        }
+
+        Pipeline *pipeline = rbSrv->getActivePipeline();
+        HiZBuffer *occlusionBuffer = pipeline != nullptr ? pipeline->getOcclusionBuffer() : nullptr;
+        if (occlusionBuffer == nullptr || !occlusionBuffer->isValid()) {
+            osre_error(getTestName(), "No depth was read back by the occlusion pass.");
+            return false;
+        }
+
+        const Common::AABB behind(glm::vec3(-0.25f, -0.25f, -3.0f), glm::vec3(0.25f, 0.25f, -2.5f));
+        if (occlusionBuffer->isVisible(behind)) {
+            osre_error(getTestName(), "The box behind the wall is not occluded.");
+            return false;
+        }
+
+        const Common::AABB inFront(glm::vec3(-0.25f, -0.25f, 1.0f), glm::vec3(0.25f, 0.25f, 1.5f));
+        if (!occlusionBuffer->isVisible(inFront)) {
+            osre_error(getTestName(), "The box in front of the wall is occluded.");
+            return false;
+        }
+
+        return true;
+    }
+};
+
+ATTACH_RENDERTEST(OcclusionRenderTest)
+
+} // Namespace RenderTest
+} // Namespace OSRE
@@ -102,6 +102,7 @@ bool RenderTestSuite::setup(const String &API) {
     Properties::Settings *settings = new Properties::Settings;
     settings->setString(Properties::Settings::RenderAPI, m_renderAPI);
     settings->setBool(Properties::Settings::PollingMode, true);
+    settings->setBool(Properties::Settings::OcclusionCulling, true);
 
     // create the platform abstraction
     m_pPlatformInterface = Platform::PlatformInterface::create(settings);
@@ -130,6 +131,7 @@ bool RenderTestSuite::setup(const String &API) {
         CreateRendererEventData *data = new CreateRendererEventData(m_pPlatformInterface->getRootWindow());
         data->DefaultFont = m_pPlatformInterface->getDefaultFontName();
         data->RequestedPipeline = m_pRenderBackendServer->createDefault3DPipeline(0);
+        m_pRenderBackendServer->setActivePipeline(data->RequestedPipeline);
         m_pRenderBackendServer->sendEvent(&OnCreateRendererEvent, data);
     }
 
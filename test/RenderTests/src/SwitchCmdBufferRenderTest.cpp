@@ -106,6 +106,9 @@ public:
         rbSrv->beginRenderBatch("b1");
 
         m_particeGen = new ParticleEmitter( rbSrv );
+        m_particeGen->getEmitParams().LifetimeMin = 1.0f;
+        m_particeGen->getEmitParams().LifetimeMax = 3.0f;
+        m_particeGen->setEmissionRate( NumPoints / 2.0f );
         m_particeGen->init( NumPoints );
 
 
@@ -120,12 +123,13 @@ public:
     }
 
     bool onRender( RenderBackend::RenderBackendService *rbSrv) override {
-        m_particeGen->update( NumPoints );
+        m_particeGen->update( 1.0 / 60.0 );
 
         rbSrv->beginPass(RenderPass::getPassNameById(RenderPassId));
         rbSrv->beginRenderBatch("b1");
 
         rbSrv->updateMesh( m_particeGen->getMesh() );
+        rbSrv->updateMeshPrimitives( m_particeGen->getMesh() );
 
         rbSrv->endRenderBatch();
         rbSrv->endPass();
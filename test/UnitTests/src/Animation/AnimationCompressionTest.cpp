@@ -0,0 +1,132 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "Animation/AnimationCompression.h"
+#include "Animation/AnimatorComponent.h"
+
+#include <cmath>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Animation;
+
+class AnimationCompressionTest : public ::testing::Test {
+protected:
+    static constexpr size_t NumChannels = 8;
+    static constexpr size_t NumKeys = 2000;
+
+    // Mocap like data, a key per tick with smooth motion and constant scaling
+    static AnimationTrack *createTrack() {
+        AnimationTrack *track = new AnimationTrack;
+        track->duration = static_cast<f32>(NumKeys - 1);
+        track->numVectorChannels = NumChannels;
+        track->animationChannels = new AnimationChannel[NumChannels];
+        for (size_t c = 0; c < NumChannels; ++c) {
+            AnimationChannel &channel = track->animationChannels[c];
+            channel.NodeName = "joint" + std::to_string(c);
+            channel.PositionKeys.resize(NumKeys);
+            channel.RotationKeys.resize(NumKeys);
+            channel.ScalingKeys.resize(NumKeys);
+            for (size_t i = 0; i < NumKeys; ++i) {
+                const f32 t = static_cast<f32>(i);
+                channel.PositionKeys[i].Time = t;
+                channel.PositionKeys[i].Value = glm::vec3(std::sin(t * 0.01f + c), 0.5f * t * 0.001f, 1.0f);
+                channel.RotationKeys[i].Time = t;
+                channel.RotationKeys[i].Quad = glm::angleAxis(std::sin(t * 0.005f) * 2.0f, glm::normalize(glm::vec3(1.0f, c + 1.0f, 0.5f)));
+                channel.ScalingKeys[i].Time = t;
+                channel.ScalingKeys[i].Scale = glm::vec3(1.0f);
+            }
+        }
+
+        return track;
+    }
+};
+
+TEST_F(AnimationCompressionTest, packRotationTest) {
+    const glm::vec3 axes[] = { glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::normalize(glm::vec3(1, 2, 3)), glm::normalize(glm::vec3(-3, 1, -1)) };
+    for (const glm::vec3 &axis : axes) {
+        for (f32 angle = -3.0f; angle <= 3.0f; angle += 0.37f) {
+            const glm::quat q = glm::angleAxis(angle, axis);
+            ui16 words[3];
+            CompressedClip::packRotation(q, words);
+            const glm::quat r = CompressedClip::unpackRotation(words);
+            EXPECT_NEAR(1.0f, std::abs(glm::dot(q, r)), 1e-6f);
+        }
+    }
+}
+
+TEST_F(AnimationCompressionTest, compressTest) {
+    AnimationTrack *track = createTrack();
+    CompressionSettings settings;
+    CompressedClip *clip = AnimationCompressor::compress(*track, settings);
+    ASSERT_NE(nullptr, clip);
+    ASSERT_EQ(NumChannels, clip->getNumChannels());
+    EXPECT_EQ("joint3", clip->getChannel(3).NodeName);
+    EXPECT_EQ(1u, clip->getChannel(0).Scaling.NumKeys);
+
+    const size_t rawSize = AnimationCompressor::getMemorySize(*track);
+    const size_t compressedSize = clip->getMemorySize();
+    EXPECT_GT(rawSize, compressedSize * 5);
+
+    // The compressed keys must stay close to the source
+    KeyCursor rawCursor, clipCursor;
+    for (d32 time = 0.0; time < track->duration; time += 3.7) {
+        for (size_t c = 0; c < NumChannels; ++c) {
+            glm::vec3 rawPos, rawScale, pos, scale;
+            glm::quat rawRot, rot;
+            AnimationSampler::sample(track->animationChannels[c], time, rawCursor, RotationBlendMode::Slerp, rawPos, rawRot, rawScale);
+            AnimationSampler::sample(*clip, c, time, clipCursor, RotationBlendMode::Slerp, pos, rot, scale);
+            EXPECT_LT(glm::length(rawPos - pos), 2.0f * settings.PositionTolerance);
+            EXPECT_LT(glm::length(rawScale - scale), 2.0f * settings.ScaleTolerance);
+            EXPECT_GT(std::abs(glm::dot(rawRot, rot)), std::cos(settings.RotationTolerance));
+        }
+    }
+
+    delete clip;
+    delete track;
+}
+
+TEST_F(AnimationCompressionTest, compressTrackTest) {
+    AnimationTrack *track = createTrack();
+    KeyCursor cursor;
+    const glm::mat4 expected = AnimationSampler::sample(*track, 2, 100.5, cursor, RotationBlendMode::Nlerp);
+
+    EXPECT_TRUE(AnimationCompressor::compressTrack(*track, CompressionSettings()));
+    EXPECT_EQ(nullptr, track->animationChannels);
+    ASSERT_NE(nullptr, track->compressedClip);
+    EXPECT_EQ("joint2", AnimationSampler::getChannelName(*track, 2));
+
+    cursor.reset();
+    const glm::mat4 m = AnimationSampler::sample(*track, 2, 100.5, cursor, RotationBlendMode::Nlerp);
+    for (glm::length_t i = 0; i < 4; ++i) {
+        for (glm::length_t j = 0; j < 4; ++j) {
+            EXPECT_NEAR(expected[i][j], m[i][j], 0.01f);
+        }
+    }
+
+    delete track;
+}
+
+} // namespace UnitTest
+} // namespace OSRE
@@ -0,0 +1,145 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "Animation/AnimationSampler.h"
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Animation;
+
+class AnimationSamplerTest : public ::testing::Test {
+protected:
+    static void createTrack(AnimationChannel &channel, size_t numKeys) {
+        channel.PositionKeys.resize(numKeys);
+        channel.RotationKeys.resize(numKeys);
+        channel.ScalingKeys.resize(numKeys);
+        for (size_t i = 0; i < numKeys; ++i) {
+            const f32 time = static_cast<f32>(i);
+            channel.PositionKeys[i].Time = time;
+            channel.PositionKeys[i].Value = glm::vec3(time, 0.0f, 0.0f);
+            channel.RotationKeys[i].Time = time;
+            channel.RotationKeys[i].Quad = glm::angleAxis(time * 0.01f, glm::vec3(0.0f, 1.0f, 0.0f));
+            channel.ScalingKeys[i].Time = time;
+            channel.ScalingKeys[i].Scale = glm::vec3(1.0f + time);
+        }
+    }
+};
+
+TEST_F(AnimationSamplerTest, findKeyTest) {
+    AnimationChannel channel;
+    createTrack(channel, 10);
+    const VectorKeyArray &keys = channel.PositionKeys;
+
+    EXPECT_EQ(0u, AnimationSampler::findKey(keys, -1.0, 0));
+    EXPECT_EQ(0u, AnimationSampler::findKey(keys, 0.5, 0));
+    EXPECT_EQ(9u, AnimationSampler::findKey(keys, 20.0, 0));
+
+    // cached key, successor and binary search must agree
+    EXPECT_EQ(3u, AnimationSampler::findKey(keys, 3.5, 3));
+    EXPECT_EQ(4u, AnimationSampler::findKey(keys, 4.5, 3));
+    EXPECT_EQ(7u, AnimationSampler::findKey(keys, 7.0, 3));
+    EXPECT_EQ(2u, AnimationSampler::findKey(keys, 2.25, 8));
+    for (size_t hint = 0; hint < 12; ++hint) {
+        EXPECT_EQ(5u, AnimationSampler::findKey(keys, 5.75, hint));
+    }
+}
+
+TEST_F(AnimationSamplerTest, rotationBlendTest) {
+    const glm::vec3 axis(0.0f, 0.0f, 1.0f);
+    const glm::quat a = glm::angleAxis(0.0f, axis);
+    const glm::quat b = glm::angleAxis(glm::radians(90.0f), axis);
+    const glm::quat expected = glm::angleAxis(glm::radians(45.0f), axis);
+
+    const glm::quat s = AnimationSampler::slerp(a, b, 0.5f);
+    EXPECT_NEAR(1.0f, std::abs(glm::dot(s, expected)), 1e-5f);
+
+    const glm::quat n = AnimationSampler::nlerp(a, b, 0.5f);
+    EXPECT_NEAR(1.0f, glm::length(n), 1e-5f);
+    EXPECT_NEAR(1.0f, std::abs(glm::dot(n, expected)), 1e-5f);
+
+    // The negated quaternion describes the same rotation, the blend must take the shortest path
+    const glm::quat shortest = AnimationSampler::slerp(a, -b, 0.5f);
+    EXPECT_NEAR(1.0f, std::abs(glm::dot(shortest, expected)), 1e-5f);
+}
+
+TEST_F(AnimationSamplerTest, sampleTest) {
+    AnimationChannel channel;
+    createTrack(channel, 4);
+    channel.ScalingKeys.resize(2);
+
+    KeyCursor cursor;
+    glm::vec3 pos, scale;
+    glm::quat rot;
+    AnimationSampler::sample(channel, 2.5, cursor, RotationBlendMode::Slerp, pos, rot, scale);
+    EXPECT_FLOAT_EQ(2.5f, pos.x);
+    EXPECT_EQ(2u, cursor.Position);
+    EXPECT_EQ(2u, cursor.Rotation);
+    EXPECT_EQ(1u, cursor.Scaling);
+    EXPECT_FLOAT_EQ(2.0f, scale.x);
+
+    // Jump back, the cursor must follow
+    AnimationSampler::sample(channel, 0.5, cursor, RotationBlendMode::Nlerp, pos, rot, scale);
+    EXPECT_FLOAT_EQ(0.5f, pos.x);
+    EXPECT_FLOAT_EQ(1.5f, scale.x);
+    EXPECT_EQ(0u, cursor.Position);
+
+    // Empty channels will return the identity
+    AnimationChannel empty;
+    AnimationSampler::sample(empty, 1.0, cursor, RotationBlendMode::Slerp, pos, rot, scale);
+    EXPECT_FLOAT_EQ(0.0f, pos.x);
+    EXPECT_FLOAT_EQ(1.0f, scale.y);
+    EXPECT_FLOAT_EQ(1.0f, rot.w);
+}
+
+TEST_F(AnimationSamplerTest, longTrackTest) {
+    constexpr size_t NumKeys = 1000;
+    constexpr size_t NumFrames = 4000;
+    AnimationChannel channel;
+    createTrack(channel, NumKeys);
+    const d32 step = static_cast<d32>(NumKeys - 1) / static_cast<d32>(NumFrames);
+
+    // Playback, the cursor will advance by the cached key
+    KeyCursor cursor;
+    glm::vec3 pos, scale;
+    glm::quat rot;
+    for (size_t frame = 0; frame < NumFrames; ++frame) {
+        const d32 time = frame * step;
+        AnimationSampler::sample(channel, time, cursor, RotationBlendMode::Slerp, pos, rot, scale);
+        EXPECT_NEAR(static_cast<f32>(time), pos.x, 1e-3f);
+        EXPECT_EQ(static_cast<size_t>(time), cursor.Position);
+    }
+
+    // Random seeks, every sample needs a binary search
+    size_t seed = 12345;
+    for (size_t frame = 0; frame < NumFrames; ++frame) {
+        seed = seed * 1103515245 + 12345;
+        const d32 time = static_cast<d32>(seed % (NumKeys - 1)) + 0.5;
+        AnimationSampler::sample(channel, time, cursor, RotationBlendMode::Nlerp, pos, rot, scale);
+        EXPECT_FLOAT_EQ(static_cast<f32>(time), pos.x);
+        EXPECT_FLOAT_EQ(static_cast<f32>(time) + 1.0f, scale.x);
+    }
+}
+
+} // namespace UnitTest
+} // namespace OSRE
@@ -0,0 +1,157 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "Animation/AnimationSystem.h"
+#include "Animation/AnimatorComponent.h"
+#include "Animation/SkeletonRig.h"
+#include "RenderBackend/RenderBackendService.h"
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Animation;
+using namespace ::OSRE::RenderBackend;
+
+class AnimationSystemTest : public ::testing::Test {
+protected:
+    AnimationTrack mTrack;
+
+    void SetUp() override {
+        // One channel moving from 0 to 10 along x within 10 ticks
+        mTrack.duration = 10.0f;
+        mTrack.ticksPerSecond = 1.0f;
+        mTrack.numVectorChannels = 1;
+        mTrack.animationChannels = new AnimationChannel[1];
+        VectorKey key;
+        key.Time = 0.0f;
+        key.Value = glm::vec3(0.0f);
+        mTrack.animationChannels[0].PositionKeys.add(key);
+        key.Time = 10.0f;
+        key.Value = glm::vec3(10.0f, 0.0f, 0.0f);
+        mTrack.animationChannels[0].PositionKeys.add(key);
+    }
+};
+
+TEST_F(AnimationSystemTest, updateTest) {
+    AnimationSystem system;
+    system.setGrainSize(1);
+
+    std::vector<AnimatorComponent *> animators;
+    for (size_t i = 0; i < 16; ++i) {
+        AnimatorComponent *animator = new AnimatorComponent(nullptr);
+        animator->addTrack(&mTrack);
+        animator->seek(static_cast<d32>(i % 4));
+        system.addAnimator(animator);
+        animators.push_back(animator);
+    }
+    EXPECT_EQ(16u, system.getNumAnimators());
+
+    // One second is one tick
+    system.update(Time(1000000));
+    ASSERT_EQ(16u, system.getPoseBuffer().size());
+    for (size_t i = 0; i < animators.size(); ++i) {
+        size_t offset = 0, count = 0;
+        ASSERT_TRUE(system.getPoseRange(animators[i], offset, count));
+        ASSERT_EQ(1u, count);
+        EXPECT_FLOAT_EQ(static_cast<f32>(i % 4 + 1), system.getPoseBuffer()[offset][3][0]);
+        EXPECT_FLOAT_EQ(system.getPoseBuffer()[offset][3][0], animators[i]->getChannelTransform(0)[3][0]);
+    }
+
+    // Deleted animators will leave the system
+    delete animators[0];
+    EXPECT_EQ(15u, system.getNumAnimators());
+    size_t offset = 0, count = 0;
+    EXPECT_FALSE(system.getPoseRange(animators[0], offset, count));
+
+    for (size_t i = 1; i < animators.size(); ++i) {
+        delete animators[i];
+    }
+    EXPECT_EQ(0u, system.getNumAnimators());
+}
+
+TEST_F(AnimationSystemTest, uploadTest) {
+    // A chain of two and a chain of three joints, the root follows the track
+    Skeleton skeletons[2];
+    SkeletonRig rigs[2];
+    const size_t numJoints[2] = { 2, 3 };
+    for (size_t i = 0; i < 2; ++i) {
+        for (size_t j = 0; j < numJoints[i]; ++j) {
+            Bone *bone = new Bone;
+            bone->mName = j == 0 ? "root" : "joint" + std::to_string(j);
+            bone->mParent = static_cast<i32>(j) - 1;
+            bone->m_offsetMatrix = glm::mat4(1.0f);
+            skeletons[i].mBones.add(bone);
+        }
+        ASSERT_TRUE(rigs[i].create(skeletons[i]));
+    }
+    mTrack.animationChannels[0].NodeName = "root";
+
+    AnimationSystem system;
+    AnimatorComponent small(nullptr), large(nullptr);
+    small.setSkeletonRig(&rigs[0]);
+    large.setSkeletonRig(&rigs[1]);
+    small.addTrack(&mTrack);
+    large.addTrack(&mTrack);
+    large.seek(5.0);
+    system.addAnimator(&small);
+    system.addAnimator(&large);
+    system.update(Time(1000000));
+    ASSERT_NE(nullptr, small.getRenderBatchName());
+    ASSERT_NE(nullptr, large.getRenderBatchName());
+    EXPECT_STRNE(small.getRenderBatchName(), large.getRenderBatchName());
+
+    // Every palette lands in the batch of its animator, the larger one does not hit the smaller one
+    RenderBackendService rbSrv;
+    ASSERT_NE(nullptr, rbSrv.beginPass("test"));
+    system.upload(&rbSrv);
+    rbSrv.endPass();
+    PassData *pass = rbSrv.getPassById("test");
+    ASSERT_NE(nullptr, pass);
+
+    const AnimatorComponent *animators[2] = { &small, &large };
+    const f32 rootX[2] = { 1.0f, 6.0f };
+    for (size_t i = 0; i < 2; ++i) {
+        RenderBatchData *batch = pass->getBatchById(animators[i]->getRenderBatchName());
+        ASSERT_NE(nullptr, batch);
+        UniformVar *palette = batch->getVarByName(SkinPaletteName);
+        ASSERT_NE(nullptr, palette);
+        ASSERT_EQ(numJoints[i], palette->m_numItems);
+
+        const glm::mat4 *matrices = reinterpret_cast<const glm::mat4 *>(palette->m_data.getData());
+        EXPECT_FLOAT_EQ(rootX[i], matrices[0][3][0]);
+        for (size_t j = 0; j < numJoints[i]; ++j) {
+            EXPECT_EQ(animators[i]->getSkeletonPose().getPalette()[j], matrices[j]);
+        }
+    }
+
+    system.removeAnimator(&small);
+    system.removeAnimator(&large);
+    for (Skeleton &skeleton : skeletons) {
+        for (size_t i = 0; i < skeleton.mBones.size(); ++i) {
+            delete skeleton.mBones[i];
+        }
+    }
+}
+
+} // namespace UnitTest
+} // namespace OSRE
@@ -0,0 +1,97 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "Animation/PoseBlender.h"
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Animation;
+
+class PoseBlenderTest : public ::testing::Test {
+protected:
+    static void createPose(LocalPose &pose, f32 x) {
+        pose.resize(2);
+        for (size_t i = 0; i < pose.size(); ++i) {
+            pose.Translations[i] = glm::vec3(x, 0.0f, 0.0f);
+            pose.Scales[i] = glm::vec3(1.0f + x);
+        }
+    }
+};
+
+TEST_F(PoseBlenderTest, accumulateTest) {
+    LocalPose a, b, accum;
+    createPose(a, 1.0f);
+    createPose(b, 3.0f);
+    accum.resize(2);
+
+    PoseBlender::clear(accum);
+    PoseBlender::accumulate(accum, a, 0.5f);
+    PoseBlender::accumulate(accum, b, 1.5f);
+    PoseBlender::normalize(accum, 2.0f);
+    EXPECT_FLOAT_EQ(2.5f, accum.Translations[0].x);
+    EXPECT_FLOAT_EQ(3.5f, accum.Scales[1].y);
+    EXPECT_FLOAT_EQ(1.0f, accum.Rotations[0].w);
+
+    // Without any weight the pose falls back to identity
+    PoseBlender::clear(accum);
+    PoseBlender::normalize(accum, 0.0f);
+    EXPECT_FLOAT_EQ(0.0f, accum.Translations[1].x);
+    EXPECT_FLOAT_EQ(1.0f, accum.Scales[1].x);
+    EXPECT_FLOAT_EQ(1.0f, accum.Rotations[1].w);
+}
+
+TEST_F(PoseBlenderTest, blendMaskTest) {
+    LocalPose target, source;
+    createPose(target, 0.0f);
+    createPose(source, 2.0f);
+
+    // Only the second slot is driven by the source pose
+    const f32 mask[] = { 0.0f, 1.0f };
+    PoseBlender::blend(target, source, 0.5f, mask);
+    EXPECT_FLOAT_EQ(0.0f, target.Translations[0].x);
+    EXPECT_FLOAT_EQ(1.0f, target.Translations[1].x);
+    EXPECT_FLOAT_EQ(2.0f, target.Scales[1].x);
+}
+
+TEST_F(PoseBlenderTest, additiveTest) {
+    LocalPose reference, pose, target;
+    createPose(reference, 1.0f);
+    createPose(pose, 3.0f);
+    createPose(target, 0.0f);
+
+    PoseBlender::makeAdditive(pose, reference);
+    EXPECT_FLOAT_EQ(2.0f, pose.Translations[0].x);
+    EXPECT_FLOAT_EQ(2.0f, pose.Scales[0].x);
+
+    // Adding the difference to the reference restores the source pose
+    PoseBlender::addAdditive(reference, pose, 1.0f, nullptr);
+    EXPECT_FLOAT_EQ(3.0f, reference.Translations[1].x);
+    EXPECT_FLOAT_EQ(4.0f, reference.Scales[1].x);
+
+    PoseBlender::addAdditive(target, pose, 0.5f, nullptr);
+    EXPECT_FLOAT_EQ(1.0f, target.Translations[0].x);
+}
+
+} // namespace UnitTest
+} // namespace OSRE
@@ -0,0 +1,125 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "Animation/SkeletonRig.h"
+#include "Animation/AnimatorComponent.h"
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Animation;
+
+class SkeletonRigTest : public ::testing::Test {
+protected:
+    Skeleton mSkeleton;
+
+    void SetUp() override {
+        // The bones are stored in a different order than the hierarchy: root <- spine <- head
+        mSkeleton.mName = "test";
+        mSkeleton.mBones.add(createBone("head", 2, glm::vec3(0, 2, 0)));
+        mSkeleton.mBones.add(createBone("root", -1, glm::vec3(0, 0, 0)));
+        mSkeleton.mBones.add(createBone("spine", 1, glm::vec3(0, 1, 0)));
+    }
+
+    void TearDown() override {
+        for (size_t i = 0; i < mSkeleton.mBones.size(); ++i) {
+            delete mSkeleton.mBones[i];
+        }
+        mSkeleton.mBones.clear();
+    }
+
+    static Bone *createBone(const String &name, i32 parent, const glm::vec3 &bindPos) {
+        Bone *bone = new Bone;
+        bone->mName = name;
+        bone->mParent = parent;
+        bone->m_offsetMatrix = glm::translate(glm::mat4(1.0f), -bindPos);
+        return bone;
+    }
+};
+
+TEST_F(SkeletonRigTest, createTest) {
+    SkeletonRig rig;
+    EXPECT_TRUE(rig.create(mSkeleton));
+    ASSERT_EQ(3u, rig.getNumJoints());
+
+    // Parents are stored in front of their children
+    EXPECT_EQ(0, rig.getJointByBone(1));
+    EXPECT_EQ(1, rig.getJointByBone(2));
+    EXPECT_EQ(2, rig.getJointByBone(0));
+    EXPECT_EQ(-1, rig.getParent(0));
+    EXPECT_EQ(0, rig.getParent(1));
+    EXPECT_EQ(1, rig.getParent(2));
+    EXPECT_EQ(2, rig.findJoint("head"));
+    EXPECT_EQ(-1, rig.findJoint("tail"));
+
+    // The local bind pose is relative to the parent
+    EXPECT_FLOAT_EQ(1.0f, rig.getBindPose(2)[3][1]);
+
+    // Cycles cannot be sorted
+    mSkeleton.mBones[1]->mParent = 0;
+    EXPECT_FALSE(rig.create(mSkeleton));
+    EXPECT_EQ(0u, rig.getNumJoints());
+}
+
+TEST_F(SkeletonRigTest, buildPaletteTest) {
+    SkeletonRig rig;
+    ASSERT_TRUE(rig.create(mSkeleton));
+
+    // The bind pose will not move any vertex
+    SkeletonPose pose(&rig);
+    pose.buildPalette();
+    for (size_t i = 0; i < pose.getNumJoints(); ++i) {
+        const glm::vec4 p = pose.getPalette()[i] * glm::vec4(0.5f, 2.0f, 0.0f, 1.0f);
+        EXPECT_FLOAT_EQ(0.5f, p.x);
+        EXPECT_FLOAT_EQ(2.0f, p.y);
+    }
+
+    // Moving the spine will move the head as well
+    AnimationTrack track;
+    track.numVectorChannels = 1;
+    track.animationChannels = new AnimationChannel[1];
+    track.animationChannels[0].NodeName = "spine";
+    VectorKey key;
+    key.Time = 0.0f;
+    key.Value = glm::vec3(1, 1, 0);
+    track.animationChannels[0].PositionKeys.add(key);
+
+    std::vector<i32> jointToChannel;
+    rig.createChannelMap(track, jointToChannel);
+    ASSERT_EQ(3u, jointToChannel.size());
+    EXPECT_EQ(-1, jointToChannel[0]);
+    EXPECT_EQ(0, jointToChannel[1]);
+    EXPECT_EQ(-1, jointToChannel[2]);
+
+    pose.sample(track, jointToChannel, 0.0, RotationBlendMode::Slerp);
+    pose.buildPalette();
+    EXPECT_FLOAT_EQ(1.0f, pose.getModelTransforms()[2][3][0]);
+    EXPECT_FLOAT_EQ(2.0f, pose.getModelTransforms()[2][3][1]);
+
+    const glm::vec4 headVertex = pose.getPalette()[2] * glm::vec4(0.0f, 2.0f, 0.0f, 1.0f);
+    EXPECT_FLOAT_EQ(1.0f, headVertex.x);
+    EXPECT_FLOAT_EQ(2.0f, headVertex.y);
+}
+
+} // namespace UnitTest
+} // namespace OSRE
@@ -22,8 +22,11 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include <gtest/gtest.h>
 #include "App/AssetBundle.h"
+#include "IO/BundleArchive.h"
 #include "IO/Uri.h"
 
+#include <cstdio>
+
 namespace OSRE {
 namespace UnitTest {
 
@@ -51,5 +54,27 @@ TEST_F(AssetBundleTest, add_remove_Test) {
     EXPECT_EQ(0u, bundle.getNumAssets());
 }
 
+TEST_F(AssetBundleTest, packTest) {
+    FILE *file = ::fopen("asset_bundle_test.obj", "wb");
+    ASSERT_NE(nullptr, file);
+    ::fputs("v 0 0 0\n", file);
+    ::fclose(file);
+
+    AssetBundle bundle("test.osbundle");
+    bundle.add("asset_bundle_test.obj");
+    EXPECT_TRUE(bundle.pack(".", "asset_bundle_test.osbundle", IO::BundleCompression::Deflate));
+    IO::BundleArchive archive;
+    ASSERT_TRUE(archive.open("asset_bundle_test.osbundle"));
+    const IO::BundleEntry *entry = archive.find("asset_bundle_test.obj");
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(8u, entry->UncompressedSize);
+    archive.close();
+
+    bundle.add("not_existing.obj");
+    EXPECT_FALSE(bundle.pack(".", "asset_bundle_test.osbundle", IO::BundleCompression::None));
+    ::remove("asset_bundle_test.obj");
+    ::remove("asset_bundle_test.osbundle");
+}
+
 } // namespace App
 } // namespace OSRE
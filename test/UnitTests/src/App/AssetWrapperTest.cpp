@@ -22,13 +22,26 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include <gtest/gtest.h>
 
+#include "Animation/AnimationSampler.h"
+#include "Animation/AnimatorComponent.h"
 #include "App/AssimpWrapper.h"
+#include "App/SharedAssetCache.h"
 #include "Common/Ids.h"
+#include "IO/BundleArchive.h"
+#include "IO/IOService.h"
+#include "IO/Uri.h"
+#include "RenderBackend/Mesh.h"
+
+#include <assimp/scene.h>
+
+#include <cstdio>
 
 namespace OSRE {
 namespace UnitTest {
 
 using namespace ::OSRE::App;
+using namespace ::OSRE::Animation;
+using namespace ::OSRE::RenderBackend;
 
 class AssimpWrapperTest : public ::testing::Test {
     // empty
@@ -46,5 +59,153 @@ TEST_F( AssimpWrapperTest, createTest ) {
     EXPECT_TRUE( ok );
 }
 
+static void createLinearAnimation(aiAnimation &animation, ui32 numKeys) {
+    animation.mDuration = static_cast<double>(numKeys - 1);
+    animation.mTicksPerSecond = 0.0;
+    animation.mNumChannels = 1;
+    animation.mChannels = new aiNodeAnim *[1];
+    aiNodeAnim *nodeAnim = new aiNodeAnim;
+    animation.mChannels[0] = nodeAnim;
+    nodeAnim->mNodeName = aiString("root");
+    nodeAnim->mNumPositionKeys = numKeys;
+    nodeAnim->mPositionKeys = new aiVectorKey[numKeys];
+    for (ui32 i = 0; i < numKeys; ++i) {
+        nodeAnim->mPositionKeys[i] = aiVectorKey(static_cast<double>(i), aiVector3D(static_cast<ai_real>(i), 0, 0));
+    }
+    nodeAnim->mNumRotationKeys = 1;
+    nodeAnim->mRotationKeys = new aiQuatKey[1];
+    nodeAnim->mNumScalingKeys = 1;
+    nodeAnim->mScalingKeys = new aiVectorKey[1];
+    nodeAnim->mScalingKeys[0] = aiVectorKey(0.0, aiVector3D(1, 1, 1));
+}
+
+TEST_F( AssimpWrapperTest, convertAnimationTest ) {
+    aiAnimation animation;
+    createLinearAnimation(animation, 11);
+
+    AnimationTrack track;
+    EXPECT_TRUE(AssimpWrapper::convertAnimation(&animation, nullptr, track));
+    EXPECT_FLOAT_EQ(1.0f, track.ticksPerSecond);
+    EXPECT_EQ(nullptr, track.compressedClip);
+    ASSERT_NE(nullptr, track.animationChannels);
+    EXPECT_EQ("root", track.animationChannels[0].NodeName);
+    EXPECT_EQ(11u, track.animationChannels[0].PositionKeys.size());
+}
+
+TEST_F( AssimpWrapperTest, compressAnimationTest ) {
+    aiAnimation animation;
+    createLinearAnimation(animation, 11);
+
+    CompressionSettings settings;
+    AnimationTrack track;
+    EXPECT_TRUE(AssimpWrapper::convertAnimation(&animation, &settings, track));
+    ASSERT_NE(nullptr, track.compressedClip);
+    EXPECT_EQ(nullptr, track.animationChannels);
+
+    // The linear motion is reduced to its end keys
+    EXPECT_EQ(2u, track.compressedClip->getChannel(0).Position.NumKeys);
+
+    KeyCursor cursor;
+    glm::vec3 position, scale;
+    glm::quat rotation;
+    EXPECT_TRUE(AnimationSampler::sample(track, 0, 5.5, cursor, RotationBlendMode::Slerp, position, rotation, scale));
+    EXPECT_NEAR(5.5f, position.x, 0.01f);
+}
+
+static aiNode *addChildNode(aiNode &parent, const char *name, f32 x, ui32 meshIndex) {
+    aiNode **children = new aiNode *[parent.mNumChildren + 1];
+    for (ui32 i = 0; i < parent.mNumChildren; ++i) {
+        children[i] = parent.mChildren[i];
+    }
+    delete[] parent.mChildren;
+    parent.mChildren = children;
+
+    aiNode *child = new aiNode(name);
+    child->mParent = &parent;
+    child->mTransformation.a4 = x;
+    child->mNumMeshes = 1;
+    child->mMeshes = new unsigned[1];
+    child->mMeshes[0] = meshIndex;
+    parent.mChildren[parent.mNumChildren++] = child;
+
+    return child;
+}
+
+TEST_F( AssimpWrapperTest, collectMeshInstancesTest ) {
+    aiNode root("root");
+    root.mTransformation.b4 = 1.0f;
+    addChildNode(root, "left", -2.0f, 0);
+    aiNode *right = addChildNode(root, "right", 2.0f, 0);
+    addChildNode(*right, "invalid", 0.0f, 1);
+
+    // Both nodes draw the same mesh with their own world transformation
+    AssimpWrapper::MeshInstanceArray instances;
+    AssimpWrapper::collectMeshInstances(&root, 1, instances);
+    ASSERT_EQ(2u, instances.size());
+    EXPECT_EQ(0u, instances[0].MeshIndex);
+    EXPECT_EQ(0u, instances[1].MeshIndex);
+    EXPECT_EQ(root.mChildren[0], instances[0].Node);
+    EXPECT_EQ(right, instances[1].Node);
+
+    const glm::vec4 left = instances[0].Transform * glm::vec4(0, 0, 0, 1);
+    EXPECT_FLOAT_EQ(-2.0f, left.x);
+    EXPECT_FLOAT_EQ(1.0f, left.y);
+    const glm::vec4 rightPos = instances[1].Transform * glm::vec4(0, 0, 0, 1);
+    EXPECT_FLOAT_EQ(2.0f, rightPos.x);
+    EXPECT_FLOAT_EQ(1.0f, rightPos.y);
+}
+
+TEST_F( AssimpWrapperTest, createMeshInstanceTest ) {
+    glm::vec3 vertices[3] = { glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0) };
+    ui32 indices[3] = { 0, 1, 2 };
+    Mesh source("source", VertexType::RenderVertex, IndexType::UnsignedInt);
+    source.createVertexBuffer(vertices, sizeof(vertices), BufferAccessType::ReadOnly);
+    source.createIndexBuffer(indices, sizeof(indices), IndexType::UnsignedInt, BufferAccessType::ReadOnly);
+    source.addPrimitiveGroup(3, PrimitiveType::TriangleList, 0);
+
+    SharedAssetCache cache;
+    Mesh empty("empty", VertexType::RenderVertex, IndexType::UnsignedInt);
+    EXPECT_EQ(nullptr, AssimpWrapper::createMeshInstance(&empty, cache));
+
+    // The instance draws the buffers of the source
+    Mesh *instance = AssimpWrapper::createMeshInstance(&source, cache);
+    ASSERT_NE(nullptr, instance);
+    EXPECT_EQ(source.getVertexBuffer(), instance->getVertexBuffer());
+    EXPECT_EQ(source.getIndexBuffer(), instance->getIndexBuffer());
+    EXPECT_TRUE(instance->hasSharedVertexBuffer());
+    EXPECT_TRUE(source.hasSharedIndexBuffer());
+    ASSERT_EQ(1u, instance->getNumberOfPrimitiveGroups());
+    EXPECT_EQ(3u, instance->getPrimitiveGroupAt(0)->m_numIndices);
+    EXPECT_NE(source.getId(), instance->getId());
+    delete instance;
+}
+
+TEST_F( AssimpWrapperTest, importBundleTest ) {
+    const c8 *ArchiveFile = "assimp_bundle_test.osbundle";
+    const String text = "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n";
+    IO::BundleArchiveWriter writer;
+    ASSERT_TRUE(writer.add("models/triangle.obj", text.c_str(), text.size(), IO::BundleCompression::None));
+    ASSERT_TRUE(writer.write(ArchiveFile));
+
+    IO::IOService *ioService = IO::IOService::create();
+    ASSERT_TRUE(ioService->open());
+    ASSERT_TRUE(ioService->mountBundle("pack", ArchiveFile));
+    {
+        // The model is parsed from the archive through the io-service
+        Common::Ids ids;
+        AssimpWrapper assimpWrapper(ids, nullptr);
+        EXPECT_FALSE(assimpWrapper.loadAsset(IO::Uri("bundle://pack/models/missing.obj"), 0));
+        ASSERT_TRUE(assimpWrapper.loadAsset(IO::Uri("bundle://pack/models/triangle.obj"), 0));
+        ASSERT_NE(nullptr, assimpWrapper.getScene());
+        EXPECT_EQ(1u, assimpWrapper.getScene()->mNumMeshes);
+        ui32 numVertices = 0, numTriangles = 0;
+        assimpWrapper.getStatistics(numVertices, numTriangles);
+        EXPECT_EQ(1u, numTriangles);
+    }
+    ioService->close();
+    ioService->release();
+    ::remove(ArchiveFile);
+}
+
 } // namespace App
 } // namespace OSRE
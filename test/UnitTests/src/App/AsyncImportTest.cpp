@@ -0,0 +1,107 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "App/AsyncImport.h"
+#include "Common/Ids.h"
+#include "IO/Uri.h"
+
+#include <chrono>
+#include <thread>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::App;
+using namespace ::OSRE::Common;
+
+class AsyncImportTest : public ::testing::Test {
+protected:
+    static bool waitForImport(AsyncImport &import) {
+        for (ui32 i = 0; i < 1000; ++i) {
+            if (import.update()) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        return false;
+    }
+};
+
+TEST_F(AsyncImportTest, createTest) {
+    Ids ids;
+    AsyncImport import(ids, nullptr);
+    EXPECT_EQ(AsyncImportState::Idle, import.getState());
+    EXPECT_EQ(nullptr, import.getEntity());
+    EXPECT_FALSE(import.update());
+}
+
+TEST_F(AsyncImportTest, startWithInvalidUriTest) {
+    Ids ids;
+    AsyncImport import(ids, nullptr);
+    IO::Uri invalid;
+    EXPECT_FALSE(import.start(invalid, 0));
+    EXPECT_EQ(AsyncImportState::Idle, import.getState());
+}
+
+TEST_F(AsyncImportTest, missingFileFailsTest) {
+    Ids ids;
+    AsyncImport import(ids, nullptr);
+    IO::Uri missing("file://not_existing_model.obj");
+    ASSERT_TRUE(import.start(missing, 0));
+    EXPECT_FALSE(import.start(missing, 0));
+    ASSERT_TRUE(waitForImport(import));
+    EXPECT_EQ(AsyncImportState::Failed, import.getState());
+    EXPECT_EQ(nullptr, import.getEntity());
+}
+
+TEST_F(AsyncImportTest, progressTest) {
+    Ids ids;
+    AsyncImport import(ids, nullptr);
+    EXPECT_TRUE(import.onProgress(ImportStage::Parse, 0.0f));
+    EXPECT_FLOAT_EQ(0.0f, import.getProgress());
+
+    EXPECT_TRUE(import.onProgress(ImportStage::Meshes, 2.0f));
+    EXPECT_EQ(ImportStage::Meshes, import.getStage());
+    const f32 meshesDone = import.getProgress();
+
+    EXPECT_TRUE(import.onProgress(ImportStage::Upload, 1.0f));
+    EXPECT_FLOAT_EQ(1.0f, import.getProgress());
+    EXPECT_LT(meshesDone, import.getProgress());
+}
+
+TEST_F(AsyncImportTest, cancelTest) {
+    Ids ids;
+    AsyncImport import(ids, nullptr);
+    import.cancel();
+    EXPECT_FALSE(import.onProgress(ImportStage::Parse, 0.5f));
+}
+
+TEST_F(AsyncImportTest, getStageNameTest) {
+    EXPECT_STREQ("Parse", AsyncImport::getStageName(ImportStage::Parse));
+    EXPECT_STREQ("Upload", AsyncImport::getStageName(ImportStage::Upload));
+    EXPECT_STREQ("Invalid", AsyncImport::getStageName(ImportStage::Count));
+}
+
+} // namespace UnitTest
+} // namespace OSRE
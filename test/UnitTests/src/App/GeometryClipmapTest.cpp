@@ -0,0 +1,167 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "App/GeometryClipmap.h"
+
+#include <cstdio>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::App;
+
+class GeometryClipmapTest : public ::testing::Test {
+protected:
+    // Will mark all samples of the regions, every sample must be reported once
+    static void markRegions(const ClipmapRegionArray &regions, ui32 size, std::vector<ui32> &texels, i32 originX, i32 originZ) {
+        for (ui32 i = 0; i < regions.size(); ++i) {
+            const ClipmapRegion &region = regions[i];
+            EXPECT_LE(region.TexelX + region.Width, size);
+            EXPECT_LE(region.TexelZ + region.Height, size);
+            for (ui32 z = 0; z < region.Height; ++z) {
+                for (ui32 x = 0; x < region.Width; ++x) {
+                    const i32 sx = region.SampleX + static_cast<i32>(x);
+                    const i32 sz = region.SampleZ + static_cast<i32>(z);
+                    EXPECT_GE(sx, originX);
+                    EXPECT_LT(sx, originX + static_cast<i32>(size));
+                    EXPECT_GE(sz, originZ);
+                    EXPECT_LT(sz, originZ + static_cast<i32>(size));
+                    EXPECT_EQ((region.TexelX + x) % size, static_cast<ui32>(((sx % static_cast<i32>(size)) + size) % size));
+                    ++texels[(region.TexelZ + z) * size + region.TexelX + x];
+                }
+            }
+        }
+    }
+};
+
+TEST_F(GeometryClipmapTest, windowTest) {
+    const ui32 size = 9;
+    ClipmapWindow window;
+    window.init(size);
+    EXPECT_FALSE(window.isValid());
+
+    // The first move reports the whole window, split at the texture border
+    ClipmapRegionArray regions;
+    window.moveTo(-3, 0, regions);
+    EXPECT_TRUE(window.isValid());
+    EXPECT_EQ(2u, regions.size());
+    std::vector<ui32> texels(size * size, 0u);
+    markRegions(regions, size, texels, -3, 0);
+    for (ui32 count : texels) {
+        EXPECT_EQ(1u, count);
+    }
+
+    // A small move reports only the entering samples
+    regions.resize(0);
+    window.moveTo(-1, -1, regions);
+    texels.assign(size * size, 0u);
+    markRegions(regions, size, texels, -1, -1);
+    ui32 numTexels = 0;
+    for (ui32 count : texels) {
+        EXPECT_LE(count, 1u);
+        numTexels += count;
+    }
+    EXPECT_EQ(2u * size + 1u * size - 2u, numTexels);
+
+    regions.resize(0);
+    window.moveTo(-1, -1, regions);
+    EXPECT_TRUE(regions.isEmpty());
+
+    // A jump reports everything again
+    regions.resize(0);
+    window.moveTo(100, 100, regions);
+    texels.assign(size * size, 0u);
+    markRegions(regions, size, texels, 100, 100);
+    for (ui32 count : texels) {
+        EXPECT_EQ(1u, count);
+    }
+}
+
+TEST_F(GeometryClipmapTest, gridIndicesTest) {
+    const ui32 gridSize = 8;
+    EXPECT_EQ(6u * 64u, GeometryClipmap::getNumGridIndices(gridSize, false));
+    EXPECT_EQ(6u * (64u - 16u), GeometryClipmap::getNumGridIndices(gridSize, true));
+
+    std::vector<ui16> indices(GeometryClipmap::getNumGridIndices(gridSize, true));
+    GeometryClipmap::buildGridIndices(gridSize, true, indices.data());
+    for (ui16 index : indices) {
+        EXPECT_LT(index, 81u);
+
+        // No triangle touches the inside of the hole
+        const ui32 x = index % 9u, z = index / 9u;
+        EXPECT_FALSE(x > 2u && x < 6u && z > 2u && z < 6u);
+    }
+}
+
+TEST_F(GeometryClipmapTest, mappedHeightFieldTest) {
+    const c8 *filename = "clipmap_test.r16";
+    const ui16 samples[] = { 0, 1, 2, 3, 4, 5 };
+    FILE *file = ::fopen(filename, "wb");
+    ASSERT_NE(nullptr, file);
+    ::fwrite(samples, sizeof(ui16), 6, file);
+    ::fclose(file);
+
+    MappedHeightField field;
+    EXPECT_FLOAT_EQ(0.0f, field.getSample(0, 0));
+    EXPECT_FALSE(field.open(filename, 4, 2, 1.0f, 0.0f));
+    EXPECT_FALSE(field.isOpen());
+    EXPECT_FLOAT_EQ(0.0f, field.getSample(1, 1));
+    ASSERT_TRUE(field.open(filename, 3, 2, 0.5f, -1.0f));
+    EXPECT_EQ(3u, field.getWidth());
+    EXPECT_FLOAT_EQ(-1.0f, field.getSample(0, 0));
+    EXPECT_FLOAT_EQ(1.0f, field.getSample(1, 1));
+    EXPECT_FLOAT_EQ(1.5f, field.getSample(10, 10));
+    EXPECT_FLOAT_EQ(-1.0f, field.getSample(-4, -4));
+    field.close();
+    EXPECT_FALSE(field.isOpen());
+    EXPECT_FLOAT_EQ(0.0f, field.getSample(1, 1));
+
+    ::remove(filename);
+}
+
+TEST_F(GeometryClipmapTest, levelOriginTest) {
+    GeometryClipmap clipmap;
+    const ClipmapDesc &desc = clipmap.getDesc();
+    const i32 halfSize = static_cast<i32>(desc.GridSize / 2);
+    const glm::vec3 eyes[] = { glm::vec3(0.0f), glm::vec3(1000.5f, 3.0f, -517.0f), glm::vec3(-40.0f, 0.0f, 12345.0f) };
+    for (const glm::vec3 &eye : eyes) {
+        i32 x = 0, z = 0;
+        for (ui32 level = 0; level + 1 < desc.NumLevels; ++level) {
+            i32 coarseX = 0, coarseZ = 0;
+            clipmap.getLevelOrigin(eye, level, x, z);
+            clipmap.getLevelOrigin(eye, level + 1, coarseX, coarseZ);
+            EXPECT_EQ(2 * coarseX + halfSize, x);
+            EXPECT_EQ(2 * coarseZ + halfSize, z);
+        }
+
+        // The camera is inside of the finest level
+        clipmap.getLevelOrigin(eye, 0, x, z);
+        EXPECT_LE(static_cast<f32>(x), eye.x);
+        EXPECT_GE(static_cast<f32>(x + 2 * halfSize), eye.x);
+        EXPECT_LE(static_cast<f32>(z), eye.z);
+        EXPECT_GE(static_cast<f32>(z + 2 * halfSize), eye.z);
+    }
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,288 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "App/MeshCache.h"
+#include "RenderBackend/Mesh.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::App;
+using namespace ::OSRE::RenderBackend;
+
+class MeshCacheTest : public ::testing::Test {
+protected:
+    static const c8 *SourceFile;
+    static const c8 *CacheFile;
+
+    void SetUp() override {
+        writeFile(SourceFile, "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 3\n");
+    }
+
+    void TearDown() override {
+        ::remove(SourceFile);
+        ::remove(CacheFile);
+    }
+
+    static void writeFile(const c8 *filename, const c8 *content) {
+        FILE *file = ::fopen(filename, "wb");
+        ASSERT_NE(nullptr, file);
+        ::fwrite(content, 1, ::strlen(content), file);
+        ::fclose(file);
+    }
+
+    static Mesh *createQuad() {
+        ColorVert vertices[4];
+        vertices[0].position = glm::vec3(0, 0, 0);
+        vertices[1].position = glm::vec3(1, 0, 0);
+        vertices[2].position = glm::vec3(1, 1, 0);
+        vertices[3].position = glm::vec3(0, 1, 0);
+        ui16 indices[6] = { 0, 1, 2, 0, 2, 3 };
+
+        Mesh *mesh = new Mesh("quad", VertexType::ColorVertex, IndexType::UnsignedShort);
+        mesh->createVertexBuffer(vertices, sizeof(vertices), BufferAccessType::ReadOnly);
+        mesh->createIndexBuffer(indices, sizeof(indices), IndexType::UnsignedShort, BufferAccessType::ReadOnly);
+        mesh->addPrimitiveGroup(6, PrimitiveType::TriangleList, 0);
+        MeshLodArray lods;
+        lods.add({ 0, 6, 0.0f });
+        lods.add({ 0, 3, 0.5f });
+        mesh->setLods(lods);
+
+        return mesh;
+    }
+
+    static bool writeCache(ui64 key) {
+        MeshCacheWriter writer;
+        MaterialDesc desc;
+        desc.Name = "stone";
+        desc.Textures.add({ "textures/stone.png", TextureStageType::TextureStage0 });
+        desc.ColorMask = 1 << static_cast<ui32>(MaterialColorType::Mat_Diffuse);
+        desc.Colors[static_cast<ui32>(MaterialColorType::Mat_Diffuse)] = Color4(0.5f, 0.25f, 1.0f, 1.0f);
+        writer.addMaterial(desc);
+
+        Mesh *mesh = createQuad();
+        const bool added = writer.addMesh(mesh, 0);
+        delete mesh;
+        if (!added) {
+            return false;
+        }
+
+        cppcore::TArray<ui32> refs;
+        writer.addNode("root", -1, glm::mat4(1.0f), cppcore::TArray<ui32>());
+        refs.add(0);
+        writer.addNode("child", 0, glm::translate(glm::mat4(1.0f), glm::vec3(1, 2, 3)), refs);
+        writer.setModelInfo(Common::AABB(glm::vec3(0, 0, 0), glm::vec3(1, 1, 0)), 4, 2);
+
+        return writer.write(CacheFile, key);
+    }
+};
+
+const c8 *MeshCacheTest::SourceFile = "mesh_cache_test.obj";
+const c8 *MeshCacheTest::CacheFile = "mesh_cache_test.obj.osrecache";
+
+TEST_F(MeshCacheTest, computeKeyTest) {
+    const ui64 key = MeshCache::computeKey(SourceFile, 1);
+    EXPECT_NE(0u, key);
+    EXPECT_EQ(key, MeshCache::computeKey(SourceFile, 1));
+    EXPECT_NE(key, MeshCache::computeKey(SourceFile, 2));
+
+    const String content = "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 3 2\n";
+    writeFile(SourceFile, content.c_str());
+    const ui64 changedKey = MeshCache::computeKey(SourceFile, 1);
+    EXPECT_NE(key, changedKey);
+
+    // Sources read into memory, like bundle entries, get the key of the file
+    EXPECT_EQ(changedKey, MeshCache::computeKey(content.c_str(), content.size(), 1));
+
+    EXPECT_EQ(0u, MeshCache::computeKey("does_not_exist.obj", 1));
+    EXPECT_EQ(String(CacheFile), MeshCache::getCacheFilename(SourceFile));
+}
+
+TEST_F(MeshCacheTest, roundTripTest) {
+    const ui64 key = MeshCache::computeKey(SourceFile, 1);
+    ASSERT_TRUE(writeCache(key));
+
+    MeshCacheReader reader;
+    ASSERT_TRUE(reader.open(CacheFile, key));
+    EXPECT_TRUE(reader.isOpen());
+    EXPECT_EQ(4u, reader.getHeader().NumVertices);
+    EXPECT_EQ(2u, reader.getHeader().NumTriangles);
+    EXPECT_EQ(glm::vec3(1, 1, 0), reader.getBounds().getMax());
+
+    ASSERT_EQ(1u, reader.getNumMaterials());
+    MaterialDesc desc;
+    reader.getMaterial(0, desc);
+    EXPECT_EQ(String("stone"), desc.Name);
+    ASSERT_EQ(1u, desc.Textures.size());
+    EXPECT_EQ(String("textures/stone.png"), desc.Textures[0].Name);
+    EXPECT_EQ(TextureStageType::TextureStage0, desc.Textures[0].Stage);
+    EXPECT_EQ(desc.ColorMask, 1u << static_cast<ui32>(MaterialColorType::Mat_Diffuse));
+    EXPECT_FLOAT_EQ(0.25f, desc.Colors[static_cast<ui32>(MaterialColorType::Mat_Diffuse)].m_g);
+
+    ASSERT_EQ(1u, reader.getNumMeshes());
+    i32 materialIndex = -1;
+    Mesh *mesh = reader.createMesh(0, materialIndex);
+    ASSERT_NE(nullptr, mesh);
+    EXPECT_EQ(0, materialIndex);
+    EXPECT_EQ(String("quad"), mesh->getName());
+    EXPECT_EQ(VertexType::ColorVertex, mesh->getVertexType());
+    EXPECT_EQ(IndexType::UnsignedShort, mesh->getIndexType());
+    ASSERT_EQ(4 * sizeof(ColorVert), mesh->getVertexBuffer()->getSize());
+    const ColorVert *vertices = reinterpret_cast<const ColorVert *>(mesh->getVertexBuffer()->getData());
+    EXPECT_EQ(glm::vec3(1, 1, 0), vertices[2].position);
+    ASSERT_EQ(6 * sizeof(ui16), mesh->getIndexBuffer()->getSize());
+    const ui16 *indices = reinterpret_cast<const ui16 *>(mesh->getIndexBuffer()->getData());
+    EXPECT_EQ(3u, indices[5]);
+    ASSERT_EQ(1u, mesh->getNumberOfPrimitiveGroups());
+    EXPECT_EQ(6u, mesh->getPrimitiveGroupAt(0)->m_numIndices);
+    ASSERT_EQ(2u, mesh->getNumLods());
+    EXPECT_EQ(3u, mesh->getLodAt(1).mNumIndices);
+    delete mesh;
+
+    ASSERT_EQ(2u, reader.getNumNodes());
+    const CachedNode &root = reader.getNode(0);
+    EXPECT_EQ(String("root"), reader.getString(root.Name));
+    EXPECT_EQ(-1, root.Parent);
+    EXPECT_EQ(0u, root.NumMeshRefs);
+    const CachedNode &child = reader.getNode(1);
+    EXPECT_EQ(String("child"), reader.getString(child.Name));
+    EXPECT_EQ(0, child.Parent);
+    ASSERT_EQ(1u, child.NumMeshRefs);
+    EXPECT_EQ(0u, reader.getMeshRefs(child)[0]);
+    EXPECT_FLOAT_EQ(2.0f, child.Transform[13]);
+}
+
+TEST_F(MeshCacheTest, embeddedTextureTest) {
+    static const uc8 Encoded[] = { 'P', '6', '\n', '1', ' ', '1', '\n', '2', '5', '5', '\n', 1, 2, 3 };
+    static const uc8 Pixels[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    MeshCacheWriter writer;
+    writer.addEmbeddedTexture("file://model.glb*0", Encoded, sizeof(Encoded), 0, 0);
+    writer.addEmbeddedTexture("file://model.glb*1", Pixels, sizeof(Pixels), 2, 1);
+    const ui64 key = MeshCache::computeKey(SourceFile, 1);
+    ASSERT_TRUE(writer.write(CacheFile, key));
+
+    MeshCacheReader reader;
+    ASSERT_TRUE(reader.open(CacheFile, key));
+    ASSERT_EQ(2u, reader.getNumEmbeddedTextures());
+    const CachedEmbeddedTexture &encoded = reader.getEmbeddedTexture(0);
+    EXPECT_EQ(String("file://model.glb*0"), reader.getString(encoded.Name));
+    EXPECT_EQ(0u, encoded.Width);
+    ASSERT_EQ(sizeof(Encoded), encoded.DataSize);
+    EXPECT_EQ(0, ::memcmp(Encoded, reader.getEmbeddedTextureData(encoded), sizeof(Encoded)));
+
+    const CachedEmbeddedTexture &pixels = reader.getEmbeddedTexture(1);
+    EXPECT_EQ(2u, pixels.Width);
+    EXPECT_EQ(1u, pixels.Height);
+    ASSERT_EQ(sizeof(Pixels), pixels.DataSize);
+    EXPECT_EQ(0, ::memcmp(Pixels, reader.getEmbeddedTextureData(pixels), sizeof(Pixels)));
+    reader.close();
+
+    // The pixels must match the size
+    MeshCacheWriter invalid;
+    invalid.addEmbeddedTexture("file://model.glb*0", Pixels, sizeof(Pixels), 2, 2);
+    ASSERT_TRUE(invalid.write(CacheFile, key));
+    EXPECT_FALSE(reader.open(CacheFile, key));
+}
+
+TEST_F(MeshCacheTest, rejectOutdatedTest) {
+    const ui64 key = MeshCache::computeKey(SourceFile, 1);
+    ASSERT_TRUE(writeCache(key));
+
+    MeshCacheReader reader;
+    EXPECT_FALSE(reader.open(CacheFile, key + 1));
+    EXPECT_FALSE(reader.isOpen());
+    EXPECT_EQ(0u, reader.getNumMeshes());
+    EXPECT_FALSE(reader.open("does_not_exist.osrecache", key));
+}
+
+TEST_F(MeshCacheTest, rejectChangedDependencyTest) {
+    const c8 *LibFile = "mesh_cache_test.mtl";
+    const c8 *TexFile = "mesh_cache_test_missing.png";
+    writeFile(LibFile, "newmtl stone\n");
+    ::remove(TexFile);
+    const ui64 key = MeshCache::computeKey(SourceFile, 1);
+
+    MeshCacheWriter writer;
+    writer.addDependency(LibFile);
+    writer.addDependency(LibFile);
+    writer.addDependency(TexFile);
+    ASSERT_TRUE(writer.write(CacheFile, key));
+    MeshCacheReader reader;
+    EXPECT_TRUE(reader.open(CacheFile, key));
+    EXPECT_EQ(2u, reader.getHeader().Dependencies.Count);
+    reader.close();
+
+    // The key of the source is the same, but the material library was changed
+    writeFile(LibFile, "newmtl stone\nKd 1 0 0\n");
+    EXPECT_FALSE(reader.open(CacheFile, key));
+
+    // A texture which was missing during the import shows up
+    MeshCacheWriter writer2;
+    writer2.addDependency(LibFile);
+    writer2.addDependency(TexFile);
+    ASSERT_TRUE(writer2.write(CacheFile, key));
+    EXPECT_TRUE(reader.open(CacheFile, key));
+    reader.close();
+    writeFile(TexFile, "png");
+    EXPECT_FALSE(reader.open(CacheFile, key));
+
+    ::remove(LibFile);
+    ::remove(TexFile);
+}
+
+TEST_F(MeshCacheTest, rejectCorruptTest) {
+    const ui64 key = MeshCache::computeKey(SourceFile, 1);
+    ASSERT_TRUE(writeCache(key));
+
+    // Truncate the data section
+    FILE *file = ::fopen(CacheFile, "rb");
+    ASSERT_NE(nullptr, file);
+    ::fseek(file, 0, SEEK_END);
+    const long size = ::ftell(file);
+    ::fseek(file, 0, SEEK_SET);
+    std::vector<c8> content(static_cast<size_t>(size));
+    ASSERT_EQ(content.size(), ::fread(content.data(), 1, content.size(), file));
+    ::fclose(file);
+
+    file = ::fopen(CacheFile, "wb");
+    ASSERT_NE(nullptr, file);
+    ::fwrite(content.data(), 1, content.size() - 8, file);
+    ::fclose(file);
+
+    MeshCacheReader reader;
+    EXPECT_FALSE(reader.open(CacheFile, key));
+
+    // Damage the magic
+    content[0] = 'X';
+    file = ::fopen(CacheFile, "wb");
+    ASSERT_NE(nullptr, file);
+    ::fwrite(content.data(), 1, content.size(), file);
+    ::fclose(file);
+    EXPECT_FALSE(reader.open(CacheFile, key));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,115 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "App/ParticleEmitter.h"
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::App;
+using namespace ::OSRE::Common;
+using namespace ::OSRE::RenderBackend;
+
+class ParticleBufferTest : public ::testing::Test {
+protected:
+    static ParticleVertexStream getStream(std::vector<ColorVert> &vertices) {
+        ParticleVertexStream stream;
+        stream.Data = reinterpret_cast<uc8 *>(vertices.data());
+        stream.Stride = sizeof(ColorVert);
+        stream.PositionOffset = offsetof(ColorVert, position);
+        stream.ColorOffset = static_cast<i32>(offsetof(ColorVert, color0));
+        return stream;
+    }
+};
+
+TEST_F(ParticleBufferTest, emitTest) {
+    std::vector<ColorVert> vertices(100);
+    ParticleBuffer particles;
+    particles.reserve(vertices.size());
+
+    ParticleEmitParams params;
+    params.SpawnBox.set(glm::vec3(1.0f), glm::vec3(2.0f));
+    EXPECT_EQ(60u, particles.emit(60, params, 1, getStream(vertices)));
+    EXPECT_EQ(40u, particles.emit(60, params, 2, getStream(vertices)));
+    EXPECT_EQ(100u, particles.getNumAlive());
+
+    for (size_t i = 0; i < particles.getNumAlive(); ++i) {
+        const glm::vec3 pos = particles.getPosition(i);
+        EXPECT_TRUE(params.SpawnBox.isIn(pos));
+        EXPECT_EQ(pos, vertices[i].position);
+        EXPECT_GT(vertices[i].color0.x, 0.0f);
+    }
+}
+
+TEST_F(ParticleBufferTest, simulateTest) {
+    std::vector<ColorVert> vertices(37);
+    ParticleBuffer particles;
+    particles.reserve(vertices.size());
+
+    // Resting particles will only fall
+    ParticleEmitParams params;
+    params.SpawnBox.set(glm::vec3(0.0f), glm::vec3(0.0f));
+    params.VelocityMin = params.VelocityMax = glm::vec3(0.0f);
+    particles.emit(vertices.size(), params, 1, getStream(vertices));
+
+    particles.simulate(0.5f, glm::vec3(0.0f, -2.0f, 0.0f), nullptr, getStream(vertices));
+    ASSERT_EQ(37u, particles.getNumAlive());
+    for (size_t i = 0; i < particles.getNumAlive(); ++i) {
+        EXPECT_FLOAT_EQ(-0.5f, particles.getPosition(i).y);
+        EXPECT_FLOAT_EQ(-0.5f, vertices[i].position.y);
+        EXPECT_FLOAT_EQ(0.5f, particles.getAge(i));
+    }
+
+    // Particles leaving the bounds will be killed
+    const AABB bounds(glm::vec3(-1.0f), glm::vec3(1.0f));
+    particles.simulate(0.5f, glm::vec3(0.0f, -2.0f, 0.0f), &bounds, getStream(vertices));
+    EXPECT_EQ(0u, particles.getNumAlive());
+}
+
+TEST_F(ParticleBufferTest, lifetimeTest) {
+    std::vector<ColorVert> vertices(10);
+    ParticleBuffer particles;
+    particles.reserve(vertices.size());
+
+    ParticleEmitParams shortLived;
+    shortLived.LifetimeMin = shortLived.LifetimeMax = 1.0f;
+    shortLived.ColorMin = shortLived.ColorMax = glm::vec3(1.0f, 0.0f, 0.0f);
+    ParticleEmitParams longLived;
+    longLived.ColorMin = longLived.ColorMax = glm::vec3(0.0f, 1.0f, 0.0f);
+    for (size_t i = 0; i < 5; ++i) {
+        particles.emit(1, shortLived, 1, getStream(vertices));
+        particles.emit(1, longLived, 1, getStream(vertices));
+    }
+
+    // The survivors are moved to the front together with their vertices
+    particles.simulate(1.5f, glm::vec3(0.0f), nullptr, getStream(vertices));
+    ASSERT_EQ(5u, particles.getNumAlive());
+    for (size_t i = 0; i < particles.getNumAlive(); ++i) {
+        EXPECT_FLOAT_EQ(1.5f, particles.getAge(i));
+        EXPECT_FLOAT_EQ(1.0f, vertices[i].color0.y);
+        EXPECT_EQ(particles.getPosition(i), vertices[i].position);
+    }
+}
+
+} // namespace UnitTest
+} // namespace OSRE
@@ -0,0 +1,163 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "App/SharedAssetCache.h"
+#include "RenderBackend/Mesh.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::App;
+using namespace ::OSRE::RenderBackend;
+
+class SharedAssetCacheTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        ::remove("shared_texture_a.png");
+        ::remove("shared_texture_b.png");
+        ::remove("shared_texture_c.png");
+    }
+
+    static void writeFile(const c8 *filename, const c8 *content) {
+        FILE *file = ::fopen(filename, "wb");
+        ASSERT_NE(nullptr, file);
+        ::fwrite(content, 1, ::strlen(content), file);
+        ::fclose(file);
+    }
+
+    static Mesh *createTriangle(f32 size) {
+        ColorVert vertices[3];
+        vertices[0].position = glm::vec3(0, 0, 0);
+        vertices[1].position = glm::vec3(size, 0, 0);
+        vertices[2].position = glm::vec3(0, size, 0);
+        ui16 indices[3] = { 0, 1, 2 };
+
+        Mesh *mesh = new Mesh("triangle", VertexType::ColorVertex, IndexType::UnsignedShort);
+        mesh->createVertexBuffer(vertices, sizeof(vertices), BufferAccessType::ReadOnly);
+        mesh->createIndexBuffer(indices, sizeof(indices), IndexType::UnsignedShort, BufferAccessType::ReadOnly);
+        mesh->addPrimitiveGroup(3, PrimitiveType::TriangleList, 0);
+
+        return mesh;
+    }
+};
+
+TEST_F(SharedAssetCacheTest, computeMeshKeyTest) {
+    const ui32 indices[3] = { 0, 1, 2 };
+    const f32 vertices[9] = { 0, 0, 0, 1, 0, 0, 0, 1, 0 };
+    const ui64 key = SharedAssetCache::computeMeshKey(VertexType::ColorVertex, IndexType::UnsignedInt, vertices, sizeof(vertices), indices, sizeof(indices));
+    EXPECT_EQ(key, SharedAssetCache::computeMeshKey(VertexType::ColorVertex, IndexType::UnsignedInt, vertices, sizeof(vertices), indices, sizeof(indices)));
+    EXPECT_NE(key, SharedAssetCache::computeMeshKey(VertexType::RenderVertex, IndexType::UnsignedInt, vertices, sizeof(vertices), indices, sizeof(indices)));
+    EXPECT_NE(key, SharedAssetCache::computeMeshKey(VertexType::ColorVertex, IndexType::UnsignedInt, vertices, sizeof(vertices) - 4, indices, sizeof(indices)));
+}
+
+TEST_F(SharedAssetCacheTest, shareMeshTest) {
+    SharedAssetCache cache;
+    Mesh *first = createTriangle(1.0f);
+    Mesh *second = createTriangle(1.0f);
+    Mesh *other = createTriangle(2.0f);
+
+    EXPECT_FALSE(cache.shareMesh(first));
+    EXPECT_TRUE(cache.shareMesh(second));
+    EXPECT_FALSE(cache.shareMesh(other));
+    EXPECT_FALSE(cache.shareMesh(first));
+
+    // The instance uses the buffers of the first mesh, so they get uploaded once
+    EXPECT_EQ(first->getVertexBuffer(), second->getVertexBuffer());
+    EXPECT_EQ(first->getIndexBuffer(), second->getIndexBuffer());
+    EXPECT_TRUE(first->hasSharedVertexBuffer());
+    EXPECT_TRUE(second->hasSharedIndexBuffer());
+    EXPECT_FALSE(other->hasSharedVertexBuffer());
+    EXPECT_NE(first->getVertexBuffer(), other->getVertexBuffer());
+
+    EXPECT_EQ(2u, cache.getStatistics().NumMeshes);
+    EXPECT_EQ(1u, cache.getStatistics().NumSharedMeshes);
+
+    cache.clear();
+    EXPECT_EQ(0u, cache.getStatistics().NumMeshes);
+    EXPECT_FALSE(cache.shareMesh(second));
+
+    delete first;
+    delete second;
+    delete other;
+}
+
+TEST_F(SharedAssetCacheTest, findMeshTest) {
+    SharedAssetCache cache;
+    Mesh *mesh = createTriangle(1.0f);
+    BufferData *vb = mesh->getVertexBuffer();
+    BufferData *ib = mesh->getIndexBuffer();
+
+    // Another content with the same key must not be found
+    cache.addMesh(42, mesh);
+    EXPECT_EQ(mesh, cache.findMesh(42, VertexType::ColorVertex, IndexType::UnsignedShort, vb->getData(), vb->getSize(), ib->getData(), ib->getSize()));
+    const ui16 indices[3] = { 2, 1, 0 };
+    EXPECT_EQ(nullptr, cache.findMesh(42, VertexType::ColorVertex, IndexType::UnsignedShort, vb->getData(), vb->getSize(), indices, sizeof(indices)));
+    EXPECT_EQ(nullptr, cache.findMesh(43, VertexType::ColorVertex, IndexType::UnsignedShort, vb->getData(), vb->getSize(), ib->getData(), ib->getSize()));
+
+    delete mesh;
+}
+
+TEST_F(SharedAssetCacheTest, getTextureNameTest) {
+    writeFile("shared_texture_a.png", "texture-content");
+    writeFile("shared_texture_b.png", "texture-content");
+    writeFile("shared_texture_c.png", "other-content");
+
+    SharedAssetCache cache;
+    const String a = "file://shared_texture_a.png";
+    EXPECT_EQ(a, cache.getTextureName(a));
+    EXPECT_EQ(a, cache.getTextureName("file://shared_texture_b.png"));
+    EXPECT_EQ("file://shared_texture_c.png", cache.getTextureName("file://shared_texture_c.png"));
+    EXPECT_EQ("file://not_existing.png", cache.getTextureName("file://not_existing.png"));
+    EXPECT_EQ(3u, cache.getStatistics().NumTextures);
+    EXPECT_EQ(1u, cache.getStatistics().NumSharedTextures);
+
+    // The same content is loaded by one resource
+    TextureResource *texRes = cache.getTextureResource(a);
+    ASSERT_NE(nullptr, texRes);
+    EXPECT_EQ(texRes, cache.getTextureResource("file://shared_texture_b.png"));
+    EXPECT_NE(texRes, cache.getTextureResource("file://shared_texture_c.png"));
+}
+
+TEST_F(SharedAssetCacheTest, addTextureResourceTest) {
+    SharedAssetCache cache;
+    const String name = "file://model.glb*0";
+    auto *texRes = new TextureResource(name, IO::Uri(name));
+    EXPECT_FALSE(cache.addTextureResource(name, 1, nullptr));
+    EXPECT_TRUE(cache.addTextureResource(name, 1, texRes));
+    EXPECT_EQ(texRes, cache.getTextureResource(name));
+
+    // A known name and the same content are resolved to the registered texture
+    TextureResource other("file://model.glb*1", IO::Uri("file://model.glb*1"));
+    EXPECT_FALSE(cache.addTextureResource(name, 2, &other));
+    EXPECT_FALSE(cache.addTextureResource("file://other.glb*0", 1, &other));
+    EXPECT_EQ(name, cache.getTextureName("file://other.glb*0"));
+    EXPECT_EQ(texRes, cache.getTextureResource("file://other.glb*0"));
+    EXPECT_EQ(1u, cache.getStatistics().NumTextures);
+    EXPECT_EQ(1u, cache.getStatistics().NumSharedTextures);
+}
+
+} // namespace UnitTest
+} // namespace OSRE
@@ -0,0 +1,184 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "App/Terrain.h"
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::App;
+using namespace ::OSRE::Common;
+using namespace ::OSRE::RenderBackend;
+
+class TerrainTest : public ::testing::Test {
+protected:
+    static void createSlope(HeightField &field, ui32 size) {
+        std::vector<f32> heights(size * size);
+        for (ui32 z = 0; z < size; ++z) {
+            for (ui32 x = 0; x < size; ++x) {
+                heights[z * size + x] = static_cast<f32>(x) * 0.5f;
+            }
+        }
+        field.create(size, size, heights.data());
+    }
+
+    static TerrainDesc getDesc() {
+        TerrainDesc desc;
+        desc.ChunkSize = 32;
+        desc.NumLods = 3;
+        desc.LodRange = 16.0f;
+        return desc;
+    }
+};
+
+TEST_F(TerrainTest, heightFieldTest) {
+    HeightField field;
+    EXPECT_TRUE(field.isEmpty());
+    EXPECT_FALSE(field.create(0, 4, nullptr));
+
+    createSlope(field, 9);
+    EXPECT_EQ(9u, field.getWidth());
+    EXPECT_EQ(9u, field.getHeight());
+    EXPECT_FLOAT_EQ(1.0f, field.getSample(2, 3));
+    EXPECT_FLOAT_EQ(0.0f, field.getSample(-5, 3));
+    EXPECT_FLOAT_EQ(4.0f, field.getSample(100, 100));
+
+    f32 minH = 0.0f, maxH = 0.0f;
+    field.getRange(2, 0, 4, 8, minH, maxH);
+    EXPECT_FLOAT_EQ(1.0f, minH);
+    EXPECT_FLOAT_EQ(2.0f, maxH);
+
+    const uc8 pixels[] = { 0, 9, 255, 9, 128, 9, 64, 9 };
+    EXPECT_TRUE(field.createFromImage(2, 2, 2, pixels, 0.5f, -10.0f));
+    EXPECT_FLOAT_EQ(-10.0f, field.getSample(0, 0));
+    EXPECT_FLOAT_EQ(117.5f, field.getSample(1, 0));
+    EXPECT_FLOAT_EQ(54.0f, field.getSample(0, 1));
+}
+
+TEST_F(TerrainTest, selectTest) {
+    HeightField field;
+    createSlope(field, 129);
+    TerrainLodTree tree;
+    EXPECT_FALSE(tree.init(nullptr, getDesc()));
+    ASSERT_TRUE(tree.init(&field, getDesc()));
+
+    ui32 numX = 0, numZ = 0;
+    tree.getNumNodes(0, numX, numZ);
+    EXPECT_EQ(4u, numX);
+    EXPECT_EQ(4u, numZ);
+    tree.getNumNodes(2, numX, numZ);
+    EXPECT_EQ(1u, numX);
+
+    // Far away only the root is needed
+    TerrainNodeArray nodes;
+    tree.select(glm::vec3(10000.0f), nodes);
+    ASSERT_EQ(1u, nodes.size());
+    EXPECT_EQ(2u, nodes[0].Level);
+    const AABB root = tree.getBounds(nodes[0]);
+    EXPECT_FLOAT_EQ(0.0f, root.getMin().y);
+    EXPECT_FLOAT_EQ(64.0f, root.getMax().y);
+    EXPECT_FLOAT_EQ(128.0f, root.getMax().x);
+
+    // Close to a corner the finest chunk is selected there, and the nodes cover the field exactly once
+    nodes.resize(0);
+    tree.select(glm::vec3(0.0f, 0.0f, 0.0f), nodes);
+    std::vector<ui32> coverage(128 * 128, 0u);
+    bool hasFinestCorner = false;
+    for (ui32 i = 0; i < nodes.size(); ++i) {
+        const TerrainNode &node = nodes[i];
+        const ui32 span = 32u << node.Level;
+        hasFinestCorner |= (node.Level == 0 && node.X == 0 && node.Z == 0);
+        for (ui32 z = node.Z * span; z < (node.Z + 1) * span; ++z) {
+            for (ui32 x = node.X * span; x < (node.X + 1) * span; ++x) {
+                ++coverage[z * 128 + x];
+            }
+        }
+    }
+    EXPECT_TRUE(hasFinestCorner);
+    EXPECT_GT(nodes.size(), 1u);
+    for (ui32 count : coverage) {
+        EXPECT_EQ(1u, count);
+    }
+}
+
+TEST_F(TerrainTest, buildChunkTest) {
+    HeightField field;
+    createSlope(field, 129);
+    TerrainLodTree tree;
+    ASSERT_TRUE(tree.init(&field, getDesc()));
+
+    const ui32 numVertices = tree.getNumChunkVertices();
+    const ui32 numIndices = tree.getNumChunkIndices();
+    EXPECT_EQ(33u * 33u + 4u * 32u, numVertices);
+    EXPECT_EQ(6u * 32u * 32u + 24u * 32u, numIndices);
+
+    std::vector<ui16> indices(numIndices);
+    tree.buildChunkIndices(indices.data());
+    for (ui16 index : indices) {
+        EXPECT_LT(index, numVertices);
+    }
+
+    // A coarse chunk steps over the samples with its level
+    std::vector<RenderVert> vertices(numVertices);
+    const TerrainNode node = { 1, 1, 0 };
+    tree.buildChunkVertices(node, vertices.data());
+    EXPECT_FLOAT_EQ(64.0f, vertices[0].position.x);
+    EXPECT_FLOAT_EQ(32.0f, vertices[0].position.y);
+    EXPECT_FLOAT_EQ(66.0f, vertices[1].position.x);
+    EXPECT_FLOAT_EQ(33.0f, vertices[1].position.y);
+    EXPECT_FLOAT_EQ(2.0f, vertices[33].position.z);
+
+    // The skirt hangs below its border vertex
+    const RenderVert &skirt = vertices[33 * 33];
+    EXPECT_EQ(vertices[0].position.x, skirt.position.x);
+    EXPECT_LT(skirt.position.y, vertices[0].position.y);
+}
+
+TEST_F(TerrainTest, chunkCacheTest) {
+    TerrainChunkCache cache;
+    cache.reserve(2);
+
+    bool isNew = false;
+    const ui32 a = cache.acquire(1, 1, isNew);
+    EXPECT_TRUE(isNew);
+    const ui32 b = cache.acquire(2, 1, isNew);
+    EXPECT_TRUE(isNew);
+    EXPECT_NE(a, b);
+
+    // The budget is used by the current frame
+    EXPECT_EQ(TerrainChunkCache::InvalidSlot, cache.acquire(3, 1, isNew));
+
+    // The chunk of frame 2 stays, the older one is replaced
+    EXPECT_EQ(b, cache.acquire(2, 2, isNew));
+    EXPECT_FALSE(isNew);
+    EXPECT_EQ(a, cache.acquire(3, 2, isNew));
+    EXPECT_TRUE(isNew);
+    EXPECT_FALSE(cache.contains(1));
+    EXPECT_TRUE(cache.contains(3));
+    EXPECT_TRUE(cache.isUsed(a, 2));
+    EXPECT_FALSE(cache.isUsed(a, 3));
+    EXPECT_EQ(2u, cache.getNumResident());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -0,0 +1,291 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "Common/BatchMath.h"
+
+#include <vector>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+
+class BatchMathTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        BatchMath::setActiveLevel(BatchMath::getSupportedLevel());
+    }
+
+    static std::vector<SimdLevel> getLevels() {
+        std::vector<SimdLevel> levels;
+        for (i32 i = 0; i <= static_cast<i32>(BatchMath::getSupportedLevel()); ++i) {
+            levels.push_back(static_cast<SimdLevel>(i));
+        }
+        return levels;
+    }
+
+    static glm::mat4 createMatrix(f32 seed) {
+        glm::mat4 m(1.0f);
+        for (glm::length_t col = 0; col < 4; ++col) {
+            for (glm::length_t row = 0; row < 4; ++row) {
+                m[col][row] = seed + static_cast<f32>(col * 4 + row) * 0.25f - 2.0f;
+            }
+        }
+        return m;
+    }
+
+    // Interleaved like a vertex, the position is followed by two other floats
+    struct Vertex {
+        f32 Pos[3];
+        f32 Pad[2];
+    };
+
+    static std::vector<Vertex> createVertices(size_t count) {
+        std::vector<Vertex> vertices(count);
+        for (size_t i = 0; i < count; ++i) {
+            const f32 t = static_cast<f32>(i);
+            vertices[i].Pos[0] = (static_cast<f32>((i * 7919) % 1000) - 500.0f) * 0.1f;
+            vertices[i].Pos[1] = t * 0.5f - 3.0f;
+            vertices[i].Pos[2] = -t;
+            vertices[i].Pad[0] = vertices[i].Pad[1] = 12345.0f;
+        }
+        return vertices;
+    }
+};
+
+TEST_F(BatchMathTest, selectLevelTest) {
+    BatchMath::setActiveLevel(SimdLevel::Scalar);
+    EXPECT_EQ(SimdLevel::Scalar, BatchMath::getActiveLevel());
+
+    // Not supported levels will be clamped
+    BatchMath::setActiveLevel(SimdLevel::AVX2);
+    EXPECT_EQ(BatchMath::getSupportedLevel(), BatchMath::getActiveLevel());
+    EXPECT_STREQ("SSE2", BatchMath::getLevelName(SimdLevel::SSE2));
+}
+
+TEST_F(BatchMathTest, multiplyMatricesTest) {
+    constexpr size_t Count = 5;
+    std::vector<glm::mat4> lhs, rhs;
+    for (size_t i = 0; i < Count; ++i) {
+        lhs.push_back(createMatrix(static_cast<f32>(i)));
+        rhs.push_back(createMatrix(static_cast<f32>(i) * -0.5f));
+    }
+
+    for (SimdLevel level : getLevels()) {
+        BatchMath::setActiveLevel(level);
+        std::vector<glm::mat4> result(Count, glm::mat4(0.0f));
+        BatchMath::multiplyMatrices(lhs.data(), rhs.data(), result.data(), Count);
+        for (size_t i = 0; i < Count; ++i) {
+            const glm::mat4 expected = lhs[i] * rhs[i];
+            for (glm::length_t col = 0; col < 4; ++col) {
+                for (glm::length_t row = 0; row < 4; ++row) {
+                    EXPECT_NEAR(expected[col][row], result[i][col][row], 1e-4f) << BatchMath::getLevelName(level);
+                }
+            }
+        }
+
+        // In place
+        std::vector<glm::mat4> inPlace = rhs;
+        BatchMath::multiplyMatrices(lhs.data(), inPlace.data(), inPlace.data(), Count);
+        EXPECT_NEAR(result[Count - 1][3][2], inPlace[Count - 1][3][2], 1e-4f);
+    }
+}
+
+TEST_F(BatchMathTest, transformPointsTest) {
+    constexpr size_t Count = 7;
+    const glm::mat4 m = createMatrix(1.0f);
+    const std::vector<Vertex> src = createVertices(Count);
+    for (SimdLevel level : getLevels()) {
+        BatchMath::setActiveLevel(level);
+        std::vector<Vertex> dst = createVertices(Count);
+        BatchMath::transformPoints(m, src[0].Pos, sizeof(Vertex), dst[0].Pos, sizeof(Vertex), Count);
+        for (size_t i = 0; i < Count; ++i) {
+            const glm::vec4 expected = m * glm::vec4(src[i].Pos[0], src[i].Pos[1], src[i].Pos[2], 1.0f);
+            EXPECT_NEAR(expected.x, dst[i].Pos[0], 1e-3f) << BatchMath::getLevelName(level);
+            EXPECT_NEAR(expected.y, dst[i].Pos[1], 1e-3f);
+            EXPECT_NEAR(expected.z, dst[i].Pos[2], 1e-3f);
+            EXPECT_EQ(12345.0f, dst[i].Pad[0]);
+        }
+    }
+}
+
+TEST_F(BatchMathTest, computeBoundsTest) {
+    // The packed array ends with the last position, so it must not be overread
+    for (size_t count = 1; count < 6; ++count) {
+        std::vector<f32> packed;
+        for (size_t i = 0; i < count; ++i) {
+            packed.push_back(static_cast<f32>(i));
+            packed.push_back(-static_cast<f32>(i) * 2.0f);
+            packed.push_back(i % 2 == 0 ? 1.0f : -1.0f);
+        }
+
+        for (SimdLevel level : getLevels()) {
+            BatchMath::setActiveLevel(level);
+            glm::vec3 min, max;
+            ASSERT_TRUE(BatchMath::computeBounds(packed.data(), 3 * sizeof(f32), count, min, max));
+            EXPECT_FLOAT_EQ(0.0f, min.x) << BatchMath::getLevelName(level);
+            EXPECT_FLOAT_EQ(static_cast<f32>(count - 1), max.x);
+            EXPECT_FLOAT_EQ(-static_cast<f32>(count - 1) * 2.0f, min.y);
+            EXPECT_FLOAT_EQ(0.0f, max.y);
+            EXPECT_FLOAT_EQ(count > 1 ? -1.0f : 1.0f, min.z);
+            EXPECT_FLOAT_EQ(1.0f, max.z);
+        }
+    }
+
+    glm::vec3 min, max;
+    EXPECT_FALSE(BatchMath::computeBounds(nullptr, 12, 1, min, max));
+}
+
+TEST_F(BatchMathTest, mapToClipSpaceTest) {
+    for (SimdLevel level : getLevels()) {
+        BatchMath::setActiveLevel(level);
+        std::vector<Vertex> vertices(7);
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            vertices[i].Pos[0] = static_cast<f32>(i) * 100.0f;
+            vertices[i].Pos[1] = static_cast<f32>(i) * 50.0f;
+            vertices[i].Pos[2] = -1.0f;
+        }
+        BatchMath::mapToClipSpace(vertices[0].Pos, sizeof(Vertex), vertices.size(), 600.0f, 300.0f);
+        for (size_t i = 0; i < vertices.size(); ++i) {
+            EXPECT_NEAR(static_cast<f32>(i) / 3.0f - 1.0f, vertices[i].Pos[0], 1e-5f) << BatchMath::getLevelName(level);
+            EXPECT_NEAR(1.0f - static_cast<f32>(i) / 3.0f, vertices[i].Pos[1], 1e-5f);
+            EXPECT_EQ(-1.0f, vertices[i].Pos[2]);
+        }
+    }
+}
+
+TEST_F(BatchMathTest, interleaveVerticesTest) {
+    // The colors are stored with alpha, the texture coordinates with three components
+    constexpr size_t Count = 5;
+    std::vector<f32> positions, normals, colors, texCoords;
+    for (size_t i = 0; i < Count; ++i) {
+        const f32 t = static_cast<f32>(i);
+        positions.insert(positions.end(), { t, t + 0.1f, t + 0.2f });
+        normals.insert(normals.end(), { -t, -t - 0.1f, -t - 0.2f });
+        colors.insert(colors.end(), { t * 0.1f, t * 0.2f, t * 0.3f, 1.0f });
+        texCoords.insert(texCoords.end(), { t * 0.5f, t * 0.25f, 7.0f });
+    }
+
+    for (SimdLevel level : getLevels()) {
+        BatchMath::setActiveLevel(level);
+
+        // Twelve floats per vertex, the last one must not be touched
+        std::vector<f32> vertices(Count * 12, 12345.0f);
+        VertexStreams streams;
+        streams.Positions = positions.data();
+        streams.Normals = normals.data();
+        streams.Colors = colors.data();
+        streams.ColorStride = 4 * sizeof(f32);
+        streams.TexCoords = texCoords.data();
+        streams.TexCoordStride = 3 * sizeof(f32);
+        BatchMath::interleaveVertices(streams, vertices.data(), 12 * sizeof(f32), Count);
+        for (size_t i = 0; i < Count; ++i) {
+            const f32 *v = &vertices[i * 12];
+            for (size_t c = 0; c < 3; ++c) {
+                EXPECT_EQ(positions[i * 3 + c], v[c]) << BatchMath::getLevelName(level);
+                EXPECT_EQ(normals[i * 3 + c], v[3 + c]);
+                EXPECT_EQ(colors[i * 4 + c], v[6 + c]);
+            }
+            EXPECT_EQ(texCoords[i * 3], v[9]);
+            EXPECT_EQ(texCoords[i * 3 + 1], v[10]);
+            EXPECT_EQ(12345.0f, v[11]);
+        }
+
+        // Missing streams are written as zero, a color stride of 0 repeats the first color
+        streams.Normals = nullptr;
+        streams.TexCoords = nullptr;
+        streams.ColorStride = 0;
+        BatchMath::interleaveVertices(streams, vertices.data(), 12 * sizeof(f32), Count);
+        const f32 *last = &vertices[(Count - 1) * 12];
+        EXPECT_EQ(positions[(Count - 1) * 3], last[0]);
+        EXPECT_EQ(0.0f, last[3]);
+        EXPECT_EQ(colors[1], last[7]);
+        EXPECT_EQ(0.0f, last[10]);
+    }
+}
+
+TEST_F(BatchMathTest, lerpVectorsTest) {
+    // Long enough for the wide kernels and their remainder
+    constexpr size_t Count = 19;
+    std::vector<glm::vec3> source, start;
+    std::vector<f32> mask;
+    for (size_t i = 0; i < Count; ++i) {
+        const f32 t = static_cast<f32>(i);
+        start.emplace_back(t, -t, 1.0f);
+        source.emplace_back(t * 2.0f, t, 3.0f);
+        mask.push_back(static_cast<f32>(i % 5) * 0.25f);
+    }
+
+    for (SimdLevel level : getLevels()) {
+        BatchMath::setActiveLevel(level);
+        std::vector<glm::vec3> uniform = start, masked = start;
+        BatchMath::lerpVectors(uniform.data(), source.data(), 0.5f, nullptr, Count);
+        BatchMath::lerpVectors(masked.data(), source.data(), 0.5f, mask.data(), Count);
+        for (size_t i = 0; i < Count; ++i) {
+            const glm::vec3 expectedUniform = start[i] + (source[i] - start[i]) * 0.5f;
+            const glm::vec3 expectedMasked = start[i] + (source[i] - start[i]) * (0.5f * mask[i]);
+            for (glm::length_t c = 0; c < 3; ++c) {
+                EXPECT_NEAR(expectedUniform[c], uniform[i][c], 1e-5f) << BatchMath::getLevelName(level);
+                EXPECT_NEAR(expectedMasked[c], masked[i][c], 1e-5f) << BatchMath::getLevelName(level);
+            }
+        }
+    }
+}
+
+TEST_F(BatchMathTest, nlerpRotationsTest) {
+    // Every third source rotation is in the other hemisphere, the shortest path must be taken
+    constexpr size_t Count = 19;
+    std::vector<glm::quat> source, start;
+    std::vector<f32> mask;
+    for (size_t i = 0; i < Count; ++i) {
+        const f32 t = static_cast<f32>(i);
+        start.push_back(glm::angleAxis(t * 0.1f, glm::normalize(glm::vec3(1.0f, t, 0.5f))));
+        const glm::quat target = glm::angleAxis(1.0f - t * 0.05f, glm::vec3(0.0f, 1.0f, 0.0f));
+        source.push_back(i % 3 == 0 ? -target : target);
+        mask.push_back(static_cast<f32>(i % 5) * 0.25f);
+    }
+
+    for (SimdLevel level : getLevels()) {
+        BatchMath::setActiveLevel(level);
+        std::vector<glm::quat> uniform = start, masked = start;
+        BatchMath::nlerpRotations(uniform.data(), source.data(), 0.3f, nullptr, Count);
+        BatchMath::nlerpRotations(masked.data(), source.data(), 0.3f, mask.data(), Count);
+        for (size_t i = 0; i < Count; ++i) {
+            const f32 sign = glm::dot(start[i], source[i]) < 0.0f ? -1.0f : 1.0f;
+            const f32 w = 0.3f * mask[i];
+            const glm::quat expectedUniform = glm::normalize(start[i] * 0.7f + source[i] * (sign * 0.3f));
+            const glm::quat expectedMasked = glm::normalize(start[i] * (1.0f - w) + source[i] * (sign * w));
+            EXPECT_NEAR(expectedUniform.x, uniform[i].x, 1e-5f) << BatchMath::getLevelName(level);
+            EXPECT_NEAR(expectedUniform.y, uniform[i].y, 1e-5f);
+            EXPECT_NEAR(expectedUniform.z, uniform[i].z, 1e-5f);
+            EXPECT_NEAR(expectedUniform.w, uniform[i].w, 1e-5f);
+            EXPECT_NEAR(expectedMasked.x, masked[i].x, 1e-5f) << BatchMath::getLevelName(level);
+            EXPECT_NEAR(expectedMasked.y, masked[i].y, 1e-5f);
+            EXPECT_NEAR(expectedMasked.z, masked[i].z, 1e-5f);
+            EXPECT_NEAR(expectedMasked.w, masked[i].w, 1e-5f);
+        }
+    }
+}
+
+} // namespace UnitTest
+} // namespace OSRE
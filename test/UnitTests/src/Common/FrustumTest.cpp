@@ -73,6 +73,18 @@ TEST_F(FrustumTest, extractFromTest) {
     EXPECT_FALSE(result);
 }
 
+TEST_F(FrustumTest, isSphereInTest) {
+    Frustum f;
+    glm::mat4 p = glm::perspective(1.2f, 1.f, 0.1f, 100.0f);
+    glm::mat4 v = glm::lookAt(glm::vec3(0, 0, 10), glm::vec3(0, 0, 20), glm::vec3(0, 1, 0));
+    f.extractFrom(p * v);
+    EXPECT_TRUE(f.isIn(glm::vec3(0, 0, 20), 1.0f));
+
+    // Behind the near plane, the radius decides
+    EXPECT_FALSE(f.isIn(glm::vec3(0, 0, 8), 1.0f));
+    EXPECT_TRUE(f.isIn(glm::vec3(0, 0, 8), 3.0f));
+}
+
 } // namespace UnitTest
 } // namespace OSRE
 
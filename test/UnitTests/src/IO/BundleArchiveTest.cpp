@@ -0,0 +1,211 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "IO/BundleArchive.h"
+#include "IO/BundleFileSystem.h"
+#include "IO/IOService.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::IO;
+
+class BundleArchiveTest : public ::testing::Test {
+protected:
+    static const c8 *ArchiveFile;
+
+    void TearDown() override {
+        ::remove(ArchiveFile);
+    }
+
+    // Repetitive content, so it can be compressed
+    static String createText() {
+        String text;
+        for (i32 i = 0; i < 64; ++i) {
+            text += "v 0.0 1.0 2.0\n";
+        }
+
+        return text;
+    }
+
+    static bool writeArchive() {
+        const String text = createText();
+        static const uc8 Random[] = { 7, 1, 9, 3 };
+        BundleArchiveWriter writer;
+        bool ok = writer.add("models/x.osb", text.c_str(), text.size(), BundleCompression::Deflate);
+        ok = ok && writer.add("textures/a.raw", Random, sizeof(Random), BundleCompression::Deflate);
+        ok = ok && writer.add("empty.txt", nullptr, 0, BundleCompression::None);
+        ok = ok && !writer.add("models/x.osb", Random, sizeof(Random), BundleCompression::None);
+        ok = ok && 3u == writer.getNumEntries();
+
+        return ok && writer.write(ArchiveFile);
+    }
+};
+
+const c8 *BundleArchiveTest::ArchiveFile = "bundle_archive_test.osbundle";
+
+TEST_F(BundleArchiveTest, readTest) {
+    ASSERT_TRUE(writeArchive());
+
+    BundleArchive archive;
+    ASSERT_TRUE(archive.open(ArchiveFile));
+    ASSERT_EQ(3u, archive.getNumEntries());
+    EXPECT_EQ(String("empty.txt"), archive.getName(archive.getEntry(0)));
+    EXPECT_EQ(nullptr, archive.find("models/y.osb"));
+    EXPECT_EQ(nullptr, archive.find("models"));
+
+    const String text = createText();
+    const BundleEntry *model = archive.find("models/x.osb");
+    ASSERT_NE(nullptr, model);
+    EXPECT_EQ(static_cast<ui32>(BundleCompression::Deflate), model->Compression);
+    EXPECT_LT(model->Size, model->UncompressedSize);
+    EXPECT_EQ(0u, model->Offset % BundleArchiveWriter::DefaultAlignment);
+    ASSERT_EQ(text.size(), model->UncompressedSize);
+    std::vector<uc8> buffer(text.size());
+    EXPECT_FALSE(archive.read(*model, buffer.data(), buffer.size() - 1));
+    ASSERT_TRUE(archive.read(*model, buffer.data(), buffer.size()));
+    EXPECT_EQ(0, ::memcmp(text.c_str(), buffer.data(), text.size()));
+
+    // Data which does not get smaller is stored and can be used from the mapping
+    const BundleEntry *raw = archive.find("textures/a.raw");
+    ASSERT_NE(nullptr, raw);
+    EXPECT_EQ(static_cast<ui32>(BundleCompression::None), raw->Compression);
+    ASSERT_EQ(4u, raw->Size);
+    EXPECT_EQ(9, archive.getData(*raw)[2]);
+
+    const BundleEntry *empty = archive.find("empty.txt");
+    ASSERT_NE(nullptr, empty);
+    EXPECT_EQ(0u, empty->UncompressedSize);
+    EXPECT_TRUE(archive.read(*empty, nullptr, 0));
+
+    archive.close();
+    EXPECT_FALSE(archive.isOpen());
+    EXPECT_EQ(nullptr, archive.find("empty.txt"));
+}
+
+TEST_F(BundleArchiveTest, rejectCorruptTest) {
+    ASSERT_TRUE(writeArchive());
+
+    FILE *file = ::fopen(ArchiveFile, "rb");
+    ASSERT_NE(nullptr, file);
+    ::fseek(file, 0, SEEK_END);
+    const long size = ::ftell(file);
+    ::fseek(file, 0, SEEK_SET);
+    std::vector<c8> content(static_cast<size_t>(size));
+    ASSERT_EQ(content.size(), ::fread(content.data(), 1, content.size(), file));
+    ::fclose(file);
+
+    // Truncate the data of the last entry
+    file = ::fopen(ArchiveFile, "wb");
+    ASSERT_NE(nullptr, file);
+    ::fwrite(content.data(), 1, content.size() - 2, file);
+    ::fclose(file);
+
+    BundleArchive archive;
+    EXPECT_FALSE(archive.open(ArchiveFile));
+    EXPECT_FALSE(archive.isOpen());
+    EXPECT_FALSE(archive.open("does_not_exist.osbundle"));
+}
+
+TEST_F(BundleArchiveTest, fileSystemTest) {
+    ASSERT_TRUE(writeArchive());
+
+    BundleFileSystem fs;
+    EXPECT_EQ(String("bundle"), String(fs.getSchema()));
+    ASSERT_TRUE(fs.mount("pack", ArchiveFile));
+    EXPECT_FALSE(fs.mount("pack", ArchiveFile));
+    EXPECT_NE(nullptr, fs.getArchive("pack"));
+
+    String bundle, entry;
+    ASSERT_TRUE(BundleFileSystem::splitUri(Uri("bundle://pack/models/x.osb"), bundle, entry));
+    EXPECT_EQ(String("pack"), bundle);
+    EXPECT_EQ(String("models/x.osb"), entry);
+    EXPECT_TRUE(fs.fileExist(Uri("bundle://pack/models/x.osb")));
+    EXPECT_FALSE(fs.fileExist(Uri("bundle://other/models/x.osb")));
+    EXPECT_FALSE(fs.fileExist(Uri("bundle://pack/models/y.osb")));
+    EXPECT_EQ(nullptr, fs.open(Uri("bundle://pack/models/x.osb"), Stream::AccessMode::WriteAccess));
+
+    const String text = createText();
+    Stream *stream = fs.open(Uri("bundle://pack/models/x.osb"), Stream::AccessMode::ReadAccessBinary);
+    ASSERT_NE(nullptr, stream);
+    EXPECT_TRUE(stream->isOpen());
+    EXPECT_FALSE(stream->canBeMapped());
+    ASSERT_EQ(text.size(), stream->getSize());
+    c8 line[14];
+    EXPECT_EQ(sizeof(line), stream->read(line, sizeof(line)));
+    EXPECT_EQ(0, ::memcmp(text.c_str(), line, sizeof(line)));
+    EXPECT_EQ(sizeof(line), stream->tell());
+    EXPECT_EQ(text.size() - 2, stream->seek(2, Stream::Origin::End));
+    EXPECT_EQ(2u, stream->read(line, sizeof(line)));
+    EXPECT_EQ('\n', line[1]);
+    fs.close(&stream);
+    EXPECT_EQ(nullptr, stream);
+
+    StringArray searchPaths;
+    searchPaths.add("other/textures/");
+    searchPaths.add("pack/textures/");
+    stream = fs.find(Uri("bundle://a.raw"), Stream::AccessMode::ReadAccessBinary, &searchPaths);
+    ASSERT_NE(nullptr, stream);
+    EXPECT_TRUE(stream->canBeMapped());
+    ui32 value = 0;
+    EXPECT_EQ(sizeof(ui32), stream->readUI32(value));
+    EXPECT_EQ(0, ::memcmp(&value, static_cast<BundleStream *>(stream)->getData(), sizeof(ui32)));
+    fs.close(&stream);
+
+    fs.unmount("pack");
+    EXPECT_EQ(nullptr, fs.getArchive("pack"));
+    EXPECT_FALSE(fs.fileExist(Uri("bundle://pack/models/x.osb")));
+}
+
+TEST_F(BundleArchiveTest, ioServiceTest) {
+    ASSERT_TRUE(writeArchive());
+
+    IOService *ioService = IOService::create();
+    EXPECT_FALSE(ioService->mountBundle("pack", ArchiveFile));
+    ASSERT_TRUE(ioService->open());
+    ASSERT_NE(nullptr, ioService->getBundleFileSystem());
+    EXPECT_EQ(ioService->getBundleFileSystem(), ioService->getFileSystem("bundle"));
+    EXPECT_FALSE(ioService->mountBundle("pack", "does_not_exist.osbundle"));
+    ASSERT_TRUE(ioService->mountBundle("pack", ArchiveFile));
+    EXPECT_EQ(String(ArchiveFile), ioService->getBundleFileSystem()->getArchive("pack")->getFilename());
+
+    // The entries are opened by their uri
+    const Uri uri("bundle://pack/models/x.osb");
+    EXPECT_TRUE(ioService->fileExists(uri));
+    Stream *stream = ioService->openStream(uri, Stream::AccessMode::ReadAccessBinary);
+    ASSERT_NE(nullptr, stream);
+    EXPECT_EQ(createText().size(), stream->getSize());
+    ioService->closeStream(&stream);
+
+    ioService->unmountBundle("pack");
+    EXPECT_FALSE(ioService->fileExists(uri));
+    ioService->close();
+    EXPECT_EQ(nullptr, ioService->getBundleFileSystem());
+    ioService->release();
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
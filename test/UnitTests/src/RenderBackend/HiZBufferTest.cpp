@@ -0,0 +1,86 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "RenderBackend/HiZBuffer.h"
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+using namespace ::OSRE::Common;
+
+class HiZBufferTest : public ::testing::Test {
+protected:
+    static constexpr ui32 Size = 64;
+
+    cppcore::TArray<f32> mDepth;
+
+    void SetUp() override {
+        // An occluder at window depth 0.5 covers the left half, the right half is empty
+        mDepth.resize(Size * Size);
+        for (ui32 y = 0; y < Size; ++y) {
+            for (ui32 x = 0; x < Size; ++x) {
+                mDepth[y * Size + x] = x < Size / 2 ? 0.5f : 1.0f;
+            }
+        }
+    }
+};
+
+TEST_F(HiZBufferTest, buildTest) {
+    HiZBuffer buffer;
+    EXPECT_FALSE(buffer.isValid());
+
+    buffer.build(&mDepth[0], Size, Size, glm::mat4(1.0f));
+    EXPECT_TRUE(buffer.isValid());
+    EXPECT_EQ(7u, buffer.getNumLevels());
+
+    buffer.clear();
+    EXPECT_FALSE(buffer.isValid());
+}
+
+TEST_F(HiZBufferTest, isVisibleTest) {
+    HiZBuffer buffer;
+
+    // Without a pyramid nothing can be culled
+    AABB behind(glm::vec3(-0.9f, -0.5f, 0.5f), glm::vec3(-0.2f, 0.5f, 0.8f));
+    EXPECT_TRUE(buffer.isVisible(behind));
+
+    // With the identity the boxes are given in normalized device coordinates
+    buffer.build(&mDepth[0], Size, Size, glm::mat4(1.0f));
+    EXPECT_FALSE(buffer.isVisible(behind));
+
+    AABB inFront(glm::vec3(-0.9f, -0.5f, -0.5f), glm::vec3(-0.2f, 0.5f, -0.2f));
+    EXPECT_TRUE(buffer.isVisible(inFront));
+
+    AABB behindEmpty(glm::vec3(0.2f, -0.5f, 0.5f), glm::vec3(0.9f, 0.5f, 0.8f));
+    EXPECT_TRUE(buffer.isVisible(behindEmpty));
+
+    AABB overlapping(glm::vec3(-0.5f, -0.5f, 0.5f), glm::vec3(0.5f, 0.5f, 0.8f));
+    EXPECT_TRUE(buffer.isVisible(overlapping));
+
+    AABB outside(glm::vec3(1.5f, 1.5f, 0.5f), glm::vec3(2.0f, 2.0f, 0.8f));
+    EXPECT_TRUE(buffer.isVisible(outside));
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
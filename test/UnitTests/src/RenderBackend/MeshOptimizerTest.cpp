@@ -0,0 +1,146 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "RenderBackend/Mesh/MeshOptimizer.h"
+#include "RenderBackend/Mesh.h"
+#include "RenderBackend/MeshProcessor.h"
+#include "RenderBackend/TestGrid.h"
+
+#include <algorithm>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class MeshOptimizerTest : public ::testing::Test {
+protected:
+    static constexpr ui32 GridSize = 33;
+
+    cppcore::TArray<RenderVert> mVertices;
+    cppcore::TArray<ui32> mIndices;
+
+    void SetUp() override {
+        // The triangles are scattered over the grid, so the input order has no locality
+        cppcore::TArray<glm::vec3> positions;
+        createGrid(GridSize, 577, positions, mIndices);
+        mVertices.resize(positions.size());
+        for (size_t i = 0; i < positions.size(); ++i) {
+            mVertices[i].position = positions[i];
+        }
+    }
+
+    static cppcore::TArray<ui64> getSortedTriangles(const cppcore::TArray<ui32> &indices) {
+        cppcore::TArray<ui64> triangles;
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            ui32 tri[3] = { indices[i], indices[i + 1], indices[i + 2] };
+            std::rotate(tri, std::min_element(tri, tri + 3), tri + 3);
+            triangles.add((static_cast<ui64>(tri[0]) << 42) | (static_cast<ui64>(tri[1]) << 21) | tri[2]);
+        }
+        std::sort(triangles.begin(), triangles.end());
+
+        return triangles;
+    }
+};
+
+TEST_F(MeshOptimizerTest, analyzeVertexCacheTest) {
+    const ui32 indices[6] = { 0, 1, 2, 2, 1, 3 };
+    const VertexCacheStatistics stats = MeshOptimizer::analyzeVertexCache(indices, 6, 4);
+    EXPECT_EQ(4u, stats.mNumTransforms);
+    EXPECT_EQ(2u, stats.mNumTriangles);
+    EXPECT_EQ(4u, stats.mNumVertices);
+    EXPECT_FLOAT_EQ(2.0f, stats.mAcmr);
+    EXPECT_FLOAT_EQ(1.0f, stats.mAtvr);
+
+    const ui32 invalid[3] = { 0, 1, 7 };
+    EXPECT_EQ(0u, MeshOptimizer::analyzeVertexCache(invalid, 3, 4).mNumTriangles);
+}
+
+TEST_F(MeshOptimizerTest, optimizeVertexCacheTest) {
+    const cppcore::TArray<ui64> source = getSortedTriangles(mIndices);
+    const VertexCacheStatistics before = MeshOptimizer::analyzeVertexCache(&mIndices[0], mIndices.size(), mVertices.size());
+    MeshOptimizer::optimizeVertexCache(&mIndices[0], mIndices.size(), mVertices.size());
+    const VertexCacheStatistics after = MeshOptimizer::analyzeVertexCache(&mIndices[0], mIndices.size(), mVertices.size());
+
+    EXPECT_TRUE(source == getSortedTriangles(mIndices));
+    EXPECT_LT(after.mAcmr, before.mAcmr);
+    EXPECT_LT(after.mAcmr, 0.9f);
+    EXPECT_GE(after.mAtvr, 1.0f);
+}
+
+TEST_F(MeshOptimizerTest, optimizeOverdrawTest) {
+    MeshOptimizer::optimizeVertexCache(&mIndices[0], mIndices.size(), mVertices.size());
+    const cppcore::TArray<ui64> source = getSortedTriangles(mIndices);
+    const VertexCacheStatistics before = MeshOptimizer::analyzeVertexCache(&mIndices[0], mIndices.size(), mVertices.size());
+    MeshOptimizer::optimizeOverdraw(&mIndices[0], mIndices.size(), reinterpret_cast<const c8 *>(&mVertices[0]),
+            mVertices.size(), sizeof(RenderVert), 1.05f);
+    const VertexCacheStatistics after = MeshOptimizer::analyzeVertexCache(&mIndices[0], mIndices.size(), mVertices.size());
+
+    EXPECT_TRUE(source == getSortedTriangles(mIndices));
+    EXPECT_LT(after.mAcmr, before.mAcmr * 1.2f);
+}
+
+TEST_F(MeshOptimizerTest, optimizeVertexFetchTest) {
+    cppcore::TArray<glm::vec3> positions;
+    for (size_t i = 0; i < mIndices.size(); ++i) {
+        positions.add(mVertices[mIndices[i]].position);
+    }
+
+    const size_t numUsed = MeshOptimizer::optimizeVertexFetch(reinterpret_cast<c8 *>(&mVertices[0]), mVertices.size(),
+            sizeof(RenderVert), &mIndices[0], mIndices.size());
+    EXPECT_EQ(mVertices.size(), numUsed);
+
+    // The vertices are stored in the order of their first use
+    ui32 next = 0;
+    for (size_t i = 0; i < mIndices.size(); ++i) {
+        EXPECT_EQ(positions[i], mVertices[mIndices[i]].position);
+        EXPECT_LE(mIndices[i], next);
+        next = std::max(next, mIndices[i] + 1);
+    }
+}
+
+TEST_F(MeshOptimizerTest, optimizeMeshTest) {
+    cppcore::TArray<ui16> indices;
+    for (size_t i = 0; i < mIndices.size(); ++i) {
+        indices.add(static_cast<ui16>(mIndices[i]));
+    }
+
+    Mesh mesh("grid", VertexType::RenderVertex, IndexType::UnsignedShort);
+    mesh.createVertexBuffer(&mVertices[0], mVertices.size() * sizeof(RenderVert), BufferAccessType::ReadOnly);
+    mesh.createIndexBuffer(&indices[0], indices.size() * sizeof(ui16), IndexType::UnsignedShort, BufferAccessType::ReadOnly);
+    mesh.addPrimitiveGroup(indices.size(), PrimitiveType::TriangleList, 0);
+
+    MeshOptimizationReport report;
+    EXPECT_TRUE(MeshProcessor::optimizeVertexCache(&mesh, &report));
+    EXPECT_LT(report.mAfter.mAcmr, report.mBefore.mAcmr);
+    EXPECT_TRUE(MeshProcessor::optimizeOverdraw(&mesh, 1.05f, &report));
+    EXPECT_TRUE(MeshProcessor::optimizeVertexFetch(&mesh, &report));
+    EXPECT_FLOAT_EQ(report.mBefore.mAcmr, report.mAfter.mAcmr);
+
+    Mesh empty("empty", VertexType::RenderVertex, IndexType::UnsignedShort);
+    EXPECT_FALSE(MeshProcessor::optimizeVertexCache(&empty));
+    EXPECT_FALSE(MeshProcessor::optimizeVertexCache(nullptr));
+}
+
+} // namespace UnitTest
+} // namespace OSRE
@@ -0,0 +1,102 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "RenderBackend/Mesh/MeshSimplifier.h"
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class MeshSimplifierTest : public ::testing::Test {
+protected:
+    static constexpr ui32 GridSize = 33;
+
+    cppcore::TArray<RenderVert> mVertices;
+    cppcore::TArray<ui32> mIndices;
+
+    void SetUp() override {
+        // A flat grid, all inner vertices can be removed without any error
+        mVertices.resize(GridSize * GridSize);
+        for (ui32 y = 0; y < GridSize; ++y) {
+            for (ui32 x = 0; x < GridSize; ++x) {
+                mVertices[y * GridSize + x].position = glm::vec3(static_cast<f32>(x), static_cast<f32>(y), 0.0f);
+            }
+        }
+
+        for (ui32 y = 0; y < GridSize - 1; ++y) {
+            for (ui32 x = 0; x < GridSize - 1; ++x) {
+                const ui32 i = y * GridSize + x;
+                mIndices.add(i);
+                mIndices.add(i + 1);
+                mIndices.add(i + GridSize);
+                mIndices.add(i + 1);
+                mIndices.add(i + GridSize + 1);
+                mIndices.add(i + GridSize);
+            }
+        }
+    }
+
+    const c8 *getVertexData() const {
+        return reinterpret_cast<const c8 *>(&mVertices[0]);
+    }
+};
+
+TEST_F(MeshSimplifierTest, simplifyPlaneTest) {
+    cppcore::TArray<ui32> result;
+    const size_t target = mIndices.size() / 2;
+    const f32 error = MeshSimplifier::simplify(getVertexData(), mVertices.size(), sizeof(RenderVert),
+            &mIndices[0], mIndices.size(), target, result);
+
+    EXPECT_FALSE(result.isEmpty());
+    EXPECT_LE(result.size(), target);
+    EXPECT_EQ(0u, result.size() % 3);
+    EXPECT_NEAR(0.0f, error, 0.0001f);
+    for (size_t i = 0; i < result.size(); i += 3) {
+        EXPECT_LT(result[i], mVertices.size());
+        EXPECT_NE(result[i], result[i + 1]);
+        EXPECT_NE(result[i + 1], result[i + 2]);
+        EXPECT_NE(result[i], result[i + 2]);
+    }
+}
+
+TEST_F(MeshSimplifierTest, generateLodChainTest) {
+    const size_t numIndices = mIndices.size();
+    MeshLodArray lods;
+    const size_t numLods = MeshSimplifier::generateLodChain(getVertexData(), mVertices.size(), sizeof(RenderVert),
+            mIndices, lods);
+
+    EXPECT_GE(numLods, 2u);
+    EXPECT_EQ(numLods, lods.size());
+    EXPECT_EQ(0u, lods[0].mStartIndex);
+    EXPECT_EQ(numIndices, lods[0].mNumIndices);
+    for (size_t i = 1; i < lods.size(); ++i) {
+        EXPECT_EQ(lods[i - 1].mStartIndex + lods[i - 1].mNumIndices, lods[i].mStartIndex);
+        EXPECT_LT(lods[i].mNumIndices, lods[i - 1].mNumIndices);
+        EXPECT_GE(lods[i].mError, lods[i - 1].mError);
+    }
+    EXPECT_EQ(lods[numLods - 1].mStartIndex + lods[numLods - 1].mNumIndices, mIndices.size());
+}
+
+} // namespace UnitTest
+} // namespace OSRE
@@ -41,5 +41,51 @@ TEST_F(MeshTest, createPrimitiveGroupsTest) {
     delete mesh;
 }
 
+TEST_F(MeshTest, cachedAABBTest) {
+    Mesh *mesh = new Mesh("test", VertexType::RenderVertex, IndexType::UnsignedShort);
+    EXPECT_FALSE(mesh->getAABB().isValid());
+
+    RenderVert vertices[3];
+    vertices[0].position = glm::vec3(-1, 0, 0);
+    vertices[1].position = glm::vec3(1, 2, 0);
+    vertices[2].position = glm::vec3(0, 0, 3);
+    mesh->createVertexBuffer(vertices, sizeof(vertices), BufferAccessType::ReadOnly);
+    const Common::AABB &aabb = mesh->getAABB();
+    EXPECT_EQ(glm::vec3(-1, 0, 0), aabb.getMin());
+    EXPECT_EQ(glm::vec3(1, 2, 3), aabb.getMax());
+
+    RenderVert *vb = reinterpret_cast<RenderVert *>(mesh->getVertexBuffer()->getData());
+    vb[0].position = glm::vec3(-5, 0, 0);
+    mesh->invalidateAABB();
+    EXPECT_EQ(glm::vec3(-5, 0, 0), mesh->getAABB().getMin());
+
+    delete mesh;
+}
+
+TEST_F(MeshTest, selectLodTest) {
+    Mesh *mesh = new Mesh("test", VertexType::RenderVertex, IndexType::UnsignedInt);
+    mesh->addPrimitiveGroup(300, PrimitiveType::TriangleList, 0);
+    MeshLodArray lods;
+    lods.add({ 0u, 300u, 0.0f });
+    lods.add({ 300u, 150u, 0.1f });
+    lods.add({ 450u, 75u, 1.0f });
+    mesh->setLods(lods);
+    EXPECT_EQ(3u, mesh->getNumLods());
+
+    // 10 pixels per unit: level 1 projects to 1 pixel, but must stay below the hysteresis band to get selected
+    EXPECT_EQ(0u, mesh->selectLod(10.0f, 1.0f, 0.25f));
+    EXPECT_EQ(1u, mesh->selectLod(5.0f, 1.0f, 0.25f));
+    EXPECT_TRUE(mesh->setActiveLod(1));
+    EXPECT_EQ(300u, mesh->getPrimitiveGroupAt(0)->m_startIndex);
+    EXPECT_EQ(150u, mesh->getPrimitiveGroupAt(0)->m_numIndices);
+
+    // Once active, the level will be kept up to the threshold
+    EXPECT_EQ(1u, mesh->selectLod(10.0f, 1.0f, 0.25f));
+    EXPECT_EQ(0u, mesh->selectLod(20.0f, 1.0f, 0.25f));
+    EXPECT_FALSE(mesh->setActiveLod(1));
+
+    delete mesh;
+}
+
 }
 }
@@ -0,0 +1,221 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "RenderBackend/Mesh/MeshletBuilder.h"
+#include "RenderBackend/Mesh/MeshOptimizer.h"
+#include "RenderBackend/Mesh.h"
+#include "RenderBackend/MeshProcessor.h"
+#include "RenderBackend/TestGrid.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Common;
+using namespace ::OSRE::RenderBackend;
+
+class MeshletBuilderTest : public ::testing::Test {
+protected:
+    static constexpr ui32 GridSize = 65;
+
+    cppcore::TArray<glm::vec3> mPositions;
+    cppcore::TArray<ui32> mIndices;
+
+    void SetUp() override {
+        createGrid(GridSize, 1, mPositions, mIndices);
+        MeshOptimizer::optimizeVertexCache(&mIndices[0], mIndices.size(), mPositions.size());
+    }
+
+    static Frustum getFrustum(const glm::vec3 &eye, const glm::vec3 &center) {
+        const glm::mat4 p = glm::perspective(1.2f, 1.f, 0.1f, 1000.0f);
+        const glm::mat4 v = glm::lookAt(eye, center, glm::vec3(0, 1, 0));
+        Frustum frustum;
+        frustum.extractFrom(p * v);
+
+        return frustum;
+    }
+};
+
+TEST_F(MeshletBuilderTest, buildTest) {
+    cppcore::TArray<ui32> source = mIndices;
+    MeshletArray meshlets;
+    const size_t numMeshlets = MeshletBuilder::build(&mIndices[0], mIndices.size(), &mPositions[0], mPositions.size(), 0, meshlets);
+    ASSERT_EQ(numMeshlets, meshlets.size());
+
+    // The meshlets cover the index buffer without gaps and keep the limits
+    const size_t numTriangles = mIndices.size() / 3;
+    EXPECT_GE(numMeshlets, numTriangles / MeshletBuilder::MaxTriangles);
+    ui32 next = 0;
+    for (size_t i = 0; i < meshlets.size(); ++i) {
+        const Meshlet &meshlet = meshlets[i];
+        EXPECT_EQ(next, meshlet.mStartIndex);
+        EXPECT_LE(meshlet.mNumIndices, MeshletBuilder::MaxTriangles * 3);
+        EXPECT_LE(meshlet.mNumVertices, MeshletBuilder::MaxVertices);
+
+        cppcore::TArray<ui32> vertices;
+        for (ui32 j = 0; j < meshlet.mNumIndices; ++j) {
+            vertices.add(mIndices[meshlet.mStartIndex + j]);
+        }
+        std::sort(vertices.begin(), vertices.end());
+        EXPECT_EQ(meshlet.mNumVertices, static_cast<ui32>(std::unique(vertices.begin(), vertices.end()) - vertices.begin()));
+        next += meshlet.mNumIndices;
+    }
+    EXPECT_EQ(mIndices.size(), next);
+
+    // Connected triangles keep the meshlets well filled
+    EXPECT_LT(numMeshlets, numTriangles / 80);
+
+    std::sort(source.begin(), source.end());
+    cppcore::TArray<ui32> result = mIndices;
+    std::sort(result.begin(), result.end());
+    EXPECT_TRUE(source == result);
+
+    EXPECT_EQ(0u, MeshletBuilder::build(nullptr, 0, &mPositions[0], mPositions.size(), 0, meshlets));
+}
+
+TEST_F(MeshletBuilderTest, boundsTest) {
+    MeshletArray meshlets;
+    MeshletBuilder::build(&mIndices[0], mIndices.size(), &mPositions[0], mPositions.size(), 0, meshlets);
+    for (size_t i = 0; i < meshlets.size(); ++i) {
+        const Meshlet &meshlet = meshlets[i];
+        for (ui32 j = 0; j < meshlet.mNumIndices; ++j) {
+            EXPECT_LE(glm::length(mPositions[mIndices[meshlet.mStartIndex + j]] - meshlet.mCenter), meshlet.mRadius + 1e-4f);
+        }
+
+        // A flat meshlet has a cone without spread
+        EXPECT_NEAR(1.0f, meshlet.mConeAxis.z, 1e-4f);
+        EXPECT_NEAR(0.0f, meshlet.mConeCutoff, 1e-3f);
+    }
+}
+
+TEST_F(MeshletBuilderTest, cullTest) {
+    MeshletArray meshlets;
+    MeshletBuilder::build(&mIndices[0], mIndices.size(), &mPositions[0], mPositions.size(), 0, meshlets);
+    const glm::vec3 center(32.0f, 32.0f, 0.0f);
+
+    // The whole grid is seen from the front, one merged draw covers everything
+    glm::vec3 eye(32.0f, 32.0f, 200.0f);
+    DrawIndirectCommandArray commands;
+    EXPECT_EQ(meshlets.size(), MeshletCuller::cull(meshlets, getFrustum(eye, center), eye, commands));
+    ASSERT_EQ(1u, commands.size());
+    EXPECT_EQ(mIndices.size(), commands[0].mCount);
+    EXPECT_EQ(0u, commands[0].mFirstIndex);
+    EXPECT_EQ(1u, commands[0].mInstanceCount);
+
+    // Seen from behind, all meshlets are back-facing
+    eye = glm::vec3(32.0f, 32.0f, -200.0f);
+    EXPECT_EQ(0u, MeshletCuller::cull(meshlets, getFrustum(eye, center), eye, commands));
+    EXPECT_TRUE(commands.isEmpty());
+
+    // Close to a corner only a part is inside of the frustum
+    eye = glm::vec3(4.0f, 4.0f, 5.0f);
+    cppcore::TArray<ui32> visibleIndices;
+    const size_t numVisible = MeshletCuller::cull(meshlets, getFrustum(eye, glm::vec3(4.0f, 4.0f, 0.0f)), eye, &mIndices[0], visibleIndices);
+    EXPECT_GT(numVisible, 0u);
+    EXPECT_LT(numVisible, meshlets.size());
+    EXPECT_GT(visibleIndices.size(), 0u);
+    EXPECT_LT(visibleIndices.size(), mIndices.size());
+    EXPECT_EQ(0u, visibleIndices.size() % 3);
+}
+
+TEST_F(MeshletBuilderTest, buildMeshTest) {
+    cppcore::TArray<RenderVert> vertices;
+    vertices.resize(mPositions.size());
+    for (size_t i = 0; i < mPositions.size(); ++i) {
+        vertices[i].position = mPositions[i];
+    }
+
+    Mesh mesh("grid", VertexType::RenderVertex, IndexType::UnsignedInt);
+    mesh.createVertexBuffer(&vertices[0], vertices.size() * sizeof(RenderVert), BufferAccessType::ReadOnly);
+    mesh.createIndexBuffer(&mIndices[0], mIndices.size() * sizeof(ui32), IndexType::UnsignedInt, BufferAccessType::ReadOnly);
+    mesh.addPrimitiveGroup(mIndices.size(), PrimitiveType::TriangleList, 0);
+
+    MeshletArray meshlets;
+    EXPECT_TRUE(MeshProcessor::buildMeshlets(&mesh, meshlets, 32, 60));
+    ASSERT_FALSE(meshlets.isEmpty());
+    for (size_t i = 0; i < meshlets.size(); ++i) {
+        EXPECT_LE(meshlets[i].mNumVertices, 32u);
+        EXPECT_LE(meshlets[i].mNumIndices, 180u);
+    }
+
+    Mesh empty("empty", VertexType::RenderVertex, IndexType::UnsignedInt);
+    EXPECT_FALSE(MeshProcessor::buildMeshlets(&empty, meshlets));
+    EXPECT_TRUE(meshlets.isEmpty());
+    EXPECT_FALSE(MeshProcessor::buildMeshlets(nullptr, meshlets));
+}
+
+TEST_F(MeshletBuilderTest, cullMeshTest) {
+    cppcore::TArray<RenderVert> vertices;
+    vertices.resize(mPositions.size());
+    for (size_t i = 0; i < mPositions.size(); ++i) {
+        vertices[i].position = mPositions[i];
+    }
+
+    Mesh mesh("grid", VertexType::RenderVertex, IndexType::UnsignedInt);
+    mesh.createVertexBuffer(&vertices[0], vertices.size() * sizeof(RenderVert), BufferAccessType::ReadOnly);
+    mesh.createIndexBuffer(&mIndices[0], mIndices.size() * sizeof(ui32), IndexType::UnsignedInt, BufferAccessType::ReadOnly);
+    mesh.addPrimitiveGroup(mIndices.size(), PrimitiveType::TriangleList, 0);
+    MeshletArray meshlets;
+    ASSERT_TRUE(MeshProcessor::buildMeshlets(&mesh, meshlets));
+    EXPECT_EQ(meshlets.size(), mesh.getMeshlets().size());
+    cppcore::TArray<ui32> source;
+    source.resize(mIndices.size());
+    ::memcpy(&source[0], mesh.getIndexBuffer()->getData(), mIndices.size() * sizeof(ui32));
+
+    // Seen from the front everything is drawn, the same view needs no new upload
+    const glm::vec3 center(32.0f, 32.0f, 0.0f);
+    glm::vec3 eye(32.0f, 32.0f, 200.0f);
+    size_t offset = 0, size = 0;
+    EXPECT_TRUE(mesh.cullMeshlets(getFrustum(eye, center), eye));
+    EXPECT_EQ(mIndices.size(), mesh.getNumDrawnIndices(0));
+    EXPECT_EQ(0u, mesh.getNumDrawnIndices(1));
+    EXPECT_TRUE(mesh.getDirtyDrawnIndices(0, offset, size));
+    EXPECT_EQ(0u, offset);
+    EXPECT_EQ(mIndices.size() * sizeof(ui32), size);
+    mesh.clearDirtyDrawnIndices();
+    EXPECT_FALSE(mesh.cullMeshlets(getFrustum(eye, center), eye));
+    EXPECT_FALSE(mesh.getDirtyDrawnIndices(0, offset, size));
+
+    // Close to a corner only the visible meshlets are packed to the start of the group
+    eye = glm::vec3(4.0f, 4.0f, 5.0f);
+    const Frustum frustum = getFrustum(eye, glm::vec3(4.0f, 4.0f, 0.0f));
+    EXPECT_TRUE(mesh.cullMeshlets(frustum, eye));
+    cppcore::TArray<ui32> visibleIndices;
+    MeshletCuller::cull(mesh.getMeshlets(), frustum, eye, &source[0], visibleIndices);
+    ASSERT_EQ(visibleIndices.size(), mesh.getNumDrawnIndices(0));
+    EXPECT_LT(mesh.getNumDrawnIndices(0), mIndices.size());
+    EXPECT_TRUE(mesh.getDirtyDrawnIndices(0, offset, size));
+    EXPECT_EQ(visibleIndices.size() * sizeof(ui32), size);
+    const ui32 *drawn = reinterpret_cast<const ui32 *>(mesh.getDrawnIndexData());
+    for (size_t i = 0; i < visibleIndices.size(); ++i) {
+        EXPECT_EQ(visibleIndices[i], drawn[i]);
+    }
+
+    // The index buffer keeps all triangles for the other users of the mesh
+    EXPECT_EQ(0, ::memcmp(&source[0], mesh.getIndexBuffer()->getData(), mIndices.size() * sizeof(ui32)));
+}
+
+} // namespace UnitTest
+} // namespace OSRE
@@ -54,6 +54,16 @@ TEST_F( OGLEnumTest, access_cullFace_success ) {
     EXPECT_EQ(GL_FRONT_AND_BACK, (GLint)OGLEnum::getOGLCullFace(state.m_cullFace));
 }
 
+TEST_F(OGLEnumTest, access_compactVertexFormat_success) {
+    EXPECT_EQ(GL_HALF_FLOAT, (GLint)OGLEnum::getOGLTypeForFormat(VertexFormat::Half2));
+    EXPECT_EQ(2u, OGLEnum::getOGLSizeForFormat(VertexFormat::Short2Norm));
+    EXPECT_EQ(4u, OGLEnum::getOGLSizeForFormat(VertexFormat::UByte4Norm));
+    EXPECT_TRUE(OGLEnum::isNormalizedFormat(VertexFormat::Short4Norm));
+    EXPECT_FALSE(OGLEnum::isNormalizedFormat(VertexFormat::Short4));
+    EXPECT_TRUE(OGLEnum::isIntegerFormat(VertexFormat::UByte4Int));
+    EXPECT_FALSE(OGLEnum::isIntegerFormat(VertexFormat::UByte4Norm));
+}
+
 } // Namespace UnitTest
 } // Namespace OSRE
 
@@ -22,6 +22,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "osre_testcommon.h"
 #include "RenderBackend/Pipeline.h"
+#include "RenderBackend/HiZBuffer.h"
 #include "RenderBackend/RenderBackendService.h"
 
 namespace OSRE {
@@ -109,5 +110,18 @@ TEST_F( PipelineTest, getPassByIndexTest ) {
     delete pipeline;
 }
 
+TEST_F( PipelineTest, occlusionBufferTest ) {
+    Pipeline *pipeline = new Pipeline("p1");
+    pipeline->addPass(mPass1);
+    EXPECT_EQ(nullptr, pipeline->getOcclusionBuffer());
+
+    pipeline->addPass(RenderPassFactory::create(OcclusionPassId, FrameBufferId));
+    HiZBuffer *occlusionBuffer = pipeline->getOcclusionBuffer();
+    ASSERT_NE(nullptr, occlusionBuffer);
+    EXPECT_FALSE(occlusionBuffer->isValid());
+
+    delete pipeline;
+}
+
 } // Namespace UnitTest
 } // Namespace OSRE
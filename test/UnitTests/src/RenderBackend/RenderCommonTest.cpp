@@ -235,5 +235,48 @@ TEST_F(RenderCommonTest, uniformBufferEncodeDecodeTest) {
     EXPECT_EQ(lenData, lenData_out);
 }
 
+TEST_F(RenderCommonTest, loadTextureFromMemoryTest) {
+    // A binary PPM with 2x2 pixels, the rows are stored from the top to the bottom
+    static const uc8 Image[] = { 'P', '6', '\n', '2', ' ', '2', '\n', '2', '5', '5', '\n',
+        255, 0, 0, 0, 255, 0,
+        0, 0, 255, 255, 255, 255 };
+    TextureLoader loader;
+    TextureResource texRes("embedded", IO::Uri("file://model.glb*0"));
+    EXPECT_EQ(Common::ResourceState::Loaded, texRes.loadFromMemory(Image, sizeof(Image), loader));
+    Texture *tex = texRes.getRes();
+    ASSERT_NE(nullptr, tex);
+    EXPECT_EQ(String("embedded"), tex->TextureName);
+    EXPECT_EQ(2u, tex->Width);
+    EXPECT_EQ(2u, tex->Height);
+    ASSERT_EQ(3u, tex->Channels);
+    EXPECT_EQ(0, tex->Data[0]);
+    EXPECT_EQ(255, tex->Data[2]);
+    EXPECT_EQ(255, tex->Data[6]);
+
+    // Already loaded
+    EXPECT_EQ(Common::ResourceState::Loaded, texRes.loadFromMemory(Image, 4, loader));
+    texRes.unload(loader);
+    delete tex;
+
+    TextureResource invalid("invalid", IO::Uri("file://model.glb*1"));
+    EXPECT_EQ(Common::ResourceState::Error, invalid.loadFromMemory(Image, 4, loader));
+    delete invalid.getRes();
+}
+
+TEST_F(RenderCommonTest, loadTextureFromPixelsTest) {
+    static const uc8 Pixels[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+    TextureLoader loader;
+    Texture tex("pixels");
+    EXPECT_EQ(0u, loader.loadFromPixels(Pixels, 0, 2, 4, &tex));
+    EXPECT_EQ(sizeof(Pixels), loader.loadFromPixels(Pixels, 1, 2, 4, &tex));
+    EXPECT_EQ(1u, tex.Width);
+    EXPECT_EQ(2u, tex.Height);
+    EXPECT_EQ(4u, tex.Channels);
+    EXPECT_EQ(5, tex.Data[0]);
+    EXPECT_EQ(4, tex.Data[7]);
+    loader.unload(&tex);
+    EXPECT_EQ(nullptr, tex.Data);
+}
+
 } // Namespace UnitTest
 } // Namespace OSRE
@@ -0,0 +1,62 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#pragma once
+
+#include "Common/osre_common.h"
+#include "Common/glm_common.h"
+
+#include <cppcore/Container/TArray.h>
+
+namespace OSRE {
+namespace UnitTest {
+
+/// @brief Will create a flat grid in the xy-plane, all triangles are facing along +z.
+/// @param[in]  gridSize    The number of vertices per side.
+/// @param[in]  quadStep    The step between two following quads, 1 keeps the row order. A step coprime to
+///                         the number of quads scatters the triangles over the grid.
+/// @param[out] positions   The vertex positions, will be replaced.
+/// @param[out] indices     The triangle indices, will be replaced.
+inline void createGrid(ui32 gridSize, ui32 quadStep, cppcore::TArray<glm::vec3> &positions, cppcore::TArray<ui32> &indices) {
+    positions.resize(gridSize * gridSize);
+    for (ui32 y = 0; y < gridSize; ++y) {
+        for (ui32 x = 0; x < gridSize; ++x) {
+            positions[y * gridSize + x] = glm::vec3(static_cast<f32>(x), static_cast<f32>(y), 0.0f);
+        }
+    }
+
+    indices.resize(0);
+    const ui32 numQuads = (gridSize - 1) * (gridSize - 1);
+    for (ui32 q = 0; q < numQuads; ++q) {
+        const ui32 quad = (q * quadStep) % numQuads;
+        const ui32 i = (quad / (gridSize - 1)) * gridSize + quad % (gridSize - 1);
+        indices.add(i);
+        indices.add(i + 1);
+        indices.add(i + gridSize);
+        indices.add(i + 1);
+        indices.add(i + gridSize + 1);
+        indices.add(i + gridSize);
+    }
+}
+
+} // namespace UnitTest
+} // namespace OSRE
@@ -0,0 +1,146 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "RenderBackend/Mesh/VertexQuantizer.h"
+#include "RenderBackend/Mesh.h"
+#include "RenderBackend/MeshBuilder.h"
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::RenderBackend;
+
+class VertexQuantizerTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(VertexQuantizerTest, halfTest) {
+    EXPECT_EQ(0x3c00u, VertexQuantizer::toHalf(1.0f));
+    EXPECT_EQ(0xc000u, VertexQuantizer::toHalf(-2.0f));
+    EXPECT_EQ(0x0000u, VertexQuantizer::toHalf(0.0f));
+    EXPECT_EQ(0x7c00u, VertexQuantizer::toHalf(100000.0f));
+
+    const f32 values[] = { 0.0f, 0.5f, 0.333f, -0.75f, 1.0f, 12.25f, 0.0001f };
+    for (f32 value : values) {
+        EXPECT_NEAR(value, VertexQuantizer::fromHalf(VertexQuantizer::toHalf(value)), std::fabs(value) * 0.001f + 0.00001f);
+    }
+}
+
+TEST_F(VertexQuantizerTest, normTest) {
+    EXPECT_EQ(32767, VertexQuantizer::toSnorm16(1.0f));
+    EXPECT_EQ(-32767, VertexQuantizer::toSnorm16(-2.0f));
+    EXPECT_FLOAT_EQ(-1.0f, VertexQuantizer::fromSnorm16(-32768));
+    EXPECT_EQ(255u, VertexQuantizer::toUnorm8(1.5f));
+    EXPECT_EQ(128u, VertexQuantizer::toUnorm8(0.5f));
+}
+
+TEST_F(VertexQuantizerTest, normalTest) {
+    const glm::vec3 normals[] = {
+        glm::vec3(0, 0, 1), glm::vec3(0, 0, -1), glm::vec3(1, 0, 0), glm::vec3(0, -1, 0),
+        glm::normalize(glm::vec3(1, 2, -3)), glm::normalize(glm::vec3(-0.2f, 0.7f, 0.1f))
+    };
+    for (const glm::vec3 &normal : normals) {
+        i16 encoded[2];
+        VertexQuantizer::encodeNormal(normal, encoded);
+        const glm::vec3 decoded = VertexQuantizer::decodeNormal(encoded);
+        EXPECT_GT(glm::dot(normal, decoded), 0.9999f);
+    }
+}
+
+TEST_F(VertexQuantizerTest, encodeDecodeTest) {
+    RenderVert vertices[2];
+    vertices[0].position = glm::vec3(-10.0f, 2.0f, 5.0f);
+    vertices[0].normal = glm::vec3(0.0f, 1.0f, 0.0f);
+    vertices[0].color0 = glm::vec3(1.0f, 0.5f, 0.0f);
+    vertices[0].tex0 = glm::vec2(0.25f, 0.75f);
+    vertices[1].position = glm::vec3(30.0f, 4.0f, 6.0f);
+
+    glm::vec3 scale, offset;
+    VertexQuantizer::getDequantization(glm::vec3(-10.0f, 2.0f, 5.0f), glm::vec3(30.0f, 4.0f, 6.0f), scale, offset);
+    EXPECT_EQ(glm::vec3(20.0f), scale);
+    EXPECT_EQ(glm::vec3(10.0f, 3.0f, 5.5f), offset);
+
+    CompactVert compact[2];
+    VertexQuantizer::encode(vertices, 2, scale, offset, compact);
+    const RenderVert decoded = VertexQuantizer::decode(compact[0], scale, offset);
+    EXPECT_NEAR(0.0f, glm::length(decoded.position - vertices[0].position), 0.001f);
+    EXPECT_NEAR(0.0f, glm::length(decoded.normal - vertices[0].normal), 0.001f);
+    EXPECT_NEAR(0.0f, glm::length(decoded.color0 - vertices[0].color0), 0.005f);
+    EXPECT_EQ(vertices[0].tex0, decoded.tex0);
+}
+
+TEST_F(VertexQuantizerTest, compactMeshTest) {
+    EXPECT_EQ(20u, sizeof(CompactVert));
+    EXPECT_EQ(sizeof(CompactVert), Mesh::getVertexSize(VertexType::CompactVertex));
+    EXPECT_EQ(4u, getVertexFormatSize(VertexFormat::Half2));
+    EXPECT_EQ(8u, getVertexFormatSize(VertexFormat::Short4Norm));
+
+    glm::vec3 pos[3] = { glm::vec3(-1, -1, 0), glm::vec3(0, 3, 0), glm::vec3(1, -1, 2) };
+    Mesh mesh("compact", VertexType::CompactVertex, IndexType::UnsignedShort);
+    MeshBuilder::allocVertices(&mesh, VertexType::CompactVertex, 3, pos, nullptr, nullptr, BufferAccessType::ReadOnly);
+    ASSERT_NE(nullptr, mesh.getVertexBuffer());
+    EXPECT_EQ(3 * sizeof(CompactVert), mesh.getVertexBuffer()->getSize());
+    for (ui32 i = 0; i < 3; ++i) {
+        EXPECT_NEAR(0.0f, glm::length(mesh.getPosition(i) - pos[i]), 0.001f);
+    }
+
+    const Common::AABB &aabb = mesh.getAABB();
+    EXPECT_NEAR(-1.0f, aabb.getMin().x, 0.001f);
+    EXPECT_NEAR(3.0f, aabb.getMax().y, 0.001f);
+
+    const glm::vec4 corner = mesh.getDequantizationMatrix() * glm::vec4(1.0f, 1.0f, 1.0f, 1.0f);
+    EXPECT_NEAR(2.0f, corner.x, 0.001f);
+
+    Mesh renderMesh("render", VertexType::RenderVertex, IndexType::UnsignedShort);
+    RenderVert vertex;
+    EXPECT_FALSE(VertexQuantizer::createVertexBuffer(&renderMesh, &vertex, 1, BufferAccessType::ReadOnly));
+}
+
+TEST_F(VertexQuantizerTest, meshMatrixTest) {
+    glm::vec3 pos[3] = { glm::vec3(-1, -1, 0), glm::vec3(0, 3, 0), glm::vec3(1, -1, 2) };
+    Mesh floatMesh("float", VertexType::RenderVertex, IndexType::UnsignedShort);
+    MeshBuilder::allocVertices(&floatMesh, VertexType::RenderVertex, 3, pos, nullptr, nullptr, BufferAccessType::ReadOnly);
+    Mesh compactMesh("compact", VertexType::CompactVertex, IndexType::UnsignedShort);
+    MeshBuilder::allocVertices(&compactMesh, VertexType::CompactVertex, 3, pos, nullptr, nullptr, BufferAccessType::ReadOnly);
+    EXPECT_FALSE(floatMesh.hasMeshMatrix());
+    EXPECT_TRUE(compactMesh.hasMeshMatrix());
+
+    const glm::mat4 local = glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    floatMesh.setModelMatrix(true, local);
+    compactMesh.setModelMatrix(true, local);
+
+    // The model matrix of the entity gets multiplied from the left, like in the draw call
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), glm::vec3(5.0f, -2.0f, 8.0f));
+    model = glm::rotate(model, glm::radians(60.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    const CompactVert *compact = reinterpret_cast<const CompactVert *>(compactMesh.getVertexBuffer()->getData());
+    for (ui32 i = 0; i < 3; ++i) {
+        const glm::vec4 quantized(VertexQuantizer::fromSnorm16(compact[i].position[0]), VertexQuantizer::fromSnorm16(compact[i].position[1]),
+                VertexQuantizer::fromSnorm16(compact[i].position[2]), 1.0f);
+        const glm::vec4 expected = model * floatMesh.getMeshMatrix() * glm::vec4(pos[i], 1.0f);
+        const glm::vec4 drawn = model * compactMesh.getMeshMatrix() * quantized;
+        EXPECT_NEAR(0.0f, glm::length(glm::vec3(drawn) - glm::vec3(expected)), 0.001f);
+    }
+}
+
+} // namespace UnitTest
+} // namespace OSRE
@@ -151,5 +151,57 @@ TEST_F(TransformComponentTest, onUpdateWorldTransformTest) {
     EXPECT_FLOAT_EQ(mat_parent[3][2], 3);
 }
 
+TEST_F(TransformComponentTest, setRotationTest) {
+    TransformComponent *comp = createNode("node", mEntity, *mIds, nullptr);
+    comp->translate(glm::vec3(1, 2, 3));
+    comp->scale(glm::vec3(2, 2, 2));
+
+    // The rotation is replaced, translation and scale are kept
+    const glm::quat rotation = glm::angleAxis(glm::radians(90.0f), glm::vec3(0, 0, 1));
+    comp->setRotation(rotation);
+    comp->setRotation(rotation);
+    const glm::mat4 &m = comp->getTransformationMatrix();
+    EXPECT_NEAR(0.0f, m[0][0], 1e-5f);
+    EXPECT_NEAR(2.0f, m[0][1], 1e-5f);
+    EXPECT_NEAR(-2.0f, m[1][0], 1e-5f);
+    EXPECT_NEAR(2.0f, m[2][2], 1e-5f);
+    EXPECT_FLOAT_EQ(1.0f, m[3][0]);
+    EXPECT_FLOAT_EQ(2.0f, m[3][1]);
+    EXPECT_FLOAT_EQ(3.0f, m[3][2]);
+}
+
+TEST_F(TransformComponentTest, batchWorldTransformTest) {
+    TransformComponent *root = createNode("root", mEntity, *mIds, nullptr);
+    TransformComponent *child1 = createNode("child1", mEntity, *mIds, root);
+    TransformComponent *child2 = createNode("child2", mEntity, *mIds, root);
+    TransformComponent *grandChild = createNode("grandchild", mEntity, *mIds, child1);
+
+    root->translate(glm::vec3(1, 0, 0));
+    root->rotate(glm::radians(90.0f), glm::vec3(0, 1, 0));
+    child1->translate(glm::vec3(0, 0, 2));
+    child2->scale(glm::vec3(2, 2, 2));
+    grandChild->translate(glm::vec3(0, 3, 0));
+
+    TransformComponent::updateWorldTransforms(root);
+
+    // The children are transformed by their parents
+    const glm::mat4 expected = root->getTransformationMatrix() * child1->getTransformationMatrix() * grandChild->getTransformationMatrix();
+    for (TransformComponent *node : { root, child1, child2, grandChild }) {
+        const glm::mat4 world = node->getWorlTransformMatrix();
+        for (glm::length_t col = 0; col < 4; ++col) {
+            for (glm::length_t row = 0; row < 4; ++row) {
+                EXPECT_NEAR(world[col][row], node->getWorldTransform()[col][row], 1e-5f);
+            }
+        }
+    }
+    for (glm::length_t row = 0; row < 4; ++row) {
+        EXPECT_NEAR(expected[3][row], grandChild->getWorldTransform()[3][row], 1e-5f);
+    }
+
+    // The rotated offset of child1 points along x
+    EXPECT_NEAR(3.0f, grandChild->getWorldTransform()[3][0], 1e-5f);
+    EXPECT_NEAR(3.0f, grandChild->getWorldTransform()[3][1], 1e-5f);
+}
+
 } // Namespace UnitTest
 } // Namespace OSRE
@@ -0,0 +1,140 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "App/Entity.h"
+#include "App/Raycaster.h"
+#include "App/Scene.h"
+#include "RenderBackend/Mesh.h"
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::App;
+using namespace ::OSRE::Common;
+using namespace ::OSRE::RenderBackend;
+
+class RaycasterTest : public ::testing::Test {
+protected:
+    Scene *mScene = nullptr;
+    Entity *mFront = nullptr;
+    Entity *mBack = nullptr;
+    Mesh *mFrontQuad = nullptr;
+    Mesh *mBackQuad = nullptr;
+
+    static Mesh *createQuad(f32 z) {
+        Mesh *mesh = new Mesh("quad", VertexType::RenderVertex, IndexType::UnsignedShort);
+        RenderVert vertices[4];
+        vertices[0].position = glm::vec3(-1, -1, z);
+        vertices[1].position = glm::vec3(1, -1, z);
+        vertices[2].position = glm::vec3(1, 1, z);
+        vertices[3].position = glm::vec3(-1, 1, z);
+        mesh->createVertexBuffer(vertices, sizeof(vertices), BufferAccessType::ReadOnly);
+        ui16 indices[6] = { 0, 1, 2, 0, 2, 3 };
+        mesh->createIndexBuffer(indices, sizeof(indices), IndexType::UnsignedShort, BufferAccessType::ReadOnly);
+        mesh->addPrimitiveGroup(6, PrimitiveType::TriangleList, 0);
+
+        return mesh;
+    }
+
+    void SetUp() override {
+        mScene = new Scene("test");
+        mFront = new Entity("front", mScene->getIds(), mScene);
+        mBack = new Entity("back", mScene->getIds(), mScene);
+        mFrontQuad = createQuad(0.0f);
+        mBackQuad = createQuad(-5.0f);
+        ((RenderComponent *)mFront->getComponent(ComponentType::RenderComponentType))->addStaticMesh(mFrontQuad);
+        ((RenderComponent *)mBack->getComponent(ComponentType::RenderComponentType))->addStaticMesh(mBackQuad);
+        mScene->update(Time());
+    }
+
+    void TearDown() override {
+        delete mFront;
+        delete mBack;
+        delete mScene;
+        delete mFrontQuad;
+        delete mBackQuad;
+    }
+};
+
+TEST_F(RaycasterTest, intersectAABBTest) {
+    AABB aabb(glm::vec3(-1.0f), glm::vec3(1.0f));
+    f32 distance = 0.0f;
+    EXPECT_TRUE(Raycaster::intersect(Ray(glm::vec3(0, 0, 5), glm::vec3(0, 0, -1)), aabb, 100.0f, distance));
+    EXPECT_FLOAT_EQ(4.0f, distance);
+    EXPECT_FALSE(Raycaster::intersect(Ray(glm::vec3(0, 0, 5), glm::vec3(0, 0, 1)), aabb, 100.0f, distance));
+    EXPECT_FALSE(Raycaster::intersect(Ray(glm::vec3(0, 0, 5), glm::vec3(0, 0, -1)), aabb, 2.0f, distance));
+
+    // The packet test must match the single ray test
+    Ray rays[Raycaster::PacketSize] = {
+        Ray(glm::vec3(0, 0, 5), glm::vec3(0, 0, -1)),
+        Ray(glm::vec3(3, 0, 5), glm::vec3(0, 0, -1)),
+        Ray(glm::vec3(-5, 0.5f, 0), glm::vec3(1, 0, 0)),
+        Ray(glm::vec3(0, 0, 5), glm::vec3(0, 0, -1))
+    };
+    f32 maxDistance[Raycaster::PacketSize] = { 100.0f, 100.0f, 100.0f, -1.0f };
+    f32 distances[Raycaster::PacketSize] = {};
+    EXPECT_EQ(0x5u, Raycaster::intersect(rays, aabb, maxDistance, distances));
+    EXPECT_FLOAT_EQ(4.0f, distances[0]);
+    EXPECT_FLOAT_EQ(4.0f, distances[2]);
+}
+
+TEST_F(RaycasterTest, raycastClosestHitTest) {
+    RayHit hit;
+    EXPECT_TRUE(mScene->raycast(Ray(glm::vec3(0.5f, 0.5f, 10.0f), glm::vec3(0, 0, -1)), hit));
+    EXPECT_EQ(mFront, hit.mEntity);
+    EXPECT_EQ(mFrontQuad, hit.mMesh);
+    EXPECT_FLOAT_EQ(10.0f, hit.mDistance);
+    EXPECT_FLOAT_EQ(0.0f, hit.mPoint.z);
+
+    // From behind the back quad is the closest one
+    EXPECT_TRUE(mScene->raycast(Ray(glm::vec3(0.5f, 0.5f, -10.0f), glm::vec3(0, 0, 1)), hit));
+    EXPECT_EQ(mBack, hit.mEntity);
+
+    EXPECT_FALSE(mScene->raycast(Ray(glm::vec3(5.0f, 0.0f, 10.0f), glm::vec3(0, 0, -1)), hit));
+    EXPECT_FALSE(mScene->raycast(Ray(glm::vec3(0.5f, 0.5f, 10.0f), glm::vec3(0, 0, -1)), hit, RaycastMode::ClosestHit, 5.0f));
+}
+
+TEST_F(RaycasterTest, raycastBatchTest) {
+    static constexpr size_t NumRays = 6;
+    Ray rays[NumRays];
+    for (size_t i = 0; i < NumRays; ++i) {
+        rays[i] = Ray(glm::vec3(-0.9f + 0.3f * i, 0.1f, 10.0f), glm::vec3(0, 0, -1));
+    }
+    rays[NumRays - 1] = Ray(glm::vec3(5.0f, 0.0f, 10.0f), glm::vec3(0, 0, -1));
+
+    RayHit hits[NumRays];
+    mScene->raycastBatch(rays, NumRays, hits, RaycastMode::ClosestHit);
+    for (size_t i = 0; i < NumRays - 1; ++i) {
+        EXPECT_EQ(mFront, hits[i].mEntity);
+    }
+    EXPECT_FALSE(hits[NumRays - 1].hasHit());
+
+    mScene->raycastBatch(rays, NumRays, hits, RaycastMode::AnyHit);
+    for (size_t i = 0; i < NumRays - 1; ++i) {
+        EXPECT_TRUE(hits[i].hasHit());
+    }
+    EXPECT_FALSE(hits[NumRays - 1].hasHit());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
@@ -21,7 +21,10 @@ IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 -----------------------------------------------------------------------------------------------*/
 #include "osre_testcommon.h"
+#include "Animation/AnimationSystem.h"
 #include "App/Scene.h"
+#include "App/Entity.h"
+#include "App/TransformComponent.h"
 
 namespace OSRE {
 namespace UnitTest {
@@ -40,5 +43,127 @@ TEST_F(SceneTest, createTest) {
     EXPECT_TRUE( ok );
 }
 
+TEST_F(SceneTest, findEntityTest) {
+    Scene myScene("test");
+    Entity *entity1 = new Entity("e1", myScene.getIds(), &myScene);
+    Entity *entity2 = new Entity("e2", myScene.getIds(), &myScene);
+
+    EXPECT_EQ(entity1, myScene.findEntity("e1"));
+    EXPECT_EQ(entity2, myScene.getEntityByName("e2"));
+    EXPECT_EQ(nullptr, myScene.findEntity("e3"));
+
+    delete entity1;
+    EXPECT_EQ(nullptr, myScene.findEntity("e1"));
+    EXPECT_EQ(entity2, myScene.findEntity("e2"));
+    delete entity2;
+}
+
+TEST_F(SceneTest, queryRadiusTest) {
+    Scene myScene("test");
+    Entity *entity = new Entity("e1", myScene.getIds(), &myScene);
+    TransformComponent *node = (TransformComponent *)entity->createComponent(ComponentType::TransformComponentType);
+    entity->setNode(node);
+    node->translate(glm::vec3(5.0f, 0.0f, 0.0f));
+    myScene.update(Time());
+
+    cppcore::TArray<Entity *> result;
+    myScene.queryRadius(glm::vec3(5.0f, 0.0f, 0.0f), 1.0f, result);
+    EXPECT_EQ(1u, result.size());
+
+    // Moves are applied with the next update
+    node->translate(glm::vec3(10.0f, 0.0f, 0.0f));
+    myScene.update(Time());
+    result.resize(0);
+    myScene.queryRadius(glm::vec3(5.0f, 0.0f, 0.0f), 1.0f, result);
+    EXPECT_EQ(0u, result.size());
+    myScene.queryBox(Common::AABB(glm::vec3(14.0f, -1.0f, -1.0f), glm::vec3(16.0f, 1.0f, 1.0f)), result);
+    EXPECT_EQ(1u, result.size());
+
+    delete entity;
+}
+
+TEST_F(SceneTest, renameEntityTest) {
+    Scene myScene("test");
+    Entity *entity = new Entity("e1", myScene.getIds(), &myScene);
+    entity->setName("e2");
+    EXPECT_EQ(nullptr, myScene.findEntity("e1"));
+    EXPECT_EQ(entity, myScene.findEntity("e2"));
+
+    // A new entity can take over the old name
+    Entity *other = new Entity("e1", myScene.getIds(), &myScene);
+    EXPECT_EQ(other, myScene.findEntity("e1"));
+
+    delete other;
+    delete entity;
+}
+
+TEST_F(SceneTest, moveParentTest) {
+    Scene myScene("test");
+    Entity *parentEntity = new Entity("parent", myScene.getIds(), &myScene);
+    TransformComponent *parent = (TransformComponent *)parentEntity->createComponent(ComponentType::TransformComponentType);
+    parentEntity->setNode(parent);
+    Entity *childEntity = new Entity("child", myScene.getIds(), &myScene);
+    TransformComponent *child = (TransformComponent *)childEntity->createComponent(ComponentType::TransformComponentType);
+    childEntity->setNode(child);
+    parent->addChild(child);
+    child->setParent(parent);
+    myScene.update(Time());
+
+    // The child entity moves with its parent
+    parent->translate(glm::vec3(20.0f, 0.0f, 0.0f));
+    myScene.update(Time());
+    cppcore::TArray<Entity *> result;
+    myScene.queryRadius(glm::vec3(20.0f, 0.0f, 0.0f), 1.0f, result);
+    EXPECT_EQ(2u, result.size());
+
+    glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
+    child->translate(glm::vec3(0.0f, 10.0f, 0.0f));
+    child->setRotation(rotation);
+    myScene.update(Time());
+    result.resize(0);
+    myScene.queryRadius(glm::vec3(20.0f, 10.0f, 0.0f), 1.0f, result);
+    ASSERT_EQ(1u, result.size());
+    EXPECT_EQ(childEntity, result[0]);
+
+    delete parentEntity;
+    delete childEntity;
+}
+
+TEST_F(SceneTest, removeAnimatedEntityTest) {
+    Scene myScene("test");
+    Entity *entity = new Entity("e1", myScene.getIds(), &myScene);
+    EXPECT_NE(nullptr, entity->createComponent(ComponentType::AnimationComponentType));
+    EXPECT_EQ(1u, myScene.getAnimationSystem().getNumAnimators());
+
+    // The animator leaves the system with its entity
+    EXPECT_TRUE(myScene.removeEntity(entity));
+    EXPECT_EQ(0u, myScene.getAnimationSystem().getNumAnimators());
+    myScene.update(Time());
+
+    delete entity;
+}
+
+TEST_F(SceneTest, worldBoundsTest) {
+    Scene myScene("test");
+    Entity *entity = new Entity("e1", myScene.getIds(), &myScene);
+    entity->setAABB(Common::AABB(glm::vec3(-1.0f, -1.0f, -1.0f), glm::vec3(1.0f, 1.0f, 1.0f)));
+    EXPECT_FLOAT_EQ(1.0f, entity->getWorldScale());
+    EXPECT_EQ(glm::vec3(1.0f, 1.0f, 1.0f), entity->getWorldAABB().getMax());
+
+    // The LOD and the occlusion tests are using the bounds of the moved and scaled entity
+    TransformComponent *node = (TransformComponent *)entity->createComponent(ComponentType::TransformComponentType);
+    entity->setNode(node);
+    node->translate(glm::vec3(5.0f, 0.0f, 0.0f));
+    node->scale(glm::vec3(2.0f, 3.0f, 1.0f));
+    EXPECT_FLOAT_EQ(3.0f, entity->getWorldScale());
+    const Common::AABB bounds = entity->getWorldAABB();
+    EXPECT_FLOAT_EQ(3.0f, bounds.getMin().x);
+    EXPECT_FLOAT_EQ(7.0f, bounds.getMax().x);
+    EXPECT_FLOAT_EQ(3.0f, bounds.getMax().y);
+    EXPECT_FLOAT_EQ(-1.0f, bounds.getMin().z);
+
+    delete entity;
+}
+
 } // Namespace UnitTest
 } // Namespace OSRE
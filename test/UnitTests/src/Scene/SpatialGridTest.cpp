@@ -0,0 +1,125 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "App/Entity.h"
+#include "App/SpatialGrid.h"
+#include "Common/Ids.h"
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::App;
+using namespace ::OSRE::Common;
+
+class SpatialGridTest : public ::testing::Test {
+protected:
+    Ids mIds;
+    Entity *mEntity1 = nullptr;
+    Entity *mEntity2 = nullptr;
+    Entity *mEntity3 = nullptr;
+
+    void SetUp() override {
+        mEntity1 = new Entity("e1", mIds, nullptr);
+        mEntity2 = new Entity("e2", mIds, nullptr);
+        mEntity3 = new Entity("e3", mIds, nullptr);
+    }
+
+    void TearDown() override {
+        delete mEntity3;
+        delete mEntity2;
+        delete mEntity1;
+    }
+};
+
+TEST_F(SpatialGridTest, updateTest) {
+    SpatialGrid grid(1.0f);
+    grid.update(mEntity1, glm::vec3(0.5f));
+    grid.update(mEntity2, glm::vec3(-3.5f, 2.0f, 0.0f));
+    EXPECT_EQ(2u, grid.size());
+    EXPECT_TRUE(grid.contains(mEntity1));
+    EXPECT_FALSE(grid.contains(mEntity3));
+
+    // Moving inside of the cell and into another cell
+    grid.update(mEntity1, glm::vec3(0.7f));
+    grid.update(mEntity2, glm::vec3(10.0f));
+    EXPECT_EQ(2u, grid.size());
+
+    EXPECT_TRUE(grid.remove(mEntity1));
+    EXPECT_FALSE(grid.remove(mEntity1));
+    EXPECT_EQ(1u, grid.size());
+
+    grid.clear();
+    EXPECT_EQ(0u, grid.size());
+}
+
+TEST_F(SpatialGridTest, queryRadiusTest) {
+    SpatialGrid grid(2.0f);
+    grid.update(mEntity1, glm::vec3(0.0f));
+    grid.update(mEntity2, glm::vec3(1.5f, 0.0f, 0.0f));
+    grid.update(mEntity3, glm::vec3(-10.0f, 4.0f, 0.0f));
+
+    cppcore::TArray<Entity *> result;
+    grid.queryRadius(glm::vec3(0.0f), 1.0f, result);
+    ASSERT_EQ(1u, result.size());
+    EXPECT_EQ(mEntity1, result[0]);
+
+    result.resize(0);
+    grid.queryRadius(glm::vec3(0.0f), 2.0f, result);
+    EXPECT_EQ(2u, result.size());
+
+    // Large queries walk the occupied cells
+    result.resize(0);
+    grid.queryRadius(glm::vec3(0.0f), 1000.0f, result);
+    EXPECT_EQ(3u, result.size());
+
+    // Moved entities will be found at their new position
+    grid.update(mEntity3, glm::vec3(0.5f, 0.5f, 0.0f));
+    result.resize(0);
+    grid.queryRadius(glm::vec3(0.0f), 1.0f, result);
+    EXPECT_EQ(2u, result.size());
+}
+
+TEST_F(SpatialGridTest, queryBoxTest) {
+    SpatialGrid grid(1.0f);
+    grid.update(mEntity1, glm::vec3(0.5f, 0.5f, 0.5f));
+    grid.update(mEntity2, glm::vec3(2.5f, 0.5f, 0.5f));
+    grid.update(mEntity3, glm::vec3(-0.5f, -0.5f, -0.5f));
+
+    cppcore::TArray<Entity *> result;
+    grid.queryBox(AABB(glm::vec3(0.0f), glm::vec3(3.0f)), result);
+    EXPECT_EQ(2u, result.size());
+
+    result.resize(0);
+    grid.queryBox(AABB(glm::vec3(-1.0f), glm::vec3(0.0f)), result);
+    ASSERT_EQ(1u, result.size());
+    EXPECT_EQ(mEntity3, result[0]);
+
+    // Changing the cell size keeps all entities
+    grid.setCellSize(0.25f);
+    result.resize(0);
+    grid.queryBox(AABB(glm::vec3(0.0f), glm::vec3(3.0f)), result);
+    EXPECT_EQ(2u, result.size());
+}
+
+} // Namespace UnitTest
+} // Namespace OSRE
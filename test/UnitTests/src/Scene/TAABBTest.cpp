@@ -94,6 +94,33 @@ TEST_F( TAABBTest, mergeArrayTest_Success ) {
     EXPECT_EQ( newMax, aabb.getMax() );
 }
 
+TEST_F( TAABBTest, mergeAABBTest ) {
+    AABB aabb;
+    EXPECT_FALSE(aabb.isValid());
+
+    AABB other(glm::vec3(-1, -2, -3), glm::vec3(1, 2, 3));
+    aabb.merge(other);
+    EXPECT_TRUE(aabb.isValid());
+    EXPECT_EQ(other, aabb);
+
+    AABB invalid;
+    aabb.merge(invalid);
+    EXPECT_EQ(other, aabb);
+}
+
+TEST_F( TAABBTest, transformTest ) {
+    AABB aabb(glm::vec3(-1, -1, -1), glm::vec3(1, 1, 1));
+    glm::mat4 m = glm::translate(glm::mat4(1.0f), glm::vec3(10, 0, 0));
+    AABB translated = aabb.transform(m);
+    EXPECT_EQ(glm::vec3(9, -1, -1), translated.getMin());
+    EXPECT_EQ(glm::vec3(11, 1, 1), translated.getMax());
+
+    m = glm::scale(glm::mat4(1.0f), glm::vec3(2, 3, 4));
+    AABB scaled = aabb.transform(m);
+    EXPECT_EQ(glm::vec3(-2, -3, -4), scaled.getMin());
+    EXPECT_EQ(glm::vec3(2, 3, 4), scaled.getMax());
+}
+
 TEST_F( TAABBTest, getDiameterTest ) {
     glm::vec3 min(0, 0, 0), max(1, 1, 1);
     AABB aabb( min, max );
@@ -0,0 +1,70 @@
+/*-----------------------------------------------------------------------------------------------
+The MIT License (MIT)
+
+Copyright (c) 2015-2025 OSRE ( Open Source Render Engine ) by Kim Kulling
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of
+this software and associated documentation files (the "Software"), to deal in
+the Software without restriction, including without limitation the rights to
+use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+-----------------------------------------------------------------------------------------------*/
+#include "osre_testcommon.h"
+#include "Threading/WorkerPool.h"
+
+namespace OSRE {
+namespace UnitTest {
+
+using namespace ::OSRE::Threading;
+
+class WorkerPoolTest : public ::testing::Test {
+    // empty
+};
+
+TEST_F(WorkerPoolTest, parallelForTest) {
+    WorkerPool pool(3);
+    EXPECT_EQ(3u, pool.getNumWorkers());
+
+    // Every index must be visited exactly once
+    std::vector<i32> visited(1000, 0);
+    for (size_t run = 0; run < 10; ++run) {
+        pool.parallelFor(visited.size(), 7, [&visited](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                ++visited[i];
+            }
+        });
+    }
+    for (i32 count : visited) {
+        EXPECT_EQ(10, count);
+    }
+}
+
+TEST_F(WorkerPoolTest, serialFallbackTest) {
+    WorkerPool pool(1);
+    size_t numCalls = 0;
+    pool.parallelFor(4, 16, [&numCalls](size_t begin, size_t end) {
+        EXPECT_EQ(0u, begin);
+        EXPECT_EQ(4u, end);
+        ++numCalls;
+    });
+    EXPECT_EQ(1u, numCalls);
+
+    pool.parallelFor(0, 16, [&numCalls](size_t, size_t) {
+        ++numCalls;
+    });
+    EXPECT_EQ(1u, numCalls);
+}
+
+} // namespace UnitTest
+} // namespace OSRE